@@ -39,7 +39,46 @@ pub fn build(b: *std.Build) void {
         // Later on we'll use this module as the root module of a test executable
         // which requires us to specify a target.
         .target = target,
+        .link_libc = true,
     });
+    // The firmware bytecode VM is plain C; the library compiles it for the host (with
+    // ESP-IDF shims from esp32_firmware/host) so the simulator, benchmarks and tests
+    // exercise exactly the code that runs on the pillar.
+    mod.addIncludePath(b.path("esp32_firmware/host"));
+    mod.addIncludePath(b.path("esp32_firmware/main"));
+    mod.addCSourceFile(.{
+        .file = b.path("esp32_firmware/main/fw_bytecode_vm.c"),
+        .flags = &.{
+            "-O3",
+            "-ffast-math",
+            "-fno-math-errno",
+        },
+    });
+    // Band-parallel render jobs: a pthread worker on the host, so the frame split and
+    // barrier used by the firmware's dual-core native rendering are tested here too.
+    mod.addCSourceFile(.{
+        .file = b.path("esp32_firmware/main/fw_render_jobs.c"),
+        .flags = &.{"-O2"},
+    });
+    // Render/output frame pipeline; tests drive it with a mock output stage instead of RMT.
+    mod.addCSourceFile(.{
+        .file = b.path("esp32_firmware/main/fw_frame_pipeline.c"),
+        .flags = &.{"-O2"},
+    });
+    // Frame payload decoder, shared with the simulator so it decodes exactly like the pillar.
+    mod.addCSourceFile(.{
+        .file = b.path("esp32_firmware/main/fw_frame_codec.c"),
+        .flags = &.{"-O2"},
+    });
+    // UDP frame stream jitter buffer; the simulator's v5 receiver runs the firmware code.
+    mod.addCSourceFile(.{
+        .file = b.path("esp32_firmware/main/fw_udp_stream.c"),
+        .flags = &.{"-O2"},
+    });
+    if (target.result.os.tag != .windows) {
+        mod.linkSystemLibrary("m", .{});
+        mod.linkSystemLibrary("pthread", .{});
+    }
 
     // Here we define an executable. An executable needs to have a root module
     // which needs to expose a `main` function. While we could add a main function
@@ -135,6 +174,68 @@ pub fn build(b: *std.Build) void {
     const gen_shaders_step = b.step("gen-shaders", "Regenerate shader registry C files from DSL sources");
     gen_shaders_step.dependOn(&gen_registry_cmd.step);
 
+    // Host benchmark of the firmware bytecode VM over every example shader.
+    // Always built optimized so results are comparable between runs.
+    const vm_bench_exe = b.addExecutable(.{
+        .name = "vm_bench",
+        .root_module = b.createModule(.{
+            .root_source_file = b.path("src/vm_bench_main.zig"),
+            .target = target,
+            .optimize = .ReleaseFast,
+            .imports = &.{
+                .{ .name = "led_pillar_zig", .module = mod },
+            },
+        }),
+    });
+    const vm_bench_cmd = b.addRunArtifact(vm_bench_exe);
+    vm_bench_cmd.setCwd(b.path("."));
+    if (b.args) |args| {
+        vm_bench_cmd.addArgs(args);
+    }
+    const vm_bench_step = b.step("vm-bench", "Benchmark the firmware bytecode VM on all example shaders (JSON report)");
+    vm_bench_step.dependOn(&vm_bench_cmd.step);
+
+    // Loopback benchmark of frame streaming: achieved FPS of protocol v2 (stop-and-wait) and
+    // v4 windows against latency injected by a delay proxy.
+    const stream_bench_exe = b.addExecutable(.{
+        .name = "stream_bench",
+        .root_module = b.createModule(.{
+            .root_source_file = b.path("src/stream_bench_main.zig"),
+            .target = target,
+            .optimize = .ReleaseFast,
+            .imports = &.{
+                .{ .name = "led_pillar_zig", .module = mod },
+            },
+        }),
+    });
+    const stream_bench_cmd = b.addRunArtifact(stream_bench_exe);
+    if (b.args) |args| {
+        stream_bench_cmd.addArgs(args);
+    }
+    const stream_bench_step = b.step("stream-bench", "Benchmark v2 vs windowed v4 frame streaming FPS against injected latency (JSON report)");
+    stream_bench_step.dependOn(&stream_bench_cmd.step);
+
+    // Bytes per frame and encode/decode time of the compressed frame encodings over every example
+    // shader, rendered by the DSL evaluator as `dsl-file` streams them.
+    const codec_bench_exe = b.addExecutable(.{
+        .name = "codec_bench",
+        .root_module = b.createModule(.{
+            .root_source_file = b.path("src/codec_bench_main.zig"),
+            .target = target,
+            .optimize = .ReleaseFast,
+            .imports = &.{
+                .{ .name = "led_pillar_zig", .module = mod },
+            },
+        }),
+    });
+    const codec_bench_cmd = b.addRunArtifact(codec_bench_exe);
+    codec_bench_cmd.setCwd(b.path("."));
+    if (b.args) |args| {
+        codec_bench_cmd.addArgs(args);
+    }
+    const codec_bench_step = b.step("codec-bench", "Benchmark compressed frame payload size and encode/decode time on all example shaders (JSON report)");
+    codec_bench_step.dependOn(&codec_bench_cmd.step);
+
     // This creates a top level step. Top level steps have a name and can be
     // invoked by name when running `zig build` (e.g. `zig build run`).
     // This will evaluate the `run` step rather than the default step.
@@ -0,0 +1,6 @@
+#pragma once
+
+// Host build shim for ESP-IDF's esp_attr.h.
+// Lets firmware sources such as fw_bytecode_vm.c compile into the simulator and
+// host benchmarks; memory placement attributes have no meaning off-target.
+#define IRAM_ATTR
@@ -123,20 +123,24 @@ static void fw_init_led_layout(void) {
     ESP_ERROR_CHECK(fw_led_map_logical_xy(&g_fw_layout, 0, 0, &first_pixel));
 
     ESP_LOGI(TAG,
-             "LED layout ready: %ux%u, segments=%u, total_leds=%" PRIu32 ", serpentine=%s",
+             "LED layout ready: %ux%u, segments=%u, total_leds=%" PRIu32 ", serpentine=%s, mirror_x=%s, flip_y=%s, column_offset=%u",
              g_fw_layout.width,
              g_fw_layout.height,
              g_fw_layout.segment_count,
              fw_led_layout_total_leds(&g_fw_layout),
-             g_fw_layout.serpentine_columns ? "enabled" : "disabled");
+             g_fw_layout.serpentine_columns ? "enabled" : "disabled",
+             g_fw_layout.mirror_x ? "yes" : "no",
+             g_fw_layout.flip_y ? "yes" : "no",
+             g_fw_layout.column_offset);
 
     uint8_t segment = 0;
     while (segment < g_fw_layout.segment_count) {
         ESP_LOGI(TAG,
-                 "segment[%u]: gpio=%d leds=%u",
+                 "segment[%u]: gpio=%d leds=%u%s",
                  segment,
                  g_fw_layout.segments[segment].gpio,
-                 g_fw_layout.segments[segment].led_count);
+                 g_fw_layout.segments[segment].led_count,
+                 g_fw_layout.segments[segment].reversed ? " reversed" : "");
         segment += 1;
     }
 
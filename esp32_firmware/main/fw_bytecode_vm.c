@@ -1,2358 +1,4841 @@
-#include "fw_bytecode_vm.h"
-
-#include <float.h>
-#include <limits.h>
-#include <math.h>
-#include <string.h>
-#include "fw_fast_math.h"
-#include "esp_attr.h"
-
-#define FW_BC3_INPUT_SLOT_COUNT 7U
-#define FW_BC3_MAX_CALL_ARGS 8U
-#define FW_BC3_BUILTIN_COUNT 24U
-
-typedef enum {
-    FW_BC3_OP_PUSH_LITERAL = 1,
-    FW_BC3_OP_PUSH_SLOT = 2,
-    FW_BC3_OP_NEGATE = 3,
-    FW_BC3_OP_ADD = 4,
-    FW_BC3_OP_SUB = 5,
-    FW_BC3_OP_MUL = 6,
-    FW_BC3_OP_DIV = 7,
-    FW_BC3_OP_CALL_BUILTIN = 8,
-    FW_BC3_OP_MOD = 9,
-} fw_bc3_expr_opcode_t;
-
-typedef enum {
-    FW_BC3_SLOT_INPUT = 1,
-    FW_BC3_SLOT_PARAM = 2,
-    FW_BC3_SLOT_FRAME_LET = 3,
-    FW_BC3_SLOT_LET = 4,
-} fw_bc3_slot_tag_t;
-
-typedef enum {
-    FW_BC3_DOP_PUSH_SCALAR_LIT = 0,
-    FW_BC3_DOP_PUSH_INPUT = 1,
-    FW_BC3_DOP_PUSH_PARAM = 2,
-    FW_BC3_DOP_PUSH_FRAME_LET = 3,
-    FW_BC3_DOP_PUSH_LET = 4,
-    FW_BC3_DOP_NEGATE = 5,
-    FW_BC3_DOP_ADD = 6,
-    FW_BC3_DOP_SUB = 7,
-    FW_BC3_DOP_MUL = 8,
-    FW_BC3_DOP_DIV = 9,
-    FW_BC3_DOP_MOD = 10,
-    FW_BC3_DOP_CALL_BUILTIN = 11,
-    // Inlined builtins (1-arg scalar -> scalar)
-    FW_BC3_DOP_BUILTIN_SIN = 12,
-    FW_BC3_DOP_BUILTIN_COS = 13,
-    FW_BC3_DOP_BUILTIN_SQRT = 14,
-    FW_BC3_DOP_BUILTIN_ABS = 15,
-    FW_BC3_DOP_BUILTIN_FLOOR = 16,
-    FW_BC3_DOP_BUILTIN_FRACT = 17,
-    FW_BC3_DOP_BUILTIN_LN = 18,
-    FW_BC3_DOP_BUILTIN_LOG = 19,
-    // Inlined builtins (2-arg scalar -> scalar)
-    FW_BC3_DOP_BUILTIN_MIN = 20,
-    FW_BC3_DOP_BUILTIN_MAX = 21,
-    // Inlined builtins (3-arg scalar -> scalar)
-    FW_BC3_DOP_BUILTIN_CLAMP = 22,
-    FW_BC3_DOP_BUILTIN_SMOOTHSTEP = 23,
-    // Inlined builtins (pow, noise)
-    FW_BC3_DOP_BUILTIN_POW = 24,
-    FW_BC3_DOP_BUILTIN_NOISE = 25,
-    FW_BC3_DOP_BUILTIN_NOISE3 = 26,
-    // Inlined phasor (returns 0 in bytecode VM)
-    FW_BC3_DOP_BUILTIN_PHASOR = 27,
-    // Inlined type constructors
-    FW_BC3_DOP_BUILTIN_VEC2 = 28,
-    FW_BC3_DOP_BUILTIN_RGBA = 29,
-    // Sentinel: terminates computed-goto dispatch
-    FW_BC3_DOP_HALT = 30,
-} fw_bc3_decoded_opcode_t;
-
-typedef enum {
-    FW_BC3_INPUT_TIME = 0,
-    FW_BC3_INPUT_FRAME = 1,
-    FW_BC3_INPUT_X = 2,
-    FW_BC3_INPUT_Y = 3,
-    FW_BC3_INPUT_WIDTH = 4,
-    FW_BC3_INPUT_HEIGHT = 5,
-    FW_BC3_INPUT_SEED = 6,
-} fw_bc3_input_slot_t;
-
-typedef enum {
-    FW_BC3_BUILTIN_SIN = 0,
-    FW_BC3_BUILTIN_COS = 1,
-    FW_BC3_BUILTIN_SQRT = 2,
-    FW_BC3_BUILTIN_LN = 3,
-    FW_BC3_BUILTIN_LOG = 4,
-    FW_BC3_BUILTIN_ABS = 5,
-    FW_BC3_BUILTIN_FLOOR = 6,
-    FW_BC3_BUILTIN_FRACT = 7,
-    FW_BC3_BUILTIN_MIN = 8,
-    FW_BC3_BUILTIN_MAX = 9,
-    FW_BC3_BUILTIN_CLAMP = 10,
-    FW_BC3_BUILTIN_SMOOTHSTEP = 11,
-    FW_BC3_BUILTIN_CIRCLE = 12,
-    FW_BC3_BUILTIN_BOX = 13,
-    FW_BC3_BUILTIN_WRAPDX = 14,
-    FW_BC3_BUILTIN_HASH01 = 15,
-    FW_BC3_BUILTIN_HASH_SIGNED = 16,
-    FW_BC3_BUILTIN_HASH_COORDS01 = 17,
-    FW_BC3_BUILTIN_POW = 18,
-    FW_BC3_BUILTIN_NOISE = 19,
-    FW_BC3_BUILTIN_NOISE3 = 20,
-    FW_BC3_BUILTIN_PHASOR = 21,
-    FW_BC3_BUILTIN_VEC2 = 22,
-    FW_BC3_BUILTIN_RGBA = 23,
-} fw_bc3_builtin_id_t;
-
-typedef struct {
-    const uint8_t *base;
-    const uint8_t *cur;
-    const uint8_t *end;
-} fw_bc3_cursor_t;
-
-typedef struct {
-    uint8_t tag;
-    uint32_t index;
-} fw_bc3_slot_ref_t;
-
-typedef struct {
-    float time;
-    float frame;
-    float x;
-    float y;
-    float width;
-    float height;
-    float seed;
-} fw_bc3_inputs_t;
-
-typedef struct {
-    uint16_t start;
-    uint16_t count;
-    uint16_t max_slot_plus_one;
-} fw_bc3_stmt_block_info_t;
-
-typedef enum {
-    FW_BC3_PARAM_EVAL_ALL = 0,
-    FW_BC3_PARAM_EVAL_STATIC_ONLY = 1,
-    FW_BC3_PARAM_EVAL_DYNAMIC_ONLY = 2,
-    FW_BC3_PARAM_EVAL_DYNAMIC_X_ONLY = 3,
-    FW_BC3_PARAM_EVAL_DYNAMIC_Y_ONLY = 4,
-} fw_bc3_param_eval_mode_t;
-
-static fw_bc3_value_t fw_bc3_make_scalar(float scalar) {
-    fw_bc3_value_t value = {
-        .tag = FW_BC3_VALUE_SCALAR,
-        .as.scalar = scalar,
-    };
-    return value;
-}
-
-static fw_bc3_status_t fw_bc3_cursor_read_u8(fw_bc3_cursor_t *cursor, uint8_t *out) {
-    if (cursor->cur >= cursor->end) {
-        return FW_BC3_ERR_TRUNCATED;
-    }
-    *out = *cursor->cur;
-    cursor->cur += 1;
-    return FW_BC3_OK;
-}
-
-static fw_bc3_status_t fw_bc3_cursor_read_u16(fw_bc3_cursor_t *cursor, uint16_t *out) {
-    if ((size_t)(cursor->end - cursor->cur) < 2U) {
-        return FW_BC3_ERR_TRUNCATED;
-    }
-    // Host serializer writes all integer fields in little-endian order.
-    *out = (uint16_t)cursor->cur[0] | ((uint16_t)cursor->cur[1] << 8U);
-    cursor->cur += 2;
-    return FW_BC3_OK;
-}
-
-static fw_bc3_status_t fw_bc3_cursor_read_u32(fw_bc3_cursor_t *cursor, uint32_t *out) {
-    if ((size_t)(cursor->end - cursor->cur) < 4U) {
-        return FW_BC3_ERR_TRUNCATED;
-    }
-    *out = (uint32_t)cursor->cur[0] | ((uint32_t)cursor->cur[1] << 8U) | ((uint32_t)cursor->cur[2] << 16U) |
-           ((uint32_t)cursor->cur[3] << 24U);
-    cursor->cur += 4;
-    return FW_BC3_OK;
-}
-
-static fw_bc3_status_t fw_bc3_cursor_read_f32(fw_bc3_cursor_t *cursor, float *out) {
-    uint32_t bits = 0;
-    fw_bc3_status_t status = fw_bc3_cursor_read_u32(cursor, &bits);
-    if (status != FW_BC3_OK) {
-        return status;
-    }
-    memcpy(out, &bits, sizeof(bits));
-    return FW_BC3_OK;
-}
-
-static fw_bc3_status_t fw_bc3_parse_runtime_value(fw_bc3_cursor_t *cursor, fw_bc3_value_t *out) {
-    uint8_t tag = 0;
-    fw_bc3_status_t status = fw_bc3_cursor_read_u8(cursor, &tag);
-    if (status != FW_BC3_OK) {
-        return status;
-    }
-
-    if (tag == FW_BC3_VALUE_SCALAR) {
-        float scalar = 0.0f;
-        status = fw_bc3_cursor_read_f32(cursor, &scalar);
-        if (status != FW_BC3_OK) {
-            return status;
-        }
-        if (out != NULL) {
-            *out = fw_bc3_make_scalar(scalar);
-        }
-        return FW_BC3_OK;
-    }
-
-    if (tag == FW_BC3_VALUE_VEC2) {
-        float x = 0.0f;
-        float y = 0.0f;
-        status = fw_bc3_cursor_read_f32(cursor, &x);
-        if (status != FW_BC3_OK) {
-            return status;
-        }
-        status = fw_bc3_cursor_read_f32(cursor, &y);
-        if (status != FW_BC3_OK) {
-            return status;
-        }
-        if (out != NULL) {
-            out->tag = FW_BC3_VALUE_VEC2;
-            out->as.vec2 = (fw_bc3_vec2_t){
-                .x = x,
-                .y = y,
-            };
-        }
-        return FW_BC3_OK;
-    }
-
-    if (tag == FW_BC3_VALUE_RGBA) {
-        float r = 0.0f;
-        float g = 0.0f;
-        float b = 0.0f;
-        float a = 0.0f;
-        status = fw_bc3_cursor_read_f32(cursor, &r);
-        if (status != FW_BC3_OK) {
-            return status;
-        }
-        status = fw_bc3_cursor_read_f32(cursor, &g);
-        if (status != FW_BC3_OK) {
-            return status;
-        }
-        status = fw_bc3_cursor_read_f32(cursor, &b);
-        if (status != FW_BC3_OK) {
-            return status;
-        }
-        status = fw_bc3_cursor_read_f32(cursor, &a);
-        if (status != FW_BC3_OK) {
-            return status;
-        }
-        if (out != NULL) {
-            out->tag = FW_BC3_VALUE_RGBA;
-            out->as.rgba = (fw_bc3_color_t){
-                .r = r,
-                .g = g,
-                .b = b,
-                .a = a,
-            };
-        }
-        return FW_BC3_OK;
-    }
-
-    return FW_BC3_ERR_INVALID_TAG;
-}
-
-static fw_bc3_status_t fw_bc3_parse_slot_ref(fw_bc3_cursor_t *cursor, fw_bc3_slot_ref_t *out) {
-    uint8_t tag = 0;
-    fw_bc3_status_t status = fw_bc3_cursor_read_u8(cursor, &tag);
-    if (status != FW_BC3_OK) {
-        return status;
-    }
-
-    out->tag = tag;
-    if (tag == FW_BC3_SLOT_INPUT) {
-        uint8_t input_slot = 0;
-        status = fw_bc3_cursor_read_u8(cursor, &input_slot);
-        if (status != FW_BC3_OK) {
-            return status;
-        }
-        if (input_slot >= FW_BC3_INPUT_SLOT_COUNT) {
-            return FW_BC3_ERR_INVALID_SLOT;
-        }
-        out->index = input_slot;
-        return FW_BC3_OK;
-    }
-
-    if (tag == FW_BC3_SLOT_PARAM || tag == FW_BC3_SLOT_FRAME_LET || tag == FW_BC3_SLOT_LET) {
-        uint32_t index = 0;
-        status = fw_bc3_cursor_read_u32(cursor, &index);
-        if (status != FW_BC3_OK) {
-            return status;
-        }
-        out->index = index;
-        return FW_BC3_OK;
-    }
-
-    return FW_BC3_ERR_INVALID_TAG;
-}
-
-static fw_bc3_status_t fw_bc3_parse_expression(fw_bc3_program_t *program, fw_bc3_cursor_t *cursor, uint16_t *out_expr_index) {
-    uint32_t declared_max_stack = 0;
-    uint32_t instruction_count = 0;
-    fw_bc3_status_t status = fw_bc3_cursor_read_u32(cursor, &declared_max_stack);
-    if (status != FW_BC3_OK) {
-        return status;
-    }
-    status = fw_bc3_cursor_read_u32(cursor, &instruction_count);
-    if (status != FW_BC3_OK) {
-        return status;
-    }
-
-    if (declared_max_stack == 0U || declared_max_stack > FW_BC3_MAX_EXPR_STACK) {
-        return FW_BC3_ERR_LIMIT;
-    }
-    if (instruction_count == 0U || instruction_count > FW_BC3_MAX_EXPR_INSTRUCTIONS) {
-        return FW_BC3_ERR_LIMIT;
-    }
-    if (program->expr_count >= FW_BC3_MAX_EXPRESSIONS) {
-        return FW_BC3_ERR_LIMIT;
-    }
-
-    const uint16_t expr_index = program->expr_count;
-    program->expr_count += 1U;
-    program->expressions[expr_index] = (fw_bc3_expr_view_t){
-        .byte_offset = (uint32_t)(cursor->cur - cursor->base),
-        .instruction_count = (uint16_t)instruction_count,
-        .max_stack_depth = (uint16_t)declared_max_stack,
-    };
-
-    int32_t stack_depth = 0;
-    uint32_t max_seen = 0;
-    uint32_t i = 0;
-    while (i < instruction_count) {
-        uint8_t opcode = 0;
-        status = fw_bc3_cursor_read_u8(cursor, &opcode);
-        if (status != FW_BC3_OK) {
-            return status;
-        }
-
-        if (opcode == FW_BC3_OP_PUSH_LITERAL) {
-            status = fw_bc3_parse_runtime_value(cursor, NULL);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            stack_depth += 1;
-        } else if (opcode == FW_BC3_OP_PUSH_SLOT) {
-            fw_bc3_slot_ref_t slot = {0};
-            status = fw_bc3_parse_slot_ref(cursor, &slot);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            if (slot.tag == FW_BC3_SLOT_PARAM && slot.index >= program->param_count) {
-                return FW_BC3_ERR_INVALID_SLOT;
-            }
-            if ((slot.tag == FW_BC3_SLOT_FRAME_LET || slot.tag == FW_BC3_SLOT_LET) && slot.index >= FW_BC3_MAX_LET_SLOTS) {
-                return FW_BC3_ERR_INVALID_SLOT;
-            }
-            stack_depth += 1;
-        } else if (opcode == FW_BC3_OP_NEGATE) {
-            if (stack_depth < 1) {
-                return FW_BC3_ERR_STACK_UNDERFLOW;
-            }
-        } else if (opcode == FW_BC3_OP_ADD || opcode == FW_BC3_OP_SUB || opcode == FW_BC3_OP_MUL || opcode == FW_BC3_OP_DIV || opcode == FW_BC3_OP_MOD) {
-            if (stack_depth < 2) {
-                return FW_BC3_ERR_STACK_UNDERFLOW;
-            }
-            stack_depth -= 1;
-        } else if (opcode == FW_BC3_OP_CALL_BUILTIN) {
-            uint8_t builtin = 0;
-            uint8_t arg_count = 0;
-            status = fw_bc3_cursor_read_u8(cursor, &builtin);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            status = fw_bc3_cursor_read_u8(cursor, &arg_count);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            if (builtin >= FW_BC3_BUILTIN_COUNT) {
-                return FW_BC3_ERR_INVALID_BUILTIN;
-            }
-            if (arg_count == 0U || arg_count > FW_BC3_MAX_CALL_ARGS) {
-                return FW_BC3_ERR_FORMAT;
-            }
-            if (stack_depth < (int32_t)arg_count) {
-                return FW_BC3_ERR_STACK_UNDERFLOW;
-            }
-            stack_depth = stack_depth - (int32_t)arg_count + 1;
-        } else {
-            return FW_BC3_ERR_INVALID_OPCODE;
-        }
-
-        if (stack_depth < 0) {
-            return FW_BC3_ERR_STACK_UNDERFLOW;
-        }
-        if ((uint32_t)stack_depth > declared_max_stack || (uint32_t)stack_depth > FW_BC3_MAX_EXPR_STACK) {
-            return FW_BC3_ERR_STACK_OVERFLOW;
-        }
-        if ((uint32_t)stack_depth > max_seen) {
-            max_seen = (uint32_t)stack_depth;
-        }
-        i += 1U;
-    }
-
-    if (stack_depth != 1) {
-        return FW_BC3_ERR_FORMAT;
-    }
-    if (max_seen > declared_max_stack) {
-        return FW_BC3_ERR_FORMAT;
-    }
-
-    // Pre-decode pass: convert raw bytecode into flat decoded ops
-    {
-        const uint16_t decode_start = program->decoded_op_count;
-        program->expr_op_start[expr_index] = decode_start;
-
-        fw_bc3_cursor_t decode_cursor = {
-            .base = cursor->base,
-            .cur = cursor->base + program->expressions[expr_index].byte_offset,
-            .end = cursor->end,
-        };
-
-        uint32_t di = 0;
-        while (di < instruction_count) {
-            if (program->decoded_op_count >= FW_BC3_MAX_DECODED_OPS) {
-                return FW_BC3_ERR_LIMIT;
-            }
-            fw_bc3_decoded_op_t *dop = &program->decoded_ops[program->decoded_op_count];
-            memset(dop, 0, sizeof(*dop));
-
-            uint8_t opcode = 0;
-            status = fw_bc3_cursor_read_u8(&decode_cursor, &opcode);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-
-            if (opcode == FW_BC3_OP_PUSH_LITERAL) {
-                uint8_t tag = 0;
-                status = fw_bc3_cursor_read_u8(&decode_cursor, &tag);
-                if (status != FW_BC3_OK) {
-                    return status;
-                }
-                if (tag == FW_BC3_VALUE_SCALAR) {
-                    float scalar = 0.0f;
-                    status = fw_bc3_cursor_read_f32(&decode_cursor, &scalar);
-                    if (status != FW_BC3_OK) {
-                        return status;
-                    }
-                    dop->op = (uint8_t)FW_BC3_DOP_PUSH_SCALAR_LIT;
-                    dop->scalar = scalar;
-                } else if (tag == FW_BC3_VALUE_VEC2) {
-                    float x_val = 0.0f, y_val = 0.0f;
-                    status = fw_bc3_cursor_read_f32(&decode_cursor, &x_val);
-                    if (status != FW_BC3_OK) {
-                        return status;
-                    }
-                    status = fw_bc3_cursor_read_f32(&decode_cursor, &y_val);
-                    if (status != FW_BC3_OK) {
-                        return status;
-                    }
-                    // Decompose: push x, push y, vec2 constructor
-                    dop->op = (uint8_t)FW_BC3_DOP_PUSH_SCALAR_LIT;
-                    dop->scalar = x_val;
-                    program->decoded_op_count += 1U;
-                    if (program->decoded_op_count >= FW_BC3_MAX_DECODED_OPS) {
-                        return FW_BC3_ERR_LIMIT;
-                    }
-                    dop = &program->decoded_ops[program->decoded_op_count];
-                    memset(dop, 0, sizeof(*dop));
-                    dop->op = (uint8_t)FW_BC3_DOP_PUSH_SCALAR_LIT;
-                    dop->scalar = y_val;
-                    program->decoded_op_count += 1U;
-                    if (program->decoded_op_count >= FW_BC3_MAX_DECODED_OPS) {
-                        return FW_BC3_ERR_LIMIT;
-                    }
-                    dop = &program->decoded_ops[program->decoded_op_count];
-                    memset(dop, 0, sizeof(*dop));
-                    dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_VEC2;
-                } else if (tag == FW_BC3_VALUE_RGBA) {
-                    float r = 0.0f, g = 0.0f, b_val = 0.0f, a = 0.0f;
-                    status = fw_bc3_cursor_read_f32(&decode_cursor, &r);
-                    if (status != FW_BC3_OK) {
-                        return status;
-                    }
-                    status = fw_bc3_cursor_read_f32(&decode_cursor, &g);
-                    if (status != FW_BC3_OK) {
-                        return status;
-                    }
-                    status = fw_bc3_cursor_read_f32(&decode_cursor, &b_val);
-                    if (status != FW_BC3_OK) {
-                        return status;
-                    }
-                    status = fw_bc3_cursor_read_f32(&decode_cursor, &a);
-                    if (status != FW_BC3_OK) {
-                        return status;
-                    }
-                    // Decompose: push r, push g, push b, push a, rgba constructor
-                    dop->op = (uint8_t)FW_BC3_DOP_PUSH_SCALAR_LIT;
-                    dop->scalar = r;
-                    program->decoded_op_count += 1U;
-                    if (program->decoded_op_count >= FW_BC3_MAX_DECODED_OPS) {
-                        return FW_BC3_ERR_LIMIT;
-                    }
-                    dop = &program->decoded_ops[program->decoded_op_count];
-                    memset(dop, 0, sizeof(*dop));
-                    dop->op = (uint8_t)FW_BC3_DOP_PUSH_SCALAR_LIT;
-                    dop->scalar = g;
-                    program->decoded_op_count += 1U;
-                    if (program->decoded_op_count >= FW_BC3_MAX_DECODED_OPS) {
-                        return FW_BC3_ERR_LIMIT;
-                    }
-                    dop = &program->decoded_ops[program->decoded_op_count];
-                    memset(dop, 0, sizeof(*dop));
-                    dop->op = (uint8_t)FW_BC3_DOP_PUSH_SCALAR_LIT;
-                    dop->scalar = b_val;
-                    program->decoded_op_count += 1U;
-                    if (program->decoded_op_count >= FW_BC3_MAX_DECODED_OPS) {
-                        return FW_BC3_ERR_LIMIT;
-                    }
-                    dop = &program->decoded_ops[program->decoded_op_count];
-                    memset(dop, 0, sizeof(*dop));
-                    dop->op = (uint8_t)FW_BC3_DOP_PUSH_SCALAR_LIT;
-                    dop->scalar = a;
-                    program->decoded_op_count += 1U;
-                    if (program->decoded_op_count >= FW_BC3_MAX_DECODED_OPS) {
-                        return FW_BC3_ERR_LIMIT;
-                    }
-                    dop = &program->decoded_ops[program->decoded_op_count];
-                    memset(dop, 0, sizeof(*dop));
-                    dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_RGBA;
-                } else {
-                    return FW_BC3_ERR_INVALID_TAG;
-                }
-            } else if (opcode == FW_BC3_OP_PUSH_SLOT) {
-                fw_bc3_slot_ref_t slot = {0};
-                status = fw_bc3_parse_slot_ref(&decode_cursor, &slot);
-                if (status != FW_BC3_OK) {
-                    return status;
-                }
-                if (slot.tag == FW_BC3_SLOT_INPUT) {
-                    dop->op = (uint8_t)FW_BC3_DOP_PUSH_INPUT;
-                    dop->index = (uint16_t)slot.index;
-                } else if (slot.tag == FW_BC3_SLOT_PARAM) {
-                    dop->op = (uint8_t)FW_BC3_DOP_PUSH_PARAM;
-                    dop->index = (uint16_t)slot.index;
-                } else if (slot.tag == FW_BC3_SLOT_FRAME_LET) {
-                    dop->op = (uint8_t)FW_BC3_DOP_PUSH_FRAME_LET;
-                    dop->index = (uint16_t)slot.index;
-                } else if (slot.tag == FW_BC3_SLOT_LET) {
-                    dop->op = (uint8_t)FW_BC3_DOP_PUSH_LET;
-                    dop->index = (uint16_t)slot.index;
-                } else {
-                    return FW_BC3_ERR_INVALID_TAG;
-                }
-            } else if (opcode == FW_BC3_OP_NEGATE) {
-                dop->op = (uint8_t)FW_BC3_DOP_NEGATE;
-            } else if (opcode == FW_BC3_OP_ADD) {
-                dop->op = (uint8_t)FW_BC3_DOP_ADD;
-            } else if (opcode == FW_BC3_OP_SUB) {
-                dop->op = (uint8_t)FW_BC3_DOP_SUB;
-            } else if (opcode == FW_BC3_OP_MUL) {
-                dop->op = (uint8_t)FW_BC3_DOP_MUL;
-            } else if (opcode == FW_BC3_OP_DIV) {
-                dop->op = (uint8_t)FW_BC3_DOP_DIV;
-            } else if (opcode == FW_BC3_OP_MOD) {
-                dop->op = (uint8_t)FW_BC3_DOP_MOD;
-            } else if (opcode == FW_BC3_OP_CALL_BUILTIN) {
-                uint8_t builtin = 0;
-                uint8_t arg_count = 0;
-                status = fw_bc3_cursor_read_u8(&decode_cursor, &builtin);
-                if (status != FW_BC3_OK) {
-                    return status;
-                }
-                status = fw_bc3_cursor_read_u8(&decode_cursor, &arg_count);
-                if (status != FW_BC3_OK) {
-                    return status;
-                }
-                switch ((fw_bc3_builtin_id_t)builtin) {
-                    case FW_BC3_BUILTIN_SIN:
-                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_SIN;
-                        break;
-                    case FW_BC3_BUILTIN_COS:
-                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_COS;
-                        break;
-                    case FW_BC3_BUILTIN_SQRT:
-                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_SQRT;
-                        break;
-                    case FW_BC3_BUILTIN_ABS:
-                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_ABS;
-                        break;
-                    case FW_BC3_BUILTIN_FLOOR:
-                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_FLOOR;
-                        break;
-                    case FW_BC3_BUILTIN_FRACT:
-                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_FRACT;
-                        break;
-                    case FW_BC3_BUILTIN_LN:
-                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_LN;
-                        break;
-                    case FW_BC3_BUILTIN_LOG:
-                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_LOG;
-                        break;
-                    case FW_BC3_BUILTIN_MIN:
-                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_MIN;
-                        break;
-                    case FW_BC3_BUILTIN_MAX:
-                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_MAX;
-                        break;
-                    case FW_BC3_BUILTIN_CLAMP:
-                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_CLAMP;
-                        break;
-                    case FW_BC3_BUILTIN_SMOOTHSTEP:
-                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_SMOOTHSTEP;
-                        break;
-                    case FW_BC3_BUILTIN_POW:
-                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_POW;
-                        break;
-                    case FW_BC3_BUILTIN_NOISE:
-                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_NOISE;
-                        break;
-                    case FW_BC3_BUILTIN_NOISE3:
-                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_NOISE3;
-                        break;
-                    case FW_BC3_BUILTIN_PHASOR:
-                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_PHASOR;
-                        break;
-                    case FW_BC3_BUILTIN_VEC2:
-                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_VEC2;
-                        break;
-                    case FW_BC3_BUILTIN_RGBA:
-                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_RGBA;
-                        break;
-                    default:
-                        dop->op = (uint8_t)FW_BC3_DOP_CALL_BUILTIN;
-                        dop->builtin = builtin;
-                        dop->arg_count = arg_count;
-                        break;
-                }
-            } else {
-                return FW_BC3_ERR_INVALID_OPCODE;
-            }
-
-            program->decoded_op_count += 1U;
-            di += 1U;
-        }
-
-        program->expr_op_count[expr_index] = (uint16_t)(program->decoded_op_count - decode_start);
-
-        // Append HALT sentinel for computed-goto dispatch
-        if (program->decoded_op_count >= FW_BC3_MAX_DECODED_OPS) {
-            return FW_BC3_ERR_LIMIT;
-        }
-        program->decoded_ops[program->decoded_op_count].op = (uint8_t)FW_BC3_DOP_HALT;
-        program->decoded_op_count += 1U;
-    }
-
-    *out_expr_index = expr_index;
-    return FW_BC3_OK;
-}
-
-static fw_bc3_status_t fw_bc3_expression_scan_input_dependencies(
-    const fw_bc3_program_t *program,
-    uint16_t expr_index,
-    bool include_param_dependencies,
-    bool *uses_x,
-    bool *uses_y
-) {
-    if (program == NULL || uses_x == NULL || uses_y == NULL || expr_index >= program->expr_count) {
-        return FW_BC3_ERR_INVALID_ARG;
-    }
-
-    const fw_bc3_decoded_op_t *ops = &program->decoded_ops[program->expr_op_start[expr_index]];
-    const uint16_t op_count = program->expr_op_count[expr_index];
-
-    bool local_uses_x = false;
-    bool local_uses_y = false;
-    for (uint16_t i = 0; i < op_count; i++) {
-        const fw_bc3_decoded_op_t *op = &ops[i];
-        if (op->op == (uint8_t)FW_BC3_DOP_PUSH_INPUT) {
-            if (op->index == FW_BC3_INPUT_X) {
-                local_uses_x = true;
-            } else if (op->index == FW_BC3_INPUT_Y) {
-                local_uses_y = true;
-            }
-        } else if (include_param_dependencies && op->op == (uint8_t)FW_BC3_DOP_PUSH_PARAM && op->index < program->param_count) {
-            if (program->param_depends_x[op->index] != 0U) {
-                local_uses_x = true;
-            }
-            if (program->param_depends_y[op->index] != 0U) {
-                local_uses_y = true;
-            }
-        }
-
-        if (local_uses_x && local_uses_y) {
-            break;
-        }
-    }
-
-    *uses_x = local_uses_x;
-    *uses_y = local_uses_y;
-    return FW_BC3_OK;
-}
-
-static fw_bc3_status_t fw_bc3_statement_block_depends_xy(
-    const fw_bc3_program_t *program,
-    uint16_t start,
-    uint16_t count,
-    uint8_t depth,
-    bool *depends_xy
-) {
-    if (program == NULL || depends_xy == NULL || depth > FW_BC3_MAX_STATEMENT_DEPTH) {
-        return FW_BC3_ERR_INVALID_ARG;
-    }
-    if ((uint32_t)start + (uint32_t)count > program->stmt_count) {
-        return FW_BC3_ERR_FORMAT;
-    }
-
-    bool local_depends = false;
-    uint16_t i = 0U;
-    while (i < count && !local_depends) {
-        const fw_bc3_stmt_view_t *stmt = &program->statements[start + i];
-        bool uses_x = false;
-        bool uses_y = false;
-        fw_bc3_status_t status = FW_BC3_OK;
-
-        switch (stmt->kind) {
-            case FW_BC3_STMT_LET:
-                status = fw_bc3_expression_scan_input_dependencies(
-                    program,
-                    stmt->as.let_decl.expr_index,
-                    true,
-                    &uses_x,
-                    &uses_y
-                );
-                if (status != FW_BC3_OK) {
-                    return status;
-                }
-                local_depends = uses_x || uses_y;
-                break;
-            case FW_BC3_STMT_BLEND:
-                status = fw_bc3_expression_scan_input_dependencies(
-                    program,
-                    stmt->as.blend.expr_index,
-                    true,
-                    &uses_x,
-                    &uses_y
-                );
-                if (status != FW_BC3_OK) {
-                    return status;
-                }
-                local_depends = uses_x || uses_y;
-                break;
-            case FW_BC3_STMT_IF:
-                status = fw_bc3_expression_scan_input_dependencies(
-                    program,
-                    stmt->as.if_stmt.cond_expr_index,
-                    true,
-                    &uses_x,
-                    &uses_y
-                );
-                if (status != FW_BC3_OK) {
-                    return status;
-                }
-                local_depends = uses_x || uses_y;
-                if (!local_depends) {
-                    status = fw_bc3_statement_block_depends_xy(
-                        program,
-                        stmt->as.if_stmt.then_start,
-                        stmt->as.if_stmt.then_count,
-                        (uint8_t)(depth + 1U),
-                        &local_depends
-                    );
-                    if (status != FW_BC3_OK) {
-                        return status;
-                    }
-                }
-                if (!local_depends) {
-                    status = fw_bc3_statement_block_depends_xy(
-                        program,
-                        stmt->as.if_stmt.else_start,
-                        stmt->as.if_stmt.else_count,
-                        (uint8_t)(depth + 1U),
-                        &local_depends
-                    );
-                    if (status != FW_BC3_OK) {
-                        return status;
-                    }
-                }
-                break;
-            case FW_BC3_STMT_FOR:
-                status = fw_bc3_statement_block_depends_xy(
-                    program,
-                    stmt->as.for_stmt.body_start,
-                    stmt->as.for_stmt.body_count,
-                    (uint8_t)(depth + 1U),
-                    &local_depends
-                );
-                if (status != FW_BC3_OK) {
-                    return status;
-                }
-                break;
-            default:
-                return FW_BC3_ERR_FORMAT;
-        }
-
-        i += 1U;
-    }
-
-    *depends_xy = local_depends;
-    return FW_BC3_OK;
-}
-
-static uint16_t fw_bc3_max_u16(uint16_t a, uint16_t b) {
-    return (a > b) ? a : b;
-}
-
-static fw_bc3_status_t fw_bc3_parse_statement_block(
-    fw_bc3_program_t *program,
-    fw_bc3_cursor_t *cursor,
-    uint8_t depth,
-    fw_bc3_stmt_block_info_t *out
-) {
-    if (depth > FW_BC3_MAX_STATEMENT_DEPTH) {
-        return FW_BC3_ERR_LIMIT;
-    }
-
-    // Each statement block is length-prefixed, then recursively nests child blocks for if/for.
-    uint32_t statement_count = 0;
-    fw_bc3_status_t status = fw_bc3_cursor_read_u32(cursor, &statement_count);
-    if (status != FW_BC3_OK) {
-        return status;
-    }
-    if (statement_count > UINT16_MAX) {
-        return FW_BC3_ERR_LIMIT;
-    }
-    if (program->stmt_count + statement_count > FW_BC3_MAX_STATEMENTS) {
-        return FW_BC3_ERR_LIMIT;
-    }
-
-    out->start = program->stmt_count;
-    out->count = (uint16_t)statement_count;
-    out->max_slot_plus_one = 0;
-
-    uint32_t i = 0;
-    while (i < statement_count) {
-        uint16_t stmt_index = program->stmt_count;
-        program->stmt_count += 1U;
-
-        fw_bc3_stmt_view_t *stmt = &program->statements[stmt_index];
-        uint8_t opcode = 0;
-        status = fw_bc3_cursor_read_u8(cursor, &opcode);
-        if (status != FW_BC3_OK) {
-            return status;
-        }
-
-        if (opcode == FW_BC3_STMT_LET) {
-            uint32_t slot = 0;
-            uint16_t expr_index = 0;
-            status = fw_bc3_cursor_read_u32(cursor, &slot);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            if (slot >= FW_BC3_MAX_LET_SLOTS) {
-                return FW_BC3_ERR_INVALID_SLOT;
-            }
-            status = fw_bc3_parse_expression(program, cursor, &expr_index);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-
-            stmt->kind = FW_BC3_STMT_LET;
-            stmt->as.let_decl.slot = (uint16_t)slot;
-            stmt->as.let_decl.expr_index = expr_index;
-            out->max_slot_plus_one = fw_bc3_max_u16(out->max_slot_plus_one, (uint16_t)(slot + 1U));
-        } else if (opcode == FW_BC3_STMT_BLEND) {
-            uint16_t expr_index = 0;
-            status = fw_bc3_parse_expression(program, cursor, &expr_index);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-
-            stmt->kind = FW_BC3_STMT_BLEND;
-            stmt->as.blend.expr_index = expr_index;
-        } else if (opcode == FW_BC3_STMT_IF) {
-            uint16_t cond_expr = 0;
-            fw_bc3_stmt_block_info_t then_block = {0};
-            fw_bc3_stmt_block_info_t else_block = {0};
-
-            status = fw_bc3_parse_expression(program, cursor, &cond_expr);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            status = fw_bc3_parse_statement_block(program, cursor, (uint8_t)(depth + 1U), &then_block);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            status = fw_bc3_parse_statement_block(program, cursor, (uint8_t)(depth + 1U), &else_block);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-
-            stmt->kind = FW_BC3_STMT_IF;
-            stmt->as.if_stmt.cond_expr_index = cond_expr;
-            stmt->as.if_stmt.then_start = then_block.start;
-            stmt->as.if_stmt.then_count = then_block.count;
-            stmt->as.if_stmt.else_start = else_block.start;
-            stmt->as.if_stmt.else_count = else_block.count;
-
-            out->max_slot_plus_one = fw_bc3_max_u16(out->max_slot_plus_one, then_block.max_slot_plus_one);
-            out->max_slot_plus_one = fw_bc3_max_u16(out->max_slot_plus_one, else_block.max_slot_plus_one);
-        } else if (opcode == FW_BC3_STMT_FOR) {
-            uint32_t index_slot = 0;
-            uint32_t start_inclusive = 0;
-            uint32_t end_exclusive = 0;
-            fw_bc3_stmt_block_info_t body_block = {0};
-
-            status = fw_bc3_cursor_read_u32(cursor, &index_slot);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            status = fw_bc3_cursor_read_u32(cursor, &start_inclusive);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            status = fw_bc3_cursor_read_u32(cursor, &end_exclusive);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            if (index_slot >= FW_BC3_MAX_LET_SLOTS) {
-                return FW_BC3_ERR_INVALID_SLOT;
-            }
-            if (end_exclusive < start_inclusive) {
-                return FW_BC3_ERR_FORMAT;
-            }
-
-            status = fw_bc3_parse_statement_block(program, cursor, (uint8_t)(depth + 1U), &body_block);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-
-            stmt->kind = FW_BC3_STMT_FOR;
-            stmt->as.for_stmt.index_slot = (uint16_t)index_slot;
-            stmt->as.for_stmt.start_inclusive = start_inclusive;
-            stmt->as.for_stmt.end_exclusive = end_exclusive;
-            stmt->as.for_stmt.body_start = body_block.start;
-            stmt->as.for_stmt.body_count = body_block.count;
-
-            out->max_slot_plus_one = fw_bc3_max_u16(out->max_slot_plus_one, (uint16_t)(index_slot + 1U));
-            out->max_slot_plus_one = fw_bc3_max_u16(out->max_slot_plus_one, body_block.max_slot_plus_one);
-        } else {
-            return FW_BC3_ERR_INVALID_OPCODE;
-        }
-
-        i += 1U;
-    }
-
-    return FW_BC3_OK;
-}
-
-fw_bc3_status_t fw_bc3_program_load(fw_bc3_program_t *program, const uint8_t *blob, size_t blob_len) {
-    if (program == NULL || blob == NULL || blob_len < 8U) {
-        return FW_BC3_ERR_INVALID_ARG;
-    }
-
-    memset(program, 0, sizeof(*program));
-    program->blob = blob;
-    program->blob_len = blob_len;
-
-    fw_bc3_cursor_t cursor = {
-        .base = blob,
-        .cur = blob,
-        .end = blob + blob_len,
-    };
-
-    if ((size_t)(cursor.end - cursor.cur) < 4U || memcmp(cursor.cur, "DSLB", 4U) != 0) {
-        return FW_BC3_ERR_BAD_MAGIC;
-    }
-    cursor.cur += 4U;
-
-    uint16_t version = 0;
-    fw_bc3_status_t status = fw_bc3_cursor_read_u16(&cursor, &version);
-    if (status != FW_BC3_OK) {
-        return status;
-    }
-    if (version != FW_BC3_VERSION) {
-        return FW_BC3_ERR_UNSUPPORTED_VERSION;
-    }
-
-    // v3 keeps the reserved u16 directly after version for forward-compatible flags.
-    uint16_t reserved_flags = 0;
-    status = fw_bc3_cursor_read_u16(&cursor, &reserved_flags);
-    if (status != FW_BC3_OK) {
-        return status;
-    }
-    (void)reserved_flags;
-
-    uint32_t param_count = 0;
-    status = fw_bc3_cursor_read_u32(&cursor, &param_count);
-    if (status != FW_BC3_OK) {
-        return status;
-    }
-    if (param_count > FW_BC3_MAX_PARAMS) {
-        return FW_BC3_ERR_LIMIT;
-    }
-    program->param_count = (uint16_t)param_count;
-
-    uint32_t param_index = 0;
-    while (param_index < param_count) {
-        uint8_t depends_on_xy = 0;
-        uint16_t expr_index = 0;
-        bool depends_on_x = false;
-        bool depends_on_y = false;
-        status = fw_bc3_cursor_read_u8(&cursor, &depends_on_xy);
-        if (status != FW_BC3_OK) {
-            return status;
-        }
-        if (depends_on_xy > 1U) {
-            return FW_BC3_ERR_FORMAT;
-        }
-
-        status = fw_bc3_parse_expression(program, &cursor, &expr_index);
-        if (status != FW_BC3_OK) {
-            return status;
-        }
-        status = fw_bc3_expression_scan_input_dependencies(program, expr_index, false, &depends_on_x, &depends_on_y);
-        if (status != FW_BC3_OK) {
-            return status;
-        }
-
-        // Keep legacy combined flag for compatibility while using fine-grained runtime flags.
-        program->param_depends_xy[param_index] = (depends_on_x || depends_on_y) ? 1U : 0U;
-        program->param_depends_x[param_index] = depends_on_x ? 1U : 0U;
-        program->param_depends_y[param_index] = depends_on_y ? 1U : 0U;
-        program->param_expr[param_index] = expr_index;
-        param_index += 1U;
-    }
-
-    fw_bc3_stmt_block_info_t frame_block = {0};
-    status = fw_bc3_parse_statement_block(program, &cursor, 0, &frame_block);
-    if (status != FW_BC3_OK) {
-        return status;
-    }
-    program->frame_stmt_start = frame_block.start;
-    program->frame_stmt_count = frame_block.count;
-    program->frame_let_count = frame_block.max_slot_plus_one;
-
-    uint32_t layer_count = 0;
-    status = fw_bc3_cursor_read_u32(&cursor, &layer_count);
-    if (status != FW_BC3_OK) {
-        return status;
-    }
-    if (layer_count > FW_BC3_MAX_LAYERS) {
-        return FW_BC3_ERR_LIMIT;
-    }
-    program->layer_count = (uint16_t)layer_count;
-
-    uint32_t layer_index = 0;
-    while (layer_index < layer_count) {
-        fw_bc3_stmt_block_info_t layer_block = {0};
-        status = fw_bc3_parse_statement_block(program, &cursor, 0, &layer_block);
-        if (status != FW_BC3_OK) {
-            return status;
-        }
-        program->layer_stmt_start[layer_index] = layer_block.start;
-        program->layer_stmt_count[layer_index] = layer_block.count;
-        program->layer_let_count[layer_index] = layer_block.max_slot_plus_one;
-        layer_index += 1U;
-    }
-
-    layer_index = 0;
-    while (layer_index < layer_count) {
-        bool layer_depends_xy = false;
-        status = fw_bc3_statement_block_depends_xy(
-            program,
-            program->layer_stmt_start[layer_index],
-            program->layer_stmt_count[layer_index],
-            0,
-            &layer_depends_xy
-        );
-        if (status != FW_BC3_OK) {
-            return status;
-        }
-        if (layer_depends_xy) {
-            program->pixel_depends_xy = 1U;
-            break;
-        }
-        layer_index += 1U;
-    }
-
-    if (cursor.cur != cursor.end) {
-        return FW_BC3_ERR_FORMAT;
-    }
-
-    return FW_BC3_OK;
-}
-
-static float IRAM_ATTR fw_bc3_clamp01(float value) {
-    if (value < 0.0f) {
-        return 0.0f;
-    }
-    if (value > 1.0f) {
-        return 1.0f;
-    }
-    return value;
-}
-
-static float IRAM_ATTR fw_bc3_linearstep(float edge0, float edge1, float x) {
-    if (edge0 == edge1) {
-        return (x < edge0) ? 0.0f : 1.0f;
-    }
-    return fw_bc3_clamp01((x - edge0) / (edge1 - edge0));
-}
-
-static float IRAM_ATTR fw_bc3_smoothstep(float edge0, float edge1, float x) {
-    const float t = fw_bc3_linearstep(edge0, edge1, x);
-    return t * t * (3.0f - (2.0f * t));
-}
-
-static uint32_t fw_bc3_hash_u32(uint32_t value) {
-    uint32_t x = value;
-    x ^= x >> 16U;
-    x *= 0x7feb352dU;
-    x ^= x >> 15U;
-    x *= 0x846ca68bU;
-    x ^= x >> 16U;
-    return x;
-}
-
-static uint32_t fw_bc3_bitcast_u32_from_i32(int32_t value) {
-    uint32_t out = 0;
-    memcpy(&out, &value, sizeof(out));
-    return out;
-}
-
-static int32_t fw_bc3_scalar_to_i32(float value) {
-    const float min_i32 = (float)INT32_MIN;
-    const float max_i32 = (float)INT32_MAX;
-    if (value < min_i32) {
-        value = min_i32;
-    }
-    if (value > max_i32) {
-        value = max_i32;
-    }
-    return (int32_t)value;
-}
-
-static uint32_t fw_bc3_scalar_to_u32(float value) {
-    return fw_bc3_bitcast_u32_from_i32(fw_bc3_scalar_to_i32(value));
-}
-
-static float fw_bc3_hash01(uint32_t value) {
-    const uint32_t hashed = fw_bc3_hash_u32(value) & 0x00ffffffU;
-    return (float)hashed / 16777215.0f;
-}
-
-static float fw_bc3_hash_signed(uint32_t value) {
-    return (fw_bc3_hash01(value) * 2.0f) - 1.0f;
-}
-
-static float fw_bc3_hash_coords01(int32_t x, int32_t y, uint32_t seed) {
-    const uint32_t ux = fw_bc3_bitcast_u32_from_i32(x);
-    const uint32_t uy = fw_bc3_bitcast_u32_from_i32(y);
-    const uint32_t mixed = (ux * 0x1f123bb5U) ^ (uy * 0x5f356495U) ^ seed;
-    return fw_bc3_hash01(mixed);
-}
-
-static float fw_bc3_vec2_length(fw_bc3_vec2_t vec) {
-    return dsl_fast_sqrtf((vec.x * vec.x) + (vec.y * vec.y));
-}
-
-static float fw_bc3_wrapped_delta_x(float px, float center_x, float width) {
-    float dx = px - center_x;
-    const float half_width = width * 0.5f;
-    if (dx > half_width) {
-        dx -= width;
-    }
-    if (dx < -half_width) {
-        dx += width;
-    }
-    return dx;
-}
-
-static float fw_bc3_fast_sin(float x) {
-    return dsl_fast_sinf(x);
-}
-
-static float fw_bc3_fast_cos(float x) {
-    return dsl_fast_cosf(x);
-}
-
-// --- Simplex noise (matches dsl_c_emitter.zig preamble) ---
-
-static const unsigned char fw_bc3_noise_perm[512] = {
-    151,160,137,91,90,15,131,13,201,95,96,53,194,233,7,225,
-    140,36,103,30,69,142,8,99,37,240,21,10,23,190,6,148,
-    247,120,234,75,0,26,197,62,94,252,219,203,117,35,11,32,
-    57,177,33,88,237,149,56,87,174,20,125,136,171,168,68,175,
-    74,165,71,134,139,48,27,166,77,146,158,231,83,111,229,122,
-    60,211,133,230,220,105,92,41,55,46,245,40,244,102,143,54,
-    65,25,63,161,1,216,80,73,209,76,132,187,208,89,18,169,
-    200,196,135,130,116,188,159,86,164,100,109,198,173,186,3,64,
-    52,217,226,250,124,123,5,202,38,147,118,126,255,82,85,212,
-    207,206,59,227,47,16,58,17,182,189,28,42,223,183,170,213,
-    119,248,152,2,44,154,163,70,221,153,101,155,167,43,172,9,
-    129,22,39,253,19,98,108,110,79,113,224,232,178,185,112,104,
-    218,246,97,228,251,34,242,193,238,210,144,12,191,179,162,241,
-    81,51,145,235,249,14,239,107,49,192,214,31,181,199,106,157,
-    184,84,204,176,115,121,50,45,127,4,150,254,138,236,205,93,
-    222,114,67,29,24,72,243,141,128,195,78,66,215,61,156,180,
-    151,160,137,91,90,15,131,13,201,95,96,53,194,233,7,225,
-    140,36,103,30,69,142,8,99,37,240,21,10,23,190,6,148,
-    247,120,234,75,0,26,197,62,94,252,219,203,117,35,11,32,
-    57,177,33,88,237,149,56,87,174,20,125,136,171,168,68,175,
-    74,165,71,134,139,48,27,166,77,146,158,231,83,111,229,122,
-    60,211,133,230,220,105,92,41,55,46,245,40,244,102,143,54,
-    65,25,63,161,1,216,80,73,209,76,132,187,208,89,18,169,
-    200,196,135,130,116,188,159,86,164,100,109,198,173,186,3,64,
-    52,217,226,250,124,123,5,202,38,147,118,126,255,82,85,212,
-    207,206,59,227,47,16,58,17,182,189,28,42,223,183,170,213,
-    119,248,152,2,44,154,163,70,221,153,101,155,167,43,172,9,
-    129,22,39,253,19,98,108,110,79,113,224,232,178,185,112,104,
-    218,246,97,228,251,34,242,193,238,210,144,12,191,179,162,241,
-    81,51,145,235,249,14,239,107,49,192,214,31,181,199,106,157,
-    184,84,204,176,115,121,50,45,127,4,150,254,138,236,205,93,
-    222,114,67,29,24,72,243,141,128,195,78,66,215,61,156,180,
-};
-
-static inline float fw_bc3_grad2(int hash, float x, float y) {
-    const int h = hash & 7;
-    const float u = h < 4 ? x : y;
-    const float v = h < 4 ? y : x;
-    return ((h & 1) ? -u : u) + ((h & 2) ? -2.0f * v : 2.0f * v);
-}
-
-static inline float fw_bc3_noise2(float x, float y) {
-    const float F2 = 0.3660254037844386f;
-    const float G2 = 0.21132486540518713f;
-    const float s = (x + y) * F2;
-    const int i = (int)floorf(x + s);
-    const int j = (int)floorf(y + s);
-    const float t = (float)(i + j) * G2;
-    const float x0 = x - ((float)i - t);
-    const float y0 = y - ((float)j - t);
-    int i1, j1;
-    if (x0 > y0) { i1 = 1; j1 = 0; } else { i1 = 0; j1 = 1; }
-    const float x1 = x0 - (float)i1 + G2;
-    const float y1 = y0 - (float)j1 + G2;
-    const float x2 = x0 - 1.0f + 2.0f * G2;
-    const float y2 = y0 - 1.0f + 2.0f * G2;
-    const int ii = i & 255;
-    const int jj = j & 255;
-    float n = 0.0f;
-    float t0 = 0.5f - x0*x0 - y0*y0;
-    if (t0 >= 0.0f) { t0 *= t0; n += t0 * t0 * fw_bc3_grad2(fw_bc3_noise_perm[ii + fw_bc3_noise_perm[jj]], x0, y0); }
-    float t1 = 0.5f - x1*x1 - y1*y1;
-    if (t1 >= 0.0f) { t1 *= t1; n += t1 * t1 * fw_bc3_grad2(fw_bc3_noise_perm[ii + i1 + fw_bc3_noise_perm[jj + j1]], x1, y1); }
-    float t2 = 0.5f - x2*x2 - y2*y2;
-    if (t2 >= 0.0f) { t2 *= t2; n += t2 * t2 * fw_bc3_grad2(fw_bc3_noise_perm[ii + 1 + fw_bc3_noise_perm[jj + 1]], x2, y2); }
-    return 70.0f * n;
-}
-
-static inline float fw_bc3_grad3(int hash, float x, float y, float z) {
-    const int h = hash & 15;
-    const float u = h < 8 ? x : y;
-    const float v = h < 4 ? y : (h == 12 || h == 14 ? x : z);
-    return ((h & 1) ? -u : u) + ((h & 2) ? -v : v);
-}
-
-static inline float fw_bc3_noise3(float x, float y, float z) {
-    const float F3 = 1.0f / 3.0f;
-    const float G3 = 1.0f / 6.0f;
-    const float s = (x + y + z) * F3;
-    const int i = (int)floorf(x + s);
-    const int j = (int)floorf(y + s);
-    const int k = (int)floorf(z + s);
-    const float t = (float)(i + j + k) * G3;
-    const float x0 = x - ((float)i - t);
-    const float y0 = y - ((float)j - t);
-    const float z0 = z - ((float)k - t);
-    int i1, j1, k1, i2, j2, k2;
-    if (x0 >= y0) {
-        if (y0 >= z0) { i1=1;j1=0;k1=0;i2=1;j2=1;k2=0; }
-        else if (x0 >= z0) { i1=1;j1=0;k1=0;i2=1;j2=0;k2=1; }
-        else { i1=0;j1=0;k1=1;i2=1;j2=0;k2=1; }
-    } else {
-        if (y0 < z0) { i1=0;j1=0;k1=1;i2=0;j2=1;k2=1; }
-        else if (x0 < z0) { i1=0;j1=1;k1=0;i2=0;j2=1;k2=1; }
-        else { i1=0;j1=1;k1=0;i2=1;j2=1;k2=0; }
-    }
-    const float x1 = x0 - (float)i1 + G3;
-    const float y1 = y0 - (float)j1 + G3;
-    const float z1 = z0 - (float)k1 + G3;
-    const float x2 = x0 - (float)i2 + 2.0f*G3;
-    const float y2 = y0 - (float)j2 + 2.0f*G3;
-    const float z2 = z0 - (float)k2 + 2.0f*G3;
-    const float x3 = x0 - 1.0f + 3.0f*G3;
-    const float y3 = y0 - 1.0f + 3.0f*G3;
-    const float z3 = z0 - 1.0f + 3.0f*G3;
-    const int ii = i & 255;
-    const int jj = j & 255;
-    const int kk = k & 255;
-    float n = 0.0f;
-    float c0 = 0.6f - x0*x0 - y0*y0 - z0*z0;
-    if (c0 >= 0.0f) { c0 *= c0; n += c0*c0*fw_bc3_grad3(fw_bc3_noise_perm[ii+fw_bc3_noise_perm[jj+fw_bc3_noise_perm[kk]]], x0, y0, z0); }
-    float c1 = 0.6f - x1*x1 - y1*y1 - z1*z1;
-    if (c1 >= 0.0f) { c1 *= c1; n += c1*c1*fw_bc3_grad3(fw_bc3_noise_perm[ii+i1+fw_bc3_noise_perm[jj+j1+fw_bc3_noise_perm[kk+k1]]], x1, y1, z1); }
-    float c2 = 0.6f - x2*x2 - y2*y2 - z2*z2;
-    if (c2 >= 0.0f) { c2 *= c2; n += c2*c2*fw_bc3_grad3(fw_bc3_noise_perm[ii+i2+fw_bc3_noise_perm[jj+j2+fw_bc3_noise_perm[kk+k2]]], x2, y2, z2); }
-    float c3 = 0.6f - x3*x3 - y3*y3 - z3*z3;
-    if (c3 >= 0.0f) { c3 *= c3; n += c3*c3*fw_bc3_grad3(fw_bc3_noise_perm[ii+1+fw_bc3_noise_perm[jj+1+fw_bc3_noise_perm[kk+1]]], x3, y3, z3); }
-    return 32.0f * n;
-}
-
-static fw_bc3_color_t fw_bc3_color_clamped(fw_bc3_color_t color) {
-    fw_bc3_color_t out = color;
-    out.r = fw_bc3_clamp01(out.r);
-    out.g = fw_bc3_clamp01(out.g);
-    out.b = fw_bc3_clamp01(out.b);
-    out.a = fw_bc3_clamp01(out.a);
-    return out;
-}
-
-static fw_bc3_color_t IRAM_ATTR fw_bc3_blend_over(fw_bc3_color_t src, fw_bc3_color_t dst) {
-    const fw_bc3_color_t s = fw_bc3_color_clamped(src);
-    const fw_bc3_color_t d = fw_bc3_color_clamped(dst);
-    const float out_a = s.a + (d.a * (1.0f - s.a));
-    if (out_a <= 0.000001f) {
-        return (fw_bc3_color_t){
-            .r = 0.0f,
-            .g = 0.0f,
-            .b = 0.0f,
-            .a = 0.0f,
-        };
-    }
-
-    const float inv_out_a = 1.0f / out_a;
-    return (fw_bc3_color_t){
-        .r = ((s.r * s.a) + (d.r * d.a * (1.0f - s.a))) * inv_out_a,
-        .g = ((s.g * s.a) + (d.g * d.a * (1.0f - s.a))) * inv_out_a,
-        .b = ((s.b * s.a) + (d.b * d.a * (1.0f - s.a))) * inv_out_a,
-        .a = out_a,
-    };
-}
-
-static fw_bc3_status_t fw_bc3_value_as_scalar(const fw_bc3_value_t *value, float *out) {
-    if (value->tag != FW_BC3_VALUE_SCALAR) {
-        return FW_BC3_ERR_TYPE_MISMATCH;
-    }
-    *out = value->as.scalar;
-    return FW_BC3_OK;
-}
-
-static fw_bc3_status_t fw_bc3_value_as_vec2(const fw_bc3_value_t *value, fw_bc3_vec2_t *out) {
-    if (value->tag != FW_BC3_VALUE_VEC2) {
-        return FW_BC3_ERR_TYPE_MISMATCH;
-    }
-    *out = value->as.vec2;
-    return FW_BC3_OK;
-}
-
-static fw_bc3_status_t fw_bc3_eval_builtin(
-    uint8_t builtin,
-    const fw_bc3_value_t *args,
-    uint8_t arg_count,
-    fw_bc3_value_t *out
-) {
-    if (builtin >= FW_BC3_BUILTIN_COUNT) {
-        return FW_BC3_ERR_INVALID_BUILTIN;
-    }
-
-    float a0 = 0.0f;
-    float a1 = 0.0f;
-    float a2 = 0.0f;
-    fw_bc3_vec2_t v0 = {0};
-    fw_bc3_vec2_t v1 = {0};
-    fw_bc3_status_t status = FW_BC3_OK;
-
-    switch ((fw_bc3_builtin_id_t)builtin) {
-        case FW_BC3_BUILTIN_SIN:
-            if (arg_count != 1U) {
-                return FW_BC3_ERR_FORMAT;
-            }
-            status = fw_bc3_value_as_scalar(&args[0], &a0);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            *out = fw_bc3_make_scalar(fw_bc3_fast_sin(a0));
-            return FW_BC3_OK;
-        case FW_BC3_BUILTIN_COS:
-            if (arg_count != 1U) {
-                return FW_BC3_ERR_FORMAT;
-            }
-            status = fw_bc3_value_as_scalar(&args[0], &a0);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            *out = fw_bc3_make_scalar(fw_bc3_fast_cos(a0));
-            return FW_BC3_OK;
-        case FW_BC3_BUILTIN_SQRT:
-            if (arg_count != 1U) {
-                return FW_BC3_ERR_FORMAT;
-            }
-            status = fw_bc3_value_as_scalar(&args[0], &a0);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            *out = fw_bc3_make_scalar(dsl_fast_sqrtf(a0));
-            return FW_BC3_OK;
-        case FW_BC3_BUILTIN_LN:
-            if (arg_count != 1U) {
-                return FW_BC3_ERR_FORMAT;
-            }
-            status = fw_bc3_value_as_scalar(&args[0], &a0);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            *out = fw_bc3_make_scalar(dsl_fast_logf(a0));
-            return FW_BC3_OK;
-        case FW_BC3_BUILTIN_LOG:
-            if (arg_count != 1U) {
-                return FW_BC3_ERR_FORMAT;
-            }
-            status = fw_bc3_value_as_scalar(&args[0], &a0);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            *out = fw_bc3_make_scalar(dsl_fast_log10f(a0));
-            return FW_BC3_OK;
-        case FW_BC3_BUILTIN_ABS:
-            if (arg_count != 1U) {
-                return FW_BC3_ERR_FORMAT;
-            }
-            status = fw_bc3_value_as_scalar(&args[0], &a0);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            *out = fw_bc3_make_scalar(fabsf(a0));
-            return FW_BC3_OK;
-        case FW_BC3_BUILTIN_FLOOR:
-            if (arg_count != 1U) {
-                return FW_BC3_ERR_FORMAT;
-            }
-            status = fw_bc3_value_as_scalar(&args[0], &a0);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            *out = fw_bc3_make_scalar(dsl_fast_floorf(a0));
-            return FW_BC3_OK;
-        case FW_BC3_BUILTIN_FRACT:
-            if (arg_count != 1U) {
-                return FW_BC3_ERR_FORMAT;
-            }
-            status = fw_bc3_value_as_scalar(&args[0], &a0);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            *out = fw_bc3_make_scalar(a0 - dsl_fast_floorf(a0));
-            return FW_BC3_OK;
-        case FW_BC3_BUILTIN_MIN:
-            if (arg_count != 2U) {
-                return FW_BC3_ERR_FORMAT;
-            }
-            status = fw_bc3_value_as_scalar(&args[0], &a0);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            status = fw_bc3_value_as_scalar(&args[1], &a1);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            *out = fw_bc3_make_scalar(fminf(a0, a1));
-            return FW_BC3_OK;
-        case FW_BC3_BUILTIN_MAX:
-            if (arg_count != 2U) {
-                return FW_BC3_ERR_FORMAT;
-            }
-            status = fw_bc3_value_as_scalar(&args[0], &a0);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            status = fw_bc3_value_as_scalar(&args[1], &a1);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            *out = fw_bc3_make_scalar(fmaxf(a0, a1));
-            return FW_BC3_OK;
-        case FW_BC3_BUILTIN_CLAMP:
-            if (arg_count != 3U) {
-                return FW_BC3_ERR_FORMAT;
-            }
-            status = fw_bc3_value_as_scalar(&args[0], &a0);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            status = fw_bc3_value_as_scalar(&args[1], &a1);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            status = fw_bc3_value_as_scalar(&args[2], &a2);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            *out = fw_bc3_make_scalar(fminf(fmaxf(a0, a1), a2));
-            return FW_BC3_OK;
-        case FW_BC3_BUILTIN_SMOOTHSTEP:
-            if (arg_count != 3U) {
-                return FW_BC3_ERR_FORMAT;
-            }
-            status = fw_bc3_value_as_scalar(&args[0], &a0);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            status = fw_bc3_value_as_scalar(&args[1], &a1);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            status = fw_bc3_value_as_scalar(&args[2], &a2);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            *out = fw_bc3_make_scalar(fw_bc3_smoothstep(a0, a1, a2));
-            return FW_BC3_OK;
-        case FW_BC3_BUILTIN_CIRCLE:
-            if (arg_count != 2U) {
-                return FW_BC3_ERR_FORMAT;
-            }
-            status = fw_bc3_value_as_vec2(&args[0], &v0);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            status = fw_bc3_value_as_scalar(&args[1], &a0);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            *out = fw_bc3_make_scalar(fw_bc3_vec2_length(v0) - a0);
-            return FW_BC3_OK;
-        case FW_BC3_BUILTIN_BOX: {
-            fw_bc3_vec2_t q = {0};
-            fw_bc3_vec2_t outside = {0};
-            float inside = 0.0f;
-
-            if (arg_count != 2U) {
-                return FW_BC3_ERR_FORMAT;
-            }
-            status = fw_bc3_value_as_vec2(&args[0], &v0);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            status = fw_bc3_value_as_vec2(&args[1], &v1);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-
-            q.x = fabsf(v0.x) - v1.x;
-            q.y = fabsf(v0.y) - v1.y;
-            outside.x = (q.x > 0.0f) ? q.x : 0.0f;
-            outside.y = (q.y > 0.0f) ? q.y : 0.0f;
-            inside = fminf(fmaxf(q.x, q.y), 0.0f);
-            *out = fw_bc3_make_scalar(fw_bc3_vec2_length(outside) + inside);
-            return FW_BC3_OK;
-        }
-        case FW_BC3_BUILTIN_WRAPDX:
-            if (arg_count != 3U) {
-                return FW_BC3_ERR_FORMAT;
-            }
-            status = fw_bc3_value_as_scalar(&args[0], &a0);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            status = fw_bc3_value_as_scalar(&args[1], &a1);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            status = fw_bc3_value_as_scalar(&args[2], &a2);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            *out = fw_bc3_make_scalar(fw_bc3_wrapped_delta_x(a0, a1, a2));
-            return FW_BC3_OK;
-        case FW_BC3_BUILTIN_HASH01:
-            if (arg_count != 1U) {
-                return FW_BC3_ERR_FORMAT;
-            }
-            status = fw_bc3_value_as_scalar(&args[0], &a0);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            *out = fw_bc3_make_scalar(fw_bc3_hash01(fw_bc3_scalar_to_u32(a0)));
-            return FW_BC3_OK;
-        case FW_BC3_BUILTIN_HASH_SIGNED:
-            if (arg_count != 1U) {
-                return FW_BC3_ERR_FORMAT;
-            }
-            status = fw_bc3_value_as_scalar(&args[0], &a0);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            *out = fw_bc3_make_scalar(fw_bc3_hash_signed(fw_bc3_scalar_to_u32(a0)));
-            return FW_BC3_OK;
-        case FW_BC3_BUILTIN_HASH_COORDS01:
-            if (arg_count != 3U) {
-                return FW_BC3_ERR_FORMAT;
-            }
-            status = fw_bc3_value_as_scalar(&args[0], &a0);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            status = fw_bc3_value_as_scalar(&args[1], &a1);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            status = fw_bc3_value_as_scalar(&args[2], &a2);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            *out = fw_bc3_make_scalar(
-                fw_bc3_hash_coords01(fw_bc3_scalar_to_i32(a0), fw_bc3_scalar_to_i32(a1), fw_bc3_scalar_to_u32(a2))
-            );
-            return FW_BC3_OK;
-        case FW_BC3_BUILTIN_POW:
-            if (arg_count != 2U) {
-                return FW_BC3_ERR_FORMAT;
-            }
-            status = fw_bc3_value_as_scalar(&args[0], &a0);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            status = fw_bc3_value_as_scalar(&args[1], &a1);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            *out = fw_bc3_make_scalar(powf(a0, a1));
-            return FW_BC3_OK;
-        case FW_BC3_BUILTIN_NOISE:
-            if (arg_count != 2U) {
-                return FW_BC3_ERR_FORMAT;
-            }
-            status = fw_bc3_value_as_scalar(&args[0], &a0);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            status = fw_bc3_value_as_scalar(&args[1], &a1);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            *out = fw_bc3_make_scalar(fw_bc3_noise2(a0, a1));
-            return FW_BC3_OK;
-        case FW_BC3_BUILTIN_NOISE3:
-            if (arg_count != 3U) {
-                return FW_BC3_ERR_FORMAT;
-            }
-            status = fw_bc3_value_as_scalar(&args[0], &a0);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            status = fw_bc3_value_as_scalar(&args[1], &a1);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            status = fw_bc3_value_as_scalar(&args[2], &a2);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            *out = fw_bc3_make_scalar(fw_bc3_noise3(a0, a1, a2));
-            return FW_BC3_OK;
-        case FW_BC3_BUILTIN_PHASOR:
-            /* Phasor requires persistent state; returns 0 in bytecode VM. */
-            *out = fw_bc3_make_scalar(0.0f);
-            return FW_BC3_OK;
-        case FW_BC3_BUILTIN_VEC2:
-            if (arg_count != 2U) {
-                return FW_BC3_ERR_FORMAT;
-            }
-            status = fw_bc3_value_as_scalar(&args[0], &a0);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            status = fw_bc3_value_as_scalar(&args[1], &a1);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            out->tag = FW_BC3_VALUE_VEC2;
-            out->as.vec2.x = a0;
-            out->as.vec2.y = a1;
-            return FW_BC3_OK;
-        case FW_BC3_BUILTIN_RGBA:
-            if (arg_count != 4U) {
-                return FW_BC3_ERR_FORMAT;
-            }
-            status = fw_bc3_value_as_scalar(&args[0], &a0);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            status = fw_bc3_value_as_scalar(&args[1], &a1);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            status = fw_bc3_value_as_scalar(&args[2], &a2);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            {
-                float a3 = 0.0f;
-                status = fw_bc3_value_as_scalar(&args[3], &a3);
-                if (status != FW_BC3_OK) {
-                    return status;
-                }
-                out->tag = FW_BC3_VALUE_RGBA;
-                out->as.rgba = (fw_bc3_color_t){
-                    .r = a0,
-                    .g = a1,
-                    .b = a2,
-                    .a = a3,
-                };
-            }
-            return FW_BC3_OK;
-        default:
-            return FW_BC3_ERR_INVALID_BUILTIN;
-    }
-}
-
-static void fw_bc3_reset_value_slots(fw_bc3_value_t *values, uint16_t count) {
-    uint16_t i = 0;
-    while (i < count) {
-        values[i] = fw_bc3_make_scalar(0.0f);
-        i += 1U;
-    }
-}
-
-
-static fw_bc3_status_t __attribute__((flatten)) IRAM_ATTR fw_bc3_eval_expression(
-    fw_bc3_runtime_t *runtime,
-    uint16_t expr_index,
-    const fw_bc3_inputs_t *inputs,
-    uint16_t let_limit,
-    fw_bc3_value_t *out
-) {
-    if (expr_index >= runtime->program->expr_count) {
-        return FW_BC3_ERR_FORMAT;
-    }
-
-    const fw_bc3_decoded_op_t *op = &runtime->program->decoded_ops[runtime->program->expr_op_start[expr_index]];
-    fw_bc3_value_t *stack = runtime->expr_stack;
-    uint16_t sp = 0;
-
-    // Computed-goto dispatch table — contiguous enum values 0..29 for a compact jump table.
-    static const void *dispatch_table[] = {
-        [FW_BC3_DOP_PUSH_SCALAR_LIT] = &&dop_push_scalar_lit,
-        [FW_BC3_DOP_PUSH_INPUT]      = &&dop_push_input,
-        [FW_BC3_DOP_PUSH_PARAM]      = &&dop_push_param,
-        [FW_BC3_DOP_PUSH_FRAME_LET]  = &&dop_push_frame_let,
-        [FW_BC3_DOP_PUSH_LET]        = &&dop_push_let,
-        [FW_BC3_DOP_NEGATE]          = &&dop_negate,
-        [FW_BC3_DOP_ADD]             = &&dop_add,
-        [FW_BC3_DOP_SUB]             = &&dop_sub,
-        [FW_BC3_DOP_MUL]             = &&dop_mul,
-        [FW_BC3_DOP_DIV]             = &&dop_div,
-        [FW_BC3_DOP_MOD]             = &&dop_mod,
-        [FW_BC3_DOP_CALL_BUILTIN]    = &&dop_call_builtin,
-        [FW_BC3_DOP_BUILTIN_SIN]     = &&dop_sin,
-        [FW_BC3_DOP_BUILTIN_COS]     = &&dop_cos,
-        [FW_BC3_DOP_BUILTIN_SQRT]    = &&dop_sqrt,
-        [FW_BC3_DOP_BUILTIN_ABS]     = &&dop_abs,
-        [FW_BC3_DOP_BUILTIN_FLOOR]   = &&dop_floor,
-        [FW_BC3_DOP_BUILTIN_FRACT]   = &&dop_fract,
-        [FW_BC3_DOP_BUILTIN_LN]      = &&dop_ln,
-        [FW_BC3_DOP_BUILTIN_LOG]     = &&dop_log,
-        [FW_BC3_DOP_BUILTIN_MIN]     = &&dop_min,
-        [FW_BC3_DOP_BUILTIN_MAX]     = &&dop_max,
-        [FW_BC3_DOP_BUILTIN_CLAMP]   = &&dop_clamp,
-        [FW_BC3_DOP_BUILTIN_SMOOTHSTEP] = &&dop_smoothstep,
-        [FW_BC3_DOP_BUILTIN_POW]     = &&dop_pow,
-        [FW_BC3_DOP_BUILTIN_NOISE]   = &&dop_noise,
-        [FW_BC3_DOP_BUILTIN_NOISE3]  = &&dop_noise3,
-        [FW_BC3_DOP_BUILTIN_PHASOR]  = &&dop_phasor,
-        [FW_BC3_DOP_BUILTIN_VEC2]    = &&dop_vec2,
-        [FW_BC3_DOP_BUILTIN_RGBA]    = &&dop_rgba,
-        [FW_BC3_DOP_HALT]            = &&dop_halt,
-    };
-
-#define NEXT() do { ++op; goto *dispatch_table[op->op]; } while(0)
-
-    goto *dispatch_table[op->op];
-
-dop_push_scalar_lit:
-    stack[sp].tag = FW_BC3_VALUE_SCALAR;
-    stack[sp].as.scalar = op->scalar;
-    sp++;
-    NEXT();
-dop_push_input:
-    stack[sp].tag = FW_BC3_VALUE_SCALAR;
-    stack[sp].as.scalar = ((const float *)inputs)[op->index];
-    sp++;
-    NEXT();
-dop_push_param:
-    stack[sp].tag = FW_BC3_VALUE_SCALAR;
-    stack[sp].as.scalar = runtime->param_values[op->index];
-    sp++;
-    NEXT();
-dop_push_frame_let:
-    stack[sp] = runtime->frame_values[op->index];
-    sp++;
-    NEXT();
-dop_push_let:
-    if (op->index >= let_limit) {
-        return FW_BC3_ERR_INVALID_SLOT;
-    }
-    stack[sp] = runtime->let_values[op->index];
-    sp++;
-    NEXT();
-dop_negate:
-    stack[sp - 1].as.scalar = -(stack[sp - 1].as.scalar);
-    NEXT();
-dop_add:
-    stack[sp - 2].as.scalar = stack[sp - 2].as.scalar + stack[sp - 1].as.scalar;
-    sp--;
-    NEXT();
-dop_sub:
-    stack[sp - 2].as.scalar = stack[sp - 2].as.scalar - stack[sp - 1].as.scalar;
-    sp--;
-    NEXT();
-dop_mul:
-    stack[sp - 2].as.scalar = stack[sp - 2].as.scalar * stack[sp - 1].as.scalar;
-    sp--;
-    NEXT();
-dop_div: {
-    float rhs = stack[sp - 1].as.scalar;
-    float lhs = stack[sp - 2].as.scalar;
-    stack[sp - 2].as.scalar = (rhs != 0.0f) ? (lhs / rhs) : ((lhs >= 0.0f) ? FLT_MAX : -FLT_MAX);
-    sp--;
-    NEXT();
-}
-dop_mod: {
-    float rhs = stack[sp - 1].as.scalar;
-    float lhs = stack[sp - 2].as.scalar;
-    stack[sp - 2].as.scalar = (rhs != 0.0f) ? fmodf(lhs, rhs) : 0.0f;
-    sp--;
-    NEXT();
-}
-dop_call_builtin: {
-    fw_bc3_value_t result = {0};
-    fw_bc3_status_t status = fw_bc3_eval_builtin(
-        op->builtin, &stack[sp - op->arg_count], op->arg_count, &result
-    );
-    if (status != FW_BC3_OK) {
-        return status;
-    }
-    sp = sp - op->arg_count;
-    stack[sp] = result;
-    sp++;
-    NEXT();
-}
-dop_sin:
-    stack[sp - 1].as.scalar = fw_bc3_fast_sin(stack[sp - 1].as.scalar);
-    NEXT();
-dop_cos:
-    stack[sp - 1].as.scalar = fw_bc3_fast_cos(stack[sp - 1].as.scalar);
-    NEXT();
-dop_sqrt:
-    stack[sp - 1].as.scalar = dsl_fast_sqrtf(stack[sp - 1].as.scalar);
-    NEXT();
-dop_abs:
-    stack[sp - 1].as.scalar = fabsf(stack[sp - 1].as.scalar);
-    NEXT();
-dop_floor:
-    stack[sp - 1].as.scalar = dsl_fast_floorf(stack[sp - 1].as.scalar);
-    NEXT();
-dop_fract: {
-    float x = stack[sp - 1].as.scalar;
-    stack[sp - 1].as.scalar = x - dsl_fast_floorf(x);
-    NEXT();
-}
-dop_ln:
-    stack[sp - 1].as.scalar = dsl_fast_logf(stack[sp - 1].as.scalar);
-    NEXT();
-dop_log:
-    stack[sp - 1].as.scalar = dsl_fast_log10f(stack[sp - 1].as.scalar);
-    NEXT();
-dop_min:
-    stack[sp - 2].as.scalar = fminf(stack[sp - 2].as.scalar, stack[sp - 1].as.scalar);
-    sp--;
-    NEXT();
-dop_max:
-    stack[sp - 2].as.scalar = fmaxf(stack[sp - 2].as.scalar, stack[sp - 1].as.scalar);
-    sp--;
-    NEXT();
-dop_clamp: {
-    float x = stack[sp - 3].as.scalar;
-    float lo = stack[sp - 2].as.scalar;
-    float hi = stack[sp - 1].as.scalar;
-    stack[sp - 3].as.scalar = fminf(fmaxf(x, lo), hi);
-    sp -= 2;
-    NEXT();
-}
-dop_smoothstep: {
-    float edge0 = stack[sp - 3].as.scalar;
-    float edge1 = stack[sp - 2].as.scalar;
-    float x = stack[sp - 1].as.scalar;
-    stack[sp - 3].as.scalar = fw_bc3_smoothstep(edge0, edge1, x);
-    sp -= 2;
-    NEXT();
-}
-dop_pow: {
-    float base = stack[sp - 2].as.scalar;
-    float exp = stack[sp - 1].as.scalar;
-    stack[sp - 2].as.scalar = powf(base, exp);
-    sp--;
-    NEXT();
-}
-dop_noise: {
-    float nx = stack[sp - 2].as.scalar;
-    float ny = stack[sp - 1].as.scalar;
-    stack[sp - 2].as.scalar = fw_bc3_noise2(nx, ny);
-    sp--;
-    NEXT();
-}
-dop_noise3: {
-    float nx = stack[sp - 3].as.scalar;
-    float ny = stack[sp - 2].as.scalar;
-    float nz = stack[sp - 1].as.scalar;
-    stack[sp - 3].as.scalar = fw_bc3_noise3(nx, ny, nz);
-    sp -= 2;
-    NEXT();
-}
-dop_phasor:
-    /* Phasor requires persistent state; returns 0 in bytecode VM. */
-    stack[sp - 1].as.scalar = 0.0f;
-    NEXT();
-dop_vec2: {
-    float x_val = stack[sp - 2].as.scalar;
-    float y_val = stack[sp - 1].as.scalar;
-    stack[sp - 2].tag = FW_BC3_VALUE_VEC2;
-    stack[sp - 2].as.vec2.x = x_val;
-    stack[sp - 2].as.vec2.y = y_val;
-    sp--;
-    NEXT();
-}
-dop_rgba: {
-    float r = stack[sp - 4].as.scalar;
-    float g = stack[sp - 3].as.scalar;
-    float b = stack[sp - 2].as.scalar;
-    float a = stack[sp - 1].as.scalar;
-    stack[sp - 4].tag = FW_BC3_VALUE_RGBA;
-    stack[sp - 4].as.rgba.r = r;
-    stack[sp - 4].as.rgba.g = g;
-    stack[sp - 4].as.rgba.b = b;
-    stack[sp - 4].as.rgba.a = a;
-    sp -= 3;
-    NEXT();
-}
-dop_halt:
-    *out = stack[0];
-    return FW_BC3_OK;
-
-#undef NEXT
-}
-
-static fw_bc3_status_t IRAM_ATTR fw_bc3_execute_statement_block(
-    fw_bc3_runtime_t *runtime,
-    uint16_t start,
-    uint16_t count,
-    bool frame_mode,
-    uint16_t let_limit,
-    const fw_bc3_inputs_t *inputs,
-    fw_bc3_color_t *out_color,
-    uint8_t depth,
-    uint32_t *remaining_budget
-) {
-    if (depth > FW_BC3_MAX_STATEMENT_DEPTH) {
-        return FW_BC3_ERR_LIMIT;
-    }
-    if ((uint32_t)start + (uint32_t)count > runtime->program->stmt_count) {
-        return FW_BC3_ERR_FORMAT;
-    }
-
-    uint16_t i = 0;
-    while (i < count) {
-        fw_bc3_status_t status = FW_BC3_OK;
-        const fw_bc3_stmt_view_t *stmt = &runtime->program->statements[start + i];
-        if (*remaining_budget == 0U) {
-            return FW_BC3_ERR_EXEC_BUDGET;
-        }
-        *remaining_budget -= 1U;
-
-        switch (stmt->kind) {
-            case FW_BC3_STMT_LET: {
-                fw_bc3_value_t value = {0};
-                if (stmt->as.let_decl.slot >= let_limit) {
-                    return FW_BC3_ERR_INVALID_SLOT;
-                }
-                status = fw_bc3_eval_expression(
-                    runtime,
-                    stmt->as.let_decl.expr_index,
-                    inputs,
-                    let_limit,
-                    &value
-                );
-                if (status != FW_BC3_OK) {
-                    return status;
-                }
-                runtime->let_values[stmt->as.let_decl.slot] = value;
-                if (frame_mode) {
-                    runtime->frame_values[stmt->as.let_decl.slot] = value;
-                }
-                break;
-            }
-            case FW_BC3_STMT_BLEND: {
-                fw_bc3_value_t value = {0};
-                if (frame_mode) {
-                    return FW_BC3_ERR_FORMAT;
-                }
-                status = fw_bc3_eval_expression(runtime, stmt->as.blend.expr_index, inputs, let_limit, &value);
-                if (status != FW_BC3_OK) {
-                    return status;
-                }
-                if (value.tag != FW_BC3_VALUE_RGBA) {
-                    return FW_BC3_ERR_TYPE_MISMATCH;
-                }
-                *out_color = fw_bc3_blend_over(value.as.rgba, *out_color);
-                break;
-            }
-            case FW_BC3_STMT_IF: {
-                fw_bc3_value_t condition = {0};
-                status = fw_bc3_eval_expression(runtime, stmt->as.if_stmt.cond_expr_index, inputs, let_limit, &condition);
-                if (status != FW_BC3_OK) {
-                    return status;
-                }
-                if (condition.tag != FW_BC3_VALUE_SCALAR) {
-                    return FW_BC3_ERR_TYPE_MISMATCH;
-                }
-                if (condition.as.scalar > 0.0f) {
-                    status = fw_bc3_execute_statement_block(
-                        runtime,
-                        stmt->as.if_stmt.then_start,
-                        stmt->as.if_stmt.then_count,
-                        frame_mode,
-                        let_limit,
-                        inputs,
-                        out_color,
-                        (uint8_t)(depth + 1U),
-                        remaining_budget
-                    );
-                } else {
-                    status = fw_bc3_execute_statement_block(
-                        runtime,
-                        stmt->as.if_stmt.else_start,
-                        stmt->as.if_stmt.else_count,
-                        frame_mode,
-                        let_limit,
-                        inputs,
-                        out_color,
-                        (uint8_t)(depth + 1U),
-                        remaining_budget
-                    );
-                }
-                if (status != FW_BC3_OK) {
-                    return status;
-                }
-                break;
-            }
-            case FW_BC3_STMT_FOR: {
-                const uint32_t start_value = stmt->as.for_stmt.start_inclusive;
-                const uint32_t end_value = stmt->as.for_stmt.end_exclusive;
-                uint32_t iter = 0;
-                if (stmt->as.for_stmt.index_slot >= let_limit) {
-                    return FW_BC3_ERR_INVALID_SLOT;
-                }
-                if (end_value < start_value) {
-                    return FW_BC3_ERR_FORMAT;
-                }
-                if ((end_value - start_value) > FW_BC3_MAX_LOOP_ITERATIONS) {
-                    return FW_BC3_ERR_LOOP_LIMIT;
-                }
-                iter = start_value;
-                while (iter < end_value) {
-                    const fw_bc3_value_t index_value = {
-                        .tag = FW_BC3_VALUE_SCALAR,
-                        .as.scalar = (float)iter,
-                    };
-                    runtime->let_values[stmt->as.for_stmt.index_slot] = index_value;
-                    if (frame_mode) {
-                        runtime->frame_values[stmt->as.for_stmt.index_slot] = index_value;
-                    }
-                    status = fw_bc3_execute_statement_block(
-                        runtime,
-                        stmt->as.for_stmt.body_start,
-                        stmt->as.for_stmt.body_count,
-                        frame_mode,
-                        let_limit,
-                        inputs,
-                        out_color,
-                        (uint8_t)(depth + 1U),
-                        remaining_budget
-                    );
-                    if (status != FW_BC3_OK) {
-                        return status;
-                    }
-                    iter += 1U;
-                }
-                break;
-            }
-            default:
-                return FW_BC3_ERR_FORMAT;
-        }
-
-        i += 1U;
-    }
-
-    return FW_BC3_OK;
-}
-
-static fw_bc3_status_t IRAM_ATTR fw_bc3_evaluate_params(
-    fw_bc3_runtime_t *runtime,
-    const fw_bc3_inputs_t *inputs,
-    fw_bc3_param_eval_mode_t mode
-) {
-    uint16_t i = 0;
-    while (i < runtime->program->param_count) {
-        const bool depends_x = runtime->program->param_depends_x[i] != 0U;
-        const bool depends_y = runtime->program->param_depends_y[i] != 0U;
-        const bool is_dynamic = depends_x || depends_y;
-        fw_bc3_value_t value = {0};
-        fw_bc3_status_t status = FW_BC3_OK;
-
-        switch (mode) {
-            case FW_BC3_PARAM_EVAL_ALL:
-                break;
-            case FW_BC3_PARAM_EVAL_STATIC_ONLY:
-                if (is_dynamic) {
-                    i += 1U;
-                    continue;
-                }
-                break;
-            case FW_BC3_PARAM_EVAL_DYNAMIC_ONLY:
-                if (!is_dynamic) {
-                    i += 1U;
-                    continue;
-                }
-                break;
-            case FW_BC3_PARAM_EVAL_DYNAMIC_X_ONLY:
-                if (!depends_x) {
-                    i += 1U;
-                    continue;
-                }
-                break;
-            case FW_BC3_PARAM_EVAL_DYNAMIC_Y_ONLY:
-                if (!depends_y || depends_x) {
-                    i += 1U;
-                    continue;
-                }
-                break;
-            default:
-                return FW_BC3_ERR_INVALID_ARG;
-        }
-
-        status = fw_bc3_eval_expression(runtime, runtime->program->param_expr[i], inputs, 0, &value);
-        if (status != FW_BC3_OK) {
-            return status;
-        }
-        if (value.tag != FW_BC3_VALUE_SCALAR) {
-            return FW_BC3_ERR_TYPE_MISMATCH;
-        }
-        runtime->param_values[i] = value.as.scalar;
-        i += 1U;
-    }
-
-    return FW_BC3_OK;
-}
-
-fw_bc3_status_t fw_bc3_runtime_init(fw_bc3_runtime_t *runtime, const fw_bc3_program_t *program, uint16_t width, uint16_t height) {
-    if (runtime == NULL || program == NULL || width == 0U || height == 0U) {
-        return FW_BC3_ERR_INVALID_ARG;
-    }
-
-    memset(runtime, 0, sizeof(*runtime));
-    runtime->program = program;
-    runtime->width = (float)width;
-    runtime->height = (float)height;
-    runtime->has_dynamic_params = false;
-    runtime->has_x_dynamic_params = false;
-    runtime->has_y_only_dynamic_params = false;
-    runtime->y_only_params_cache_valid = false;
-    runtime->y_only_params_cached_y = 0.0f;
-
-    uint16_t i = 0;
-    while (i < program->param_count) {
-        const bool depends_x = program->param_depends_x[i] != 0U;
-        const bool depends_y = program->param_depends_y[i] != 0U;
-        if (depends_x || depends_y) {
-            runtime->has_dynamic_params = true;
-            if (depends_x) {
-                runtime->has_x_dynamic_params = true;
-            }
-            if (depends_y && !depends_x) {
-                runtime->has_y_only_dynamic_params = true;
-            }
-        }
-        i += 1U;
-    }
-
-    fw_bc3_reset_value_slots(runtime->frame_values, FW_BC3_MAX_LET_SLOTS);
-    fw_bc3_reset_value_slots(runtime->let_values, FW_BC3_MAX_LET_SLOTS);
-
-    return FW_BC3_OK;
-}
-
-fw_bc3_status_t fw_bc3_runtime_begin_frame(fw_bc3_runtime_t *runtime, float time_seconds, uint32_t frame_counter) {
-    if (runtime == NULL || runtime->program == NULL) {
-        return FW_BC3_ERR_INVALID_ARG;
-    }
-
-    runtime->time_seconds = time_seconds;
-    runtime->frame_counter = (float)frame_counter;
-    runtime->y_only_params_cache_valid = false;
-    fw_bc3_reset_value_slots(runtime->frame_values, FW_BC3_MAX_LET_SLOTS);
-    fw_bc3_reset_value_slots(runtime->let_values, FW_BC3_MAX_LET_SLOTS);
-
-    fw_bc3_inputs_t inputs = {
-        .time = time_seconds,
-        .frame = (float)frame_counter,
-        .x = 0.0f,
-        .y = 0.0f,
-        .width = runtime->width,
-        .height = runtime->height,
-        .seed = runtime->seed,
-    };
-
-    fw_bc3_status_t status = fw_bc3_evaluate_params(runtime, &inputs, FW_BC3_PARAM_EVAL_STATIC_ONLY);
-    if (status != FW_BC3_OK) {
-        return status;
-    }
-
-    uint32_t budget = FW_BC3_DEFAULT_STATEMENT_BUDGET;
-    fw_bc3_color_t dummy = {
-        .r = 0.0f,
-        .g = 0.0f,
-        .b = 0.0f,
-        .a = 1.0f,
-    };
-    return fw_bc3_execute_statement_block(
-        runtime,
-        runtime->program->frame_stmt_start,
-        runtime->program->frame_stmt_count,
-        true,
-        runtime->program->frame_let_count,
-        &inputs,
-        &dummy,
-        0,
-        &budget
-    );
-}
-
-fw_bc3_status_t IRAM_ATTR fw_bc3_runtime_eval_pixel(fw_bc3_runtime_t *runtime, float x, float y, fw_bc3_color_t *out_color) {
-    if (runtime == NULL || runtime->program == NULL || out_color == NULL) {
-        return FW_BC3_ERR_INVALID_ARG;
-    }
-
-    fw_bc3_inputs_t inputs = {
-        .time = runtime->time_seconds,
-        .frame = runtime->frame_counter,
-        .x = x,
-        .y = y,
-        .width = runtime->width,
-        .height = runtime->height,
-        .seed = runtime->seed,
-    };
-
-    if (runtime->has_dynamic_params) {
-        if (runtime->has_y_only_dynamic_params &&
-            (!runtime->y_only_params_cache_valid || runtime->y_only_params_cached_y != y)) {
-            fw_bc3_status_t status = fw_bc3_evaluate_params(runtime, &inputs, FW_BC3_PARAM_EVAL_DYNAMIC_Y_ONLY);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-            runtime->y_only_params_cache_valid = true;
-            runtime->y_only_params_cached_y = y;
-        }
-
-        if (runtime->has_x_dynamic_params) {
-            fw_bc3_status_t status = fw_bc3_evaluate_params(runtime, &inputs, FW_BC3_PARAM_EVAL_DYNAMIC_X_ONLY);
-            if (status != FW_BC3_OK) {
-                return status;
-            }
-        }
-    }
-
-    fw_bc3_color_t out = {
-        .r = 0.0f,
-        .g = 0.0f,
-        .b = 0.0f,
-        .a = 1.0f,
-    };
-    uint32_t budget = FW_BC3_DEFAULT_STATEMENT_BUDGET;
-
-    uint16_t layer = 0;
-    while (layer < runtime->program->layer_count) {
-        fw_bc3_status_t status = fw_bc3_execute_statement_block(
-            runtime,
-            runtime->program->layer_stmt_start[layer],
-            runtime->program->layer_stmt_count[layer],
-            false,
-            runtime->program->layer_let_count[layer],
-            &inputs,
-            &out,
-            0,
-            &budget
-        );
-        if (status != FW_BC3_OK) {
-            return status;
-        }
-        layer += 1U;
-    }
-
-    *out_color = out;
-    return FW_BC3_OK;
-}
-
-const char *fw_bc3_status_to_string(fw_bc3_status_t status) {
-    switch (status) {
-        case FW_BC3_OK:
-            return "ok";
-        case FW_BC3_ERR_INVALID_ARG:
-            return "invalid_arg";
-        case FW_BC3_ERR_BAD_MAGIC:
-            return "bad_magic";
-        case FW_BC3_ERR_UNSUPPORTED_VERSION:
-            return "unsupported_version";
-        case FW_BC3_ERR_TRUNCATED:
-            return "truncated";
-        case FW_BC3_ERR_FORMAT:
-            return "format";
-        case FW_BC3_ERR_LIMIT:
-            return "limit";
-        case FW_BC3_ERR_INVALID_OPCODE:
-            return "invalid_opcode";
-        case FW_BC3_ERR_INVALID_TAG:
-            return "invalid_tag";
-        case FW_BC3_ERR_INVALID_SLOT:
-            return "invalid_slot";
-        case FW_BC3_ERR_STACK_UNDERFLOW:
-            return "stack_underflow";
-        case FW_BC3_ERR_STACK_OVERFLOW:
-            return "stack_overflow";
-        case FW_BC3_ERR_TYPE_MISMATCH:
-            return "type_mismatch";
-        case FW_BC3_ERR_INVALID_BUILTIN:
-            return "invalid_builtin";
-        case FW_BC3_ERR_LOOP_LIMIT:
-            return "loop_limit";
-        case FW_BC3_ERR_EXEC_BUDGET:
-            return "exec_budget";
-        default:
-            return "unknown";
-    }
-}
+#include "fw_bytecode_vm.h"
+
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <string.h>
+#include "fw_fast_math.h"
+#include "esp_attr.h"
+
+#define FW_BC3_INPUT_SLOT_COUNT 7U
+#define FW_BC3_MAX_CALL_ARGS 8U
+#define FW_BC3_BUILTIN_COUNT 24U
+
+#if FW_BC3_DEFAULT_STATEMENT_BUDGET > 0xFFFFU
+#error "runtime->row_budget counts statements in 16 bits"
+#endif
+
+typedef enum {
+    FW_BC3_OP_PUSH_LITERAL = 1,
+    FW_BC3_OP_PUSH_SLOT = 2,
+    FW_BC3_OP_NEGATE = 3,
+    FW_BC3_OP_ADD = 4,
+    FW_BC3_OP_SUB = 5,
+    FW_BC3_OP_MUL = 6,
+    FW_BC3_OP_DIV = 7,
+    FW_BC3_OP_CALL_BUILTIN = 8,
+    FW_BC3_OP_MOD = 9,
+} fw_bc3_expr_opcode_t;
+
+typedef enum {
+    FW_BC3_SLOT_INPUT = 1,
+    FW_BC3_SLOT_PARAM = 2,
+    FW_BC3_SLOT_FRAME_LET = 3,
+    FW_BC3_SLOT_LET = 4,
+} fw_bc3_slot_tag_t;
+
+typedef enum {
+    FW_BC3_DOP_PUSH_SCALAR_LIT = 0,
+    FW_BC3_DOP_PUSH_INPUT = 1,
+    FW_BC3_DOP_PUSH_PARAM = 2,
+    FW_BC3_DOP_PUSH_FRAME_LET = 3,
+    FW_BC3_DOP_PUSH_LET = 4,
+    FW_BC3_DOP_NEGATE = 5,
+    FW_BC3_DOP_ADD = 6,
+    FW_BC3_DOP_SUB = 7,
+    FW_BC3_DOP_MUL = 8,
+    FW_BC3_DOP_DIV = 9,
+    FW_BC3_DOP_MOD = 10,
+    FW_BC3_DOP_CALL_BUILTIN = 11,
+    // Inlined builtins (1-arg scalar -> scalar)
+    FW_BC3_DOP_BUILTIN_SIN = 12,
+    FW_BC3_DOP_BUILTIN_COS = 13,
+    FW_BC3_DOP_BUILTIN_SQRT = 14,
+    FW_BC3_DOP_BUILTIN_ABS = 15,
+    FW_BC3_DOP_BUILTIN_FLOOR = 16,
+    FW_BC3_DOP_BUILTIN_FRACT = 17,
+    FW_BC3_DOP_BUILTIN_LN = 18,
+    FW_BC3_DOP_BUILTIN_LOG = 19,
+    // Inlined builtins (2-arg scalar -> scalar)
+    FW_BC3_DOP_BUILTIN_MIN = 20,
+    FW_BC3_DOP_BUILTIN_MAX = 21,
+    // Inlined builtins (3-arg scalar -> scalar)
+    FW_BC3_DOP_BUILTIN_CLAMP = 22,
+    FW_BC3_DOP_BUILTIN_SMOOTHSTEP = 23,
+    // Inlined builtins (pow, noise)
+    FW_BC3_DOP_BUILTIN_POW = 24,
+    FW_BC3_DOP_BUILTIN_NOISE = 25,
+    FW_BC3_DOP_BUILTIN_NOISE3 = 26,
+    // Inlined phasor (returns 0 in bytecode VM)
+    FW_BC3_DOP_BUILTIN_PHASOR = 27,
+    // Inlined type constructors
+    FW_BC3_DOP_BUILTIN_VEC2 = 28,
+    FW_BC3_DOP_BUILTIN_RGBA = 29,
+    // Superinstructions formed by fw_bc3_fuse_decoded_ops
+    FW_BC3_DOP_MUL_LIT = 30,
+    FW_BC3_DOP_ADD_LIT = 31,
+    FW_BC3_DOP_SUB_LIT = 32,
+    FW_BC3_DOP_RSUB_LIT = 33,
+    FW_BC3_DOP_FMA_LIT = 34,
+    FW_BC3_DOP_SIN_AFFINE = 35,
+    FW_BC3_DOP_COS_AFFINE = 36,
+    // Sentinel: terminates computed-goto dispatch
+    FW_BC3_DOP_HALT = 37,
+} fw_bc3_decoded_opcode_t;
+
+typedef enum {
+    FW_BC3_BLEND_MIX = 0,         // blend over the opaque pixel color
+    FW_BC3_BLEND_REPLACE = 1,     // literal alpha >= 1: the clamped source replaces the pixel
+    FW_BC3_BLEND_ALPHA_FIRST = 2, // computed alpha: r/g/b only run where alpha > 0
+} fw_bc3_blend_mode_t;
+
+// Register form: three-address ops over runtime->registers, built from the decoded ops at load time.
+typedef enum {
+    FW_BC3_ROP_MOV = 0,
+    FW_BC3_ROP_NEGATE = 1,
+    FW_BC3_ROP_ADD = 2,
+    FW_BC3_ROP_SUB = 3,
+    FW_BC3_ROP_MUL = 4,
+    FW_BC3_ROP_DIV = 5,
+    FW_BC3_ROP_MOD = 6,
+    FW_BC3_ROP_SIN = 7,
+    FW_BC3_ROP_COS = 8,
+    FW_BC3_ROP_SQRT = 9,
+    FW_BC3_ROP_ABS = 10,
+    FW_BC3_ROP_FLOOR = 11,
+    FW_BC3_ROP_FRACT = 12,
+    FW_BC3_ROP_LN = 13,
+    FW_BC3_ROP_LOG = 14,
+    FW_BC3_ROP_MIN = 15,
+    FW_BC3_ROP_MAX = 16,
+    FW_BC3_ROP_CLAMP = 17,
+    FW_BC3_ROP_SMOOTHSTEP = 18,
+    FW_BC3_ROP_POW = 19,
+    FW_BC3_ROP_NOISE = 20,
+    FW_BC3_ROP_NOISE3 = 21,
+    // Phasor: constant 0 in the bytecode VM
+    FW_BC3_ROP_ZERO = 22,
+    FW_BC3_ROP_CIRCLE = 23,
+    FW_BC3_ROP_BOX = 24,
+    FW_BC3_ROP_WRAPDX = 25,
+    FW_BC3_ROP_HASH01 = 26,
+    FW_BC3_ROP_HASH_SIGNED = 27,
+    FW_BC3_ROP_HASH_COORDS01 = 28,
+    // src[0] * src[1] + src[2], optionally through sin/cos (fused affine decoded ops)
+    FW_BC3_ROP_FMA = 29,
+    FW_BC3_ROP_SIN_AFFINE = 30,
+    FW_BC3_ROP_COS_AFFINE = 31,
+    // Sentinel: dst holds the result value tag, src the result component registers
+    FW_BC3_ROP_HALT = 32,
+} fw_bc3_register_opcode_t;
+
+typedef enum {
+    FW_BC3_INPUT_TIME = 0,
+    FW_BC3_INPUT_FRAME = 1,
+    FW_BC3_INPUT_X = 2,
+    FW_BC3_INPUT_Y = 3,
+    FW_BC3_INPUT_WIDTH = 4,
+    FW_BC3_INPUT_HEIGHT = 5,
+    FW_BC3_INPUT_SEED = 6,
+} fw_bc3_input_slot_t;
+
+typedef enum {
+    FW_BC3_BUILTIN_SIN = 0,
+    FW_BC3_BUILTIN_COS = 1,
+    FW_BC3_BUILTIN_SQRT = 2,
+    FW_BC3_BUILTIN_LN = 3,
+    FW_BC3_BUILTIN_LOG = 4,
+    FW_BC3_BUILTIN_ABS = 5,
+    FW_BC3_BUILTIN_FLOOR = 6,
+    FW_BC3_BUILTIN_FRACT = 7,
+    FW_BC3_BUILTIN_MIN = 8,
+    FW_BC3_BUILTIN_MAX = 9,
+    FW_BC3_BUILTIN_CLAMP = 10,
+    FW_BC3_BUILTIN_SMOOTHSTEP = 11,
+    FW_BC3_BUILTIN_CIRCLE = 12,
+    FW_BC3_BUILTIN_BOX = 13,
+    FW_BC3_BUILTIN_WRAPDX = 14,
+    FW_BC3_BUILTIN_HASH01 = 15,
+    FW_BC3_BUILTIN_HASH_SIGNED = 16,
+    FW_BC3_BUILTIN_HASH_COORDS01 = 17,
+    FW_BC3_BUILTIN_POW = 18,
+    FW_BC3_BUILTIN_NOISE = 19,
+    FW_BC3_BUILTIN_NOISE3 = 20,
+    FW_BC3_BUILTIN_PHASOR = 21,
+    FW_BC3_BUILTIN_VEC2 = 22,
+    FW_BC3_BUILTIN_RGBA = 23,
+} fw_bc3_builtin_id_t;
+
+typedef struct {
+    const uint8_t *base;
+    const uint8_t *cur;
+    const uint8_t *end;
+} fw_bc3_cursor_t;
+
+typedef struct {
+    uint8_t tag;
+    uint32_t index;
+} fw_bc3_slot_ref_t;
+
+typedef struct {
+    float time;
+    float frame;
+    float x;
+    float y;
+    float width;
+    float height;
+    float seed;
+} fw_bc3_inputs_t;
+
+typedef struct {
+    uint16_t start;
+    uint16_t count;
+    uint16_t max_slot_plus_one;
+} fw_bc3_stmt_block_info_t;
+
+typedef enum {
+    FW_BC3_PARAM_EVAL_ALL = 0,
+    FW_BC3_PARAM_EVAL_STATIC_ONLY = 1,
+    FW_BC3_PARAM_EVAL_DYNAMIC_ONLY = 2,
+    FW_BC3_PARAM_EVAL_DYNAMIC_X_ONLY = 3,
+    FW_BC3_PARAM_EVAL_DYNAMIC_Y_ONLY = 4,
+} fw_bc3_param_eval_mode_t;
+
+static fw_bc3_value_t fw_bc3_make_scalar(float scalar) {
+    fw_bc3_value_t value = {
+        .tag = FW_BC3_VALUE_SCALAR,
+        .as.scalar = scalar,
+    };
+    return value;
+}
+
+static fw_bc3_status_t fw_bc3_cursor_read_u8(fw_bc3_cursor_t *cursor, uint8_t *out) {
+    if (cursor->cur >= cursor->end) {
+        return FW_BC3_ERR_TRUNCATED;
+    }
+    *out = *cursor->cur;
+    cursor->cur += 1;
+    return FW_BC3_OK;
+}
+
+static fw_bc3_status_t fw_bc3_cursor_read_u16(fw_bc3_cursor_t *cursor, uint16_t *out) {
+    if ((size_t)(cursor->end - cursor->cur) < 2U) {
+        return FW_BC3_ERR_TRUNCATED;
+    }
+    // Host serializer writes all integer fields in little-endian order.
+    *out = (uint16_t)cursor->cur[0] | ((uint16_t)cursor->cur[1] << 8U);
+    cursor->cur += 2;
+    return FW_BC3_OK;
+}
+
+static fw_bc3_status_t fw_bc3_cursor_read_u32(fw_bc3_cursor_t *cursor, uint32_t *out) {
+    if ((size_t)(cursor->end - cursor->cur) < 4U) {
+        return FW_BC3_ERR_TRUNCATED;
+    }
+    *out = (uint32_t)cursor->cur[0] | ((uint32_t)cursor->cur[1] << 8U) | ((uint32_t)cursor->cur[2] << 16U) |
+           ((uint32_t)cursor->cur[3] << 24U);
+    cursor->cur += 4;
+    return FW_BC3_OK;
+}
+
+static fw_bc3_status_t fw_bc3_cursor_skip(fw_bc3_cursor_t *cursor, size_t byte_count) {
+    if ((size_t)(cursor->end - cursor->cur) < byte_count) {
+        return FW_BC3_ERR_TRUNCATED;
+    }
+    cursor->cur += byte_count;
+    return FW_BC3_OK;
+}
+
+static fw_bc3_status_t fw_bc3_cursor_read_f32(fw_bc3_cursor_t *cursor, float *out) {
+    uint32_t bits = 0;
+    fw_bc3_status_t status = fw_bc3_cursor_read_u32(cursor, &bits);
+    if (status != FW_BC3_OK) {
+        return status;
+    }
+    memcpy(out, &bits, sizeof(bits));
+    return FW_BC3_OK;
+}
+
+static fw_bc3_status_t fw_bc3_parse_runtime_value(fw_bc3_cursor_t *cursor, fw_bc3_value_t *out) {
+    uint8_t tag = 0;
+    fw_bc3_status_t status = fw_bc3_cursor_read_u8(cursor, &tag);
+    if (status != FW_BC3_OK) {
+        return status;
+    }
+
+    if (tag == FW_BC3_VALUE_SCALAR) {
+        float scalar = 0.0f;
+        status = fw_bc3_cursor_read_f32(cursor, &scalar);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+        if (out != NULL) {
+            *out = fw_bc3_make_scalar(scalar);
+        }
+        return FW_BC3_OK;
+    }
+
+    if (tag == FW_BC3_VALUE_VEC2) {
+        float x = 0.0f;
+        float y = 0.0f;
+        status = fw_bc3_cursor_read_f32(cursor, &x);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+        status = fw_bc3_cursor_read_f32(cursor, &y);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+        if (out != NULL) {
+            out->tag = FW_BC3_VALUE_VEC2;
+            out->as.vec2 = (fw_bc3_vec2_t){
+                .x = x,
+                .y = y,
+            };
+        }
+        return FW_BC3_OK;
+    }
+
+    if (tag == FW_BC3_VALUE_RGBA) {
+        float r = 0.0f;
+        float g = 0.0f;
+        float b = 0.0f;
+        float a = 0.0f;
+        status = fw_bc3_cursor_read_f32(cursor, &r);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+        status = fw_bc3_cursor_read_f32(cursor, &g);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+        status = fw_bc3_cursor_read_f32(cursor, &b);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+        status = fw_bc3_cursor_read_f32(cursor, &a);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+        if (out != NULL) {
+            out->tag = FW_BC3_VALUE_RGBA;
+            out->as.rgba = (fw_bc3_color_t){
+                .r = r,
+                .g = g,
+                .b = b,
+                .a = a,
+            };
+        }
+        return FW_BC3_OK;
+    }
+
+    return FW_BC3_ERR_INVALID_TAG;
+}
+
+static fw_bc3_status_t fw_bc3_parse_slot_ref(fw_bc3_cursor_t *cursor, fw_bc3_slot_ref_t *out) {
+    uint8_t tag = 0;
+    fw_bc3_status_t status = fw_bc3_cursor_read_u8(cursor, &tag);
+    if (status != FW_BC3_OK) {
+        return status;
+    }
+
+    out->tag = tag;
+    if (tag == FW_BC3_SLOT_INPUT) {
+        uint8_t input_slot = 0;
+        status = fw_bc3_cursor_read_u8(cursor, &input_slot);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+        if (input_slot >= FW_BC3_INPUT_SLOT_COUNT) {
+            return FW_BC3_ERR_INVALID_SLOT;
+        }
+        out->index = input_slot;
+        return FW_BC3_OK;
+    }
+
+    if (tag == FW_BC3_SLOT_PARAM || tag == FW_BC3_SLOT_FRAME_LET || tag == FW_BC3_SLOT_LET) {
+        uint32_t index = 0;
+        status = fw_bc3_cursor_read_u32(cursor, &index);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+        out->index = index;
+        return FW_BC3_OK;
+    }
+
+    return FW_BC3_ERR_INVALID_TAG;
+}
+
+// Number of stack values a decoded op consumes; every op except HALT pushes exactly one result.
+static uint8_t fw_bc3_decoded_op_arity(const fw_bc3_decoded_op_t *op) {
+    switch ((fw_bc3_decoded_opcode_t)op->op) {
+        case FW_BC3_DOP_PUSH_SCALAR_LIT:
+        case FW_BC3_DOP_PUSH_INPUT:
+        case FW_BC3_DOP_PUSH_PARAM:
+        case FW_BC3_DOP_PUSH_FRAME_LET:
+        case FW_BC3_DOP_PUSH_LET:
+            return 0U;
+        case FW_BC3_DOP_ADD:
+        case FW_BC3_DOP_SUB:
+        case FW_BC3_DOP_MUL:
+        case FW_BC3_DOP_DIV:
+        case FW_BC3_DOP_MOD:
+        case FW_BC3_DOP_BUILTIN_MIN:
+        case FW_BC3_DOP_BUILTIN_MAX:
+        case FW_BC3_DOP_BUILTIN_POW:
+        case FW_BC3_DOP_BUILTIN_NOISE:
+        case FW_BC3_DOP_BUILTIN_VEC2:
+            return 2U;
+        case FW_BC3_DOP_BUILTIN_CLAMP:
+        case FW_BC3_DOP_BUILTIN_SMOOTHSTEP:
+        case FW_BC3_DOP_BUILTIN_NOISE3:
+            return 3U;
+        case FW_BC3_DOP_BUILTIN_RGBA:
+            return 4U;
+        case FW_BC3_DOP_CALL_BUILTIN:
+            return op->arg_count;
+        default:
+            return 1U;
+    }
+}
+
+// Finds where the subexpression producing the value on top of the stack after ops[0 .. end) begins.
+static bool fw_bc3_decoded_operand_start(const fw_bc3_decoded_op_t *ops, uint16_t end, uint16_t *out_start) {
+    int32_t needed = 1;
+    uint16_t i = end;
+    while (i > 0U) {
+        i -= 1U;
+        needed += (int32_t)fw_bc3_decoded_op_arity(&ops[i]) - 1;
+        if (needed == 0) {
+            *out_start = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool fw_bc3_add_decoded_affine(fw_bc3_program_t *program, float scale, float offset, uint16_t *out_index) {
+    if (program->decoded_affine_count >= program->decoded_affine_capacity) {
+        return false;
+    }
+    program->decoded_affines[program->decoded_affine_count] = (fw_bc3_affine_t){
+        .scale = scale,
+        .offset = offset,
+    };
+    *out_index = program->decoded_affine_count;
+    program->decoded_affine_count += 1U;
+    return true;
+}
+
+// Peephole pass over one expression's decoded ops (before its HALT), rewriting them in place and
+// returning the new op count. Literal operands of +, -, * fold into the op (MUL_LIT and friends), a
+// MUL_LIT followed by a literal add/sub becomes FMA_LIT, and sin/cos of an FMA_LIT or ADD_LIT becomes
+// SIN_AFFINE/COS_AFFINE. Every rewrite performs the same IEEE operations as the ops it replaces, only
+// with commuted operands or an exactly negated literal; the one visible difference is that -ffast-math
+// may re-associate a fused sin/cos argument, which can move that result by an ulp. Operand types are
+// not checked: the compiler only emits arithmetic on scalars.
+static uint16_t fw_bc3_fuse_decoded_ops(fw_bc3_program_t *program, fw_bc3_decoded_op_t *ops, uint16_t count) {
+    uint16_t out = 0;
+    for (uint16_t i = 0; i < count; i++) {
+        fw_bc3_decoded_op_t op = ops[i];
+
+        if (op.op == (uint8_t)FW_BC3_DOP_ADD || op.op == (uint8_t)FW_BC3_DOP_SUB || op.op == (uint8_t)FW_BC3_DOP_MUL) {
+            uint16_t rhs_start = 0;
+            if (out > 0U && ops[out - 1U].op == (uint8_t)FW_BC3_DOP_PUSH_SCALAR_LIT) {
+                // x op c
+                const float literal = ops[out - 1U].scalar;
+                out -= 1U;
+                op.op = (op.op == (uint8_t)FW_BC3_DOP_ADD)   ? (uint8_t)FW_BC3_DOP_ADD_LIT
+                        : (op.op == (uint8_t)FW_BC3_DOP_SUB) ? (uint8_t)FW_BC3_DOP_SUB_LIT
+                                                             : (uint8_t)FW_BC3_DOP_MUL_LIT;
+                op.scalar = literal;
+            } else if (
+                fw_bc3_decoded_operand_start(ops, out, &rhs_start) && rhs_start > 0U &&
+                ops[rhs_start - 1U].op == (uint8_t)FW_BC3_DOP_PUSH_SCALAR_LIT
+            ) {
+                // c op <expr>: drop the literal push and apply the literal after the right-hand side
+                const float literal = ops[rhs_start - 1U].scalar;
+                memmove(&ops[rhs_start - 1U], &ops[rhs_start], (size_t)(out - rhs_start) * sizeof(*ops));
+                out -= 1U;
+                op.op = (op.op == (uint8_t)FW_BC3_DOP_ADD)   ? (uint8_t)FW_BC3_DOP_ADD_LIT
+                        : (op.op == (uint8_t)FW_BC3_DOP_SUB) ? (uint8_t)FW_BC3_DOP_RSUB_LIT
+                                                             : (uint8_t)FW_BC3_DOP_MUL_LIT;
+                op.scalar = literal;
+            }
+        }
+
+        if (
+            (op.op == (uint8_t)FW_BC3_DOP_ADD_LIT || op.op == (uint8_t)FW_BC3_DOP_SUB_LIT || op.op == (uint8_t)FW_BC3_DOP_RSUB_LIT) &&
+            out > 0U && ops[out - 1U].op == (uint8_t)FW_BC3_DOP_MUL_LIT
+        ) {
+            // x*a - b == x*a + (-b) and b - x*a == x*(-a) + b exactly
+            float scale = ops[out - 1U].scalar;
+            float offset = op.scalar;
+            if (op.op == (uint8_t)FW_BC3_DOP_SUB_LIT) {
+                offset = -offset;
+            } else if (op.op == (uint8_t)FW_BC3_DOP_RSUB_LIT) {
+                scale = -scale;
+            }
+            uint16_t affine = 0;
+            if (fw_bc3_add_decoded_affine(program, scale, offset, &affine)) {
+                out -= 1U;
+                memset(&op, 0, sizeof(op));
+                op.op = (uint8_t)FW_BC3_DOP_FMA_LIT;
+                op.index = affine;
+            }
+        }
+
+        if ((op.op == (uint8_t)FW_BC3_DOP_BUILTIN_SIN || op.op == (uint8_t)FW_BC3_DOP_BUILTIN_COS) && out > 0U) {
+            const fw_bc3_decoded_op_t *prev = &ops[out - 1U];
+            uint16_t affine = 0;
+            bool fused = false;
+            if (prev->op == (uint8_t)FW_BC3_DOP_FMA_LIT) {
+                affine = prev->index;
+                fused = true;
+            } else if (prev->op == (uint8_t)FW_BC3_DOP_ADD_LIT) {
+                // x * 1 is exact, so sin(x + b) can share the affine form
+                fused = fw_bc3_add_decoded_affine(program, 1.0f, prev->scalar, &affine);
+            }
+            if (fused) {
+                const uint8_t fused_op = (op.op == (uint8_t)FW_BC3_DOP_BUILTIN_SIN) ? (uint8_t)FW_BC3_DOP_SIN_AFFINE
+                                                                                    : (uint8_t)FW_BC3_DOP_COS_AFFINE;
+                out -= 1U;
+                memset(&op, 0, sizeof(op));
+                op.op = fused_op;
+                op.index = affine;
+            }
+        }
+
+        ops[out] = op;
+        out += 1U;
+    }
+
+    // fw_bc3_fusion_kind_t lists the fused opcodes in the same order.
+    for (uint16_t i = 0; i < out; i++) {
+        if (ops[i].op >= (uint8_t)FW_BC3_DOP_MUL_LIT && ops[i].op <= (uint8_t)FW_BC3_DOP_COS_AFFINE) {
+            program->fusion_counts[ops[i].op - (uint8_t)FW_BC3_DOP_MUL_LIT] += 1U;
+        }
+    }
+    program->fusion_removed_op_count = (uint16_t)(program->fusion_removed_op_count + (count - out));
+    return out;
+}
+
+static fw_bc3_status_t fw_bc3_parse_expression(fw_bc3_program_t *program, fw_bc3_cursor_t *cursor, uint16_t *out_expr_index) {
+    uint32_t declared_max_stack = 0;
+    uint32_t instruction_count = 0;
+    fw_bc3_status_t status = fw_bc3_cursor_read_u32(cursor, &declared_max_stack);
+    if (status != FW_BC3_OK) {
+        return status;
+    }
+    status = fw_bc3_cursor_read_u32(cursor, &instruction_count);
+    if (status != FW_BC3_OK) {
+        return status;
+    }
+
+    if (declared_max_stack == 0U || declared_max_stack > FW_BC3_MAX_EXPR_STACK) {
+        return FW_BC3_ERR_LIMIT;
+    }
+    if (instruction_count == 0U || instruction_count > FW_BC3_MAX_EXPR_INSTRUCTIONS) {
+        return FW_BC3_ERR_LIMIT;
+    }
+    if (program->expr_count >= program->expr_capacity) {
+        return FW_BC3_ERR_LIMIT;
+    }
+
+    const uint16_t expr_index = program->expr_count;
+    const uint8_t *const instructions = cursor->cur;
+    program->expr_count += 1U;
+
+    int32_t stack_depth = 0;
+    uint32_t max_seen = 0;
+    uint32_t i = 0;
+    while (i < instruction_count) {
+        uint8_t opcode = 0;
+        status = fw_bc3_cursor_read_u8(cursor, &opcode);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+
+        if (opcode == FW_BC3_OP_PUSH_LITERAL) {
+            status = fw_bc3_parse_runtime_value(cursor, NULL);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            stack_depth += 1;
+        } else if (opcode == FW_BC3_OP_PUSH_SLOT) {
+            fw_bc3_slot_ref_t slot = {0};
+            status = fw_bc3_parse_slot_ref(cursor, &slot);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            if (slot.tag == FW_BC3_SLOT_PARAM && slot.index >= program->param_count) {
+                return FW_BC3_ERR_INVALID_SLOT;
+            }
+            if ((slot.tag == FW_BC3_SLOT_FRAME_LET || slot.tag == FW_BC3_SLOT_LET) && slot.index >= FW_BC3_MAX_LET_SLOTS) {
+                return FW_BC3_ERR_INVALID_SLOT;
+            }
+            // Frame lets may be read before (or without) being declared; those reads see a reset slot.
+            if (slot.tag == FW_BC3_SLOT_FRAME_LET && slot.index >= program->frame_value_count) {
+                program->frame_value_count = (uint16_t)(slot.index + 1U);
+            }
+            stack_depth += 1;
+        } else if (opcode == FW_BC3_OP_NEGATE) {
+            if (stack_depth < 1) {
+                return FW_BC3_ERR_STACK_UNDERFLOW;
+            }
+        } else if (opcode == FW_BC3_OP_ADD || opcode == FW_BC3_OP_SUB || opcode == FW_BC3_OP_MUL || opcode == FW_BC3_OP_DIV || opcode == FW_BC3_OP_MOD) {
+            if (stack_depth < 2) {
+                return FW_BC3_ERR_STACK_UNDERFLOW;
+            }
+            stack_depth -= 1;
+        } else if (opcode == FW_BC3_OP_CALL_BUILTIN) {
+            uint8_t builtin = 0;
+            uint8_t arg_count = 0;
+            status = fw_bc3_cursor_read_u8(cursor, &builtin);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            status = fw_bc3_cursor_read_u8(cursor, &arg_count);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            if (builtin >= FW_BC3_BUILTIN_COUNT) {
+                return FW_BC3_ERR_INVALID_BUILTIN;
+            }
+            if (arg_count == 0U || arg_count > FW_BC3_MAX_CALL_ARGS) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            if (stack_depth < (int32_t)arg_count) {
+                return FW_BC3_ERR_STACK_UNDERFLOW;
+            }
+            stack_depth = stack_depth - (int32_t)arg_count + 1;
+        } else {
+            return FW_BC3_ERR_INVALID_OPCODE;
+        }
+
+        if (stack_depth < 0) {
+            return FW_BC3_ERR_STACK_UNDERFLOW;
+        }
+        if ((uint32_t)stack_depth > declared_max_stack || (uint32_t)stack_depth > FW_BC3_MAX_EXPR_STACK) {
+            return FW_BC3_ERR_STACK_OVERFLOW;
+        }
+        if ((uint32_t)stack_depth > max_seen) {
+            max_seen = (uint32_t)stack_depth;
+        }
+        i += 1U;
+    }
+
+    if (stack_depth != 1) {
+        return FW_BC3_ERR_FORMAT;
+    }
+    if (max_seen > declared_max_stack) {
+        return FW_BC3_ERR_FORMAT;
+    }
+
+    // Pre-decode pass: convert raw bytecode into flat decoded ops
+    {
+        const uint16_t decode_start = program->decoded_op_count;
+        program->expressions[expr_index] = (fw_bc3_expr_view_t){
+            .op_start = decode_start,
+        };
+
+        fw_bc3_cursor_t decode_cursor = {
+            .base = cursor->base,
+            .cur = instructions,
+            .end = cursor->end,
+        };
+
+        uint32_t di = 0;
+        while (di < instruction_count) {
+            if (program->decoded_op_count >= program->decoded_op_capacity) {
+                return FW_BC3_ERR_LIMIT;
+            }
+            fw_bc3_decoded_op_t *dop = &program->decoded_ops[program->decoded_op_count];
+            memset(dop, 0, sizeof(*dop));
+
+            uint8_t opcode = 0;
+            status = fw_bc3_cursor_read_u8(&decode_cursor, &opcode);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+
+            if (opcode == FW_BC3_OP_PUSH_LITERAL) {
+                uint8_t tag = 0;
+                status = fw_bc3_cursor_read_u8(&decode_cursor, &tag);
+                if (status != FW_BC3_OK) {
+                    return status;
+                }
+                if (tag == FW_BC3_VALUE_SCALAR) {
+                    float scalar = 0.0f;
+                    status = fw_bc3_cursor_read_f32(&decode_cursor, &scalar);
+                    if (status != FW_BC3_OK) {
+                        return status;
+                    }
+                    dop->op = (uint8_t)FW_BC3_DOP_PUSH_SCALAR_LIT;
+                    dop->scalar = scalar;
+                } else if (tag == FW_BC3_VALUE_VEC2) {
+                    float x_val = 0.0f, y_val = 0.0f;
+                    status = fw_bc3_cursor_read_f32(&decode_cursor, &x_val);
+                    if (status != FW_BC3_OK) {
+                        return status;
+                    }
+                    status = fw_bc3_cursor_read_f32(&decode_cursor, &y_val);
+                    if (status != FW_BC3_OK) {
+                        return status;
+                    }
+                    // Decompose: push x, push y, vec2 constructor
+                    dop->op = (uint8_t)FW_BC3_DOP_PUSH_SCALAR_LIT;
+                    dop->scalar = x_val;
+                    program->decoded_op_count += 1U;
+                    if (program->decoded_op_count >= program->decoded_op_capacity) {
+                        return FW_BC3_ERR_LIMIT;
+                    }
+                    dop = &program->decoded_ops[program->decoded_op_count];
+                    memset(dop, 0, sizeof(*dop));
+                    dop->op = (uint8_t)FW_BC3_DOP_PUSH_SCALAR_LIT;
+                    dop->scalar = y_val;
+                    program->decoded_op_count += 1U;
+                    if (program->decoded_op_count >= program->decoded_op_capacity) {
+                        return FW_BC3_ERR_LIMIT;
+                    }
+                    dop = &program->decoded_ops[program->decoded_op_count];
+                    memset(dop, 0, sizeof(*dop));
+                    dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_VEC2;
+                } else if (tag == FW_BC3_VALUE_RGBA) {
+                    float r = 0.0f, g = 0.0f, b_val = 0.0f, a = 0.0f;
+                    status = fw_bc3_cursor_read_f32(&decode_cursor, &r);
+                    if (status != FW_BC3_OK) {
+                        return status;
+                    }
+                    status = fw_bc3_cursor_read_f32(&decode_cursor, &g);
+                    if (status != FW_BC3_OK) {
+                        return status;
+                    }
+                    status = fw_bc3_cursor_read_f32(&decode_cursor, &b_val);
+                    if (status != FW_BC3_OK) {
+                        return status;
+                    }
+                    status = fw_bc3_cursor_read_f32(&decode_cursor, &a);
+                    if (status != FW_BC3_OK) {
+                        return status;
+                    }
+                    // Decompose: push r, push g, push b, push a, rgba constructor
+                    dop->op = (uint8_t)FW_BC3_DOP_PUSH_SCALAR_LIT;
+                    dop->scalar = r;
+                    program->decoded_op_count += 1U;
+                    if (program->decoded_op_count >= program->decoded_op_capacity) {
+                        return FW_BC3_ERR_LIMIT;
+                    }
+                    dop = &program->decoded_ops[program->decoded_op_count];
+                    memset(dop, 0, sizeof(*dop));
+                    dop->op = (uint8_t)FW_BC3_DOP_PUSH_SCALAR_LIT;
+                    dop->scalar = g;
+                    program->decoded_op_count += 1U;
+                    if (program->decoded_op_count >= program->decoded_op_capacity) {
+                        return FW_BC3_ERR_LIMIT;
+                    }
+                    dop = &program->decoded_ops[program->decoded_op_count];
+                    memset(dop, 0, sizeof(*dop));
+                    dop->op = (uint8_t)FW_BC3_DOP_PUSH_SCALAR_LIT;
+                    dop->scalar = b_val;
+                    program->decoded_op_count += 1U;
+                    if (program->decoded_op_count >= program->decoded_op_capacity) {
+                        return FW_BC3_ERR_LIMIT;
+                    }
+                    dop = &program->decoded_ops[program->decoded_op_count];
+                    memset(dop, 0, sizeof(*dop));
+                    dop->op = (uint8_t)FW_BC3_DOP_PUSH_SCALAR_LIT;
+                    dop->scalar = a;
+                    program->decoded_op_count += 1U;
+                    if (program->decoded_op_count >= program->decoded_op_capacity) {
+                        return FW_BC3_ERR_LIMIT;
+                    }
+                    dop = &program->decoded_ops[program->decoded_op_count];
+                    memset(dop, 0, sizeof(*dop));
+                    dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_RGBA;
+                } else {
+                    return FW_BC3_ERR_INVALID_TAG;
+                }
+            } else if (opcode == FW_BC3_OP_PUSH_SLOT) {
+                fw_bc3_slot_ref_t slot = {0};
+                status = fw_bc3_parse_slot_ref(&decode_cursor, &slot);
+                if (status != FW_BC3_OK) {
+                    return status;
+                }
+                if (slot.tag == FW_BC3_SLOT_INPUT) {
+                    dop->op = (uint8_t)FW_BC3_DOP_PUSH_INPUT;
+                    dop->index = (uint16_t)slot.index;
+                } else if (slot.tag == FW_BC3_SLOT_PARAM) {
+                    dop->op = (uint8_t)FW_BC3_DOP_PUSH_PARAM;
+                    dop->index = (uint16_t)slot.index;
+                } else if (slot.tag == FW_BC3_SLOT_FRAME_LET) {
+                    dop->op = (uint8_t)FW_BC3_DOP_PUSH_FRAME_LET;
+                    dop->index = (uint16_t)slot.index;
+                } else if (slot.tag == FW_BC3_SLOT_LET) {
+                    dop->op = (uint8_t)FW_BC3_DOP_PUSH_LET;
+                    dop->index = (uint16_t)slot.index;
+                } else {
+                    return FW_BC3_ERR_INVALID_TAG;
+                }
+            } else if (opcode == FW_BC3_OP_NEGATE) {
+                dop->op = (uint8_t)FW_BC3_DOP_NEGATE;
+            } else if (opcode == FW_BC3_OP_ADD) {
+                dop->op = (uint8_t)FW_BC3_DOP_ADD;
+            } else if (opcode == FW_BC3_OP_SUB) {
+                dop->op = (uint8_t)FW_BC3_DOP_SUB;
+            } else if (opcode == FW_BC3_OP_MUL) {
+                dop->op = (uint8_t)FW_BC3_DOP_MUL;
+            } else if (opcode == FW_BC3_OP_DIV) {
+                dop->op = (uint8_t)FW_BC3_DOP_DIV;
+            } else if (opcode == FW_BC3_OP_MOD) {
+                dop->op = (uint8_t)FW_BC3_DOP_MOD;
+            } else if (opcode == FW_BC3_OP_CALL_BUILTIN) {
+                uint8_t builtin = 0;
+                uint8_t arg_count = 0;
+                status = fw_bc3_cursor_read_u8(&decode_cursor, &builtin);
+                if (status != FW_BC3_OK) {
+                    return status;
+                }
+                status = fw_bc3_cursor_read_u8(&decode_cursor, &arg_count);
+                if (status != FW_BC3_OK) {
+                    return status;
+                }
+                switch ((fw_bc3_builtin_id_t)builtin) {
+                    case FW_BC3_BUILTIN_SIN:
+                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_SIN;
+                        break;
+                    case FW_BC3_BUILTIN_COS:
+                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_COS;
+                        break;
+                    case FW_BC3_BUILTIN_SQRT:
+                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_SQRT;
+                        break;
+                    case FW_BC3_BUILTIN_ABS:
+                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_ABS;
+                        break;
+                    case FW_BC3_BUILTIN_FLOOR:
+                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_FLOOR;
+                        break;
+                    case FW_BC3_BUILTIN_FRACT:
+                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_FRACT;
+                        break;
+                    case FW_BC3_BUILTIN_LN:
+                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_LN;
+                        break;
+                    case FW_BC3_BUILTIN_LOG:
+                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_LOG;
+                        break;
+                    case FW_BC3_BUILTIN_MIN:
+                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_MIN;
+                        break;
+                    case FW_BC3_BUILTIN_MAX:
+                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_MAX;
+                        break;
+                    case FW_BC3_BUILTIN_CLAMP:
+                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_CLAMP;
+                        break;
+                    case FW_BC3_BUILTIN_SMOOTHSTEP:
+                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_SMOOTHSTEP;
+                        break;
+                    case FW_BC3_BUILTIN_POW:
+                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_POW;
+                        break;
+                    case FW_BC3_BUILTIN_NOISE:
+                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_NOISE;
+                        break;
+                    case FW_BC3_BUILTIN_NOISE3:
+                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_NOISE3;
+                        break;
+                    case FW_BC3_BUILTIN_PHASOR:
+                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_PHASOR;
+                        break;
+                    case FW_BC3_BUILTIN_VEC2:
+                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_VEC2;
+                        break;
+                    case FW_BC3_BUILTIN_RGBA:
+                        dop->op = (uint8_t)FW_BC3_DOP_BUILTIN_RGBA;
+                        break;
+                    default:
+                        dop->op = (uint8_t)FW_BC3_DOP_CALL_BUILTIN;
+                        dop->builtin = builtin;
+                        dop->arg_count = arg_count;
+                        break;
+                }
+            } else {
+                return FW_BC3_ERR_INVALID_OPCODE;
+            }
+
+            program->decoded_op_count += 1U;
+            di += 1U;
+        }
+
+        program->decoded_op_count = (uint16_t)(decode_start + fw_bc3_fuse_decoded_ops(
+            program,
+            &program->decoded_ops[decode_start],
+            (uint16_t)(program->decoded_op_count - decode_start)
+        ));
+        program->expressions[expr_index].op_count = (uint16_t)(program->decoded_op_count - decode_start);
+
+        // Append HALT sentinel for computed-goto dispatch
+        if (program->decoded_op_count >= program->decoded_op_capacity) {
+            return FW_BC3_ERR_LIMIT;
+        }
+        program->decoded_ops[program->decoded_op_count].op = (uint8_t)FW_BC3_DOP_HALT;
+        program->decoded_op_count += 1U;
+    }
+
+    *out_expr_index = expr_index;
+    return FW_BC3_OK;
+}
+
+static fw_bc3_status_t fw_bc3_expression_scan_input_dependencies(
+    const fw_bc3_program_t *program,
+    uint16_t expr_index,
+    bool include_param_dependencies,
+    bool *uses_x,
+    bool *uses_y
+) {
+    if (program == NULL || uses_x == NULL || uses_y == NULL || expr_index >= program->expr_count) {
+        return FW_BC3_ERR_INVALID_ARG;
+    }
+
+    const fw_bc3_decoded_op_t *ops = &program->decoded_ops[program->expressions[expr_index].op_start];
+    const uint16_t op_count = program->expressions[expr_index].op_count;
+
+    bool local_uses_x = false;
+    bool local_uses_y = false;
+    for (uint16_t i = 0; i < op_count; i++) {
+        const fw_bc3_decoded_op_t *op = &ops[i];
+        if (op->op == (uint8_t)FW_BC3_DOP_PUSH_INPUT) {
+            if (op->index == FW_BC3_INPUT_X) {
+                local_uses_x = true;
+            } else if (op->index == FW_BC3_INPUT_Y) {
+                local_uses_y = true;
+            }
+        } else if (include_param_dependencies && op->op == (uint8_t)FW_BC3_DOP_PUSH_PARAM && op->index < program->param_count) {
+            if (program->param_depends_x[op->index] != 0U) {
+                local_uses_x = true;
+            }
+            if (program->param_depends_y[op->index] != 0U) {
+                local_uses_y = true;
+            }
+        }
+
+        if (local_uses_x && local_uses_y) {
+            break;
+        }
+    }
+
+    *uses_x = local_uses_x;
+    *uses_y = local_uses_y;
+    return FW_BC3_OK;
+}
+
+// Picks the lowering of a blend statement from its decoded source expression. A literal alpha >= 1
+// replaces the pixel; a computed alpha is split off into two derived expressions appended after the
+// parsed ones, so the r/g/b operands only run where alpha > 0. Blends stay plain mixes when the split
+// would not fit the expression or decoded-op tables.
+static void fw_bc3_lower_blend(fw_bc3_program_t *program, uint16_t stmt_index) {
+    const uint16_t expr_index = program->statements[stmt_index].as.blend.expr_index;
+    const fw_bc3_decoded_op_t *ops = &program->decoded_ops[program->expressions[expr_index].op_start];
+    const uint16_t op_count = program->expressions[expr_index].op_count;
+    uint16_t alpha_start = 0;
+    if (op_count < 2U || ops[op_count - 1U].op != (uint8_t)FW_BC3_DOP_BUILTIN_RGBA ||
+        !fw_bc3_decoded_operand_start(ops, (uint16_t)(op_count - 1U), &alpha_start)) {
+        return;
+    }
+    if (alpha_start == op_count - 2U && ops[alpha_start].op == (uint8_t)FW_BC3_DOP_PUSH_SCALAR_LIT) {
+        if (ops[alpha_start].scalar >= 1.0f) {
+            program->statements[stmt_index].blend_mode = (uint8_t)FW_BC3_BLEND_REPLACE;
+        }
+        return;
+    }
+
+    // Alpha operand + HALT, then r/g/b operands + literal alpha + RGBA + HALT.
+    const uint16_t alpha_op_count = (uint16_t)(op_count - 1U - alpha_start);
+    const uint32_t needed_ops = (uint32_t)alpha_op_count + 1U + (uint32_t)alpha_start + 3U;
+    if ((uint32_t)program->expr_count + 2U > program->expr_capacity ||
+        (uint32_t)program->decoded_op_count + needed_ops > program->decoded_op_capacity) {
+        return;
+    }
+
+    const uint16_t alpha_expr = program->expr_count;
+    fw_bc3_decoded_op_t *dst = &program->decoded_ops[program->decoded_op_count];
+    program->expressions[alpha_expr] = (fw_bc3_expr_view_t){
+        .op_start = program->decoded_op_count,
+        .op_count = alpha_op_count,
+    };
+    memcpy(dst, &ops[alpha_start], alpha_op_count * sizeof(*dst));
+    dst += alpha_op_count;
+    memset(dst, 0, sizeof(*dst));
+    dst->op = (uint8_t)FW_BC3_DOP_HALT;
+    dst += 1;
+
+    const uint16_t color_expr = (uint16_t)(alpha_expr + 1U);
+    program->expressions[color_expr] = (fw_bc3_expr_view_t){
+        .op_start = (uint16_t)(program->expressions[alpha_expr].op_start + alpha_op_count + 1U),
+        .op_count = (uint16_t)(alpha_start + 2U),
+    };
+    memcpy(dst, ops, alpha_start * sizeof(*dst));
+    dst += alpha_start;
+    memset(dst, 0, 3U * sizeof(*dst));
+    dst[0].op = (uint8_t)FW_BC3_DOP_PUSH_SCALAR_LIT;
+    dst[0].scalar = 0.0f;
+    dst[1].op = (uint8_t)FW_BC3_DOP_BUILTIN_RGBA;
+    dst[2].op = (uint8_t)FW_BC3_DOP_HALT;
+
+    program->expr_count = (uint16_t)(program->expr_count + 2U);
+    program->decoded_op_count = (uint16_t)(program->decoded_op_count + needed_ops);
+    program->statements[stmt_index].blend_mode = (uint8_t)FW_BC3_BLEND_ALPHA_FIRST;
+    program->statements[stmt_index].as.blend.alpha_expr = alpha_expr;
+}
+
+static fw_bc3_status_t fw_bc3_expression_rate(
+    const fw_bc3_program_t *program,
+    uint16_t expr_index,
+    const uint8_t *slot_rate,
+    uint8_t *out_rate
+) {
+    if (program == NULL || slot_rate == NULL || out_rate == NULL || expr_index >= program->expr_count) {
+        return FW_BC3_ERR_INVALID_ARG;
+    }
+
+    const fw_bc3_decoded_op_t *ops = &program->decoded_ops[program->expressions[expr_index].op_start];
+    const uint16_t op_count = program->expressions[expr_index].op_count;
+
+    uint8_t rate = (uint8_t)FW_BC3_RATE_FRAME;
+    for (uint16_t i = 0; i < op_count && rate != (uint8_t)FW_BC3_RATE_PIXEL; i++) {
+        const fw_bc3_decoded_op_t *op = &ops[i];
+        uint8_t op_rate = (uint8_t)FW_BC3_RATE_FRAME;
+        if (op->op == (uint8_t)FW_BC3_DOP_PUSH_INPUT) {
+            if (op->index == FW_BC3_INPUT_X) {
+                op_rate = (uint8_t)FW_BC3_RATE_PIXEL;
+            } else if (op->index == FW_BC3_INPUT_Y) {
+                op_rate = (uint8_t)FW_BC3_RATE_ROW;
+            }
+        } else if (op->op == (uint8_t)FW_BC3_DOP_PUSH_PARAM && op->index < program->param_count) {
+            if (program->param_depends_x[op->index] != 0U) {
+                op_rate = (uint8_t)FW_BC3_RATE_PIXEL;
+            } else if (program->param_depends_y[op->index] != 0U) {
+                op_rate = (uint8_t)FW_BC3_RATE_ROW;
+            }
+        } else if (op->op == (uint8_t)FW_BC3_DOP_PUSH_LET) {
+            op_rate = (op->index < FW_BC3_MAX_LET_SLOTS) ? slot_rate[op->index] : (uint8_t)FW_BC3_RATE_PIXEL;
+        }
+        if (op_rate > rate) {
+            rate = op_rate;
+        }
+    }
+
+    *out_rate = rate;
+    return FW_BC3_OK;
+}
+
+// Classifies every let of a statement block by how often its value can change and reports the rate of the
+// whole block, so a block above FW_BC3_RATE_FRAME depends on x or y. `slot_rate` tracks the let slots in
+// scope. `iterations` is how often the block runs per pixel (the product of the enclosing loop trip counts)
+// and 0 inside if branches: whether those run depends on the pixel, so their lets are never hoisted.
+static fw_bc3_status_t fw_bc3_classify_statement_block(
+    fw_bc3_program_t *program,
+    uint16_t start,
+    uint16_t count,
+    uint8_t depth,
+    uint32_t iterations,
+    uint8_t *slot_rate,
+    uint8_t *out_rate
+) {
+    if (program == NULL || slot_rate == NULL || out_rate == NULL || depth > FW_BC3_MAX_STATEMENT_DEPTH) {
+        return FW_BC3_ERR_INVALID_ARG;
+    }
+    if ((uint32_t)start + (uint32_t)count > program->stmt_count) {
+        return FW_BC3_ERR_FORMAT;
+    }
+
+    uint8_t block_rate = (uint8_t)FW_BC3_RATE_FRAME;
+    for (uint16_t i = 0; i < count; i++) {
+        const uint16_t stmt_index = (uint16_t)(start + i);
+        const fw_bc3_stmt_view_t *stmt = &program->statements[stmt_index];
+        uint8_t rate = (uint8_t)FW_BC3_RATE_FRAME;
+        uint8_t nested_rate = (uint8_t)FW_BC3_RATE_FRAME;
+        fw_bc3_status_t status = FW_BC3_OK;
+
+        switch (stmt->kind) {
+            case FW_BC3_STMT_LET: {
+                const uint16_t expr_index = stmt->as.let_decl.expr_index;
+                status = fw_bc3_expression_rate(program, expr_index, slot_rate, &rate);
+                if (status != FW_BC3_OK) {
+                    return status;
+                }
+                slot_rate[stmt->as.let_decl.slot] = rate;
+                program->statements[stmt_index].rate = rate;
+                // A let that only copies one value costs as much to replay as to evaluate.
+                if (iterations != 0U && rate != (uint8_t)FW_BC3_RATE_PIXEL && program->expressions[expr_index].op_count > 1U &&
+                    (uint32_t)program->hoisted_value_count + iterations <= FW_BC3_MAX_HOISTED_VALUES) {
+                    program->statements[stmt_index].hoisted = 1U;
+                    program->hoisted_value_count = (uint16_t)(program->hoisted_value_count + iterations);
+                    program->hoisted_let_count[rate] += 1U;
+                }
+                break;
+            }
+            case FW_BC3_STMT_BLEND:
+                status = fw_bc3_expression_rate(program, stmt->as.blend.expr_index, slot_rate, &rate);
+                break;
+            case FW_BC3_STMT_IF:
+                status = fw_bc3_expression_rate(program, stmt->as.if_stmt.cond_expr_index, slot_rate, &rate);
+                if (status != FW_BC3_OK) {
+                    return status;
+                }
+                status = fw_bc3_classify_statement_block(
+                    program,
+                    stmt->as.if_stmt.then_start,
+                    stmt->as.if_stmt.then_count,
+                    (uint8_t)(depth + 1U),
+                    0U,
+                    slot_rate,
+                    &nested_rate
+                );
+                if (status != FW_BC3_OK) {
+                    return status;
+                }
+                rate = (nested_rate > rate) ? nested_rate : rate;
+                status = fw_bc3_classify_statement_block(
+                    program,
+                    stmt->as.if_stmt.else_start,
+                    stmt->as.if_stmt.else_count,
+                    (uint8_t)(depth + 1U),
+                    0U,
+                    slot_rate,
+                    &nested_rate
+                );
+                rate = (nested_rate > rate) ? nested_rate : rate;
+                break;
+            case FW_BC3_STMT_FOR: {
+                // The loop index takes the same values at every pixel.
+                const uint32_t trips = stmt->as.for_stmt.end_exclusive - stmt->as.for_stmt.start_inclusive;
+                const uint32_t body_iterations =
+                    (iterations != 0U && trips <= FW_BC3_MAX_HOISTED_VALUES / iterations) ? iterations * trips : 0U;
+                const uint16_t hoisted_before = program->hoisted_value_count;
+                slot_rate[stmt->as.for_stmt.index_slot] = (uint8_t)FW_BC3_RATE_FRAME;
+                status = fw_bc3_classify_statement_block(
+                    program,
+                    stmt->as.for_stmt.body_start,
+                    stmt->as.for_stmt.body_count,
+                    (uint8_t)(depth + 1U),
+                    body_iterations,
+                    slot_rate,
+                    &rate
+                );
+                if (program->hoisted_value_count != hoisted_before) {
+                    program->statements[stmt_index].hoisted = 1U;
+                }
+                break;
+            }
+            default:
+                return FW_BC3_ERR_FORMAT;
+        }
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+
+        if (rate > block_rate) {
+            block_rate = rate;
+        }
+    }
+
+    *out_rate = block_rate;
+    return FW_BC3_OK;
+}
+
+static uint16_t fw_bc3_max_u16(uint16_t a, uint16_t b) {
+    return (a > b) ? a : b;
+}
+
+static fw_bc3_status_t fw_bc3_parse_statement_block(
+    fw_bc3_program_t *program,
+    fw_bc3_cursor_t *cursor,
+    uint8_t depth,
+    fw_bc3_stmt_block_info_t *out
+) {
+    if (depth > FW_BC3_MAX_STATEMENT_DEPTH) {
+        return FW_BC3_ERR_LIMIT;
+    }
+
+    // Each statement block is length-prefixed, then recursively nests child blocks for if/for.
+    uint32_t statement_count = 0;
+    fw_bc3_status_t status = fw_bc3_cursor_read_u32(cursor, &statement_count);
+    if (status != FW_BC3_OK) {
+        return status;
+    }
+    if (statement_count > UINT16_MAX) {
+        return FW_BC3_ERR_LIMIT;
+    }
+    if (program->stmt_count + statement_count > program->stmt_capacity) {
+        return FW_BC3_ERR_LIMIT;
+    }
+
+    // Reserve the whole block up front so its statements stay contiguous; nested if/for blocks are
+    // appended after it while the statements below are parsed.
+    out->start = program->stmt_count;
+    out->count = (uint16_t)statement_count;
+    out->max_slot_plus_one = 0;
+    program->stmt_count = (uint16_t)(program->stmt_count + statement_count);
+
+    uint32_t i = 0;
+    while (i < statement_count) {
+        uint16_t stmt_index = (uint16_t)(out->start + i);
+
+        fw_bc3_stmt_view_t *stmt = &program->statements[stmt_index];
+        memset(stmt, 0, sizeof(*stmt));
+        uint8_t opcode = 0;
+        status = fw_bc3_cursor_read_u8(cursor, &opcode);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+
+        if (opcode == FW_BC3_STMT_LET) {
+            uint32_t slot = 0;
+            uint16_t expr_index = 0;
+            status = fw_bc3_cursor_read_u32(cursor, &slot);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            if (slot >= FW_BC3_MAX_LET_SLOTS) {
+                return FW_BC3_ERR_INVALID_SLOT;
+            }
+            status = fw_bc3_parse_expression(program, cursor, &expr_index);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+
+            stmt->kind = FW_BC3_STMT_LET;
+            stmt->as.let_decl.slot = (uint16_t)slot;
+            stmt->as.let_decl.expr_index = expr_index;
+            out->max_slot_plus_one = fw_bc3_max_u16(out->max_slot_plus_one, (uint16_t)(slot + 1U));
+        } else if (opcode == FW_BC3_STMT_BLEND) {
+            uint16_t expr_index = 0;
+            status = fw_bc3_parse_expression(program, cursor, &expr_index);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+
+            stmt->kind = FW_BC3_STMT_BLEND;
+            stmt->as.blend.expr_index = expr_index;
+        } else if (opcode == FW_BC3_STMT_IF) {
+            uint16_t cond_expr = 0;
+            fw_bc3_stmt_block_info_t then_block = {0};
+            fw_bc3_stmt_block_info_t else_block = {0};
+
+            status = fw_bc3_parse_expression(program, cursor, &cond_expr);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            status = fw_bc3_parse_statement_block(program, cursor, (uint8_t)(depth + 1U), &then_block);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            status = fw_bc3_parse_statement_block(program, cursor, (uint8_t)(depth + 1U), &else_block);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+
+            stmt->kind = FW_BC3_STMT_IF;
+            stmt->as.if_stmt.cond_expr_index = cond_expr;
+            stmt->as.if_stmt.then_start = then_block.start;
+            stmt->as.if_stmt.then_count = then_block.count;
+            stmt->as.if_stmt.else_start = else_block.start;
+            stmt->as.if_stmt.else_count = else_block.count;
+
+            out->max_slot_plus_one = fw_bc3_max_u16(out->max_slot_plus_one, then_block.max_slot_plus_one);
+            out->max_slot_plus_one = fw_bc3_max_u16(out->max_slot_plus_one, else_block.max_slot_plus_one);
+        } else if (opcode == FW_BC3_STMT_FOR) {
+            uint32_t index_slot = 0;
+            uint32_t start_inclusive = 0;
+            uint32_t end_exclusive = 0;
+            fw_bc3_stmt_block_info_t body_block = {0};
+
+            status = fw_bc3_cursor_read_u32(cursor, &index_slot);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            status = fw_bc3_cursor_read_u32(cursor, &start_inclusive);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            status = fw_bc3_cursor_read_u32(cursor, &end_exclusive);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            if (index_slot >= FW_BC3_MAX_LET_SLOTS) {
+                return FW_BC3_ERR_INVALID_SLOT;
+            }
+            if (end_exclusive < start_inclusive) {
+                return FW_BC3_ERR_FORMAT;
+            }
+
+            status = fw_bc3_parse_statement_block(program, cursor, (uint8_t)(depth + 1U), &body_block);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+
+            stmt->kind = FW_BC3_STMT_FOR;
+            stmt->as.for_stmt.index_slot = (uint16_t)index_slot;
+            stmt->as.for_stmt.start_inclusive = start_inclusive;
+            stmt->as.for_stmt.end_exclusive = end_exclusive;
+            stmt->as.for_stmt.body_start = body_block.start;
+            stmt->as.for_stmt.body_count = body_block.count;
+
+            out->max_slot_plus_one = fw_bc3_max_u16(out->max_slot_plus_one, (uint16_t)(index_slot + 1U));
+            out->max_slot_plus_one = fw_bc3_max_u16(out->max_slot_plus_one, body_block.max_slot_plus_one);
+        } else {
+            return FW_BC3_ERR_INVALID_OPCODE;
+        }
+
+        i += 1U;
+    }
+
+    return FW_BC3_OK;
+}
+
+// --- Register form ---
+//
+// Row evaluation runs three-address ops over a flat float register file instead of replaying the stack
+// program. The builder below simulates each expression's stack at load time: pushes of inputs, params,
+// literals and lets emit nothing (the stack entry just names their registers), vec2/rgba constructors
+// only regroup component registers, and every remaining op writes one scalar temp. Layout:
+//
+//   [inputs][params][literal constants][top-level frame lets][layer lets ->   ...   <- temps]
+//
+// Layer lets are lexically scoped, so a let whose value already lives in a register simply aliases it and
+// a block's registers are reused once it ends. Anything the builder cannot prove equivalent to the stack
+// path (non-scalar arithmetic, out-of-scope slots, forward param references, register pressure) leaves
+// has_register_form at 0, and rows are then evaluated pixel by pixel.
+
+typedef struct {
+    uint8_t tag;
+    uint16_t temp_mark;
+    uint8_t reg[4];
+} fw_bc3_reg_entry_t;
+
+typedef struct {
+    fw_bc3_program_t *program;
+    uint16_t next_let;
+    uint16_t temp_top;
+    uint16_t temp_floor;
+    // Highest let register + 1 and lowest temp register ever allocated, for compacting the register file.
+    uint16_t let_high;
+    uint16_t temp_low;
+    uint16_t expr_op_start;
+    uint16_t x_param_limit;
+    bool in_param;
+    bool in_frame;
+    uint8_t block_depth;
+    uint16_t next_block_id;
+    uint16_t active_blocks[FW_BC3_MAX_STATEMENT_DEPTH + 2U];
+    uint16_t slot_block[FW_BC3_MAX_LET_SLOTS];
+    uint8_t slot_tag[FW_BC3_MAX_LET_SLOTS];
+    uint8_t slot_regs[FW_BC3_MAX_LET_SLOTS][4];
+    fw_bc3_reg_entry_t stack[FW_BC3_MAX_EXPR_STACK];
+} fw_bc3_reg_builder_t;
+
+static uint8_t fw_bc3_value_component_count(fw_bc3_value_tag_t tag) {
+    if (tag == FW_BC3_VALUE_VEC2) {
+        return 2U;
+    }
+    if (tag == FW_BC3_VALUE_RGBA) {
+        return 4U;
+    }
+    return 1U;
+}
+
+static bool fw_bc3_reg_slot_visible(const fw_bc3_reg_builder_t *builder, uint16_t slot) {
+    const uint16_t block = builder->slot_block[slot];
+    if (block == 0U) {
+        return false;
+    }
+    for (uint8_t i = 0; i < builder->block_depth; i++) {
+        if (builder->active_blocks[i] == block) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static fw_bc3_status_t fw_bc3_reg_emit(
+    fw_bc3_reg_builder_t *builder,
+    fw_bc3_register_opcode_t op,
+    uint8_t dst,
+    const uint8_t *src,
+    uint8_t src_count
+) {
+    fw_bc3_program_t *program = builder->program;
+    if (src_count > 4U) {
+        return FW_BC3_ERR_FORMAT;
+    }
+    if (program->register_op_count >= program->register_op_capacity) {
+        return FW_BC3_ERR_LIMIT;
+    }
+    fw_bc3_register_op_t *rop = &program->register_ops[program->register_op_count];
+    memset(rop, 0, sizeof(*rop));
+    rop->op = (uint8_t)op;
+    rop->dst = dst;
+    for (uint8_t i = 0; i < src_count; i++) {
+        rop->src[i] = src[i];
+    }
+    program->register_op_count += 1U;
+    return FW_BC3_OK;
+}
+
+static fw_bc3_status_t fw_bc3_reg_alloc_temp(fw_bc3_reg_builder_t *builder, uint8_t *out) {
+    // Temps grow down from the top of the register file and must stay clear of live lets.
+    if (builder->temp_top == 0U || (uint16_t)(builder->temp_top - 1U) < builder->next_let) {
+        return FW_BC3_ERR_LIMIT;
+    }
+    builder->temp_top -= 1U;
+    if (builder->temp_top < builder->temp_floor) {
+        builder->temp_floor = builder->temp_top;
+    }
+    if (builder->temp_top < builder->temp_low) {
+        builder->temp_low = builder->temp_top;
+    }
+    *out = (uint8_t)builder->temp_top;
+    return FW_BC3_OK;
+}
+
+// Pops `entry_count` stack entries and pushes a scalar temp computed by `op` from `src`.
+static fw_bc3_status_t fw_bc3_reg_apply(
+    fw_bc3_reg_builder_t *builder,
+    uint16_t *sp,
+    uint16_t entry_count,
+    fw_bc3_register_opcode_t op,
+    const uint8_t *src,
+    uint8_t src_count
+) {
+    fw_bc3_reg_entry_t *first = &builder->stack[*sp - entry_count];
+    const uint16_t mark = first->temp_mark;
+    uint8_t dst = 0;
+
+    // Operand temps are dead once the op has read them, so the result can reuse the lowest one.
+    builder->temp_top = mark;
+    fw_bc3_status_t status = fw_bc3_reg_alloc_temp(builder, &dst);
+    if (status != FW_BC3_OK) {
+        return status;
+    }
+    status = fw_bc3_reg_emit(builder, op, dst, src, src_count);
+    if (status != FW_BC3_OK) {
+        return status;
+    }
+
+    memset(first, 0, sizeof(*first));
+    first->tag = (uint8_t)FW_BC3_VALUE_SCALAR;
+    first->temp_mark = mark;
+    first->reg[0] = dst;
+    *sp = (uint16_t)(*sp - entry_count + 1U);
+    return FW_BC3_OK;
+}
+
+static fw_bc3_status_t fw_bc3_reg_scalar_args(
+    const fw_bc3_reg_builder_t *builder,
+    uint16_t sp,
+    uint8_t arity,
+    uint8_t *src
+) {
+    if (sp < arity) {
+        return FW_BC3_ERR_STACK_UNDERFLOW;
+    }
+    for (uint8_t i = 0; i < arity; i++) {
+        const fw_bc3_reg_entry_t *entry = &builder->stack[sp - arity + i];
+        if (entry->tag != (uint8_t)FW_BC3_VALUE_SCALAR) {
+            return FW_BC3_ERR_TYPE_MISMATCH;
+        }
+        src[i] = entry->reg[0];
+    }
+    return FW_BC3_OK;
+}
+
+static fw_bc3_status_t fw_bc3_reg_scalar_op(
+    fw_bc3_reg_builder_t *builder,
+    uint16_t *sp,
+    fw_bc3_register_opcode_t op,
+    uint8_t arity
+) {
+    uint8_t src[4] = {0};
+    fw_bc3_status_t status = fw_bc3_reg_scalar_args(builder, *sp, arity, src);
+    if (status != FW_BC3_OK) {
+        return status;
+    }
+    return fw_bc3_reg_apply(builder, sp, arity, op, src, arity);
+}
+
+static fw_bc3_status_t fw_bc3_reg_construct(fw_bc3_reg_builder_t *builder, uint16_t *sp, fw_bc3_value_tag_t tag) {
+    const uint8_t arity = fw_bc3_value_component_count(tag);
+    uint8_t src[4] = {0};
+    fw_bc3_status_t status = fw_bc3_reg_scalar_args(builder, *sp, arity, src);
+    if (status != FW_BC3_OK) {
+        return status;
+    }
+    fw_bc3_reg_entry_t *first = &builder->stack[*sp - arity];
+    first->tag = (uint8_t)tag;
+    for (uint8_t i = 0; i < arity; i++) {
+        first->reg[i] = src[i];
+    }
+    *sp = (uint16_t)(*sp - arity + 1U);
+    return FW_BC3_OK;
+}
+
+static fw_bc3_status_t fw_bc3_reg_call_builtin(fw_bc3_reg_builder_t *builder, uint16_t *sp, const fw_bc3_decoded_op_t *op) {
+    const uint8_t arg_count = op->arg_count;
+    uint8_t src[4] = {0};
+    if (*sp < arg_count) {
+        return FW_BC3_ERR_STACK_UNDERFLOW;
+    }
+    const fw_bc3_reg_entry_t *args = &builder->stack[*sp - arg_count];
+
+    switch ((fw_bc3_builtin_id_t)op->builtin) {
+        case FW_BC3_BUILTIN_CIRCLE:
+            if (arg_count != 2U) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            if (args[0].tag != (uint8_t)FW_BC3_VALUE_VEC2 || args[1].tag != (uint8_t)FW_BC3_VALUE_SCALAR) {
+                return FW_BC3_ERR_TYPE_MISMATCH;
+            }
+            src[0] = args[0].reg[0];
+            src[1] = args[0].reg[1];
+            src[2] = args[1].reg[0];
+            return fw_bc3_reg_apply(builder, sp, arg_count, FW_BC3_ROP_CIRCLE, src, 3U);
+        case FW_BC3_BUILTIN_BOX:
+            if (arg_count != 2U) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            if (args[0].tag != (uint8_t)FW_BC3_VALUE_VEC2 || args[1].tag != (uint8_t)FW_BC3_VALUE_VEC2) {
+                return FW_BC3_ERR_TYPE_MISMATCH;
+            }
+            src[0] = args[0].reg[0];
+            src[1] = args[0].reg[1];
+            src[2] = args[1].reg[0];
+            src[3] = args[1].reg[1];
+            return fw_bc3_reg_apply(builder, sp, arg_count, FW_BC3_ROP_BOX, src, 4U);
+        case FW_BC3_BUILTIN_WRAPDX:
+            if (arg_count != 3U) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            return fw_bc3_reg_scalar_op(builder, sp, FW_BC3_ROP_WRAPDX, 3U);
+        case FW_BC3_BUILTIN_HASH01:
+            if (arg_count != 1U) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            return fw_bc3_reg_scalar_op(builder, sp, FW_BC3_ROP_HASH01, 1U);
+        case FW_BC3_BUILTIN_HASH_SIGNED:
+            if (arg_count != 1U) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            return fw_bc3_reg_scalar_op(builder, sp, FW_BC3_ROP_HASH_SIGNED, 1U);
+        case FW_BC3_BUILTIN_HASH_COORDS01:
+            if (arg_count != 3U) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            return fw_bc3_reg_scalar_op(builder, sp, FW_BC3_ROP_HASH_COORDS01, 3U);
+        default:
+            return FW_BC3_ERR_INVALID_BUILTIN;
+    }
+}
+
+static fw_bc3_status_t fw_bc3_reg_find_const(const fw_bc3_program_t *program, float value, uint8_t *out) {
+    for (uint8_t i = 0; i < program->register_const_count; i++) {
+        if (memcmp(&program->register_const_values[i], &value, sizeof(value)) == 0) {
+            *out = (uint8_t)(program->register_const_base + i);
+            return FW_BC3_OK;
+        }
+    }
+    return FW_BC3_ERR_LIMIT;
+}
+
+// Fused literal ops lower to the plain register op with their literals read from constant registers.
+static fw_bc3_status_t fw_bc3_reg_literal_op(
+    fw_bc3_reg_builder_t *builder,
+    uint16_t *sp,
+    fw_bc3_register_opcode_t op,
+    const float *literals,
+    uint8_t literal_count,
+    bool literal_first
+) {
+    uint8_t operand = 0;
+    uint8_t src[4] = {0};
+    fw_bc3_status_t status = fw_bc3_reg_scalar_args(builder, *sp, 1U, &operand);
+    if (status != FW_BC3_OK) {
+        return status;
+    }
+    const uint8_t first_literal = literal_first ? 0U : 1U;
+    src[literal_first ? literal_count : 0U] = operand;
+    for (uint8_t i = 0; i < literal_count; i++) {
+        status = fw_bc3_reg_find_const(builder->program, literals[i], &src[first_literal + i]);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+    }
+    return fw_bc3_reg_apply(builder, sp, 1U, op, src, (uint8_t)(literal_count + 1U));
+}
+
+static fw_bc3_status_t fw_bc3_reg_build_expression(
+    fw_bc3_reg_builder_t *builder,
+    uint16_t expr_index,
+    uint16_t let_limit,
+    fw_bc3_reg_entry_t *out
+) {
+    fw_bc3_program_t *program = builder->program;
+    if (expr_index >= program->expr_count) {
+        return FW_BC3_ERR_FORMAT;
+    }
+
+    const fw_bc3_decoded_op_t *ops = &program->decoded_ops[program->expressions[expr_index].op_start];
+    const uint16_t op_count = program->expressions[expr_index].op_count;
+    uint16_t sp = 0;
+    builder->temp_top = FW_BC3_MAX_REGISTERS;
+    builder->temp_floor = FW_BC3_MAX_REGISTERS;
+    builder->expr_op_start = program->register_op_count;
+    program->expressions[expr_index].register_op_start = program->register_op_count;
+
+    for (uint16_t i = 0; i < op_count; i++) {
+        const fw_bc3_decoded_op_t *op = &ops[i];
+        fw_bc3_status_t status = FW_BC3_OK;
+
+        if (op->op <= (uint8_t)FW_BC3_DOP_PUSH_LET) {
+            if (sp >= FW_BC3_MAX_EXPR_STACK) {
+                return FW_BC3_ERR_STACK_OVERFLOW;
+            }
+            fw_bc3_reg_entry_t *entry = &builder->stack[sp];
+            memset(entry, 0, sizeof(*entry));
+            entry->tag = (uint8_t)FW_BC3_VALUE_SCALAR;
+            entry->temp_mark = builder->temp_top;
+
+            switch ((fw_bc3_decoded_opcode_t)op->op) {
+                case FW_BC3_DOP_PUSH_SCALAR_LIT:
+                    status = fw_bc3_reg_find_const(program, op->scalar, &entry->reg[0]);
+                    break;
+                case FW_BC3_DOP_PUSH_INPUT:
+                    if (op->index >= FW_BC3_INPUT_SLOT_COUNT) {
+                        return FW_BC3_ERR_INVALID_SLOT;
+                    }
+                    entry->reg[0] = (uint8_t)op->index;
+                    break;
+                case FW_BC3_DOP_PUSH_PARAM:
+                    if (op->index >= program->param_count) {
+                        return FW_BC3_ERR_INVALID_SLOT;
+                    }
+                    // Per pixel, an x-dependent param only sees later x-dependent params from the previous pixel.
+                    if (builder->in_param && program->param_depends_x[op->index] != 0U && op->index >= builder->x_param_limit) {
+                        return FW_BC3_ERR_FORMAT;
+                    }
+                    entry->reg[0] = (uint8_t)(program->register_param_base + op->index);
+                    break;
+                case FW_BC3_DOP_PUSH_FRAME_LET: {
+                    if (builder->in_param || builder->in_frame || op->index >= FW_BC3_MAX_LET_SLOTS) {
+                        return FW_BC3_ERR_INVALID_SLOT;
+                    }
+                    const uint8_t tag = program->register_frame_let_tag[op->index];
+                    if (tag == 0U) {
+                        return FW_BC3_ERR_INVALID_SLOT;
+                    }
+                    entry->tag = tag;
+                    for (uint8_t c = 0; c < fw_bc3_value_component_count((fw_bc3_value_tag_t)tag); c++) {
+                        entry->reg[c] = (uint8_t)(program->register_frame_let[op->index] + c);
+                    }
+                    break;
+                }
+                case FW_BC3_DOP_PUSH_LET:
+                    if (builder->in_param || op->index >= let_limit || !fw_bc3_reg_slot_visible(builder, op->index)) {
+                        return FW_BC3_ERR_INVALID_SLOT;
+                    }
+                    entry->tag = builder->slot_tag[op->index];
+                    memcpy(entry->reg, builder->slot_regs[op->index], sizeof(entry->reg));
+                    break;
+                default:
+                    return FW_BC3_ERR_INVALID_OPCODE;
+            }
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            sp += 1U;
+            continue;
+        }
+
+        switch ((fw_bc3_decoded_opcode_t)op->op) {
+            case FW_BC3_DOP_NEGATE:
+                status = fw_bc3_reg_scalar_op(builder, &sp, FW_BC3_ROP_NEGATE, 1U);
+                break;
+            case FW_BC3_DOP_ADD:
+                status = fw_bc3_reg_scalar_op(builder, &sp, FW_BC3_ROP_ADD, 2U);
+                break;
+            case FW_BC3_DOP_SUB:
+                status = fw_bc3_reg_scalar_op(builder, &sp, FW_BC3_ROP_SUB, 2U);
+                break;
+            case FW_BC3_DOP_MUL:
+                status = fw_bc3_reg_scalar_op(builder, &sp, FW_BC3_ROP_MUL, 2U);
+                break;
+            case FW_BC3_DOP_DIV:
+                status = fw_bc3_reg_scalar_op(builder, &sp, FW_BC3_ROP_DIV, 2U);
+                break;
+            case FW_BC3_DOP_MOD:
+                status = fw_bc3_reg_scalar_op(builder, &sp, FW_BC3_ROP_MOD, 2U);
+                break;
+            case FW_BC3_DOP_CALL_BUILTIN:
+                status = fw_bc3_reg_call_builtin(builder, &sp, op);
+                break;
+            case FW_BC3_DOP_BUILTIN_SIN:
+                status = fw_bc3_reg_scalar_op(builder, &sp, FW_BC3_ROP_SIN, 1U);
+                break;
+            case FW_BC3_DOP_BUILTIN_COS:
+                status = fw_bc3_reg_scalar_op(builder, &sp, FW_BC3_ROP_COS, 1U);
+                break;
+            case FW_BC3_DOP_BUILTIN_SQRT:
+                status = fw_bc3_reg_scalar_op(builder, &sp, FW_BC3_ROP_SQRT, 1U);
+                break;
+            case FW_BC3_DOP_BUILTIN_ABS:
+                status = fw_bc3_reg_scalar_op(builder, &sp, FW_BC3_ROP_ABS, 1U);
+                break;
+            case FW_BC3_DOP_BUILTIN_FLOOR:
+                status = fw_bc3_reg_scalar_op(builder, &sp, FW_BC3_ROP_FLOOR, 1U);
+                break;
+            case FW_BC3_DOP_BUILTIN_FRACT:
+                status = fw_bc3_reg_scalar_op(builder, &sp, FW_BC3_ROP_FRACT, 1U);
+                break;
+            case FW_BC3_DOP_BUILTIN_LN:
+                status = fw_bc3_reg_scalar_op(builder, &sp, FW_BC3_ROP_LN, 1U);
+                break;
+            case FW_BC3_DOP_BUILTIN_LOG:
+                status = fw_bc3_reg_scalar_op(builder, &sp, FW_BC3_ROP_LOG, 1U);
+                break;
+            case FW_BC3_DOP_BUILTIN_MIN:
+                status = fw_bc3_reg_scalar_op(builder, &sp, FW_BC3_ROP_MIN, 2U);
+                break;
+            case FW_BC3_DOP_BUILTIN_MAX:
+                status = fw_bc3_reg_scalar_op(builder, &sp, FW_BC3_ROP_MAX, 2U);
+                break;
+            case FW_BC3_DOP_BUILTIN_CLAMP:
+                status = fw_bc3_reg_scalar_op(builder, &sp, FW_BC3_ROP_CLAMP, 3U);
+                break;
+            case FW_BC3_DOP_BUILTIN_SMOOTHSTEP:
+                status = fw_bc3_reg_scalar_op(builder, &sp, FW_BC3_ROP_SMOOTHSTEP, 3U);
+                break;
+            case FW_BC3_DOP_BUILTIN_POW:
+                status = fw_bc3_reg_scalar_op(builder, &sp, FW_BC3_ROP_POW, 2U);
+                break;
+            case FW_BC3_DOP_BUILTIN_NOISE:
+                status = fw_bc3_reg_scalar_op(builder, &sp, FW_BC3_ROP_NOISE, 2U);
+                break;
+            case FW_BC3_DOP_BUILTIN_NOISE3:
+                status = fw_bc3_reg_scalar_op(builder, &sp, FW_BC3_ROP_NOISE3, 3U);
+                break;
+            case FW_BC3_DOP_BUILTIN_PHASOR:
+                status = fw_bc3_reg_scalar_op(builder, &sp, FW_BC3_ROP_ZERO, 1U);
+                break;
+            case FW_BC3_DOP_BUILTIN_VEC2:
+                status = fw_bc3_reg_construct(builder, &sp, FW_BC3_VALUE_VEC2);
+                break;
+            case FW_BC3_DOP_BUILTIN_RGBA:
+                status = fw_bc3_reg_construct(builder, &sp, FW_BC3_VALUE_RGBA);
+                break;
+            case FW_BC3_DOP_MUL_LIT:
+                status = fw_bc3_reg_literal_op(builder, &sp, FW_BC3_ROP_MUL, &op->scalar, 1U, false);
+                break;
+            case FW_BC3_DOP_ADD_LIT:
+                status = fw_bc3_reg_literal_op(builder, &sp, FW_BC3_ROP_ADD, &op->scalar, 1U, false);
+                break;
+            case FW_BC3_DOP_SUB_LIT:
+                status = fw_bc3_reg_literal_op(builder, &sp, FW_BC3_ROP_SUB, &op->scalar, 1U, false);
+                break;
+            case FW_BC3_DOP_RSUB_LIT:
+                status = fw_bc3_reg_literal_op(builder, &sp, FW_BC3_ROP_SUB, &op->scalar, 1U, true);
+                break;
+            case FW_BC3_DOP_FMA_LIT:
+            case FW_BC3_DOP_SIN_AFFINE:
+            case FW_BC3_DOP_COS_AFFINE: {
+                if (op->index >= program->decoded_affine_count) {
+                    return FW_BC3_ERR_FORMAT;
+                }
+                const fw_bc3_affine_t *affine = &program->decoded_affines[op->index];
+                const float literals[2] = {affine->scale, affine->offset};
+                const fw_bc3_register_opcode_t rop = (op->op == (uint8_t)FW_BC3_DOP_FMA_LIT)      ? FW_BC3_ROP_FMA
+                                                     : (op->op == (uint8_t)FW_BC3_DOP_SIN_AFFINE) ? FW_BC3_ROP_SIN_AFFINE
+                                                                                                  : FW_BC3_ROP_COS_AFFINE;
+                status = fw_bc3_reg_literal_op(builder, &sp, rop, literals, 2U, false);
+                break;
+            }
+            default:
+                return FW_BC3_ERR_INVALID_OPCODE;
+        }
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+    }
+
+    if (sp == 0U) {
+        return FW_BC3_ERR_STACK_UNDERFLOW;
+    }
+    // The stack path returns the bottom entry, whatever is left above it.
+    *out = builder->stack[0];
+    return FW_BC3_OK;
+}
+
+static bool fw_bc3_reg_is_temp(const fw_bc3_reg_builder_t *builder, uint8_t reg) {
+    return reg >= builder->temp_top;
+}
+
+// Moves one result component into `dst`: the op that produced a temp is retargeted, anything else is copied.
+static fw_bc3_status_t fw_bc3_reg_store(fw_bc3_reg_builder_t *builder, uint8_t src, uint8_t dst) {
+    fw_bc3_program_t *program = builder->program;
+    if (fw_bc3_reg_is_temp(builder, src)) {
+        uint16_t i = program->register_op_count;
+        while (i > builder->expr_op_start) {
+            i -= 1U;
+            if (program->register_ops[i].dst == src) {
+                program->register_ops[i].dst = dst;
+                return FW_BC3_OK;
+            }
+        }
+    }
+    return fw_bc3_reg_emit(builder, FW_BC3_ROP_MOV, dst, &src, 1U);
+}
+
+static fw_bc3_status_t fw_bc3_reg_alloc_let(fw_bc3_reg_builder_t *builder, uint8_t *out) {
+    // Let registers must not overlap the temps of the expression that produces them.
+    if (builder->next_let >= builder->temp_floor) {
+        return FW_BC3_ERR_LIMIT;
+    }
+    *out = (uint8_t)builder->next_let;
+    builder->next_let += 1U;
+    if (builder->next_let > builder->let_high) {
+        builder->let_high = builder->next_let;
+    }
+    return FW_BC3_OK;
+}
+
+// Binds `slot` to the result of the expression just built. With `fresh`, every component gets a new
+// register; otherwise only temps do and the rest alias their source registers.
+static fw_bc3_status_t fw_bc3_reg_bind_let(
+    fw_bc3_reg_builder_t *builder,
+    uint16_t slot,
+    const fw_bc3_reg_entry_t *value,
+    bool fresh
+) {
+    uint8_t regs[4] = {0};
+    const uint8_t components = fw_bc3_value_component_count((fw_bc3_value_tag_t)value->tag);
+    for (uint8_t c = 0; c < components; c++) {
+        if (!fresh && !fw_bc3_reg_is_temp(builder, value->reg[c])) {
+            regs[c] = value->reg[c];
+            continue;
+        }
+        fw_bc3_status_t status = fw_bc3_reg_alloc_let(builder, &regs[c]);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+        status = fw_bc3_reg_store(builder, value->reg[c], regs[c]);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+    }
+
+    builder->slot_block[slot] = builder->active_blocks[builder->block_depth - 1U];
+    builder->slot_tag[slot] = value->tag;
+    memcpy(builder->slot_regs[slot], regs, sizeof(regs));
+    return FW_BC3_OK;
+}
+
+static fw_bc3_status_t fw_bc3_reg_emit_halt(fw_bc3_reg_builder_t *builder, const fw_bc3_reg_entry_t *value) {
+    return fw_bc3_reg_emit(
+        builder,
+        FW_BC3_ROP_HALT,
+        value->tag,
+        value->reg,
+        fw_bc3_value_component_count((fw_bc3_value_tag_t)value->tag)
+    );
+}
+
+static fw_bc3_status_t fw_bc3_reg_build_block(
+    fw_bc3_reg_builder_t *builder,
+    uint16_t start,
+    uint16_t count,
+    uint16_t let_limit,
+    uint8_t depth,
+    const uint16_t *index_slot,
+    uint8_t index_reg
+) {
+    fw_bc3_program_t *program = builder->program;
+    if (depth > FW_BC3_MAX_STATEMENT_DEPTH) {
+        return FW_BC3_ERR_LIMIT;
+    }
+    if ((uint32_t)start + (uint32_t)count > program->stmt_count) {
+        return FW_BC3_ERR_FORMAT;
+    }
+
+    const uint16_t saved_next_let = builder->next_let;
+    builder->active_blocks[builder->block_depth] = builder->next_block_id;
+    builder->block_depth += 1U;
+    builder->next_block_id += 1U;
+    if (index_slot != NULL) {
+        builder->slot_block[*index_slot] = builder->active_blocks[builder->block_depth - 1U];
+        builder->slot_tag[*index_slot] = (uint8_t)FW_BC3_VALUE_SCALAR;
+        memset(builder->slot_regs[*index_slot], 0, sizeof(builder->slot_regs[*index_slot]));
+        builder->slot_regs[*index_slot][0] = index_reg;
+    }
+
+    for (uint16_t i = 0; i < count; i++) {
+        const uint16_t stmt_index = (uint16_t)(start + i);
+        const fw_bc3_stmt_view_t *stmt = &program->statements[stmt_index];
+        fw_bc3_reg_entry_t value = {0};
+        fw_bc3_status_t status = FW_BC3_OK;
+
+        switch (stmt->kind) {
+            case FW_BC3_STMT_LET:
+                // Redeclaring a visible slot would clobber a binding the stack path still reads.
+                if (stmt->as.let_decl.slot >= let_limit || fw_bc3_reg_slot_visible(builder, stmt->as.let_decl.slot)) {
+                    return FW_BC3_ERR_INVALID_SLOT;
+                }
+                status = fw_bc3_reg_build_expression(builder, stmt->as.let_decl.expr_index, let_limit, &value);
+                if (status != FW_BC3_OK) {
+                    return status;
+                }
+                status = fw_bc3_reg_bind_let(builder, stmt->as.let_decl.slot, &value, false);
+                if (status != FW_BC3_OK) {
+                    return status;
+                }
+                memcpy(value.reg, builder->slot_regs[stmt->as.let_decl.slot], sizeof(value.reg));
+                status = fw_bc3_reg_emit_halt(builder, &value);
+                program->statements[stmt_index].as.let_decl.register_halt = (uint16_t)(program->register_op_count - 1U);
+                break;
+            case FW_BC3_STMT_BLEND: {
+                uint16_t color_expr = stmt->as.blend.expr_index;
+                if (stmt->blend_mode == (uint8_t)FW_BC3_BLEND_ALPHA_FIRST) {
+                    status = fw_bc3_reg_build_expression(builder, stmt->as.blend.alpha_expr, let_limit, &value);
+                    if (status != FW_BC3_OK) {
+                        return status;
+                    }
+                    if (value.tag != (uint8_t)FW_BC3_VALUE_SCALAR) {
+                        return FW_BC3_ERR_TYPE_MISMATCH;
+                    }
+                    status = fw_bc3_reg_emit_halt(builder, &value);
+                    if (status != FW_BC3_OK) {
+                        return status;
+                    }
+                    color_expr = (uint16_t)(stmt->as.blend.alpha_expr + 1U);
+                }
+                status = fw_bc3_reg_build_expression(builder, color_expr, let_limit, &value);
+                if (status != FW_BC3_OK) {
+                    return status;
+                }
+                if (value.tag != (uint8_t)FW_BC3_VALUE_RGBA) {
+                    return FW_BC3_ERR_TYPE_MISMATCH;
+                }
+                status = fw_bc3_reg_emit_halt(builder, &value);
+                break;
+            }
+            case FW_BC3_STMT_IF:
+                status = fw_bc3_reg_build_expression(builder, stmt->as.if_stmt.cond_expr_index, let_limit, &value);
+                if (status != FW_BC3_OK) {
+                    return status;
+                }
+                if (value.tag != (uint8_t)FW_BC3_VALUE_SCALAR) {
+                    return FW_BC3_ERR_TYPE_MISMATCH;
+                }
+                status = fw_bc3_reg_emit_halt(builder, &value);
+                if (status != FW_BC3_OK) {
+                    return status;
+                }
+                status = fw_bc3_reg_build_block(
+                    builder,
+                    stmt->as.if_stmt.then_start,
+                    stmt->as.if_stmt.then_count,
+                    let_limit,
+                    (uint8_t)(depth + 1U),
+                    NULL,
+                    0U
+                );
+                if (status != FW_BC3_OK) {
+                    return status;
+                }
+                status = fw_bc3_reg_build_block(
+                    builder,
+                    stmt->as.if_stmt.else_start,
+                    stmt->as.if_stmt.else_count,
+                    let_limit,
+                    (uint8_t)(depth + 1U),
+                    NULL,
+                    0U
+                );
+                break;
+            case FW_BC3_STMT_FOR: {
+                const uint16_t slot = stmt->as.for_stmt.index_slot;
+                uint8_t reg = 0;
+                if (slot >= let_limit || fw_bc3_reg_slot_visible(builder, slot)) {
+                    return FW_BC3_ERR_INVALID_SLOT;
+                }
+                if ((stmt->as.for_stmt.end_exclusive - stmt->as.for_stmt.start_inclusive) > FW_BC3_MAX_LOOP_ITERATIONS) {
+                    return FW_BC3_ERR_LOOP_LIMIT;
+                }
+                builder->temp_floor = FW_BC3_MAX_REGISTERS;
+                status = fw_bc3_reg_alloc_let(builder, &reg);
+                if (status != FW_BC3_OK) {
+                    return status;
+                }
+                program->statements[stmt_index].as.for_stmt.index_register = reg;
+                status = fw_bc3_reg_build_block(
+                    builder,
+                    stmt->as.for_stmt.body_start,
+                    stmt->as.for_stmt.body_count,
+                    let_limit,
+                    (uint8_t)(depth + 1U),
+                    &slot,
+                    reg
+                );
+                break;
+            }
+            default:
+                return FW_BC3_ERR_FORMAT;
+        }
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+    }
+
+    // Everything declared in this block is out of scope from here on.
+    builder->block_depth -= 1U;
+    builder->next_let = saved_next_let;
+    return FW_BC3_OK;
+}
+
+static void fw_bc3_reg_add_const(fw_bc3_program_t *program, float value, bool *overflow) {
+    uint8_t reg = 0;
+    if (fw_bc3_reg_find_const(program, value, &reg) == FW_BC3_OK) {
+        return;
+    }
+    if ((uint32_t)program->register_const_base + program->register_const_count >= FW_BC3_MAX_REGISTERS ||
+        program->register_const_count >= program->register_const_capacity) {
+        *overflow = true;
+        return;
+    }
+    program->register_const_values[program->register_const_count] = value;
+    program->register_const_count += 1U;
+}
+
+static void fw_bc3_reg_collect_consts(fw_bc3_program_t *program, uint16_t expr_index, bool *overflow) {
+    const fw_bc3_decoded_op_t *ops = &program->decoded_ops[program->expressions[expr_index].op_start];
+    const uint16_t op_count = program->expressions[expr_index].op_count;
+    for (uint16_t i = 0; i < op_count; i++) {
+        switch ((fw_bc3_decoded_opcode_t)ops[i].op) {
+            case FW_BC3_DOP_PUSH_SCALAR_LIT:
+            case FW_BC3_DOP_MUL_LIT:
+            case FW_BC3_DOP_ADD_LIT:
+            case FW_BC3_DOP_SUB_LIT:
+            case FW_BC3_DOP_RSUB_LIT:
+                fw_bc3_reg_add_const(program, ops[i].scalar, overflow);
+                break;
+            case FW_BC3_DOP_FMA_LIT:
+            case FW_BC3_DOP_SIN_AFFINE:
+            case FW_BC3_DOP_COS_AFFINE:
+                if (ops[i].index < program->decoded_affine_count) {
+                    fw_bc3_reg_add_const(program, program->decoded_affines[ops[i].index].scale, overflow);
+                    fw_bc3_reg_add_const(program, program->decoded_affines[ops[i].index].offset, overflow);
+                }
+                break;
+            default:
+                break;
+        }
+        if (*overflow) {
+            return;
+        }
+    }
+}
+
+// Lets grow up from the constants and temps down from FW_BC3_MAX_REGISTERS. Moving the temps down onto
+// the highest let leaves the register file at register_count rows; register order is kept, so nothing
+// that used distinct registers shares one afterwards.
+static void fw_bc3_reg_compact(fw_bc3_program_t *program, uint16_t let_high, uint16_t temp_low) {
+    const uint16_t gap = (temp_low > let_high) ? (uint16_t)(temp_low - let_high) : 0U;
+    program->register_count = (uint16_t)(FW_BC3_MAX_REGISTERS - gap);
+    if (gap == 0U) {
+        return;
+    }
+    for (uint16_t i = 0; i < program->register_op_count; i++) {
+        fw_bc3_register_op_t *op = &program->register_ops[i];
+        // A HALT's dst is the result's value tag; unused sources are 0, which is never a temp.
+        if (op->op != (uint8_t)FW_BC3_ROP_HALT && op->dst >= temp_low) {
+            op->dst = (uint8_t)(op->dst - gap);
+        }
+        for (uint8_t c = 0; c < 4U; c++) {
+            if (op->src[c] >= temp_low) {
+                op->src[c] = (uint8_t)(op->src[c] - gap);
+            }
+        }
+    }
+}
+
+static fw_bc3_status_t fw_bc3_build_register_form(fw_bc3_program_t *program) {
+    fw_bc3_reg_builder_t builder;
+    memset(&builder, 0, sizeof(builder));
+    builder.program = program;
+    builder.next_block_id = 1U;
+
+    if ((uint32_t)FW_BC3_INPUT_SLOT_COUNT + program->param_count > FW_BC3_MAX_REGISTERS) {
+        return FW_BC3_ERR_LIMIT;
+    }
+    program->register_param_base = (uint8_t)FW_BC3_INPUT_SLOT_COUNT;
+    program->register_const_base = (uint8_t)(FW_BC3_INPUT_SLOT_COUNT + program->param_count);
+
+    // Param expressions are parsed first; only x-dependent ones run as register ops, the rest are broadcast.
+    bool const_overflow = false;
+    for (uint16_t i = 0; i < program->param_count; i++) {
+        if (program->param_depends_x[i] != 0U) {
+            fw_bc3_reg_collect_consts(program, program->param_expr[i], &const_overflow);
+        }
+    }
+    for (uint16_t expr = program->param_count; expr < program->expr_count; expr++) {
+        fw_bc3_reg_collect_consts(program, expr, &const_overflow);
+    }
+    if (const_overflow) {
+        return FW_BC3_ERR_LIMIT;
+    }
+    builder.next_let = (uint16_t)(program->register_const_base + program->register_const_count);
+    builder.let_high = builder.next_let;
+    builder.temp_low = FW_BC3_MAX_REGISTERS;
+
+    // Top-level frame lets get registers that begin_frame fills from frame_values. Building their
+    // expressions only establishes the value types; those ops are dropped again.
+    builder.in_frame = true;
+    builder.active_blocks[0] = builder.next_block_id;
+    builder.block_depth = 1U;
+    builder.next_block_id += 1U;
+    for (uint16_t i = 0; i < program->frame_stmt_count; i++) {
+        const fw_bc3_stmt_view_t *stmt = &program->statements[program->frame_stmt_start + i];
+        fw_bc3_reg_entry_t value = {0};
+        if (stmt->kind != FW_BC3_STMT_LET || fw_bc3_reg_slot_visible(&builder, stmt->as.let_decl.slot)) {
+            continue;
+        }
+        if (fw_bc3_reg_build_expression(&builder, stmt->as.let_decl.expr_index, program->frame_let_count, &value) != FW_BC3_OK) {
+            continue;
+        }
+        fw_bc3_status_t status = fw_bc3_reg_bind_let(&builder, stmt->as.let_decl.slot, &value, true);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+        program->register_frame_let[stmt->as.let_decl.slot] = builder.slot_regs[stmt->as.let_decl.slot][0];
+        program->register_frame_let_tag[stmt->as.let_decl.slot] = value.tag;
+    }
+    builder.block_depth = 0U;
+    builder.in_frame = false;
+    program->register_op_count = 0U;
+    const uint16_t layer_let_base = builder.next_let;
+
+    builder.in_param = true;
+    for (uint16_t i = 0; i < program->param_count; i++) {
+        fw_bc3_reg_entry_t value = {0};
+        if (program->param_depends_x[i] == 0U) {
+            continue;
+        }
+        builder.x_param_limit = i;
+        fw_bc3_status_t status = fw_bc3_reg_build_expression(&builder, program->param_expr[i], 0U, &value);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+        if (value.tag != (uint8_t)FW_BC3_VALUE_SCALAR) {
+            return FW_BC3_ERR_TYPE_MISMATCH;
+        }
+        status = fw_bc3_reg_store(&builder, value.reg[0], (uint8_t)(program->register_param_base + i));
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+        value.reg[0] = (uint8_t)(program->register_param_base + i);
+        status = fw_bc3_reg_emit_halt(&builder, &value);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+    }
+    builder.in_param = false;
+
+    for (uint16_t layer = 0; layer < program->layer_count; layer++) {
+        builder.next_let = layer_let_base;
+        fw_bc3_status_t status = fw_bc3_reg_build_block(
+            &builder,
+            program->layer_stmt_start[layer],
+            program->layer_stmt_count[layer],
+            program->layer_let_count[layer],
+            0,
+            NULL,
+            0U
+        );
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+    }
+
+    fw_bc3_reg_compact(program, builder.let_high, builder.temp_low);
+    program->has_register_form = 1U;
+    return FW_BC3_OK;
+}
+
+// --- Program arena ---
+//
+// Every table that grows with the program lives in one caller-provided arena, one section after another
+// in the order of fw_bc3_arena_counts_t. A counting pass over the blob bounds each section before anything
+// is decoded: statements and parsed expressions exactly, decoded ops by the expanded instruction count plus
+// room for blend lowering, affines by the adds, subs, sin and cos that fusion can fold, the constant pool
+// by two entries per literal component, and register ops by one per decoded op plus the moves and HALTs
+// statements add. Once the program is decoded the sections are moved down to the counts actually used.
+
+#define FW_BC3_ARENA_ALIGN 4U
+
+typedef struct {
+    uint32_t statements;
+    uint32_t decoded_ops;
+    uint32_t decoded_affines;
+    uint32_t register_consts;
+    uint32_t expressions;
+    uint32_t register_ops;
+} fw_bc3_arena_counts_t;
+
+typedef struct {
+    size_t statements;
+    size_t decoded_ops;
+    size_t decoded_affines;
+    size_t register_consts;
+    size_t expressions;
+    size_t register_ops;
+    size_t total;
+} fw_bc3_arena_layout_t;
+
+static size_t fw_bc3_arena_align(size_t offset) {
+    return (offset + (FW_BC3_ARENA_ALIGN - 1U)) & ~(size_t)(FW_BC3_ARENA_ALIGN - 1U);
+}
+
+static void fw_bc3_arena_layout(const fw_bc3_arena_counts_t *counts, fw_bc3_arena_layout_t *out) {
+    size_t offset = 0;
+    out->statements = offset;
+    offset = fw_bc3_arena_align(offset + (size_t)counts->statements * sizeof(fw_bc3_stmt_view_t));
+    out->decoded_ops = offset;
+    offset = fw_bc3_arena_align(offset + (size_t)counts->decoded_ops * sizeof(fw_bc3_decoded_op_t));
+    out->decoded_affines = offset;
+    offset = fw_bc3_arena_align(offset + (size_t)counts->decoded_affines * sizeof(fw_bc3_affine_t));
+    out->register_consts = offset;
+    offset = fw_bc3_arena_align(offset + (size_t)counts->register_consts * sizeof(float));
+    out->expressions = offset;
+    offset = fw_bc3_arena_align(offset + (size_t)counts->expressions * sizeof(fw_bc3_expr_view_t));
+    out->register_ops = offset;
+    offset = fw_bc3_arena_align(offset + (size_t)counts->register_ops * sizeof(fw_bc3_register_op_t));
+    // Never report an empty arena, so the size can go straight to an allocator.
+    out->total = (offset != 0U) ? offset : FW_BC3_ARENA_ALIGN;
+}
+
+static void fw_bc3_arena_bind(fw_bc3_program_t *program, uint8_t *arena, const fw_bc3_arena_layout_t *layout) {
+    program->arena = arena;
+    program->statements = (fw_bc3_stmt_view_t *)(void *)(arena + layout->statements);
+    program->decoded_ops = (fw_bc3_decoded_op_t *)(void *)(arena + layout->decoded_ops);
+    program->decoded_affines = (fw_bc3_affine_t *)(void *)(arena + layout->decoded_affines);
+    program->register_const_values = (float *)(void *)(arena + layout->register_consts);
+    program->expressions = (fw_bc3_expr_view_t *)(void *)(arena + layout->expressions);
+    program->register_ops = (fw_bc3_register_op_t *)(void *)(arena + layout->register_ops);
+}
+
+static void fw_bc3_arena_used_counts(const fw_bc3_program_t *program, fw_bc3_arena_counts_t *out) {
+    out->statements = program->stmt_count;
+    out->decoded_ops = program->decoded_op_count;
+    out->decoded_affines = program->decoded_affine_count;
+    out->register_consts = program->register_const_count;
+    out->expressions = program->expr_count;
+    out->register_ops = program->register_op_count;
+}
+
+static uint32_t fw_bc3_min_u32(uint32_t a, uint32_t b) {
+    return (a < b) ? a : b;
+}
+
+static fw_bc3_status_t fw_bc3_count_expression(fw_bc3_cursor_t *cursor, fw_bc3_arena_counts_t *counts, uint32_t *out_op_count) {
+    uint32_t declared_max_stack = 0;
+    uint32_t instruction_count = 0;
+    fw_bc3_status_t status = fw_bc3_cursor_read_u32(cursor, &declared_max_stack);
+    if (status != FW_BC3_OK) {
+        return status;
+    }
+    status = fw_bc3_cursor_read_u32(cursor, &instruction_count);
+    if (status != FW_BC3_OK) {
+        return status;
+    }
+    if (instruction_count == 0U || instruction_count > FW_BC3_MAX_EXPR_INSTRUCTIONS) {
+        return FW_BC3_ERR_LIMIT;
+    }
+
+    // One decoded op per instruction, vec2/rgba literals expand to their components plus a constructor.
+    uint32_t op_count = 1U; // HALT
+    for (uint32_t i = 0; i < instruction_count; i++) {
+        uint8_t opcode = 0;
+        uint8_t tag = 0;
+        status = fw_bc3_cursor_read_u8(cursor, &opcode);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+        if (opcode == FW_BC3_OP_PUSH_LITERAL || opcode == FW_BC3_OP_PUSH_SLOT) {
+            status = fw_bc3_cursor_read_u8(cursor, &tag);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+        }
+
+        if (opcode == FW_BC3_OP_PUSH_LITERAL) {
+            const uint32_t components = (tag == FW_BC3_VALUE_SCALAR) ? 1U
+                                        : (tag == FW_BC3_VALUE_VEC2) ? 2U
+                                        : (tag == FW_BC3_VALUE_RGBA) ? 4U
+                                                                     : 0U;
+            if (components == 0U) {
+                return FW_BC3_ERR_INVALID_TAG;
+            }
+            op_count += (components == 1U) ? 1U : components + 1U;
+            counts->register_consts += 2U * components;
+            status = fw_bc3_cursor_skip(cursor, components * sizeof(float));
+        } else if (opcode == FW_BC3_OP_PUSH_SLOT) {
+            if (tag == FW_BC3_SLOT_INPUT) {
+                status = fw_bc3_cursor_skip(cursor, 1U);
+            } else if (tag == FW_BC3_SLOT_PARAM || tag == FW_BC3_SLOT_FRAME_LET || tag == FW_BC3_SLOT_LET) {
+                status = fw_bc3_cursor_skip(cursor, 4U);
+            } else {
+                return FW_BC3_ERR_INVALID_TAG;
+            }
+            op_count += 1U;
+        } else if (opcode == FW_BC3_OP_ADD || opcode == FW_BC3_OP_SUB) {
+            op_count += 1U;
+            counts->decoded_affines += 1U;
+        } else if (opcode == FW_BC3_OP_NEGATE || opcode == FW_BC3_OP_MUL || opcode == FW_BC3_OP_DIV || opcode == FW_BC3_OP_MOD) {
+            op_count += 1U;
+        } else if (opcode == FW_BC3_OP_CALL_BUILTIN) {
+            uint8_t builtin = 0;
+            status = fw_bc3_cursor_read_u8(cursor, &builtin);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            if (builtin == FW_BC3_BUILTIN_SIN || builtin == FW_BC3_BUILTIN_COS) {
+                counts->decoded_affines += 1U;
+            }
+            op_count += 1U;
+            status = fw_bc3_cursor_skip(cursor, 1U);
+        } else {
+            return FW_BC3_ERR_INVALID_OPCODE;
+        }
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+    }
+
+    counts->expressions += 1U;
+    counts->decoded_ops += op_count;
+    counts->register_ops += op_count;
+    *out_op_count = op_count;
+    return FW_BC3_OK;
+}
+
+static fw_bc3_status_t fw_bc3_count_statement_block(fw_bc3_cursor_t *cursor, uint8_t depth, fw_bc3_arena_counts_t *counts) {
+    if (depth > FW_BC3_MAX_STATEMENT_DEPTH) {
+        return FW_BC3_ERR_LIMIT;
+    }
+
+    uint32_t statement_count = 0;
+    fw_bc3_status_t status = fw_bc3_cursor_read_u32(cursor, &statement_count);
+    if (status != FW_BC3_OK) {
+        return status;
+    }
+    if (statement_count > FW_BC3_MAX_STATEMENTS - counts->statements) {
+        return FW_BC3_ERR_LIMIT;
+    }
+    counts->statements += statement_count;
+
+    for (uint32_t i = 0; i < statement_count; i++) {
+        uint8_t opcode = 0;
+        uint32_t op_count = 0;
+        status = fw_bc3_cursor_read_u8(cursor, &opcode);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+
+        if (opcode == FW_BC3_STMT_LET) {
+            status = fw_bc3_cursor_skip(cursor, 4U);
+            if (status == FW_BC3_OK) {
+                status = fw_bc3_count_expression(cursor, counts, &op_count);
+            }
+            // Up to four moves into the let's registers plus the HALT naming them.
+            counts->register_ops += 5U;
+        } else if (opcode == FW_BC3_STMT_BLEND) {
+            status = fw_bc3_count_expression(cursor, counts, &op_count);
+            // Alpha-first lowering appends two derived expressions holding at most op_count + 2 ops.
+            counts->expressions += 2U;
+            counts->decoded_ops += op_count + 2U;
+            counts->register_ops += op_count + 2U + 2U;
+        } else if (opcode == FW_BC3_STMT_IF) {
+            status = fw_bc3_count_expression(cursor, counts, &op_count);
+            if (status == FW_BC3_OK) {
+                status = fw_bc3_count_statement_block(cursor, (uint8_t)(depth + 1U), counts);
+            }
+            if (status == FW_BC3_OK) {
+                status = fw_bc3_count_statement_block(cursor, (uint8_t)(depth + 1U), counts);
+            }
+            counts->register_ops += 1U;
+        } else if (opcode == FW_BC3_STMT_FOR) {
+            status = fw_bc3_cursor_skip(cursor, 12U);
+            if (status == FW_BC3_OK) {
+                status = fw_bc3_count_statement_block(cursor, (uint8_t)(depth + 1U), counts);
+            }
+        } else {
+            return FW_BC3_ERR_INVALID_OPCODE;
+        }
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+    }
+    return FW_BC3_OK;
+}
+
+// Section capacities for `blob`, each clamped to its FW_BC3_MAX_* limit; decoding enforces the limits.
+static fw_bc3_status_t fw_bc3_count_program(const uint8_t *blob, size_t blob_len, fw_bc3_arena_counts_t *out) {
+    fw_bc3_cursor_t cursor = {
+        .base = blob,
+        .cur = blob,
+        .end = blob + blob_len,
+    };
+    memset(out, 0, sizeof(*out));
+
+    if (blob_len < 4U || memcmp(cursor.cur, "DSLB", 4U) != 0) {
+        return FW_BC3_ERR_BAD_MAGIC;
+    }
+    cursor.cur += 4U;
+    uint16_t version = 0;
+    fw_bc3_status_t status = fw_bc3_cursor_read_u16(&cursor, &version);
+    if (status != FW_BC3_OK) {
+        return status;
+    }
+    if (version != FW_BC3_VERSION) {
+        return FW_BC3_ERR_UNSUPPORTED_VERSION;
+    }
+    status = fw_bc3_cursor_skip(&cursor, 2U);
+    if (status != FW_BC3_OK) {
+        return status;
+    }
+
+    uint32_t param_count = 0;
+    status = fw_bc3_cursor_read_u32(&cursor, &param_count);
+    if (status != FW_BC3_OK) {
+        return status;
+    }
+    if (param_count > FW_BC3_MAX_PARAMS) {
+        return FW_BC3_ERR_LIMIT;
+    }
+    for (uint32_t i = 0; i < param_count; i++) {
+        uint32_t op_count = 0;
+        status = fw_bc3_cursor_skip(&cursor, 1U);
+        if (status == FW_BC3_OK) {
+            status = fw_bc3_count_expression(&cursor, out, &op_count);
+        }
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+        // x-dependent params move their result into the param register and HALT.
+        out->register_ops += 2U;
+    }
+
+    status = fw_bc3_count_statement_block(&cursor, 0, out);
+    if (status != FW_BC3_OK) {
+        return status;
+    }
+    uint32_t layer_count = 0;
+    status = fw_bc3_cursor_read_u32(&cursor, &layer_count);
+    if (status != FW_BC3_OK) {
+        return status;
+    }
+    if (layer_count > FW_BC3_MAX_LAYERS) {
+        return FW_BC3_ERR_LIMIT;
+    }
+    for (uint32_t i = 0; i < layer_count; i++) {
+        status = fw_bc3_count_statement_block(&cursor, 0, out);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+    }
+    if (cursor.cur != cursor.end) {
+        return FW_BC3_ERR_FORMAT;
+    }
+
+    out->expressions = fw_bc3_min_u32(out->expressions, FW_BC3_MAX_EXPRESSIONS);
+    out->decoded_ops = fw_bc3_min_u32(out->decoded_ops, FW_BC3_MAX_DECODED_OPS);
+    out->decoded_affines = fw_bc3_min_u32(out->decoded_affines, FW_BC3_MAX_DECODED_AFFINES);
+    out->register_consts = fw_bc3_min_u32(out->register_consts, FW_BC3_MAX_REGISTERS);
+    out->register_ops = fw_bc3_min_u32(out->register_ops, FW_BC3_MAX_REGISTER_OPS);
+    return FW_BC3_OK;
+}
+
+fw_bc3_status_t fw_bc3_program_arena_size(const uint8_t *blob, size_t blob_len, size_t *out_bytes) {
+    if (blob == NULL || blob_len < 8U || out_bytes == NULL) {
+        return FW_BC3_ERR_INVALID_ARG;
+    }
+    fw_bc3_arena_counts_t capacity;
+    fw_bc3_status_t status = fw_bc3_count_program(blob, blob_len, &capacity);
+    if (status != FW_BC3_OK) {
+        return status;
+    }
+    fw_bc3_arena_layout_t layout;
+    fw_bc3_arena_layout(&capacity, &layout);
+    *out_bytes = layout.total;
+    return FW_BC3_OK;
+}
+
+// Sections keep their order and only shrink, so each one moves down past nothing it has not already left.
+static void fw_bc3_arena_compact(fw_bc3_program_t *program) {
+    fw_bc3_arena_counts_t used;
+    fw_bc3_arena_layout_t layout;
+    fw_bc3_arena_used_counts(program, &used);
+    fw_bc3_arena_layout(&used, &layout);
+
+    uint8_t *arena = program->arena;
+    memmove(arena + layout.statements, program->statements, (size_t)used.statements * sizeof(fw_bc3_stmt_view_t));
+    memmove(arena + layout.decoded_ops, program->decoded_ops, (size_t)used.decoded_ops * sizeof(fw_bc3_decoded_op_t));
+    memmove(arena + layout.decoded_affines, program->decoded_affines, (size_t)used.decoded_affines * sizeof(fw_bc3_affine_t));
+    memmove(arena + layout.register_consts, program->register_const_values, (size_t)used.register_consts * sizeof(float));
+    memmove(arena + layout.expressions, program->expressions, (size_t)used.expressions * sizeof(fw_bc3_expr_view_t));
+    memmove(arena + layout.register_ops, program->register_ops, (size_t)used.register_ops * sizeof(fw_bc3_register_op_t));
+    fw_bc3_arena_bind(program, arena, &layout);
+
+    program->stmt_capacity = program->stmt_count;
+    program->decoded_op_capacity = program->decoded_op_count;
+    program->decoded_affine_capacity = program->decoded_affine_count;
+    program->register_const_capacity = program->register_const_count;
+    program->expr_capacity = program->expr_count;
+    program->register_op_capacity = program->register_op_count;
+    program->arena_used = layout.total;
+}
+
+void fw_bc3_program_relocate(fw_bc3_program_t *program, void *arena) {
+    if (program == NULL || arena == NULL || arena == program->arena) {
+        return;
+    }
+    fw_bc3_arena_counts_t used;
+    fw_bc3_arena_layout_t layout;
+    fw_bc3_arena_used_counts(program, &used);
+    fw_bc3_arena_layout(&used, &layout);
+    memcpy(arena, program->arena, layout.total);
+    fw_bc3_arena_bind(program, (uint8_t *)arena, &layout);
+    program->arena_len = layout.total;
+}
+
+fw_bc3_status_t fw_bc3_program_load(fw_bc3_program_t *program, const uint8_t *blob, size_t blob_len, void *arena, size_t arena_len) {
+    if (program == NULL || blob == NULL || blob_len < 8U || arena == NULL || ((uintptr_t)arena % FW_BC3_ARENA_ALIGN) != 0U) {
+        return FW_BC3_ERR_INVALID_ARG;
+    }
+
+    fw_bc3_arena_counts_t capacity;
+    fw_bc3_status_t status = fw_bc3_count_program(blob, blob_len, &capacity);
+    if (status != FW_BC3_OK) {
+        return status;
+    }
+    fw_bc3_arena_layout_t layout;
+    fw_bc3_arena_layout(&capacity, &layout);
+    if (layout.total > arena_len) {
+        return FW_BC3_ERR_LIMIT;
+    }
+
+    memset(program, 0, sizeof(*program));
+    program->blob = blob;
+    program->blob_len = blob_len;
+    program->arena_len = arena_len;
+    fw_bc3_arena_bind(program, (uint8_t *)arena, &layout);
+    program->stmt_capacity = (uint16_t)capacity.statements;
+    program->decoded_op_capacity = (uint16_t)capacity.decoded_ops;
+    program->decoded_affine_capacity = (uint16_t)capacity.decoded_affines;
+    program->register_const_capacity = (uint8_t)capacity.register_consts;
+    program->expr_capacity = (uint16_t)capacity.expressions;
+    program->register_op_capacity = (uint16_t)capacity.register_ops;
+
+    fw_bc3_cursor_t cursor = {
+        .base = blob,
+        .cur = blob,
+        .end = blob + blob_len,
+    };
+
+    if ((size_t)(cursor.end - cursor.cur) < 4U || memcmp(cursor.cur, "DSLB", 4U) != 0) {
+        return FW_BC3_ERR_BAD_MAGIC;
+    }
+    cursor.cur += 4U;
+
+    uint16_t version = 0;
+    status = fw_bc3_cursor_read_u16(&cursor, &version);
+    if (status != FW_BC3_OK) {
+        return status;
+    }
+    if (version != FW_BC3_VERSION) {
+        return FW_BC3_ERR_UNSUPPORTED_VERSION;
+    }
+
+    // v3 keeps the reserved u16 directly after version for forward-compatible flags.
+    uint16_t reserved_flags = 0;
+    status = fw_bc3_cursor_read_u16(&cursor, &reserved_flags);
+    if (status != FW_BC3_OK) {
+        return status;
+    }
+    (void)reserved_flags;
+
+    uint32_t param_count = 0;
+    status = fw_bc3_cursor_read_u32(&cursor, &param_count);
+    if (status != FW_BC3_OK) {
+        return status;
+    }
+    if (param_count > FW_BC3_MAX_PARAMS) {
+        return FW_BC3_ERR_LIMIT;
+    }
+    program->param_count = (uint16_t)param_count;
+
+    uint32_t param_index = 0;
+    while (param_index < param_count) {
+        uint8_t depends_on_xy = 0;
+        uint16_t expr_index = 0;
+        bool depends_on_x = false;
+        bool depends_on_y = false;
+        status = fw_bc3_cursor_read_u8(&cursor, &depends_on_xy);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+        if (depends_on_xy > 1U) {
+            return FW_BC3_ERR_FORMAT;
+        }
+
+        status = fw_bc3_parse_expression(program, &cursor, &expr_index);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+        status = fw_bc3_expression_scan_input_dependencies(program, expr_index, false, &depends_on_x, &depends_on_y);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+
+        // Keep legacy combined flag for compatibility while using fine-grained runtime flags.
+        program->param_depends_xy[param_index] = (depends_on_x || depends_on_y) ? 1U : 0U;
+        program->param_depends_x[param_index] = depends_on_x ? 1U : 0U;
+        program->param_depends_y[param_index] = depends_on_y ? 1U : 0U;
+        program->param_expr[param_index] = expr_index;
+        param_index += 1U;
+    }
+
+    fw_bc3_stmt_block_info_t frame_block = {0};
+    status = fw_bc3_parse_statement_block(program, &cursor, 0, &frame_block);
+    if (status != FW_BC3_OK) {
+        return status;
+    }
+    program->frame_stmt_start = frame_block.start;
+    program->frame_stmt_count = frame_block.count;
+    program->frame_let_count = frame_block.max_slot_plus_one;
+    if (program->frame_let_count > program->frame_value_count) {
+        program->frame_value_count = program->frame_let_count;
+    }
+    program->let_value_count = program->frame_let_count;
+
+    uint32_t layer_count = 0;
+    status = fw_bc3_cursor_read_u32(&cursor, &layer_count);
+    if (status != FW_BC3_OK) {
+        return status;
+    }
+    if (layer_count > FW_BC3_MAX_LAYERS) {
+        return FW_BC3_ERR_LIMIT;
+    }
+    program->layer_count = (uint16_t)layer_count;
+
+    uint32_t layer_index = 0;
+    while (layer_index < layer_count) {
+        fw_bc3_stmt_block_info_t layer_block = {0};
+        status = fw_bc3_parse_statement_block(program, &cursor, 0, &layer_block);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+        program->layer_stmt_start[layer_index] = layer_block.start;
+        program->layer_stmt_count[layer_index] = layer_block.count;
+        program->layer_let_count[layer_index] = layer_block.max_slot_plus_one;
+        if (layer_block.max_slot_plus_one > program->let_value_count) {
+            program->let_value_count = layer_block.max_slot_plus_one;
+        }
+        layer_index += 1U;
+    }
+
+    // Classify layer lets for hoisting; any layer above frame rate makes the output depend on x or y.
+    uint8_t slot_rate[FW_BC3_MAX_LET_SLOTS];
+    layer_index = 0;
+    while (layer_index < layer_count) {
+        uint8_t layer_rate = (uint8_t)FW_BC3_RATE_FRAME;
+        memset(slot_rate, (int)FW_BC3_RATE_PIXEL, sizeof(slot_rate));
+        status = fw_bc3_classify_statement_block(
+            program,
+            program->layer_stmt_start[layer_index],
+            program->layer_stmt_count[layer_index],
+            0,
+            1U,
+            slot_rate,
+            &layer_rate
+        );
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+        if (layer_rate != (uint8_t)FW_BC3_RATE_FRAME) {
+            program->pixel_depends_xy = 1U;
+        }
+        layer_index += 1U;
+    }
+
+    if (cursor.cur != cursor.end) {
+        return FW_BC3_ERR_FORMAT;
+    }
+
+    for (uint16_t stmt_index = 0; stmt_index < program->stmt_count; stmt_index++) {
+        const fw_bc3_stmt_view_t *stmt = &program->statements[stmt_index];
+        if (stmt->kind == FW_BC3_STMT_BLEND) {
+            fw_bc3_lower_blend(program, stmt_index);
+        }
+    }
+
+    // Without a register form the program still runs; rows just fall back to per-pixel evaluation.
+    if (fw_bc3_build_register_form(program) != FW_BC3_OK) {
+        program->has_register_form = 0U;
+        program->register_op_count = 0U;
+    }
+
+    fw_bc3_arena_compact(program);
+    return FW_BC3_OK;
+}
+
+static float IRAM_ATTR fw_bc3_clamp01(float value) {
+    if (value < 0.0f) {
+        return 0.0f;
+    }
+    if (value > 1.0f) {
+        return 1.0f;
+    }
+    return value;
+}
+
+// With -ffinite-math-only every inlined copy of fminf/fmaxf may order its operands differently, which only
+// shows when a shader feeds NaN (e.g. pow of a negative base) into clamp. Stack and register evaluation
+// share this one out-of-line copy so they keep agreeing bit for bit.
+static __attribute__((noinline)) float fw_bc3_clamp(float value, float lo, float hi) {
+    return fminf(fmaxf(value, lo), hi);
+}
+
+// Out of line as well: a vectorized copy may divide through a reciprocal estimate (GCC does so under
+// -ffast-math), which would drift from the scalar stack path.
+static __attribute__((noinline)) float fw_bc3_safe_div(float lhs, float rhs) {
+    return (rhs != 0.0f) ? (lhs / rhs) : ((lhs >= 0.0f) ? FLT_MAX : -FLT_MAX);
+}
+
+// Keeps vectorized loops on the scalar powf; vector math libraries (glibc's libmvec) round differently.
+static __attribute__((noinline)) float fw_bc3_pow(float base, float exponent) {
+    return powf(base, exponent);
+}
+
+static float IRAM_ATTR fw_bc3_linearstep(float edge0, float edge1, float x) {
+    if (edge0 == edge1) {
+        return (x < edge0) ? 0.0f : 1.0f;
+    }
+    return fw_bc3_clamp01((x - edge0) / (edge1 - edge0));
+}
+
+// Out of line for the same reason as fw_bc3_clamp: -ffast-math may re-associate each inlined copy
+// differently, and stack and register evaluation must agree bit for bit.
+static __attribute__((noinline)) float IRAM_ATTR fw_bc3_smoothstep(float edge0, float edge1, float x) {
+    const float t = fw_bc3_linearstep(edge0, edge1, x);
+    return t * t * (3.0f - (2.0f * t));
+}
+
+static uint32_t fw_bc3_hash_u32(uint32_t value) {
+    uint32_t x = value;
+    x ^= x >> 16U;
+    x *= 0x7feb352dU;
+    x ^= x >> 15U;
+    x *= 0x846ca68bU;
+    x ^= x >> 16U;
+    return x;
+}
+
+static uint32_t fw_bc3_bitcast_u32_from_i32(int32_t value) {
+    uint32_t out = 0;
+    memcpy(&out, &value, sizeof(out));
+    return out;
+}
+
+static int32_t fw_bc3_scalar_to_i32(float value) {
+    const float min_i32 = (float)INT32_MIN;
+    const float max_i32 = (float)INT32_MAX;
+    if (value < min_i32) {
+        value = min_i32;
+    }
+    if (value > max_i32) {
+        value = max_i32;
+    }
+    return (int32_t)value;
+}
+
+static uint32_t fw_bc3_scalar_to_u32(float value) {
+    return fw_bc3_bitcast_u32_from_i32(fw_bc3_scalar_to_i32(value));
+}
+
+static float fw_bc3_hash01(uint32_t value) {
+    const uint32_t hashed = fw_bc3_hash_u32(value) & 0x00ffffffU;
+    return (float)hashed / 16777215.0f;
+}
+
+static float fw_bc3_hash_signed(uint32_t value) {
+    return (fw_bc3_hash01(value) * 2.0f) - 1.0f;
+}
+
+static float fw_bc3_hash_coords01(int32_t x, int32_t y, uint32_t seed) {
+    const uint32_t ux = fw_bc3_bitcast_u32_from_i32(x);
+    const uint32_t uy = fw_bc3_bitcast_u32_from_i32(y);
+    const uint32_t mixed = (ux * 0x1f123bb5U) ^ (uy * 0x5f356495U) ^ seed;
+    return fw_bc3_hash01(mixed);
+}
+
+static float fw_bc3_vec2_length(fw_bc3_vec2_t vec) {
+    return dsl_fast_sqrtf((vec.x * vec.x) + (vec.y * vec.y));
+}
+
+static float fw_bc3_box_distance(fw_bc3_vec2_t p, fw_bc3_vec2_t half_size) {
+    fw_bc3_vec2_t q = {0};
+    fw_bc3_vec2_t outside = {0};
+    float inside = 0.0f;
+
+    q.x = fabsf(p.x) - half_size.x;
+    q.y = fabsf(p.y) - half_size.y;
+    outside.x = (q.x > 0.0f) ? q.x : 0.0f;
+    outside.y = (q.y > 0.0f) ? q.y : 0.0f;
+    inside = fminf(fmaxf(q.x, q.y), 0.0f);
+    return fw_bc3_vec2_length(outside) + inside;
+}
+
+static float fw_bc3_wrapped_delta_x(float px, float center_x, float width) {
+    float dx = px - center_x;
+    const float half_width = width * 0.5f;
+    if (dx > half_width) {
+        dx -= width;
+    }
+    if (dx < -half_width) {
+        dx += width;
+    }
+    return dx;
+}
+
+static float fw_bc3_fast_sin(float x) {
+    return dsl_fast_sinf(x);
+}
+
+static float fw_bc3_fast_cos(float x) {
+    return dsl_fast_cosf(x);
+}
+
+// --- Simplex noise (matches dsl_c_emitter.zig preamble) ---
+
+static const unsigned char fw_bc3_noise_perm[512] = {
+    151,160,137,91,90,15,131,13,201,95,96,53,194,233,7,225,
+    140,36,103,30,69,142,8,99,37,240,21,10,23,190,6,148,
+    247,120,234,75,0,26,197,62,94,252,219,203,117,35,11,32,
+    57,177,33,88,237,149,56,87,174,20,125,136,171,168,68,175,
+    74,165,71,134,139,48,27,166,77,146,158,231,83,111,229,122,
+    60,211,133,230,220,105,92,41,55,46,245,40,244,102,143,54,
+    65,25,63,161,1,216,80,73,209,76,132,187,208,89,18,169,
+    200,196,135,130,116,188,159,86,164,100,109,198,173,186,3,64,
+    52,217,226,250,124,123,5,202,38,147,118,126,255,82,85,212,
+    207,206,59,227,47,16,58,17,182,189,28,42,223,183,170,213,
+    119,248,152,2,44,154,163,70,221,153,101,155,167,43,172,9,
+    129,22,39,253,19,98,108,110,79,113,224,232,178,185,112,104,
+    218,246,97,228,251,34,242,193,238,210,144,12,191,179,162,241,
+    81,51,145,235,249,14,239,107,49,192,214,31,181,199,106,157,
+    184,84,204,176,115,121,50,45,127,4,150,254,138,236,205,93,
+    222,114,67,29,24,72,243,141,128,195,78,66,215,61,156,180,
+    151,160,137,91,90,15,131,13,201,95,96,53,194,233,7,225,
+    140,36,103,30,69,142,8,99,37,240,21,10,23,190,6,148,
+    247,120,234,75,0,26,197,62,94,252,219,203,117,35,11,32,
+    57,177,33,88,237,149,56,87,174,20,125,136,171,168,68,175,
+    74,165,71,134,139,48,27,166,77,146,158,231,83,111,229,122,
+    60,211,133,230,220,105,92,41,55,46,245,40,244,102,143,54,
+    65,25,63,161,1,216,80,73,209,76,132,187,208,89,18,169,
+    200,196,135,130,116,188,159,86,164,100,109,198,173,186,3,64,
+    52,217,226,250,124,123,5,202,38,147,118,126,255,82,85,212,
+    207,206,59,227,47,16,58,17,182,189,28,42,223,183,170,213,
+    119,248,152,2,44,154,163,70,221,153,101,155,167,43,172,9,
+    129,22,39,253,19,98,108,110,79,113,224,232,178,185,112,104,
+    218,246,97,228,251,34,242,193,238,210,144,12,191,179,162,241,
+    81,51,145,235,249,14,239,107,49,192,214,31,181,199,106,157,
+    184,84,204,176,115,121,50,45,127,4,150,254,138,236,205,93,
+    222,114,67,29,24,72,243,141,128,195,78,66,215,61,156,180,
+};
+
+static inline float fw_bc3_grad2(int hash, float x, float y) {
+    const int h = hash & 7;
+    const float u = h < 4 ? x : y;
+    const float v = h < 4 ? y : x;
+    return ((h & 1) ? -u : u) + ((h & 2) ? -2.0f * v : 2.0f * v);
+}
+
+// Out of line for the same reason as fw_bc3_clamp: -ffast-math re-associates each inlined copy differently.
+static __attribute__((noinline)) float fw_bc3_noise2(float x, float y) {
+    const float F2 = 0.3660254037844386f;
+    const float G2 = 0.21132486540518713f;
+    const float s = (x + y) * F2;
+    const int i = (int)floorf(x + s);
+    const int j = (int)floorf(y + s);
+    const float t = (float)(i + j) * G2;
+    const float x0 = x - ((float)i - t);
+    const float y0 = y - ((float)j - t);
+    int i1, j1;
+    if (x0 > y0) { i1 = 1; j1 = 0; } else { i1 = 0; j1 = 1; }
+    const float x1 = x0 - (float)i1 + G2;
+    const float y1 = y0 - (float)j1 + G2;
+    const float x2 = x0 - 1.0f + 2.0f * G2;
+    const float y2 = y0 - 1.0f + 2.0f * G2;
+    const int ii = i & 255;
+    const int jj = j & 255;
+    float n = 0.0f;
+    float t0 = 0.5f - x0*x0 - y0*y0;
+    if (t0 >= 0.0f) { t0 *= t0; n += t0 * t0 * fw_bc3_grad2(fw_bc3_noise_perm[ii + fw_bc3_noise_perm[jj]], x0, y0); }
+    float t1 = 0.5f - x1*x1 - y1*y1;
+    if (t1 >= 0.0f) { t1 *= t1; n += t1 * t1 * fw_bc3_grad2(fw_bc3_noise_perm[ii + i1 + fw_bc3_noise_perm[jj + j1]], x1, y1); }
+    float t2 = 0.5f - x2*x2 - y2*y2;
+    if (t2 >= 0.0f) { t2 *= t2; n += t2 * t2 * fw_bc3_grad2(fw_bc3_noise_perm[ii + 1 + fw_bc3_noise_perm[jj + 1]], x2, y2); }
+    return 70.0f * n;
+}
+
+static inline float fw_bc3_grad3(int hash, float x, float y, float z) {
+    const int h = hash & 15;
+    const float u = h < 8 ? x : y;
+    const float v = h < 4 ? y : (h == 12 || h == 14 ? x : z);
+    return ((h & 1) ? -u : u) + ((h & 2) ? -v : v);
+}
+
+static __attribute__((noinline)) float fw_bc3_noise3(float x, float y, float z) {
+    const float F3 = 1.0f / 3.0f;
+    const float G3 = 1.0f / 6.0f;
+    const float s = (x + y + z) * F3;
+    const int i = (int)floorf(x + s);
+    const int j = (int)floorf(y + s);
+    const int k = (int)floorf(z + s);
+    const float t = (float)(i + j + k) * G3;
+    const float x0 = x - ((float)i - t);
+    const float y0 = y - ((float)j - t);
+    const float z0 = z - ((float)k - t);
+    int i1, j1, k1, i2, j2, k2;
+    if (x0 >= y0) {
+        if (y0 >= z0) { i1=1;j1=0;k1=0;i2=1;j2=1;k2=0; }
+        else if (x0 >= z0) { i1=1;j1=0;k1=0;i2=1;j2=0;k2=1; }
+        else { i1=0;j1=0;k1=1;i2=1;j2=0;k2=1; }
+    } else {
+        if (y0 < z0) { i1=0;j1=0;k1=1;i2=0;j2=1;k2=1; }
+        else if (x0 < z0) { i1=0;j1=1;k1=0;i2=0;j2=1;k2=1; }
+        else { i1=0;j1=1;k1=0;i2=1;j2=1;k2=0; }
+    }
+    const float x1 = x0 - (float)i1 + G3;
+    const float y1 = y0 - (float)j1 + G3;
+    const float z1 = z0 - (float)k1 + G3;
+    const float x2 = x0 - (float)i2 + 2.0f*G3;
+    const float y2 = y0 - (float)j2 + 2.0f*G3;
+    const float z2 = z0 - (float)k2 + 2.0f*G3;
+    const float x3 = x0 - 1.0f + 3.0f*G3;
+    const float y3 = y0 - 1.0f + 3.0f*G3;
+    const float z3 = z0 - 1.0f + 3.0f*G3;
+    const int ii = i & 255;
+    const int jj = j & 255;
+    const int kk = k & 255;
+    float n = 0.0f;
+    float c0 = 0.6f - x0*x0 - y0*y0 - z0*z0;
+    if (c0 >= 0.0f) { c0 *= c0; n += c0*c0*fw_bc3_grad3(fw_bc3_noise_perm[ii+fw_bc3_noise_perm[jj+fw_bc3_noise_perm[kk]]], x0, y0, z0); }
+    float c1 = 0.6f - x1*x1 - y1*y1 - z1*z1;
+    if (c1 >= 0.0f) { c1 *= c1; n += c1*c1*fw_bc3_grad3(fw_bc3_noise_perm[ii+i1+fw_bc3_noise_perm[jj+j1+fw_bc3_noise_perm[kk+k1]]], x1, y1, z1); }
+    float c2 = 0.6f - x2*x2 - y2*y2 - z2*z2;
+    if (c2 >= 0.0f) { c2 *= c2; n += c2*c2*fw_bc3_grad3(fw_bc3_noise_perm[ii+i2+fw_bc3_noise_perm[jj+j2+fw_bc3_noise_perm[kk+k2]]], x2, y2, z2); }
+    float c3 = 0.6f - x3*x3 - y3*y3 - z3*z3;
+    if (c3 >= 0.0f) { c3 *= c3; n += c3*c3*fw_bc3_grad3(fw_bc3_noise_perm[ii+1+fw_bc3_noise_perm[jj+1+fw_bc3_noise_perm[kk+1]]], x3, y3, z3); }
+    return 32.0f * n;
+}
+
+static fw_bc3_color_t fw_bc3_color_clamped(fw_bc3_color_t color) {
+    fw_bc3_color_t out = color;
+    out.r = fw_bc3_clamp01(out.r);
+    out.g = fw_bc3_clamp01(out.g);
+    out.b = fw_bc3_clamp01(out.b);
+    out.a = fw_bc3_clamp01(out.a);
+    return out;
+}
+
+// The pixel color starts opaque and blends are the only statements that write it, so dst.a is always 1:
+// out_a = s.a + (1 - s.a) rounds to exactly 1, leaving no division and no transparent-result branch.
+static fw_bc3_color_t IRAM_ATTR fw_bc3_blend_over_opaque(fw_bc3_color_t src, fw_bc3_color_t dst) {
+    const fw_bc3_color_t s = fw_bc3_color_clamped(src);
+    const float one_minus_src_a = 1.0f - s.a;
+    return (fw_bc3_color_t){
+        .r = (s.r * s.a) + (fw_bc3_clamp01(dst.r) * one_minus_src_a),
+        .g = (s.g * s.a) + (fw_bc3_clamp01(dst.g) * one_minus_src_a),
+        .b = (s.b * s.a) + (fw_bc3_clamp01(dst.b) * one_minus_src_a),
+        .a = 1.0f,
+    };
+}
+
+// Blend of a source with alpha >= 1 over an opaque pixel: the clamped source replaces it.
+static fw_bc3_color_t IRAM_ATTR fw_bc3_color_opaque(fw_bc3_color_t src) {
+    return (fw_bc3_color_t){
+        .r = fw_bc3_clamp01(src.r),
+        .g = fw_bc3_clamp01(src.g),
+        .b = fw_bc3_clamp01(src.b),
+        .a = 1.0f,
+    };
+}
+
+static fw_bc3_status_t fw_bc3_value_as_scalar(const fw_bc3_value_t *value, float *out) {
+    if (value->tag != FW_BC3_VALUE_SCALAR) {
+        return FW_BC3_ERR_TYPE_MISMATCH;
+    }
+    *out = value->as.scalar;
+    return FW_BC3_OK;
+}
+
+static fw_bc3_status_t fw_bc3_value_as_vec2(const fw_bc3_value_t *value, fw_bc3_vec2_t *out) {
+    if (value->tag != FW_BC3_VALUE_VEC2) {
+        return FW_BC3_ERR_TYPE_MISMATCH;
+    }
+    *out = value->as.vec2;
+    return FW_BC3_OK;
+}
+
+static fw_bc3_status_t fw_bc3_eval_builtin(
+    uint8_t builtin,
+    const fw_bc3_value_t *args,
+    uint8_t arg_count,
+    fw_bc3_value_t *out
+) {
+    if (builtin >= FW_BC3_BUILTIN_COUNT) {
+        return FW_BC3_ERR_INVALID_BUILTIN;
+    }
+
+    float a0 = 0.0f;
+    float a1 = 0.0f;
+    float a2 = 0.0f;
+    fw_bc3_vec2_t v0 = {0};
+    fw_bc3_vec2_t v1 = {0};
+    fw_bc3_status_t status = FW_BC3_OK;
+
+    switch ((fw_bc3_builtin_id_t)builtin) {
+        case FW_BC3_BUILTIN_SIN:
+            if (arg_count != 1U) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            status = fw_bc3_value_as_scalar(&args[0], &a0);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            *out = fw_bc3_make_scalar(fw_bc3_fast_sin(a0));
+            return FW_BC3_OK;
+        case FW_BC3_BUILTIN_COS:
+            if (arg_count != 1U) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            status = fw_bc3_value_as_scalar(&args[0], &a0);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            *out = fw_bc3_make_scalar(fw_bc3_fast_cos(a0));
+            return FW_BC3_OK;
+        case FW_BC3_BUILTIN_SQRT:
+            if (arg_count != 1U) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            status = fw_bc3_value_as_scalar(&args[0], &a0);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            *out = fw_bc3_make_scalar(dsl_fast_sqrtf(a0));
+            return FW_BC3_OK;
+        case FW_BC3_BUILTIN_LN:
+            if (arg_count != 1U) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            status = fw_bc3_value_as_scalar(&args[0], &a0);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            *out = fw_bc3_make_scalar(dsl_fast_logf(a0));
+            return FW_BC3_OK;
+        case FW_BC3_BUILTIN_LOG:
+            if (arg_count != 1U) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            status = fw_bc3_value_as_scalar(&args[0], &a0);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            *out = fw_bc3_make_scalar(dsl_fast_log10f(a0));
+            return FW_BC3_OK;
+        case FW_BC3_BUILTIN_ABS:
+            if (arg_count != 1U) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            status = fw_bc3_value_as_scalar(&args[0], &a0);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            *out = fw_bc3_make_scalar(fabsf(a0));
+            return FW_BC3_OK;
+        case FW_BC3_BUILTIN_FLOOR:
+            if (arg_count != 1U) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            status = fw_bc3_value_as_scalar(&args[0], &a0);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            *out = fw_bc3_make_scalar(dsl_fast_floorf(a0));
+            return FW_BC3_OK;
+        case FW_BC3_BUILTIN_FRACT:
+            if (arg_count != 1U) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            status = fw_bc3_value_as_scalar(&args[0], &a0);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            *out = fw_bc3_make_scalar(a0 - dsl_fast_floorf(a0));
+            return FW_BC3_OK;
+        case FW_BC3_BUILTIN_MIN:
+            if (arg_count != 2U) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            status = fw_bc3_value_as_scalar(&args[0], &a0);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            status = fw_bc3_value_as_scalar(&args[1], &a1);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            *out = fw_bc3_make_scalar(fminf(a0, a1));
+            return FW_BC3_OK;
+        case FW_BC3_BUILTIN_MAX:
+            if (arg_count != 2U) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            status = fw_bc3_value_as_scalar(&args[0], &a0);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            status = fw_bc3_value_as_scalar(&args[1], &a1);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            *out = fw_bc3_make_scalar(fmaxf(a0, a1));
+            return FW_BC3_OK;
+        case FW_BC3_BUILTIN_CLAMP:
+            if (arg_count != 3U) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            status = fw_bc3_value_as_scalar(&args[0], &a0);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            status = fw_bc3_value_as_scalar(&args[1], &a1);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            status = fw_bc3_value_as_scalar(&args[2], &a2);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            *out = fw_bc3_make_scalar(fw_bc3_clamp(a0, a1, a2));
+            return FW_BC3_OK;
+        case FW_BC3_BUILTIN_SMOOTHSTEP:
+            if (arg_count != 3U) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            status = fw_bc3_value_as_scalar(&args[0], &a0);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            status = fw_bc3_value_as_scalar(&args[1], &a1);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            status = fw_bc3_value_as_scalar(&args[2], &a2);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            *out = fw_bc3_make_scalar(fw_bc3_smoothstep(a0, a1, a2));
+            return FW_BC3_OK;
+        case FW_BC3_BUILTIN_CIRCLE:
+            if (arg_count != 2U) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            status = fw_bc3_value_as_vec2(&args[0], &v0);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            status = fw_bc3_value_as_scalar(&args[1], &a0);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            *out = fw_bc3_make_scalar(fw_bc3_vec2_length(v0) - a0);
+            return FW_BC3_OK;
+        case FW_BC3_BUILTIN_BOX:
+            if (arg_count != 2U) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            status = fw_bc3_value_as_vec2(&args[0], &v0);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            status = fw_bc3_value_as_vec2(&args[1], &v1);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+
+            *out = fw_bc3_make_scalar(fw_bc3_box_distance(v0, v1));
+            return FW_BC3_OK;
+        case FW_BC3_BUILTIN_WRAPDX:
+            if (arg_count != 3U) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            status = fw_bc3_value_as_scalar(&args[0], &a0);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            status = fw_bc3_value_as_scalar(&args[1], &a1);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            status = fw_bc3_value_as_scalar(&args[2], &a2);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            *out = fw_bc3_make_scalar(fw_bc3_wrapped_delta_x(a0, a1, a2));
+            return FW_BC3_OK;
+        case FW_BC3_BUILTIN_HASH01:
+            if (arg_count != 1U) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            status = fw_bc3_value_as_scalar(&args[0], &a0);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            *out = fw_bc3_make_scalar(fw_bc3_hash01(fw_bc3_scalar_to_u32(a0)));
+            return FW_BC3_OK;
+        case FW_BC3_BUILTIN_HASH_SIGNED:
+            if (arg_count != 1U) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            status = fw_bc3_value_as_scalar(&args[0], &a0);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            *out = fw_bc3_make_scalar(fw_bc3_hash_signed(fw_bc3_scalar_to_u32(a0)));
+            return FW_BC3_OK;
+        case FW_BC3_BUILTIN_HASH_COORDS01:
+            if (arg_count != 3U) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            status = fw_bc3_value_as_scalar(&args[0], &a0);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            status = fw_bc3_value_as_scalar(&args[1], &a1);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            status = fw_bc3_value_as_scalar(&args[2], &a2);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            *out = fw_bc3_make_scalar(
+                fw_bc3_hash_coords01(fw_bc3_scalar_to_i32(a0), fw_bc3_scalar_to_i32(a1), fw_bc3_scalar_to_u32(a2))
+            );
+            return FW_BC3_OK;
+        case FW_BC3_BUILTIN_POW:
+            if (arg_count != 2U) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            status = fw_bc3_value_as_scalar(&args[0], &a0);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            status = fw_bc3_value_as_scalar(&args[1], &a1);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            *out = fw_bc3_make_scalar(fw_bc3_pow(a0, a1));
+            return FW_BC3_OK;
+        case FW_BC3_BUILTIN_NOISE:
+            if (arg_count != 2U) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            status = fw_bc3_value_as_scalar(&args[0], &a0);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            status = fw_bc3_value_as_scalar(&args[1], &a1);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            *out = fw_bc3_make_scalar(fw_bc3_noise2(a0, a1));
+            return FW_BC3_OK;
+        case FW_BC3_BUILTIN_NOISE3:
+            if (arg_count != 3U) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            status = fw_bc3_value_as_scalar(&args[0], &a0);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            status = fw_bc3_value_as_scalar(&args[1], &a1);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            status = fw_bc3_value_as_scalar(&args[2], &a2);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            *out = fw_bc3_make_scalar(fw_bc3_noise3(a0, a1, a2));
+            return FW_BC3_OK;
+        case FW_BC3_BUILTIN_PHASOR:
+            /* Phasor requires persistent state; returns 0 in bytecode VM. */
+            *out = fw_bc3_make_scalar(0.0f);
+            return FW_BC3_OK;
+        case FW_BC3_BUILTIN_VEC2:
+            if (arg_count != 2U) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            status = fw_bc3_value_as_scalar(&args[0], &a0);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            status = fw_bc3_value_as_scalar(&args[1], &a1);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            out->tag = FW_BC3_VALUE_VEC2;
+            out->as.vec2.x = a0;
+            out->as.vec2.y = a1;
+            return FW_BC3_OK;
+        case FW_BC3_BUILTIN_RGBA:
+            if (arg_count != 4U) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            status = fw_bc3_value_as_scalar(&args[0], &a0);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            status = fw_bc3_value_as_scalar(&args[1], &a1);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            status = fw_bc3_value_as_scalar(&args[2], &a2);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+            {
+                float a3 = 0.0f;
+                status = fw_bc3_value_as_scalar(&args[3], &a3);
+                if (status != FW_BC3_OK) {
+                    return status;
+                }
+                out->tag = FW_BC3_VALUE_RGBA;
+                out->as.rgba = (fw_bc3_color_t){
+                    .r = a0,
+                    .g = a1,
+                    .b = a2,
+                    .a = a3,
+                };
+            }
+            return FW_BC3_OK;
+        default:
+            return FW_BC3_ERR_INVALID_BUILTIN;
+    }
+}
+
+static void fw_bc3_reset_value_slots(fw_bc3_value_t *values, uint16_t count) {
+    uint16_t i = 0;
+    while (i < count) {
+        values[i] = fw_bc3_make_scalar(0.0f);
+        i += 1U;
+    }
+}
+
+
+
+static fw_bc3_status_t __attribute__((flatten)) IRAM_ATTR fw_bc3_eval_expression(
+    fw_bc3_runtime_t *runtime,
+    uint16_t expr_index,
+    const fw_bc3_inputs_t *inputs,
+    uint16_t let_limit,
+    fw_bc3_value_t *out
+) {
+    if (expr_index >= runtime->program->expr_count) {
+        return FW_BC3_ERR_FORMAT;
+    }
+
+    const fw_bc3_decoded_op_t *op = &runtime->program->decoded_ops[runtime->program->expressions[expr_index].op_start];
+    const fw_bc3_affine_t *affines = runtime->program->decoded_affines;
+    fw_bc3_value_t *stack = runtime->expr_stack;
+    uint16_t sp = 0;
+
+    // Computed-goto dispatch table — contiguous enum values 0..37 for a compact jump table.
+    static const void *dispatch_table[] = {
+        [FW_BC3_DOP_PUSH_SCALAR_LIT] = &&dop_push_scalar_lit,
+        [FW_BC3_DOP_PUSH_INPUT]      = &&dop_push_input,
+        [FW_BC3_DOP_PUSH_PARAM]      = &&dop_push_param,
+        [FW_BC3_DOP_PUSH_FRAME_LET]  = &&dop_push_frame_let,
+        [FW_BC3_DOP_PUSH_LET]        = &&dop_push_let,
+        [FW_BC3_DOP_NEGATE]          = &&dop_negate,
+        [FW_BC3_DOP_ADD]             = &&dop_add,
+        [FW_BC3_DOP_SUB]             = &&dop_sub,
+        [FW_BC3_DOP_MUL]             = &&dop_mul,
+        [FW_BC3_DOP_DIV]             = &&dop_div,
+        [FW_BC3_DOP_MOD]             = &&dop_mod,
+        [FW_BC3_DOP_CALL_BUILTIN]    = &&dop_call_builtin,
+        [FW_BC3_DOP_BUILTIN_SIN]     = &&dop_sin,
+        [FW_BC3_DOP_BUILTIN_COS]     = &&dop_cos,
+        [FW_BC3_DOP_BUILTIN_SQRT]    = &&dop_sqrt,
+        [FW_BC3_DOP_BUILTIN_ABS]     = &&dop_abs,
+        [FW_BC3_DOP_BUILTIN_FLOOR]   = &&dop_floor,
+        [FW_BC3_DOP_BUILTIN_FRACT]   = &&dop_fract,
+        [FW_BC3_DOP_BUILTIN_LN]      = &&dop_ln,
+        [FW_BC3_DOP_BUILTIN_LOG]     = &&dop_log,
+        [FW_BC3_DOP_BUILTIN_MIN]     = &&dop_min,
+        [FW_BC3_DOP_BUILTIN_MAX]     = &&dop_max,
+        [FW_BC3_DOP_BUILTIN_CLAMP]   = &&dop_clamp,
+        [FW_BC3_DOP_BUILTIN_SMOOTHSTEP] = &&dop_smoothstep,
+        [FW_BC3_DOP_BUILTIN_POW]     = &&dop_pow,
+        [FW_BC3_DOP_BUILTIN_NOISE]   = &&dop_noise,
+        [FW_BC3_DOP_BUILTIN_NOISE3]  = &&dop_noise3,
+        [FW_BC3_DOP_BUILTIN_PHASOR]  = &&dop_phasor,
+        [FW_BC3_DOP_BUILTIN_VEC2]    = &&dop_vec2,
+        [FW_BC3_DOP_BUILTIN_RGBA]    = &&dop_rgba,
+        [FW_BC3_DOP_MUL_LIT]         = &&dop_mul_lit,
+        [FW_BC3_DOP_ADD_LIT]         = &&dop_add_lit,
+        [FW_BC3_DOP_SUB_LIT]         = &&dop_sub_lit,
+        [FW_BC3_DOP_RSUB_LIT]        = &&dop_rsub_lit,
+        [FW_BC3_DOP_FMA_LIT]         = &&dop_fma_lit,
+        [FW_BC3_DOP_SIN_AFFINE]      = &&dop_sin_affine,
+        [FW_BC3_DOP_COS_AFFINE]      = &&dop_cos_affine,
+        [FW_BC3_DOP_HALT]            = &&dop_halt,
+    };
+
+#define NEXT() do { ++op; goto *dispatch_table[op->op]; } while(0)
+
+    goto *dispatch_table[op->op];
+
+dop_push_scalar_lit:
+    stack[sp].tag = FW_BC3_VALUE_SCALAR;
+    stack[sp].as.scalar = op->scalar;
+    sp++;
+    NEXT();
+dop_push_input:
+    stack[sp].tag = FW_BC3_VALUE_SCALAR;
+    stack[sp].as.scalar = ((const float *)inputs)[op->index];
+    sp++;
+    NEXT();
+dop_push_param:
+    stack[sp].tag = FW_BC3_VALUE_SCALAR;
+    stack[sp].as.scalar = runtime->param_values[op->index];
+    sp++;
+    NEXT();
+dop_push_frame_let:
+    stack[sp] = runtime->frame_values[op->index];
+    sp++;
+    NEXT();
+dop_push_let:
+    if (op->index >= let_limit) {
+        return FW_BC3_ERR_INVALID_SLOT;
+    }
+    stack[sp] = runtime->let_values[op->index];
+    sp++;
+    NEXT();
+dop_negate:
+    stack[sp - 1].as.scalar = -(stack[sp - 1].as.scalar);
+    NEXT();
+dop_add:
+    stack[sp - 2].as.scalar = stack[sp - 2].as.scalar + stack[sp - 1].as.scalar;
+    sp--;
+    NEXT();
+dop_sub:
+    stack[sp - 2].as.scalar = stack[sp - 2].as.scalar - stack[sp - 1].as.scalar;
+    sp--;
+    NEXT();
+dop_mul:
+    stack[sp - 2].as.scalar = stack[sp - 2].as.scalar * stack[sp - 1].as.scalar;
+    sp--;
+    NEXT();
+dop_div: {
+    float rhs = stack[sp - 1].as.scalar;
+    float lhs = stack[sp - 2].as.scalar;
+    stack[sp - 2].as.scalar = fw_bc3_safe_div(lhs, rhs);
+    sp--;
+    NEXT();
+}
+dop_mod: {
+    float rhs = stack[sp - 1].as.scalar;
+    float lhs = stack[sp - 2].as.scalar;
+    stack[sp - 2].as.scalar = (rhs != 0.0f) ? fmodf(lhs, rhs) : 0.0f;
+    sp--;
+    NEXT();
+}
+dop_call_builtin: {
+    fw_bc3_value_t result = {0};
+    fw_bc3_status_t status = fw_bc3_eval_builtin(
+        op->builtin, &stack[sp - op->arg_count], op->arg_count, &result
+    );
+    if (status != FW_BC3_OK) {
+        return status;
+    }
+    sp = sp - op->arg_count;
+    stack[sp] = result;
+    sp++;
+    NEXT();
+}
+dop_sin:
+    stack[sp - 1].as.scalar = fw_bc3_fast_sin(stack[sp - 1].as.scalar);
+    NEXT();
+dop_cos:
+    stack[sp - 1].as.scalar = fw_bc3_fast_cos(stack[sp - 1].as.scalar);
+    NEXT();
+dop_sqrt:
+    stack[sp - 1].as.scalar = dsl_fast_sqrtf(stack[sp - 1].as.scalar);
+    NEXT();
+dop_abs:
+    stack[sp - 1].as.scalar = fabsf(stack[sp - 1].as.scalar);
+    NEXT();
+dop_floor:
+    stack[sp - 1].as.scalar = dsl_fast_floorf(stack[sp - 1].as.scalar);
+    NEXT();
+dop_fract: {
+    float x = stack[sp - 1].as.scalar;
+    stack[sp - 1].as.scalar = x - dsl_fast_floorf(x);
+    NEXT();
+}
+dop_ln:
+    stack[sp - 1].as.scalar = dsl_fast_logf(stack[sp - 1].as.scalar);
+    NEXT();
+dop_log:
+    stack[sp - 1].as.scalar = dsl_fast_log10f(stack[sp - 1].as.scalar);
+    NEXT();
+dop_min:
+    stack[sp - 2].as.scalar = fminf(stack[sp - 2].as.scalar, stack[sp - 1].as.scalar);
+    sp--;
+    NEXT();
+dop_max:
+    stack[sp - 2].as.scalar = fmaxf(stack[sp - 2].as.scalar, stack[sp - 1].as.scalar);
+    sp--;
+    NEXT();
+dop_clamp: {
+    float x = stack[sp - 3].as.scalar;
+    float lo = stack[sp - 2].as.scalar;
+    float hi = stack[sp - 1].as.scalar;
+    stack[sp - 3].as.scalar = fw_bc3_clamp(x, lo, hi);
+    sp -= 2;
+    NEXT();
+}
+dop_smoothstep: {
+    float edge0 = stack[sp - 3].as.scalar;
+    float edge1 = stack[sp - 2].as.scalar;
+    float x = stack[sp - 1].as.scalar;
+    stack[sp - 3].as.scalar = fw_bc3_smoothstep(edge0, edge1, x);
+    sp -= 2;
+    NEXT();
+}
+dop_pow: {
+    float base = stack[sp - 2].as.scalar;
+    float exp = stack[sp - 1].as.scalar;
+    stack[sp - 2].as.scalar = fw_bc3_pow(base, exp);
+    sp--;
+    NEXT();
+}
+dop_noise: {
+    float nx = stack[sp - 2].as.scalar;
+    float ny = stack[sp - 1].as.scalar;
+    stack[sp - 2].as.scalar = fw_bc3_noise2(nx, ny);
+    sp--;
+    NEXT();
+}
+dop_noise3: {
+    float nx = stack[sp - 3].as.scalar;
+    float ny = stack[sp - 2].as.scalar;
+    float nz = stack[sp - 1].as.scalar;
+    stack[sp - 3].as.scalar = fw_bc3_noise3(nx, ny, nz);
+    sp -= 2;
+    NEXT();
+}
+dop_phasor:
+    /* Phasor requires persistent state; returns 0 in bytecode VM. */
+    stack[sp - 1].as.scalar = 0.0f;
+    NEXT();
+dop_vec2: {
+    float x_val = stack[sp - 2].as.scalar;
+    float y_val = stack[sp - 1].as.scalar;
+    stack[sp - 2].tag = FW_BC3_VALUE_VEC2;
+    stack[sp - 2].as.vec2.x = x_val;
+    stack[sp - 2].as.vec2.y = y_val;
+    sp--;
+    NEXT();
+}
+dop_rgba: {
+    float r = stack[sp - 4].as.scalar;
+    float g = stack[sp - 3].as.scalar;
+    float b = stack[sp - 2].as.scalar;
+    float a = stack[sp - 1].as.scalar;
+    stack[sp - 4].tag = FW_BC3_VALUE_RGBA;
+    stack[sp - 4].as.rgba.r = r;
+    stack[sp - 4].as.rgba.g = g;
+    stack[sp - 4].as.rgba.b = b;
+    stack[sp - 4].as.rgba.a = a;
+    sp -= 3;
+    NEXT();
+}
+dop_mul_lit:
+    stack[sp - 1].as.scalar = stack[sp - 1].as.scalar * op->scalar;
+    NEXT();
+dop_add_lit:
+    stack[sp - 1].as.scalar = stack[sp - 1].as.scalar + op->scalar;
+    NEXT();
+dop_sub_lit:
+    stack[sp - 1].as.scalar = stack[sp - 1].as.scalar - op->scalar;
+    NEXT();
+dop_rsub_lit:
+    stack[sp - 1].as.scalar = op->scalar - stack[sp - 1].as.scalar;
+    NEXT();
+dop_fma_lit: {
+    const fw_bc3_affine_t *affine = &affines[op->index];
+    stack[sp - 1].as.scalar = stack[sp - 1].as.scalar * affine->scale + affine->offset;
+    NEXT();
+}
+dop_sin_affine: {
+    const fw_bc3_affine_t *affine = &affines[op->index];
+    stack[sp - 1].as.scalar = fw_bc3_fast_sin(stack[sp - 1].as.scalar * affine->scale + affine->offset);
+    NEXT();
+}
+dop_cos_affine: {
+    const fw_bc3_affine_t *affine = &affines[op->index];
+    stack[sp - 1].as.scalar = fw_bc3_fast_cos(stack[sp - 1].as.scalar * affine->scale + affine->offset);
+    NEXT();
+}
+dop_halt:
+    *out = stack[0];
+    return FW_BC3_OK;
+
+#undef NEXT
+}
+
+static fw_bc3_status_t IRAM_ATTR fw_bc3_execute_statement_block(
+    fw_bc3_runtime_t *runtime,
+    uint16_t start,
+    uint16_t count,
+    bool frame_mode,
+    uint16_t let_limit,
+    const fw_bc3_inputs_t *inputs,
+    fw_bc3_color_t *out_color,
+    uint8_t depth,
+    uint32_t *remaining_budget
+) {
+    if (depth > FW_BC3_MAX_STATEMENT_DEPTH) {
+        return FW_BC3_ERR_LIMIT;
+    }
+    if ((uint32_t)start + (uint32_t)count > runtime->program->stmt_count) {
+        return FW_BC3_ERR_FORMAT;
+    }
+
+    uint16_t i = 0;
+    while (i < count) {
+        fw_bc3_status_t status = FW_BC3_OK;
+        const fw_bc3_stmt_view_t *stmt = &runtime->program->statements[start + i];
+        if (*remaining_budget == 0U) {
+            return FW_BC3_ERR_EXEC_BUDGET;
+        }
+        *remaining_budget -= 1U;
+
+        switch (stmt->kind) {
+            case FW_BC3_STMT_LET: {
+                fw_bc3_value_t value = {0};
+                if (stmt->as.let_decl.slot >= let_limit) {
+                    return FW_BC3_ERR_INVALID_SLOT;
+                }
+                if (stmt->hoisted != 0U) {
+                    // Evaluated by begin_frame/begin_row; replay the cached values in execution order.
+                    if (runtime->hoist_cursor >= runtime->program->hoisted_value_count) {
+                        return FW_BC3_ERR_FORMAT;
+                    }
+                    value = runtime->hoisted_values[runtime->hoist_cursor];
+                    runtime->hoist_cursor += 1U;
+                } else {
+                    status = fw_bc3_eval_expression(
+                        runtime,
+                        stmt->as.let_decl.expr_index,
+                        inputs,
+                        let_limit,
+                        &value
+                    );
+                    if (status != FW_BC3_OK) {
+                        return status;
+                    }
+                }
+                runtime->let_values[stmt->as.let_decl.slot] = value;
+                if (frame_mode) {
+                    runtime->frame_values[stmt->as.let_decl.slot] = value;
+                }
+                break;
+            }
+            case FW_BC3_STMT_BLEND: {
+                fw_bc3_value_t value = {0};
+                if (frame_mode) {
+                    return FW_BC3_ERR_FORMAT;
+                }
+                const uint8_t mode = stmt->blend_mode;
+                if (mode == (uint8_t)FW_BC3_BLEND_ALPHA_FIRST) {
+                    const uint16_t alpha_expr = stmt->as.blend.alpha_expr;
+                    status = fw_bc3_eval_expression(runtime, alpha_expr, inputs, let_limit, &value);
+                    if (status != FW_BC3_OK) {
+                        return status;
+                    }
+                    if (value.tag != FW_BC3_VALUE_SCALAR) {
+                        return FW_BC3_ERR_TYPE_MISMATCH;
+                    }
+                    // A NaN alpha still blends, exactly like the unsplit expression.
+                    if (value.as.scalar <= 0.0f) {
+                        break;
+                    }
+                    const float alpha = value.as.scalar;
+                    status = fw_bc3_eval_expression(runtime, (uint16_t)(alpha_expr + 1U), inputs, let_limit, &value);
+                    if (status != FW_BC3_OK) {
+                        return status;
+                    }
+                    if (value.tag != FW_BC3_VALUE_RGBA) {
+                        return FW_BC3_ERR_TYPE_MISMATCH;
+                    }
+                    value.as.rgba.a = alpha;
+                    *out_color = fw_bc3_blend_over_opaque(value.as.rgba, *out_color);
+                    break;
+                }
+                status = fw_bc3_eval_expression(runtime, stmt->as.blend.expr_index, inputs, let_limit, &value);
+                if (status != FW_BC3_OK) {
+                    return status;
+                }
+                if (value.tag != FW_BC3_VALUE_RGBA) {
+                    return FW_BC3_ERR_TYPE_MISMATCH;
+                }
+                if (mode == (uint8_t)FW_BC3_BLEND_REPLACE) {
+                    *out_color = fw_bc3_color_opaque(value.as.rgba);
+                } else {
+                    *out_color = fw_bc3_blend_over_opaque(value.as.rgba, *out_color);
+                }
+                break;
+            }
+            case FW_BC3_STMT_IF: {
+                fw_bc3_value_t condition = {0};
+                status = fw_bc3_eval_expression(runtime, stmt->as.if_stmt.cond_expr_index, inputs, let_limit, &condition);
+                if (status != FW_BC3_OK) {
+                    return status;
+                }
+                if (condition.tag != FW_BC3_VALUE_SCALAR) {
+                    return FW_BC3_ERR_TYPE_MISMATCH;
+                }
+                if (condition.as.scalar > 0.0f) {
+                    status = fw_bc3_execute_statement_block(
+                        runtime,
+                        stmt->as.if_stmt.then_start,
+                        stmt->as.if_stmt.then_count,
+                        frame_mode,
+                        let_limit,
+                        inputs,
+                        out_color,
+                        (uint8_t)(depth + 1U),
+                        remaining_budget
+                    );
+                } else {
+                    status = fw_bc3_execute_statement_block(
+                        runtime,
+                        stmt->as.if_stmt.else_start,
+                        stmt->as.if_stmt.else_count,
+                        frame_mode,
+                        let_limit,
+                        inputs,
+                        out_color,
+                        (uint8_t)(depth + 1U),
+                        remaining_budget
+                    );
+                }
+                if (status != FW_BC3_OK) {
+                    return status;
+                }
+                break;
+            }
+            case FW_BC3_STMT_FOR: {
+                const uint32_t start_value = stmt->as.for_stmt.start_inclusive;
+                const uint32_t end_value = stmt->as.for_stmt.end_exclusive;
+                uint32_t iter = 0;
+                if (stmt->as.for_stmt.index_slot >= let_limit) {
+                    return FW_BC3_ERR_INVALID_SLOT;
+                }
+                if (end_value < start_value) {
+                    return FW_BC3_ERR_FORMAT;
+                }
+                if ((end_value - start_value) > FW_BC3_MAX_LOOP_ITERATIONS) {
+                    return FW_BC3_ERR_LOOP_LIMIT;
+                }
+                iter = start_value;
+                while (iter < end_value) {
+                    const fw_bc3_value_t index_value = {
+                        .tag = FW_BC3_VALUE_SCALAR,
+                        .as.scalar = (float)iter,
+                    };
+                    runtime->let_values[stmt->as.for_stmt.index_slot] = index_value;
+                    if (frame_mode) {
+                        runtime->frame_values[stmt->as.for_stmt.index_slot] = index_value;
+                    }
+                    status = fw_bc3_execute_statement_block(
+                        runtime,
+                        stmt->as.for_stmt.body_start,
+                        stmt->as.for_stmt.body_count,
+                        frame_mode,
+                        let_limit,
+                        inputs,
+                        out_color,
+                        (uint8_t)(depth + 1U),
+                        remaining_budget
+                    );
+                    if (status != FW_BC3_OK) {
+                        return status;
+                    }
+                    iter += 1U;
+                }
+                break;
+            }
+            default:
+                return FW_BC3_ERR_FORMAT;
+        }
+
+        i += 1U;
+    }
+
+    return FW_BC3_OK;
+}
+
+static fw_bc3_status_t IRAM_ATTR fw_bc3_evaluate_params(
+    fw_bc3_runtime_t *runtime,
+    const fw_bc3_inputs_t *inputs,
+    fw_bc3_param_eval_mode_t mode
+) {
+    uint16_t i = 0;
+    while (i < runtime->program->param_count) {
+        if (runtime->param_pinned[i] != 0U) {
+            i += 1U;
+            continue;
+        }
+        const bool depends_x = runtime->program->param_depends_x[i] != 0U;
+        const bool depends_y = runtime->program->param_depends_y[i] != 0U;
+        const bool is_dynamic = depends_x || depends_y;
+        fw_bc3_value_t value = {0};
+        fw_bc3_status_t status = FW_BC3_OK;
+
+        switch (mode) {
+            case FW_BC3_PARAM_EVAL_ALL:
+                break;
+            case FW_BC3_PARAM_EVAL_STATIC_ONLY:
+                if (is_dynamic) {
+                    i += 1U;
+                    continue;
+                }
+                break;
+            case FW_BC3_PARAM_EVAL_DYNAMIC_ONLY:
+                if (!is_dynamic) {
+                    i += 1U;
+                    continue;
+                }
+                break;
+            case FW_BC3_PARAM_EVAL_DYNAMIC_X_ONLY:
+                if (!depends_x) {
+                    i += 1U;
+                    continue;
+                }
+                break;
+            case FW_BC3_PARAM_EVAL_DYNAMIC_Y_ONLY:
+                if (!depends_y || depends_x) {
+                    i += 1U;
+                    continue;
+                }
+                break;
+            default:
+                return FW_BC3_ERR_INVALID_ARG;
+        }
+
+        status = fw_bc3_eval_expression(runtime, runtime->program->param_expr[i], inputs, 0, &value);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+        if (value.tag != FW_BC3_VALUE_SCALAR) {
+            return FW_BC3_ERR_TYPE_MISMATCH;
+        }
+        runtime->param_values[i] = value.as.scalar;
+        i += 1U;
+    }
+
+    return FW_BC3_OK;
+}
+
+// --- Let hoisting ---
+//
+// Frame- and row-rate lets outside if branches get one cache entry per execution, in execution order.
+// begin_frame fills the frame-rate entries and begin_row the row-rate ones; the pixel and row paths then
+// replay the cache with a cursor instead of evaluating those lets, which works because the statements
+// that hold hoisted lets (top level and loop bodies) run in the same order at every pixel.
+
+// Walks the hoistable part of a block. Hoisted lets of `rate` are evaluated into the cache, slower ones
+// are reloaded from it, and unhoisted lets no faster than `rate` are re-evaluated, so that every let a
+// hoisted let reads holds its value. Faster lets are skipped, though hoisted ones keep their cache entry.
+static fw_bc3_status_t fw_bc3_hoist_statement_block(
+    fw_bc3_runtime_t *runtime,
+    uint16_t start,
+    uint16_t count,
+    uint8_t rate,
+    uint16_t let_limit,
+    const fw_bc3_inputs_t *inputs,
+    uint8_t depth
+) {
+    const fw_bc3_program_t *program = runtime->program;
+    if (depth > FW_BC3_MAX_STATEMENT_DEPTH) {
+        return FW_BC3_ERR_LIMIT;
+    }
+    if ((uint32_t)start + (uint32_t)count > program->stmt_count) {
+        return FW_BC3_ERR_FORMAT;
+    }
+
+    for (uint16_t i = 0; i < count; i++) {
+        const uint16_t stmt_index = (uint16_t)(start + i);
+        const fw_bc3_stmt_view_t *stmt = &program->statements[stmt_index];
+        const bool hoisted = stmt->hoisted != 0U;
+        fw_bc3_status_t status = FW_BC3_OK;
+
+        if (stmt->kind == FW_BC3_STMT_LET) {
+            const uint8_t stmt_rate = stmt->rate;
+            fw_bc3_value_t value = {0};
+            if (stmt->as.let_decl.slot >= let_limit) {
+                return FW_BC3_ERR_INVALID_SLOT;
+            }
+            if (hoisted && runtime->hoist_cursor >= program->hoisted_value_count) {
+                return FW_BC3_ERR_FORMAT;
+            }
+            if (stmt_rate > rate) {
+                runtime->hoist_cursor = (uint16_t)(runtime->hoist_cursor + (hoisted ? 1U : 0U));
+                continue;
+            }
+            if (hoisted && stmt_rate < rate) {
+                value = runtime->hoisted_values[runtime->hoist_cursor];
+            } else {
+                status = fw_bc3_eval_expression(runtime, stmt->as.let_decl.expr_index, inputs, let_limit, &value);
+                if (status != FW_BC3_OK) {
+                    return status;
+                }
+                if (hoisted) {
+                    runtime->hoisted_values[runtime->hoist_cursor] = value;
+                }
+            }
+            runtime->hoist_cursor = (uint16_t)(runtime->hoist_cursor + (hoisted ? 1U : 0U));
+            runtime->let_values[stmt->as.let_decl.slot] = value;
+        } else if (stmt->kind == FW_BC3_STMT_FOR && hoisted) {
+            if (stmt->as.for_stmt.index_slot >= let_limit) {
+                return FW_BC3_ERR_INVALID_SLOT;
+            }
+            for (uint32_t iter = stmt->as.for_stmt.start_inclusive; iter < stmt->as.for_stmt.end_exclusive; iter++) {
+                runtime->let_values[stmt->as.for_stmt.index_slot] = fw_bc3_make_scalar((float)iter);
+                status = fw_bc3_hoist_statement_block(
+                    runtime,
+                    stmt->as.for_stmt.body_start,
+                    stmt->as.for_stmt.body_count,
+                    rate,
+                    let_limit,
+                    inputs,
+                    (uint8_t)(depth + 1U)
+                );
+                if (status != FW_BC3_OK) {
+                    return status;
+                }
+            }
+        }
+    }
+
+    return FW_BC3_OK;
+}
+
+static fw_bc3_status_t fw_bc3_hoist_layers(fw_bc3_runtime_t *runtime, fw_bc3_rate_t rate, const fw_bc3_inputs_t *inputs) {
+    const fw_bc3_program_t *program = runtime->program;
+    runtime->hoist_cursor = 0U;
+    for (uint16_t layer = 0; layer < program->layer_count; layer++) {
+        fw_bc3_status_t status = fw_bc3_hoist_statement_block(
+            runtime,
+            program->layer_stmt_start[layer],
+            program->layer_stmt_count[layer],
+            (uint8_t)rate,
+            program->layer_let_count[layer],
+            inputs,
+            0
+        );
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+    }
+    return FW_BC3_OK;
+}
+
+// --- Row evaluation over the register form ---
+//
+// Every register op processes all lanes of a row chunk before dispatching the next op, so dispatch is
+// paid once per chunk instead of once per pixel, and operands are read straight from their registers
+// instead of being pushed and popped. Each lane runs exactly the same scalar arithmetic as
+// fw_bc3_eval_expression, which keeps results bit-identical. Divergent if statements run both branches
+// under a lane mask; only blends and budgets honor the mask, because lets declared inside a branch are
+// out of scope once the branch ends.
+
+static uint32_t fw_bc3_row_full_mask(uint16_t lane_count) {
+    return (lane_count >= 32U) ? 0xFFFFFFFFU : ((1U << lane_count) - 1U);
+}
+
+static void fw_bc3_register_fill(fw_bc3_runtime_t *runtime, uint16_t reg, float value) {
+    for (uint16_t lane = 0; lane < FW_BC3_ROW_LANES; lane++) {
+        runtime->registers[reg][lane] = value;
+    }
+}
+
+// Copies the top-level frame lets into their registers; false when a value's type differs from the one
+// the register form was built for.
+static bool fw_bc3_register_fill_frame_lets(fw_bc3_runtime_t *runtime) {
+    const fw_bc3_program_t *program = runtime->program;
+    for (uint16_t slot = 0; slot < program->frame_let_count; slot++) {
+        const uint8_t tag = program->register_frame_let_tag[slot];
+        if (tag == 0U) {
+            continue;
+        }
+        const fw_bc3_value_t *value = &runtime->frame_values[slot];
+        if ((uint8_t)value->tag != tag) {
+            return false;
+        }
+        const uint16_t reg = program->register_frame_let[slot];
+        if (value->tag == FW_BC3_VALUE_VEC2) {
+            fw_bc3_register_fill(runtime, reg, value->as.vec2.x);
+            fw_bc3_register_fill(runtime, (uint16_t)(reg + 1U), value->as.vec2.y);
+        } else if (value->tag == FW_BC3_VALUE_RGBA) {
+            fw_bc3_register_fill(runtime, reg, value->as.rgba.r);
+            fw_bc3_register_fill(runtime, (uint16_t)(reg + 1U), value->as.rgba.g);
+            fw_bc3_register_fill(runtime, (uint16_t)(reg + 2U), value->as.rgba.b);
+            fw_bc3_register_fill(runtime, (uint16_t)(reg + 3U), value->as.rgba.a);
+        } else {
+            fw_bc3_register_fill(runtime, reg, value->as.scalar);
+        }
+    }
+    return true;
+}
+
+// Broadcasts a hoisted let's value into the registers named by the let's HALT op.
+static void fw_bc3_register_fill_let(fw_bc3_runtime_t *runtime, const fw_bc3_register_op_t *halt, const fw_bc3_value_t *value) {
+    if (value->tag == FW_BC3_VALUE_VEC2) {
+        fw_bc3_register_fill(runtime, halt->src[0], value->as.vec2.x);
+        fw_bc3_register_fill(runtime, halt->src[1], value->as.vec2.y);
+    } else if (value->tag == FW_BC3_VALUE_RGBA) {
+        fw_bc3_register_fill(runtime, halt->src[0], value->as.rgba.r);
+        fw_bc3_register_fill(runtime, halt->src[1], value->as.rgba.g);
+        fw_bc3_register_fill(runtime, halt->src[2], value->as.rgba.b);
+        fw_bc3_register_fill(runtime, halt->src[3], value->as.rgba.a);
+    } else {
+        fw_bc3_register_fill(runtime, halt->src[0], value->as.scalar);
+    }
+}
+
+// Runs register ops from `op_start` up to the HALT sentinel, which is returned for its result registers.
+static const fw_bc3_register_op_t *__attribute__((flatten)) IRAM_ATTR fw_bc3_run_register_ops(
+    fw_bc3_runtime_t *runtime,
+    uint16_t op_start,
+    uint16_t lane_count
+) {
+    const fw_bc3_register_op_t *op = &runtime->program->register_ops[op_start];
+    float (*regs)[FW_BC3_ROW_LANES] = runtime->registers;
+    const uint16_t n = lane_count;
+
+    static const void *dispatch_table[] = {
+        [FW_BC3_ROP_MOV]           = &&rop_mov,
+        [FW_BC3_ROP_NEGATE]        = &&rop_negate,
+        [FW_BC3_ROP_ADD]           = &&rop_add,
+        [FW_BC3_ROP_SUB]           = &&rop_sub,
+        [FW_BC3_ROP_MUL]           = &&rop_mul,
+        [FW_BC3_ROP_DIV]           = &&rop_div,
+        [FW_BC3_ROP_MOD]           = &&rop_mod,
+        [FW_BC3_ROP_SIN]           = &&rop_sin,
+        [FW_BC3_ROP_COS]           = &&rop_cos,
+        [FW_BC3_ROP_SQRT]          = &&rop_sqrt,
+        [FW_BC3_ROP_ABS]           = &&rop_abs,
+        [FW_BC3_ROP_FLOOR]         = &&rop_floor,
+        [FW_BC3_ROP_FRACT]         = &&rop_fract,
+        [FW_BC3_ROP_LN]            = &&rop_ln,
+        [FW_BC3_ROP_LOG]           = &&rop_log,
+        [FW_BC3_ROP_MIN]           = &&rop_min,
+        [FW_BC3_ROP_MAX]           = &&rop_max,
+        [FW_BC3_ROP_CLAMP]         = &&rop_clamp,
+        [FW_BC3_ROP_SMOOTHSTEP]    = &&rop_smoothstep,
+        [FW_BC3_ROP_POW]           = &&rop_pow,
+        [FW_BC3_ROP_NOISE]         = &&rop_noise,
+        [FW_BC3_ROP_NOISE3]        = &&rop_noise3,
+        [FW_BC3_ROP_ZERO]          = &&rop_zero,
+        [FW_BC3_ROP_CIRCLE]        = &&rop_circle,
+        [FW_BC3_ROP_BOX]           = &&rop_box,
+        [FW_BC3_ROP_WRAPDX]        = &&rop_wrapdx,
+        [FW_BC3_ROP_HASH01]        = &&rop_hash01,
+        [FW_BC3_ROP_HASH_SIGNED]   = &&rop_hash_signed,
+        [FW_BC3_ROP_HASH_COORDS01] = &&rop_hash_coords01,
+        [FW_BC3_ROP_FMA]           = &&rop_fma,
+        [FW_BC3_ROP_SIN_AFFINE]    = &&rop_sin_affine,
+        [FW_BC3_ROP_COS_AFFINE]    = &&rop_cos_affine,
+        [FW_BC3_ROP_HALT]          = &&rop_halt,
+    };
+
+#define NEXT() do { ++op; goto *dispatch_table[op->op]; } while(0)
+#define UNARY(expr) do { \
+        float *d = regs[op->dst]; \
+        const float *a = regs[op->src[0]]; \
+        for (uint16_t i = 0; i < n; i++) { const float v = a[i]; d[i] = (expr); } \
+    } while(0)
+#define BINARY(expr) do { \
+        float *d = regs[op->dst]; \
+        const float *a = regs[op->src[0]]; \
+        const float *b = regs[op->src[1]]; \
+        for (uint16_t i = 0; i < n; i++) { const float lhs = a[i]; const float rhs = b[i]; d[i] = (expr); } \
+    } while(0)
+#define TERNARY(expr) do { \
+        float *d = regs[op->dst]; \
+        const float *a = regs[op->src[0]]; \
+        const float *b = regs[op->src[1]]; \
+        const float *c = regs[op->src[2]]; \
+        for (uint16_t i = 0; i < n; i++) { const float a0 = a[i]; const float a1 = b[i]; const float a2 = c[i]; d[i] = (expr); } \
+    } while(0)
+
+    goto *dispatch_table[op->op];
+
+rop_mov:
+    UNARY(v);
+    NEXT();
+rop_negate:
+    UNARY(-v);
+    NEXT();
+rop_add:
+    BINARY(lhs + rhs);
+    NEXT();
+rop_sub:
+    BINARY(lhs - rhs);
+    NEXT();
+rop_mul:
+    BINARY(lhs * rhs);
+    NEXT();
+rop_div:
+    BINARY(fw_bc3_safe_div(lhs, rhs));
+    NEXT();
+rop_mod:
+    BINARY((rhs != 0.0f) ? fmodf(lhs, rhs) : 0.0f);
+    NEXT();
+rop_sin:
+    UNARY(fw_bc3_fast_sin(v));
+    NEXT();
+rop_cos:
+    UNARY(fw_bc3_fast_cos(v));
+    NEXT();
+rop_sqrt:
+    UNARY(dsl_fast_sqrtf(v));
+    NEXT();
+rop_abs:
+    UNARY(fabsf(v));
+    NEXT();
+rop_floor:
+    UNARY(dsl_fast_floorf(v));
+    NEXT();
+rop_fract:
+    UNARY(v - dsl_fast_floorf(v));
+    NEXT();
+rop_ln:
+    UNARY(dsl_fast_logf(v));
+    NEXT();
+rop_log:
+    UNARY(dsl_fast_log10f(v));
+    NEXT();
+rop_min:
+    BINARY(fminf(lhs, rhs));
+    NEXT();
+rop_max:
+    BINARY(fmaxf(lhs, rhs));
+    NEXT();
+rop_clamp:
+    TERNARY(fw_bc3_clamp(a0, a1, a2));
+    NEXT();
+rop_smoothstep:
+    TERNARY(fw_bc3_smoothstep(a0, a1, a2));
+    NEXT();
+rop_pow:
+    BINARY(fw_bc3_pow(lhs, rhs));
+    NEXT();
+rop_noise:
+    BINARY(fw_bc3_noise2(lhs, rhs));
+    NEXT();
+rop_noise3:
+    TERNARY(fw_bc3_noise3(a0, a1, a2));
+    NEXT();
+rop_zero: {
+    /* Phasor requires persistent state; returns 0 in bytecode VM. */
+    float *d = regs[op->dst];
+    for (uint16_t i = 0; i < n; i++) {
+        d[i] = 0.0f;
+    }
+    NEXT();
+}
+rop_circle:
+    TERNARY(fw_bc3_vec2_length((fw_bc3_vec2_t){ .x = a0, .y = a1 }) - a2);
+    NEXT();
+rop_box: {
+    float *d = regs[op->dst];
+    const float *px = regs[op->src[0]];
+    const float *py = regs[op->src[1]];
+    const float *bx = regs[op->src[2]];
+    const float *by = regs[op->src[3]];
+    for (uint16_t i = 0; i < n; i++) {
+        const fw_bc3_vec2_t p = { .x = px[i], .y = py[i] };
+        const fw_bc3_vec2_t b = { .x = bx[i], .y = by[i] };
+        d[i] = fw_bc3_box_distance(p, b);
+    }
+    NEXT();
+}
+rop_wrapdx:
+    TERNARY(fw_bc3_wrapped_delta_x(a0, a1, a2));
+    NEXT();
+rop_hash01:
+    UNARY(fw_bc3_hash01(fw_bc3_scalar_to_u32(v)));
+    NEXT();
+rop_hash_signed:
+    UNARY(fw_bc3_hash_signed(fw_bc3_scalar_to_u32(v)));
+    NEXT();
+rop_hash_coords01:
+    TERNARY(fw_bc3_hash_coords01(fw_bc3_scalar_to_i32(a0), fw_bc3_scalar_to_i32(a1), fw_bc3_scalar_to_u32(a2)));
+    NEXT();
+rop_fma:
+    TERNARY(a0 * a1 + a2);
+    NEXT();
+rop_sin_affine:
+    TERNARY(fw_bc3_fast_sin(a0 * a1 + a2));
+    NEXT();
+rop_cos_affine:
+    TERNARY(fw_bc3_fast_cos(a0 * a1 + a2));
+    NEXT();
+rop_halt:
+    return op;
+
+#undef TERNARY
+#undef BINARY
+#undef UNARY
+#undef NEXT
+}
+
+static fw_bc3_status_t IRAM_ATTR fw_bc3_execute_statement_block_row(
+    fw_bc3_runtime_t *runtime,
+    uint16_t start,
+    uint16_t count,
+    uint16_t lane_count,
+    uint32_t lane_mask,
+    fw_bc3_color_t *out_colors,
+    uint8_t depth
+) {
+    const fw_bc3_program_t *program = runtime->program;
+    if (depth > FW_BC3_MAX_STATEMENT_DEPTH) {
+        return FW_BC3_ERR_LIMIT;
+    }
+    if ((uint32_t)start + (uint32_t)count > program->stmt_count) {
+        return FW_BC3_ERR_FORMAT;
+    }
+
+    uint16_t i = 0;
+    while (i < count) {
+        fw_bc3_status_t status = FW_BC3_OK;
+        const uint16_t stmt_index = (uint16_t)(start + i);
+        const fw_bc3_stmt_view_t *stmt = &program->statements[stmt_index];
+        const fw_bc3_register_op_t *result = NULL;
+        for (uint16_t lane = 0; lane < lane_count; lane++) {
+            if ((lane_mask & (1U << lane)) == 0U) {
+                continue;
+            }
+            if (runtime->row_budget[lane] == 0U) {
+                return FW_BC3_ERR_EXEC_BUDGET;
+            }
+            runtime->row_budget[lane] -= 1U;
+        }
+
+        switch (stmt->kind) {
+            case FW_BC3_STMT_LET:
+                if (stmt->hoisted != 0U) {
+                    if (runtime->hoist_cursor >= program->hoisted_value_count) {
+                        return FW_BC3_ERR_FORMAT;
+                    }
+                    fw_bc3_register_fill_let(
+                        runtime,
+                        &program->register_ops[stmt->as.let_decl.register_halt],
+                        &runtime->hoisted_values[runtime->hoist_cursor]
+                    );
+                    runtime->hoist_cursor += 1U;
+                    break;
+                }
+                (void)fw_bc3_run_register_ops(runtime, program->expressions[stmt->as.let_decl.expr_index].register_op_start, lane_count);
+                break;
+            case FW_BC3_STMT_BLEND: {
+                const uint8_t mode = stmt->blend_mode;
+                uint16_t color_expr = stmt->as.blend.expr_index;
+                uint32_t blend_mask = lane_mask;
+                float alpha[FW_BC3_ROW_LANES];
+                if (mode == (uint8_t)FW_BC3_BLEND_ALPHA_FIRST) {
+                    color_expr = stmt->as.blend.alpha_expr;
+                    result = fw_bc3_run_register_ops(runtime, program->expressions[color_expr].register_op_start, lane_count);
+                    const float *alpha_reg = runtime->registers[result->src[0]];
+                    blend_mask = 0U;
+                    for (uint16_t lane = 0; lane < lane_count; lane++) {
+                        // The color ops may reuse alpha's temp register, so keep a copy.
+                        alpha[lane] = alpha_reg[lane];
+                        if (!(alpha[lane] <= 0.0f)) {
+                            blend_mask |= (1U << lane);
+                        }
+                    }
+                    blend_mask &= lane_mask;
+                    if (blend_mask == 0U) {
+                        break;
+                    }
+                    color_expr = (uint16_t)(color_expr + 1U);
+                }
+                result = fw_bc3_run_register_ops(runtime, program->expressions[color_expr].register_op_start, lane_count);
+                const float *r = runtime->registers[result->src[0]];
+                const float *g = runtime->registers[result->src[1]];
+                const float *b = runtime->registers[result->src[2]];
+                const float *a = mode == (uint8_t)FW_BC3_BLEND_ALPHA_FIRST ? alpha : runtime->registers[result->src[3]];
+                const bool replaces = mode == (uint8_t)FW_BC3_BLEND_REPLACE;
+                for (uint16_t lane = 0; lane < lane_count; lane++) {
+                    if ((blend_mask & (1U << lane)) == 0U) {
+                        continue;
+                    }
+                    const fw_bc3_color_t src = {
+                        .r = r[lane],
+                        .g = g[lane],
+                        .b = b[lane],
+                        .a = a[lane],
+                    };
+                    out_colors[lane] = replaces ? fw_bc3_color_opaque(src) : fw_bc3_blend_over_opaque(src, out_colors[lane]);
+                }
+                break;
+            }
+            case FW_BC3_STMT_IF: {
+                uint32_t then_mask = 0U;
+                result = fw_bc3_run_register_ops(runtime, program->expressions[stmt->as.if_stmt.cond_expr_index].register_op_start, lane_count);
+                const float *condition = runtime->registers[result->src[0]];
+                for (uint16_t lane = 0; lane < lane_count; lane++) {
+                    if (condition[lane] > 0.0f) {
+                        then_mask |= (1U << lane);
+                    }
+                }
+                then_mask &= lane_mask;
+                const uint32_t else_mask = lane_mask & ~then_mask;
+                if (then_mask != 0U) {
+                    status = fw_bc3_execute_statement_block_row(
+                        runtime,
+                        stmt->as.if_stmt.then_start,
+                        stmt->as.if_stmt.then_count,
+                        lane_count,
+                        then_mask,
+                        out_colors,
+                        (uint8_t)(depth + 1U)
+                    );
+                    if (status != FW_BC3_OK) {
+                        return status;
+                    }
+                }
+                if (else_mask != 0U) {
+                    status = fw_bc3_execute_statement_block_row(
+                        runtime,
+                        stmt->as.if_stmt.else_start,
+                        stmt->as.if_stmt.else_count,
+                        lane_count,
+                        else_mask,
+                        out_colors,
+                        (uint8_t)(depth + 1U)
+                    );
+                    if (status != FW_BC3_OK) {
+                        return status;
+                    }
+                }
+                break;
+            }
+            case FW_BC3_STMT_FOR: {
+                float *index_plane = runtime->registers[stmt->as.for_stmt.index_register];
+                for (uint32_t iter = stmt->as.for_stmt.start_inclusive; iter < stmt->as.for_stmt.end_exclusive; iter++) {
+                    for (uint16_t lane = 0; lane < lane_count; lane++) {
+                        index_plane[lane] = (float)iter;
+                    }
+                    status = fw_bc3_execute_statement_block_row(
+                        runtime,
+                        stmt->as.for_stmt.body_start,
+                        stmt->as.for_stmt.body_count,
+                        lane_count,
+                        lane_mask,
+                        out_colors,
+                        (uint8_t)(depth + 1U)
+                    );
+                    if (status != FW_BC3_OK) {
+                        return status;
+                    }
+                }
+                break;
+            }
+            default:
+                return FW_BC3_ERR_FORMAT;
+        }
+
+        i += 1U;
+    }
+
+    return FW_BC3_OK;
+}
+
+// Runtime arena: the register file, then frame_values, let_values and hoisted_values. Every section is a
+// multiple of 4 bytes, so one 4-byte aligned block serves them all.
+typedef struct {
+    size_t frame_values;
+    size_t let_values;
+    size_t hoisted_values;
+    size_t total;
+} fw_bc3_runtime_layout_t;
+
+static void fw_bc3_runtime_layout(const fw_bc3_program_t *program, fw_bc3_runtime_layout_t *out) {
+    const size_t registers = (program->has_register_form != 0U) ? program->register_count : 0U;
+    out->frame_values = registers * FW_BC3_ROW_LANES * sizeof(float);
+    out->let_values = out->frame_values + (size_t)program->frame_value_count * sizeof(fw_bc3_value_t);
+    out->hoisted_values = out->let_values + (size_t)program->let_value_count * sizeof(fw_bc3_value_t);
+    out->total = out->hoisted_values + (size_t)program->hoisted_value_count * sizeof(fw_bc3_value_t);
+    if (out->total == 0U) {
+        out->total = FW_BC3_ARENA_ALIGN;
+    }
+}
+
+fw_bc3_status_t fw_bc3_runtime_arena_size(const fw_bc3_program_t *program, size_t *out_bytes) {
+    if (program == NULL || out_bytes == NULL) {
+        return FW_BC3_ERR_INVALID_ARG;
+    }
+    fw_bc3_runtime_layout_t layout;
+    fw_bc3_runtime_layout(program, &layout);
+    *out_bytes = layout.total;
+    return FW_BC3_OK;
+}
+
+fw_bc3_status_t fw_bc3_runtime_init(
+    fw_bc3_runtime_t *runtime,
+    const fw_bc3_program_t *program,
+    uint16_t width,
+    uint16_t height,
+    void *arena,
+    size_t arena_len
+) {
+    if (runtime == NULL || program == NULL || width == 0U || height == 0U || arena == NULL ||
+        ((uintptr_t)arena % FW_BC3_ARENA_ALIGN) != 0U) {
+        return FW_BC3_ERR_INVALID_ARG;
+    }
+    fw_bc3_runtime_layout_t layout;
+    fw_bc3_runtime_layout(program, &layout);
+    if (arena_len < layout.total) {
+        return FW_BC3_ERR_LIMIT;
+    }
+
+    memset(runtime, 0, sizeof(*runtime));
+    uint8_t *base = (uint8_t *)arena;
+    memset(base, 0, layout.total);
+    runtime->registers = (float (*)[FW_BC3_ROW_LANES])(void *)base;
+    runtime->frame_values = (fw_bc3_value_t *)(void *)(base + layout.frame_values);
+    runtime->let_values = (fw_bc3_value_t *)(void *)(base + layout.let_values);
+    runtime->hoisted_values = (fw_bc3_value_t *)(void *)(base + layout.hoisted_values);
+    runtime->program = program;
+    runtime->width = (float)width;
+    runtime->height = (float)height;
+    runtime->has_dynamic_params = false;
+    runtime->has_x_dynamic_params = false;
+    runtime->has_y_only_dynamic_params = false;
+    runtime->row_cache_valid = false;
+    runtime->row_cached_y = 0.0f;
+
+    uint16_t i = 0;
+    while (i < program->param_count) {
+        const bool depends_x = program->param_depends_x[i] != 0U;
+        const bool depends_y = program->param_depends_y[i] != 0U;
+        if (depends_x || depends_y) {
+            runtime->has_dynamic_params = true;
+            if (depends_x) {
+                runtime->has_x_dynamic_params = true;
+            }
+            if (depends_y && !depends_x) {
+                runtime->has_y_only_dynamic_params = true;
+            }
+        }
+        i += 1U;
+    }
+
+    // Literal registers never change; inputs, params and frame lets are filled per frame and per row.
+    runtime->row_eval_supported = program->has_register_form != 0U;
+    i = 0;
+    while (runtime->row_eval_supported && i < program->register_const_count) {
+        fw_bc3_register_fill(runtime, (uint16_t)(program->register_const_base + i), program->register_const_values[i]);
+        i += 1U;
+    }
+
+    fw_bc3_reset_value_slots(runtime->frame_values, runtime->program->frame_value_count);
+    fw_bc3_reset_value_slots(runtime->let_values, runtime->program->let_value_count);
+
+    return FW_BC3_OK;
+}
+
+fw_bc3_status_t fw_bc3_runtime_set_param(fw_bc3_runtime_t *runtime, uint16_t index, float value) {
+    if (runtime == NULL || runtime->program == NULL) {
+        return FW_BC3_ERR_INVALID_ARG;
+    }
+    if (index >= runtime->program->param_count || runtime->program->param_depends_xy[index] != 0U) {
+        return FW_BC3_ERR_INVALID_SLOT;
+    }
+    runtime->param_values[index] = value;
+    runtime->param_pinned[index] = 1U;
+    return FW_BC3_OK;
+}
+
+fw_bc3_status_t fw_bc3_runtime_begin_frame(fw_bc3_runtime_t *runtime, float time_seconds, uint32_t frame_counter) {
+    if (runtime == NULL || runtime->program == NULL) {
+        return FW_BC3_ERR_INVALID_ARG;
+    }
+
+    runtime->time_seconds = time_seconds;
+    runtime->frame_counter = (float)frame_counter;
+    runtime->row_cache_valid = false;
+    fw_bc3_reset_value_slots(runtime->frame_values, runtime->program->frame_value_count);
+    fw_bc3_reset_value_slots(runtime->let_values, runtime->program->let_value_count);
+
+    fw_bc3_inputs_t inputs = {
+        .time = time_seconds,
+        .frame = (float)frame_counter,
+        .x = 0.0f,
+        .y = 0.0f,
+        .width = runtime->width,
+        .height = runtime->height,
+        .seed = runtime->seed,
+    };
+
+    fw_bc3_status_t status = fw_bc3_evaluate_params(runtime, &inputs, FW_BC3_PARAM_EVAL_STATIC_ONLY);
+    if (status != FW_BC3_OK) {
+        return status;
+    }
+
+    uint32_t budget = FW_BC3_DEFAULT_STATEMENT_BUDGET;
+    fw_bc3_color_t dummy = {
+        .r = 0.0f,
+        .g = 0.0f,
+        .b = 0.0f,
+        .a = 1.0f,
+    };
+    status = fw_bc3_execute_statement_block(
+        runtime,
+        runtime->program->frame_stmt_start,
+        runtime->program->frame_stmt_count,
+        true,
+        runtime->program->frame_let_count,
+        &inputs,
+        &dummy,
+        0,
+        &budget
+    );
+    if (status != FW_BC3_OK) {
+        return status;
+    }
+
+    const fw_bc3_program_t *program = runtime->program;
+    if (program->hoisted_let_count[FW_BC3_RATE_FRAME] != 0U) {
+        status = fw_bc3_hoist_layers(runtime, FW_BC3_RATE_FRAME, &inputs);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+    }
+
+    if (program->has_register_form != 0U) {
+        fw_bc3_register_fill(runtime, FW_BC3_INPUT_TIME, inputs.time);
+        fw_bc3_register_fill(runtime, FW_BC3_INPUT_FRAME, inputs.frame);
+        fw_bc3_register_fill(runtime, FW_BC3_INPUT_WIDTH, inputs.width);
+        fw_bc3_register_fill(runtime, FW_BC3_INPUT_HEIGHT, inputs.height);
+        fw_bc3_register_fill(runtime, FW_BC3_INPUT_SEED, inputs.seed);
+        for (uint16_t i = 0; i < program->param_count; i++) {
+            if (program->param_depends_x[i] == 0U) {
+                fw_bc3_register_fill(runtime, (uint16_t)(program->register_param_base + i), runtime->param_values[i]);
+            }
+        }
+        runtime->row_eval_supported = fw_bc3_register_fill_frame_lets(runtime);
+    }
+
+    return FW_BC3_OK;
+}
+
+fw_bc3_status_t fw_bc3_runtime_begin_row(fw_bc3_runtime_t *runtime, float y) {
+    if (runtime == NULL || runtime->program == NULL) {
+        return FW_BC3_ERR_INVALID_ARG;
+    }
+
+    fw_bc3_inputs_t inputs = {
+        .time = runtime->time_seconds,
+        .frame = runtime->frame_counter,
+        .x = 0.0f,
+        .y = y,
+        .width = runtime->width,
+        .height = runtime->height,
+        .seed = runtime->seed,
+    };
+
+    if (runtime->has_y_only_dynamic_params) {
+        fw_bc3_status_t status = fw_bc3_evaluate_params(runtime, &inputs, FW_BC3_PARAM_EVAL_DYNAMIC_Y_ONLY);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+    }
+    if (runtime->program->hoisted_let_count[FW_BC3_RATE_ROW] != 0U) {
+        fw_bc3_status_t status = fw_bc3_hoist_layers(runtime, FW_BC3_RATE_ROW, &inputs);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+    }
+
+    runtime->row_cache_valid = true;
+    runtime->row_cached_y = y;
+    return FW_BC3_OK;
+}
+
+fw_bc3_status_t IRAM_ATTR fw_bc3_runtime_eval_pixel(fw_bc3_runtime_t *runtime, float x, float y, fw_bc3_color_t *out_color) {
+    if (runtime == NULL || runtime->program == NULL || out_color == NULL) {
+        return FW_BC3_ERR_INVALID_ARG;
+    }
+
+    fw_bc3_inputs_t inputs = {
+        .time = runtime->time_seconds,
+        .frame = runtime->frame_counter,
+        .x = x,
+        .y = y,
+        .width = runtime->width,
+        .height = runtime->height,
+        .seed = runtime->seed,
+    };
+
+    if (!runtime->row_cache_valid || runtime->row_cached_y != y) {
+        fw_bc3_status_t status = fw_bc3_runtime_begin_row(runtime, y);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+    }
+
+    if (runtime->has_x_dynamic_params) {
+        fw_bc3_status_t status = fw_bc3_evaluate_params(runtime, &inputs, FW_BC3_PARAM_EVAL_DYNAMIC_X_ONLY);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+    }
+
+    fw_bc3_color_t out = {
+        .r = 0.0f,
+        .g = 0.0f,
+        .b = 0.0f,
+        .a = 1.0f,
+    };
+    uint32_t budget = FW_BC3_DEFAULT_STATEMENT_BUDGET;
+
+    runtime->hoist_cursor = 0U;
+    uint16_t layer = 0;
+    while (layer < runtime->program->layer_count) {
+        fw_bc3_status_t status = fw_bc3_execute_statement_block(
+            runtime,
+            runtime->program->layer_stmt_start[layer],
+            runtime->program->layer_stmt_count[layer],
+            false,
+            runtime->program->layer_let_count[layer],
+            &inputs,
+            &out,
+            0,
+            &budget
+        );
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+        layer += 1U;
+    }
+
+    *out_color = out;
+    return FW_BC3_OK;
+}
+
+static fw_bc3_status_t IRAM_ATTR fw_bc3_eval_row_chunk(
+    fw_bc3_runtime_t *runtime,
+    float y,
+    uint16_t x0,
+    uint16_t lane_count,
+    fw_bc3_color_t *out_colors
+) {
+    const fw_bc3_program_t *program = runtime->program;
+    for (uint16_t lane = 0; lane < lane_count; lane++) {
+        runtime->registers[FW_BC3_INPUT_X][lane] = (float)(uint16_t)(x0 + lane);
+        runtime->registers[FW_BC3_INPUT_Y][lane] = y;
+        runtime->row_budget[lane] = FW_BC3_DEFAULT_STATEMENT_BUDGET;
+        out_colors[lane] = (fw_bc3_color_t){
+            .r = 0.0f,
+            .g = 0.0f,
+            .b = 0.0f,
+            .a = 1.0f,
+        };
+    }
+
+    if (!runtime->row_cache_valid || runtime->row_cached_y != y) {
+        fw_bc3_status_t status = fw_bc3_runtime_begin_row(runtime, y);
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+    }
+
+    if (runtime->has_dynamic_params) {
+        if (runtime->has_y_only_dynamic_params) {
+            for (uint16_t i = 0; i < program->param_count; i++) {
+                if (program->param_depends_y[i] != 0U && program->param_depends_x[i] == 0U) {
+                    fw_bc3_register_fill(runtime, (uint16_t)(program->register_param_base + i), runtime->param_values[i]);
+                }
+            }
+        }
+
+        if (runtime->has_x_dynamic_params) {
+            for (uint16_t i = 0; i < program->param_count; i++) {
+                if (program->param_depends_x[i] == 0U) {
+                    continue;
+                }
+                (void)fw_bc3_run_register_ops(runtime, program->expressions[program->param_expr[i]].register_op_start, lane_count);
+                // Leave the scalar slot as the per-pixel path would after the last pixel of the chunk.
+                runtime->param_values[i] = runtime->registers[program->register_param_base + i][lane_count - 1U];
+            }
+        }
+    }
+
+    const uint32_t lane_mask = fw_bc3_row_full_mask(lane_count);
+    runtime->hoist_cursor = 0U;
+    uint16_t layer = 0;
+    while (layer < program->layer_count) {
+        fw_bc3_status_t status = fw_bc3_execute_statement_block_row(
+            runtime,
+            program->layer_stmt_start[layer],
+            program->layer_stmt_count[layer],
+            lane_count,
+            lane_mask,
+            out_colors,
+            0
+        );
+        if (status != FW_BC3_OK) {
+            return status;
+        }
+        layer += 1U;
+    }
+
+    return FW_BC3_OK;
+}
+
+fw_bc3_status_t IRAM_ATTR fw_bc3_runtime_eval_row(
+    fw_bc3_runtime_t *runtime,
+    float y,
+    uint16_t x0,
+    uint16_t count,
+    fw_bc3_color_t *out_colors
+) {
+    if (runtime == NULL || runtime->program == NULL || out_colors == NULL) {
+        return FW_BC3_ERR_INVALID_ARG;
+    }
+
+    uint16_t done = 0;
+    while (done < count) {
+        const uint16_t remaining = (uint16_t)(count - done);
+        const uint16_t lane_count = (remaining > FW_BC3_ROW_LANES) ? (uint16_t)FW_BC3_ROW_LANES : remaining;
+        const uint16_t chunk_x0 = (uint16_t)(x0 + done);
+        fw_bc3_color_t *chunk_out = &out_colors[done];
+
+        if (runtime->row_eval_supported) {
+            fw_bc3_status_t status = fw_bc3_eval_row_chunk(runtime, y, chunk_x0, lane_count, chunk_out);
+            if (status != FW_BC3_OK) {
+                return status;
+            }
+        } else {
+            for (uint16_t lane = 0; lane < lane_count; lane++) {
+                fw_bc3_status_t status = fw_bc3_runtime_eval_pixel(
+                    runtime,
+                    (float)(uint16_t)(chunk_x0 + lane),
+                    y,
+                    &chunk_out[lane]
+                );
+                if (status != FW_BC3_OK) {
+                    return status;
+                }
+            }
+        }
+        done = (uint16_t)(done + lane_count);
+    }
+
+    return FW_BC3_OK;
+}
+
+const char *fw_bc3_status_to_string(fw_bc3_status_t status) {
+    switch (status) {
+        case FW_BC3_OK:
+            return "ok";
+        case FW_BC3_ERR_INVALID_ARG:
+            return "invalid_arg";
+        case FW_BC3_ERR_BAD_MAGIC:
+            return "bad_magic";
+        case FW_BC3_ERR_UNSUPPORTED_VERSION:
+            return "unsupported_version";
+        case FW_BC3_ERR_TRUNCATED:
+            return "truncated";
+        case FW_BC3_ERR_FORMAT:
+            return "format";
+        case FW_BC3_ERR_LIMIT:
+            return "limit";
+        case FW_BC3_ERR_INVALID_OPCODE:
+            return "invalid_opcode";
+        case FW_BC3_ERR_INVALID_TAG:
+            return "invalid_tag";
+        case FW_BC3_ERR_INVALID_SLOT:
+            return "invalid_slot";
+        case FW_BC3_ERR_STACK_UNDERFLOW:
+            return "stack_underflow";
+        case FW_BC3_ERR_STACK_OVERFLOW:
+            return "stack_overflow";
+        case FW_BC3_ERR_TYPE_MISMATCH:
+            return "type_mismatch";
+        case FW_BC3_ERR_INVALID_BUILTIN:
+            return "invalid_builtin";
+        case FW_BC3_ERR_LOOP_LIMIT:
+            return "loop_limit";
+        case FW_BC3_ERR_EXEC_BUDGET:
+            return "exec_budget";
+        default:
+            return "unknown";
+    }
+}
+
+const char *fw_bc3_fusion_kind_to_string(fw_bc3_fusion_kind_t kind) {
+    switch (kind) {
+        case FW_BC3_FUSION_MUL_LIT:
+            return "mul_lit";
+        case FW_BC3_FUSION_ADD_LIT:
+            return "add_lit";
+        case FW_BC3_FUSION_SUB_LIT:
+            return "sub_lit";
+        case FW_BC3_FUSION_RSUB_LIT:
+            return "rsub_lit";
+        case FW_BC3_FUSION_FMA_LIT:
+            return "fma_lit";
+        case FW_BC3_FUSION_SIN_AFFINE:
+            return "sin_affine";
+        case FW_BC3_FUSION_COS_AFFINE:
+            return "cos_affine";
+        default:
+            return "unknown";
+    }
+}
@@ -8,14 +8,24 @@
 #define FW_BC3_MAX_PARAMS 64U
 #define FW_BC3_MAX_LAYERS 16U
 #define FW_BC3_MAX_LET_SLOTS 128U
-#define FW_BC3_MAX_EXPRESSIONS 512U
-#define FW_BC3_MAX_STATEMENTS 512U
+// Expression, statement, op and constant tables live in a per-program arena sized to the blob, so these
+// limits only bound what one program may use; they cost nothing when unused.
+#define FW_BC3_MAX_EXPRESSIONS 2048U
+#define FW_BC3_MAX_STATEMENTS 2048U
 #define FW_BC3_MAX_EXPR_INSTRUCTIONS 256U
 #define FW_BC3_MAX_EXPR_STACK 32U
-#define FW_BC3_MAX_DECODED_OPS 2048U
+#define FW_BC3_MAX_DECODED_OPS 8192U
+#define FW_BC3_MAX_DECODED_AFFINES 1024U
 #define FW_BC3_MAX_STATEMENT_DEPTH 16U
 #define FW_BC3_MAX_LOOP_ITERATIONS 1024U
 #define FW_BC3_DEFAULT_STATEMENT_BUDGET 8192U
+#define FW_BC3_ROW_LANES 32U
+// Let values, hoisted values and the register file live in a per-runtime arena sized to the loaded program
+// (fw_bc3_runtime_arena_size); FW_BC3_MAX_LET_SLOTS, FW_BC3_MAX_REGISTERS and FW_BC3_MAX_HOISTED_VALUES only
+// bound it.
+#define FW_BC3_MAX_REGISTERS 128U
+#define FW_BC3_MAX_REGISTER_OPS 4096U
+#define FW_BC3_MAX_HOISTED_VALUES 512U
 
 typedef enum {
     FW_BC3_OK = 0,
@@ -63,10 +73,37 @@ typedef struct {
     } as;
 } fw_bc3_value_t;
 
+// Superinstructions formed by the decoder's peephole pass; counted per program in fusion_counts.
+typedef enum {
+    FW_BC3_FUSION_MUL_LIT = 0,    // x * c
+    FW_BC3_FUSION_ADD_LIT = 1,    // x + c, c + x
+    FW_BC3_FUSION_SUB_LIT = 2,    // x - c
+    FW_BC3_FUSION_RSUB_LIT = 3,   // c - x
+    FW_BC3_FUSION_FMA_LIT = 4,    // x * a + b
+    FW_BC3_FUSION_SIN_AFFINE = 5, // sin(x * a + b)
+    FW_BC3_FUSION_COS_AFFINE = 6, // cos(x * a + b)
+    FW_BC3_FUSION_COUNT = 7,
+} fw_bc3_fusion_kind_t;
+
+typedef struct {
+    float scale;
+    float offset;
+} fw_bc3_affine_t;
+
+// How often a layer let's value can change; the loader classifies every let at load time.
+typedef enum {
+    FW_BC3_RATE_FRAME = 0, // reads only time/frame/size/seed, static params, frame lets and loop indices
+    FW_BC3_RATE_ROW = 1,   // additionally reads y or y-only params
+    FW_BC3_RATE_PIXEL = 2, // reads x, x-dependent params, or sits inside an if branch
+    FW_BC3_RATE_COUNT = 3,
+} fw_bc3_rate_t;
+
+// Decoded ops op_start .. op_start + op_count, followed by a HALT; register_op_start is the expression's
+// first op in the register form.
 typedef struct {
-    uint32_t byte_offset;
-    uint16_t instruction_count;
-    uint16_t max_stack_depth;
+    uint16_t op_start;
+    uint16_t op_count;
+    uint16_t register_op_start;
 } fw_bc3_expr_view_t;
 
 typedef enum {
@@ -76,15 +113,24 @@ typedef enum {
     FW_BC3_STMT_FOR = 4,
 } fw_bc3_stmt_kind_t;
 
+// Per-statement load-time results share the record: rate and hoisted come from let hoisting (hoisted also
+// marks for loops whose body holds hoisted lets), blend_mode from blend lowering (fw_bc3_blend_mode_t in .c).
 typedef struct {
-    fw_bc3_stmt_kind_t kind;
+    uint8_t kind; // fw_bc3_stmt_kind_t
+    uint8_t rate; // fw_bc3_rate_t of a let
+    uint8_t hoisted;
+    uint8_t blend_mode;
     union {
         struct {
             uint16_t slot;
             uint16_t expr_index;
+            uint16_t register_halt; // HALT op naming the let's registers in the register form
         } let_decl;
         struct {
             uint16_t expr_index;
+            // Alpha-first blends evaluate the derived expression alpha_expr, and alpha_expr + 1 (r/g/b with
+            // a placeholder alpha) only when alpha > 0.
+            uint16_t alpha_expr;
         } blend;
         struct {
             uint16_t cond_expr_index;
@@ -94,11 +140,12 @@ typedef struct {
             uint16_t else_count;
         } if_stmt;
         struct {
-            uint16_t index_slot;
             uint32_t start_inclusive;
             uint32_t end_exclusive;
+            uint16_t index_slot;
             uint16_t body_start;
             uint16_t body_count;
+            uint8_t index_register; // register holding the loop index in the register form
         } for_stmt;
     } as;
 } fw_bc3_stmt_view_t;
@@ -109,14 +156,28 @@ typedef struct {
     uint8_t arg_count; // CALL_BUILTIN: argument count
     uint8_t _pad;
     union {
-        float scalar;           // PUSH_SCALAR_LIT
-        uint16_t index;         // PUSH_INPUT/PARAM/FRAME_LET/LET: slot index
+        float scalar;           // PUSH_SCALAR_LIT, MUL/ADD/SUB/RSUB_LIT
+        uint16_t index;         // PUSH_INPUT/PARAM/FRAME_LET/LET: slot index; FMA_LIT/*_AFFINE: decoded_affines index
     };
 } fw_bc3_decoded_op_t;
 
+// Three-address op over the flat float register file; vec2/rgba values occupy consecutive registers.
+typedef struct {
+    uint8_t op;     // register opcode (fw_bc3_register_opcode_t in .c)
+    uint8_t dst;    // destination register
+    uint8_t src[4]; // source registers; HALT lists the result components here
+} fw_bc3_register_op_t;
+
 typedef struct {
     const uint8_t *blob;
     size_t blob_len;
+    // Caller-owned storage for every table below that grows with the program (expressions, statements,
+    // decoded ops, affines, the register constant pool and register ops). fw_bc3_program_load carves it
+    // into sections no larger than the counting pass of fw_bc3_program_arena_size allows, then compacts
+    // them to the first arena_used bytes.
+    uint8_t *arena;
+    size_t arena_len;
+    size_t arena_used;
     uint16_t param_count;
     uint16_t layer_count;
     uint16_t frame_stmt_start;
@@ -131,13 +192,42 @@ typedef struct {
     uint8_t pixel_depends_xy;
     uint16_t param_expr[FW_BC3_MAX_PARAMS];
     uint16_t expr_count;
+    uint16_t expr_capacity;
+    fw_bc3_expr_view_t *expressions;
     uint16_t stmt_count;
-    fw_bc3_expr_view_t expressions[FW_BC3_MAX_EXPRESSIONS];
-    fw_bc3_stmt_view_t statements[FW_BC3_MAX_STATEMENTS];
+    uint16_t stmt_capacity;
+    fw_bc3_stmt_view_t *statements;
     uint16_t decoded_op_count;
-    uint16_t expr_op_start[FW_BC3_MAX_EXPRESSIONS];
-    uint16_t expr_op_count[FW_BC3_MAX_EXPRESSIONS];
-    fw_bc3_decoded_op_t decoded_ops[FW_BC3_MAX_DECODED_OPS];
+    uint16_t decoded_op_capacity;
+    fw_bc3_decoded_op_t *decoded_ops;
+    // Literal pairs of fused affine ops, kept out of line so decoded ops stay 8 bytes.
+    uint16_t decoded_affine_count;
+    uint16_t decoded_affine_capacity;
+    fw_bc3_affine_t *decoded_affines;
+    uint16_t fusion_counts[FW_BC3_FUSION_COUNT];
+    uint16_t fusion_removed_op_count;
+    // Register form used by row evaluation; when has_register_form is 0 rows fall back to per-pixel evaluation.
+    uint8_t has_register_form;
+    uint8_t register_param_base;
+    uint8_t register_const_base;
+    uint8_t register_const_count;
+    uint8_t register_const_capacity;
+    uint8_t register_frame_let[FW_BC3_MAX_LET_SLOTS];
+    uint8_t register_frame_let_tag[FW_BC3_MAX_LET_SLOTS];
+    // Constant pool: literal values loaded into registers register_const_base .. + register_const_count.
+    float *register_const_values;
+    uint16_t register_op_count;
+    uint16_t register_op_capacity;
+    fw_bc3_register_op_t *register_ops;
+    // Registers 0 .. register_count - 1 are all the register form names; 0 without a register form.
+    uint16_t register_count;
+    // Runtime value slots: frame lets written or read (frame_values) and the largest let scope (let_values).
+    uint16_t frame_value_count;
+    uint16_t let_value_count;
+    // Let hoisting: frame- and row-rate lets outside if branches are evaluated once per frame or row and
+    // replayed from runtime->hoisted_values in execution order.
+    uint16_t hoisted_value_count;
+    uint16_t hoisted_let_count[FW_BC3_RATE_PIXEL];
 } fw_bc3_program_t;
 
 typedef struct {
@@ -150,16 +240,87 @@ typedef struct {
     bool has_dynamic_params;
     bool has_x_dynamic_params;
     bool has_y_only_dynamic_params;
-    bool y_only_params_cache_valid;
-    float y_only_params_cached_y;
+    // y-only params and row-rate hoisted lets are refreshed by fw_bc3_runtime_begin_row when y changes.
+    bool row_cache_valid;
+    float row_cached_y;
     float param_values[FW_BC3_MAX_PARAMS];
-    fw_bc3_value_t frame_values[FW_BC3_MAX_LET_SLOTS];
-    fw_bc3_value_t let_values[FW_BC3_MAX_LET_SLOTS];
+    // Params set by fw_bc3_runtime_set_param keep their value instead of re-evaluating their expression.
+    uint8_t param_pinned[FW_BC3_MAX_PARAMS];
     fw_bc3_value_t expr_stack[FW_BC3_MAX_EXPR_STACK];
+    uint16_t hoist_cursor;
+    bool row_eval_supported;
+    // Statements left per lane of the current row chunk; FW_BC3_DEFAULT_STATEMENT_BUDGET fits 16 bits.
+    uint16_t row_budget[FW_BC3_ROW_LANES];
+    // Carved from the caller's arena by fw_bc3_runtime_init, sized by the program's counts: register file
+    // registers[r][lane] (register_count), frame_values (frame_value_count), let_values (let_value_count)
+    // and hoisted_values (hoisted_value_count).
+    float (*registers)[FW_BC3_ROW_LANES];
+    fw_bc3_value_t *frame_values;
+    fw_bc3_value_t *let_values;
+    fw_bc3_value_t *hoisted_values;
 } fw_bc3_runtime_t;
 
-fw_bc3_status_t fw_bc3_program_load(fw_bc3_program_t *program, const uint8_t *blob, size_t blob_len);
-fw_bc3_status_t fw_bc3_runtime_init(fw_bc3_runtime_t *runtime, const fw_bc3_program_t *program, uint16_t width, uint16_t height);
+/**
+ * Counting pass over a DSLB blob: validates its framing and reports how many arena bytes
+ * fw_bc3_program_load needs for it. Only the structure is checked here; load still validates everything.
+ */
+fw_bc3_status_t fw_bc3_program_arena_size(const uint8_t *blob, size_t blob_len, size_t *out_bytes);
+/**
+ * Decode `blob` into `program`, placing its tables in `arena` (4-byte aligned, at least the size reported by
+ * fw_bc3_program_arena_size; FW_BC3_ERR_LIMIT otherwise). Both the blob and the arena must outlive the program.
+ * On success the tables occupy exactly the first program->arena_used bytes, so callers may move them into a
+ * smaller buffer with fw_bc3_program_relocate.
+ */
+fw_bc3_status_t fw_bc3_program_load(fw_bc3_program_t *program, const uint8_t *blob, size_t blob_len, void *arena, size_t arena_len);
+/**
+ * Copy the loaded program's arena_used bytes into `arena` (4-byte aligned) and point the program at it.
+ * The previous arena is no longer referenced afterwards; runtimes initialized for the program stay valid.
+ */
+void fw_bc3_program_relocate(fw_bc3_program_t *program, void *arena);
+/**
+ * Reports how many arena bytes fw_bc3_runtime_init needs for a runtime of the loaded `program`: its register
+ * file, let values and hoisted values. Never 0, so callers can always allocate the result.
+ */
+fw_bc3_status_t fw_bc3_runtime_arena_size(const fw_bc3_program_t *program, size_t *out_bytes);
+/**
+ * Initialize `runtime` for `program`, carving its per-program storage from `arena` (4-byte aligned, at least
+ * fw_bc3_runtime_arena_size bytes; FW_BC3_ERR_LIMIT otherwise). The arena must outlive the runtime.
+ */
+fw_bc3_status_t fw_bc3_runtime_init(
+    fw_bc3_runtime_t *runtime,
+    const fw_bc3_program_t *program,
+    uint16_t width,
+    uint16_t height,
+    void *arena,
+    size_t arena_len
+);
+/**
+ * Pin param `index` to `value` from the next fw_bc3_runtime_begin_frame on, in place of its expression,
+ * until the runtime is initialized again. Only params that depend on neither x nor y can be set
+ * (FW_BC3_ERR_INVALID_SLOT otherwise), so the loaded program needs no re-decode.
+ */
+fw_bc3_status_t fw_bc3_runtime_set_param(fw_bc3_runtime_t *runtime, uint16_t index, float value);
 fw_bc3_status_t fw_bc3_runtime_begin_frame(fw_bc3_runtime_t *runtime, float time_seconds, uint32_t frame_counter);
+/**
+ * Refresh the per-row state for row y: y-only params and row-rate hoisted lets. The eval functions call
+ * this themselves whenever y differs from the previous call, so calling it explicitly is optional.
+ */
+fw_bc3_status_t fw_bc3_runtime_begin_row(fw_bc3_runtime_t *runtime, float y);
 fw_bc3_status_t fw_bc3_runtime_eval_pixel(fw_bc3_runtime_t *runtime, float x, float y, fw_bc3_color_t *out_color);
+/**
+ * Evaluate `count` consecutive pixels (x0 .. x0 + count - 1) of row y into out_colors.
+ * Each register op runs over up to FW_BC3_ROW_LANES pixels at once, so dispatch is paid once per row
+ * chunk instead of once per pixel. While every value stays finite, results are bit-identical to calling
+ * fw_bc3_runtime_eval_pixel per pixel; once an expression produces inf or NaN (x / frame at frame 0, ln(0))
+ * the -ffast-math build may fold the two paths differently and their colors can disagree.
+ * Programs without a register form transparently fall back to per-pixel evaluation.
+ */
+fw_bc3_status_t fw_bc3_runtime_eval_row(
+    fw_bc3_runtime_t *runtime,
+    float y,
+    uint16_t x0,
+    uint16_t count,
+    fw_bc3_color_t *out_colors
+);
 const char *fw_bc3_status_to_string(fw_bc3_status_t status);
+const char *fw_bc3_fusion_kind_to_string(fw_bc3_fusion_kind_t kind);
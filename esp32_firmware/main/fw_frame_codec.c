@@ -0,0 +1,73 @@
+#include "fw_frame_codec.h"
+
+#include <string.h>
+
+static int fw_frame_codec_decode_xor_rle(const uint8_t *body, size_t body_len, uint8_t *frame, size_t frame_len) {
+    size_t in = 0U;
+    size_t out = 0U;
+    while (in < body_len) {
+        const uint8_t control = body[in++];
+        const size_t run = (size_t)(control & 0x7FU) + 1U;
+        if (run > frame_len - out) {
+            return -1;
+        }
+        if ((control & 0x80U) != 0U) {
+            out += run;
+            continue;
+        }
+        if (run > body_len - in) {
+            return -1;
+        }
+        for (size_t i = 0U; i < run; i++) {
+            frame[out + i] ^= body[in + i];
+        }
+        in += run;
+        out += run;
+    }
+    return 0;
+}
+
+static int fw_frame_codec_decode_spans(const uint8_t *body, size_t body_len, uint8_t *frame, size_t frame_len,
+                                       uint8_t bytes_per_pixel) {
+    if (bytes_per_pixel == 0U) {
+        return -1;
+    }
+    size_t in = 0U;
+    while (in < body_len) {
+        if (body_len - in < 4U) {
+            return -1;
+        }
+        const size_t first_pixel = ((size_t)body[in] << 8) | (size_t)body[in + 1U];
+        const size_t pixel_count = ((size_t)body[in + 2U] << 8) | (size_t)body[in + 3U];
+        in += 4U;
+        const size_t offset = first_pixel * bytes_per_pixel;
+        const size_t len = pixel_count * bytes_per_pixel;
+        if (offset > frame_len || len > frame_len - offset || len > body_len - in) {
+            return -1;
+        }
+        memcpy(frame + offset, body + in, len);
+        in += len;
+    }
+    return 0;
+}
+
+int fw_frame_codec_decode(uint8_t encoding, const uint8_t *body, size_t body_len, uint8_t *frame,
+                          size_t frame_len, uint8_t bytes_per_pixel) {
+    if (frame == NULL || (body == NULL && body_len > 0U)) {
+        return -1;
+    }
+    switch (encoding) {
+        case FW_FRAME_CODEC_RAW:
+            if (body_len != frame_len) {
+                return -1;
+            }
+            memcpy(frame, body, frame_len);
+            return 0;
+        case FW_FRAME_CODEC_XOR_RLE:
+            return fw_frame_codec_decode_xor_rle(body, body_len, frame, frame_len);
+        case FW_FRAME_CODEC_SPANS:
+            return fw_frame_codec_decode_spans(body, body_len, frame, frame_len, bytes_per_pixel);
+        default:
+            return -1;
+    }
+}
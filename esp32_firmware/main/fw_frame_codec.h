@@ -0,0 +1,48 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Compressed frame payloads.
+ *
+ * A sender sets FW_FRAME_CODEC_FORMAT_FLAG in the pixel format byte to say
+ * its frame payloads are encoded.  Each encoded payload is
+ *
+ *   u32 BE body_len | u8 encoding | body_len bytes
+ *
+ * and is applied to the receiver's copy of the previous frame of the same
+ * connection (the reference), which then becomes the new frame:
+ *
+ *   RAW      body is the whole frame.
+ *   XOR_RLE  body is a run-length coded XOR against the reference.  Each
+ *            control byte c is either a run of ((c & 0x7f) + 1) unchanged
+ *            bytes (c & 0x80) or is followed by (c + 1) bytes to XOR in.
+ *            Bytes past the last run are unchanged.
+ *   SPANS    body is a list of { u16 BE first_pixel, u16 BE pixel_count,
+ *            pixel_count * bytes_per_pixel new bytes } records.
+ *
+ * The first frame of a connection must be RAW; an unchanged frame is a
+ * delta with an empty body.
+ */
+
+#define FW_FRAME_CODEC_FORMAT_FLAG 0x80U
+#define FW_FRAME_CODEC_PREFIX_LEN 5U
+
+#define FW_FRAME_CODEC_RAW 0U
+#define FW_FRAME_CODEC_XOR_RLE 1U
+#define FW_FRAME_CODEC_SPANS 2U
+
+/**
+ * Apply one encoded body to the reference frame in place.
+ *
+ * @param encoding        One of FW_FRAME_CODEC_*.
+ * @param frame           Reference frame; holds the decoded frame on success.
+ * @param frame_len       Bytes per decoded frame.
+ * @param bytes_per_pixel Pixel size, used by SPANS.
+ * @return 0 on success, -1 for an unknown encoding or a body that does not fit
+ *         the frame (the reference is then partially updated and must be
+ *         discarded).
+ */
+int fw_frame_codec_decode(uint8_t encoding, const uint8_t *body, size_t body_len, uint8_t *frame,
+                          size_t frame_len, uint8_t bytes_per_pixel);
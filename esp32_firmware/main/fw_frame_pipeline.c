@@ -0,0 +1,388 @@
+#include "fw_frame_pipeline.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+
+#if defined(ESP_PLATFORM)
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#elif !defined(_WIN32)
+#include <pthread.h>
+#include <time.h>
+#define FW_FRAME_PIPELINE_PTHREAD 1
+#else
+#include <windows.h>
+#endif
+
+/* The output stage only starts RMT transfers and waits on the driver. */
+#define FW_FRAME_PIPELINE_STACK_SIZE 4096U
+/* Above the render worker on the same core, so transmission starts as soon as a frame is queued. */
+#define FW_FRAME_PIPELINE_PRIORITY 5U
+
+struct fw_frame_pipeline {
+    size_t frame_len;
+    uint8_t *buffers[FW_FRAME_PIPELINE_DEPTH];
+    int64_t submit_us[FW_FRAME_PIPELINE_DEPTH];
+    fw_frame_output_fn_t output;
+    void *output_ctx;
+
+    /* Guarded by the lock. */
+    uint32_t write_index;
+    uint32_t read_index;
+    uint32_t queued_count; /* submitted frames whose output has not finished */
+    int latched_error;
+    bool stopping;
+    bool exited;
+    fw_frame_pipeline_stats_t stats;
+
+#if defined(ESP_PLATFORM)
+    SemaphoreHandle_t lock;
+    SemaphoreHandle_t ready_sem; /* given on submit and stop; taken by the output stage */
+    SemaphoreHandle_t done_sem;  /* given when a frame is output; taken by acquire/flush */
+    TaskHandle_t task;
+#elif defined(FW_FRAME_PIPELINE_PTHREAD)
+    pthread_mutex_t lock;
+    pthread_cond_t ready_cond;
+    pthread_cond_t done_cond;
+    pthread_t thread;
+#endif
+};
+
+static float fw_frame_pipeline_ema(float average, float sample) {
+    return average * 0.9f + sample * 0.1f;
+}
+
+/*
+ * Platform primitives.  Waits are called with the lock held, return with it
+ * held, and may wake spuriously, so callers re-check their condition.
+ */
+#if defined(ESP_PLATFORM)
+
+static int64_t fw_frame_pipeline_now_us(void) {
+    return esp_timer_get_time();
+}
+
+static void fw_frame_pipeline_lock(fw_frame_pipeline_t *pipeline) {
+    xSemaphoreTake(pipeline->lock, portMAX_DELAY);
+}
+
+static void fw_frame_pipeline_unlock(fw_frame_pipeline_t *pipeline) {
+    xSemaphoreGive(pipeline->lock);
+}
+
+static void fw_frame_pipeline_wait_ready(fw_frame_pipeline_t *pipeline) {
+    xSemaphoreGive(pipeline->lock);
+    xSemaphoreTake(pipeline->ready_sem, portMAX_DELAY);
+    xSemaphoreTake(pipeline->lock, portMAX_DELAY);
+}
+
+static void fw_frame_pipeline_wait_done(fw_frame_pipeline_t *pipeline) {
+    xSemaphoreGive(pipeline->lock);
+    xSemaphoreTake(pipeline->done_sem, portMAX_DELAY);
+    xSemaphoreTake(pipeline->lock, portMAX_DELAY);
+}
+
+static void fw_frame_pipeline_signal_ready(fw_frame_pipeline_t *pipeline) {
+    xSemaphoreGive(pipeline->ready_sem);
+}
+
+static void fw_frame_pipeline_signal_done(fw_frame_pipeline_t *pipeline) {
+    xSemaphoreGive(pipeline->done_sem);
+}
+
+#elif defined(FW_FRAME_PIPELINE_PTHREAD)
+
+static int64_t fw_frame_pipeline_now_us(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (int64_t)now.tv_sec * 1000000 + (int64_t)(now.tv_nsec / 1000);
+}
+
+static void fw_frame_pipeline_lock(fw_frame_pipeline_t *pipeline) {
+    pthread_mutex_lock(&pipeline->lock);
+}
+
+static void fw_frame_pipeline_unlock(fw_frame_pipeline_t *pipeline) {
+    pthread_mutex_unlock(&pipeline->lock);
+}
+
+static void fw_frame_pipeline_wait_ready(fw_frame_pipeline_t *pipeline) {
+    pthread_cond_wait(&pipeline->ready_cond, &pipeline->lock);
+}
+
+static void fw_frame_pipeline_wait_done(fw_frame_pipeline_t *pipeline) {
+    pthread_cond_wait(&pipeline->done_cond, &pipeline->lock);
+}
+
+static void fw_frame_pipeline_signal_ready(fw_frame_pipeline_t *pipeline) {
+    pthread_cond_broadcast(&pipeline->ready_cond);
+}
+
+static void fw_frame_pipeline_signal_done(fw_frame_pipeline_t *pipeline) {
+    pthread_cond_broadcast(&pipeline->done_cond);
+}
+
+#else
+
+/* No threads: submit outputs the frame before returning, so nothing ever waits. */
+static int64_t fw_frame_pipeline_now_us(void) {
+    LARGE_INTEGER counter;
+    LARGE_INTEGER frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (int64_t)(counter.QuadPart * 1000000 / frequency.QuadPart);
+}
+
+static void fw_frame_pipeline_lock(fw_frame_pipeline_t *pipeline) {
+    (void)pipeline;
+}
+
+static void fw_frame_pipeline_unlock(fw_frame_pipeline_t *pipeline) {
+    (void)pipeline;
+}
+
+static void fw_frame_pipeline_wait_done(fw_frame_pipeline_t *pipeline) {
+    (void)pipeline;
+}
+
+static void fw_frame_pipeline_signal_ready(fw_frame_pipeline_t *pipeline) {
+    (void)pipeline;
+}
+
+static void fw_frame_pipeline_signal_done(fw_frame_pipeline_t *pipeline) {
+    (void)pipeline;
+}
+
+#endif
+
+/* Output the oldest queued frame.  Called with the lock held; drops it around the callback. */
+static void fw_frame_pipeline_output_next(fw_frame_pipeline_t *pipeline) {
+    const uint32_t index = pipeline->read_index;
+    const int64_t submit_us = pipeline->submit_us[index];
+    fw_frame_pipeline_unlock(pipeline);
+
+    const int64_t output_start_us = fw_frame_pipeline_now_us();
+    const int err = pipeline->output(pipeline->output_ctx, pipeline->buffers[index], pipeline->frame_len);
+    const int64_t output_end_us = fw_frame_pipeline_now_us();
+
+    fw_frame_pipeline_lock(pipeline);
+    if (err != 0 && pipeline->latched_error == 0) {
+        pipeline->latched_error = err;
+    }
+    pipeline->read_index = (index + 1U) % FW_FRAME_PIPELINE_DEPTH;
+    pipeline->queued_count -= 1U;
+    pipeline->stats.frames_output += 1U;
+    pipeline->stats.output_us = fw_frame_pipeline_ema(pipeline->stats.output_us, (float)(output_end_us - output_start_us));
+    pipeline->stats.latency_us = fw_frame_pipeline_ema(pipeline->stats.latency_us, (float)(output_end_us - submit_us));
+    fw_frame_pipeline_signal_done(pipeline);
+}
+
+#if defined(ESP_PLATFORM) || defined(FW_FRAME_PIPELINE_PTHREAD)
+static void fw_frame_pipeline_output_loop(fw_frame_pipeline_t *pipeline) {
+    fw_frame_pipeline_lock(pipeline);
+    for (;;) {
+        while (pipeline->queued_count == 0U && !pipeline->stopping) {
+            fw_frame_pipeline_wait_ready(pipeline);
+        }
+        if (pipeline->queued_count == 0U) {
+            break;
+        }
+        fw_frame_pipeline_output_next(pipeline);
+    }
+    pipeline->exited = true;
+    fw_frame_pipeline_signal_done(pipeline);
+    fw_frame_pipeline_unlock(pipeline);
+}
+#endif
+
+#if defined(ESP_PLATFORM)
+
+static void fw_frame_pipeline_task(void *arg) {
+    fw_frame_pipeline_output_loop((fw_frame_pipeline_t *)arg);
+    vTaskDelete(NULL);
+}
+
+static int fw_frame_pipeline_start_output(fw_frame_pipeline_t *pipeline, int core) {
+    pipeline->lock = xSemaphoreCreateMutex();
+    pipeline->ready_sem = xSemaphoreCreateBinary();
+    pipeline->done_sem = xSemaphoreCreateBinary();
+    if (pipeline->lock == NULL || pipeline->ready_sem == NULL || pipeline->done_sem == NULL) {
+        goto fail;
+    }
+    if (xTaskCreatePinnedToCore(fw_frame_pipeline_task, "fw_frame_out", FW_FRAME_PIPELINE_STACK_SIZE, pipeline,
+                                FW_FRAME_PIPELINE_PRIORITY, &pipeline->task, core) != pdPASS) {
+        goto fail;
+    }
+    return 0;
+
+fail:
+    if (pipeline->lock != NULL) {
+        vSemaphoreDelete(pipeline->lock);
+    }
+    if (pipeline->ready_sem != NULL) {
+        vSemaphoreDelete(pipeline->ready_sem);
+    }
+    if (pipeline->done_sem != NULL) {
+        vSemaphoreDelete(pipeline->done_sem);
+    }
+    return -1;
+}
+
+static void fw_frame_pipeline_join_output(fw_frame_pipeline_t *pipeline) {
+    /* The task only calls vTaskDelete() once it has released the lock with exited set. */
+    fw_frame_pipeline_lock(pipeline);
+    while (!pipeline->exited) {
+        fw_frame_pipeline_wait_done(pipeline);
+    }
+    fw_frame_pipeline_unlock(pipeline);
+    vSemaphoreDelete(pipeline->lock);
+    vSemaphoreDelete(pipeline->ready_sem);
+    vSemaphoreDelete(pipeline->done_sem);
+}
+
+#elif defined(FW_FRAME_PIPELINE_PTHREAD)
+
+static void *fw_frame_pipeline_thread(void *arg) {
+    fw_frame_pipeline_output_loop((fw_frame_pipeline_t *)arg);
+    return NULL;
+}
+
+static int fw_frame_pipeline_start_output(fw_frame_pipeline_t *pipeline, int core) {
+    (void)core;
+    if (pthread_mutex_init(&pipeline->lock, NULL) != 0) {
+        return -1;
+    }
+    if (pthread_cond_init(&pipeline->ready_cond, NULL) != 0) {
+        pthread_mutex_destroy(&pipeline->lock);
+        return -1;
+    }
+    if (pthread_cond_init(&pipeline->done_cond, NULL) != 0) {
+        pthread_cond_destroy(&pipeline->ready_cond);
+        pthread_mutex_destroy(&pipeline->lock);
+        return -1;
+    }
+    if (pthread_create(&pipeline->thread, NULL, fw_frame_pipeline_thread, pipeline) != 0) {
+        pthread_cond_destroy(&pipeline->done_cond);
+        pthread_cond_destroy(&pipeline->ready_cond);
+        pthread_mutex_destroy(&pipeline->lock);
+        return -1;
+    }
+    return 0;
+}
+
+static void fw_frame_pipeline_join_output(fw_frame_pipeline_t *pipeline) {
+    pthread_join(pipeline->thread, NULL);
+    pthread_cond_destroy(&pipeline->done_cond);
+    pthread_cond_destroy(&pipeline->ready_cond);
+    pthread_mutex_destroy(&pipeline->lock);
+}
+
+#else
+
+static int fw_frame_pipeline_start_output(fw_frame_pipeline_t *pipeline, int core) {
+    (void)pipeline;
+    (void)core;
+    return 0;
+}
+
+static void fw_frame_pipeline_join_output(fw_frame_pipeline_t *pipeline) {
+    (void)pipeline;
+}
+
+#endif
+
+static void fw_frame_pipeline_free(fw_frame_pipeline_t *pipeline) {
+    for (uint32_t i = 0; i < FW_FRAME_PIPELINE_DEPTH; i++) {
+        free(pipeline->buffers[i]);
+    }
+    free(pipeline);
+}
+
+fw_frame_pipeline_t *fw_frame_pipeline_create(size_t frame_len, fw_frame_output_fn_t output, void *output_ctx, int core) {
+    if (frame_len == 0U || output == NULL) {
+        return NULL;
+    }
+    fw_frame_pipeline_t *pipeline = (fw_frame_pipeline_t *)calloc(1U, sizeof(fw_frame_pipeline_t));
+    if (pipeline == NULL) {
+        return NULL;
+    }
+    pipeline->frame_len = frame_len;
+    pipeline->output = output;
+    pipeline->output_ctx = output_ctx;
+    for (uint32_t i = 0; i < FW_FRAME_PIPELINE_DEPTH; i++) {
+        pipeline->buffers[i] = (uint8_t *)calloc(1U, frame_len);
+        if (pipeline->buffers[i] == NULL) {
+            fw_frame_pipeline_free(pipeline);
+            return NULL;
+        }
+    }
+    if (fw_frame_pipeline_start_output(pipeline, core) != 0) {
+        fw_frame_pipeline_free(pipeline);
+        return NULL;
+    }
+    return pipeline;
+}
+
+void fw_frame_pipeline_destroy(fw_frame_pipeline_t *pipeline) {
+    if (pipeline == NULL) {
+        return;
+    }
+    fw_frame_pipeline_lock(pipeline);
+    pipeline->stopping = true;
+    fw_frame_pipeline_signal_ready(pipeline);
+    fw_frame_pipeline_unlock(pipeline);
+    fw_frame_pipeline_join_output(pipeline);
+    fw_frame_pipeline_free(pipeline);
+}
+
+uint8_t *fw_frame_pipeline_acquire(fw_frame_pipeline_t *pipeline) {
+    const int64_t wait_start_us = fw_frame_pipeline_now_us();
+    fw_frame_pipeline_lock(pipeline);
+    while (pipeline->queued_count >= FW_FRAME_PIPELINE_DEPTH) {
+        fw_frame_pipeline_wait_done(pipeline);
+    }
+    uint8_t *buffer = pipeline->buffers[pipeline->write_index];
+    pipeline->stats.acquire_wait_us =
+        fw_frame_pipeline_ema(pipeline->stats.acquire_wait_us, (float)(fw_frame_pipeline_now_us() - wait_start_us));
+    fw_frame_pipeline_unlock(pipeline);
+    return buffer;
+}
+
+int fw_frame_pipeline_submit(fw_frame_pipeline_t *pipeline) {
+    const int64_t now_us = fw_frame_pipeline_now_us();
+    fw_frame_pipeline_lock(pipeline);
+    const uint32_t index = pipeline->write_index;
+    pipeline->submit_us[index] = now_us;
+    pipeline->write_index = (index + 1U) % FW_FRAME_PIPELINE_DEPTH;
+    pipeline->queued_count += 1U;
+    pipeline->stats.frames_submitted += 1U;
+    const int err = pipeline->latched_error;
+    pipeline->latched_error = 0;
+    fw_frame_pipeline_signal_ready(pipeline);
+#if !defined(ESP_PLATFORM) && !defined(FW_FRAME_PIPELINE_PTHREAD)
+    while (pipeline->queued_count > 0U) {
+        fw_frame_pipeline_output_next(pipeline);
+    }
+#endif
+    fw_frame_pipeline_unlock(pipeline);
+    return err;
+}
+
+int fw_frame_pipeline_flush(fw_frame_pipeline_t *pipeline) {
+    fw_frame_pipeline_lock(pipeline);
+    while (pipeline->queued_count > 0U) {
+        fw_frame_pipeline_wait_done(pipeline);
+    }
+    const int err = pipeline->latched_error;
+    pipeline->latched_error = 0;
+    fw_frame_pipeline_unlock(pipeline);
+    return err;
+}
+
+void fw_frame_pipeline_get_stats(fw_frame_pipeline_t *pipeline, fw_frame_pipeline_stats_t *out_stats) {
+    fw_frame_pipeline_lock(pipeline);
+    *out_stats = pipeline->stats;
+    fw_frame_pipeline_unlock(pipeline);
+}
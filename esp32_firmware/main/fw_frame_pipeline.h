@@ -0,0 +1,75 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Pipelined render/output for shader frames.
+ *
+ * The pipeline owns two logical frame buffers.  The renderer acquires one,
+ * renders into it and submits it; a dedicated output stage (a FreeRTOS task
+ * on ESP32, a pthread on hosts) hands submitted frames to an output callback
+ * in order, which on the pillar transmits the (already wire-format) frame.
+ * While frame N is in the output stage, frame N+1 is already being rendered;
+ * the renderer only blocks when it gets two frames ahead of the output.
+ *
+ * acquire/submit/flush must be serialized by the caller (the TCP server
+ * calls them under its state lock).  The output callback runs on the output
+ * stage and must not take that lock.
+ */
+
+#define FW_FRAME_PIPELINE_DEPTH 2U
+
+/**
+ * Output one frame (physical LED order).  Runs on the output stage.
+ * @return 0 on success; any other value is latched and reported by the next
+ *         fw_frame_pipeline_submit() or fw_frame_pipeline_flush().
+ */
+typedef int (*fw_frame_output_fn_t)(void *ctx, const uint8_t *frame, size_t frame_len);
+
+typedef struct {
+    uint32_t frames_submitted;
+    uint32_t frames_output;
+    float acquire_wait_us; /* EMA: renderer blocked waiting for a free buffer */
+    float output_us;       /* EMA: time spent in the output callback */
+    float latency_us;      /* EMA: submit to output callback done */
+} fw_frame_pipeline_stats_t;
+
+typedef struct fw_frame_pipeline fw_frame_pipeline_t;
+
+/**
+ * Allocate the frame buffers and start the output stage.
+ *
+ * @param frame_len  Bytes per logical frame.
+ * @param output     Output callback (must not be NULL).
+ * @param output_ctx Passed to every output call.
+ * @param core       Core to pin the output stage to on ESP32; ignored on hosts.
+ * @return The pipeline, or NULL on allocation or task creation failure.
+ */
+fw_frame_pipeline_t *fw_frame_pipeline_create(size_t frame_len, fw_frame_output_fn_t output, void *output_ctx, int core);
+
+/** Drain pending frames, stop the output stage and free the pipeline. NULL is ignored. */
+void fw_frame_pipeline_destroy(fw_frame_pipeline_t *pipeline);
+
+/**
+ * Get the next buffer to render into, waiting while the output stage still
+ * owns it.  Its previous contents are unspecified.
+ */
+uint8_t *fw_frame_pipeline_acquire(fw_frame_pipeline_t *pipeline);
+
+/**
+ * Queue the buffer returned by the last acquire for output and return
+ * without waiting for it.
+ * @return 0, or the latched error of an earlier output call.
+ */
+int fw_frame_pipeline_submit(fw_frame_pipeline_t *pipeline);
+
+/**
+ * Wait until every submitted frame has been output, e.g. before writing to
+ * the LED driver directly.
+ * @return 0, or the latched error of an earlier output call.
+ */
+int fw_frame_pipeline_flush(fw_frame_pipeline_t *pipeline);
+
+/** Copy the pipeline's counters and per-stage latencies. */
+void fw_frame_pipeline_get_stats(fw_frame_pipeline_t *pipeline, fw_frame_pipeline_stats_t *out_stats);
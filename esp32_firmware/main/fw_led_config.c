@@ -1,17 +1,22 @@
 #include "fw_led_config.h"
 
 #include <stddef.h>
+#include <stdlib.h>
 
-static esp_err_t fw_led_resolve_global_index(const fw_led_layout_config_t *layout, uint32_t global_index, fw_led_physical_index_t *out) {
+static esp_err_t fw_led_resolve_chain_index(const fw_led_layout_config_t *layout, uint32_t chain_index, fw_led_physical_index_t *out) {
     uint32_t offset = 0;
     uint8_t segment = 0;
 
     while (segment < layout->segment_count) {
         const uint32_t segment_len = layout->segments[segment].led_count;
-        if (global_index < (offset + segment_len)) {
+        if (chain_index < (offset + segment_len)) {
+            uint32_t segment_led_index = chain_index - offset;
+            if (layout->segments[segment].reversed) {
+                segment_led_index = segment_len - 1U - segment_led_index;
+            }
             out->segment_index = segment;
-            out->segment_led_index = (uint16_t)(global_index - offset);
-            out->global_led_index = global_index;
+            out->segment_led_index = (uint16_t)segment_led_index;
+            out->global_led_index = offset + segment_led_index;
             return ESP_OK;
         }
 
@@ -31,6 +36,9 @@ void fw_led_layout_load_default(fw_led_layout_config_t *layout) {
         .width = FW_LED_DEFAULT_WIDTH,
         .height = FW_LED_DEFAULT_HEIGHT,
         .serpentine_columns = true,
+        .mirror_x = false,
+        .flip_y = false,
+        .column_offset = 0,
         .segment_count = 3,
         .segments =
             {
@@ -92,13 +100,15 @@ esp_err_t fw_led_map_logical_xy(const fw_led_layout_config_t *layout, uint16_t x
         return ESP_ERR_INVALID_ARG;
     }
 
-    uint16_t mapped_y = y;
-    if (layout->serpentine_columns && ((x & 1U) != 0U)) {
-        mapped_y = (uint16_t)(layout->height - 1U - y);
+    uint16_t column = layout->mirror_x ? (uint16_t)(layout->width - 1U - x) : x;
+    column = (uint16_t)(((uint32_t)column + layout->column_offset) % layout->width);
+    uint16_t row = layout->flip_y ? (uint16_t)(layout->height - 1U - y) : y;
+    if (layout->serpentine_columns && ((column & 1U) != 0U)) {
+        row = (uint16_t)(layout->height - 1U - row);
     }
 
-    const uint32_t global_index = ((uint32_t)x * (uint32_t)layout->height) + mapped_y;
-    return fw_led_resolve_global_index(layout, global_index, out);
+    const uint32_t chain_index = ((uint32_t)column * (uint32_t)layout->height) + row;
+    return fw_led_resolve_chain_index(layout, chain_index, out);
 }
 
 esp_err_t fw_led_map_logical_linear(const fw_led_layout_config_t *layout, uint32_t logical_index, fw_led_physical_index_t *out) {
@@ -115,3 +125,49 @@ esp_err_t fw_led_map_logical_linear(const fw_led_layout_config_t *layout, uint32
     const uint16_t y = (uint16_t)(logical_index / layout->width);
     return fw_led_map_logical_xy(layout, x, y, out);
 }
+
+esp_err_t fw_led_layout_map_init(fw_led_layout_map_t *map, const fw_led_layout_config_t *layout) {
+    if (map == NULL || layout == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t layout_err = fw_led_layout_validate(layout);
+    if (layout_err != ESP_OK) {
+        return layout_err;
+    }
+
+    const uint32_t led_count = (uint32_t)layout->width * (uint32_t)layout->height;
+    if (led_count > (uint32_t)UINT16_MAX + 1U) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    uint16_t *table = (uint16_t *)malloc((size_t)led_count * sizeof(uint16_t));
+    if (table == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    for (uint16_t y = 0; y < layout->height; y += 1U) {
+        for (uint16_t x = 0; x < layout->width; x += 1U) {
+            fw_led_physical_index_t physical;
+            esp_err_t map_err = fw_led_map_logical_xy(layout, x, y, &physical);
+            if (map_err != ESP_OK) {
+                free(table);
+                return map_err;
+            }
+            table[(size_t)y * layout->width + x] = (uint16_t)physical.global_led_index;
+        }
+    }
+
+    map->width = layout->width;
+    map->height = layout->height;
+    map->logical_to_physical = table;
+    return ESP_OK;
+}
+
+void fw_led_layout_map_deinit(fw_led_layout_map_t *map) {
+    if (map == NULL) {
+        return;
+    }
+    free(map->logical_to_physical);
+    map->logical_to_physical = NULL;
+    map->width = 0U;
+    map->height = 0U;
+}
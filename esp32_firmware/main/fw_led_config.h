@@ -13,12 +13,22 @@
 typedef struct {
     gpio_num_t gpio;
     uint16_t led_count;
+    bool reversed; /* data enters at the far end, so the segment's LEDs are numbered backwards */
 } fw_led_segment_config_t;
 
+/*
+ * Wiring of the logical (x, y) grid: columns of `height` LEDs chained
+ * bottom-up (alternating direction when serpentine), split into segments in
+ * chain order.  The logical grid is first mirrored/flipped and then rotated
+ * around the pillar by column_offset columns.
+ */
 typedef struct {
     uint16_t width;
     uint16_t height;
     bool serpentine_columns;
+    bool mirror_x;
+    bool flip_y;
+    uint16_t column_offset;
     uint8_t segment_count;
     fw_led_segment_config_t segments[FW_LED_MAX_SEGMENTS];
 } fw_led_layout_config_t;
@@ -29,8 +39,23 @@ typedef struct {
     uint32_t global_led_index;
 } fw_led_physical_index_t;
 
+/*
+ * Logical-to-physical permutation built once from a layout.  Physical indices
+ * are global LED indices in wire order (segments back to back, each in its own
+ * data direction), so index * bytes_per_pixel addresses a physical frame.
+ */
+typedef struct {
+    uint16_t width;
+    uint16_t height;
+    uint16_t *logical_to_physical; /* [y * width + x] */
+} fw_led_layout_map_t;
+
 void fw_led_layout_load_default(fw_led_layout_config_t *layout);
 uint32_t fw_led_layout_total_leds(const fw_led_layout_config_t *layout);
 esp_err_t fw_led_layout_validate(const fw_led_layout_config_t *layout);
 esp_err_t fw_led_map_logical_xy(const fw_led_layout_config_t *layout, uint16_t x, uint16_t y, fw_led_physical_index_t *out);
 esp_err_t fw_led_map_logical_linear(const fw_led_layout_config_t *layout, uint32_t logical_index, fw_led_physical_index_t *out);
+
+/** Build the permutation table for a valid layout (at most 65536 LEDs). */
+esp_err_t fw_led_layout_map_init(fw_led_layout_map_t *map, const fw_led_layout_config_t *layout);
+void fw_led_layout_map_deinit(fw_led_layout_map_t *map);
@@ -256,6 +256,36 @@ static esp_err_t fw_led_output_wait_pending(fw_led_output_t *driver) {
     return ESP_OK;
 }
 
+// Reads the whole source pixel before writing, so dst may alias src (in-place slot conversion).
+static inline void fw_led_output_encode_pixel(
+    const fw_led_output_t *driver,
+    uint8_t *dst,
+    const uint8_t *src,
+    uint8_t pixel_format,
+    uint8_t bytes_per_pixel
+) {
+    uint8_t r = 0U;
+    uint8_t g = 0U;
+    uint8_t b = 0U;
+    if (pixel_format == 0U && bytes_per_pixel == 3U) {
+        r = src[0];
+        g = src[1];
+        b = src[2];
+    } else {
+        uint8_t w = 0U;
+        fw_led_unpack_pixel(pixel_format, src, &r, &g, &b, &w);
+        if (bytes_per_pixel == 4U && w > 0U) {
+            r = fw_led_saturating_add(r, w);
+            g = fw_led_saturating_add(g, w);
+            b = fw_led_saturating_add(b, w);
+        }
+    }
+
+    dst[0] = driver->gamma_lut[g];
+    dst[1] = driver->gamma_lut[r];
+    dst[2] = driver->gamma_lut[b];
+}
+
 static esp_err_t fw_led_output_prepare_slot_from_frame(
     fw_led_output_t *driver,
     uint8_t slot,
@@ -276,27 +306,7 @@ static esp_err_t fw_led_output_prepare_slot_from_frame(
         while (led_index < segment_led_count) {
             const size_t src_offset = (size_t)(global_led_index + led_index) * bytes_per_pixel;
             const size_t dst_offset = (size_t)led_index * 3U;
-
-            uint8_t r = 0U;
-            uint8_t g = 0U;
-            uint8_t b = 0U;
-            if (pixel_format == 0U && bytes_per_pixel == 3U) {
-                r = frame_buffer[src_offset];
-                g = frame_buffer[src_offset + 1U];
-                b = frame_buffer[src_offset + 2U];
-            } else {
-                uint8_t w = 0U;
-                fw_led_unpack_pixel(pixel_format, frame_buffer + src_offset, &r, &g, &b, &w);
-                if (bytes_per_pixel == 4U && w > 0U) {
-                    r = fw_led_saturating_add(r, w);
-                    g = fw_led_saturating_add(g, w);
-                    b = fw_led_saturating_add(b, w);
-                }
-            }
-
-            segment_buffer[dst_offset + 0U] = driver->gamma_lut[g];
-            segment_buffer[dst_offset + 1U] = driver->gamma_lut[r];
-            segment_buffer[dst_offset + 2U] = driver->gamma_lut[b];
+            fw_led_output_encode_pixel(driver, segment_buffer + dst_offset, frame_buffer + src_offset, pixel_format, bytes_per_pixel);
             led_index += 1U;
         }
 
@@ -306,6 +316,50 @@ static esp_err_t fw_led_output_prepare_slot_from_frame(
     return ESP_OK;
 }
 
+/*
+ * Same as fw_led_output_prepare_slot_from_frame for a frame in logical order:
+ * walk it sequentially and scatter each pixel to its physical LED, so no
+ * intermediate physical-order copy of the frame is needed.
+ */
+static esp_err_t fw_led_output_prepare_slot_remapped(
+    fw_led_output_t *driver,
+    uint8_t slot,
+    const uint8_t *frame_buffer,
+    const uint16_t *logical_to_physical,
+    uint8_t pixel_format,
+    uint8_t bytes_per_pixel
+) {
+    uint32_t segment_start[FW_LED_MAX_SEGMENTS];
+    uint32_t segment_end[FW_LED_MAX_SEGMENTS];
+    uint32_t total_leds = 0U;
+    uint8_t segment = 0U;
+    while (segment < driver->layout.segment_count) {
+        if (driver->segment_buffers[segment][slot] == NULL) {
+            return ESP_ERR_INVALID_STATE;
+        }
+        segment_start[segment] = total_leds;
+        total_leds += driver->layout.segments[segment].led_count;
+        segment_end[segment] = total_leds;
+        segment += 1U;
+    }
+
+    uint32_t logical = 0U;
+    while (logical < total_leds) {
+        const uint32_t physical = logical_to_physical[logical];
+        if (physical >= total_leds) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        segment = 0U;
+        while (physical >= segment_end[segment]) {
+            segment += 1U;
+        }
+        uint8_t *dst = driver->segment_buffers[segment][slot] + (size_t)(physical - segment_start[segment]) * 3U;
+        fw_led_output_encode_pixel(driver, dst, frame_buffer + (size_t)logical * bytes_per_pixel, pixel_format, bytes_per_pixel);
+        logical += 1U;
+    }
+    return ESP_OK;
+}
+
 static esp_err_t fw_led_output_prepare_slot_uniform(
     fw_led_output_t *driver,
     uint8_t slot,
@@ -334,28 +388,28 @@ static esp_err_t fw_led_output_prepare_slot_uniform(
     return ESP_OK;
 }
 
-static esp_err_t fw_led_output_transmit_slot(fw_led_output_t *driver, uint8_t slot) {
+static esp_err_t fw_led_output_transmit_segment(fw_led_output_t *driver, uint8_t segment, const uint8_t *segment_buffer) {
     const rmt_transmit_config_t transmit_config = {
         .loop_count = 0,
         .flags = {0},
     };
 
+    if (driver->channels[segment] == NULL || driver->encoders[segment] == NULL || segment_buffer == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    return rmt_transmit(
+        driver->channels[segment],
+        driver->encoders[segment],
+        segment_buffer,
+        driver->segment_buffer_len[segment],
+        &transmit_config
+    );
+}
+
+static esp_err_t fw_led_output_transmit_slot(fw_led_output_t *driver, uint8_t slot) {
     uint8_t segment = 0U;
     while (segment < driver->layout.segment_count) {
-        if (driver->channels[segment] == NULL || driver->encoders[segment] == NULL) {
-            return ESP_ERR_INVALID_STATE;
-        }
-        const uint8_t *segment_buffer = driver->segment_buffers[segment][slot];
-        if (segment_buffer == NULL) {
-            return ESP_ERR_INVALID_STATE;
-        }
-        esp_err_t tx_err = rmt_transmit(
-            driver->channels[segment],
-            driver->encoders[segment],
-            segment_buffer,
-            driver->segment_buffer_len[segment],
-            &transmit_config
-        );
+        esp_err_t tx_err = fw_led_output_transmit_segment(driver, segment, driver->segment_buffers[segment][slot]);
         if (tx_err != ESP_OK) {
             return tx_err;
         }
@@ -367,6 +421,23 @@ static esp_err_t fw_led_output_transmit_slot(fw_led_output_t *driver, uint8_t sl
     return ESP_OK;
 }
 
+// next_slot is never the one on the wire (that one is waited for before the
+// other is transmitted), so a push fills it while the previous frame still
+// shifts out.  A slot claimed for a zero-copy receive is left alone: the push
+// then waits for the other slot to come off the wire and reuses it.
+static esp_err_t fw_led_output_select_prepare_slot(fw_led_output_t *driver, uint8_t *out_slot) {
+    if (!driver->slot_claimed || driver->claimed_slot != driver->next_slot) {
+        *out_slot = driver->next_slot;
+        return ESP_OK;
+    }
+    esp_err_t wait_err = fw_led_output_wait_pending(driver);
+    if (wait_err != ESP_OK) {
+        return wait_err;
+    }
+    *out_slot = (uint8_t)(driver->next_slot ^ 1U);
+    return ESP_OK;
+}
+
 esp_err_t fw_led_output_init(fw_led_output_t *driver, const fw_led_layout_config_t *layout) {
     if (driver == NULL || layout == NULL) {
         return ESP_ERR_INVALID_ARG;
@@ -489,6 +560,7 @@ esp_err_t fw_led_output_push_frame(
     fw_led_output_t *driver,
     const uint8_t *frame_buffer,
     size_t frame_buffer_len,
+    const uint16_t *logical_to_physical,
     uint8_t pixel_format,
     uint8_t bytes_per_pixel
 ) {
@@ -511,16 +583,21 @@ esp_err_t fw_led_output_push_frame(
         return ESP_ERR_INVALID_SIZE;
     }
 
-    esp_err_t wait_err = fw_led_output_wait_pending(driver);
-    if (wait_err != ESP_OK) {
-        return wait_err;
+    uint8_t slot = 0U;
+    esp_err_t slot_err = fw_led_output_select_prepare_slot(driver, &slot);
+    if (slot_err != ESP_OK) {
+        return slot_err;
     }
-    const uint8_t slot = driver->next_slot;
-
-    esp_err_t prep_err = fw_led_output_prepare_slot_from_frame(driver, slot, frame_buffer, pixel_format, bytes_per_pixel);
+    esp_err_t prep_err = (logical_to_physical != NULL)
+        ? fw_led_output_prepare_slot_remapped(driver, slot, frame_buffer, logical_to_physical, pixel_format, bytes_per_pixel)
+        : fw_led_output_prepare_slot_from_frame(driver, slot, frame_buffer, pixel_format, bytes_per_pixel);
     if (prep_err != ESP_OK) {
         return prep_err;
     }
+    esp_err_t wait_err = fw_led_output_wait_pending(driver);
+    if (wait_err != ESP_OK) {
+        return wait_err;
+    }
     esp_err_t tx_err = fw_led_output_transmit_slot(driver, slot);
     if (tx_err != ESP_OK) {
         return tx_err;
@@ -542,15 +619,114 @@ esp_err_t fw_led_output_push_uniform_rgb(fw_led_output_t *driver, uint8_t r, uin
     const uint8_t corrected_g = driver->gamma_lut[g];
     const uint8_t corrected_b = driver->gamma_lut[b];
 
+    uint8_t slot = 0U;
+    esp_err_t slot_err = fw_led_output_select_prepare_slot(driver, &slot);
+    if (slot_err != ESP_OK) {
+        return slot_err;
+    }
+    esp_err_t prep_err = fw_led_output_prepare_slot_uniform(driver, slot, corrected_r, corrected_g, corrected_b);
+    if (prep_err != ESP_OK) {
+        return prep_err;
+    }
+    esp_err_t wait_err = fw_led_output_wait_pending(driver);
+    if (wait_err != ESP_OK) {
+        return wait_err;
+    }
+    esp_err_t tx_err = fw_led_output_transmit_slot(driver, slot);
+    if (tx_err != ESP_OK) {
+        return tx_err;
+    }
+
+    driver->next_slot = (uint8_t)(slot ^ 1U);
+    return ESP_OK;
+}
+
+esp_err_t fw_led_output_push_wire_frame(fw_led_output_t *driver, const uint8_t *wire_frame, size_t wire_frame_len) {
+    if (driver == NULL || wire_frame == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!driver->initialized) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    const size_t expected_len = (size_t)fw_led_layout_total_leds(&driver->layout) * 3U;
+    if (wire_frame_len < expected_len) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
     esp_err_t wait_err = fw_led_output_wait_pending(driver);
     if (wait_err != ESP_OK) {
         return wait_err;
     }
+
+    size_t offset = 0U;
+    uint8_t segment = 0U;
+    while (segment < driver->layout.segment_count) {
+        esp_err_t tx_err = fw_led_output_transmit_segment(driver, segment, wire_frame + offset);
+        if (tx_err != ESP_OK) {
+            return tx_err;
+        }
+        offset += driver->segment_buffer_len[segment];
+        segment += 1U;
+    }
+    driver->sync_needs_reset = true;
+
+    // RMT reads the caller's buffer while it shifts out, so hand it back only once it is done.
+    return fw_led_output_wait_pending(driver);
+}
+
+esp_err_t fw_led_output_claim_slot(fw_led_output_t *driver, fw_led_output_slot_claim_t *out_claim) {
+    if (driver == NULL || out_claim == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!driver->initialized || driver->slot_claimed) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // next_slot is off the wire between pushes, so it can be written right away.
     const uint8_t slot = driver->next_slot;
+    memset(out_claim, 0, sizeof(*out_claim));
+    out_claim->segment_count = driver->layout.segment_count;
+    uint8_t segment = 0U;
+    while (segment < driver->layout.segment_count) {
+        if (driver->segment_buffers[segment][slot] == NULL) {
+            return ESP_ERR_INVALID_STATE;
+        }
+        out_claim->segments[segment] = driver->segment_buffers[segment][slot];
+        out_claim->segment_len[segment] = driver->segment_buffer_len[segment];
+        segment += 1U;
+    }
 
-    esp_err_t prep_err = fw_led_output_prepare_slot_uniform(driver, slot, corrected_r, corrected_g, corrected_b);
-    if (prep_err != ESP_OK) {
-        return prep_err;
+    driver->claimed_slot = slot;
+    driver->slot_claimed = true;
+    return ESP_OK;
+}
+
+esp_err_t fw_led_output_push_claimed_slot(fw_led_output_t *driver, uint8_t pixel_format) {
+    if (driver == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!driver->initialized || !driver->slot_claimed) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    const uint8_t slot = driver->claimed_slot;
+    driver->slot_claimed = false;
+    uint8_t segment = 0U;
+    while (segment < driver->layout.segment_count) {
+        uint8_t *segment_buffer = driver->segment_buffers[segment][slot];
+        const uint16_t segment_led_count = driver->layout.segments[segment].led_count;
+        uint16_t led_index = 0U;
+        while (led_index < segment_led_count) {
+            uint8_t *pixel = segment_buffer + (size_t)led_index * 3U;
+            fw_led_output_encode_pixel(driver, pixel, pixel, pixel_format, 3U);
+            led_index += 1U;
+        }
+        segment += 1U;
+    }
+
+    esp_err_t wait_err = fw_led_output_wait_pending(driver);
+    if (wait_err != ESP_OK) {
+        return wait_err;
     }
     esp_err_t tx_err = fw_led_output_transmit_slot(driver, slot);
     if (tx_err != ESP_OK) {
@@ -560,3 +736,9 @@ esp_err_t fw_led_output_push_uniform_rgb(fw_led_output_t *driver, uint8_t r, uin
     driver->next_slot = (uint8_t)(slot ^ 1U);
     return ESP_OK;
 }
+
+void fw_led_output_release_slot(fw_led_output_t *driver) {
+    if (driver != NULL) {
+        driver->slot_claimed = false;
+    }
+}
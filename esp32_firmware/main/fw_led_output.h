@@ -18,18 +18,57 @@ typedef struct {
     size_t segment_buffer_len[FW_LED_MAX_SEGMENTS];
     bool slot_in_flight[2];
     uint8_t next_slot;
+    bool slot_claimed;
+    uint8_t claimed_slot;
     bool sync_needs_reset;
     uint16_t gamma_x100;
     uint8_t gamma_lut[256];
 } fw_led_output_t;
 
+/* Segment buffers of a claimed slot, in physical LED order, back to back. */
+typedef struct {
+    uint8_t segment_count;
+    uint8_t *segments[FW_LED_MAX_SEGMENTS];
+    size_t segment_len[FW_LED_MAX_SEGMENTS];
+} fw_led_output_slot_claim_t;
+
 esp_err_t fw_led_output_init(fw_led_output_t *driver, const fw_led_layout_config_t *layout);
 void fw_led_output_deinit(fw_led_output_t *driver);
+
+/**
+ * Convert a frame to gamma-corrected GRB in the next slot and transmit it.
+ * With logical_to_physical (see fw_led_layout_map_t) frame_buffer is in
+ * logical order and each pixel is scattered to its physical LED; NULL means
+ * frame_buffer is already in physical order.
+ */
 esp_err_t fw_led_output_push_frame(
     fw_led_output_t *driver,
     const uint8_t *frame_buffer,
     size_t frame_buffer_len,
+    const uint16_t *logical_to_physical,
     uint8_t pixel_format,
     uint8_t bytes_per_pixel
 );
 esp_err_t fw_led_output_push_uniform_rgb(fw_led_output_t *driver, uint8_t r, uint8_t g, uint8_t b);
+
+/**
+ * Transmit a frame that is already in wire format: gamma-corrected GRB (see
+ * gamma_lut), indexed by global LED index, so the segments lie back to back.
+ * Each segment is sent straight from wire_frame, skipping the slot prepare
+ * pass; the call returns once the transfer is done and wire_frame is free.
+ */
+esp_err_t fw_led_output_push_wire_frame(fw_led_output_t *driver, const uint8_t *wire_frame, size_t wire_frame_len);
+
+/**
+ * Zero-copy receive: claim the next slot so a 3-byte-per-pixel frame in
+ * physical order can be read straight into its segment buffers.  Pushes made
+ * while the claim is held leave the slot alone.  End the claim with
+ * fw_led_output_push_claimed_slot or fw_led_output_release_slot.
+ */
+esp_err_t fw_led_output_claim_slot(fw_led_output_t *driver, fw_led_output_slot_claim_t *out_claim);
+
+/** Convert the claimed slot to gamma-corrected GRB in place and transmit it. */
+esp_err_t fw_led_output_push_claimed_slot(fw_led_output_t *driver, uint8_t pixel_format);
+
+/** Drop a claim without transmitting; a no-op when no slot is claimed. */
+void fw_led_output_release_slot(fw_led_output_t *driver);
@@ -3,6 +3,7 @@
 // dsl_vec2_t, and dsl_shader_entry_t, so we set the header include-guard
 // BEFORE pulling in fw_native_shader.h to avoid duplicate typedefs.
 #include <math.h>
+#include <stdlib.h>
 #include "esp_timer.h"
 #include "esp_log.h"
 #include "fw_fast_math.h"
@@ -47,58 +48,74 @@
 #endif
 
 #include "fw_native_shader.h"
+#include "fw_render_jobs.h"
 
 static const char *BENCH_TAG = "shader_bench";
 
-static inline uint8_t fw_native_channel_to_u8(float value) {
-    if (value <= 0.0f) return 0U;
-    if (value >= 1.0f) return 255U;
-    return (uint8_t)(value * 255.0f + 0.5f);
+typedef struct {
+    const dsl_shader_entry_t *shader;
+    float time_seconds;
+    float frame_counter;
+    int width;
+    int height;
+    float seed;
+    uint8_t *frame_buffer;
+    const uint16_t *phys_index;
+    const uint8_t *grb_gamma;
+} fw_native_band_job_t;
+
+static void fw_native_render_band(void *ctx, uint32_t band_index, uint32_t band_count) {
+    const fw_native_band_job_t *job = (const fw_native_band_job_t *)ctx;
+    job->shader->render_rows(job->time_seconds, job->frame_counter, job->width, job->height, (int)band_index,
+                             (int)band_count, job->seed, job->frame_buffer, job->phys_index, job->grb_gamma);
 }
 
-int __attribute__((flatten)) fw_native_shader_render_frame(
+int fw_native_shader_render_frame(
     const dsl_shader_entry_t *shader,
     float time_seconds,
     float frame_counter,
-    uint16_t width,
-    uint16_t height,
+    const fw_led_layout_map_t *layout_map,
     float seed,
-    int serpentine,
+    const uint8_t *grb_gamma,
     uint8_t *frame_buffer,
     size_t buffer_len
 ) {
-    if (shader == NULL) {
+    if (shader == NULL || shader->render_frame == NULL || layout_map == NULL || layout_map->logical_to_physical == NULL) {
         return -1;
     }
 
     const size_t bytes_per_pixel = 3U;
-    const size_t required = (size_t)width * height * bytes_per_pixel;
+    const size_t required = (size_t)layout_map->width * layout_map->height * bytes_per_pixel;
     if (frame_buffer == 0 || buffer_len < required) {
         return -1;
     }
-
-    const float fw = (float)width;
-    const float fh = (float)height;
-
-    if (shader->has_frame_func && shader->eval_frame != NULL) {
-        shader->eval_frame(time_seconds, frame_counter);
+    const uint16_t *phys_index = layout_map->logical_to_physical;
+
+    // The x/y loops, per-row lets and quantization (plus gamma/GRB for wire
+    // frames) all live in the generated render_frame, so the only indirect
+    // call is this one per frame.
+    if (shader->render_rows == NULL || shader->prepare_frame == NULL || fw_render_jobs_band_count() < 2U) {
+        shader->render_frame(time_seconds, frame_counter, layout_map->width, layout_map->height, seed, frame_buffer,
+                             phys_index, grb_gamma);
+        return 0;
     }
 
-    for (uint16_t y = 0; y < height; y++) {
-        for (uint16_t x = 0; x < width; x++) {
-            dsl_color_t c = {0};
-            shader->eval_pixel(time_seconds, frame_counter, (float)x, (float)y, fw, fh, seed, &c);
-
-            uint16_t mapped_y = y;
-            if (serpentine && ((x & 1U) != 0U)) {
-                mapped_y = (uint16_t)(height - 1U - y);
-            }
-            const size_t offset = ((size_t)x * height + mapped_y) * bytes_per_pixel;
-            frame_buffer[offset]     = fw_native_channel_to_u8(c.r);
-            frame_buffer[offset + 1] = fw_native_channel_to_u8(c.g);
-            frame_buffer[offset + 2] = fw_native_channel_to_u8(c.b);
-        }
-    }
+    // Band-parallel: the uniforms are filled once here, then both cores render
+    // interleaved rows that only read them.  run() returns after both bands
+    // are written, so the caller can push the frame straight away.
+    shader->prepare_frame(time_seconds, frame_counter, (float)layout_map->width, (float)layout_map->height, seed);
+    fw_native_band_job_t job = {
+        .shader = shader,
+        .time_seconds = time_seconds,
+        .frame_counter = frame_counter,
+        .width = layout_map->width,
+        .height = layout_map->height,
+        .seed = seed,
+        .frame_buffer = frame_buffer,
+        .phys_index = phys_index,
+        .grb_gamma = grb_gamma,
+    };
+    fw_render_jobs_run(fw_native_render_band, &job);
     return 0;
 }
 
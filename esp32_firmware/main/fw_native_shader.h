@@ -3,21 +3,29 @@
 #include <stdint.h>
 #include <stddef.h>
 
+#include "fw_led_config.h"
 #include "generated/dsl_shader_registry.h"
 
 /**
- * Render a full frame into an RGB frame buffer using the given shader entry.
- * Keeps the pixel loop in the same translation unit as the generated shaders
- * so the compiler can fully inline eval_pixel via __attribute__((flatten)).
+ * Render a full frame using the given shader entry.
+ * Calls the shader's generated render_frame, which runs the pixel loop itself
+ * (row-invariant lets in the outer loop) and writes through the layout's
+ * logical-to-physical permutation table.
+ * When the fw_render_jobs worker is running, the frame is prepared once and
+ * its rows are split between both cores via render_rows instead; the call
+ * returns only after every band has been written.
+ *
+ * With grb_gamma set, pixels are quantized, gamma-mapped and written as GRB
+ * in one pass, so frame_buffer is a ready wire frame for
+ * fw_led_output_push_wire_frame (segments back to back by global index).
  *
  * @param shader         Shader entry from the registry (must not be NULL).
  * @param time_seconds   Elapsed time since shader start.
  * @param frame_counter  Monotonically increasing frame index.
- * @param width          Grid width (columns).
- * @param height         Grid height (rows).
+ * @param layout_map     Layout permutation table (see fw_led_layout_map_init).
  * @param seed           Per-activation random seed in [0, 1).
- * @param serpentine     Non-zero if odd columns are bottom-to-top.
- * @param frame_buffer   Output buffer (width*height*3 bytes, RGB).
+ * @param grb_gamma      256-entry gamma table for wire output, or NULL for RGB.
+ * @param frame_buffer   Output buffer (width*height*3 bytes).
  * @param buffer_len     Size of frame_buffer in bytes.
  * @return 0 on success, -1 on error.
  */
@@ -25,10 +33,9 @@ int fw_native_shader_render_frame(
     const dsl_shader_entry_t *shader,
     float time_seconds,
     float frame_counter,
-    uint16_t width,
-    uint16_t height,
+    const fw_led_layout_map_t *layout_map,
     float seed,
-    int serpentine,
+    const uint8_t *grb_gamma,
     uint8_t *frame_buffer,
     size_t buffer_len
 );
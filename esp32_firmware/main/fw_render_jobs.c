@@ -0,0 +1,214 @@
+#include "fw_render_jobs.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#if defined(ESP_PLATFORM)
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#elif !defined(_WIN32)
+#include <pthread.h>
+#define FW_RENDER_JOBS_PTHREAD 1
+#endif
+
+/* Stack for the worker task: it only runs generated render_rows bodies. */
+#define FW_RENDER_JOBS_STACK_SIZE 6144U
+/* Same priority as the shader task on the other core; WiFi and audio still preempt it. */
+#define FW_RENDER_JOBS_PRIORITY 4U
+
+typedef struct {
+    bool running;
+    bool stopping;
+    fw_render_band_fn_t fn;
+    void *ctx;
+#if defined(ESP_PLATFORM)
+    TaskHandle_t task;
+    SemaphoreHandle_t start_sem;
+    SemaphoreHandle_t done_sem;
+#elif defined(FW_RENDER_JOBS_PTHREAD)
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint32_t start_seq; /* bumped by run() to hand the worker the next frame */
+    uint32_t done_seq;  /* set to start_seq by the worker once its band is written */
+#endif
+} fw_render_jobs_state_t;
+
+static fw_render_jobs_state_t s_jobs;
+
+#if defined(ESP_PLATFORM)
+
+static void fw_render_jobs_task(void *arg) {
+    (void)arg;
+    for (;;) {
+        xSemaphoreTake(s_jobs.start_sem, portMAX_DELAY);
+        if (s_jobs.stopping) {
+            break;
+        }
+        s_jobs.fn(s_jobs.ctx, 1U, FW_RENDER_JOBS_MAX_BANDS);
+        xSemaphoreGive(s_jobs.done_sem);
+    }
+    xSemaphoreGive(s_jobs.done_sem);
+    vTaskDelete(NULL);
+}
+
+int fw_render_jobs_start(int core) {
+    if (s_jobs.running) {
+        return 0;
+    }
+    s_jobs.stopping = false;
+    s_jobs.start_sem = xSemaphoreCreateBinary();
+    s_jobs.done_sem = xSemaphoreCreateBinary();
+    if (s_jobs.start_sem == NULL || s_jobs.done_sem == NULL) {
+        goto fail;
+    }
+    if (xTaskCreatePinnedToCore(fw_render_jobs_task, "fw_render_job", FW_RENDER_JOBS_STACK_SIZE, NULL,
+                                FW_RENDER_JOBS_PRIORITY, &s_jobs.task, core) != pdPASS) {
+        goto fail;
+    }
+    s_jobs.running = true;
+    return 0;
+
+fail:
+    if (s_jobs.start_sem != NULL) {
+        vSemaphoreDelete(s_jobs.start_sem);
+    }
+    if (s_jobs.done_sem != NULL) {
+        vSemaphoreDelete(s_jobs.done_sem);
+    }
+    s_jobs.start_sem = NULL;
+    s_jobs.done_sem = NULL;
+    return -1;
+}
+
+void fw_render_jobs_stop(void) {
+    if (!s_jobs.running) {
+        return;
+    }
+    s_jobs.stopping = true;
+    xSemaphoreGive(s_jobs.start_sem);
+    xSemaphoreTake(s_jobs.done_sem, portMAX_DELAY);
+    vSemaphoreDelete(s_jobs.start_sem);
+    vSemaphoreDelete(s_jobs.done_sem);
+    s_jobs.start_sem = NULL;
+    s_jobs.done_sem = NULL;
+    s_jobs.task = NULL;
+    s_jobs.running = false;
+}
+
+static void fw_render_jobs_dispatch(void) {
+    xSemaphoreGive(s_jobs.start_sem);
+    s_jobs.fn(s_jobs.ctx, 0U, FW_RENDER_JOBS_MAX_BANDS);
+    xSemaphoreTake(s_jobs.done_sem, portMAX_DELAY);
+}
+
+#elif defined(FW_RENDER_JOBS_PTHREAD)
+
+static void *fw_render_jobs_thread(void *arg) {
+    (void)arg;
+    uint32_t seen_seq = 0U;
+    pthread_mutex_lock(&s_jobs.lock);
+    for (;;) {
+        while (!s_jobs.stopping && s_jobs.start_seq == seen_seq) {
+            pthread_cond_wait(&s_jobs.cond, &s_jobs.lock);
+        }
+        if (s_jobs.stopping) {
+            break;
+        }
+        seen_seq = s_jobs.start_seq;
+        pthread_mutex_unlock(&s_jobs.lock);
+
+        s_jobs.fn(s_jobs.ctx, 1U, FW_RENDER_JOBS_MAX_BANDS);
+
+        pthread_mutex_lock(&s_jobs.lock);
+        s_jobs.done_seq = seen_seq;
+        pthread_cond_broadcast(&s_jobs.cond);
+    }
+    pthread_mutex_unlock(&s_jobs.lock);
+    return NULL;
+}
+
+int fw_render_jobs_start(int core) {
+    (void)core;
+    if (s_jobs.running) {
+        return 0;
+    }
+    if (pthread_mutex_init(&s_jobs.lock, NULL) != 0) {
+        return -1;
+    }
+    if (pthread_cond_init(&s_jobs.cond, NULL) != 0) {
+        pthread_mutex_destroy(&s_jobs.lock);
+        return -1;
+    }
+    s_jobs.stopping = false;
+    s_jobs.start_seq = 0U;
+    s_jobs.done_seq = 0U;
+    if (pthread_create(&s_jobs.thread, NULL, fw_render_jobs_thread, NULL) != 0) {
+        pthread_cond_destroy(&s_jobs.cond);
+        pthread_mutex_destroy(&s_jobs.lock);
+        return -1;
+    }
+    s_jobs.running = true;
+    return 0;
+}
+
+void fw_render_jobs_stop(void) {
+    if (!s_jobs.running) {
+        return;
+    }
+    pthread_mutex_lock(&s_jobs.lock);
+    s_jobs.stopping = true;
+    pthread_cond_broadcast(&s_jobs.cond);
+    pthread_mutex_unlock(&s_jobs.lock);
+    pthread_join(s_jobs.thread, NULL);
+    pthread_cond_destroy(&s_jobs.cond);
+    pthread_mutex_destroy(&s_jobs.lock);
+    s_jobs.running = false;
+}
+
+static void fw_render_jobs_dispatch(void) {
+    pthread_mutex_lock(&s_jobs.lock);
+    const uint32_t seq = s_jobs.start_seq + 1U;
+    s_jobs.start_seq = seq;
+    pthread_cond_broadcast(&s_jobs.cond);
+    pthread_mutex_unlock(&s_jobs.lock);
+
+    s_jobs.fn(s_jobs.ctx, 0U, FW_RENDER_JOBS_MAX_BANDS);
+
+    pthread_mutex_lock(&s_jobs.lock);
+    while (s_jobs.done_seq != seq) {
+        pthread_cond_wait(&s_jobs.cond, &s_jobs.lock);
+    }
+    pthread_mutex_unlock(&s_jobs.lock);
+}
+
+#else
+
+int fw_render_jobs_start(int core) {
+    (void)core;
+    return -1;
+}
+
+void fw_render_jobs_stop(void) {}
+
+static void fw_render_jobs_dispatch(void) {}
+
+#endif
+
+uint32_t fw_render_jobs_band_count(void) {
+    return s_jobs.running ? FW_RENDER_JOBS_MAX_BANDS : 1U;
+}
+
+void fw_render_jobs_run(fw_render_band_fn_t fn, void *ctx) {
+    if (fn == NULL) {
+        return;
+    }
+    if (!s_jobs.running) {
+        fn(ctx, 0U, 1U);
+        return;
+    }
+    s_jobs.fn = fn;
+    s_jobs.ctx = ctx;
+    fw_render_jobs_dispatch();
+}
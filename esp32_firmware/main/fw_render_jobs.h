@@ -0,0 +1,52 @@
+#pragma once
+
+#include <stdint.h>
+
+/*
+ * Band-parallel frame rendering.
+ *
+ * A frame is split into bands of interleaved rows (band i renders rows
+ * i, i + band_count, ...), so work stays balanced when a shader's content is
+ * concentrated in one part of the pillar.  Band 0 runs on the calling thread
+ * and band 1 on a persistent worker; fw_render_jobs_run() returns only after
+ * both have finished, so the frame buffer is complete when it is pushed.
+ *
+ * On ESP32 the worker is a FreeRTOS task pinned to the other core.  On hosts
+ * it is a pthread, so the split and the barrier can be tested and benchmarked
+ * off-target; without pthreads every band runs on the caller.
+ */
+
+/* Upper bound on fw_render_jobs_band_count(): the calling core plus one worker. */
+#define FW_RENDER_JOBS_MAX_BANDS 2U
+
+/**
+ * Render band `band_index` of `band_count`.  Must only write pixels owned by
+ * that band and must not depend on the other bands' output.
+ */
+typedef void (*fw_render_band_fn_t)(void *ctx, uint32_t band_index, uint32_t band_count);
+
+/**
+ * Start the persistent band worker.  Calling it again while the worker runs
+ * is a no-op.
+ *
+ * @param core  Core to pin the worker to on ESP32; ignored on hosts.
+ * @return 0 on success, -1 if the worker could not be created (frames are
+ *         then rendered as a single band on the calling thread).
+ */
+int fw_render_jobs_start(int core);
+
+/**
+ * Stop the worker and wait for it to exit.  Must not be called while
+ * fw_render_jobs_run() is in progress.
+ */
+void fw_render_jobs_stop(void);
+
+/** Number of bands fw_render_jobs_run() splits a frame into (1 without a worker). */
+uint32_t fw_render_jobs_band_count(void);
+
+/**
+ * Render one frame: call `fn` once per band, band 0 on the calling thread and
+ * the rest on the worker, and return when every band is done.  Only one
+ * thread may call this at a time.
+ */
+void fw_render_jobs_run(fw_render_band_fn_t fn, void *ctx);
@@ -9,6 +9,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/select.h>
 #include <sys/socket.h>
 #include <unistd.h>
 
@@ -27,8 +28,10 @@
 #include "sdkconfig.h"
 
 #include "fw_bytecode_vm.h"
+#include "fw_frame_codec.h"
 #include "fw_led_output.h"
 #include "fw_native_shader.h"
+#include "fw_render_jobs.h"
 #include "fw_audio_output.h"
 
 #ifdef CONFIG_FW_V12_REMAP_LOGICAL
@@ -37,12 +40,27 @@
 #define FW_V12_REMAP_LOGICAL false
 #endif
 
+#ifdef CONFIG_FW_UDP_STREAM_ENABLED
+#define FW_UDP_STREAM_ENABLED true
+#define FW_UDP_JITTER_SLOTS CONFIG_FW_UDP_JITTER_SLOTS
+#define FW_UDP_JITTER_DELAY_MS CONFIG_FW_UDP_JITTER_DELAY_MS
+#else
+#define FW_UDP_STREAM_ENABLED false
+#define FW_UDP_JITTER_SLOTS 3
+#define FW_UDP_JITTER_DELAY_MS 30
+#endif
+/* Holds one datagram on the stack. */
+#define FW_UDP_STREAM_TASK_STACK 6144U
+#define FW_UDP_STREAM_IDLE_WAIT_US 1000000LL
+#define FW_UDP_STREAM_STATS_INTERVAL_US 10000000LL
+
 #define FW_TCP_HEADER_LEN 10U
 #define FW_TCP_ACK_BYTE 0x06U
 
 #define FW_TCP_PROTOCOL_V1 0x01U
 #define FW_TCP_PROTOCOL_V2 0x02U
 #define FW_TCP_PROTOCOL_V3 0x03U
+#define FW_TCP_PROTOCOL_V4 0x04U
 
 #define FW_TCP_MAX_BYTES_PER_PIXEL 4U
 #define FW_TCP_MAX_BYTECODE_BLOB (64U * 1024U)
@@ -55,8 +73,26 @@
 #define FW_TCP_V3_CMD_UPLOAD_FIRMWARE 0x06U
 #define FW_TCP_V3_CMD_ACTIVATE_NATIVE_SHADER 0x07U
 #define FW_TCP_V3_CMD_STOP_SHADER 0x08U
+#define FW_TCP_V3_CMD_SET_PARAMS 0x09U
 #define FW_TCP_V3_RESPONSE_FLAG 0x80U
 
+// v4 windowed streaming: header bytes 5..8 carry a big-endian value, byte 9 the message type.
+#define FW_TCP_V4_MSG_HELLO 0x01U
+#define FW_TCP_V4_MSG_FRAME 0x02U
+#define FW_TCP_V4_MSG_TIME_REQUEST 0x03U
+#define FW_TCP_V4_MSG_HELLO_REPLY 0x81U
+#define FW_TCP_V4_MSG_ACK 0x82U
+#define FW_TCP_V4_MSG_TIME_REPLY 0x83U
+#define FW_TCP_V4_HELLO_PAYLOAD_LEN 5U
+#define FW_TCP_V4_MAX_WINDOW 8U
+// Time reply payload: u64 BE receive and send time of the request on esp_timer (us since boot).
+#define FW_TCP_V4_TIME_REPLY_PAYLOAD_LEN 16U
+// Hello pixel format flag: every frame payload starts with a u64 BE presentation deadline on esp_timer.
+#define FW_TCP_V4_PRESENT_FLAG 0x40U
+#define FW_TCP_V4_PRESENT_PREFIX_LEN 8U
+// A deadline further out than this comes from a stale clock mapping; the frame is shown after this long.
+#define FW_TCP_V4_MAX_PRESENT_HOLD_US 1000000LL
+
 #define FW_TCP_V3_STATUS_OK 0U
 #define FW_TCP_V3_STATUS_INVALID_ARG 1U
 #define FW_TCP_V3_STATUS_UNSUPPORTED_CMD 2U
@@ -69,6 +105,12 @@
 #define FW_TCP_NVS_NAMESPACE "fw_shader"
 #define FW_TCP_NVS_KEY_DEFAULT_SHADER "default_bc3"
 #define FW_TCP_V3_STATUS_PAYLOAD_LEN 20U
+// SET_PARAMS entries: a selector byte (param index, or FW_TCP_V3_PARAM_BY_NAME followed by a u8 name
+// length and the name), then the value as a big-endian IEEE-754 float.
+#define FW_TCP_V3_PARAM_BY_NAME 0xFFU
+#define FW_TCP_V3_PARAM_VALUE_LEN 4U
+// ACTIVATE_SHADER may carry a u16 BE crossfade duration in ms for swapping out a running bytecode shader.
+#define FW_TCP_V3_ACTIVATE_CROSSFADE_LEN 2U
 #define FW_STARTUP_RGB_STEP_MS 500U
 #define FW_STARTUP_WHITE_MS 1000U
 #define FW_SHADER_FRAME_INTERVAL_MS 25U
@@ -109,6 +151,37 @@ fw_tcp_server_state_t *fw_tcp_server_get_state(void) {
     return &g_fw_tcp_server;
 }
 
+esp_err_t fw_tcp_server_flush_output_locked(fw_tcp_server_state_t *state) {
+    if (state == NULL || state->frame_pipeline == NULL) {
+        return ESP_OK;
+    }
+    return (esp_err_t)fw_frame_pipeline_flush(state->frame_pipeline);
+}
+
+/* Output stage of the frame pipeline.  Runs on its own task without state_lock;
+ * everything else flushes the pipeline before touching led_output. */
+static int fw_tcp_pipeline_output(void *ctx, const uint8_t *frame, size_t frame_len) {
+    fw_tcp_server_state_t *state = (fw_tcp_server_state_t *)ctx;
+    return (int)fw_led_output_push_wire_frame(&state->led_output, frame, frame_len);
+}
+
+/* Wire frame (gamma-corrected GRB, global LED order) a shader renders into:
+ * the next pipeline buffer, or frame_buffer when the pipeline could not be created. */
+static uint8_t *fw_tcp_shader_frame_acquire_locked(fw_tcp_server_state_t *state) {
+    if (state->frame_pipeline != NULL) {
+        return fw_frame_pipeline_acquire(state->frame_pipeline);
+    }
+    return state->frame_buffer;
+}
+
+/* Queue the acquired frame for output; returns an earlier output error, if any. */
+static esp_err_t fw_tcp_shader_frame_submit_locked(fw_tcp_server_state_t *state, const uint8_t *frame, size_t frame_len) {
+    if (state->frame_pipeline != NULL) {
+        return (esp_err_t)fw_frame_pipeline_submit(state->frame_pipeline);
+    }
+    return fw_led_output_push_wire_frame(&state->led_output, frame, frame_len);
+}
+
 static uint32_t fw_tcp_read_be_u32(const uint8_t *bytes) {
     return ((uint32_t)bytes[0] << 24U) | ((uint32_t)bytes[1] << 16U) | ((uint32_t)bytes[2] << 8U) | (uint32_t)bytes[3];
 }
@@ -120,6 +193,33 @@ static void fw_tcp_write_be_u32(uint8_t *bytes, uint32_t value) {
     bytes[3] = (uint8_t)(value & 0xffU);
 }
 
+static uint64_t fw_tcp_read_be_u64(const uint8_t *bytes) {
+    return ((uint64_t)fw_tcp_read_be_u32(bytes) << 32U) | (uint64_t)fw_tcp_read_be_u32(&bytes[4]);
+}
+
+static void fw_tcp_write_be_u64(uint8_t *bytes, uint64_t value) {
+    fw_tcp_write_be_u32(bytes, (uint32_t)(value >> 32U));
+    fw_tcp_write_be_u32(&bytes[4], (uint32_t)(value & 0xffffffffU));
+}
+
+/* Microsecond-precision absolute deadline wait.  FreeRTOS vTaskDelayUntil uses ticks (default 10 ms),
+ * giving only 33 or 50 FPS instead of the 40 FPS target.  We sleep via vTaskDelay for coarse alignment
+ * then spin-yield for the remainder. */
+static void fw_tcp_wait_until(int64_t deadline_us) {
+    const int64_t sleep_us = deadline_us - esp_timer_get_time();
+    if (sleep_us > 2000) {
+        TickType_t delay_ticks = pdMS_TO_TICKS((sleep_us - 1000) / 1000);
+        if (delay_ticks < 1) delay_ticks = 1;
+        vTaskDelay(delay_ticks);
+    } else if (sleep_us <= 0) {
+        taskYIELD();
+    }
+    /* Spin for sub-tick precision (typically < 1 ms). */
+    while (esp_timer_get_time() < deadline_us) {
+        taskYIELD();
+    }
+}
+
 static bool fw_tcp_recv_exact(int sock, uint8_t *buffer, size_t len) {
     size_t read_total = 0;
     while (read_total < len) {
@@ -188,50 +288,6 @@ static bool fw_tcp_pixel_format_bytes(uint8_t pixel_format, uint8_t *out_bytes_p
     }
 }
 
-static esp_err_t fw_tcp_blit_frame(fw_tcp_server_state_t *state, uint8_t bytes_per_pixel, const uint8_t *payload, size_t payload_len) {
-    if (state == NULL || payload == NULL || bytes_per_pixel == 0U) {
-        return ESP_ERR_INVALID_ARG;
-    }
-
-    if (state->led_count > (UINT32_MAX / bytes_per_pixel)) {
-        return ESP_ERR_INVALID_SIZE;
-    }
-
-    const size_t expected_len = (size_t)state->led_count * bytes_per_pixel;
-    if (payload_len != expected_len || payload_len > state->frame_buffer_len) {
-        return ESP_ERR_INVALID_SIZE;
-    }
-
-    if (!FW_V12_REMAP_LOGICAL) {
-        memcpy(state->frame_buffer, payload, expected_len);
-        return ESP_OK;
-    }
-
-    uint32_t logical_index = 0U;
-    for (uint16_t y = 0; y < state->layout.height; y += 1U) {
-        for (uint16_t x = 0; x < state->layout.width; x += 1U) {
-            uint16_t mapped_y = y;
-            if (state->layout.serpentine_columns && ((x & 1U) != 0U)) {
-                mapped_y = (uint16_t)(state->layout.height - 1U - y);
-            }
-            const uint32_t physical_index = ((uint32_t)x * (uint32_t)state->layout.height) + mapped_y;
-            if (physical_index >= state->led_count) {
-                return ESP_ERR_INVALID_SIZE;
-            }
-
-            const size_t src_offset = (size_t)logical_index * bytes_per_pixel;
-            const size_t dst_offset = (size_t)physical_index * bytes_per_pixel;
-            if (dst_offset + bytes_per_pixel > state->frame_buffer_len) {
-                return ESP_ERR_INVALID_SIZE;
-            }
-            memcpy(state->frame_buffer + dst_offset, payload + src_offset, bytes_per_pixel);
-            logical_index += 1U;
-        }
-    }
-
-    return ESP_OK;
-}
-
 static bool fw_tcp_send_v3_response(int sock, uint8_t response_type, uint8_t status, const uint8_t *payload, size_t payload_len) {
     if (payload_len > UINT32_MAX - 1U) {
         return false;
@@ -256,24 +312,15 @@ static bool fw_tcp_send_v3_response(int sock, uint8_t response_type, uint8_t sta
 }
 
 static esp_err_t fw_tcp_show_startup_color(fw_tcp_server_state_t *state, uint8_t r, uint8_t g, uint8_t b, uint32_t hold_ms) {
-    if (state == NULL || state->frame_buffer == NULL) {
+    if (state == NULL) {
         return ESP_ERR_INVALID_ARG;
     }
 
-    const size_t bytes_per_pixel = 3U;
-    const size_t required_len = (size_t)state->led_count * bytes_per_pixel;
-    if (required_len > state->frame_buffer_len) {
-        return ESP_ERR_INVALID_SIZE;
-    }
-
-    for (uint32_t i = 0; i < state->led_count; i += 1U) {
-        const size_t offset = (size_t)i * bytes_per_pixel;
-        state->frame_buffer[offset] = r;
-        state->frame_buffer[offset + 1U] = g;
-        state->frame_buffer[offset + 2U] = b;
+    esp_err_t err = fw_tcp_server_flush_output_locked(state);
+    if (err != ESP_OK) {
+        return err;
     }
-
-    esp_err_t err = fw_led_output_push_frame(&state->led_output, state->frame_buffer, required_len, 0U, (uint8_t)bytes_per_pixel);
+    err = fw_led_output_push_uniform_rgb(&state->led_output, r, g, b);
     if (err != ESP_OK) {
         return err;
     }
@@ -323,28 +370,25 @@ static esp_err_t fw_tcp_render_native_shader_frame_locked(fw_tcp_server_state_t
 
     const size_t bytes_per_pixel = 3U;
     const size_t required_len = (size_t)state->led_count * bytes_per_pixel;
-    if (required_len > state->frame_buffer_len) {
-        return ESP_ERR_INVALID_SIZE;
-    }
-
     state->uniform_last_color_valid = false;
 
     const int64_t display_start_us = esp_timer_get_time();
+    uint8_t *frame = fw_tcp_shader_frame_acquire_locked(state);
     int rc = fw_native_shader_render_frame(
         state->active_native_shader,
         time_seconds,
         (float)frame_counter,
-        state->layout.width,
-        state->layout.height,
+        &state->layout_map,
         state->native_shader_seed,
-        state->layout.serpentine_columns ? 1 : 0,
-        state->frame_buffer,
-        state->frame_buffer_len
+        state->led_output.gamma_lut,
+        frame,
+        required_len
     );
     if (rc != 0) {
         return ESP_FAIL;
     }
-    esp_err_t push_err = fw_led_output_push_frame(&state->led_output, state->frame_buffer, required_len, 0U, (uint8_t)bytes_per_pixel);
+    /* Returns once the frame is queued; the RMT transmit overlaps the next render. */
+    esp_err_t push_err = fw_tcp_shader_frame_submit_locked(state, frame, required_len);
     const float display_us = (float)(esp_timer_get_time() - display_start_us);
     state->render_time_display_us = state->render_time_display_us * 0.9f + display_us * 0.1f;
 
@@ -409,10 +453,32 @@ static esp_err_t fw_tcp_render_native_shader_frame_locked(fw_tcp_server_state_t
     return push_err;
 }
 
+static void fw_tcp_free_program_arena(fw_tcp_program_slot_t *slot) {
+    free(slot->arena);
+    free(slot->runtime_arena);
+    slot->arena = NULL;
+    slot->runtime_arena = NULL;
+    slot->runtime_arena_len = 0U;
+}
+
+/* Free everything a program slot holds; it is allocated again by the next load into it. */
+static void fw_tcp_release_program_slot(fw_tcp_program_slot_t *slot) {
+    fw_tcp_free_program_arena(slot);
+    free(slot->program);
+    free(slot->runtime);
+    slot->program = NULL;
+    slot->runtime = NULL;
+}
+
 static esp_err_t fw_tcp_render_shader_frame_locked(fw_tcp_server_state_t *state, float time_seconds, uint32_t frame_counter) {
     if (state == NULL || !state->shader_active) {
         return ESP_ERR_INVALID_STATE;
     }
+    /* The last crossfade frame has been rendered, so nothing reads the replaced program any more. */
+    if (state->crossfade_frames_total > 0U && state->crossfade_frames_left == 0U) {
+        fw_tcp_release_program_slot(&state->program_slots[state->active_program_slot ^ 1U]);
+        state->crossfade_frames_total = 0U;
+    }
     if (state->shader_source == FW_TCP_SHADER_SOURCE_NATIVE) {
         return fw_tcp_render_native_shader_frame_locked(state, time_seconds, frame_counter);
     }
@@ -420,22 +486,34 @@ static esp_err_t fw_tcp_render_shader_frame_locked(fw_tcp_server_state_t *state,
         return ESP_ERR_INVALID_STATE;
     }
 
-    fw_bc3_status_t vm_status = fw_bc3_runtime_begin_frame(&state->runtime, time_seconds, frame_counter);
+    fw_bc3_runtime_t *runtime = state->program_slots[state->active_program_slot].runtime;
+    fw_bc3_status_t vm_status = fw_bc3_runtime_begin_frame(runtime, time_seconds, frame_counter);
     if (vm_status != FW_BC3_OK) {
         ESP_LOGW(TAG, "shader begin_frame failed: %s", fw_bc3_status_to_string(vm_status));
         return ESP_FAIL;
     }
 
+    /* During a crossfade the replaced program renders too and fades out over crossfade_frames_total frames;
+     * it is dropped as soon as it fails. */
+    fw_bc3_runtime_t *fade_runtime = NULL;
+    float fade_mix = 1.0f;
+    if (state->crossfade_frames_left > 0U) {
+        fade_runtime = state->program_slots[state->active_program_slot ^ 1U].runtime;
+        fade_mix = 1.0f - (float)state->crossfade_frames_left / (float)state->crossfade_frames_total;
+        state->crossfade_frames_left -= 1U;
+        if (fw_bc3_runtime_begin_frame(fade_runtime, time_seconds, frame_counter) != FW_BC3_OK) {
+            fade_runtime = NULL;
+            state->crossfade_frames_left = 0U;
+        }
+    }
+
     const int64_t bc_render_start = esp_timer_get_time();
     const size_t bytes_per_pixel = 3U;
     const size_t required_len = (size_t)state->led_count * bytes_per_pixel;
-    if (required_len > state->frame_buffer_len) {
-        return ESP_ERR_INVALID_SIZE;
-    }
 
-    if (state->runtime.program != NULL && state->runtime.program->pixel_depends_xy == 0U) {
+    if (fade_runtime == NULL && runtime->program != NULL && runtime->program->pixel_depends_xy == 0U) {
         fw_bc3_color_t color = {0};
-        vm_status = fw_bc3_runtime_eval_pixel(&state->runtime, 0.0f, 0.0f, &color);
+        vm_status = fw_bc3_runtime_eval_pixel(runtime, 0.0f, 0.0f, &color);
         if (vm_status != FW_BC3_OK) {
             ESP_LOGW(TAG, "shader eval_pixel failed: %s", fw_bc3_status_to_string(vm_status));
             return ESP_FAIL;
@@ -444,7 +522,10 @@ static esp_err_t fw_tcp_render_shader_frame_locked(fw_tcp_server_state_t *state,
         const uint8_t r = fw_tcp_channel_to_u8(color.r);
         const uint8_t g = fw_tcp_channel_to_u8(color.g);
         const uint8_t b = fw_tcp_channel_to_u8(color.b);
-        esp_err_t push_err = fw_led_output_push_uniform_rgb(&state->led_output, r, g, b);
+        esp_err_t push_err = fw_tcp_server_flush_output_locked(state);
+        if (push_err == ESP_OK) {
+            push_err = fw_led_output_push_uniform_rgb(&state->led_output, r, g, b);
+        }
         if (push_err == ESP_OK) {
             state->uniform_last_color_valid = true;
             state->uniform_last_r = r;
@@ -466,36 +547,49 @@ static esp_err_t fw_tcp_render_shader_frame_locked(fw_tcp_server_state_t *state,
     state->uniform_last_color_valid = false;
 
     const int64_t vm_render_start = esp_timer_get_time();
+    uint8_t *frame = fw_tcp_shader_frame_acquire_locked(state);
+    const uint8_t *grb_gamma = state->led_output.gamma_lut;
+    const uint16_t *logical_to_physical = state->layout_map.logical_to_physical;
     uint32_t logical_index = 0U;
+    fw_bc3_color_t row_colors[FW_BC3_ROW_LANES];
+    fw_bc3_color_t fade_colors[FW_BC3_ROW_LANES];
     for (uint16_t y = 0; y < state->layout.height; y += 1U) {
-        for (uint16_t x = 0; x < state->layout.width; x += 1U) {
-            fw_bc3_color_t color = {0};
-            vm_status = fw_bc3_runtime_eval_pixel(&state->runtime, (float)x, (float)y, &color);
+        for (uint16_t x0 = 0; x0 < state->layout.width; x0 = (uint16_t)(x0 + FW_BC3_ROW_LANES)) {
+            const uint16_t remaining = (uint16_t)(state->layout.width - x0);
+            const uint16_t chunk = (remaining > FW_BC3_ROW_LANES) ? (uint16_t)FW_BC3_ROW_LANES : remaining;
+            vm_status = fw_bc3_runtime_eval_row(runtime, (float)y, x0, chunk, row_colors);
             if (vm_status != FW_BC3_OK) {
-                ESP_LOGW(TAG, "shader eval_pixel failed: %s", fw_bc3_status_to_string(vm_status));
+                ESP_LOGW(TAG, "shader eval_row failed: %s", fw_bc3_status_to_string(vm_status));
                 return ESP_FAIL;
             }
-            if (logical_index >= state->led_count) {
-                return ESP_ERR_INVALID_SIZE;
+            if (fade_runtime != NULL) {
+                if (fw_bc3_runtime_eval_row(fade_runtime, (float)y, x0, chunk, fade_colors) != FW_BC3_OK) {
+                    fade_runtime = NULL;
+                    state->crossfade_frames_left = 0U;
+                } else {
+                    for (uint16_t lane = 0; lane < chunk; lane += 1U) {
+                        row_colors[lane].r = fade_colors[lane].r + (row_colors[lane].r - fade_colors[lane].r) * fade_mix;
+                        row_colors[lane].g = fade_colors[lane].g + (row_colors[lane].g - fade_colors[lane].g) * fade_mix;
+                        row_colors[lane].b = fade_colors[lane].b + (row_colors[lane].b - fade_colors[lane].b) * fade_mix;
+                    }
+                }
             }
 
-            uint16_t mapped_y = y;
-            if (state->layout.serpentine_columns && ((x & 1U) != 0U)) {
-                mapped_y = (uint16_t)(state->layout.height - 1U - y);
-            }
-            const uint32_t physical_index = ((uint32_t)x * (uint32_t)state->layout.height) + mapped_y;
-            if (physical_index >= state->led_count) {
-                return ESP_ERR_INVALID_SIZE;
-            }
+            for (uint16_t lane = 0; lane < chunk; lane += 1U) {
+                const fw_bc3_color_t color = row_colors[lane];
+                if (logical_index >= state->led_count) {
+                    return ESP_ERR_INVALID_SIZE;
+                }
 
-            const size_t offset = (size_t)physical_index * bytes_per_pixel;
-            if (offset + bytes_per_pixel > state->frame_buffer_len) {
-                return ESP_ERR_INVALID_SIZE;
+                const size_t offset = (size_t)logical_to_physical[logical_index] * bytes_per_pixel;
+                if (offset + bytes_per_pixel > required_len) {
+                    return ESP_ERR_INVALID_SIZE;
+                }
+                frame[offset] = grb_gamma[fw_tcp_channel_to_u8(color.g)];
+                frame[offset + 1U] = grb_gamma[fw_tcp_channel_to_u8(color.r)];
+                frame[offset + 2U] = grb_gamma[fw_tcp_channel_to_u8(color.b)];
+                logical_index += 1U;
             }
-            state->frame_buffer[offset] = fw_tcp_channel_to_u8(color.r);
-            state->frame_buffer[offset + 1U] = fw_tcp_channel_to_u8(color.g);
-            state->frame_buffer[offset + 2U] = fw_tcp_channel_to_u8(color.b);
-            logical_index += 1U;
         }
     }
 
@@ -509,7 +603,7 @@ static esp_err_t fw_tcp_render_shader_frame_locked(fw_tcp_server_state_t *state,
                  (long long)(vm_compute_us / 1200));
     }
 
-    esp_err_t push_err = fw_led_output_push_frame(&state->led_output, state->frame_buffer, required_len, 0U, (uint8_t)bytes_per_pixel);
+    esp_err_t push_err = fw_tcp_shader_frame_submit_locked(state, frame, required_len);
     const float bc_total_us = (float)(esp_timer_get_time() - bc_render_start);
     state->render_time_display_us = state->render_time_display_us * 0.9f + bc_total_us * 0.1f;
     const int64_t audio_start_us = esp_timer_get_time();
@@ -613,26 +707,8 @@ static void fw_tcp_shader_task(void *arg) {
             xSemaphoreGive(state->state_lock);
         }
         esp_task_wdt_reset();
-        /* Microsecond-precision absolute deadline timing.  FreeRTOS
-         * vTaskDelayUntil uses ticks (default 10 ms), giving only 33 or
-         * 50 FPS instead of the 40 FPS target.  We sleep via vTaskDelay
-         * for coarse alignment then spin-yield for the remainder. */
-        {
-            int64_t now_us = esp_timer_get_time();
-            int64_t sleep_us = next_deadline_us - now_us;
-            if (sleep_us > 2000) {
-                TickType_t delay_ticks = pdMS_TO_TICKS((sleep_us - 1000) / 1000);
-                if (delay_ticks < 1) delay_ticks = 1;
-                vTaskDelay(delay_ticks);
-            } else if (sleep_us <= 0) {
-                taskYIELD();
-            }
-            /* Spin for sub-tick precision (typically < 1 ms). */
-            while (esp_timer_get_time() < next_deadline_us) {
-                taskYIELD();
-            }
-            next_deadline_us += frame_interval_us;
-        }
+        fw_tcp_wait_until(next_deadline_us);
+        next_deadline_us += frame_interval_us;
     }
 }
 
@@ -677,6 +753,69 @@ static esp_err_t fw_tcp_persist_default_shader(const fw_tcp_server_state_t *stat
     return err;
 }
 
+/* Decode `blob` into a slot the render task is not reading. The slot's program and runtime are allocated
+ * on first use and its arena is replaced with one sized by the VM's counting pass, then trimmed to what
+ * the program uses; the runtime arena is then sized from the decoded program. A failed load leaves the
+ * slot released. */
+static fw_bc3_status_t fw_tcp_load_program_slot(fw_tcp_program_slot_t *slot, const uint8_t *blob, size_t blob_len) {
+    size_t arena_len = 0U;
+    fw_bc3_status_t vm_status = fw_bc3_program_arena_size(blob, blob_len, &arena_len);
+    if (vm_status != FW_BC3_OK) {
+        fw_tcp_release_program_slot(slot);
+        return vm_status;
+    }
+    fw_tcp_free_program_arena(slot);
+    if (slot->program == NULL) {
+        slot->program = (fw_bc3_program_t *)malloc(sizeof(fw_bc3_program_t));
+    }
+    if (slot->runtime == NULL) {
+        slot->runtime = (fw_bc3_runtime_t *)malloc(sizeof(fw_bc3_runtime_t));
+    }
+    uint8_t *arena = (uint8_t *)malloc(arena_len);
+    if (slot->program == NULL || slot->runtime == NULL || arena == NULL) {
+        ESP_LOGW(TAG, "no heap for a program slot (%u-byte arena)", (unsigned)arena_len);
+        free(arena);
+        fw_tcp_release_program_slot(slot);
+        return FW_BC3_ERR_LIMIT;
+    }
+    vm_status = fw_bc3_program_load(slot->program, blob, blob_len, arena, arena_len);
+    if (vm_status != FW_BC3_OK) {
+        free(arena);
+        fw_tcp_release_program_slot(slot);
+        return vm_status;
+    }
+    const size_t used = slot->program->arena_used;
+    if (used < arena_len) {
+        uint8_t *exact = (uint8_t *)malloc(used);
+        if (exact != NULL) {
+            fw_bc3_program_relocate(slot->program, exact);
+            free(arena);
+            arena = exact;
+        }
+    }
+    slot->arena = arena;
+    size_t runtime_arena_len = 0U;
+    (void)fw_bc3_runtime_arena_size(slot->program, &runtime_arena_len);
+    slot->runtime_arena = malloc(runtime_arena_len);
+    if (slot->runtime_arena == NULL) {
+        ESP_LOGW(TAG, "no heap for a %u-byte runtime arena", (unsigned)runtime_arena_len);
+        fw_tcp_release_program_slot(slot);
+        return FW_BC3_ERR_LIMIT;
+    }
+    slot->runtime_arena_len = runtime_arena_len;
+    ESP_LOGI(TAG, "program uses %u bytes (%u-byte arena), its runtime %u bytes (%u-byte arena, %u registers)",
+             (unsigned)(sizeof(fw_bc3_program_t) + used), (unsigned)used,
+             (unsigned)(sizeof(fw_bc3_runtime_t) + runtime_arena_len), (unsigned)runtime_arena_len,
+             (unsigned)(slot->program->has_register_form != 0U ? slot->program->register_count : 0U));
+    return FW_BC3_OK;
+}
+
+/* Stop any crossfade; the replaced program's slot is then only released by whoever stopped it. */
+static void fw_tcp_cancel_crossfade_locked(fw_tcp_server_state_t *state) {
+    state->crossfade_frames_left = 0U;
+    state->crossfade_frames_total = 0U;
+}
+
 static esp_err_t fw_tcp_load_persisted_default_shader(fw_tcp_server_state_t *state) {
     if (state == NULL || state->bytecode_blob == NULL) {
         return ESP_ERR_INVALID_ARG;
@@ -715,23 +854,27 @@ static esp_err_t fw_tcp_load_persisted_default_shader(fw_tcp_server_state_t *sta
         return ESP_ERR_INVALID_SIZE;
     }
 
-    fw_bc3_status_t vm_status = fw_bc3_program_load(&state->uploaded_program, state->bytecode_blob, read_len);
+    fw_tcp_program_slot_t *slot = &state->program_slots[state->active_program_slot];
+    fw_bc3_status_t vm_status = fw_tcp_load_program_slot(slot, state->bytecode_blob, read_len);
     if (vm_status != FW_BC3_OK) {
         ESP_LOGW(TAG, "persisted bytecode load failed: %s", fw_bc3_status_to_string(vm_status));
         (void)fw_tcp_clear_persisted_default_shader();
         return ESP_ERR_INVALID_RESPONSE;
     }
 
-    vm_status = fw_bc3_runtime_init(&state->runtime, &state->uploaded_program, state->layout.width, state->layout.height);
+    vm_status = fw_bc3_runtime_init(slot->runtime, slot->program, state->layout.width, state->layout.height,
+                                    slot->runtime_arena, slot->runtime_arena_len);
     if (vm_status != FW_BC3_OK) {
         ESP_LOGW(TAG, "persisted shader activate failed: %s", fw_bc3_status_to_string(vm_status));
+        fw_tcp_release_program_slot(slot);
         (void)fw_tcp_clear_persisted_default_shader();
         return ESP_ERR_INVALID_RESPONSE;
     }
-    state->runtime.seed = fw_tcp_generate_seed();
+    slot->runtime->seed = fw_tcp_generate_seed();
 
     state->bytecode_blob_len = read_len;
     state->has_uploaded_program = true;
+    state->uploaded_program_slot = state->active_program_slot;
     state->shader_active = true;
     state->shader_source = FW_TCP_SHADER_SOURCE_BYTECODE;
     state->uniform_last_color_valid = false;
@@ -740,6 +883,8 @@ static esp_err_t fw_tcp_load_persisted_default_shader(fw_tcp_server_state_t *sta
     return ESP_OK;
 }
 
+/* Uploads decode without state_lock into the slot that is not rendering, so a running shader keeps its
+ * frame rate. With a single slot the running shader is stopped first and the program decodes in place. */
 static uint8_t fw_tcp_handle_v3_upload(fw_tcp_server_state_t *state, const uint8_t *payload, size_t payload_len) {
     if (state == NULL || payload == NULL || payload_len == 0U) {
         return FW_TCP_V3_STATUS_INVALID_ARG;
@@ -751,15 +896,15 @@ static uint8_t fw_tcp_handle_v3_upload(fw_tcp_server_state_t *state, const uint8
     if (state->state_lock == NULL || xSemaphoreTake(state->state_lock, portMAX_DELAY) != pdTRUE) {
         return FW_TCP_V3_STATUS_INTERNAL;
     }
-
-    if (payload != state->bytecode_blob) {
-        memcpy(state->bytecode_blob, payload, payload_len);
-    }
-    fw_bc3_status_t vm_status = fw_bc3_program_load(&state->uploaded_program, state->bytecode_blob, payload_len);
-    if (vm_status != FW_BC3_OK) {
-        ESP_LOGW(TAG, "bytecode load failed: %s", fw_bc3_status_to_string(vm_status));
+    const uint8_t slot_index = state->program_slot_count > 1U ? (uint8_t)(state->active_program_slot ^ 1U) : 0U;
+    /* Only drop the activatable program if this upload overwrites it; a failed upload into the spare slot
+     * leaves the running program to be re-activated. */
+    if (slot_index == state->uploaded_program_slot) {
         state->has_uploaded_program = false;
-        state->bytecode_blob_len = 0U;
+    }
+    /* A crossfade still renders the previous program from the staging slot. */
+    fw_tcp_cancel_crossfade_locked(state);
+    if (slot_index == state->active_program_slot) {
         state->shader_active = false;
         state->shader_source = FW_TCP_SHADER_SOURCE_NONE;
         state->uniform_last_color_valid = false;
@@ -768,56 +913,95 @@ static uint8_t fw_tcp_handle_v3_upload(fw_tcp_server_state_t *state, const uint8
             state->phasor_state = NULL;
             state->phasor_state_count = 0;
         }
+    }
+    xSemaphoreGive(state->state_lock);
+
+    /* Only this task writes the staging slot and bytecode_blob; the render task no longer reads them. */
+    if (payload != state->bytecode_blob) {
+        memcpy(state->bytecode_blob, payload, payload_len);
+    }
+    const int64_t load_start_us = esp_timer_get_time();
+    const fw_bc3_status_t vm_status = fw_tcp_load_program_slot(&state->program_slots[slot_index], state->bytecode_blob, payload_len);
+    const int64_t load_us = esp_timer_get_time() - load_start_us;
+
+    if (state->state_lock == NULL || xSemaphoreTake(state->state_lock, portMAX_DELAY) != pdTRUE) {
+        return FW_TCP_V3_STATUS_INTERNAL;
+    }
+    if (vm_status != FW_BC3_OK) {
+        ESP_LOGW(TAG, "bytecode load failed: %s", fw_bc3_status_to_string(vm_status));
+        state->bytecode_blob_len = 0U;
         xSemaphoreGive(state->state_lock);
         return FW_TCP_V3_STATUS_VM_ERROR;
     }
 
     state->bytecode_blob_len = payload_len;
     state->has_uploaded_program = true;
-    state->shader_active = false;
-    state->shader_source = FW_TCP_SHADER_SOURCE_NONE;
-    state->uniform_last_color_valid = false;
-    if (state->phasor_state != NULL) {
-        free(state->phasor_state);
-        state->phasor_state = NULL;
-        state->phasor_state_count = 0;
-    }
+    state->uploaded_program_slot = slot_index;
     xSemaphoreGive(state->state_lock);
+    ESP_LOGI(TAG, "bytecode decoded into slot %u in %lld us", (unsigned)slot_index, (long long)load_us);
     return FW_TCP_V3_STATUS_OK;
 }
 
-static uint8_t fw_tcp_handle_v3_activate(fw_tcp_server_state_t *state) {
+/* Activating a newly uploaded program initializes its runtime without state_lock and swaps slots between
+ * frames; time and the frame counter carry on. With crossfade_ms > 0 and a bytecode shader running, the
+ * old program fades out over that long. Re-activating the running program restarts it in place. */
+static uint8_t fw_tcp_handle_v3_activate(fw_tcp_server_state_t *state, uint16_t crossfade_ms) {
     if (state == NULL) {
         return FW_TCP_V3_STATUS_INTERNAL;
     }
     if (state->state_lock == NULL || xSemaphoreTake(state->state_lock, portMAX_DELAY) != pdTRUE) {
         return FW_TCP_V3_STATUS_INTERNAL;
     }
+    /* How long the render task can be kept waiting by this activation. */
+    int64_t lock_start_us = esp_timer_get_time();
     if (!state->has_uploaded_program) {
         xSemaphoreGive(state->state_lock);
         return FW_TCP_V3_STATUS_NOT_READY;
     }
 
-    fw_bc3_status_t vm_status = fw_bc3_runtime_init(
-        &state->runtime,
-        &state->uploaded_program,
-        state->layout.width,
-        state->layout.height
-    );
+    const uint8_t slot_index = state->uploaded_program_slot;
+    const fw_tcp_program_slot_t *slot = &state->program_slots[slot_index];
+    const bool swap = slot_index != state->active_program_slot;
+    if (swap) {
+        xSemaphoreGive(state->state_lock);
+    }
+    fw_bc3_status_t vm_status = fw_bc3_runtime_init(slot->runtime, slot->program, state->layout.width, state->layout.height,
+                                                    slot->runtime_arena, slot->runtime_arena_len);
+    if (vm_status == FW_BC3_OK) {
+        slot->runtime->seed = fw_tcp_generate_seed();
+    }
+    if (swap) {
+        if (xSemaphoreTake(state->state_lock, portMAX_DELAY) != pdTRUE) {
+            return FW_TCP_V3_STATUS_INTERNAL;
+        }
+        lock_start_us = esp_timer_get_time();
+    }
     if (vm_status != FW_BC3_OK) {
         ESP_LOGW(TAG, "shader activate failed: %s", fw_bc3_status_to_string(vm_status));
-        state->shader_active = false;
-        state->uniform_last_color_valid = false;
-        if (state->phasor_state != NULL) {
-            free(state->phasor_state);
-            state->phasor_state = NULL;
-            state->phasor_state_count = 0;
+        /* A failed swap leaves the running shader alone. */
+        if (!swap) {
+            state->shader_active = false;
+            state->uniform_last_color_valid = false;
+            if (state->phasor_state != NULL) {
+                free(state->phasor_state);
+                state->phasor_state = NULL;
+                state->phasor_state_count = 0;
+            }
         }
         xSemaphoreGive(state->state_lock);
         return FW_TCP_V3_STATUS_VM_ERROR;
     }
-    state->runtime.seed = fw_tcp_generate_seed();
 
+    fw_tcp_cancel_crossfade_locked(state);
+    if (swap && crossfade_ms > 0U && state->shader_active && state->shader_source == FW_TCP_SHADER_SOURCE_BYTECODE) {
+        uint32_t frames = ((uint32_t)crossfade_ms * state->target_fps) / 1000U;
+        if (frames == 0U) {
+            frames = 1U;
+        }
+        state->crossfade_frames_total = frames > UINT16_MAX ? UINT16_MAX : (uint16_t)frames;
+        state->crossfade_frames_left = state->crossfade_frames_total;
+    }
+    state->active_program_slot = slot_index;
     state->shader_active = true;
     state->shader_source = FW_TCP_SHADER_SOURCE_BYTECODE;
     state->shader_slow_frame_count = 0U;
@@ -832,7 +1016,16 @@ static uint8_t fw_tcp_handle_v3_activate(fw_tcp_server_state_t *state) {
         state->phasor_state = NULL;
         state->phasor_state_count = 0;
     }
+    /* Without a crossfade nothing renders the replaced program any more; otherwise the render task
+     * releases it after the last crossfade frame. Only this task writes the idle slot. */
+    const bool release_idle = state->program_slot_count > 1U && state->crossfade_frames_total == 0U;
+    const int64_t lock_us = esp_timer_get_time() - lock_start_us;
     xSemaphoreGive(state->state_lock);
+    if (release_idle) {
+        fw_tcp_release_program_slot(&state->program_slots[slot_index ^ 1U]);
+    }
+    ESP_LOGI(TAG, "shader activated from slot %u (%s), state_lock held %lld us", (unsigned)slot_index,
+             swap ? "swap" : "in place", (long long)lock_us);
     return FW_TCP_V3_STATUS_OK;
 }
 
@@ -865,6 +1058,10 @@ static uint8_t fw_tcp_handle_v3_activate_native(fw_tcp_server_state_t *state, co
     state->shader_active = true;
     state->shader_source = FW_TCP_SHADER_SOURCE_NATIVE;
     state->active_native_shader = shader;
+    /* Params set for an earlier activation do not carry over, as with bytecode runtime init. */
+    for (int i = 0; i < shader->param_count; i++) {
+        shader->params[i].pinned = 0U;
+    }
     state->native_shader_seed = fw_tcp_generate_seed();
     /* Allocate phasor state for audio phase accumulators. */
     if (state->phasor_state != NULL) {
@@ -895,6 +1092,97 @@ static uint8_t fw_tcp_handle_v3_activate_native(fw_tcp_server_state_t *state, co
     return FW_TCP_V3_STATUS_OK;
 }
 
+/* Parse the SET_PARAMS entry at *offset and resolve it against the active shader. Bytecode blobs carry
+ * no param names, so bytecode shaders only take indices; the host resolves names from the DSL source. */
+static uint8_t fw_tcp_parse_param_entry_locked(const fw_tcp_server_state_t *state, const uint8_t *payload, size_t payload_len,
+                                               size_t *offset, uint16_t *out_index, float *out_value) {
+    size_t at = *offset;
+    const uint8_t selector = payload[at++];
+    const dsl_shader_entry_t *shader = state->shader_source == FW_TCP_SHADER_SOURCE_NATIVE ? state->active_native_shader : NULL;
+    uint16_t index = selector;
+    if (selector == FW_TCP_V3_PARAM_BY_NAME) {
+        if (at >= payload_len) {
+            return FW_TCP_V3_STATUS_INVALID_ARG;
+        }
+        const size_t name_len = payload[at++];
+        if (shader == NULL || name_len == 0U || payload_len - at < name_len) {
+            return FW_TCP_V3_STATUS_INVALID_ARG;
+        }
+        index = UINT16_MAX;
+        for (int i = 0; i < shader->param_count; i++) {
+            const char *name = shader->params[i].name;
+            if (strlen(name) == name_len && memcmp(name, &payload[at], name_len) == 0) {
+                index = (uint16_t)i;
+                break;
+            }
+        }
+        at += name_len;
+    }
+
+    if (shader != NULL) {
+        if (index >= (uint16_t)shader->param_count || shader->params[index].settable == 0U) {
+            return FW_TCP_V3_STATUS_INVALID_ARG;
+        }
+    } else if (index >= state->program_slots[state->active_program_slot].program->param_count ||
+               state->program_slots[state->active_program_slot].program->param_depends_xy[index] != 0U) {
+        return FW_TCP_V3_STATUS_INVALID_ARG;
+    }
+
+    if (payload_len - at < FW_TCP_V3_PARAM_VALUE_LEN) {
+        return FW_TCP_V3_STATUS_INVALID_ARG;
+    }
+    const uint32_t bits = fw_tcp_read_be_u32(&payload[at]);
+    float value = 0.0f;
+    memcpy(&value, &bits, sizeof(value));
+    if (!isfinite(value)) {
+        return FW_TCP_V3_STATUS_INVALID_ARG;
+    }
+    *offset = at + FW_TCP_V3_PARAM_VALUE_LEN;
+    *out_index = index;
+    *out_value = value;
+    return FW_TCP_V3_STATUS_OK;
+}
+
+/* Pin params of the running shader between frames (state_lock is held across a whole frame), without
+ * a re-upload or restart. Every entry is validated before any is applied. */
+static uint8_t fw_tcp_handle_v3_set_params(fw_tcp_server_state_t *state, const uint8_t *payload, size_t payload_len) {
+    if (state == NULL || payload == NULL || payload_len == 0U) {
+        return FW_TCP_V3_STATUS_INVALID_ARG;
+    }
+    if (state->state_lock == NULL || xSemaphoreTake(state->state_lock, portMAX_DELAY) != pdTRUE) {
+        return FW_TCP_V3_STATUS_INTERNAL;
+    }
+    const bool native = state->shader_source == FW_TCP_SHADER_SOURCE_NATIVE && state->active_native_shader != NULL;
+    if (!state->shader_active || (!native && state->shader_source != FW_TCP_SHADER_SOURCE_BYTECODE)) {
+        xSemaphoreGive(state->state_lock);
+        return FW_TCP_V3_STATUS_NOT_READY;
+    }
+
+    for (int pass = 0; pass < 2; pass++) {
+        size_t offset = 0U;
+        while (offset < payload_len) {
+            uint16_t index = 0U;
+            float value = 0.0f;
+            const uint8_t status = fw_tcp_parse_param_entry_locked(state, payload, payload_len, &offset, &index, &value);
+            if (status != FW_TCP_V3_STATUS_OK) {
+                xSemaphoreGive(state->state_lock);
+                return status;
+            }
+            if (pass == 0) {
+                continue;
+            }
+            if (native) {
+                state->active_native_shader->params[index].value = value;
+                state->active_native_shader->params[index].pinned = 1U;
+            } else {
+                (void)fw_bc3_runtime_set_param(state->program_slots[state->active_program_slot].runtime, index, value);
+            }
+        }
+    }
+    xSemaphoreGive(state->state_lock);
+    return FW_TCP_V3_STATUS_OK;
+}
+
 static uint8_t fw_tcp_handle_v3_stop_shader(fw_tcp_server_state_t *state) {
     if (state == NULL) {
         return FW_TCP_V3_STATUS_INTERNAL;
@@ -920,7 +1208,10 @@ static uint8_t fw_tcp_handle_v3_stop_shader(fw_tcp_server_state_t *state) {
 #if defined(CONFIG_FW_AUDIO_ENABLED) && CONFIG_FW_AUDIO_ENABLED
     (void)fw_tcp_push_silence_frame(state);
 #endif
-    esp_err_t clear_err = fw_led_output_push_uniform_rgb(&state->led_output, 0U, 0U, 0U);
+    esp_err_t clear_err = fw_tcp_server_flush_output_locked(state);
+    if (clear_err == ESP_OK) {
+        clear_err = fw_led_output_push_uniform_rgb(&state->led_output, 0U, 0U, 0U);
+    }
     xSemaphoreGive(state->state_lock);
     if (clear_err != ESP_OK) {
         ESP_LOGW(TAG, "shader stop clear failed: %s", esp_err_to_name(clear_err));
@@ -1017,10 +1308,12 @@ static bool fw_tcp_handle_v3_message(int sock, fw_tcp_server_state_t *state, uin
             status = fw_tcp_handle_v3_upload(state, payload, payload_len);
             break;
         case FW_TCP_V3_CMD_ACTIVATE_SHADER:
-            if (payload_len != 0U) {
-                status = FW_TCP_V3_STATUS_INVALID_ARG;
+            if (payload_len == 0U) {
+                status = fw_tcp_handle_v3_activate(state, 0U);
+            } else if (payload_len == FW_TCP_V3_ACTIVATE_CROSSFADE_LEN) {
+                status = fw_tcp_handle_v3_activate(state, (uint16_t)(((uint16_t)payload[0] << 8) | payload[1]));
             } else {
-                status = fw_tcp_handle_v3_activate(state);
+                status = FW_TCP_V3_STATUS_INVALID_ARG;
             }
             break;
         case FW_TCP_V3_CMD_SET_DEFAULT_HOOK:
@@ -1049,6 +1342,9 @@ static bool fw_tcp_handle_v3_message(int sock, fw_tcp_server_state_t *state, uin
                 status = fw_tcp_handle_v3_stop_shader(state);
             }
             break;
+        case FW_TCP_V3_CMD_SET_PARAMS:
+            status = fw_tcp_handle_v3_set_params(state, payload, payload_len);
+            break;
         default:
             status = FW_TCP_V3_STATUS_UNSUPPORTED_CMD;
             break;
@@ -1118,16 +1414,129 @@ static uint8_t fw_tcp_handle_v3_firmware_upload_stream(int sock, fw_tcp_server_s
     return FW_TCP_V3_STATUS_OK;
 }
 
-static bool fw_tcp_handle_frame_message(
+/*
+ * True when frames of this stream can be received straight into a claimed LED output slot: raw
+ * 3-byte pixels already in physical order, so the slot only needs its in-place GRB/gamma pass.
+ */
+static bool fw_tcp_frame_fits_output_slot(const fw_tcp_server_state_t *state, bool encoded, uint8_t bytes_per_pixel,
+                                          uint32_t pixel_count) {
+    return !encoded && !FW_V12_REMAP_LOGICAL && bytes_per_pixel == 3U && pixel_count == state->led_count;
+}
+
+static bool fw_tcp_claim_output_slot(fw_tcp_server_state_t *state, fw_led_output_slot_claim_t *claim) {
+    if (state->state_lock == NULL || xSemaphoreTake(state->state_lock, portMAX_DELAY) != pdTRUE) {
+        return false;
+    }
+    const esp_err_t err = fw_led_output_claim_slot(&state->led_output, claim);
+    xSemaphoreGive(state->state_lock);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "output slot claim failed: %s", esp_err_to_name(err));
+        return false;
+    }
+    return true;
+}
+
+static void fw_tcp_release_output_slot(fw_tcp_server_state_t *state) {
+    if (state->state_lock == NULL || xSemaphoreTake(state->state_lock, portMAX_DELAY) != pdTRUE) {
+        return;
+    }
+    fw_led_output_release_slot(&state->led_output);
+    xSemaphoreGive(state->state_lock);
+}
+
+/* delta_frame is only needed by encoded streams, so it is allocated on the first one and freed when the
+ * connection closes. */
+static bool fw_tcp_reserve_delta_frame(fw_tcp_server_state_t *state) {
+    if (state->delta_frame != NULL) {
+        return true;
+    }
+    state->delta_frame = (uint8_t *)malloc(state->rx_buffer_len);
+    if (state->delta_frame == NULL) {
+        ESP_LOGW(TAG, "delta frame alloc failed (%u bytes)", (unsigned)state->rx_buffer_len);
+        return false;
+    }
+    state->delta_frame_valid = false;
+    return true;
+}
+
+static void fw_tcp_free_delta_frame(fw_tcp_server_state_t *state) {
+    free(state->delta_frame);
+    state->delta_frame = NULL;
+    state->delta_frame_valid = false;
+}
+
+/*
+ * Receive one frame payload that decodes to `payload_len` bytes.  With a claimed output slot the raw
+ * payload is read segment by segment straight into it and *out_payload is left NULL.  Otherwise raw
+ * payloads land in rx_buffer; encoded ones (FW_FRAME_CODEC_FORMAT_FLAG) are read into rx_buffer and
+ * applied to delta_frame, which then holds the frame.  Only the client task touches these buffers
+ * (a claimed slot is skipped by every other output), so no lock is needed.
+ */
+static bool fw_tcp_recv_frame_payload(
     int sock,
     fw_tcp_server_state_t *state,
-    uint8_t version,
+    bool encoded,
+    uint8_t bytes_per_pixel,
+    size_t payload_len,
+    const fw_led_output_slot_claim_t *slot,
+    const uint8_t **out_payload
+) {
+    if (slot != NULL) {
+        *out_payload = NULL;
+        for (uint8_t segment = 0U; segment < slot->segment_count; segment += 1U) {
+            if (!fw_tcp_recv_exact(sock, slot->segments[segment], slot->segment_len[segment])) {
+                return false;
+            }
+        }
+        return true;
+    }
+    if (!encoded) {
+        if (!fw_tcp_recv_exact(sock, state->rx_buffer, payload_len)) {
+            return false;
+        }
+        *out_payload = state->rx_buffer;
+        return true;
+    }
+
+    uint8_t prefix[FW_FRAME_CODEC_PREFIX_LEN];
+    if (!fw_tcp_recv_exact(sock, prefix, sizeof(prefix))) {
+        return false;
+    }
+    const uint32_t body_len = fw_tcp_read_be_u32(prefix);
+    const uint8_t encoding = prefix[4];
+    /* Senders fall back to raw rather than send a body larger than the frame. */
+    if (body_len > payload_len || payload_len > state->rx_buffer_len) {
+        ESP_LOGW(TAG, "encoded frame too large: body=%" PRIu32 " frame=%u", body_len, (unsigned)payload_len);
+        return false;
+    }
+    if (!fw_tcp_recv_exact(sock, state->rx_buffer, body_len) || !fw_tcp_reserve_delta_frame(state)) {
+        return false;
+    }
+    if (encoding != FW_FRAME_CODEC_RAW &&
+        (!state->delta_frame_valid || state->delta_bytes_per_pixel != bytes_per_pixel)) {
+        ESP_LOGW(TAG, "delta frame without a reference frame");
+        return false;
+    }
+
+    state->delta_frame_valid = false;
+    if (fw_frame_codec_decode(encoding, state->rx_buffer, body_len, state->delta_frame, payload_len, bytes_per_pixel) != 0) {
+        ESP_LOGW(TAG, "invalid encoded frame: encoding=%u body=%" PRIu32, encoding, body_len);
+        return false;
+    }
+    state->delta_frame_valid = true;
+    state->delta_bytes_per_pixel = bytes_per_pixel;
+    *out_payload = state->delta_frame;
+    return true;
+}
+
+static bool fw_tcp_show_frame(
+    fw_tcp_server_state_t *state,
     uint8_t pixel_format,
     uint32_t pixel_count,
     const uint8_t *payload,
     size_t payload_len
 ) {
-    if (state == NULL || payload == NULL) {
+    if (state == NULL) {
         return false;
     }
 
@@ -1145,19 +1554,38 @@ static bool fw_tcp_handle_frame_message(
         return false;
     }
 
-    esp_err_t blit_err = fw_tcp_blit_frame(state, bytes_per_pixel, payload, payload_len);
-    if (blit_err != ESP_OK) {
-        xSemaphoreGive(state->state_lock);
-        ESP_LOGW(TAG, "frame blit failed: %s", esp_err_to_name(blit_err));
-        return false;
+    /* A NULL payload was received into the claimed output slot. */
+    esp_err_t push_err = fw_tcp_server_flush_output_locked(state);
+    if (push_err == ESP_OK) {
+        push_err = (payload == NULL)
+            ? fw_led_output_push_claimed_slot(&state->led_output, pixel_format)
+            : fw_led_output_push_frame(&state->led_output, payload, payload_len,
+                                       FW_V12_REMAP_LOGICAL ? state->layout_map.logical_to_physical : NULL,
+                                       pixel_format, bytes_per_pixel);
+    } else if (payload == NULL) {
+        /* The frame is not shown, so hand its slot back to the other outputs. */
+        fw_led_output_release_slot(&state->led_output);
     }
-    esp_err_t push_err =
-        fw_led_output_push_frame(&state->led_output, state->frame_buffer, state->frame_buffer_len, pixel_format, bytes_per_pixel);
     xSemaphoreGive(state->state_lock);
     if (push_err != ESP_OK) {
         ESP_LOGW(TAG, "frame output failed: %s", esp_err_to_name(push_err));
         return false;
     }
+    return true;
+}
+
+static bool fw_tcp_handle_frame_message(
+    int sock,
+    fw_tcp_server_state_t *state,
+    uint8_t version,
+    uint8_t pixel_format,
+    uint32_t pixel_count,
+    const uint8_t *payload,
+    size_t payload_len
+) {
+    if (!fw_tcp_show_frame(state, pixel_format, pixel_count, payload, payload_len)) {
+        return false;
+    }
 
     if (version == FW_TCP_PROTOCOL_V2) {
         const uint8_t ack = FW_TCP_ACK_BYTE;
@@ -1168,8 +1596,212 @@ static bool fw_tcp_handle_frame_message(
     return true;
 }
 
+/* Negotiated v4 stream of one client connection; window 0 until its hello was accepted. */
+typedef struct {
+    uint32_t window;
+    uint32_t pixel_count;
+    uint8_t pixel_format;
+    uint8_t bytes_per_pixel;
+    bool encoded;
+    /* Frames carry a presentation deadline (FW_TCP_V4_PRESENT_FLAG). */
+    bool timed;
+    size_t payload_len;
+    uint32_t frames_dropped;
+    /* Timed frames that were ready only after their deadline. */
+    uint32_t frames_late;
+} fw_tcp_v4_stream_t;
+
+static bool fw_tcp_send_v4_message(int sock, uint8_t msg_type, uint32_t value) {
+    uint8_t header[FW_TCP_HEADER_LEN] = {'L', 'E', 'D', 'S', FW_TCP_PROTOCOL_V4, 0, 0, 0, 0, msg_type};
+    fw_tcp_write_be_u32(&header[5], value);
+    return fw_tcp_send_exact(sock, header, sizeof(header));
+}
+
+/* Reads the hello payload and grants min(requested, FW_TCP_V4_MAX_WINDOW); replies 0 and closes the
+ * connection when the announced frame does not fit this display. */
+static bool fw_tcp_handle_v4_hello(int sock, fw_tcp_server_state_t *state, uint32_t requested_window, fw_tcp_v4_stream_t *stream) {
+    uint8_t payload[FW_TCP_V4_HELLO_PAYLOAD_LEN];
+    if (!fw_tcp_recv_exact(sock, payload, sizeof(payload))) {
+        return false;
+    }
+
+    const uint32_t pixel_count = fw_tcp_read_be_u32(payload);
+    const bool encoded = (payload[4] & FW_FRAME_CODEC_FORMAT_FLAG) != 0U;
+    const bool timed = (payload[4] & FW_TCP_V4_PRESENT_FLAG) != 0U;
+    const uint8_t pixel_format = (uint8_t)(payload[4] & ~(FW_FRAME_CODEC_FORMAT_FLAG | FW_TCP_V4_PRESENT_FLAG));
+    uint8_t bytes_per_pixel = 0;
+    bool accepted = requested_window > 0U && pixel_count == state->led_count &&
+        fw_tcp_pixel_format_bytes(pixel_format, &bytes_per_pixel);
+    const size_t payload_len = accepted ? (size_t)pixel_count * bytes_per_pixel : 0U;
+    if (payload_len > state->rx_buffer_len || (accepted && encoded && !fw_tcp_reserve_delta_frame(state))) {
+        accepted = false;
+    }
+
+    const uint32_t window = accepted
+        ? ((requested_window < FW_TCP_V4_MAX_WINDOW) ? requested_window : FW_TCP_V4_MAX_WINDOW)
+        : 0U;
+    if (!fw_tcp_send_v4_message(sock, FW_TCP_V4_MSG_HELLO_REPLY, window)) {
+        return false;
+    }
+    if (!accepted) {
+        ESP_LOGW(TAG, "v4 stream rejected: pixels=%" PRIu32 " format=%u window=%" PRIu32, pixel_count, pixel_format, requested_window);
+        return false;
+    }
+
+    /* Several frames and ACKs are in flight; Nagle would hold each small ACK back for a round trip. */
+    const int no_delay = 1;
+    if (setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &no_delay, sizeof(no_delay)) < 0) {
+        ESP_LOGW(TAG, "setsockopt(TCP_NODELAY) failed: errno=%d", errno);
+    }
+
+    stream->window = window;
+    stream->pixel_count = pixel_count;
+    stream->pixel_format = pixel_format;
+    stream->bytes_per_pixel = bytes_per_pixel;
+    stream->encoded = encoded;
+    stream->timed = timed;
+    stream->payload_len = payload_len;
+    stream->frames_dropped = 0U;
+    stream->frames_late = 0U;
+    ESP_LOGI(TAG, "v4 stream: window=%" PRIu32 " payload=%u encoded=%d timed=%d", window, (unsigned)payload_len, encoded, timed);
+    return true;
+}
+
+/* True when the complete header of a v4 message of this type is already waiting in the socket. */
+static bool fw_tcp_v4_message_queued(int sock, uint8_t msg_type) {
+    uint8_t next[FW_TCP_HEADER_LEN];
+    const ssize_t peeked = recv(sock, next, sizeof(next), MSG_PEEK | MSG_DONTWAIT);
+    return peeked == (ssize_t)sizeof(next) && memcmp(next, "LEDS", 4U) == 0 &&
+        next[4] == FW_TCP_PROTOCOL_V4 && next[9] == msg_type;
+}
+
+static bool fw_tcp_v4_frame_queued(int sock) {
+    return fw_tcp_v4_message_queued(sock, FW_TCP_V4_MSG_FRAME);
+}
+
+/* NTP-style clock sync: echo the request id with the times it was received and answered; the client
+ * keeps the exchange with the shortest round trip. */
+static bool fw_tcp_handle_v4_time_request(int sock, uint32_t request_id, int64_t received_us) {
+    uint8_t reply[FW_TCP_HEADER_LEN + FW_TCP_V4_TIME_REPLY_PAYLOAD_LEN] = {
+        'L', 'E', 'D', 'S', FW_TCP_PROTOCOL_V4, 0, 0, 0, 0, FW_TCP_V4_MSG_TIME_REPLY,
+    };
+    fw_tcp_write_be_u32(&reply[5], request_id);
+    fw_tcp_write_be_u64(&reply[FW_TCP_HEADER_LEN], (uint64_t)received_us);
+    fw_tcp_write_be_u64(&reply[FW_TCP_HEADER_LEN + 8U], (uint64_t)esp_timer_get_time());
+    return fw_tcp_send_exact(sock, reply, sizeof(reply));
+}
+
+/*
+ * Hold a timed frame until its deadline.  Time requests queued right behind it are answered while
+ * waiting, so their timestamps do not include the hold; once anything else is queued the rest of the
+ * wait is the shader task's absolute-deadline wait.
+ */
+static bool fw_tcp_hold_until(int sock, int64_t deadline_us) {
+    const int64_t latest_us = esp_timer_get_time() + FW_TCP_V4_MAX_PRESENT_HOLD_US;
+    if (deadline_us > latest_us) {
+        deadline_us = latest_us;
+    }
+    while (true) {
+        /* select() wakes on ticks; leave the last ticks to fw_tcp_wait_until. */
+        const int64_t wait_us = deadline_us - esp_timer_get_time() - 2000;
+        if (wait_us <= 0) {
+            break;
+        }
+        fd_set read_fds;
+        FD_ZERO(&read_fds);
+        FD_SET(sock, &read_fds);
+        struct timeval timeout = {
+            .tv_sec = (time_t)(wait_us / 1000000LL),
+            .tv_usec = (suseconds_t)(wait_us % 1000000LL),
+        };
+        const int ready = select(sock + 1, &read_fds, NULL, NULL, &timeout);
+        if (ready < 0) {
+            return false;
+        }
+        if (ready == 0 || !fw_tcp_v4_message_queued(sock, FW_TCP_V4_MSG_TIME_REQUEST)) {
+            break;
+        }
+        uint8_t header[FW_TCP_HEADER_LEN];
+        if (!fw_tcp_recv_exact(sock, header, sizeof(header))) {
+            return false;
+        }
+        if (!fw_tcp_handle_v4_time_request(sock, fw_tcp_read_be_u32(&header[5]), esp_timer_get_time())) {
+            return false;
+        }
+    }
+    fw_tcp_wait_until(deadline_us);
+    return true;
+}
+
+static bool fw_tcp_recv_v4_frame(int sock, fw_tcp_server_state_t *state, const fw_tcp_v4_stream_t *stream,
+                                 const fw_led_output_slot_claim_t *slot, int64_t *present_at_us,
+                                 const uint8_t **payload) {
+    if (stream->timed) {
+        uint8_t prefix[FW_TCP_V4_PRESENT_PREFIX_LEN];
+        if (!fw_tcp_recv_exact(sock, prefix, sizeof(prefix))) {
+            return false;
+        }
+        *present_at_us = (int64_t)fw_tcp_read_be_u64(prefix);
+    }
+    return fw_tcp_recv_frame_payload(sock, state, stream->encoded, stream->bytes_per_pixel, stream->payload_len, slot, payload);
+}
+
+/*
+ * Receive the frame announced with `seq`, replacing it with every newer frame already queued behind
+ * it (drop-oldest), then show the newest and acknowledge it.  The ACK is cumulative, so it also
+ * releases the dropped frames from the client's window.  Dropped encoded frames are still decoded:
+ * the next delta applies to them; raw frames that fit an output slot simply overwrite it.  A timed
+ * frame is only replaced once its deadline has passed; otherwise it is held until the deadline.
+ */
+static bool fw_tcp_handle_v4_frames(int sock, fw_tcp_server_state_t *state, fw_tcp_v4_stream_t *stream, uint32_t seq) {
+    fw_led_output_slot_claim_t claim;
+    const fw_led_output_slot_claim_t *slot = NULL;
+    if (fw_tcp_frame_fits_output_slot(state, stream->encoded, stream->bytes_per_pixel, stream->pixel_count)) {
+        if (!fw_tcp_claim_output_slot(state, &claim)) {
+            return false;
+        }
+        slot = &claim;
+    }
+
+    const uint8_t *payload = NULL;
+    int64_t present_at_us = 0;
+    if (!fw_tcp_recv_v4_frame(sock, state, stream, slot, &present_at_us, &payload)) {
+        return false;
+    }
+    uint32_t dropped = 0U;
+    while ((!stream->timed || present_at_us <= esp_timer_get_time()) && fw_tcp_v4_frame_queued(sock)) {
+        uint8_t header[FW_TCP_HEADER_LEN];
+        if (!fw_tcp_recv_exact(sock, header, sizeof(header)) ||
+            !fw_tcp_recv_v4_frame(sock, state, stream, slot, &present_at_us, &payload)) {
+            return false;
+        }
+        seq = fw_tcp_read_be_u32(&header[5]);
+        dropped += 1U;
+    }
+    if (dropped > 0U) {
+        stream->frames_dropped += dropped;
+        ESP_LOGD(TAG, "v4 stream dropped %" PRIu32 " queued frame(s), %" PRIu32 " total", dropped, stream->frames_dropped);
+    }
+    if (stream->timed) {
+        if (present_at_us < esp_timer_get_time()) {
+            stream->frames_late += 1U;
+            ESP_LOGD(TAG, "v4 frame %" PRIu32 " late, %" PRIu32 " total", seq, stream->frames_late);
+        } else if (!fw_tcp_hold_until(sock, present_at_us)) {
+            return false;
+        }
+    }
+
+    if (!fw_tcp_show_frame(state, stream->pixel_format, stream->pixel_count, payload, stream->payload_len)) {
+        return false;
+    }
+    return fw_tcp_send_v4_message(sock, FW_TCP_V4_MSG_ACK, seq);
+}
+
 static bool fw_tcp_client_loop(int client_sock, fw_tcp_server_state_t *state) {
     uint8_t header[FW_TCP_HEADER_LEN];
+    fw_tcp_v4_stream_t v4_stream = {0};
+    /* Deltas never span connections: a new client starts from a raw frame. */
+    state->delta_frame_valid = false;
 
     while (true) {
         if (!fw_tcp_recv_exact(client_sock, header, sizeof(header))) {
@@ -1183,7 +1815,8 @@ static bool fw_tcp_client_loop(int client_sock, fw_tcp_server_state_t *state) {
         const uint8_t version = header[4];
         if (version == FW_TCP_PROTOCOL_V1 || version == FW_TCP_PROTOCOL_V2) {
             const uint32_t pixel_count = fw_tcp_read_be_u32(&header[5]);
-            const uint8_t pixel_format = header[9];
+            const bool encoded = (header[9] & FW_FRAME_CODEC_FORMAT_FLAG) != 0U;
+            const uint8_t pixel_format = (uint8_t)(header[9] & ~FW_FRAME_CODEC_FORMAT_FLAG);
             uint8_t bytes_per_pixel = 0;
             if (!fw_tcp_pixel_format_bytes(pixel_format, &bytes_per_pixel)) {
                 ESP_LOGW(TAG, "invalid frame pixel format: %u", pixel_format);
@@ -1202,7 +1835,16 @@ static bool fw_tcp_client_loop(int client_sock, fw_tcp_server_state_t *state) {
                 return false;
             }
 
-            if (!fw_tcp_recv_exact(client_sock, state->rx_buffer, payload_len)) {
+            fw_led_output_slot_claim_t claim;
+            const fw_led_output_slot_claim_t *slot = NULL;
+            if (fw_tcp_frame_fits_output_slot(state, encoded, bytes_per_pixel, pixel_count)) {
+                if (!fw_tcp_claim_output_slot(state, &claim)) {
+                    return false;
+                }
+                slot = &claim;
+            }
+            const uint8_t *payload = NULL;
+            if (!fw_tcp_recv_frame_payload(client_sock, state, encoded, bytes_per_pixel, payload_len, slot, &payload)) {
                 return false;
             }
             if (!fw_tcp_handle_frame_message(
@@ -1211,7 +1853,7 @@ static bool fw_tcp_client_loop(int client_sock, fw_tcp_server_state_t *state) {
                     version,
                     pixel_format,
                     pixel_count,
-                    state->rx_buffer,
+                    payload,
                     payload_len
                 )) {
                 return false;
@@ -1294,6 +1936,31 @@ static bool fw_tcp_client_loop(int client_sock, fw_tcp_server_state_t *state) {
             continue;
         }
 
+        if (version == FW_TCP_PROTOCOL_V4) {
+            const uint32_t value = fw_tcp_read_be_u32(&header[5]);
+            const uint8_t msg_type = header[9];
+            if (msg_type == FW_TCP_V4_MSG_HELLO) {
+                if (!fw_tcp_handle_v4_hello(client_sock, state, value, &v4_stream)) {
+                    return false;
+                }
+                continue;
+            }
+            if (msg_type == FW_TCP_V4_MSG_TIME_REQUEST) {
+                if (!fw_tcp_handle_v4_time_request(client_sock, value, esp_timer_get_time())) {
+                    return false;
+                }
+                continue;
+            }
+            if (msg_type == FW_TCP_V4_MSG_FRAME && v4_stream.window > 0U) {
+                if (!fw_tcp_handle_v4_frames(client_sock, state, &v4_stream, value)) {
+                    return false;
+                }
+                continue;
+            }
+            ESP_LOGW(TAG, "unexpected v4 message: %u", msg_type);
+            return false;
+        }
+
         ESP_LOGW(TAG, "unsupported protocol version: %u", version);
         return false;
     }
@@ -1331,6 +1998,121 @@ static int fw_tcp_open_listen_socket(uint16_t port) {
     return listen_sock;
 }
 
+static int fw_udp_open_socket(uint16_t port) {
+    const int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    if (sock < 0) {
+        ESP_LOGE(TAG, "udp socket() failed: errno=%d", errno);
+        return -1;
+    }
+
+    struct sockaddr_in listen_addr = {0};
+    listen_addr.sin_family = AF_INET;
+    listen_addr.sin_port = htons(port);
+    listen_addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(sock, (struct sockaddr *)&listen_addr, sizeof(listen_addr)) < 0) {
+        ESP_LOGE(TAG, "udp bind() failed: errno=%d", errno);
+        close(sock);
+        return -1;
+    }
+
+    ESP_LOGI(TAG, "UDP frame stream listening on port %u", port);
+    return sock;
+}
+
+static void fw_udp_stream_receive(fw_tcp_server_state_t *state, const uint8_t *bytes, size_t len) {
+    fw_udp_jitter_t *jitter = &state->udp_jitter;
+    fw_udp_datagram_t datagram;
+    uint8_t bytes_per_pixel = 0U;
+    if (fw_udp_stream_parse(bytes, len, &datagram) != 0 || datagram.pixel_count != state->led_count ||
+        !fw_tcp_pixel_format_bytes(datagram.pixel_format, &bytes_per_pixel)) {
+        jitter->stats.datagrams_invalid += 1U;
+        return;
+    }
+    (void)fw_udp_jitter_push(jitter, &datagram, (size_t)state->led_count * bytes_per_pixel, esp_timer_get_time());
+}
+
+/*
+ * Protocol v5: reassemble frame datagrams in the jitter buffer and show each frame once it is due,
+ * waiting in select() until the next due frame or datagram.  Only this task touches udp_jitter.
+ */
+static void fw_udp_stream_task(void *arg) {
+    fw_tcp_server_state_t *state = (fw_tcp_server_state_t *)arg;
+    fw_udp_jitter_t *jitter = &state->udp_jitter;
+    uint8_t datagram[FW_UDP_STREAM_MAX_DATAGRAM];
+    int sock = -1;
+
+    while (sock < 0) {
+        sock = fw_udp_open_socket(state->port);
+        if (sock < 0) {
+            vTaskDelay(pdMS_TO_TICKS(1000));
+        }
+    }
+
+    int64_t next_stats_us = esp_timer_get_time() + FW_UDP_STREAM_STATS_INTERVAL_US;
+    uint32_t logged_frames_shown = 0U;
+    while (true) {
+        int64_t now_us = esp_timer_get_time();
+        fw_udp_frame_t frame;
+        if (fw_udp_jitter_pop(jitter, now_us, &frame)) {
+            (void)fw_tcp_show_frame(state, frame.pixel_format, state->led_count, frame.pixels, frame.len);
+            now_us = esp_timer_get_time();
+        }
+
+        int64_t wait_us = FW_UDP_STREAM_IDLE_WAIT_US;
+        int64_t due_us = 0;
+        if (fw_udp_jitter_next_due(jitter, &due_us) && due_us - now_us < wait_us) {
+            wait_us = (due_us > now_us) ? (due_us - now_us) : 0;
+        }
+        fd_set read_fds;
+        FD_ZERO(&read_fds);
+        FD_SET(sock, &read_fds);
+        struct timeval timeout = {
+            .tv_sec = (time_t)(wait_us / 1000000LL),
+            .tv_usec = (suseconds_t)(wait_us % 1000000LL),
+        };
+        const int ready = select(sock + 1, &read_fds, NULL, NULL, &timeout);
+        if (ready < 0) {
+            ESP_LOGW(TAG, "udp select() failed: errno=%d", errno);
+            vTaskDelay(pdMS_TO_TICKS(100));
+        } else if (ready > 0) {
+            /* Drain the socket: lwIP only queues a few datagrams, fewer than a frame may have fragments. */
+            ssize_t len = 0;
+            while ((len = recv(sock, datagram, sizeof(datagram), MSG_DONTWAIT)) > 0) {
+                fw_udp_stream_receive(state, datagram, (size_t)len);
+            }
+        }
+
+        if (now_us >= next_stats_us) {
+            next_stats_us = now_us + FW_UDP_STREAM_STATS_INTERVAL_US;
+            if (jitter->stats.frames_shown != logged_frames_shown) {
+                logged_frames_shown = jitter->stats.frames_shown;
+                ESP_LOGI(TAG, "udp stream: shown=%" PRIu32 " skipped=%" PRIu32 " incomplete=%" PRIu32 " late=%" PRIu32
+                         " invalid=%" PRIu32 " restarts=%" PRIu32,
+                         jitter->stats.frames_shown, jitter->stats.frames_skipped, jitter->stats.frames_incomplete,
+                         jitter->stats.datagrams_late, jitter->stats.datagrams_invalid, jitter->stats.stream_restarts);
+            }
+        }
+    }
+}
+
+/* Optional: without heap for the jitter buffer the pillar still takes TCP frames. */
+static void fw_udp_stream_start(fw_tcp_server_state_t *state) {
+    if (!FW_UDP_STREAM_ENABLED) {
+        return;
+    }
+    const size_t slot_len = (size_t)state->led_count * FW_TCP_MAX_BYTES_PER_PIXEL;
+    state->udp_slots = (uint8_t *)malloc(slot_len * FW_UDP_JITTER_SLOTS);
+    if (state->udp_slots == NULL ||
+        fw_udp_jitter_init(&state->udp_jitter, state->udp_slots, slot_len, FW_UDP_JITTER_SLOTS,
+                           (uint32_t)FW_UDP_JITTER_DELAY_MS * 1000U) != 0 ||
+        xTaskCreate(fw_udp_stream_task, "fw_udp_stream", FW_UDP_STREAM_TASK_STACK, state, 5, NULL) != pdPASS) {
+        ESP_LOGW(TAG, "UDP frame stream disabled: %u bytes for %u jitter slots unavailable",
+                 (unsigned)(slot_len * FW_UDP_JITTER_SLOTS), (unsigned)FW_UDP_JITTER_SLOTS);
+        free(state->udp_slots);
+        state->udp_slots = NULL;
+    }
+}
+
 static void fw_tcp_server_task(void *arg) {
     fw_tcp_server_state_t *state = (fw_tcp_server_state_t *)arg;
     int listen_sock = -1;
@@ -1354,6 +2136,9 @@ static void fw_tcp_server_task(void *arg) {
 
         ESP_LOGI(TAG, "client connected");
         (void)fw_tcp_client_loop(client_sock, state);
+        /* A connection that dropped mid-frame still holds its output slot. */
+        fw_tcp_release_output_slot(state);
+        fw_tcp_free_delta_frame(state);
         shutdown(client_sock, 0);
         close(client_sock);
         ESP_LOGI(TAG, "client disconnected");
@@ -1377,41 +2162,50 @@ esp_err_t fw_tcp_server_start(const fw_led_layout_config_t *layout, uint16_t por
     g_fw_tcp_server.layout = *layout;
     g_fw_tcp_server.led_count = fw_led_layout_total_leds(layout);
     g_fw_tcp_server.port = port;
+#if defined(CONFIG_FW_SHADER_HOT_SWAP) && CONFIG_FW_SHADER_HOT_SWAP
+    g_fw_tcp_server.program_slot_count = 2U;
+#else
+    g_fw_tcp_server.program_slot_count = 1U;
+#endif
 
     if (g_fw_tcp_server.led_count == 0U || g_fw_tcp_server.led_count > (UINT32_MAX / FW_TCP_MAX_BYTES_PER_PIXEL)) {
         return ESP_ERR_INVALID_SIZE;
     }
 
-    g_fw_tcp_server.frame_buffer_len = (size_t)g_fw_tcp_server.led_count * FW_TCP_MAX_BYTES_PER_PIXEL;
-    g_fw_tcp_server.rx_buffer_len = g_fw_tcp_server.frame_buffer_len;
+    g_fw_tcp_server.rx_buffer_len = (size_t)g_fw_tcp_server.led_count * FW_TCP_MAX_BYTES_PER_PIXEL;
 
     ESP_LOGI(TAG, "free heap before alloc: %" PRIu32 " bytes (largest block: %" PRIu32 ")",
              (uint32_t)esp_get_free_heap_size(), (uint32_t)heap_caps_get_largest_free_block(MALLOC_CAP_8BIT));
-    ESP_LOGI(TAG, "need: frame_buf=%u rx_buf=%u bytecode=%u",
-             (unsigned)g_fw_tcp_server.frame_buffer_len, (unsigned)g_fw_tcp_server.rx_buffer_len,
-             (unsigned)FW_TCP_MAX_BYTECODE_BLOB);
+    ESP_LOGI(TAG, "need: rx_buf=%u bytecode=%u",
+             (unsigned)g_fw_tcp_server.rx_buffer_len, (unsigned)FW_TCP_MAX_BYTECODE_BLOB);
 
-    g_fw_tcp_server.frame_buffer = (uint8_t *)calloc(1U, g_fw_tcp_server.frame_buffer_len);
     g_fw_tcp_server.rx_buffer = (uint8_t *)malloc(g_fw_tcp_server.rx_buffer_len);
     g_fw_tcp_server.bytecode_blob = (uint8_t *)malloc(FW_TCP_MAX_BYTECODE_BLOB);
 
-    if (g_fw_tcp_server.frame_buffer == NULL || g_fw_tcp_server.rx_buffer == NULL || g_fw_tcp_server.bytecode_blob == NULL) {
-        ESP_LOGE(TAG, "buffer alloc failed: frame=%p rx=%p bytecode=%p",
-                 g_fw_tcp_server.frame_buffer, g_fw_tcp_server.rx_buffer, g_fw_tcp_server.bytecode_blob);
-        free(g_fw_tcp_server.frame_buffer);
+    if (g_fw_tcp_server.rx_buffer == NULL || g_fw_tcp_server.bytecode_blob == NULL) {
+        ESP_LOGE(TAG, "buffer alloc failed: rx=%p bytecode=%p", g_fw_tcp_server.rx_buffer, g_fw_tcp_server.bytecode_blob);
         free(g_fw_tcp_server.rx_buffer);
         free(g_fw_tcp_server.bytecode_blob);
         memset(&g_fw_tcp_server, 0, sizeof(g_fw_tcp_server));
         return ESP_ERR_NO_MEM;
     }
+
+    esp_err_t map_err = fw_led_layout_map_init(&g_fw_tcp_server.layout_map, &g_fw_tcp_server.layout);
+    if (map_err != ESP_OK) {
+        ESP_LOGE(TAG, "layout map build failed: %s", esp_err_to_name(map_err));
+        free(g_fw_tcp_server.rx_buffer);
+        free(g_fw_tcp_server.bytecode_blob);
+        memset(&g_fw_tcp_server, 0, sizeof(g_fw_tcp_server));
+        return map_err;
+    }
     ESP_LOGI(TAG, "buffers allocated, heap: %" PRIu32, (uint32_t)esp_get_free_heap_size());
 
     esp_err_t led_output_err = fw_led_output_init(&g_fw_tcp_server.led_output, &g_fw_tcp_server.layout);
     if (led_output_err != ESP_OK) {
         ESP_LOGE(TAG, "led_output_init failed: %s", esp_err_to_name(led_output_err));
-        free(g_fw_tcp_server.frame_buffer);
         free(g_fw_tcp_server.rx_buffer);
         free(g_fw_tcp_server.bytecode_blob);
+        fw_led_layout_map_deinit(&g_fw_tcp_server.layout_map);
         memset(&g_fw_tcp_server, 0, sizeof(g_fw_tcp_server));
         return led_output_err;
     }
@@ -1421,9 +2215,9 @@ esp_err_t fw_tcp_server_start(const fw_led_layout_config_t *layout, uint16_t por
     if (startup_err != ESP_OK) {
         ESP_LOGE(TAG, "startup_sequence failed: %s", esp_err_to_name(startup_err));
         fw_led_output_deinit(&g_fw_tcp_server.led_output);
-        free(g_fw_tcp_server.frame_buffer);
         free(g_fw_tcp_server.rx_buffer);
         free(g_fw_tcp_server.bytecode_blob);
+        fw_led_layout_map_deinit(&g_fw_tcp_server.layout_map);
         memset(&g_fw_tcp_server, 0, sizeof(g_fw_tcp_server));
         return startup_err;
     }
@@ -1447,39 +2241,78 @@ esp_err_t fw_tcp_server_start(const fw_led_layout_config_t *layout, uint16_t por
 
     g_fw_tcp_server.state_lock = xSemaphoreCreateMutex();
     if (g_fw_tcp_server.state_lock == NULL) {
+        fw_tcp_release_program_slot(&g_fw_tcp_server.program_slots[0]);
         fw_led_output_deinit(&g_fw_tcp_server.led_output);
-        free(g_fw_tcp_server.frame_buffer);
         free(g_fw_tcp_server.rx_buffer);
         free(g_fw_tcp_server.bytecode_blob);
+        fw_led_layout_map_deinit(&g_fw_tcp_server.layout_map);
         memset(&g_fw_tcp_server, 0, sizeof(g_fw_tcp_server));
         return ESP_ERR_NO_MEM;
     }
 
     ESP_LOGI(TAG, "creating tasks, heap: %" PRIu32, (uint32_t)esp_get_free_heap_size());
+#if defined(CONFIG_FW_RENDER_DUAL_CORE) && CONFIG_FW_RENDER_DUAL_CORE
+    /* Native shaders render half of each frame's rows on core 0 while the
+     * shader task (core 1) renders the rest; without the worker they fall
+     * back to single-core rendering. */
+    if (fw_render_jobs_start(0) != 0) {
+        ESP_LOGW(TAG, "render worker create failed, native shaders stay single-core");
+    }
+#endif
+    /* Shader frames are output by a task on core 0 so the next frame renders
+     * while the previous one is prepared and transmitted. */
+    g_fw_tcp_server.frame_pipeline = fw_frame_pipeline_create((size_t)g_fw_tcp_server.led_count * 3U,
+                                                              fw_tcp_pipeline_output, &g_fw_tcp_server, 0);
+    if (g_fw_tcp_server.frame_pipeline == NULL) {
+        ESP_LOGW(TAG, "frame pipeline create failed, shader frames are output inline");
+        g_fw_tcp_server.frame_buffer = (uint8_t *)malloc((size_t)g_fw_tcp_server.led_count * 3U);
+        if (g_fw_tcp_server.frame_buffer == NULL) {
+            ESP_LOGE(TAG, "shader frame buffer alloc failed");
+            fw_render_jobs_stop();
+            fw_tcp_release_program_slot(&g_fw_tcp_server.program_slots[0]);
+            vSemaphoreDelete(g_fw_tcp_server.state_lock);
+            fw_led_output_deinit(&g_fw_tcp_server.led_output);
+            free(g_fw_tcp_server.rx_buffer);
+            free(g_fw_tcp_server.bytecode_blob);
+            fw_led_layout_map_deinit(&g_fw_tcp_server.layout_map);
+            memset(&g_fw_tcp_server, 0, sizeof(g_fw_tcp_server));
+            return ESP_ERR_NO_MEM;
+        }
+    }
     TaskHandle_t server_task = NULL;
     if (xTaskCreate(fw_tcp_server_task, "fw_tcp_server", 8192, &g_fw_tcp_server, 5, &server_task) != pdPASS) {
         ESP_LOGE(TAG, "server task create failed");
+        fw_render_jobs_stop();
+        fw_frame_pipeline_destroy(g_fw_tcp_server.frame_pipeline);
+        fw_tcp_release_program_slot(&g_fw_tcp_server.program_slots[0]);
         vSemaphoreDelete(g_fw_tcp_server.state_lock);
         fw_led_output_deinit(&g_fw_tcp_server.led_output);
         free(g_fw_tcp_server.frame_buffer);
         free(g_fw_tcp_server.rx_buffer);
         free(g_fw_tcp_server.bytecode_blob);
+        fw_led_layout_map_deinit(&g_fw_tcp_server.layout_map);
         memset(&g_fw_tcp_server, 0, sizeof(g_fw_tcp_server));
         return ESP_ERR_NO_MEM;
     }
 
     if (xTaskCreatePinnedToCore(fw_tcp_shader_task, "fw_tcp_shader", 12288, &g_fw_tcp_server, 4, NULL, 1) != pdPASS) {
         ESP_LOGE(TAG, "shader task create failed");
+        fw_render_jobs_stop();
+        fw_frame_pipeline_destroy(g_fw_tcp_server.frame_pipeline);
         vTaskDelete(server_task);
+        fw_tcp_release_program_slot(&g_fw_tcp_server.program_slots[0]);
         vSemaphoreDelete(g_fw_tcp_server.state_lock);
         fw_led_output_deinit(&g_fw_tcp_server.led_output);
         free(g_fw_tcp_server.frame_buffer);
         free(g_fw_tcp_server.rx_buffer);
         free(g_fw_tcp_server.bytecode_blob);
+        fw_led_layout_map_deinit(&g_fw_tcp_server.layout_map);
         memset(&g_fw_tcp_server, 0, sizeof(g_fw_tcp_server));
         return ESP_ERR_NO_MEM;
     }
 
+    fw_udp_stream_start(&g_fw_tcp_server);
+
     g_fw_tcp_server.started = true;
     return ESP_OK;
 }
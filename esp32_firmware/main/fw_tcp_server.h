@@ -9,8 +9,10 @@
 #include "freertos/semphr.h"
 
 #include "fw_bytecode_vm.h"
+#include "fw_frame_pipeline.h"
 #include "fw_led_config.h"
 #include "fw_led_output.h"
+#include "fw_udp_stream.h"
 #include "generated/dsl_shader_registry.h"
 
 #define FW_TCP_DEFAULT_PORT 7777U
@@ -21,14 +23,31 @@ typedef enum {
     FW_TCP_SHADER_SOURCE_NATIVE = 2,
 } fw_tcp_shader_source_t;
 
+/* A decoded bytecode program, the heap arena holding its tables and the runtime that renders it, with the
+ * runtime's own program-sized arena (registers, let and hoisted values). */
+typedef struct {
+    fw_bc3_program_t *program;
+    fw_bc3_runtime_t *runtime;
+    void *arena;
+    void *runtime_arena;
+    size_t runtime_arena_len;
+} fw_tcp_program_slot_t;
+
 typedef struct fw_tcp_server_state {
     bool started;
     fw_led_layout_config_t layout;
+    fw_led_layout_map_t layout_map;
     uint32_t led_count;
+    /* Shader wire frame (led_count * 3 bytes), only allocated when frame_pipeline could not be created. */
     uint8_t *frame_buffer;
-    size_t frame_buffer_len;
+    /* Frame payloads that cannot go straight into an output slot, encoded frame bodies and v3 payloads. */
     uint8_t *rx_buffer;
     size_t rx_buffer_len;
+    /* Previous frame of an encoded (fw_frame_codec) stream, rx_buffer_len bytes; deltas apply to it.
+     * Allocated when a connection first negotiates or sends encoded frames and freed when it closes. */
+    uint8_t *delta_frame;
+    bool delta_frame_valid;
+    uint8_t delta_bytes_per_pixel;
     uint8_t *bytecode_blob;
     size_t bytecode_blob_len;
     bool has_uploaded_program;
@@ -52,11 +71,26 @@ typedef struct fw_tcp_server_state {
     uint8_t uniform_last_r;
     uint8_t uniform_last_g;
     uint8_t uniform_last_b;
-    fw_bc3_program_t uploaded_program;
-    fw_bc3_runtime_t runtime;
+    /* Uploads decode into the slot that is not rendering and activation swaps active_program_slot between
+     * frames. Slots are heap-allocated by the first load into them, and with CONFIG_FW_SHADER_HOT_SWAP
+     * the replaced slot is released once nothing renders it, so two are only held from an upload until
+     * its activation (and crossfade) ends. With one slot uploads stop the running shader and decode in
+     * place. */
+    fw_tcp_program_slot_t program_slots[2];
+    uint8_t program_slot_count;
+    uint8_t active_program_slot;
+    uint8_t uploaded_program_slot;
+    /* Hot-swap crossfade: the replaced slot keeps rendering underneath the active one for these frames. */
+    uint16_t crossfade_frames_total;
+    uint16_t crossfade_frames_left;
     SemaphoreHandle_t state_lock;
     uint16_t port;
     fw_led_output_t led_output;
+    /* Shader frames are rendered into pipeline buffers and output from core 0; NULL renders unpipelined. */
+    fw_frame_pipeline_t *frame_pipeline;
+    /* Protocol v5 (fw_udp_stream) frame reassembly; udp_slots is NULL while UDP streaming is off. */
+    uint8_t *udp_slots;
+    fw_udp_jitter_t udp_jitter;
 } fw_tcp_server_state_t;
 
 esp_err_t fw_tcp_server_start(const fw_led_layout_config_t *layout, uint16_t port);
@@ -66,3 +100,9 @@ esp_err_t fw_tcp_server_start(const fw_led_layout_config_t *layout, uint16_t por
  * The state is valid after fw_tcp_server_start() has been called.
  */
 fw_tcp_server_state_t *fw_tcp_server_get_state(void);
+
+/**
+ * Wait until every queued shader frame has been handed to the LED driver.
+ * Call with state_lock held before writing to led_output directly.
+ */
+esp_err_t fw_tcp_server_flush_output_locked(fw_tcp_server_state_t *state);
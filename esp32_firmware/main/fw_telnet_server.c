@@ -709,9 +709,11 @@ static void cmd_stop(int sock, fw_tcp_server_state_t *state) {
     xSemaphoreTake(state->state_lock, portMAX_DELAY);
     state->shader_active = false;
     state->active_native_shader = NULL;
+    if (fw_tcp_server_flush_output_locked(state) == ESP_OK) {
+        fw_led_output_push_uniform_rgb(&state->led_output, 0, 0, 0);
+    }
     xSemaphoreGive(state->state_lock);
 
-    fw_led_output_push_uniform_rgb(&state->led_output, 0, 0, 0);
     telnet_send_str(sock, "Shader stopped.\r\n");
 }
 
@@ -815,6 +817,11 @@ static void cmd_top(int sock, fw_tcp_server_state_t *state) {
         target_fps = state->target_fps;
         xSemaphoreGive(state->state_lock);
 
+        fw_frame_pipeline_stats_t pipeline = {0};
+        if (state->frame_pipeline != NULL) {
+            fw_frame_pipeline_get_stats(state->frame_pipeline, &pipeline);
+        }
+
         uint32_t free_heap = esp_get_free_heap_size();
 
         /* Compute render budget */
@@ -835,6 +842,7 @@ static void cmd_top(int sock, fw_tcp_server_state_t *state) {
             "Slow frames: %" PRIu32 "\r\n"
             "Audio:       %s\r\n"
             "Render:      %.1f ms display + %.1f ms audio = %.1f ms (%.1f%% of %.1f ms)\r\n"
+            "Output:      %.1f ms handoff wait, %.1f ms output stage, %.1f ms latency\r\n"
             "Free heap:   %" PRIu32 "\r\n"
             "\r\n"
             "Press any key to exit...\r\n",
@@ -842,6 +850,8 @@ static void cmd_top(int sock, fw_tcp_server_state_t *state) {
             has_audio ? "active" : "none",
             (double)display_ms, (double)audio_ms, (double)combined_ms,
             (double)percent, (double)target_frame_ms,
+            (double)(pipeline.acquire_wait_us / 1000.0f), (double)(pipeline.output_us / 1000.0f),
+            (double)(pipeline.latency_us / 1000.0f),
             free_heap);
         if (n > 0 && !telnet_send(sock, out, (size_t)n)) break;
 
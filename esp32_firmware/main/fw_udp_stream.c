@@ -0,0 +1,238 @@
+#include "fw_udp_stream.h"
+
+#include <string.h>
+
+/* Each new frame pulls the clock offset up by 1/N of how much later than the fastest frame it arrived,
+ * so sender/receiver clock drift is followed without one slow frame delaying everything after it. */
+#define FW_UDP_JITTER_OFFSET_RISE_DIV 64
+
+static uint16_t fw_udp_read_be_u16(const uint8_t *bytes) {
+    return (uint16_t)(((uint16_t)bytes[0] << 8) | (uint16_t)bytes[1]);
+}
+
+static uint32_t fw_udp_read_be_u32(const uint8_t *bytes) {
+    return ((uint32_t)bytes[0] << 24) | ((uint32_t)bytes[1] << 16) | ((uint32_t)bytes[2] << 8) | (uint32_t)bytes[3];
+}
+
+/* Frame ids wrap, so order them by their distance. */
+static bool fw_udp_frame_newer(uint32_t frame_id, uint32_t than) {
+    return (int32_t)(frame_id - than) > 0;
+}
+
+static uint64_t fw_udp_fragment_mask(uint16_t fragment_count) {
+    return (fragment_count >= 64U) ? UINT64_MAX : ((1ULL << fragment_count) - 1ULL);
+}
+
+static bool fw_udp_slot_complete(const fw_udp_jitter_slot_t *slot) {
+    return slot->fragments_received == fw_udp_fragment_mask(slot->fragment_count);
+}
+
+int fw_udp_stream_parse(const uint8_t *datagram, size_t len, fw_udp_datagram_t *out) {
+    if (datagram == NULL || out == NULL || len < FW_UDP_STREAM_HEADER_LEN) {
+        return -1;
+    }
+    if (memcmp(datagram, "LEDS", 4U) != 0 || datagram[4] != FW_UDP_STREAM_PROTOCOL_VERSION) {
+        return -1;
+    }
+
+    out->frame_id = fw_udp_read_be_u32(&datagram[5]);
+    out->pixel_format = datagram[9];
+    out->fragment_index = fw_udp_read_be_u16(&datagram[10]);
+    out->fragment_count = fw_udp_read_be_u16(&datagram[12]);
+    out->presentation_us = fw_udp_read_be_u32(&datagram[14]);
+    out->pixel_count = fw_udp_read_be_u32(&datagram[18]);
+    out->fragment = datagram + FW_UDP_STREAM_HEADER_LEN;
+    out->fragment_len = len - FW_UDP_STREAM_HEADER_LEN;
+    if (out->fragment_count == 0U || out->fragment_count > FW_UDP_STREAM_MAX_FRAGMENTS ||
+        out->fragment_index >= out->fragment_count || out->fragment_len > FW_UDP_STREAM_FRAGMENT_LEN) {
+        return -1;
+    }
+    return 0;
+}
+
+uint16_t fw_udp_stream_fragment_count(size_t frame_len) {
+    const size_t count = (frame_len + FW_UDP_STREAM_FRAGMENT_LEN - 1U) / FW_UDP_STREAM_FRAGMENT_LEN;
+    return (count > UINT16_MAX) ? UINT16_MAX : (uint16_t)count;
+}
+
+int fw_udp_jitter_init(fw_udp_jitter_t *jitter, uint8_t *storage, size_t slot_len, uint8_t slot_count, uint32_t delay_us) {
+    if (jitter == NULL || storage == NULL || slot_len == 0U || slot_count < 2U || slot_count > FW_UDP_STREAM_MAX_SLOTS) {
+        return -1;
+    }
+    memset(jitter, 0, sizeof(*jitter));
+    jitter->slot_count = slot_count;
+    jitter->slot_len = slot_len;
+    jitter->delay_us = delay_us;
+    for (uint8_t i = 0U; i < slot_count; i++) {
+        jitter->slots[i].data = storage + (size_t)i * slot_len;
+    }
+    return 0;
+}
+
+void fw_udp_jitter_reset(fw_udp_jitter_t *jitter) {
+    for (uint8_t i = 0U; i < jitter->slot_count; i++) {
+        jitter->slots[i].in_use = false;
+    }
+    jitter->clock_valid = false;
+    jitter->shown_valid = false;
+}
+
+/* Local time a frame with this presentation time is due.  Called once per frame, on its first fragment. */
+static int64_t fw_udp_jitter_due_time(fw_udp_jitter_t *jitter, uint32_t presentation_us, int64_t now_us) {
+    if (!jitter->clock_valid) {
+        jitter->clock_valid = true;
+        jitter->sender_time_us = presentation_us;
+        jitter->clock_offset_us = now_us - jitter->sender_time_us;
+    } else {
+        jitter->sender_time_us += (int32_t)(presentation_us - jitter->last_presentation_us);
+    }
+    jitter->last_presentation_us = presentation_us;
+
+    /* The offset follows the fastest frame seen: that one waited least in the network. */
+    const int64_t offset_us = now_us - jitter->sender_time_us;
+    if (offset_us < jitter->clock_offset_us) {
+        jitter->clock_offset_us = offset_us;
+    } else {
+        jitter->clock_offset_us += (offset_us - jitter->clock_offset_us) / FW_UDP_JITTER_OFFSET_RISE_DIV;
+    }
+    return jitter->sender_time_us + jitter->clock_offset_us + jitter->delay_us;
+}
+
+static void fw_udp_jitter_drop(fw_udp_jitter_t *jitter, fw_udp_jitter_slot_t *slot) {
+    if (fw_udp_slot_complete(slot)) {
+        jitter->stats.frames_skipped += 1U;
+    } else {
+        jitter->stats.frames_incomplete += 1U;
+    }
+    slot->in_use = false;
+}
+
+/* Newest frame id shown or being reassembled. */
+static bool fw_udp_jitter_newest_id(const fw_udp_jitter_t *jitter, uint32_t *out_id) {
+    bool found = jitter->shown_valid;
+    *out_id = jitter->last_shown_id;
+    for (uint8_t i = 0U; i < jitter->slot_count; i++) {
+        const fw_udp_jitter_slot_t *slot = &jitter->slots[i];
+        if (slot->in_use && (!found || fw_udp_frame_newer(slot->frame_id, *out_id))) {
+            *out_id = slot->frame_id;
+            found = true;
+        }
+    }
+    return found;
+}
+
+/* A free slot for a new frame, or the slot of the oldest frame when that is older than the new one. */
+static fw_udp_jitter_slot_t *fw_udp_jitter_claim_slot(fw_udp_jitter_t *jitter, uint32_t frame_id) {
+    fw_udp_jitter_slot_t *oldest = NULL;
+    for (uint8_t i = 0U; i < jitter->slot_count; i++) {
+        fw_udp_jitter_slot_t *slot = &jitter->slots[i];
+        if (!slot->in_use) {
+            return slot;
+        }
+        if (oldest == NULL || fw_udp_frame_newer(oldest->frame_id, slot->frame_id)) {
+            oldest = slot;
+        }
+    }
+    if (!fw_udp_frame_newer(frame_id, oldest->frame_id)) {
+        return NULL;
+    }
+    fw_udp_jitter_drop(jitter, oldest);
+    return oldest;
+}
+
+int fw_udp_jitter_push(fw_udp_jitter_t *jitter, const fw_udp_datagram_t *datagram, size_t frame_len, int64_t now_us) {
+    const uint16_t fragment_count = fw_udp_stream_fragment_count(frame_len);
+    const size_t fragment_offset = (size_t)datagram->fragment_index * FW_UDP_STREAM_FRAGMENT_LEN;
+    if (frame_len == 0U || frame_len > jitter->slot_len || datagram->fragment_count != fragment_count ||
+        datagram->fragment_len != ((datagram->fragment_index + 1U < fragment_count) ? FW_UDP_STREAM_FRAGMENT_LEN
+                                                                                     : frame_len - fragment_offset)) {
+        jitter->stats.datagrams_invalid += 1U;
+        return -1;
+    }
+
+    uint32_t newest_id = 0U;
+    if (fw_udp_jitter_newest_id(jitter, &newest_id) &&
+        (int32_t)(newest_id - datagram->frame_id) >= (int32_t)FW_UDP_STREAM_RESTART_GAP) {
+        fw_udp_jitter_reset(jitter);
+        jitter->stats.stream_restarts += 1U;
+    }
+    if (jitter->shown_valid && !fw_udp_frame_newer(datagram->frame_id, jitter->last_shown_id)) {
+        jitter->stats.datagrams_late += 1U;
+        return -1;
+    }
+
+    fw_udp_jitter_slot_t *slot = NULL;
+    for (uint8_t i = 0U; i < jitter->slot_count; i++) {
+        if (jitter->slots[i].in_use && jitter->slots[i].frame_id == datagram->frame_id) {
+            slot = &jitter->slots[i];
+            break;
+        }
+    }
+    if (slot == NULL) {
+        slot = fw_udp_jitter_claim_slot(jitter, datagram->frame_id);
+        if (slot == NULL) {
+            jitter->stats.datagrams_late += 1U;
+            return -1;
+        }
+        slot->frame_id = datagram->frame_id;
+        slot->frame_len = frame_len;
+        slot->fragment_count = fragment_count;
+        slot->pixel_format = datagram->pixel_format;
+        slot->fragments_received = 0U;
+        slot->due_us = fw_udp_jitter_due_time(jitter, datagram->presentation_us, now_us);
+        slot->in_use = true;
+    } else if (slot->frame_len != frame_len || slot->pixel_format != datagram->pixel_format) {
+        jitter->stats.datagrams_invalid += 1U;
+        return -1;
+    }
+
+    const uint64_t bit = 1ULL << datagram->fragment_index;
+    if ((slot->fragments_received & bit) == 0U) {
+        memcpy(slot->data + fragment_offset, datagram->fragment, datagram->fragment_len);
+        slot->fragments_received |= bit;
+    }
+    return 0;
+}
+
+bool fw_udp_jitter_pop(fw_udp_jitter_t *jitter, int64_t now_us, fw_udp_frame_t *out) {
+    fw_udp_jitter_slot_t *newest = NULL;
+    for (uint8_t i = 0U; i < jitter->slot_count; i++) {
+        fw_udp_jitter_slot_t *slot = &jitter->slots[i];
+        if (slot->in_use && fw_udp_slot_complete(slot) && slot->due_us <= now_us &&
+            (newest == NULL || fw_udp_frame_newer(slot->frame_id, newest->frame_id))) {
+            newest = slot;
+        }
+    }
+    if (newest == NULL) {
+        return false;
+    }
+
+    for (uint8_t i = 0U; i < jitter->slot_count; i++) {
+        fw_udp_jitter_slot_t *slot = &jitter->slots[i];
+        if (slot->in_use && fw_udp_frame_newer(newest->frame_id, slot->frame_id)) {
+            fw_udp_jitter_drop(jitter, slot);
+        }
+    }
+    newest->in_use = false;
+    jitter->shown_valid = true;
+    jitter->last_shown_id = newest->frame_id;
+    jitter->stats.frames_shown += 1U;
+
+    out->pixels = newest->data;
+    out->len = newest->frame_len;
+    out->frame_id = newest->frame_id;
+    out->pixel_format = newest->pixel_format;
+    return true;
+}
+
+bool fw_udp_jitter_next_due(const fw_udp_jitter_t *jitter, int64_t *out_due_us) {
+    bool found = false;
+    for (uint8_t i = 0U; i < jitter->slot_count; i++) {
+        const fw_udp_jitter_slot_t *slot = &jitter->slots[i];
+        if (slot->in_use && fw_udp_slot_complete(slot) && (!found || slot->due_us < *out_due_us)) {
+            *out_due_us = slot->due_us;
+            found = true;
+        }
+    }
+    return found;
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * UDP frame streaming (protocol v5).
+ *
+ * Every frame is split into fragments of FW_UDP_STREAM_FRAGMENT_LEN payload
+ * bytes (the last one shorter), each sent as one datagram:
+ *
+ *   0  "LEDS"
+ *   4  u8     0x05
+ *   5  u32 BE frame_id          increments per frame, starts at 1
+ *   9  u8     pixel_format      as in v1/v2 (no compression flag)
+ *  10  u16 BE fragment_index
+ *  12  u16 BE fragment_count
+ *  14  u32 BE presentation_us   sender clock, wraps
+ *  18  u32 BE pixel_count
+ *  22  fragment payload, bytes [fragment_index * FW_UDP_STREAM_FRAGMENT_LEN, ...)
+ *
+ * There are no ACKs and no retransmissions.  The receiver reassembles frames
+ * in a small jitter buffer and shows each one a fixed delay after its
+ * presentation time (mapped onto the local clock), so network jitter up to
+ * that delay is absorbed.  A frame that is still incomplete, or older than
+ * one already shown, is dropped instead of holding back newer frames.
+ *
+ * The jitter buffer is plain C with the clock passed in, so the simulator
+ * and tests run exactly the code that runs on the pillar.
+ */
+
+#define FW_UDP_STREAM_PROTOCOL_VERSION 0x05U
+#define FW_UDP_STREAM_HEADER_LEN 22U
+/* Fits an Ethernet/Wi-Fi MTU with IP and UDP headers; a multiple of 3 and 4 bytes per pixel. */
+#define FW_UDP_STREAM_FRAGMENT_LEN 1440U
+#define FW_UDP_STREAM_MAX_DATAGRAM (FW_UDP_STREAM_HEADER_LEN + FW_UDP_STREAM_FRAGMENT_LEN)
+/* Fragments are tracked in a 64-bit mask. */
+#define FW_UDP_STREAM_MAX_FRAGMENTS 64U
+#define FW_UDP_STREAM_MAX_SLOTS 8U
+/* A frame id this far behind the last shown one starts a new stream (sender restarted). */
+#define FW_UDP_STREAM_RESTART_GAP 64U
+
+typedef struct {
+    uint32_t frame_id;
+    uint8_t pixel_format;
+    uint16_t fragment_index;
+    uint16_t fragment_count;
+    uint32_t presentation_us;
+    uint32_t pixel_count;
+    const uint8_t *fragment;
+    size_t fragment_len;
+} fw_udp_datagram_t;
+
+typedef struct {
+    uint32_t frames_shown;
+    /* Complete frames skipped because a newer one was due at the same time. */
+    uint32_t frames_skipped;
+    /* Frames dropped with fragments missing. */
+    uint32_t frames_incomplete;
+    /* Datagrams of frames older than the last one shown. */
+    uint32_t datagrams_late;
+    /* Datagrams that do not parse or do not fit the frame they claim to belong to. */
+    uint32_t datagrams_invalid;
+    uint32_t stream_restarts;
+} fw_udp_jitter_stats_t;
+
+typedef struct {
+    uint8_t *data;
+    size_t frame_len;
+    uint64_t fragments_received;
+    uint32_t frame_id;
+    int64_t due_us;
+    uint16_t fragment_count;
+    uint8_t pixel_format;
+    bool in_use;
+} fw_udp_jitter_slot_t;
+
+typedef struct {
+    fw_udp_jitter_slot_t slots[FW_UDP_STREAM_MAX_SLOTS];
+    uint8_t slot_count;
+    size_t slot_len;
+    int64_t delay_us;
+    /* Sender clock extended past its 32-bit wrap, and local minus sender time. */
+    bool clock_valid;
+    uint32_t last_presentation_us;
+    int64_t sender_time_us;
+    int64_t clock_offset_us;
+    bool shown_valid;
+    uint32_t last_shown_id;
+    fw_udp_jitter_stats_t stats;
+} fw_udp_jitter_t;
+
+typedef struct {
+    const uint8_t *pixels;
+    size_t len;
+    uint32_t frame_id;
+    uint8_t pixel_format;
+} fw_udp_frame_t;
+
+/**
+ * Parse one datagram.  The fragment points into `datagram`.
+ * @return 0, or -1 for a datagram that is not a v5 frame fragment.
+ */
+int fw_udp_stream_parse(const uint8_t *datagram, size_t len, fw_udp_datagram_t *out);
+
+/** Fragments a frame of `frame_len` bytes is sent in. */
+uint16_t fw_udp_stream_fragment_count(size_t frame_len);
+
+/**
+ * @param storage    slot_count * slot_len bytes, owned by the caller.
+ * @param slot_len   Largest frame the buffer takes.
+ * @param slot_count Frames reassembled at once, 2..FW_UDP_STREAM_MAX_SLOTS.
+ * @param delay_us   How long after its presentation time a frame is shown.
+ * @return 0, or -1 for invalid arguments.
+ */
+int fw_udp_jitter_init(fw_udp_jitter_t *jitter, uint8_t *storage, size_t slot_len, uint8_t slot_count, uint32_t delay_us);
+
+/** Forget every frame and the clock mapping, e.g. for a new sender. Stats are kept. */
+void fw_udp_jitter_reset(fw_udp_jitter_t *jitter);
+
+/**
+ * Add one fragment received at local time `now_us`.  `frame_len` is the
+ * decoded size of its frame (pixel_count times the format's bytes per pixel),
+ * checked by the caller against the display.  When every slot is taken the
+ * oldest frame is dropped to make room.
+ * @return 0 when stored (duplicates included), -1 when dropped (see stats).
+ */
+int fw_udp_jitter_push(fw_udp_jitter_t *jitter, const fw_udp_datagram_t *datagram, size_t frame_len, int64_t now_us);
+
+/**
+ * Take the newest complete frame that is due at `now_us`; older frames are
+ * dropped.  The pixels stay valid until the next push.
+ * @return true when a frame was taken.
+ */
+bool fw_udp_jitter_pop(fw_udp_jitter_t *jitter, int64_t now_us, fw_udp_frame_t *out);
+
+/**
+ * Local time the earliest complete frame is due, to bound the next receive
+ * wait.
+ * @return false when no complete frame is waiting.
+ */
+bool fw_udp_jitter_next_due(const fw_udp_jitter_t *jitter, int64_t *out_due_us);
@@ -1,4 +1,5 @@
 #include <math.h>
+#include <stddef.h>
 #include <stdint.h>
 
 /* DSL_NOINLINE: defined by the ESP32 build to control inlining of
@@ -28,12 +29,43 @@ typedef struct {
     float a;
 } dsl_color_t;
 
+/* One DSL param of a shader; SET_PARAMS pins settable ones (no x/y dependency) to value. */
+typedef struct {
+    const char *name;
+    float value;
+    uint8_t pinned;
+    uint8_t settable;
+} dsl_shader_param_t;
+
 static inline float dsl_clamp(float v, float lo, float hi) {
     if (v < lo) return lo;
     if (v > hi) return hi;
     return v;
 }
 
+static inline uint8_t dsl_channel_to_u8(float v) {
+    if (v <= 0.0f) return 0U;
+    if (v >= 1.0f) return 255U;
+    return (uint8_t)(v * 255.0f + 0.5f);
+}
+
+/* Quantize one pixel into its output bytes: RGB, or the LED wire format
+ * (gamma-corrected GRB) when a gamma table is given. */
+static inline void dsl_store_pixel(uint8_t *px, dsl_color_t c, const uint8_t *grb_gamma) {
+    const uint8_t r = dsl_channel_to_u8(c.r);
+    const uint8_t g = dsl_channel_to_u8(c.g);
+    const uint8_t b = dsl_channel_to_u8(c.b);
+    if (grb_gamma != NULL) {
+        px[0] = grb_gamma[g];
+        px[1] = grb_gamma[r];
+        px[2] = grb_gamma[b];
+        return;
+    }
+    px[0] = r;
+    px[1] = g;
+    px[2] = b;
+}
+
 static inline float dsl_fract(float v) {
     return v - floorf(v);
 }
@@ -91,6 +123,15 @@ static inline float dsl_box(dsl_vec2_t p, dsl_vec2_t b) {
     return sqrtf((outside.x * outside.x) + (outside.y * outside.y)) + inside;
 }
 
+/* Conservative footprint test for blend culling: false only when (px, py) lies at
+ * least (rx, ry), plus a margin for SDF rounding, from the origin on either axis.
+ * A macro so px is only evaluated for rows that pass the y test. */
+#define DSL_NEAR_BOX(px, py, rx, ry) (fabsf(py) < (ry) + 0.01f && fabsf(px) < (rx) + 0.01f)
+
+static inline float dsl_reach_max(float a, float b) {
+    return (a > b) ? a : b;
+}
+
 static DSL_NOINLINE dsl_color_t dsl_blend_over(dsl_color_t src, dsl_color_t dst) {
     const float src_a = dsl_clamp(src.a, 0.0f, 1.0f);
     const float dst_a = dsl_clamp(dst.a, 0.0f, 1.0f);
@@ -108,6 +149,29 @@ static DSL_NOINLINE dsl_color_t dsl_blend_over(dsl_color_t src, dsl_color_t dst)
     };
 }
 
+/* dsl_blend_over with dst.a == 1: out_a is then exactly 1, so the division
+ * and the transparent-result branch drop out. */
+static inline dsl_color_t dsl_blend_over_opaque(dsl_color_t src, dsl_color_t dst) {
+    const float src_a = dsl_clamp(src.a, 0.0f, 1.0f);
+    const float one_minus_src_a = 1.0f - src_a;
+    return (dsl_color_t){
+        .r = dsl_clamp((src.r * src_a) + (dst.r * one_minus_src_a), 0.0f, 1.0f),
+        .g = dsl_clamp((src.g * src_a) + (dst.g * one_minus_src_a), 0.0f, 1.0f),
+        .b = dsl_clamp((src.b * src_a) + (dst.b * one_minus_src_a), 0.0f, 1.0f),
+        .a = 1.0f,
+    };
+}
+
+/* dsl_blend_over with src.a >= 1: the source simply replaces the destination. */
+static inline dsl_color_t dsl_color_opaque(dsl_color_t src) {
+    return (dsl_color_t){
+        .r = dsl_clamp(src.r, 0.0f, 1.0f),
+        .g = dsl_clamp(src.g, 0.0f, 1.0f),
+        .b = dsl_clamp(src.b, 0.0f, 1.0f),
+        .a = 1.0f,
+    };
+}
+
 static const unsigned char dsl_perm[512] = {
     151,160,137,91,90,15,131,13,201,95,96,53,194,233,7,225,
     140,36,103,30,69,142,8,99,37,240,21,10,23,190,6,148,
@@ -236,22 +300,66 @@ static inline float dsl_phasor_advance(float *state, float freq, float sample_ra
 }
 
 
+/* Generated from effect: a440_test_tone */
+static void a440_test_tone_prepare_frame(float time, float frame, float width, float height, float seed) {
+}
+
 /* Generated from effect: a440_test_tone */
 static void a440_test_tone_eval_pixel(float time, float frame, float x, float y, float width, float height, float seed, dsl_color_t *out_color) {
     dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
     /* layer background */
     const float dsl_let_pulse_0 DSL_MAYBE_UNUSED = ((sinf(((time * 0.250000f) * 6.28318530717958647692f)) * 0.500000f) + 0.500000f);
     const float dsl_let_intensity_1 DSL_MAYBE_UNUSED = (0.180000f + (dsl_let_pulse_0 * 0.220000f));
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = dsl_let_intensity_1, .g = (dsl_let_intensity_1 * 0.350000f), .b = (dsl_let_intensity_1 * 0.050000f), .a = 1.000000f }, __dsl_out);
+    __dsl_out = dsl_color_opaque((dsl_color_t){ .r = dsl_let_intensity_1, .g = (dsl_let_intensity_1 * 0.350000f), .b = (dsl_let_intensity_1 * 0.050000f), .a = 1.000000f });
     /* layer status_glow */
     const float dsl_let_cy_2 DSL_MAYBE_UNUSED = (height * 0.500000f);
     const float dsl_let_dist_3 DSL_MAYBE_UNUSED = fabsf((y - dsl_let_cy_2));
     const float dsl_let_band_4 DSL_MAYBE_UNUSED = dsl_smoothstep(10.000000f, 0.000000f, dsl_let_dist_3);
     const float dsl_let_intensity_5 DSL_MAYBE_UNUSED = (dsl_let_band_4 * 0.850000f);
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = dsl_let_intensity_5, .g = (dsl_let_intensity_5 * 0.750000f), .b = (dsl_let_intensity_5 * 0.100000f), .a = dsl_let_intensity_5 }, __dsl_out);
+    {
+        const float __dsl_blend_a = dsl_let_intensity_5;
+        if (!(__dsl_blend_a <= 0.0f)) {
+            __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_let_intensity_5, .g = (dsl_let_intensity_5 * 0.750000f), .b = (dsl_let_intensity_5 * 0.100000f), .a = __dsl_blend_a }, __dsl_out);
+        }
+    }
     *out_color = __dsl_out;
 }
 
+/* Generated from effect: a440_test_tone */
+static void a440_test_tone_render_rows(float time, float frame, int width_px, int height_px, int row_first, int row_step, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    const float width DSL_MAYBE_UNUSED = (float)width_px;
+    const float height DSL_MAYBE_UNUSED = (float)height_px;
+    for (int py = row_first; py < height_px; py += row_step) {
+        const float y DSL_MAYBE_UNUSED = (float)py;
+        const float dsl_let_pulse_0 DSL_MAYBE_UNUSED = ((sinf(((time * 0.250000f) * 6.28318530717958647692f)) * 0.500000f) + 0.500000f);
+        const float dsl_let_intensity_1 DSL_MAYBE_UNUSED = (0.180000f + (dsl_let_pulse_0 * 0.220000f));
+        const float dsl_let_cy_2 DSL_MAYBE_UNUSED = (height * 0.500000f);
+        const float dsl_let_dist_3 DSL_MAYBE_UNUSED = fabsf((y - dsl_let_cy_2));
+        const float dsl_let_band_4 DSL_MAYBE_UNUSED = dsl_smoothstep(10.000000f, 0.000000f, dsl_let_dist_3);
+        const float dsl_let_intensity_5 DSL_MAYBE_UNUSED = (dsl_let_band_4 * 0.850000f);
+        for (int px = 0; px < width_px; px++) {
+            const float x DSL_MAYBE_UNUSED = (float)px;
+            dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
+            /* layer background */
+            __dsl_out = dsl_color_opaque((dsl_color_t){ .r = dsl_let_intensity_1, .g = (dsl_let_intensity_1 * 0.350000f), .b = (dsl_let_intensity_1 * 0.050000f), .a = 1.000000f });
+            /* layer status_glow */
+            {
+                const float __dsl_blend_a = dsl_let_intensity_5;
+                if (!(__dsl_blend_a <= 0.0f)) {
+                    __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_let_intensity_5, .g = (dsl_let_intensity_5 * 0.750000f), .b = (dsl_let_intensity_5 * 0.100000f), .a = __dsl_blend_a }, __dsl_out);
+                }
+            }
+            dsl_store_pixel(pixel_out + (uint32_t)phys_index[py * width_px + px] * 3U, __dsl_out, grb_gamma);
+        }
+    }
+}
+
+/* Generated from effect: a440_test_tone */
+static void a440_test_tone_render_frame(float time, float frame, int width_px, int height_px, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    a440_test_tone_prepare_frame(time, frame, (float)width_px, (float)height_px, seed);
+    a440_test_tone_render_rows(time, frame, width_px, height_px, 0, 1, seed, pixel_out, phys_index, grb_gamma);
+}
+
 /* Audio: generated from effect: a440_test_tone */
 static float a440_test_tone_eval_audio(float time, float seed, float sample_rate, float *phasor_state) {
     float __dsl_audio_out = 0.0f;
@@ -260,72 +368,255 @@ static float a440_test_tone_eval_audio(float time, float seed, float sample_rate
     return __dsl_audio_out;
 }
 
+static dsl_shader_param_t aurora_params[3] = {
+    { .name = "speed", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "thickness", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "alpha_scale", .value = 0.0f, .pinned = 0, .settable = 1 },
+};
+
+typedef struct {
+    float dsl_param_speed_0;
+    float dsl_param_thickness_1;
+    float dsl_param_alpha_scale_2;
+} aurora_uniforms_t;
+
+static aurora_uniforms_t aurora_uniforms;
+
+/* Generated from effect: aurora_v1 */
+static void aurora_prepare_frame(float time, float frame, float width, float height, float seed) {
+    const float dsl_param_speed_0 DSL_MAYBE_UNUSED = aurora_params[0].pinned ? aurora_params[0].value : 0.280000f;
+    const float dsl_param_thickness_1 DSL_MAYBE_UNUSED = aurora_params[1].pinned ? aurora_params[1].value : 3.800000f;
+    const float dsl_param_alpha_scale_2 DSL_MAYBE_UNUSED = aurora_params[2].pinned ? aurora_params[2].value : 0.450000f;
+    aurora_uniforms.dsl_param_speed_0 = dsl_param_speed_0;
+    aurora_uniforms.dsl_param_thickness_1 = dsl_param_thickness_1;
+    aurora_uniforms.dsl_param_alpha_scale_2 = dsl_param_alpha_scale_2;
+}
+
 /* Generated from effect: aurora_v1 */
 static void aurora_eval_pixel(float time, float frame, float x, float y, float width, float height, float seed, dsl_color_t *out_color) {
-    const float dsl_param_speed_0 DSL_MAYBE_UNUSED = 0.280000f;
-    const float dsl_param_thickness_1 DSL_MAYBE_UNUSED = 3.800000f;
-    const float dsl_param_alpha_scale_2 DSL_MAYBE_UNUSED = 0.450000f;
     dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
     /* layer ribbon */
     const float dsl_let_theta_3 DSL_MAYBE_UNUSED = ((x / width) * 6.28318530717958647692f);
-    const float dsl_let_center_4 DSL_MAYBE_UNUSED = ((height * 0.500000f) + (sinf((dsl_let_theta_3 + (time * dsl_param_speed_0))) * 6.000000f));
-    const float dsl_let_d_5 DSL_MAYBE_UNUSED = dsl_box((dsl_vec2_t){ .x = 0.000000f, .y = (y - dsl_let_center_4) }, (dsl_vec2_t){ .x = width, .y = dsl_param_thickness_1 });
-    const float dsl_let_a_6 DSL_MAYBE_UNUSED = ((1.000000f - dsl_smoothstep(0.000000f, 1.900000f, dsl_let_d_5)) * dsl_param_alpha_scale_2);
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = 0.350000f, .g = 0.950000f, .b = 0.750000f, .a = fminf(dsl_let_a_6, 1.000000f) }, __dsl_out);
+    const float dsl_let_center_4 DSL_MAYBE_UNUSED = ((height * 0.500000f) + (sinf((dsl_let_theta_3 + (time * aurora_uniforms.dsl_param_speed_0))) * 6.000000f));
+    if (DSL_NEAR_BOX(0.000000f, (y - dsl_let_center_4), (width + 1.900000f), (aurora_uniforms.dsl_param_thickness_1 + 1.900000f))) {
+        const float dsl_let_d_5 DSL_MAYBE_UNUSED = dsl_box((dsl_vec2_t){ .x = 0.000000f, .y = (y - dsl_let_center_4) }, (dsl_vec2_t){ .x = width, .y = aurora_uniforms.dsl_param_thickness_1 });
+        const float dsl_let_a_6 DSL_MAYBE_UNUSED = ((1.000000f - dsl_smoothstep(0.000000f, 1.900000f, dsl_let_d_5)) * aurora_uniforms.dsl_param_alpha_scale_2);
+        {
+            const float __dsl_blend_a = fminf(dsl_let_a_6, 1.000000f);
+            if (!(__dsl_blend_a <= 0.0f)) {
+                __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = 0.350000f, .g = 0.950000f, .b = 0.750000f, .a = __dsl_blend_a }, __dsl_out);
+            }
+        }
+    }
     *out_color = __dsl_out;
 }
 
+/* Generated from effect: aurora_v1 */
+static void aurora_render_rows(float time, float frame, int width_px, int height_px, int row_first, int row_step, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    const float width DSL_MAYBE_UNUSED = (float)width_px;
+    const float height DSL_MAYBE_UNUSED = (float)height_px;
+    for (int py = row_first; py < height_px; py += row_step) {
+        const float y DSL_MAYBE_UNUSED = (float)py;
+        for (int px = 0; px < width_px; px++) {
+            const float x DSL_MAYBE_UNUSED = (float)px;
+            dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
+            /* layer ribbon */
+            const float dsl_let_theta_3 DSL_MAYBE_UNUSED = ((x / width) * 6.28318530717958647692f);
+            const float dsl_let_center_4 DSL_MAYBE_UNUSED = ((height * 0.500000f) + (sinf((dsl_let_theta_3 + (time * aurora_uniforms.dsl_param_speed_0))) * 6.000000f));
+            if (DSL_NEAR_BOX(0.000000f, (y - dsl_let_center_4), (width + 1.900000f), (aurora_uniforms.dsl_param_thickness_1 + 1.900000f))) {
+                const float dsl_let_d_5 DSL_MAYBE_UNUSED = dsl_box((dsl_vec2_t){ .x = 0.000000f, .y = (y - dsl_let_center_4) }, (dsl_vec2_t){ .x = width, .y = aurora_uniforms.dsl_param_thickness_1 });
+                const float dsl_let_a_6 DSL_MAYBE_UNUSED = ((1.000000f - dsl_smoothstep(0.000000f, 1.900000f, dsl_let_d_5)) * aurora_uniforms.dsl_param_alpha_scale_2);
+                {
+                    const float __dsl_blend_a = fminf(dsl_let_a_6, 1.000000f);
+                    if (!(__dsl_blend_a <= 0.0f)) {
+                        __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = 0.350000f, .g = 0.950000f, .b = 0.750000f, .a = __dsl_blend_a }, __dsl_out);
+                    }
+                }
+            }
+            dsl_store_pixel(pixel_out + (uint32_t)phys_index[py * width_px + px] * 3U, __dsl_out, grb_gamma);
+        }
+    }
+}
+
+/* Generated from effect: aurora_v1 */
+static void aurora_render_frame(float time, float frame, int width_px, int height_px, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    aurora_prepare_frame(time, frame, (float)width_px, (float)height_px, seed);
+    aurora_render_rows(time, frame, width_px, height_px, 0, 1, seed, pixel_out, phys_index, grb_gamma);
+}
+
+typedef struct {
+    float dsl_let_t_warp_0;
+    float dsl_let_t_hue_1;
+    float dsl_let_t_breathe_2;
+    float dsl_let_t_crest_3;
+    float dsl_let_t_accent_4;
+    float dsl_let_w0_8[4];
+    float dsl_let_w1_9[4];
+    float dsl_let_w2_10[4];
+    float dsl_let_w3_11[4];
+    float dsl_let_phase_12[4];
+    float dsl_let_speed_13[4];
+    float dsl_let_wave_14[4];
+    float dsl_let_width_base_15[4];
+    float dsl_let_alpha_scale_16[4];
+    float dsl_let_breathing_17[4];
+    float dsl_let_thickness_18[4];
+} aurora_ribbons_classic_uniforms_t;
+
+static aurora_ribbons_classic_uniforms_t aurora_ribbons_classic_uniforms;
+
 /* Generated from effect: aurora_ribbons_classic_v1 */
-static void aurora_ribbons_classic_eval_frame(float time, float frame) {
+static void aurora_ribbons_classic_prepare_frame(float time, float frame, float width, float height, float seed) {
     const float dsl_let_t_warp_0 DSL_MAYBE_UNUSED = (time * 0.120000f);
     const float dsl_let_t_hue_1 DSL_MAYBE_UNUSED = (time * 0.200000f);
     const float dsl_let_t_breathe_2 DSL_MAYBE_UNUSED = (time * 0.350000f);
     const float dsl_let_t_crest_3 DSL_MAYBE_UNUSED = (time * 0.500000f);
     const float dsl_let_t_accent_4 DSL_MAYBE_UNUSED = (time * 0.550000f);
+    for (int32_t dsl_iter_i_5 = 0; dsl_iter_i_5 < 4; dsl_iter_i_5++) {
+        const float dsl_index_i_6 DSL_MAYBE_UNUSED = (float)dsl_iter_i_5;
+        const float dsl_let_layer_index_7 DSL_MAYBE_UNUSED = dsl_index_i_6;
+        const float dsl_let_w0_8 DSL_MAYBE_UNUSED = dsl_clamp((1.000000f - fabsf((dsl_let_layer_index_7 - 0.000000f))), 0.000000f, 1.000000f);
+        const float dsl_let_w1_9 DSL_MAYBE_UNUSED = dsl_clamp((1.000000f - fabsf((dsl_let_layer_index_7 - 1.000000f))), 0.000000f, 1.000000f);
+        const float dsl_let_w2_10 DSL_MAYBE_UNUSED = dsl_clamp((1.000000f - fabsf((dsl_let_layer_index_7 - 2.000000f))), 0.000000f, 1.000000f);
+        const float dsl_let_w3_11 DSL_MAYBE_UNUSED = dsl_clamp((1.000000f - fabsf((dsl_let_layer_index_7 - 3.000000f))), 0.000000f, 1.000000f);
+        const float dsl_let_phase_12 DSL_MAYBE_UNUSED = ((((0.000000f * dsl_let_w0_8) + (1.500000f * dsl_let_w1_9)) + (2.700000f * dsl_let_w2_10)) + (4.000000f * dsl_let_w3_11));
+        const float dsl_let_speed_13 DSL_MAYBE_UNUSED = ((((0.280000f * dsl_let_w0_8) + (0.340000f * dsl_let_w1_9)) + (0.220000f * dsl_let_w2_10)) + (0.300000f * dsl_let_w3_11));
+        const float dsl_let_wave_14 DSL_MAYBE_UNUSED = ((((0.900000f * dsl_let_w0_8) + (1.200000f * dsl_let_w1_9)) + (1.600000f * dsl_let_w2_10)) + (1.050000f * dsl_let_w3_11));
+        const float dsl_let_width_base_15 DSL_MAYBE_UNUSED = ((((4.200000f * dsl_let_w0_8) + (3.800000f * dsl_let_w1_9)) + (3.200000f * dsl_let_w2_10)) + (2.900000f * dsl_let_w3_11));
+        const float dsl_let_alpha_scale_16 DSL_MAYBE_UNUSED = (0.160000f + (dsl_let_layer_index_7 * 0.050000f));
+        const float dsl_let_breathing_17 DSL_MAYBE_UNUSED = sinf(((dsl_let_t_breathe_2 + dsl_let_phase_12) + (dsl_let_layer_index_7 * 0.400000f)));
+        const float dsl_let_thickness_18 DSL_MAYBE_UNUSED = (dsl_let_width_base_15 + (dsl_let_breathing_17 * 0.900000f));
+        aurora_ribbons_classic_uniforms.dsl_let_w0_8[dsl_iter_i_5] = dsl_let_w0_8;
+        aurora_ribbons_classic_uniforms.dsl_let_w1_9[dsl_iter_i_5] = dsl_let_w1_9;
+        aurora_ribbons_classic_uniforms.dsl_let_w2_10[dsl_iter_i_5] = dsl_let_w2_10;
+        aurora_ribbons_classic_uniforms.dsl_let_w3_11[dsl_iter_i_5] = dsl_let_w3_11;
+        aurora_ribbons_classic_uniforms.dsl_let_phase_12[dsl_iter_i_5] = dsl_let_phase_12;
+        aurora_ribbons_classic_uniforms.dsl_let_speed_13[dsl_iter_i_5] = dsl_let_speed_13;
+        aurora_ribbons_classic_uniforms.dsl_let_wave_14[dsl_iter_i_5] = dsl_let_wave_14;
+        aurora_ribbons_classic_uniforms.dsl_let_width_base_15[dsl_iter_i_5] = dsl_let_width_base_15;
+        aurora_ribbons_classic_uniforms.dsl_let_alpha_scale_16[dsl_iter_i_5] = dsl_let_alpha_scale_16;
+        aurora_ribbons_classic_uniforms.dsl_let_breathing_17[dsl_iter_i_5] = dsl_let_breathing_17;
+        aurora_ribbons_classic_uniforms.dsl_let_thickness_18[dsl_iter_i_5] = dsl_let_thickness_18;
+    }
+    aurora_ribbons_classic_uniforms.dsl_let_t_warp_0 = dsl_let_t_warp_0;
+    aurora_ribbons_classic_uniforms.dsl_let_t_hue_1 = dsl_let_t_hue_1;
+    aurora_ribbons_classic_uniforms.dsl_let_t_breathe_2 = dsl_let_t_breathe_2;
+    aurora_ribbons_classic_uniforms.dsl_let_t_crest_3 = dsl_let_t_crest_3;
+    aurora_ribbons_classic_uniforms.dsl_let_t_accent_4 = dsl_let_t_accent_4;
 }
 
 /* Generated from effect: aurora_ribbons_classic_v1 */
 static void aurora_ribbons_classic_eval_pixel(float time, float frame, float x, float y, float width, float height, float seed, dsl_color_t *out_color) {
-    const float dsl_let_t_warp_0 DSL_MAYBE_UNUSED = (time * 0.120000f);
-    const float dsl_let_t_hue_1 DSL_MAYBE_UNUSED = (time * 0.200000f);
-    const float dsl_let_t_breathe_2 DSL_MAYBE_UNUSED = (time * 0.350000f);
-    const float dsl_let_t_crest_3 DSL_MAYBE_UNUSED = (time * 0.500000f);
-    const float dsl_let_t_accent_4 DSL_MAYBE_UNUSED = (time * 0.550000f);
     dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
     /* layer ribbons */
-    const float dsl_let_theta_5 DSL_MAYBE_UNUSED = ((x / width) * 6.28318530717958647692f);
-    for (int32_t dsl_iter_i_6 = 0; dsl_iter_i_6 < 4; dsl_iter_i_6++) {
-        const float dsl_index_i_7 DSL_MAYBE_UNUSED = (float)dsl_iter_i_6;
-        const float dsl_let_layer_index_8 DSL_MAYBE_UNUSED = dsl_index_i_7;
-        const float dsl_let_w0_9 DSL_MAYBE_UNUSED = dsl_clamp((1.000000f - fabsf((dsl_let_layer_index_8 - 0.000000f))), 0.000000f, 1.000000f);
-        const float dsl_let_w1_10 DSL_MAYBE_UNUSED = dsl_clamp((1.000000f - fabsf((dsl_let_layer_index_8 - 1.000000f))), 0.000000f, 1.000000f);
-        const float dsl_let_w2_11 DSL_MAYBE_UNUSED = dsl_clamp((1.000000f - fabsf((dsl_let_layer_index_8 - 2.000000f))), 0.000000f, 1.000000f);
-        const float dsl_let_w3_12 DSL_MAYBE_UNUSED = dsl_clamp((1.000000f - fabsf((dsl_let_layer_index_8 - 3.000000f))), 0.000000f, 1.000000f);
-        const float dsl_let_phase_13 DSL_MAYBE_UNUSED = ((((0.000000f * dsl_let_w0_9) + (1.500000f * dsl_let_w1_10)) + (2.700000f * dsl_let_w2_11)) + (4.000000f * dsl_let_w3_12));
-        const float dsl_let_speed_14 DSL_MAYBE_UNUSED = ((((0.280000f * dsl_let_w0_9) + (0.340000f * dsl_let_w1_10)) + (0.220000f * dsl_let_w2_11)) + (0.300000f * dsl_let_w3_12));
-        const float dsl_let_wave_15 DSL_MAYBE_UNUSED = ((((0.900000f * dsl_let_w0_9) + (1.200000f * dsl_let_w1_10)) + (1.600000f * dsl_let_w2_11)) + (1.050000f * dsl_let_w3_12));
-        const float dsl_let_width_base_16 DSL_MAYBE_UNUSED = ((((4.200000f * dsl_let_w0_9) + (3.800000f * dsl_let_w1_10)) + (3.200000f * dsl_let_w2_11)) + (2.900000f * dsl_let_w3_12));
-        const float dsl_let_alpha_scale_17 DSL_MAYBE_UNUSED = (0.160000f + (dsl_let_layer_index_8 * 0.050000f));
-        const float dsl_let_warp_18 DSL_MAYBE_UNUSED = (sinf((((dsl_let_theta_5 * 3.000000f) + dsl_let_t_warp_0) + (dsl_let_phase_13 * 0.500000f))) * (0.220000f * dsl_let_wave_15));
-        const float dsl_let_flow_19 DSL_MAYBE_UNUSED = sinf((((dsl_let_theta_5 + (time * dsl_let_speed_14)) + dsl_let_phase_13) + dsl_let_warp_18));
-        const float dsl_let_sweep_20 DSL_MAYBE_UNUSED = sinf(((((dsl_let_theta_5 * 2.000000f) - (time * (0.220000f + (dsl_let_speed_14 * 0.150000f)))) + (dsl_let_phase_13 * 0.700000f)) + dsl_let_warp_18));
-        const float dsl_let_base_21 DSL_MAYBE_UNUSED = ((0.500000f + (0.340000f * dsl_let_flow_19)) + (0.080000f * dsl_let_warp_18));
-        const float dsl_let_centerline_22 DSL_MAYBE_UNUSED = (((1.000000f - dsl_let_base_21) * (height - 1.000000f)) + (dsl_let_sweep_20 * 2.900000f));
-        const float dsl_let_breathing_23 DSL_MAYBE_UNUSED = sinf(((dsl_let_t_breathe_2 + dsl_let_phase_13) + (dsl_let_layer_index_8 * 0.400000f)));
-        const float dsl_let_thickness_24 DSL_MAYBE_UNUSED = (dsl_let_width_base_16 + (dsl_let_breathing_23 * 0.900000f));
-        const float dsl_let_band_d_25 DSL_MAYBE_UNUSED = dsl_box((dsl_vec2_t){ .x = 0.000000f, .y = (y - dsl_let_centerline_22) }, (dsl_vec2_t){ .x = width, .y = dsl_let_thickness_24 });
-        const float dsl_let_band_alpha_26 DSL_MAYBE_UNUSED = ((1.000000f - dsl_smoothstep(0.000000f, 1.900000f, dsl_let_band_d_25)) * dsl_let_alpha_scale_17);
-        const float dsl_let_hue_phase_27 DSL_MAYBE_UNUSED = ((dsl_let_t_hue_1 + dsl_let_phase_13) + dsl_let_theta_5);
-        __dsl_out = dsl_blend_over((dsl_color_t){ .r = (0.180000f + (0.220000f * (0.500000f + (0.500000f * sinf((dsl_let_hue_phase_27 + 2.000000f)))))), .g = (0.420000f + (0.460000f * (0.500000f + (0.500000f * sinf(dsl_let_hue_phase_27))))), .b = (0.460000f + (0.420000f * (0.500000f + (0.500000f * sinf((dsl_let_hue_phase_27 + 4.000000f)))))), .a = dsl_let_band_alpha_26 }, __dsl_out);
-        const float dsl_let_accent_center_28 DSL_MAYBE_UNUSED = (dsl_let_centerline_22 + (sinf((((dsl_let_theta_5 * 4.000000f) + dsl_let_t_accent_4) + dsl_let_phase_13)) * 1.300000f));
-        const float dsl_let_accent_d_29 DSL_MAYBE_UNUSED = dsl_box((dsl_vec2_t){ .x = 0.000000f, .y = (y - dsl_let_accent_center_28) }, (dsl_vec2_t){ .x = width, .y = fmaxf(0.400000f, (dsl_let_thickness_24 * 0.260000f)) });
-        const float dsl_let_crest_30 DSL_MAYBE_UNUSED = dsl_smoothstep(0.550000f, 1.000000f, sinf((((dsl_let_theta_5 * 2.000000f) + dsl_let_t_crest_3) + dsl_let_phase_13)));
-        const float dsl_let_accent_alpha_31 DSL_MAYBE_UNUSED = (((1.000000f - dsl_smoothstep(0.000000f, 0.950000f, dsl_let_accent_d_29)) * dsl_let_crest_30) * 0.200000f);
-        __dsl_out = dsl_blend_over((dsl_color_t){ .r = 0.880000f, .g = 0.900000f, .b = 0.950000f, .a = dsl_let_accent_alpha_31 }, __dsl_out);
+    const float dsl_let_theta_19 DSL_MAYBE_UNUSED = ((x / width) * 6.28318530717958647692f);
+    for (int32_t dsl_iter_i_20 = 0; dsl_iter_i_20 < 4; dsl_iter_i_20++) {
+        const float dsl_index_i_21 DSL_MAYBE_UNUSED = (float)dsl_iter_i_20;
+        const float dsl_let_layer_index_22 DSL_MAYBE_UNUSED = dsl_index_i_21;
+        const float dsl_let_w0_23 DSL_MAYBE_UNUSED = aurora_ribbons_classic_uniforms.dsl_let_w0_8[dsl_iter_i_20];
+        const float dsl_let_w1_24 DSL_MAYBE_UNUSED = aurora_ribbons_classic_uniforms.dsl_let_w1_9[dsl_iter_i_20];
+        const float dsl_let_w2_25 DSL_MAYBE_UNUSED = aurora_ribbons_classic_uniforms.dsl_let_w2_10[dsl_iter_i_20];
+        const float dsl_let_w3_26 DSL_MAYBE_UNUSED = aurora_ribbons_classic_uniforms.dsl_let_w3_11[dsl_iter_i_20];
+        const float dsl_let_phase_27 DSL_MAYBE_UNUSED = aurora_ribbons_classic_uniforms.dsl_let_phase_12[dsl_iter_i_20];
+        const float dsl_let_speed_28 DSL_MAYBE_UNUSED = aurora_ribbons_classic_uniforms.dsl_let_speed_13[dsl_iter_i_20];
+        const float dsl_let_wave_29 DSL_MAYBE_UNUSED = aurora_ribbons_classic_uniforms.dsl_let_wave_14[dsl_iter_i_20];
+        const float dsl_let_width_base_30 DSL_MAYBE_UNUSED = aurora_ribbons_classic_uniforms.dsl_let_width_base_15[dsl_iter_i_20];
+        const float dsl_let_alpha_scale_31 DSL_MAYBE_UNUSED = aurora_ribbons_classic_uniforms.dsl_let_alpha_scale_16[dsl_iter_i_20];
+        const float dsl_let_warp_32 DSL_MAYBE_UNUSED = (sinf((((dsl_let_theta_19 * 3.000000f) + aurora_ribbons_classic_uniforms.dsl_let_t_warp_0) + (dsl_let_phase_27 * 0.500000f))) * (0.220000f * dsl_let_wave_29));
+        const float dsl_let_flow_33 DSL_MAYBE_UNUSED = sinf((((dsl_let_theta_19 + (time * dsl_let_speed_28)) + dsl_let_phase_27) + dsl_let_warp_32));
+        const float dsl_let_sweep_34 DSL_MAYBE_UNUSED = sinf(((((dsl_let_theta_19 * 2.000000f) - (time * (0.220000f + (dsl_let_speed_28 * 0.150000f)))) + (dsl_let_phase_27 * 0.700000f)) + dsl_let_warp_32));
+        const float dsl_let_base_35 DSL_MAYBE_UNUSED = ((0.500000f + (0.340000f * dsl_let_flow_33)) + (0.080000f * dsl_let_warp_32));
+        const float dsl_let_centerline_36 DSL_MAYBE_UNUSED = (((1.000000f - dsl_let_base_35) * (height - 1.000000f)) + (dsl_let_sweep_34 * 2.900000f));
+        const float dsl_let_breathing_37 DSL_MAYBE_UNUSED = aurora_ribbons_classic_uniforms.dsl_let_breathing_17[dsl_iter_i_20];
+        const float dsl_let_thickness_38 DSL_MAYBE_UNUSED = aurora_ribbons_classic_uniforms.dsl_let_thickness_18[dsl_iter_i_20];
+        const float dsl_let_band_d_39 DSL_MAYBE_UNUSED = dsl_box((dsl_vec2_t){ .x = 0.000000f, .y = (y - dsl_let_centerline_36) }, (dsl_vec2_t){ .x = width, .y = dsl_let_thickness_38 });
+        const float dsl_let_band_alpha_40 DSL_MAYBE_UNUSED = ((1.000000f - dsl_smoothstep(0.000000f, 1.900000f, dsl_let_band_d_39)) * dsl_let_alpha_scale_31);
+        const float dsl_let_hue_phase_41 DSL_MAYBE_UNUSED = ((aurora_ribbons_classic_uniforms.dsl_let_t_hue_1 + dsl_let_phase_27) + dsl_let_theta_19);
+        {
+            const float __dsl_blend_a = dsl_let_band_alpha_40;
+            if (!(__dsl_blend_a <= 0.0f)) {
+                __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = (0.180000f + (0.220000f * (0.500000f + (0.500000f * sinf((dsl_let_hue_phase_41 + 2.000000f)))))), .g = (0.420000f + (0.460000f * (0.500000f + (0.500000f * sinf(dsl_let_hue_phase_41))))), .b = (0.460000f + (0.420000f * (0.500000f + (0.500000f * sinf((dsl_let_hue_phase_41 + 4.000000f)))))), .a = __dsl_blend_a }, __dsl_out);
+            }
+        }
+        const float dsl_let_accent_center_42 DSL_MAYBE_UNUSED = (dsl_let_centerline_36 + (sinf((((dsl_let_theta_19 * 4.000000f) + aurora_ribbons_classic_uniforms.dsl_let_t_accent_4) + dsl_let_phase_27)) * 1.300000f));
+        const float dsl_let_accent_d_43 DSL_MAYBE_UNUSED = dsl_box((dsl_vec2_t){ .x = 0.000000f, .y = (y - dsl_let_accent_center_42) }, (dsl_vec2_t){ .x = width, .y = fmaxf(0.400000f, (dsl_let_thickness_38 * 0.260000f)) });
+        const float dsl_let_crest_44 DSL_MAYBE_UNUSED = dsl_smoothstep(0.550000f, 1.000000f, sinf((((dsl_let_theta_19 * 2.000000f) + aurora_ribbons_classic_uniforms.dsl_let_t_crest_3) + dsl_let_phase_27)));
+        const float dsl_let_accent_alpha_45 DSL_MAYBE_UNUSED = (((1.000000f - dsl_smoothstep(0.000000f, 0.950000f, dsl_let_accent_d_43)) * dsl_let_crest_44) * 0.200000f);
+        {
+            const float __dsl_blend_a = dsl_let_accent_alpha_45;
+            if (!(__dsl_blend_a <= 0.0f)) {
+                __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = 0.880000f, .g = 0.900000f, .b = 0.950000f, .a = __dsl_blend_a }, __dsl_out);
+            }
+        }
     }
     *out_color = __dsl_out;
 }
 
+/* Generated from effect: aurora_ribbons_classic_v1 */
+static void aurora_ribbons_classic_render_rows(float time, float frame, int width_px, int height_px, int row_first, int row_step, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    const float width DSL_MAYBE_UNUSED = (float)width_px;
+    const float height DSL_MAYBE_UNUSED = (float)height_px;
+    for (int py = row_first; py < height_px; py += row_step) {
+        const float y DSL_MAYBE_UNUSED = (float)py;
+        for (int px = 0; px < width_px; px++) {
+            const float x DSL_MAYBE_UNUSED = (float)px;
+            dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
+            /* layer ribbons */
+            const float dsl_let_theta_19 DSL_MAYBE_UNUSED = ((x / width) * 6.28318530717958647692f);
+            for (int32_t dsl_iter_i_20 = 0; dsl_iter_i_20 < 4; dsl_iter_i_20++) {
+                const float dsl_index_i_21 DSL_MAYBE_UNUSED = (float)dsl_iter_i_20;
+                const float dsl_let_layer_index_22 DSL_MAYBE_UNUSED = dsl_index_i_21;
+                const float dsl_let_w0_23 DSL_MAYBE_UNUSED = aurora_ribbons_classic_uniforms.dsl_let_w0_8[dsl_iter_i_20];
+                const float dsl_let_w1_24 DSL_MAYBE_UNUSED = aurora_ribbons_classic_uniforms.dsl_let_w1_9[dsl_iter_i_20];
+                const float dsl_let_w2_25 DSL_MAYBE_UNUSED = aurora_ribbons_classic_uniforms.dsl_let_w2_10[dsl_iter_i_20];
+                const float dsl_let_w3_26 DSL_MAYBE_UNUSED = aurora_ribbons_classic_uniforms.dsl_let_w3_11[dsl_iter_i_20];
+                const float dsl_let_phase_27 DSL_MAYBE_UNUSED = aurora_ribbons_classic_uniforms.dsl_let_phase_12[dsl_iter_i_20];
+                const float dsl_let_speed_28 DSL_MAYBE_UNUSED = aurora_ribbons_classic_uniforms.dsl_let_speed_13[dsl_iter_i_20];
+                const float dsl_let_wave_29 DSL_MAYBE_UNUSED = aurora_ribbons_classic_uniforms.dsl_let_wave_14[dsl_iter_i_20];
+                const float dsl_let_width_base_30 DSL_MAYBE_UNUSED = aurora_ribbons_classic_uniforms.dsl_let_width_base_15[dsl_iter_i_20];
+                const float dsl_let_alpha_scale_31 DSL_MAYBE_UNUSED = aurora_ribbons_classic_uniforms.dsl_let_alpha_scale_16[dsl_iter_i_20];
+                const float dsl_let_warp_32 DSL_MAYBE_UNUSED = (sinf((((dsl_let_theta_19 * 3.000000f) + aurora_ribbons_classic_uniforms.dsl_let_t_warp_0) + (dsl_let_phase_27 * 0.500000f))) * (0.220000f * dsl_let_wave_29));
+                const float dsl_let_flow_33 DSL_MAYBE_UNUSED = sinf((((dsl_let_theta_19 + (time * dsl_let_speed_28)) + dsl_let_phase_27) + dsl_let_warp_32));
+                const float dsl_let_sweep_34 DSL_MAYBE_UNUSED = sinf(((((dsl_let_theta_19 * 2.000000f) - (time * (0.220000f + (dsl_let_speed_28 * 0.150000f)))) + (dsl_let_phase_27 * 0.700000f)) + dsl_let_warp_32));
+                const float dsl_let_base_35 DSL_MAYBE_UNUSED = ((0.500000f + (0.340000f * dsl_let_flow_33)) + (0.080000f * dsl_let_warp_32));
+                const float dsl_let_centerline_36 DSL_MAYBE_UNUSED = (((1.000000f - dsl_let_base_35) * (height - 1.000000f)) + (dsl_let_sweep_34 * 2.900000f));
+                const float dsl_let_breathing_37 DSL_MAYBE_UNUSED = aurora_ribbons_classic_uniforms.dsl_let_breathing_17[dsl_iter_i_20];
+                const float dsl_let_thickness_38 DSL_MAYBE_UNUSED = aurora_ribbons_classic_uniforms.dsl_let_thickness_18[dsl_iter_i_20];
+                const float dsl_let_band_d_39 DSL_MAYBE_UNUSED = dsl_box((dsl_vec2_t){ .x = 0.000000f, .y = (y - dsl_let_centerline_36) }, (dsl_vec2_t){ .x = width, .y = dsl_let_thickness_38 });
+                const float dsl_let_band_alpha_40 DSL_MAYBE_UNUSED = ((1.000000f - dsl_smoothstep(0.000000f, 1.900000f, dsl_let_band_d_39)) * dsl_let_alpha_scale_31);
+                const float dsl_let_hue_phase_41 DSL_MAYBE_UNUSED = ((aurora_ribbons_classic_uniforms.dsl_let_t_hue_1 + dsl_let_phase_27) + dsl_let_theta_19);
+                {
+                    const float __dsl_blend_a = dsl_let_band_alpha_40;
+                    if (!(__dsl_blend_a <= 0.0f)) {
+                        __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = (0.180000f + (0.220000f * (0.500000f + (0.500000f * sinf((dsl_let_hue_phase_41 + 2.000000f)))))), .g = (0.420000f + (0.460000f * (0.500000f + (0.500000f * sinf(dsl_let_hue_phase_41))))), .b = (0.460000f + (0.420000f * (0.500000f + (0.500000f * sinf((dsl_let_hue_phase_41 + 4.000000f)))))), .a = __dsl_blend_a }, __dsl_out);
+                    }
+                }
+                const float dsl_let_accent_center_42 DSL_MAYBE_UNUSED = (dsl_let_centerline_36 + (sinf((((dsl_let_theta_19 * 4.000000f) + aurora_ribbons_classic_uniforms.dsl_let_t_accent_4) + dsl_let_phase_27)) * 1.300000f));
+                const float dsl_let_accent_d_43 DSL_MAYBE_UNUSED = dsl_box((dsl_vec2_t){ .x = 0.000000f, .y = (y - dsl_let_accent_center_42) }, (dsl_vec2_t){ .x = width, .y = fmaxf(0.400000f, (dsl_let_thickness_38 * 0.260000f)) });
+                const float dsl_let_crest_44 DSL_MAYBE_UNUSED = dsl_smoothstep(0.550000f, 1.000000f, sinf((((dsl_let_theta_19 * 2.000000f) + aurora_ribbons_classic_uniforms.dsl_let_t_crest_3) + dsl_let_phase_27)));
+                const float dsl_let_accent_alpha_45 DSL_MAYBE_UNUSED = (((1.000000f - dsl_smoothstep(0.000000f, 0.950000f, dsl_let_accent_d_43)) * dsl_let_crest_44) * 0.200000f);
+                {
+                    const float __dsl_blend_a = dsl_let_accent_alpha_45;
+                    if (!(__dsl_blend_a <= 0.0f)) {
+                        __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = 0.880000f, .g = 0.900000f, .b = 0.950000f, .a = __dsl_blend_a }, __dsl_out);
+                    }
+                }
+            }
+            dsl_store_pixel(pixel_out + (uint32_t)phys_index[py * width_px + px] * 3U, __dsl_out, grb_gamma);
+        }
+    }
+}
+
+/* Generated from effect: aurora_ribbons_classic_v1 */
+static void aurora_ribbons_classic_render_frame(float time, float frame, int width_px, int height_px, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    aurora_ribbons_classic_prepare_frame(time, frame, (float)width_px, (float)height_px, seed);
+    aurora_ribbons_classic_render_rows(time, frame, width_px, height_px, 0, 1, seed, pixel_out, phys_index, grb_gamma);
+}
+
+/* Generated from effect: blink */
+static void blink_prepare_frame(float time, float frame, float width, float height, float seed) {
+}
+
 /* Generated from effect: blink */
 static void blink_eval_pixel(float time, float frame, float x, float y, float width, float height, float seed, dsl_color_t *out_color) {
     dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
@@ -334,217 +625,778 @@ static void blink_eval_pixel(float time, float frame, float x, float y, float wi
     const float dsl_let_g_1 DSL_MAYBE_UNUSED = ((sinf((((time * 13.000000f) + (-(x))) + (y / 2.200000f))) + 1.000000f) / 2.000000f);
     const float dsl_let_b_2 DSL_MAYBE_UNUSED = ((sinf((((time * 17.000000f) + x) + (y / 2.400000f))) + 1.000000f) / 2.000000f);
     const float dsl_let_a_3 DSL_MAYBE_UNUSED = sqrtf(((sinf(((((-(time)) * 2.000000f) + (x / 5.000000f)) + (y / 2.000000f))) + 1.000000f) / 2.000000f));
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = dsl_let_r_0, .g = dsl_let_g_1, .b = dsl_let_b_2, .a = dsl_let_a_3 }, __dsl_out);
+    {
+        const float __dsl_blend_a = dsl_let_a_3;
+        if (!(__dsl_blend_a <= 0.0f)) {
+            __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_let_r_0, .g = dsl_let_g_1, .b = dsl_let_b_2, .a = __dsl_blend_a }, __dsl_out);
+        }
+    }
     *out_color = __dsl_out;
 }
 
+/* Generated from effect: blink */
+static void blink_render_rows(float time, float frame, int width_px, int height_px, int row_first, int row_step, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    const float width DSL_MAYBE_UNUSED = (float)width_px;
+    const float height DSL_MAYBE_UNUSED = (float)height_px;
+    for (int py = row_first; py < height_px; py += row_step) {
+        const float y DSL_MAYBE_UNUSED = (float)py;
+        for (int px = 0; px < width_px; px++) {
+            const float x DSL_MAYBE_UNUSED = (float)px;
+            dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
+            /* layer l */
+            const float dsl_let_r_0 DSL_MAYBE_UNUSED = ((sinf((((time * 11.000000f) + (-(x))) + (y / 2.000000f))) + 1.000000f) / 2.000000f);
+            const float dsl_let_g_1 DSL_MAYBE_UNUSED = ((sinf((((time * 13.000000f) + (-(x))) + (y / 2.200000f))) + 1.000000f) / 2.000000f);
+            const float dsl_let_b_2 DSL_MAYBE_UNUSED = ((sinf((((time * 17.000000f) + x) + (y / 2.400000f))) + 1.000000f) / 2.000000f);
+            const float dsl_let_a_3 DSL_MAYBE_UNUSED = sqrtf(((sinf(((((-(time)) * 2.000000f) + (x / 5.000000f)) + (y / 2.000000f))) + 1.000000f) / 2.000000f));
+            {
+                const float __dsl_blend_a = dsl_let_a_3;
+                if (!(__dsl_blend_a <= 0.0f)) {
+                    __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_let_r_0, .g = dsl_let_g_1, .b = dsl_let_b_2, .a = __dsl_blend_a }, __dsl_out);
+                }
+            }
+            dsl_store_pixel(pixel_out + (uint32_t)phys_index[py * width_px + px] * 3U, __dsl_out, grb_gamma);
+        }
+    }
+}
+
+/* Generated from effect: blink */
+static void blink_render_frame(float time, float frame, int width_px, int height_px, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    blink_prepare_frame(time, frame, (float)width_px, (float)height_px, seed);
+    blink_render_rows(time, frame, width_px, height_px, 0, 1, seed, pixel_out, phys_index, grb_gamma);
+}
+
+static dsl_shader_param_t campfire_params[4] = {
+    { .name = "pulse", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "tongue_x", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "tongue_y", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "tongue_r", .value = 0.0f, .pinned = 0, .settable = 1 },
+};
+
+typedef struct {
+    float dsl_param_pulse_0;
+    float dsl_param_tongue_x_1;
+    float dsl_param_tongue_y_2;
+    float dsl_param_tongue_r_3;
+} campfire_uniforms_t;
+
+static campfire_uniforms_t campfire_uniforms;
+
+/* Generated from effect: campfire_v1 */
+static void campfire_prepare_frame(float time, float frame, float width, float height, float seed) {
+    const float dsl_param_pulse_0 DSL_MAYBE_UNUSED = campfire_params[0].pinned ? campfire_params[0].value : 0.900000f;
+    const float dsl_param_tongue_x_1 DSL_MAYBE_UNUSED = campfire_params[1].pinned ? campfire_params[1].value : 14.000000f;
+    const float dsl_param_tongue_y_2 DSL_MAYBE_UNUSED = campfire_params[2].pinned ? campfire_params[2].value : 28.000000f;
+    const float dsl_param_tongue_r_3 DSL_MAYBE_UNUSED = campfire_params[3].pinned ? campfire_params[3].value : 2.300000f;
+    campfire_uniforms.dsl_param_pulse_0 = dsl_param_pulse_0;
+    campfire_uniforms.dsl_param_tongue_x_1 = dsl_param_tongue_x_1;
+    campfire_uniforms.dsl_param_tongue_y_2 = dsl_param_tongue_y_2;
+    campfire_uniforms.dsl_param_tongue_r_3 = dsl_param_tongue_r_3;
+}
+
 /* Generated from effect: campfire_v1 */
 static void campfire_eval_pixel(float time, float frame, float x, float y, float width, float height, float seed, dsl_color_t *out_color) {
-    const float dsl_param_pulse_0 DSL_MAYBE_UNUSED = 0.900000f;
-    const float dsl_param_tongue_x_1 DSL_MAYBE_UNUSED = 14.000000f;
-    const float dsl_param_tongue_y_2 DSL_MAYBE_UNUSED = 28.000000f;
-    const float dsl_param_tongue_r_3 DSL_MAYBE_UNUSED = 2.300000f;
     dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
     /* layer embers */
-    const float dsl_let_d_4 DSL_MAYBE_UNUSED = dsl_box((dsl_vec2_t){ .x = dsl_wrapdx(x, (width * 0.500000f), width), .y = (y - (height - 1.400000f)) }, (dsl_vec2_t){ .x = 2.000000f, .y = 1.100000f });
-    const float dsl_let_a_5 DSL_MAYBE_UNUSED = ((1.000000f - dsl_smoothstep((-(0.100000f)), 1.250000f, dsl_let_d_4)) * 0.550000f);
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = 0.950000f, .g = 0.450000f, .b = 0.080000f, .a = dsl_let_a_5 }, __dsl_out);
+    if (DSL_NEAR_BOX(dsl_wrapdx(x, (width * 0.500000f), width), (y - (height - 1.400000f)), (2.000000f + 1.250000f), (1.100000f + 1.250000f))) {
+        const float dsl_let_d_4 DSL_MAYBE_UNUSED = dsl_box((dsl_vec2_t){ .x = dsl_wrapdx(x, (width * 0.500000f), width), .y = (y - (height - 1.400000f)) }, (dsl_vec2_t){ .x = 2.000000f, .y = 1.100000f });
+        const float dsl_let_a_5 DSL_MAYBE_UNUSED = ((1.000000f - dsl_smoothstep((-(0.100000f)), 1.250000f, dsl_let_d_4)) * 0.550000f);
+        {
+            const float __dsl_blend_a = dsl_let_a_5;
+            if (!(__dsl_blend_a <= 0.0f)) {
+                __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = 0.950000f, .g = 0.450000f, .b = 0.080000f, .a = __dsl_blend_a }, __dsl_out);
+            }
+        }
+    }
     /* layer tongue */
-    const float dsl_let_sway_6 DSL_MAYBE_UNUSED = (sinf(((time * 5.800000f) + (y * 0.080000f))) * (0.450000f + (0.550000f * dsl_smoothstep(0.600000f, 0.950000f, ((sinf((time * dsl_param_pulse_0)) + 1.000000f) * 0.500000f)))));
-    const float dsl_let_d_7 DSL_MAYBE_UNUSED = dsl_circle((dsl_vec2_t){ .x = dsl_wrapdx(x, (dsl_param_tongue_x_1 + dsl_let_sway_6), width), .y = (y - dsl_param_tongue_y_2) }, dsl_param_tongue_r_3);
-    const float dsl_let_body_8 DSL_MAYBE_UNUSED = (1.000000f - dsl_smoothstep(0.000000f, 1.450000f, dsl_let_d_7));
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = 1.000000f, .g = 0.780000f, .b = 0.250000f, .a = (dsl_let_body_8 * 0.700000f) }, __dsl_out);
+    const float dsl_let_sway_6 DSL_MAYBE_UNUSED = (sinf(((time * 5.800000f) + (y * 0.080000f))) * (0.450000f + (0.550000f * dsl_smoothstep(0.600000f, 0.950000f, ((sinf((time * campfire_uniforms.dsl_param_pulse_0)) + 1.000000f) * 0.500000f)))));
+    if (DSL_NEAR_BOX(dsl_wrapdx(x, (campfire_uniforms.dsl_param_tongue_x_1 + dsl_let_sway_6), width), (y - campfire_uniforms.dsl_param_tongue_y_2), (campfire_uniforms.dsl_param_tongue_r_3 + 1.450000f), (campfire_uniforms.dsl_param_tongue_r_3 + 1.450000f))) {
+        const float dsl_let_d_7 DSL_MAYBE_UNUSED = dsl_circle((dsl_vec2_t){ .x = dsl_wrapdx(x, (campfire_uniforms.dsl_param_tongue_x_1 + dsl_let_sway_6), width), .y = (y - campfire_uniforms.dsl_param_tongue_y_2) }, campfire_uniforms.dsl_param_tongue_r_3);
+        const float dsl_let_body_8 DSL_MAYBE_UNUSED = (1.000000f - dsl_smoothstep(0.000000f, 1.450000f, dsl_let_d_7));
+        {
+            const float __dsl_blend_a = (dsl_let_body_8 * 0.700000f);
+            if (!(__dsl_blend_a <= 0.0f)) {
+                __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = 1.000000f, .g = 0.780000f, .b = 0.250000f, .a = __dsl_blend_a }, __dsl_out);
+            }
+        }
+    }
     *out_color = __dsl_out;
 }
 
+/* Generated from effect: campfire_v1 */
+static void campfire_render_rows(float time, float frame, int width_px, int height_px, int row_first, int row_step, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    const float width DSL_MAYBE_UNUSED = (float)width_px;
+    const float height DSL_MAYBE_UNUSED = (float)height_px;
+    for (int py = row_first; py < height_px; py += row_step) {
+        const float y DSL_MAYBE_UNUSED = (float)py;
+        const float dsl_let_sway_6 DSL_MAYBE_UNUSED = (sinf(((time * 5.800000f) + (y * 0.080000f))) * (0.450000f + (0.550000f * dsl_smoothstep(0.600000f, 0.950000f, ((sinf((time * campfire_uniforms.dsl_param_pulse_0)) + 1.000000f) * 0.500000f)))));
+        for (int px = 0; px < width_px; px++) {
+            const float x DSL_MAYBE_UNUSED = (float)px;
+            dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
+            /* layer embers */
+            if (DSL_NEAR_BOX(dsl_wrapdx(x, (width * 0.500000f), width), (y - (height - 1.400000f)), (2.000000f + 1.250000f), (1.100000f + 1.250000f))) {
+                const float dsl_let_d_4 DSL_MAYBE_UNUSED = dsl_box((dsl_vec2_t){ .x = dsl_wrapdx(x, (width * 0.500000f), width), .y = (y - (height - 1.400000f)) }, (dsl_vec2_t){ .x = 2.000000f, .y = 1.100000f });
+                const float dsl_let_a_5 DSL_MAYBE_UNUSED = ((1.000000f - dsl_smoothstep((-(0.100000f)), 1.250000f, dsl_let_d_4)) * 0.550000f);
+                {
+                    const float __dsl_blend_a = dsl_let_a_5;
+                    if (!(__dsl_blend_a <= 0.0f)) {
+                        __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = 0.950000f, .g = 0.450000f, .b = 0.080000f, .a = __dsl_blend_a }, __dsl_out);
+                    }
+                }
+            }
+            /* layer tongue */
+            if (DSL_NEAR_BOX(dsl_wrapdx(x, (campfire_uniforms.dsl_param_tongue_x_1 + dsl_let_sway_6), width), (y - campfire_uniforms.dsl_param_tongue_y_2), (campfire_uniforms.dsl_param_tongue_r_3 + 1.450000f), (campfire_uniforms.dsl_param_tongue_r_3 + 1.450000f))) {
+                const float dsl_let_d_7 DSL_MAYBE_UNUSED = dsl_circle((dsl_vec2_t){ .x = dsl_wrapdx(x, (campfire_uniforms.dsl_param_tongue_x_1 + dsl_let_sway_6), width), .y = (y - campfire_uniforms.dsl_param_tongue_y_2) }, campfire_uniforms.dsl_param_tongue_r_3);
+                const float dsl_let_body_8 DSL_MAYBE_UNUSED = (1.000000f - dsl_smoothstep(0.000000f, 1.450000f, dsl_let_d_7));
+                {
+                    const float __dsl_blend_a = (dsl_let_body_8 * 0.700000f);
+                    if (!(__dsl_blend_a <= 0.0f)) {
+                        __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = 1.000000f, .g = 0.780000f, .b = 0.250000f, .a = __dsl_blend_a }, __dsl_out);
+                    }
+                }
+            }
+            dsl_store_pixel(pixel_out + (uint32_t)phys_index[py * width_px + px] * 3U, __dsl_out, grb_gamma);
+        }
+    }
+}
+
+/* Generated from effect: campfire_v1 */
+static void campfire_render_frame(float time, float frame, int width_px, int height_px, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    campfire_prepare_frame(time, frame, (float)width_px, (float)height_px, seed);
+    campfire_render_rows(time, frame, width_px, height_px, 0, 1, seed, pixel_out, phys_index, grb_gamma);
+}
+
+static dsl_shader_param_t chaos_nebula_params[9] = {
+    { .name = "t_slow", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "t_med", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "t_fast", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "energy", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "base", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "cx", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "cy", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "scx", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "scy", .value = 0.0f, .pinned = 0, .settable = 1 },
+};
+
+typedef struct {
+    float dsl_param_t_slow_0;
+    float dsl_param_t_med_1;
+    float dsl_param_t_fast_2;
+    float dsl_param_energy_3;
+    float dsl_param_base_4;
+    float dsl_param_cx_5;
+    float dsl_param_cy_6;
+    float dsl_param_scx_7;
+    float dsl_param_scy_8;
+} chaos_nebula_uniforms_t;
+
+static chaos_nebula_uniforms_t chaos_nebula_uniforms;
+
+/* Generated from effect: chaos_nebula_v1 */
+static void chaos_nebula_prepare_frame(float time, float frame, float width, float height, float seed) {
+    const float dsl_param_t_slow_0 DSL_MAYBE_UNUSED = chaos_nebula_params[0].pinned ? chaos_nebula_params[0].value : ((time * 0.061800f) + (seed * 100.000000f));
+    const float dsl_param_t_med_1 DSL_MAYBE_UNUSED = chaos_nebula_params[1].pinned ? chaos_nebula_params[1].value : ((time * 0.173200f) + (seed * 200.000000f));
+    const float dsl_param_t_fast_2 DSL_MAYBE_UNUSED = chaos_nebula_params[2].pinned ? chaos_nebula_params[2].value : ((time * 0.289600f) + (seed * 300.000000f));
+    const float dsl_param_energy_3 DSL_MAYBE_UNUSED = chaos_nebula_params[3].pinned ? chaos_nebula_params[3].value : dsl_clamp((((sinf(((time * 0.110000f) + (seed * 50.000000f))) + sinf(((time * 0.077000f) + (seed * 70.000000f)))) + sinf(((time * 0.053000f) + (seed * 90.000000f)))) - 1.500000f), 0.000000f, 1.000000f);
+    const float dsl_param_base_4 DSL_MAYBE_UNUSED = chaos_nebula_params[4].pinned ? chaos_nebula_params[4].value : (0.025000f + (0.015000f * sinf((time * 0.029000f))));
+    const float dsl_param_cx_5 DSL_MAYBE_UNUSED = chaos_nebula_params[5].pinned ? chaos_nebula_params[5].value : (width * 0.500000f);
+    const float dsl_param_cy_6 DSL_MAYBE_UNUSED = chaos_nebula_params[6].pinned ? chaos_nebula_params[6].value : (height * 0.500000f);
+    const float dsl_param_scx_7 DSL_MAYBE_UNUSED = chaos_nebula_params[7].pinned ? chaos_nebula_params[7].value : (6.28318530717958647692f / width);
+    const float dsl_param_scy_8 DSL_MAYBE_UNUSED = chaos_nebula_params[8].pinned ? chaos_nebula_params[8].value : (6.28318530717958647692f / height);
+    chaos_nebula_uniforms.dsl_param_t_slow_0 = dsl_param_t_slow_0;
+    chaos_nebula_uniforms.dsl_param_t_med_1 = dsl_param_t_med_1;
+    chaos_nebula_uniforms.dsl_param_t_fast_2 = dsl_param_t_fast_2;
+    chaos_nebula_uniforms.dsl_param_energy_3 = dsl_param_energy_3;
+    chaos_nebula_uniforms.dsl_param_base_4 = dsl_param_base_4;
+    chaos_nebula_uniforms.dsl_param_cx_5 = dsl_param_cx_5;
+    chaos_nebula_uniforms.dsl_param_cy_6 = dsl_param_cy_6;
+    chaos_nebula_uniforms.dsl_param_scx_7 = dsl_param_scx_7;
+    chaos_nebula_uniforms.dsl_param_scy_8 = dsl_param_scy_8;
+}
+
 /* Generated from effect: chaos_nebula_v1 */
 static void chaos_nebula_eval_pixel(float time, float frame, float x, float y, float width, float height, float seed, dsl_color_t *out_color) {
-    const float dsl_param_t_slow_0 DSL_MAYBE_UNUSED = ((time * 0.061800f) + (seed * 100.000000f));
-    const float dsl_param_t_med_1 DSL_MAYBE_UNUSED = ((time * 0.173200f) + (seed * 200.000000f));
-    const float dsl_param_t_fast_2 DSL_MAYBE_UNUSED = ((time * 0.289600f) + (seed * 300.000000f));
-    const float dsl_param_energy_3 DSL_MAYBE_UNUSED = dsl_clamp((((sinf(((time * 0.110000f) + (seed * 50.000000f))) + sinf(((time * 0.077000f) + (seed * 70.000000f)))) + sinf(((time * 0.053000f) + (seed * 90.000000f)))) - 1.500000f), 0.000000f, 1.000000f);
-    const float dsl_param_base_4 DSL_MAYBE_UNUSED = (0.025000f + (0.015000f * sinf((time * 0.029000f))));
-    const float dsl_param_cx_5 DSL_MAYBE_UNUSED = (width * 0.500000f);
-    const float dsl_param_cy_6 DSL_MAYBE_UNUSED = (height * 0.500000f);
-    const float dsl_param_scx_7 DSL_MAYBE_UNUSED = (6.28318530717958647692f / width);
-    const float dsl_param_scy_8 DSL_MAYBE_UNUSED = (6.28318530717958647692f / height);
     dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
     /* layer nebula */
-    const float dsl_let_dx_9 DSL_MAYBE_UNUSED = dsl_wrapdx(x, (dsl_param_cx_5 + ((sinf((dsl_param_t_slow_0 * 3.700000f)) * width) * 0.250000f)), width);
-    const float dsl_let_dy_10 DSL_MAYBE_UNUSED = ((y - dsl_param_cy_6) + ((cosf((dsl_param_t_slow_0 * 2.300000f)) * height) * 0.150000f));
-    const float dsl_let_field1_11 DSL_MAYBE_UNUSED = (sinf((((dsl_let_dx_9 * dsl_param_scx_7) * 2.000000f) + (dsl_param_t_slow_0 * 4.000000f))) * cosf((((dsl_let_dy_10 * dsl_param_scy_8) * 1.500000f) + (dsl_param_t_slow_0 * 3.000000f))));
-    const float dsl_let_field2_12 DSL_MAYBE_UNUSED = (cosf((((dsl_let_dx_9 * dsl_param_scx_7) * 1.300000f) - (dsl_param_t_med_1 * 2.500000f))) * sinf((((dsl_let_dy_10 * dsl_param_scy_8) * 2.200000f) + (dsl_param_t_med_1 * 1.800000f))));
-    const float dsl_let_glow_13 DSL_MAYBE_UNUSED = (dsl_smoothstep((-(0.200000f)), 0.600000f, (dsl_let_field1_11 + (dsl_let_field2_12 * 0.500000f))) * ((dsl_param_base_4 + 0.150000f) + (0.350000f * dsl_param_energy_3)));
-    const float dsl_let_r_14 DSL_MAYBE_UNUSED = (dsl_let_glow_13 * (0.550000f + (0.450000f * sinf((dsl_param_t_slow_0 * 1.900000f)))));
-    const float dsl_let_g_15 DSL_MAYBE_UNUSED = (dsl_let_glow_13 * (0.250000f + (0.350000f * sinf(((dsl_param_t_slow_0 * 2.700000f) + 2.000000f)))));
-    const float dsl_let_b_16 DSL_MAYBE_UNUSED = (dsl_let_glow_13 * (0.450000f + (0.450000f * cosf(((dsl_param_t_slow_0 * 1.400000f) + 1.000000f)))));
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = dsl_clamp(dsl_let_r_14, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_15, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_16, 0.000000f, 1.000000f), .a = 1.000000f }, __dsl_out);
+    const float dsl_let_dx_9 DSL_MAYBE_UNUSED = dsl_wrapdx(x, (chaos_nebula_uniforms.dsl_param_cx_5 + ((sinf((chaos_nebula_uniforms.dsl_param_t_slow_0 * 3.700000f)) * width) * 0.250000f)), width);
+    const float dsl_let_dy_10 DSL_MAYBE_UNUSED = ((y - chaos_nebula_uniforms.dsl_param_cy_6) + ((cosf((chaos_nebula_uniforms.dsl_param_t_slow_0 * 2.300000f)) * height) * 0.150000f));
+    const float dsl_let_field1_11 DSL_MAYBE_UNUSED = (sinf((((dsl_let_dx_9 * chaos_nebula_uniforms.dsl_param_scx_7) * 2.000000f) + (chaos_nebula_uniforms.dsl_param_t_slow_0 * 4.000000f))) * cosf((((dsl_let_dy_10 * chaos_nebula_uniforms.dsl_param_scy_8) * 1.500000f) + (chaos_nebula_uniforms.dsl_param_t_slow_0 * 3.000000f))));
+    const float dsl_let_field2_12 DSL_MAYBE_UNUSED = (cosf((((dsl_let_dx_9 * chaos_nebula_uniforms.dsl_param_scx_7) * 1.300000f) - (chaos_nebula_uniforms.dsl_param_t_med_1 * 2.500000f))) * sinf((((dsl_let_dy_10 * chaos_nebula_uniforms.dsl_param_scy_8) * 2.200000f) + (chaos_nebula_uniforms.dsl_param_t_med_1 * 1.800000f))));
+    const float dsl_let_glow_13 DSL_MAYBE_UNUSED = (dsl_smoothstep((-(0.200000f)), 0.600000f, (dsl_let_field1_11 + (dsl_let_field2_12 * 0.500000f))) * ((chaos_nebula_uniforms.dsl_param_base_4 + 0.150000f) + (0.350000f * chaos_nebula_uniforms.dsl_param_energy_3)));
+    const float dsl_let_r_14 DSL_MAYBE_UNUSED = (dsl_let_glow_13 * (0.550000f + (0.450000f * sinf((chaos_nebula_uniforms.dsl_param_t_slow_0 * 1.900000f)))));
+    const float dsl_let_g_15 DSL_MAYBE_UNUSED = (dsl_let_glow_13 * (0.250000f + (0.350000f * sinf(((chaos_nebula_uniforms.dsl_param_t_slow_0 * 2.700000f) + 2.000000f)))));
+    const float dsl_let_b_16 DSL_MAYBE_UNUSED = (dsl_let_glow_13 * (0.450000f + (0.450000f * cosf(((chaos_nebula_uniforms.dsl_param_t_slow_0 * 1.400000f) + 1.000000f)))));
+    __dsl_out = dsl_color_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_14, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_15, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_16, 0.000000f, 1.000000f), .a = 1.000000f });
     /* layer streams */
-    const float dsl_let_drift_17 DSL_MAYBE_UNUSED = ((dsl_param_t_med_1 * 5.000000f) + ((y * dsl_param_scy_8) * 3.000000f));
-    const float dsl_let_wx_18 DSL_MAYBE_UNUSED = dsl_wrapdx(x, (width * (0.300000f + (0.200000f * sinf((dsl_param_t_fast_2 * 1.600000f))))), width);
-    const float dsl_let_stream_19 DSL_MAYBE_UNUSED = (sinf((((dsl_let_wx_18 * dsl_param_scx_7) * 3.500000f) + dsl_let_drift_17)) * cosf((((dsl_let_wx_18 * dsl_param_scx_7) * 1.800000f) - (dsl_param_t_fast_2 * 3.000000f))));
-    const float dsl_let_mask_20 DSL_MAYBE_UNUSED = (dsl_smoothstep(0.250000f, 0.850000f, dsl_let_stream_19) * (0.080000f + (0.700000f * dsl_param_energy_3)));
-    const float dsl_let_r_21 DSL_MAYBE_UNUSED = (dsl_let_mask_20 * (0.200000f + (0.500000f * sinf(((dsl_param_t_fast_2 * 2.300000f) + 1.000000f)))));
-    const float dsl_let_g_22 DSL_MAYBE_UNUSED = (dsl_let_mask_20 * (0.500000f + (0.400000f * cosf((dsl_param_t_med_1 * 3.100000f)))));
-    const float dsl_let_b_23 DSL_MAYBE_UNUSED = (dsl_let_mask_20 * (0.700000f + (0.300000f * sinf(((dsl_param_t_slow_0 * 5.000000f) + 3.000000f)))));
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = dsl_clamp(dsl_let_r_21, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_22, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_23, 0.000000f, 1.000000f), .a = dsl_let_mask_20 }, __dsl_out);
+    const float dsl_let_drift_17 DSL_MAYBE_UNUSED = ((chaos_nebula_uniforms.dsl_param_t_med_1 * 5.000000f) + ((y * chaos_nebula_uniforms.dsl_param_scy_8) * 3.000000f));
+    const float dsl_let_wx_18 DSL_MAYBE_UNUSED = dsl_wrapdx(x, (width * (0.300000f + (0.200000f * sinf((chaos_nebula_uniforms.dsl_param_t_fast_2 * 1.600000f))))), width);
+    const float dsl_let_stream_19 DSL_MAYBE_UNUSED = (sinf((((dsl_let_wx_18 * chaos_nebula_uniforms.dsl_param_scx_7) * 3.500000f) + dsl_let_drift_17)) * cosf((((dsl_let_wx_18 * chaos_nebula_uniforms.dsl_param_scx_7) * 1.800000f) - (chaos_nebula_uniforms.dsl_param_t_fast_2 * 3.000000f))));
+    const float dsl_let_mask_20 DSL_MAYBE_UNUSED = (dsl_smoothstep(0.250000f, 0.850000f, dsl_let_stream_19) * (0.080000f + (0.700000f * chaos_nebula_uniforms.dsl_param_energy_3)));
+    const float dsl_let_r_21 DSL_MAYBE_UNUSED = (dsl_let_mask_20 * (0.200000f + (0.500000f * sinf(((chaos_nebula_uniforms.dsl_param_t_fast_2 * 2.300000f) + 1.000000f)))));
+    const float dsl_let_g_22 DSL_MAYBE_UNUSED = (dsl_let_mask_20 * (0.500000f + (0.400000f * cosf((chaos_nebula_uniforms.dsl_param_t_med_1 * 3.100000f)))));
+    const float dsl_let_b_23 DSL_MAYBE_UNUSED = (dsl_let_mask_20 * (0.700000f + (0.300000f * sinf(((chaos_nebula_uniforms.dsl_param_t_slow_0 * 5.000000f) + 3.000000f)))));
+    {
+        const float __dsl_blend_a = dsl_let_mask_20;
+        if (!(__dsl_blend_a <= 0.0f)) {
+            __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_21, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_22, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_23, 0.000000f, 1.000000f), .a = __dsl_blend_a }, __dsl_out);
+        }
+    }
     /* layer sparks */
     const float dsl_let_cell_x_24 DSL_MAYBE_UNUSED = floorf((x * 0.200000f));
     const float dsl_let_cell_y_25 DSL_MAYBE_UNUSED = floorf((y * 0.150000f));
     const float dsl_let_cell_seed_26 DSL_MAYBE_UNUSED = (((dsl_let_cell_x_24 * 17.310000f) + (dsl_let_cell_y_25 * 43.170000f)) + (floorf((time * 1.500000f)) * 7.130000f));
     const float dsl_let_brightness_27 DSL_MAYBE_UNUSED = dsl_hash01(dsl_let_cell_seed_26);
-    const float dsl_let_spark_28 DSL_MAYBE_UNUSED = (dsl_smoothstep(0.880000f, 1.000000f, dsl_let_brightness_27) * (0.150000f + (0.850000f * dsl_param_energy_3)));
+    const float dsl_let_spark_28 DSL_MAYBE_UNUSED = (dsl_smoothstep(0.880000f, 1.000000f, dsl_let_brightness_27) * (0.150000f + (0.850000f * chaos_nebula_uniforms.dsl_param_energy_3)));
     const float dsl_let_hue_29 DSL_MAYBE_UNUSED = dsl_fract((dsl_hash01(((dsl_let_cell_x_24 * 13.000000f) + (dsl_let_cell_y_25 * 29.000000f))) + (time * 0.030000f)));
     const float dsl_let_r_30 DSL_MAYBE_UNUSED = (dsl_let_spark_28 * (0.500000f + (0.500000f * sinf((dsl_let_hue_29 * 6.28318530717958647692f)))));
     const float dsl_let_g_31 DSL_MAYBE_UNUSED = (dsl_let_spark_28 * (0.500000f + (0.500000f * sinf(((dsl_let_hue_29 * 6.28318530717958647692f) + (6.28318530717958647692f / 3.000000f))))));
     const float dsl_let_b_32 DSL_MAYBE_UNUSED = (dsl_let_spark_28 * (0.500000f + (0.500000f * sinf(((dsl_let_hue_29 * 6.28318530717958647692f) + ((6.28318530717958647692f * 2.000000f) / 3.000000f))))));
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = dsl_clamp(dsl_let_r_30, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_31, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_32, 0.000000f, 1.000000f), .a = dsl_let_spark_28 }, __dsl_out);
+    {
+        const float __dsl_blend_a = dsl_let_spark_28;
+        if (!(__dsl_blend_a <= 0.0f)) {
+            __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_30, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_31, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_32, 0.000000f, 1.000000f), .a = __dsl_blend_a }, __dsl_out);
+        }
+    }
     *out_color = __dsl_out;
 }
 
+/* Generated from effect: chaos_nebula_v1 */
+static void chaos_nebula_render_rows(float time, float frame, int width_px, int height_px, int row_first, int row_step, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    const float width DSL_MAYBE_UNUSED = (float)width_px;
+    const float height DSL_MAYBE_UNUSED = (float)height_px;
+    for (int py = row_first; py < height_px; py += row_step) {
+        const float y DSL_MAYBE_UNUSED = (float)py;
+        const float dsl_let_dy_10 DSL_MAYBE_UNUSED = ((y - chaos_nebula_uniforms.dsl_param_cy_6) + ((cosf((chaos_nebula_uniforms.dsl_param_t_slow_0 * 2.300000f)) * height) * 0.150000f));
+        const float dsl_let_drift_17 DSL_MAYBE_UNUSED = ((chaos_nebula_uniforms.dsl_param_t_med_1 * 5.000000f) + ((y * chaos_nebula_uniforms.dsl_param_scy_8) * 3.000000f));
+        const float dsl_let_cell_y_25 DSL_MAYBE_UNUSED = floorf((y * 0.150000f));
+        for (int px = 0; px < width_px; px++) {
+            const float x DSL_MAYBE_UNUSED = (float)px;
+            dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
+            /* layer nebula */
+            const float dsl_let_dx_9 DSL_MAYBE_UNUSED = dsl_wrapdx(x, (chaos_nebula_uniforms.dsl_param_cx_5 + ((sinf((chaos_nebula_uniforms.dsl_param_t_slow_0 * 3.700000f)) * width) * 0.250000f)), width);
+            const float dsl_let_field1_11 DSL_MAYBE_UNUSED = (sinf((((dsl_let_dx_9 * chaos_nebula_uniforms.dsl_param_scx_7) * 2.000000f) + (chaos_nebula_uniforms.dsl_param_t_slow_0 * 4.000000f))) * cosf((((dsl_let_dy_10 * chaos_nebula_uniforms.dsl_param_scy_8) * 1.500000f) + (chaos_nebula_uniforms.dsl_param_t_slow_0 * 3.000000f))));
+            const float dsl_let_field2_12 DSL_MAYBE_UNUSED = (cosf((((dsl_let_dx_9 * chaos_nebula_uniforms.dsl_param_scx_7) * 1.300000f) - (chaos_nebula_uniforms.dsl_param_t_med_1 * 2.500000f))) * sinf((((dsl_let_dy_10 * chaos_nebula_uniforms.dsl_param_scy_8) * 2.200000f) + (chaos_nebula_uniforms.dsl_param_t_med_1 * 1.800000f))));
+            const float dsl_let_glow_13 DSL_MAYBE_UNUSED = (dsl_smoothstep((-(0.200000f)), 0.600000f, (dsl_let_field1_11 + (dsl_let_field2_12 * 0.500000f))) * ((chaos_nebula_uniforms.dsl_param_base_4 + 0.150000f) + (0.350000f * chaos_nebula_uniforms.dsl_param_energy_3)));
+            const float dsl_let_r_14 DSL_MAYBE_UNUSED = (dsl_let_glow_13 * (0.550000f + (0.450000f * sinf((chaos_nebula_uniforms.dsl_param_t_slow_0 * 1.900000f)))));
+            const float dsl_let_g_15 DSL_MAYBE_UNUSED = (dsl_let_glow_13 * (0.250000f + (0.350000f * sinf(((chaos_nebula_uniforms.dsl_param_t_slow_0 * 2.700000f) + 2.000000f)))));
+            const float dsl_let_b_16 DSL_MAYBE_UNUSED = (dsl_let_glow_13 * (0.450000f + (0.450000f * cosf(((chaos_nebula_uniforms.dsl_param_t_slow_0 * 1.400000f) + 1.000000f)))));
+            __dsl_out = dsl_color_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_14, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_15, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_16, 0.000000f, 1.000000f), .a = 1.000000f });
+            /* layer streams */
+            const float dsl_let_wx_18 DSL_MAYBE_UNUSED = dsl_wrapdx(x, (width * (0.300000f + (0.200000f * sinf((chaos_nebula_uniforms.dsl_param_t_fast_2 * 1.600000f))))), width);
+            const float dsl_let_stream_19 DSL_MAYBE_UNUSED = (sinf((((dsl_let_wx_18 * chaos_nebula_uniforms.dsl_param_scx_7) * 3.500000f) + dsl_let_drift_17)) * cosf((((dsl_let_wx_18 * chaos_nebula_uniforms.dsl_param_scx_7) * 1.800000f) - (chaos_nebula_uniforms.dsl_param_t_fast_2 * 3.000000f))));
+            const float dsl_let_mask_20 DSL_MAYBE_UNUSED = (dsl_smoothstep(0.250000f, 0.850000f, dsl_let_stream_19) * (0.080000f + (0.700000f * chaos_nebula_uniforms.dsl_param_energy_3)));
+            const float dsl_let_r_21 DSL_MAYBE_UNUSED = (dsl_let_mask_20 * (0.200000f + (0.500000f * sinf(((chaos_nebula_uniforms.dsl_param_t_fast_2 * 2.300000f) + 1.000000f)))));
+            const float dsl_let_g_22 DSL_MAYBE_UNUSED = (dsl_let_mask_20 * (0.500000f + (0.400000f * cosf((chaos_nebula_uniforms.dsl_param_t_med_1 * 3.100000f)))));
+            const float dsl_let_b_23 DSL_MAYBE_UNUSED = (dsl_let_mask_20 * (0.700000f + (0.300000f * sinf(((chaos_nebula_uniforms.dsl_param_t_slow_0 * 5.000000f) + 3.000000f)))));
+            {
+                const float __dsl_blend_a = dsl_let_mask_20;
+                if (!(__dsl_blend_a <= 0.0f)) {
+                    __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_21, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_22, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_23, 0.000000f, 1.000000f), .a = __dsl_blend_a }, __dsl_out);
+                }
+            }
+            /* layer sparks */
+            const float dsl_let_cell_x_24 DSL_MAYBE_UNUSED = floorf((x * 0.200000f));
+            const float dsl_let_cell_seed_26 DSL_MAYBE_UNUSED = (((dsl_let_cell_x_24 * 17.310000f) + (dsl_let_cell_y_25 * 43.170000f)) + (floorf((time * 1.500000f)) * 7.130000f));
+            const float dsl_let_brightness_27 DSL_MAYBE_UNUSED = dsl_hash01(dsl_let_cell_seed_26);
+            const float dsl_let_spark_28 DSL_MAYBE_UNUSED = (dsl_smoothstep(0.880000f, 1.000000f, dsl_let_brightness_27) * (0.150000f + (0.850000f * chaos_nebula_uniforms.dsl_param_energy_3)));
+            const float dsl_let_hue_29 DSL_MAYBE_UNUSED = dsl_fract((dsl_hash01(((dsl_let_cell_x_24 * 13.000000f) + (dsl_let_cell_y_25 * 29.000000f))) + (time * 0.030000f)));
+            const float dsl_let_r_30 DSL_MAYBE_UNUSED = (dsl_let_spark_28 * (0.500000f + (0.500000f * sinf((dsl_let_hue_29 * 6.28318530717958647692f)))));
+            const float dsl_let_g_31 DSL_MAYBE_UNUSED = (dsl_let_spark_28 * (0.500000f + (0.500000f * sinf(((dsl_let_hue_29 * 6.28318530717958647692f) + (6.28318530717958647692f / 3.000000f))))));
+            const float dsl_let_b_32 DSL_MAYBE_UNUSED = (dsl_let_spark_28 * (0.500000f + (0.500000f * sinf(((dsl_let_hue_29 * 6.28318530717958647692f) + ((6.28318530717958647692f * 2.000000f) / 3.000000f))))));
+            {
+                const float __dsl_blend_a = dsl_let_spark_28;
+                if (!(__dsl_blend_a <= 0.0f)) {
+                    __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_30, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_31, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_32, 0.000000f, 1.000000f), .a = __dsl_blend_a }, __dsl_out);
+                }
+            }
+            dsl_store_pixel(pixel_out + (uint32_t)phys_index[py * width_px + px] * 3U, __dsl_out, grb_gamma);
+        }
+    }
+}
+
+/* Generated from effect: chaos_nebula_v1 */
+static void chaos_nebula_render_frame(float time, float frame, int width_px, int height_px, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    chaos_nebula_prepare_frame(time, frame, (float)width_px, (float)height_px, seed);
+    chaos_nebula_render_rows(time, frame, width_px, height_px, 0, 1, seed, pixel_out, phys_index, grb_gamma);
+}
+
+static dsl_shader_param_t dream_weaver_params[11] = {
+    { .name = "t1", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "t2", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "t3", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "vitality", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "hue_base", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "src1_x", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "src1_y", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "src2_x", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "src2_y", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "src3_x", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "src3_y", .value = 0.0f, .pinned = 0, .settable = 1 },
+};
+
+typedef struct {
+    float dsl_param_t1_0;
+    float dsl_param_t2_1;
+    float dsl_param_t3_2;
+    float dsl_param_vitality_3;
+    float dsl_param_hue_base_4;
+    float dsl_param_src1_x_5;
+    float dsl_param_src1_y_6;
+    float dsl_param_src2_x_7;
+    float dsl_param_src2_y_8;
+    float dsl_param_src3_x_9;
+    float dsl_param_src3_y_10;
+} dream_weaver_uniforms_t;
+
+static dream_weaver_uniforms_t dream_weaver_uniforms;
+
+/* Generated from effect: dream_weaver_v1 */
+static void dream_weaver_prepare_frame(float time, float frame, float width, float height, float seed) {
+    const float dsl_param_t1_0 DSL_MAYBE_UNUSED = dream_weaver_params[0].pinned ? dream_weaver_params[0].value : ((time * 0.080900f) + (seed * 100.000000f));
+    const float dsl_param_t2_1 DSL_MAYBE_UNUSED = dream_weaver_params[1].pinned ? dream_weaver_params[1].value : ((time * 0.131100f) + (seed * 200.000000f));
+    const float dsl_param_t3_2 DSL_MAYBE_UNUSED = dream_weaver_params[2].pinned ? dream_weaver_params[2].value : ((time * 0.191800f) + (seed * 300.000000f));
+    const float dsl_param_vitality_3 DSL_MAYBE_UNUSED = dream_weaver_params[3].pinned ? dream_weaver_params[3].value : dsl_clamp((((sinf(((time * 0.083000f) + (seed * 55.000000f))) + sinf(((time * 0.059000f) + (seed * 75.000000f)))) + sinf(((time * 0.037000f) + (seed * 95.000000f)))) - 1.300000f), 0.000000f, 1.000000f);
+    const float dsl_param_hue_base_4 DSL_MAYBE_UNUSED = dream_weaver_params[4].pinned ? dream_weaver_params[4].value : dsl_fract((time * 0.004300f));
+    const float dsl_param_src1_x_5 DSL_MAYBE_UNUSED = dream_weaver_params[5].pinned ? dream_weaver_params[5].value : (width * dsl_fract((dsl_param_t1_0 * 0.800000f)));
+    const float dsl_param_src1_y_6 DSL_MAYBE_UNUSED = dream_weaver_params[6].pinned ? dream_weaver_params[6].value : (height * (0.350000f + (0.150000f * sinf((dsl_param_t2_1 * 3.000000f)))));
+    const float dsl_param_src2_x_7 DSL_MAYBE_UNUSED = dream_weaver_params[7].pinned ? dream_weaver_params[7].value : (width * dsl_fract(((dsl_param_t1_0 * 0.800000f) + 0.500000f)));
+    const float dsl_param_src2_y_8 DSL_MAYBE_UNUSED = dream_weaver_params[8].pinned ? dream_weaver_params[8].value : (height * (0.650000f + (0.150000f * cosf((dsl_param_t3_2 * 2.000000f)))));
+    const float dsl_param_src3_x_9 DSL_MAYBE_UNUSED = dream_weaver_params[9].pinned ? dream_weaver_params[9].value : (width * dsl_fract(((dsl_param_t2_1 * 0.500000f) + 0.250000f)));
+    const float dsl_param_src3_y_10 DSL_MAYBE_UNUSED = dream_weaver_params[10].pinned ? dream_weaver_params[10].value : (height * (0.500000f + (0.250000f * sinf((dsl_param_t3_2 * 1.400000f)))));
+    dream_weaver_uniforms.dsl_param_t1_0 = dsl_param_t1_0;
+    dream_weaver_uniforms.dsl_param_t2_1 = dsl_param_t2_1;
+    dream_weaver_uniforms.dsl_param_t3_2 = dsl_param_t3_2;
+    dream_weaver_uniforms.dsl_param_vitality_3 = dsl_param_vitality_3;
+    dream_weaver_uniforms.dsl_param_hue_base_4 = dsl_param_hue_base_4;
+    dream_weaver_uniforms.dsl_param_src1_x_5 = dsl_param_src1_x_5;
+    dream_weaver_uniforms.dsl_param_src1_y_6 = dsl_param_src1_y_6;
+    dream_weaver_uniforms.dsl_param_src2_x_7 = dsl_param_src2_x_7;
+    dream_weaver_uniforms.dsl_param_src2_y_8 = dsl_param_src2_y_8;
+    dream_weaver_uniforms.dsl_param_src3_x_9 = dsl_param_src3_x_9;
+    dream_weaver_uniforms.dsl_param_src3_y_10 = dsl_param_src3_y_10;
+}
+
 /* Generated from effect: dream_weaver_v1 */
 static void dream_weaver_eval_pixel(float time, float frame, float x, float y, float width, float height, float seed, dsl_color_t *out_color) {
-    const float dsl_param_t1_0 DSL_MAYBE_UNUSED = ((time * 0.080900f) + (seed * 100.000000f));
-    const float dsl_param_t2_1 DSL_MAYBE_UNUSED = ((time * 0.131100f) + (seed * 200.000000f));
-    const float dsl_param_t3_2 DSL_MAYBE_UNUSED = ((time * 0.191800f) + (seed * 300.000000f));
-    const float dsl_param_vitality_3 DSL_MAYBE_UNUSED = dsl_clamp((((sinf(((time * 0.083000f) + (seed * 55.000000f))) + sinf(((time * 0.059000f) + (seed * 75.000000f)))) + sinf(((time * 0.037000f) + (seed * 95.000000f)))) - 1.300000f), 0.000000f, 1.000000f);
-    const float dsl_param_hue_base_4 DSL_MAYBE_UNUSED = dsl_fract((time * 0.004300f));
-    const float dsl_param_src1_x_5 DSL_MAYBE_UNUSED = (width * dsl_fract((dsl_param_t1_0 * 0.800000f)));
-    const float dsl_param_src1_y_6 DSL_MAYBE_UNUSED = (height * (0.350000f + (0.150000f * sinf((dsl_param_t2_1 * 3.000000f)))));
-    const float dsl_param_src2_x_7 DSL_MAYBE_UNUSED = (width * dsl_fract(((dsl_param_t1_0 * 0.800000f) + 0.500000f)));
-    const float dsl_param_src2_y_8 DSL_MAYBE_UNUSED = (height * (0.650000f + (0.150000f * cosf((dsl_param_t3_2 * 2.000000f)))));
-    const float dsl_param_src3_x_9 DSL_MAYBE_UNUSED = (width * dsl_fract(((dsl_param_t2_1 * 0.500000f) + 0.250000f)));
-    const float dsl_param_src3_y_10 DSL_MAYBE_UNUSED = (height * (0.500000f + (0.250000f * sinf((dsl_param_t3_2 * 1.400000f)))));
     dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
     /* layer waves */
-    const float dsl_let_dx1_11 DSL_MAYBE_UNUSED = dsl_wrapdx(x, dsl_param_src1_x_5, width);
-    const float dsl_let_dy1_12 DSL_MAYBE_UNUSED = (y - dsl_param_src1_y_6);
+    const float dsl_let_dx1_11 DSL_MAYBE_UNUSED = dsl_wrapdx(x, dream_weaver_uniforms.dsl_param_src1_x_5, width);
+    const float dsl_let_dy1_12 DSL_MAYBE_UNUSED = (y - dream_weaver_uniforms.dsl_param_src1_y_6);
     const float dsl_let_d1_13 DSL_MAYBE_UNUSED = sqrtf(fmaxf(((dsl_let_dx1_11 * dsl_let_dx1_11) + (dsl_let_dy1_12 * dsl_let_dy1_12)), 0.100000f));
     const float dsl_let_w1_14 DSL_MAYBE_UNUSED = sinf(((dsl_let_d1_13 * 0.800000f) - (time * 2.000000f)));
-    const float dsl_let_dx2_15 DSL_MAYBE_UNUSED = dsl_wrapdx(x, dsl_param_src2_x_7, width);
-    const float dsl_let_dy2_16 DSL_MAYBE_UNUSED = (y - dsl_param_src2_y_8);
+    const float dsl_let_dx2_15 DSL_MAYBE_UNUSED = dsl_wrapdx(x, dream_weaver_uniforms.dsl_param_src2_x_7, width);
+    const float dsl_let_dy2_16 DSL_MAYBE_UNUSED = (y - dream_weaver_uniforms.dsl_param_src2_y_8);
     const float dsl_let_d2_17 DSL_MAYBE_UNUSED = sqrtf(fmaxf(((dsl_let_dx2_15 * dsl_let_dx2_15) + (dsl_let_dy2_16 * dsl_let_dy2_16)), 0.100000f));
     const float dsl_let_w2_18 DSL_MAYBE_UNUSED = sinf(((dsl_let_d2_17 * 0.600000f) - (time * 1.500000f)));
-    const float dsl_let_dx3_19 DSL_MAYBE_UNUSED = dsl_wrapdx(x, dsl_param_src3_x_9, width);
-    const float dsl_let_dy3_20 DSL_MAYBE_UNUSED = (y - dsl_param_src3_y_10);
+    const float dsl_let_dx3_19 DSL_MAYBE_UNUSED = dsl_wrapdx(x, dream_weaver_uniforms.dsl_param_src3_x_9, width);
+    const float dsl_let_dy3_20 DSL_MAYBE_UNUSED = (y - dream_weaver_uniforms.dsl_param_src3_y_10);
     const float dsl_let_d3_21 DSL_MAYBE_UNUSED = sqrtf(fmaxf(((dsl_let_dx3_19 * dsl_let_dx3_19) + (dsl_let_dy3_20 * dsl_let_dy3_20)), 0.100000f));
     const float dsl_let_w3_22 DSL_MAYBE_UNUSED = sinf(((dsl_let_d3_21 * 0.500000f) - (time * 1.100000f)));
     const float dsl_let_interference_23 DSL_MAYBE_UNUSED = (((dsl_let_w1_14 + dsl_let_w2_18) + dsl_let_w3_22) * 0.333000f);
-    const float dsl_let_bright_24 DSL_MAYBE_UNUSED = (dsl_smoothstep((-(0.300000f)), 0.700000f, dsl_let_interference_23) * ((0.040000f + (0.200000f * (1.000000f - dsl_param_vitality_3))) + (0.500000f * dsl_param_vitality_3)));
-    const float dsl_let_h_25 DSL_MAYBE_UNUSED = dsl_fract((dsl_param_hue_base_4 + (dsl_let_interference_23 * 0.250000f)));
+    const float dsl_let_bright_24 DSL_MAYBE_UNUSED = (dsl_smoothstep((-(0.300000f)), 0.700000f, dsl_let_interference_23) * ((0.040000f + (0.200000f * (1.000000f - dream_weaver_uniforms.dsl_param_vitality_3))) + (0.500000f * dream_weaver_uniforms.dsl_param_vitality_3)));
+    const float dsl_let_h_25 DSL_MAYBE_UNUSED = dsl_fract((dream_weaver_uniforms.dsl_param_hue_base_4 + (dsl_let_interference_23 * 0.250000f)));
     const float dsl_let_r_26 DSL_MAYBE_UNUSED = (dsl_let_bright_24 * (0.500000f + (0.500000f * sinf((dsl_let_h_25 * 6.28318530717958647692f)))));
     const float dsl_let_g_27 DSL_MAYBE_UNUSED = (dsl_let_bright_24 * (0.500000f + (0.500000f * sinf(((dsl_let_h_25 * 6.28318530717958647692f) + (6.28318530717958647692f / 3.000000f))))));
     const float dsl_let_b_28 DSL_MAYBE_UNUSED = (dsl_let_bright_24 * (0.500000f + (0.500000f * sinf(((dsl_let_h_25 * 6.28318530717958647692f) + ((6.28318530717958647692f * 2.000000f) / 3.000000f))))));
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = dsl_clamp(dsl_let_r_26, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_27, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_28, 0.000000f, 1.000000f), .a = 1.000000f }, __dsl_out);
+    __dsl_out = dsl_color_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_26, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_27, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_28, 0.000000f, 1.000000f), .a = 1.000000f });
     /* layer ripples */
-    const float dsl_let_angle_29 DSL_MAYBE_UNUSED = (dsl_param_t3_2 * 2.000000f);
+    const float dsl_let_angle_29 DSL_MAYBE_UNUSED = (dream_weaver_uniforms.dsl_param_t3_2 * 2.000000f);
     const float dsl_let_diag_30 DSL_MAYBE_UNUSED = ((x * cosf(dsl_let_angle_29)) + (y * sinf(dsl_let_angle_29)));
     const float dsl_let_ripple_31 DSL_MAYBE_UNUSED = ((sinf(((dsl_let_diag_30 * 0.500000f) + (time * 0.700000f))) * 0.500000f) + 0.500000f);
-    const float dsl_let_mask_32 DSL_MAYBE_UNUSED = (dsl_let_ripple_31 * (0.030000f + (0.180000f * dsl_param_vitality_3)));
-    const float dsl_let_h_33 DSL_MAYBE_UNUSED = dsl_fract(((dsl_param_hue_base_4 + 0.500000f) + (dsl_let_diag_30 * 0.010000f)));
+    const float dsl_let_mask_32 DSL_MAYBE_UNUSED = (dsl_let_ripple_31 * (0.030000f + (0.180000f * dream_weaver_uniforms.dsl_param_vitality_3)));
+    const float dsl_let_h_33 DSL_MAYBE_UNUSED = dsl_fract(((dream_weaver_uniforms.dsl_param_hue_base_4 + 0.500000f) + (dsl_let_diag_30 * 0.010000f)));
     const float dsl_let_r_34 DSL_MAYBE_UNUSED = (dsl_let_mask_32 * (0.500000f + (0.500000f * sinf((dsl_let_h_33 * 6.28318530717958647692f)))));
     const float dsl_let_g_35 DSL_MAYBE_UNUSED = (dsl_let_mask_32 * (0.500000f + (0.500000f * sinf(((dsl_let_h_33 * 6.28318530717958647692f) + (6.28318530717958647692f / 3.000000f))))));
     const float dsl_let_b_36 DSL_MAYBE_UNUSED = (dsl_let_mask_32 * (0.500000f + (0.500000f * sinf(((dsl_let_h_33 * 6.28318530717958647692f) + ((6.28318530717958647692f * 2.000000f) / 3.000000f))))));
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = dsl_clamp(dsl_let_r_34, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_35, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_36, 0.000000f, 1.000000f), .a = dsl_let_mask_32 }, __dsl_out);
+    {
+        const float __dsl_blend_a = dsl_let_mask_32;
+        if (!(__dsl_blend_a <= 0.0f)) {
+            __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_34, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_35, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_36, 0.000000f, 1.000000f), .a = __dsl_blend_a }, __dsl_out);
+        }
+    }
     /* layer sparkles */
     const float dsl_let_gx_37 DSL_MAYBE_UNUSED = floorf((x * 0.200000f));
     const float dsl_let_gy_38 DSL_MAYBE_UNUSED = floorf((y * 0.130000f));
     const float dsl_let_cell_seed_39 DSL_MAYBE_UNUSED = (((dsl_let_gx_37 * 19.700000f) + (dsl_let_gy_38 * 47.300000f)) + (floorf((time * 0.800000f)) * 31.100000f));
     const float dsl_let_h01_40 DSL_MAYBE_UNUSED = dsl_hash01(dsl_let_cell_seed_39);
-    const float dsl_let_sparkle_41 DSL_MAYBE_UNUSED = (dsl_smoothstep(0.900000f, 1.000000f, dsl_let_h01_40) * dsl_param_vitality_3);
+    const float dsl_let_sparkle_41 DSL_MAYBE_UNUSED = (dsl_smoothstep(0.900000f, 1.000000f, dsl_let_h01_40) * dream_weaver_uniforms.dsl_param_vitality_3);
     const float dsl_let_sh_42 DSL_MAYBE_UNUSED = dsl_fract((dsl_hash01(((dsl_let_gx_37 * 7.000000f) + (dsl_let_gy_38 * 13.000000f))) + (time * 0.020000f)));
     const float dsl_let_r_43 DSL_MAYBE_UNUSED = (dsl_let_sparkle_41 * (0.500000f + (0.500000f * sinf((dsl_let_sh_42 * 6.28318530717958647692f)))));
     const float dsl_let_g_44 DSL_MAYBE_UNUSED = (dsl_let_sparkle_41 * (0.500000f + (0.500000f * sinf(((dsl_let_sh_42 * 6.28318530717958647692f) + (6.28318530717958647692f / 3.000000f))))));
     const float dsl_let_b_45 DSL_MAYBE_UNUSED = (dsl_let_sparkle_41 * (0.500000f + (0.500000f * sinf(((dsl_let_sh_42 * 6.28318530717958647692f) + ((6.28318530717958647692f * 2.000000f) / 3.000000f))))));
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = dsl_clamp(dsl_let_r_43, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_44, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_45, 0.000000f, 1.000000f), .a = dsl_let_sparkle_41 }, __dsl_out);
+    {
+        const float __dsl_blend_a = dsl_let_sparkle_41;
+        if (!(__dsl_blend_a <= 0.0f)) {
+            __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_43, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_44, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_45, 0.000000f, 1.000000f), .a = __dsl_blend_a }, __dsl_out);
+        }
+    }
     *out_color = __dsl_out;
 }
 
+/* Generated from effect: dream_weaver_v1 */
+static void dream_weaver_render_rows(float time, float frame, int width_px, int height_px, int row_first, int row_step, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    const float width DSL_MAYBE_UNUSED = (float)width_px;
+    const float height DSL_MAYBE_UNUSED = (float)height_px;
+    for (int py = row_first; py < height_px; py += row_step) {
+        const float y DSL_MAYBE_UNUSED = (float)py;
+        const float dsl_let_dy1_12 DSL_MAYBE_UNUSED = (y - dream_weaver_uniforms.dsl_param_src1_y_6);
+        const float dsl_let_dy2_16 DSL_MAYBE_UNUSED = (y - dream_weaver_uniforms.dsl_param_src2_y_8);
+        const float dsl_let_dy3_20 DSL_MAYBE_UNUSED = (y - dream_weaver_uniforms.dsl_param_src3_y_10);
+        const float dsl_let_angle_29 DSL_MAYBE_UNUSED = (dream_weaver_uniforms.dsl_param_t3_2 * 2.000000f);
+        const float dsl_let_gy_38 DSL_MAYBE_UNUSED = floorf((y * 0.130000f));
+        for (int px = 0; px < width_px; px++) {
+            const float x DSL_MAYBE_UNUSED = (float)px;
+            dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
+            /* layer waves */
+            const float dsl_let_dx1_11 DSL_MAYBE_UNUSED = dsl_wrapdx(x, dream_weaver_uniforms.dsl_param_src1_x_5, width);
+            const float dsl_let_d1_13 DSL_MAYBE_UNUSED = sqrtf(fmaxf(((dsl_let_dx1_11 * dsl_let_dx1_11) + (dsl_let_dy1_12 * dsl_let_dy1_12)), 0.100000f));
+            const float dsl_let_w1_14 DSL_MAYBE_UNUSED = sinf(((dsl_let_d1_13 * 0.800000f) - (time * 2.000000f)));
+            const float dsl_let_dx2_15 DSL_MAYBE_UNUSED = dsl_wrapdx(x, dream_weaver_uniforms.dsl_param_src2_x_7, width);
+            const float dsl_let_d2_17 DSL_MAYBE_UNUSED = sqrtf(fmaxf(((dsl_let_dx2_15 * dsl_let_dx2_15) + (dsl_let_dy2_16 * dsl_let_dy2_16)), 0.100000f));
+            const float dsl_let_w2_18 DSL_MAYBE_UNUSED = sinf(((dsl_let_d2_17 * 0.600000f) - (time * 1.500000f)));
+            const float dsl_let_dx3_19 DSL_MAYBE_UNUSED = dsl_wrapdx(x, dream_weaver_uniforms.dsl_param_src3_x_9, width);
+            const float dsl_let_d3_21 DSL_MAYBE_UNUSED = sqrtf(fmaxf(((dsl_let_dx3_19 * dsl_let_dx3_19) + (dsl_let_dy3_20 * dsl_let_dy3_20)), 0.100000f));
+            const float dsl_let_w3_22 DSL_MAYBE_UNUSED = sinf(((dsl_let_d3_21 * 0.500000f) - (time * 1.100000f)));
+            const float dsl_let_interference_23 DSL_MAYBE_UNUSED = (((dsl_let_w1_14 + dsl_let_w2_18) + dsl_let_w3_22) * 0.333000f);
+            const float dsl_let_bright_24 DSL_MAYBE_UNUSED = (dsl_smoothstep((-(0.300000f)), 0.700000f, dsl_let_interference_23) * ((0.040000f + (0.200000f * (1.000000f - dream_weaver_uniforms.dsl_param_vitality_3))) + (0.500000f * dream_weaver_uniforms.dsl_param_vitality_3)));
+            const float dsl_let_h_25 DSL_MAYBE_UNUSED = dsl_fract((dream_weaver_uniforms.dsl_param_hue_base_4 + (dsl_let_interference_23 * 0.250000f)));
+            const float dsl_let_r_26 DSL_MAYBE_UNUSED = (dsl_let_bright_24 * (0.500000f + (0.500000f * sinf((dsl_let_h_25 * 6.28318530717958647692f)))));
+            const float dsl_let_g_27 DSL_MAYBE_UNUSED = (dsl_let_bright_24 * (0.500000f + (0.500000f * sinf(((dsl_let_h_25 * 6.28318530717958647692f) + (6.28318530717958647692f / 3.000000f))))));
+            const float dsl_let_b_28 DSL_MAYBE_UNUSED = (dsl_let_bright_24 * (0.500000f + (0.500000f * sinf(((dsl_let_h_25 * 6.28318530717958647692f) + ((6.28318530717958647692f * 2.000000f) / 3.000000f))))));
+            __dsl_out = dsl_color_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_26, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_27, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_28, 0.000000f, 1.000000f), .a = 1.000000f });
+            /* layer ripples */
+            const float dsl_let_diag_30 DSL_MAYBE_UNUSED = ((x * cosf(dsl_let_angle_29)) + (y * sinf(dsl_let_angle_29)));
+            const float dsl_let_ripple_31 DSL_MAYBE_UNUSED = ((sinf(((dsl_let_diag_30 * 0.500000f) + (time * 0.700000f))) * 0.500000f) + 0.500000f);
+            const float dsl_let_mask_32 DSL_MAYBE_UNUSED = (dsl_let_ripple_31 * (0.030000f + (0.180000f * dream_weaver_uniforms.dsl_param_vitality_3)));
+            const float dsl_let_h_33 DSL_MAYBE_UNUSED = dsl_fract(((dream_weaver_uniforms.dsl_param_hue_base_4 + 0.500000f) + (dsl_let_diag_30 * 0.010000f)));
+            const float dsl_let_r_34 DSL_MAYBE_UNUSED = (dsl_let_mask_32 * (0.500000f + (0.500000f * sinf((dsl_let_h_33 * 6.28318530717958647692f)))));
+            const float dsl_let_g_35 DSL_MAYBE_UNUSED = (dsl_let_mask_32 * (0.500000f + (0.500000f * sinf(((dsl_let_h_33 * 6.28318530717958647692f) + (6.28318530717958647692f / 3.000000f))))));
+            const float dsl_let_b_36 DSL_MAYBE_UNUSED = (dsl_let_mask_32 * (0.500000f + (0.500000f * sinf(((dsl_let_h_33 * 6.28318530717958647692f) + ((6.28318530717958647692f * 2.000000f) / 3.000000f))))));
+            {
+                const float __dsl_blend_a = dsl_let_mask_32;
+                if (!(__dsl_blend_a <= 0.0f)) {
+                    __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_34, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_35, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_36, 0.000000f, 1.000000f), .a = __dsl_blend_a }, __dsl_out);
+                }
+            }
+            /* layer sparkles */
+            const float dsl_let_gx_37 DSL_MAYBE_UNUSED = floorf((x * 0.200000f));
+            const float dsl_let_cell_seed_39 DSL_MAYBE_UNUSED = (((dsl_let_gx_37 * 19.700000f) + (dsl_let_gy_38 * 47.300000f)) + (floorf((time * 0.800000f)) * 31.100000f));
+            const float dsl_let_h01_40 DSL_MAYBE_UNUSED = dsl_hash01(dsl_let_cell_seed_39);
+            const float dsl_let_sparkle_41 DSL_MAYBE_UNUSED = (dsl_smoothstep(0.900000f, 1.000000f, dsl_let_h01_40) * dream_weaver_uniforms.dsl_param_vitality_3);
+            const float dsl_let_sh_42 DSL_MAYBE_UNUSED = dsl_fract((dsl_hash01(((dsl_let_gx_37 * 7.000000f) + (dsl_let_gy_38 * 13.000000f))) + (time * 0.020000f)));
+            const float dsl_let_r_43 DSL_MAYBE_UNUSED = (dsl_let_sparkle_41 * (0.500000f + (0.500000f * sinf((dsl_let_sh_42 * 6.28318530717958647692f)))));
+            const float dsl_let_g_44 DSL_MAYBE_UNUSED = (dsl_let_sparkle_41 * (0.500000f + (0.500000f * sinf(((dsl_let_sh_42 * 6.28318530717958647692f) + (6.28318530717958647692f / 3.000000f))))));
+            const float dsl_let_b_45 DSL_MAYBE_UNUSED = (dsl_let_sparkle_41 * (0.500000f + (0.500000f * sinf(((dsl_let_sh_42 * 6.28318530717958647692f) + ((6.28318530717958647692f * 2.000000f) / 3.000000f))))));
+            {
+                const float __dsl_blend_a = dsl_let_sparkle_41;
+                if (!(__dsl_blend_a <= 0.0f)) {
+                    __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_43, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_44, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_45, 0.000000f, 1.000000f), .a = __dsl_blend_a }, __dsl_out);
+                }
+            }
+            dsl_store_pixel(pixel_out + (uint32_t)phys_index[py * width_px + px] * 3U, __dsl_out, grb_gamma);
+        }
+    }
+}
+
+/* Generated from effect: dream_weaver_v1 */
+static void dream_weaver_render_frame(float time, float frame, int width_px, int height_px, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    dream_weaver_prepare_frame(time, frame, (float)width_px, (float)height_px, seed);
+    dream_weaver_render_rows(time, frame, width_px, height_px, 0, 1, seed, pixel_out, phys_index, grb_gamma);
+}
+
+static dsl_shader_param_t electric_arcs_params[2] = {
+    { .name = "arc_speed", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "intensity", .value = 0.0f, .pinned = 0, .settable = 1 },
+};
+
+typedef struct {
+    float dsl_param_arc_speed_0;
+    float dsl_param_intensity_1;
+    float dsl_let_offset_4[3];
+} electric_arcs_uniforms_t;
+
+static electric_arcs_uniforms_t electric_arcs_uniforms;
+
+/* Generated from effect: electric_arcs */
+static void electric_arcs_prepare_frame(float time, float frame, float width, float height, float seed) {
+    const float dsl_param_arc_speed_0 DSL_MAYBE_UNUSED = electric_arcs_params[0].pinned ? electric_arcs_params[0].value : 1.500000f;
+    const float dsl_param_intensity_1 DSL_MAYBE_UNUSED = electric_arcs_params[1].pinned ? electric_arcs_params[1].value : 0.800000f;
+    for (int32_t dsl_iter_i_2 = 0; dsl_iter_i_2 < 3; dsl_iter_i_2++) {
+        const float dsl_index_i_3 DSL_MAYBE_UNUSED = (float)dsl_iter_i_2;
+        const float dsl_let_offset_4 DSL_MAYBE_UNUSED = (dsl_index_i_3 * 0.333000f);
+        electric_arcs_uniforms.dsl_let_offset_4[dsl_iter_i_2] = dsl_let_offset_4;
+    }
+    electric_arcs_uniforms.dsl_param_arc_speed_0 = dsl_param_arc_speed_0;
+    electric_arcs_uniforms.dsl_param_intensity_1 = dsl_param_intensity_1;
+}
+
 /* Generated from effect: electric_arcs */
 static void electric_arcs_eval_pixel(float time, float frame, float x, float y, float width, float height, float seed, dsl_color_t *out_color) {
-    const float dsl_param_arc_speed_0 DSL_MAYBE_UNUSED = 1.500000f;
-    const float dsl_param_intensity_1 DSL_MAYBE_UNUSED = 0.800000f;
     dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
     /* layer dark_base */
-    const float dsl_let_ny_2 DSL_MAYBE_UNUSED = (y / height);
-    const float dsl_let_bg_3 DSL_MAYBE_UNUSED = (0.020000f + (0.010000f * dsl_let_ny_2));
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = 0.000000f, .g = 0.000000f, .b = dsl_let_bg_3, .a = 1.000000f }, __dsl_out);
-    /* layer arcs */
-    const float dsl_let_nx_4 DSL_MAYBE_UNUSED = (x / width);
     const float dsl_let_ny_5 DSL_MAYBE_UNUSED = (y / height);
-    for (int32_t dsl_iter_i_6 = 0; dsl_iter_i_6 < 3; dsl_iter_i_6++) {
-        const float dsl_index_i_7 DSL_MAYBE_UNUSED = (float)dsl_iter_i_6;
-        const float dsl_let_offset_8 DSL_MAYBE_UNUSED = (dsl_index_i_7 * 0.333000f);
-        const float dsl_let_ax_9 DSL_MAYBE_UNUSED = dsl_fract((dsl_let_nx_4 + dsl_let_offset_8));
-        const float dsl_let_n_10 DSL_MAYBE_UNUSED = dsl_noise3((dsl_let_ax_9 * 4.000000f), (dsl_let_ny_5 * 6.000000f), ((time * dsl_param_arc_speed_0) + (dsl_index_i_7 * 2.700000f)));
-        const float dsl_let_displaced_x_11 DSL_MAYBE_UNUSED = (dsl_let_ax_9 + (dsl_let_n_10 * 0.150000f));
-        const float dsl_let_dx_12 DSL_MAYBE_UNUSED = fabsf((dsl_let_displaced_x_11 - 0.500000f));
-        const float dsl_let_arc_val_13 DSL_MAYBE_UNUSED = (powf(fmaxf((1.000000f - (dsl_let_dx_12 * 8.000000f)), 0.000000f), 6.000000f) * dsl_param_intensity_1);
-        const float dsl_let_flicker_14 DSL_MAYBE_UNUSED = dsl_noise3((dsl_let_ax_9 * 10.000000f), (dsl_let_ny_5 * 10.000000f), ((time * 3.000000f) + (dsl_index_i_7 * 5.000000f)));
-        const float dsl_let_arc_bright_15 DSL_MAYBE_UNUSED = (dsl_let_arc_val_13 * (0.600000f + (0.400000f * ((dsl_let_flicker_14 * 0.500000f) + 0.500000f))));
-        const float dsl_let_r_16 DSL_MAYBE_UNUSED = (dsl_let_arc_bright_15 * 0.800000f);
-        const float dsl_let_g_17 DSL_MAYBE_UNUSED = (dsl_let_arc_bright_15 * 0.850000f);
-        const float dsl_let_b_18 DSL_MAYBE_UNUSED = dsl_let_arc_bright_15;
-        __dsl_out = dsl_blend_over((dsl_color_t){ .r = dsl_clamp(dsl_let_r_16, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_17, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_18, 0.000000f, 1.000000f), .a = dsl_let_arc_bright_15 }, __dsl_out);
+    const float dsl_let_bg_6 DSL_MAYBE_UNUSED = (0.020000f + (0.010000f * dsl_let_ny_5));
+    __dsl_out = dsl_color_opaque((dsl_color_t){ .r = 0.000000f, .g = 0.000000f, .b = dsl_let_bg_6, .a = 1.000000f });
+    /* layer arcs */
+    const float dsl_let_nx_7 DSL_MAYBE_UNUSED = (x / width);
+    const float dsl_let_ny_8 DSL_MAYBE_UNUSED = (y / height);
+    for (int32_t dsl_iter_i_9 = 0; dsl_iter_i_9 < 3; dsl_iter_i_9++) {
+        const float dsl_index_i_10 DSL_MAYBE_UNUSED = (float)dsl_iter_i_9;
+        const float dsl_let_offset_11 DSL_MAYBE_UNUSED = electric_arcs_uniforms.dsl_let_offset_4[dsl_iter_i_9];
+        const float dsl_let_ax_12 DSL_MAYBE_UNUSED = dsl_fract((dsl_let_nx_7 + dsl_let_offset_11));
+        const float dsl_let_n_13 DSL_MAYBE_UNUSED = dsl_noise3((dsl_let_ax_12 * 4.000000f), (dsl_let_ny_8 * 6.000000f), ((time * electric_arcs_uniforms.dsl_param_arc_speed_0) + (dsl_index_i_10 * 2.700000f)));
+        const float dsl_let_displaced_x_14 DSL_MAYBE_UNUSED = (dsl_let_ax_12 + (dsl_let_n_13 * 0.150000f));
+        const float dsl_let_dx_15 DSL_MAYBE_UNUSED = fabsf((dsl_let_displaced_x_14 - 0.500000f));
+        const float dsl_let_arc_val_16 DSL_MAYBE_UNUSED = (powf(fmaxf((1.000000f - (dsl_let_dx_15 * 8.000000f)), 0.000000f), 6.000000f) * electric_arcs_uniforms.dsl_param_intensity_1);
+        const float dsl_let_flicker_17 DSL_MAYBE_UNUSED = dsl_noise3((dsl_let_ax_12 * 10.000000f), (dsl_let_ny_8 * 10.000000f), ((time * 3.000000f) + (dsl_index_i_10 * 5.000000f)));
+        const float dsl_let_arc_bright_18 DSL_MAYBE_UNUSED = (dsl_let_arc_val_16 * (0.600000f + (0.400000f * ((dsl_let_flicker_17 * 0.500000f) + 0.500000f))));
+        const float dsl_let_r_19 DSL_MAYBE_UNUSED = (dsl_let_arc_bright_18 * 0.800000f);
+        const float dsl_let_g_20 DSL_MAYBE_UNUSED = (dsl_let_arc_bright_18 * 0.850000f);
+        const float dsl_let_b_21 DSL_MAYBE_UNUSED = dsl_let_arc_bright_18;
+        {
+            const float __dsl_blend_a = dsl_let_arc_bright_18;
+            if (!(__dsl_blend_a <= 0.0f)) {
+                __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_19, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_20, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_21, 0.000000f, 1.000000f), .a = __dsl_blend_a }, __dsl_out);
+            }
+        }
     }
     /* layer glow_pulse */
-    const float dsl_let_nx_19 DSL_MAYBE_UNUSED = (x / width);
-    const float dsl_let_ny_20 DSL_MAYBE_UNUSED = (y / height);
-    const float dsl_let_pulse_21 DSL_MAYBE_UNUSED = (powf(((sinf((time * 3.000000f)) * 0.500000f) + 0.500000f), 3.000000f) * 0.150000f);
-    const float dsl_let_n_22 DSL_MAYBE_UNUSED = dsl_noise2(((dsl_let_nx_19 * 3.000000f) + (time * 0.500000f)), (dsl_let_ny_20 * 3.000000f));
-    const float dsl_let_glow_23 DSL_MAYBE_UNUSED = (dsl_let_pulse_21 * ((dsl_let_n_22 * 0.500000f) + 0.500000f));
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = (0.200000f * dsl_let_glow_23), .g = (0.300000f * dsl_let_glow_23), .b = dsl_let_glow_23, .a = dsl_let_glow_23 }, __dsl_out);
+    const float dsl_let_nx_22 DSL_MAYBE_UNUSED = (x / width);
+    const float dsl_let_ny_23 DSL_MAYBE_UNUSED = (y / height);
+    const float dsl_let_pulse_24 DSL_MAYBE_UNUSED = (powf(((sinf((time * 3.000000f)) * 0.500000f) + 0.500000f), 3.000000f) * 0.150000f);
+    const float dsl_let_n_25 DSL_MAYBE_UNUSED = dsl_noise2(((dsl_let_nx_22 * 3.000000f) + (time * 0.500000f)), (dsl_let_ny_23 * 3.000000f));
+    const float dsl_let_glow_26 DSL_MAYBE_UNUSED = (dsl_let_pulse_24 * ((dsl_let_n_25 * 0.500000f) + 0.500000f));
+    {
+        const float __dsl_blend_a = dsl_let_glow_26;
+        if (!(__dsl_blend_a <= 0.0f)) {
+            __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = (0.200000f * dsl_let_glow_26), .g = (0.300000f * dsl_let_glow_26), .b = dsl_let_glow_26, .a = __dsl_blend_a }, __dsl_out);
+        }
+    }
     *out_color = __dsl_out;
 }
 
+/* Generated from effect: electric_arcs */
+static void electric_arcs_render_rows(float time, float frame, int width_px, int height_px, int row_first, int row_step, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    const float width DSL_MAYBE_UNUSED = (float)width_px;
+    const float height DSL_MAYBE_UNUSED = (float)height_px;
+    for (int py = row_first; py < height_px; py += row_step) {
+        const float y DSL_MAYBE_UNUSED = (float)py;
+        const float dsl_let_ny_5 DSL_MAYBE_UNUSED = (y / height);
+        const float dsl_let_bg_6 DSL_MAYBE_UNUSED = (0.020000f + (0.010000f * dsl_let_ny_5));
+        const float dsl_let_ny_8 DSL_MAYBE_UNUSED = (y / height);
+        const float dsl_let_ny_23 DSL_MAYBE_UNUSED = (y / height);
+        const float dsl_let_pulse_24 DSL_MAYBE_UNUSED = (powf(((sinf((time * 3.000000f)) * 0.500000f) + 0.500000f), 3.000000f) * 0.150000f);
+        for (int px = 0; px < width_px; px++) {
+            const float x DSL_MAYBE_UNUSED = (float)px;
+            dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
+            /* layer dark_base */
+            __dsl_out = dsl_color_opaque((dsl_color_t){ .r = 0.000000f, .g = 0.000000f, .b = dsl_let_bg_6, .a = 1.000000f });
+            /* layer arcs */
+            const float dsl_let_nx_7 DSL_MAYBE_UNUSED = (x / width);
+            for (int32_t dsl_iter_i_9 = 0; dsl_iter_i_9 < 3; dsl_iter_i_9++) {
+                const float dsl_index_i_10 DSL_MAYBE_UNUSED = (float)dsl_iter_i_9;
+                const float dsl_let_offset_11 DSL_MAYBE_UNUSED = electric_arcs_uniforms.dsl_let_offset_4[dsl_iter_i_9];
+                const float dsl_let_ax_12 DSL_MAYBE_UNUSED = dsl_fract((dsl_let_nx_7 + dsl_let_offset_11));
+                const float dsl_let_n_13 DSL_MAYBE_UNUSED = dsl_noise3((dsl_let_ax_12 * 4.000000f), (dsl_let_ny_8 * 6.000000f), ((time * electric_arcs_uniforms.dsl_param_arc_speed_0) + (dsl_index_i_10 * 2.700000f)));
+                const float dsl_let_displaced_x_14 DSL_MAYBE_UNUSED = (dsl_let_ax_12 + (dsl_let_n_13 * 0.150000f));
+                const float dsl_let_dx_15 DSL_MAYBE_UNUSED = fabsf((dsl_let_displaced_x_14 - 0.500000f));
+                const float dsl_let_arc_val_16 DSL_MAYBE_UNUSED = (powf(fmaxf((1.000000f - (dsl_let_dx_15 * 8.000000f)), 0.000000f), 6.000000f) * electric_arcs_uniforms.dsl_param_intensity_1);
+                const float dsl_let_flicker_17 DSL_MAYBE_UNUSED = dsl_noise3((dsl_let_ax_12 * 10.000000f), (dsl_let_ny_8 * 10.000000f), ((time * 3.000000f) + (dsl_index_i_10 * 5.000000f)));
+                const float dsl_let_arc_bright_18 DSL_MAYBE_UNUSED = (dsl_let_arc_val_16 * (0.600000f + (0.400000f * ((dsl_let_flicker_17 * 0.500000f) + 0.500000f))));
+                const float dsl_let_r_19 DSL_MAYBE_UNUSED = (dsl_let_arc_bright_18 * 0.800000f);
+                const float dsl_let_g_20 DSL_MAYBE_UNUSED = (dsl_let_arc_bright_18 * 0.850000f);
+                const float dsl_let_b_21 DSL_MAYBE_UNUSED = dsl_let_arc_bright_18;
+                {
+                    const float __dsl_blend_a = dsl_let_arc_bright_18;
+                    if (!(__dsl_blend_a <= 0.0f)) {
+                        __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_19, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_20, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_21, 0.000000f, 1.000000f), .a = __dsl_blend_a }, __dsl_out);
+                    }
+                }
+            }
+            /* layer glow_pulse */
+            const float dsl_let_nx_22 DSL_MAYBE_UNUSED = (x / width);
+            const float dsl_let_n_25 DSL_MAYBE_UNUSED = dsl_noise2(((dsl_let_nx_22 * 3.000000f) + (time * 0.500000f)), (dsl_let_ny_23 * 3.000000f));
+            const float dsl_let_glow_26 DSL_MAYBE_UNUSED = (dsl_let_pulse_24 * ((dsl_let_n_25 * 0.500000f) + 0.500000f));
+            {
+                const float __dsl_blend_a = dsl_let_glow_26;
+                if (!(__dsl_blend_a <= 0.0f)) {
+                    __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = (0.200000f * dsl_let_glow_26), .g = (0.300000f * dsl_let_glow_26), .b = dsl_let_glow_26, .a = __dsl_blend_a }, __dsl_out);
+                }
+            }
+            dsl_store_pixel(pixel_out + (uint32_t)phys_index[py * width_px + px] * 3U, __dsl_out, grb_gamma);
+        }
+    }
+}
+
+/* Generated from effect: electric_arcs */
+static void electric_arcs_render_frame(float time, float frame, int width_px, int height_px, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    electric_arcs_prepare_frame(time, frame, (float)width_px, (float)height_px, seed);
+    electric_arcs_render_rows(time, frame, width_px, height_px, 0, 1, seed, pixel_out, phys_index, grb_gamma);
+}
+
+static dsl_shader_param_t forest_wind_params[2] = {
+    { .name = "sway_speed", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "sway_amount", .value = 0.0f, .pinned = 0, .settable = 1 },
+};
+
+typedef struct {
+    float dsl_param_sway_speed_0;
+    float dsl_param_sway_amount_1;
+    float dsl_let_tree_x_4[5];
+    float dsl_let_tree_w_5[5];
+    float dsl_let_trunk_top_6[5];
+} forest_wind_uniforms_t;
+
+static forest_wind_uniforms_t forest_wind_uniforms;
+
+/* Generated from effect: forest_wind */
+static void forest_wind_prepare_frame(float time, float frame, float width, float height, float seed) {
+    const float dsl_param_sway_speed_0 DSL_MAYBE_UNUSED = forest_wind_params[0].pinned ? forest_wind_params[0].value : 0.600000f;
+    const float dsl_param_sway_amount_1 DSL_MAYBE_UNUSED = forest_wind_params[1].pinned ? forest_wind_params[1].value : 0.120000f;
+    for (int32_t dsl_iter_i_2 = 0; dsl_iter_i_2 < 5; dsl_iter_i_2++) {
+        const float dsl_index_i_3 DSL_MAYBE_UNUSED = (float)dsl_iter_i_2;
+        const float dsl_let_tree_x_4 DSL_MAYBE_UNUSED = (width * dsl_hash01(((dsl_index_i_3 * 31.000000f) + 7.000000f)));
+        const float dsl_let_tree_w_5 DSL_MAYBE_UNUSED = (0.400000f + (dsl_hash01(((dsl_index_i_3 * 17.000000f) + 3.000000f)) * 0.300000f));
+        const float dsl_let_trunk_top_6 DSL_MAYBE_UNUSED = (0.300000f + (dsl_hash01(((dsl_index_i_3 * 23.000000f) + 11.000000f)) * 0.300000f));
+        forest_wind_uniforms.dsl_let_tree_x_4[dsl_iter_i_2] = dsl_let_tree_x_4;
+        forest_wind_uniforms.dsl_let_tree_w_5[dsl_iter_i_2] = dsl_let_tree_w_5;
+        forest_wind_uniforms.dsl_let_trunk_top_6[dsl_iter_i_2] = dsl_let_trunk_top_6;
+    }
+    forest_wind_uniforms.dsl_param_sway_speed_0 = dsl_param_sway_speed_0;
+    forest_wind_uniforms.dsl_param_sway_amount_1 = dsl_param_sway_amount_1;
+}
+
 /* Generated from effect: forest_wind */
 static void forest_wind_eval_pixel(float time, float frame, float x, float y, float width, float height, float seed, dsl_color_t *out_color) {
-    const float dsl_param_sway_speed_0 DSL_MAYBE_UNUSED = 0.600000f;
-    const float dsl_param_sway_amount_1 DSL_MAYBE_UNUSED = 0.120000f;
     dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
     /* layer ground */
-    const float dsl_let_ny_2 DSL_MAYBE_UNUSED = (y / height);
-    const float dsl_let_ground_mask_3 DSL_MAYBE_UNUSED = dsl_smoothstep(0.600000f, 0.900000f, dsl_let_ny_2);
-    const float dsl_let_r_4 DSL_MAYBE_UNUSED = (dsl_let_ground_mask_3 * 0.250000f);
-    const float dsl_let_g_5 DSL_MAYBE_UNUSED = (dsl_let_ground_mask_3 * 0.150000f);
-    const float dsl_let_b_6 DSL_MAYBE_UNUSED = (dsl_let_ground_mask_3 * 0.050000f);
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = dsl_let_r_4, .g = dsl_let_g_5, .b = dsl_let_b_6, .a = dsl_let_ground_mask_3 }, __dsl_out);
+    const float dsl_let_ny_7 DSL_MAYBE_UNUSED = (y / height);
+    const float dsl_let_ground_mask_8 DSL_MAYBE_UNUSED = dsl_smoothstep(0.600000f, 0.900000f, dsl_let_ny_7);
+    const float dsl_let_r_9 DSL_MAYBE_UNUSED = (dsl_let_ground_mask_8 * 0.250000f);
+    const float dsl_let_g_10 DSL_MAYBE_UNUSED = (dsl_let_ground_mask_8 * 0.150000f);
+    const float dsl_let_b_11 DSL_MAYBE_UNUSED = (dsl_let_ground_mask_8 * 0.050000f);
+    {
+        const float __dsl_blend_a = dsl_let_ground_mask_8;
+        if (!(__dsl_blend_a <= 0.0f)) {
+            __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_let_r_9, .g = dsl_let_g_10, .b = dsl_let_b_11, .a = __dsl_blend_a }, __dsl_out);
+        }
+    }
     /* layer trees */
-    const float dsl_let_nx_7 DSL_MAYBE_UNUSED = (x / width);
-    const float dsl_let_ny_8 DSL_MAYBE_UNUSED = (y / height);
-    const float dsl_let_wind_9 DSL_MAYBE_UNUSED = ((dsl_noise2(((dsl_let_nx_7 * 2.000000f) + (time * dsl_param_sway_speed_0)), (time * 0.300000f)) * dsl_param_sway_amount_1) * (1.000000f - dsl_let_ny_8));
-    for (int32_t dsl_iter_i_10 = 0; dsl_iter_i_10 < 5; dsl_iter_i_10++) {
-        const float dsl_index_i_11 DSL_MAYBE_UNUSED = (float)dsl_iter_i_10;
-        const float dsl_let_tree_x_12 DSL_MAYBE_UNUSED = (width * dsl_hash01(((dsl_index_i_11 * 31.000000f) + 7.000000f)));
-        const float dsl_let_tree_w_13 DSL_MAYBE_UNUSED = (0.400000f + (dsl_hash01(((dsl_index_i_11 * 17.000000f) + 3.000000f)) * 0.300000f));
-        const float dsl_let_trunk_top_14 DSL_MAYBE_UNUSED = (0.300000f + (dsl_hash01(((dsl_index_i_11 * 23.000000f) + 11.000000f)) * 0.300000f));
-        const float dsl_let_dx_15 DSL_MAYBE_UNUSED = dsl_wrapdx(x, (dsl_let_tree_x_12 + (dsl_let_wind_9 * height)), width);
-        const float dsl_let_trunk_16 DSL_MAYBE_UNUSED = (dsl_smoothstep(dsl_let_tree_w_13, (dsl_let_tree_w_13 * 0.500000f), fabsf(dsl_let_dx_15)) * dsl_smoothstep(dsl_let_trunk_top_14, (dsl_let_trunk_top_14 + 0.100000f), dsl_let_ny_8));
-        const float dsl_let_r_17 DSL_MAYBE_UNUSED = (dsl_let_trunk_16 * 0.300000f);
-        const float dsl_let_g_18 DSL_MAYBE_UNUSED = (dsl_let_trunk_16 * 0.180000f);
-        const float dsl_let_b_19 DSL_MAYBE_UNUSED = (dsl_let_trunk_16 * 0.080000f);
-        __dsl_out = dsl_blend_over((dsl_color_t){ .r = dsl_let_r_17, .g = dsl_let_g_18, .b = dsl_let_b_19, .a = (dsl_let_trunk_16 * 0.800000f) }, __dsl_out);
+    const float dsl_let_nx_12 DSL_MAYBE_UNUSED = (x / width);
+    const float dsl_let_ny_13 DSL_MAYBE_UNUSED = (y / height);
+    const float dsl_let_wind_14 DSL_MAYBE_UNUSED = ((dsl_noise2(((dsl_let_nx_12 * 2.000000f) + (time * forest_wind_uniforms.dsl_param_sway_speed_0)), (time * 0.300000f)) * forest_wind_uniforms.dsl_param_sway_amount_1) * (1.000000f - dsl_let_ny_13));
+    for (int32_t dsl_iter_i_15 = 0; dsl_iter_i_15 < 5; dsl_iter_i_15++) {
+        const float dsl_index_i_16 DSL_MAYBE_UNUSED = (float)dsl_iter_i_15;
+        const float dsl_let_tree_x_17 DSL_MAYBE_UNUSED = forest_wind_uniforms.dsl_let_tree_x_4[dsl_iter_i_15];
+        const float dsl_let_tree_w_18 DSL_MAYBE_UNUSED = forest_wind_uniforms.dsl_let_tree_w_5[dsl_iter_i_15];
+        const float dsl_let_trunk_top_19 DSL_MAYBE_UNUSED = forest_wind_uniforms.dsl_let_trunk_top_6[dsl_iter_i_15];
+        const float dsl_let_dx_20 DSL_MAYBE_UNUSED = dsl_wrapdx(x, (dsl_let_tree_x_17 + (dsl_let_wind_14 * height)), width);
+        const float dsl_let_trunk_21 DSL_MAYBE_UNUSED = (dsl_smoothstep(dsl_let_tree_w_18, (dsl_let_tree_w_18 * 0.500000f), fabsf(dsl_let_dx_20)) * dsl_smoothstep(dsl_let_trunk_top_19, (dsl_let_trunk_top_19 + 0.100000f), dsl_let_ny_13));
+        const float dsl_let_r_22 DSL_MAYBE_UNUSED = (dsl_let_trunk_21 * 0.300000f);
+        const float dsl_let_g_23 DSL_MAYBE_UNUSED = (dsl_let_trunk_21 * 0.180000f);
+        const float dsl_let_b_24 DSL_MAYBE_UNUSED = (dsl_let_trunk_21 * 0.080000f);
+        {
+            const float __dsl_blend_a = (dsl_let_trunk_21 * 0.800000f);
+            if (!(__dsl_blend_a <= 0.0f)) {
+                __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_let_r_22, .g = dsl_let_g_23, .b = dsl_let_b_24, .a = __dsl_blend_a }, __dsl_out);
+            }
+        }
     }
     /* layer foliage */
-    const float dsl_let_nx_20 DSL_MAYBE_UNUSED = (x / width);
-    const float dsl_let_ny_21 DSL_MAYBE_UNUSED = (y / height);
-    const float dsl_let_wind_22 DSL_MAYBE_UNUSED = dsl_noise2(((dsl_let_nx_20 * 3.000000f) + ((time * dsl_param_sway_speed_0) * 1.200000f)), ((dsl_let_ny_21 * 2.000000f) + (time * 0.200000f)));
-    const float dsl_let_n1_23 DSL_MAYBE_UNUSED = ((dsl_noise2(((dsl_let_nx_20 * 5.000000f) + (dsl_let_wind_22 * 0.300000f)), ((dsl_let_ny_21 * 4.000000f) - (time * 0.100000f))) * 0.500000f) + 0.500000f);
-    const float dsl_let_n2_24 DSL_MAYBE_UNUSED = ((dsl_noise2(((dsl_let_nx_20 * 8.000000f) - (time * 0.150000f)), ((dsl_let_ny_21 * 6.000000f) + (dsl_let_wind_22 * 0.200000f))) * 0.500000f) + 0.500000f);
-    const float dsl_let_height_mask_25 DSL_MAYBE_UNUSED = dsl_smoothstep(0.700000f, 0.200000f, dsl_let_ny_21);
-    const float dsl_let_leaf_26 DSL_MAYBE_UNUSED = (powf((dsl_let_n1_23 * dsl_let_n2_24), 1.500000f) * dsl_let_height_mask_25);
-    const float dsl_let_shade_27 DSL_MAYBE_UNUSED = ((dsl_noise3((dsl_let_nx_20 * 4.000000f), (dsl_let_ny_21 * 3.000000f), (time * 0.100000f)) * 0.500000f) + 0.500000f);
-    const float dsl_let_r_28 DSL_MAYBE_UNUSED = (dsl_let_leaf_26 * (0.080000f + (0.100000f * dsl_let_shade_27)));
-    const float dsl_let_g_29 DSL_MAYBE_UNUSED = (dsl_let_leaf_26 * (0.350000f + (0.350000f * dsl_let_shade_27)));
-    const float dsl_let_b_30 DSL_MAYBE_UNUSED = (dsl_let_leaf_26 * (0.050000f + (0.080000f * dsl_let_shade_27)));
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = dsl_clamp(dsl_let_r_28, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_29, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_30, 0.000000f, 1.000000f), .a = (dsl_let_leaf_26 * 0.750000f) }, __dsl_out);
+    const float dsl_let_nx_25 DSL_MAYBE_UNUSED = (x / width);
+    const float dsl_let_ny_26 DSL_MAYBE_UNUSED = (y / height);
+    const float dsl_let_wind_27 DSL_MAYBE_UNUSED = dsl_noise2(((dsl_let_nx_25 * 3.000000f) + ((time * forest_wind_uniforms.dsl_param_sway_speed_0) * 1.200000f)), ((dsl_let_ny_26 * 2.000000f) + (time * 0.200000f)));
+    const float dsl_let_n1_28 DSL_MAYBE_UNUSED = ((dsl_noise2(((dsl_let_nx_25 * 5.000000f) + (dsl_let_wind_27 * 0.300000f)), ((dsl_let_ny_26 * 4.000000f) - (time * 0.100000f))) * 0.500000f) + 0.500000f);
+    const float dsl_let_n2_29 DSL_MAYBE_UNUSED = ((dsl_noise2(((dsl_let_nx_25 * 8.000000f) - (time * 0.150000f)), ((dsl_let_ny_26 * 6.000000f) + (dsl_let_wind_27 * 0.200000f))) * 0.500000f) + 0.500000f);
+    const float dsl_let_height_mask_30 DSL_MAYBE_UNUSED = dsl_smoothstep(0.700000f, 0.200000f, dsl_let_ny_26);
+    const float dsl_let_leaf_31 DSL_MAYBE_UNUSED = (powf((dsl_let_n1_28 * dsl_let_n2_29), 1.500000f) * dsl_let_height_mask_30);
+    const float dsl_let_shade_32 DSL_MAYBE_UNUSED = ((dsl_noise3((dsl_let_nx_25 * 4.000000f), (dsl_let_ny_26 * 3.000000f), (time * 0.100000f)) * 0.500000f) + 0.500000f);
+    const float dsl_let_r_33 DSL_MAYBE_UNUSED = (dsl_let_leaf_31 * (0.080000f + (0.100000f * dsl_let_shade_32)));
+    const float dsl_let_g_34 DSL_MAYBE_UNUSED = (dsl_let_leaf_31 * (0.350000f + (0.350000f * dsl_let_shade_32)));
+    const float dsl_let_b_35 DSL_MAYBE_UNUSED = (dsl_let_leaf_31 * (0.050000f + (0.080000f * dsl_let_shade_32)));
+    {
+        const float __dsl_blend_a = (dsl_let_leaf_31 * 0.750000f);
+        if (!(__dsl_blend_a <= 0.0f)) {
+            __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_33, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_34, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_35, 0.000000f, 1.000000f), .a = __dsl_blend_a }, __dsl_out);
+        }
+    }
     *out_color = __dsl_out;
 }
 
+/* Generated from effect: forest_wind */
+static void forest_wind_render_rows(float time, float frame, int width_px, int height_px, int row_first, int row_step, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    const float width DSL_MAYBE_UNUSED = (float)width_px;
+    const float height DSL_MAYBE_UNUSED = (float)height_px;
+    for (int py = row_first; py < height_px; py += row_step) {
+        const float y DSL_MAYBE_UNUSED = (float)py;
+        const float dsl_let_ny_7 DSL_MAYBE_UNUSED = (y / height);
+        const float dsl_let_ground_mask_8 DSL_MAYBE_UNUSED = dsl_smoothstep(0.600000f, 0.900000f, dsl_let_ny_7);
+        const float dsl_let_r_9 DSL_MAYBE_UNUSED = (dsl_let_ground_mask_8 * 0.250000f);
+        const float dsl_let_g_10 DSL_MAYBE_UNUSED = (dsl_let_ground_mask_8 * 0.150000f);
+        const float dsl_let_b_11 DSL_MAYBE_UNUSED = (dsl_let_ground_mask_8 * 0.050000f);
+        const float dsl_let_ny_13 DSL_MAYBE_UNUSED = (y / height);
+        const float dsl_let_ny_26 DSL_MAYBE_UNUSED = (y / height);
+        const float dsl_let_height_mask_30 DSL_MAYBE_UNUSED = dsl_smoothstep(0.700000f, 0.200000f, dsl_let_ny_26);
+        for (int px = 0; px < width_px; px++) {
+            const float x DSL_MAYBE_UNUSED = (float)px;
+            dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
+            /* layer ground */
+            {
+                const float __dsl_blend_a = dsl_let_ground_mask_8;
+                if (!(__dsl_blend_a <= 0.0f)) {
+                    __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_let_r_9, .g = dsl_let_g_10, .b = dsl_let_b_11, .a = __dsl_blend_a }, __dsl_out);
+                }
+            }
+            /* layer trees */
+            const float dsl_let_nx_12 DSL_MAYBE_UNUSED = (x / width);
+            const float dsl_let_wind_14 DSL_MAYBE_UNUSED = ((dsl_noise2(((dsl_let_nx_12 * 2.000000f) + (time * forest_wind_uniforms.dsl_param_sway_speed_0)), (time * 0.300000f)) * forest_wind_uniforms.dsl_param_sway_amount_1) * (1.000000f - dsl_let_ny_13));
+            for (int32_t dsl_iter_i_15 = 0; dsl_iter_i_15 < 5; dsl_iter_i_15++) {
+                const float dsl_index_i_16 DSL_MAYBE_UNUSED = (float)dsl_iter_i_15;
+                const float dsl_let_tree_x_17 DSL_MAYBE_UNUSED = forest_wind_uniforms.dsl_let_tree_x_4[dsl_iter_i_15];
+                const float dsl_let_tree_w_18 DSL_MAYBE_UNUSED = forest_wind_uniforms.dsl_let_tree_w_5[dsl_iter_i_15];
+                const float dsl_let_trunk_top_19 DSL_MAYBE_UNUSED = forest_wind_uniforms.dsl_let_trunk_top_6[dsl_iter_i_15];
+                const float dsl_let_dx_20 DSL_MAYBE_UNUSED = dsl_wrapdx(x, (dsl_let_tree_x_17 + (dsl_let_wind_14 * height)), width);
+                const float dsl_let_trunk_21 DSL_MAYBE_UNUSED = (dsl_smoothstep(dsl_let_tree_w_18, (dsl_let_tree_w_18 * 0.500000f), fabsf(dsl_let_dx_20)) * dsl_smoothstep(dsl_let_trunk_top_19, (dsl_let_trunk_top_19 + 0.100000f), dsl_let_ny_13));
+                const float dsl_let_r_22 DSL_MAYBE_UNUSED = (dsl_let_trunk_21 * 0.300000f);
+                const float dsl_let_g_23 DSL_MAYBE_UNUSED = (dsl_let_trunk_21 * 0.180000f);
+                const float dsl_let_b_24 DSL_MAYBE_UNUSED = (dsl_let_trunk_21 * 0.080000f);
+                {
+                    const float __dsl_blend_a = (dsl_let_trunk_21 * 0.800000f);
+                    if (!(__dsl_blend_a <= 0.0f)) {
+                        __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_let_r_22, .g = dsl_let_g_23, .b = dsl_let_b_24, .a = __dsl_blend_a }, __dsl_out);
+                    }
+                }
+            }
+            /* layer foliage */
+            const float dsl_let_nx_25 DSL_MAYBE_UNUSED = (x / width);
+            const float dsl_let_wind_27 DSL_MAYBE_UNUSED = dsl_noise2(((dsl_let_nx_25 * 3.000000f) + ((time * forest_wind_uniforms.dsl_param_sway_speed_0) * 1.200000f)), ((dsl_let_ny_26 * 2.000000f) + (time * 0.200000f)));
+            const float dsl_let_n1_28 DSL_MAYBE_UNUSED = ((dsl_noise2(((dsl_let_nx_25 * 5.000000f) + (dsl_let_wind_27 * 0.300000f)), ((dsl_let_ny_26 * 4.000000f) - (time * 0.100000f))) * 0.500000f) + 0.500000f);
+            const float dsl_let_n2_29 DSL_MAYBE_UNUSED = ((dsl_noise2(((dsl_let_nx_25 * 8.000000f) - (time * 0.150000f)), ((dsl_let_ny_26 * 6.000000f) + (dsl_let_wind_27 * 0.200000f))) * 0.500000f) + 0.500000f);
+            const float dsl_let_leaf_31 DSL_MAYBE_UNUSED = (powf((dsl_let_n1_28 * dsl_let_n2_29), 1.500000f) * dsl_let_height_mask_30);
+            const float dsl_let_shade_32 DSL_MAYBE_UNUSED = ((dsl_noise3((dsl_let_nx_25 * 4.000000f), (dsl_let_ny_26 * 3.000000f), (time * 0.100000f)) * 0.500000f) + 0.500000f);
+            const float dsl_let_r_33 DSL_MAYBE_UNUSED = (dsl_let_leaf_31 * (0.080000f + (0.100000f * dsl_let_shade_32)));
+            const float dsl_let_g_34 DSL_MAYBE_UNUSED = (dsl_let_leaf_31 * (0.350000f + (0.350000f * dsl_let_shade_32)));
+            const float dsl_let_b_35 DSL_MAYBE_UNUSED = (dsl_let_leaf_31 * (0.050000f + (0.080000f * dsl_let_shade_32)));
+            {
+                const float __dsl_blend_a = (dsl_let_leaf_31 * 0.750000f);
+                if (!(__dsl_blend_a <= 0.0f)) {
+                    __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_33, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_34, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_35, 0.000000f, 1.000000f), .a = __dsl_blend_a }, __dsl_out);
+                }
+            }
+            dsl_store_pixel(pixel_out + (uint32_t)phys_index[py * width_px + px] * 3U, __dsl_out, grb_gamma);
+        }
+    }
+}
+
+/* Generated from effect: forest_wind */
+static void forest_wind_render_frame(float time, float frame, int width_px, int height_px, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    forest_wind_prepare_frame(time, frame, (float)width_px, (float)height_px, seed);
+    forest_wind_render_rows(time, frame, width_px, height_px, 0, 1, seed, pixel_out, phys_index, grb_gamma);
+}
+
 /* Audio: generated from effect: forest_wind */
 static float forest_wind_eval_audio(float time, float seed, float sample_rate, float *phasor_state) {
-    const float dsl_param_sway_speed_0 DSL_MAYBE_UNUSED = 0.600000f;
-    const float dsl_param_sway_amount_1 DSL_MAYBE_UNUSED = 0.120000f;
+    const float dsl_param_sway_speed_0 DSL_MAYBE_UNUSED = forest_wind_params[0].pinned ? forest_wind_params[0].value : 0.600000f;
+    const float dsl_param_sway_amount_1 DSL_MAYBE_UNUSED = forest_wind_params[1].pinned ? forest_wind_params[1].value : 0.120000f;
     float __dsl_audio_out = 0.0f;
     const float dsl_let_n_2 DSL_MAYBE_UNUSED = dsl_noise3((time * 80.000000f), (seed * 10.000000f), (time * 0.500000f));
     const float dsl_let_low_mod_3 DSL_MAYBE_UNUSED = ((sinf((time * 0.700000f)) * 0.500000f) + 0.500000f);
@@ -553,6 +1405,10 @@ static float forest_wind_eval_audio(float time, float seed, float sample_rate, f
     return __dsl_audio_out;
 }
 
+/* Generated from effect: gradient */
+static void gradient_prepare_frame(float time, float frame, float width, float height, float seed) {
+}
+
 /* Generated from effect: gradient */
 static void gradient_eval_pixel(float time, float frame, float x, float y, float width, float height, float seed, dsl_color_t *out_color) {
     dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
@@ -560,30 +1416,81 @@ static void gradient_eval_pixel(float time, float frame, float x, float y, float
     const float dsl_let_xt_0 DSL_MAYBE_UNUSED = ((cosf(x) * 0.500000f) + 0.500000f);
     const float dsl_let_yt_1 DSL_MAYBE_UNUSED = ((cosf(y) * 0.500000f) + 0.500000f);
     const float dsl_let_at_2 DSL_MAYBE_UNUSED = ((sinf((x * y)) * 0.500000f) + 0.500000f);
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = dsl_let_xt_0, .g = dsl_let_yt_1, .b = dsl_let_xt_0, .a = dsl_let_at_2 }, __dsl_out);
+    {
+        const float __dsl_blend_a = dsl_let_at_2;
+        if (!(__dsl_blend_a <= 0.0f)) {
+            __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_let_xt_0, .g = dsl_let_yt_1, .b = dsl_let_xt_0, .a = __dsl_blend_a }, __dsl_out);
+        }
+    }
     *out_color = __dsl_out;
 }
 
+/* Generated from effect: gradient */
+static void gradient_render_rows(float time, float frame, int width_px, int height_px, int row_first, int row_step, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    const float width DSL_MAYBE_UNUSED = (float)width_px;
+    const float height DSL_MAYBE_UNUSED = (float)height_px;
+    for (int py = row_first; py < height_px; py += row_step) {
+        const float y DSL_MAYBE_UNUSED = (float)py;
+        const float dsl_let_yt_1 DSL_MAYBE_UNUSED = ((cosf(y) * 0.500000f) + 0.500000f);
+        for (int px = 0; px < width_px; px++) {
+            const float x DSL_MAYBE_UNUSED = (float)px;
+            dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
+            /* layer l */
+            const float dsl_let_xt_0 DSL_MAYBE_UNUSED = ((cosf(x) * 0.500000f) + 0.500000f);
+            const float dsl_let_at_2 DSL_MAYBE_UNUSED = ((sinf((x * y)) * 0.500000f) + 0.500000f);
+            {
+                const float __dsl_blend_a = dsl_let_at_2;
+                if (!(__dsl_blend_a <= 0.0f)) {
+                    __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_let_xt_0, .g = dsl_let_yt_1, .b = dsl_let_xt_0, .a = __dsl_blend_a }, __dsl_out);
+                }
+            }
+            dsl_store_pixel(pixel_out + (uint32_t)phys_index[py * width_px + px] * 3U, __dsl_out, grb_gamma);
+        }
+    }
+}
+
+/* Generated from effect: gradient */
+static void gradient_render_frame(float time, float frame, int width_px, int height_px, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    gradient_prepare_frame(time, frame, (float)width_px, (float)height_px, seed);
+    gradient_render_rows(time, frame, width_px, height_px, 0, 1, seed, pixel_out, phys_index, grb_gamma);
+}
+
+static dsl_shader_param_t heartbeat_pulse_params[1] = {
+    { .name = "bpm", .value = 0.0f, .pinned = 0, .settable = 1 },
+};
+
+typedef struct {
+    float dsl_param_bpm_0;
+    float dsl_let_beat_period_1;
+    float dsl_let_phase_2;
+    float dsl_let_lub_3;
+    float dsl_let_dub_phase_4;
+    float dsl_let_dub_5;
+    float dsl_let_beat_6;
+} heartbeat_pulse_uniforms_t;
+
+static heartbeat_pulse_uniforms_t heartbeat_pulse_uniforms;
+
 /* Generated from effect: heartbeat_pulse */
-static void heartbeat_pulse_eval_frame(float time, float frame) {
-    const float dsl_param_bpm_0 DSL_MAYBE_UNUSED = 72.000000f;
+static void heartbeat_pulse_prepare_frame(float time, float frame, float width, float height, float seed) {
+    const float dsl_param_bpm_0 DSL_MAYBE_UNUSED = heartbeat_pulse_params[0].pinned ? heartbeat_pulse_params[0].value : 72.000000f;
     const float dsl_let_beat_period_1 DSL_MAYBE_UNUSED = (60.000000f / dsl_param_bpm_0);
     const float dsl_let_phase_2 DSL_MAYBE_UNUSED = dsl_fract((time / dsl_let_beat_period_1));
     const float dsl_let_lub_3 DSL_MAYBE_UNUSED = powf(fmaxf((1.000000f - (dsl_let_phase_2 * 8.000000f)), 0.000000f), 3.000000f);
     const float dsl_let_dub_phase_4 DSL_MAYBE_UNUSED = fmaxf((dsl_let_phase_2 - 0.200000f), 0.000000f);
     const float dsl_let_dub_5 DSL_MAYBE_UNUSED = powf(fmaxf((1.000000f - (dsl_let_dub_phase_4 * 10.000000f)), 0.000000f), 3.000000f);
     const float dsl_let_beat_6 DSL_MAYBE_UNUSED = (dsl_let_lub_3 + (dsl_let_dub_5 * 0.700000f));
+    heartbeat_pulse_uniforms.dsl_param_bpm_0 = dsl_param_bpm_0;
+    heartbeat_pulse_uniforms.dsl_let_beat_period_1 = dsl_let_beat_period_1;
+    heartbeat_pulse_uniforms.dsl_let_phase_2 = dsl_let_phase_2;
+    heartbeat_pulse_uniforms.dsl_let_lub_3 = dsl_let_lub_3;
+    heartbeat_pulse_uniforms.dsl_let_dub_phase_4 = dsl_let_dub_phase_4;
+    heartbeat_pulse_uniforms.dsl_let_dub_5 = dsl_let_dub_5;
+    heartbeat_pulse_uniforms.dsl_let_beat_6 = dsl_let_beat_6;
 }
 
 /* Generated from effect: heartbeat_pulse */
 static void heartbeat_pulse_eval_pixel(float time, float frame, float x, float y, float width, float height, float seed, dsl_color_t *out_color) {
-    const float dsl_param_bpm_0 DSL_MAYBE_UNUSED = 72.000000f;
-    const float dsl_let_beat_period_1 DSL_MAYBE_UNUSED = (60.000000f / dsl_param_bpm_0);
-    const float dsl_let_phase_2 DSL_MAYBE_UNUSED = dsl_fract((time / dsl_let_beat_period_1));
-    const float dsl_let_lub_3 DSL_MAYBE_UNUSED = powf(fmaxf((1.000000f - (dsl_let_phase_2 * 8.000000f)), 0.000000f), 3.000000f);
-    const float dsl_let_dub_phase_4 DSL_MAYBE_UNUSED = fmaxf((dsl_let_phase_2 - 0.200000f), 0.000000f);
-    const float dsl_let_dub_5 DSL_MAYBE_UNUSED = powf(fmaxf((1.000000f - (dsl_let_dub_phase_4 * 10.000000f)), 0.000000f), 3.000000f);
-    const float dsl_let_beat_6 DSL_MAYBE_UNUSED = (dsl_let_lub_3 + (dsl_let_dub_5 * 0.700000f));
     dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
     /* layer pulse_ring */
     const float dsl_let_cx_7 DSL_MAYBE_UNUSED = (width * 0.500000f);
@@ -592,30 +1499,95 @@ static void heartbeat_pulse_eval_pixel(float time, float frame, float x, float y
     const float dsl_let_dy_10 DSL_MAYBE_UNUSED = (y - dsl_let_cy_8);
     const float dsl_let_dist_11 DSL_MAYBE_UNUSED = sqrtf(((dsl_let_dx_9 * dsl_let_dx_9) + (dsl_let_dy_10 * dsl_let_dy_10)));
     const float dsl_let_max_r_12 DSL_MAYBE_UNUSED = (height * 0.500000f);
-    const float dsl_let_ring_pos_13 DSL_MAYBE_UNUSED = (dsl_let_beat_6 * dsl_let_max_r_12);
+    const float dsl_let_ring_pos_13 DSL_MAYBE_UNUSED = (heartbeat_pulse_uniforms.dsl_let_beat_6 * dsl_let_max_r_12);
     const float dsl_let_ring_dist_14 DSL_MAYBE_UNUSED = fabsf((dsl_let_dist_11 - dsl_let_ring_pos_13));
-    const float dsl_let_ring_15 DSL_MAYBE_UNUSED = (dsl_smoothstep(2.500000f, 0.000000f, dsl_let_ring_dist_14) * dsl_let_beat_6);
+    const float dsl_let_ring_15 DSL_MAYBE_UNUSED = (dsl_smoothstep(2.500000f, 0.000000f, dsl_let_ring_dist_14) * heartbeat_pulse_uniforms.dsl_let_beat_6);
     const float dsl_let_r_16 DSL_MAYBE_UNUSED = (dsl_let_ring_15 * 0.900000f);
     const float dsl_let_g_17 DSL_MAYBE_UNUSED = (dsl_let_ring_15 * 0.100000f);
     const float dsl_let_b_18 DSL_MAYBE_UNUSED = (dsl_let_ring_15 * 0.150000f);
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = dsl_clamp(dsl_let_r_16, 0.000000f, 1.000000f), .g = dsl_let_g_17, .b = dsl_let_b_18, .a = dsl_let_ring_15 }, __dsl_out);
+    {
+        const float __dsl_blend_a = dsl_let_ring_15;
+        if (!(__dsl_blend_a <= 0.0f)) {
+            __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_16, 0.000000f, 1.000000f), .g = dsl_let_g_17, .b = dsl_let_b_18, .a = __dsl_blend_a }, __dsl_out);
+        }
+    }
     /* layer core_glow */
     const float dsl_let_cx_19 DSL_MAYBE_UNUSED = (width * 0.500000f);
     const float dsl_let_cy_20 DSL_MAYBE_UNUSED = (height * 0.500000f);
     const float dsl_let_dx_21 DSL_MAYBE_UNUSED = dsl_wrapdx(x, dsl_let_cx_19, width);
     const float dsl_let_dy_22 DSL_MAYBE_UNUSED = (y - dsl_let_cy_20);
     const float dsl_let_dist_23 DSL_MAYBE_UNUSED = sqrtf(((dsl_let_dx_21 * dsl_let_dx_21) + (dsl_let_dy_22 * dsl_let_dy_22)));
-    const float dsl_let_glow_24 DSL_MAYBE_UNUSED = (powf(fmaxf((1.000000f - (dsl_let_dist_23 / 8.000000f)), 0.000000f), 2.000000f) * (0.150000f + (0.850000f * dsl_let_beat_6)));
+    const float dsl_let_glow_24 DSL_MAYBE_UNUSED = (powf(fmaxf((1.000000f - (dsl_let_dist_23 / 8.000000f)), 0.000000f), 2.000000f) * (0.150000f + (0.850000f * heartbeat_pulse_uniforms.dsl_let_beat_6)));
     const float dsl_let_r_25 DSL_MAYBE_UNUSED = (dsl_let_glow_24 * 1.000000f);
     const float dsl_let_g_26 DSL_MAYBE_UNUSED = (dsl_let_glow_24 * 0.200000f);
     const float dsl_let_b_27 DSL_MAYBE_UNUSED = (dsl_let_glow_24 * 0.250000f);
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = dsl_clamp(dsl_let_r_25, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_26, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_27, 0.000000f, 1.000000f), .a = dsl_let_glow_24 }, __dsl_out);
+    {
+        const float __dsl_blend_a = dsl_let_glow_24;
+        if (!(__dsl_blend_a <= 0.0f)) {
+            __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_25, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_26, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_27, 0.000000f, 1.000000f), .a = __dsl_blend_a }, __dsl_out);
+        }
+    }
     *out_color = __dsl_out;
 }
 
+/* Generated from effect: heartbeat_pulse */
+static void heartbeat_pulse_render_rows(float time, float frame, int width_px, int height_px, int row_first, int row_step, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    const float width DSL_MAYBE_UNUSED = (float)width_px;
+    const float height DSL_MAYBE_UNUSED = (float)height_px;
+    for (int py = row_first; py < height_px; py += row_step) {
+        const float y DSL_MAYBE_UNUSED = (float)py;
+        const float dsl_let_cx_7 DSL_MAYBE_UNUSED = (width * 0.500000f);
+        const float dsl_let_cy_8 DSL_MAYBE_UNUSED = (height * 0.500000f);
+        const float dsl_let_dy_10 DSL_MAYBE_UNUSED = (y - dsl_let_cy_8);
+        const float dsl_let_max_r_12 DSL_MAYBE_UNUSED = (height * 0.500000f);
+        const float dsl_let_ring_pos_13 DSL_MAYBE_UNUSED = (heartbeat_pulse_uniforms.dsl_let_beat_6 * dsl_let_max_r_12);
+        const float dsl_let_cx_19 DSL_MAYBE_UNUSED = (width * 0.500000f);
+        const float dsl_let_cy_20 DSL_MAYBE_UNUSED = (height * 0.500000f);
+        const float dsl_let_dy_22 DSL_MAYBE_UNUSED = (y - dsl_let_cy_20);
+        for (int px = 0; px < width_px; px++) {
+            const float x DSL_MAYBE_UNUSED = (float)px;
+            dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
+            /* layer pulse_ring */
+            const float dsl_let_dx_9 DSL_MAYBE_UNUSED = dsl_wrapdx(x, dsl_let_cx_7, width);
+            const float dsl_let_dist_11 DSL_MAYBE_UNUSED = sqrtf(((dsl_let_dx_9 * dsl_let_dx_9) + (dsl_let_dy_10 * dsl_let_dy_10)));
+            const float dsl_let_ring_dist_14 DSL_MAYBE_UNUSED = fabsf((dsl_let_dist_11 - dsl_let_ring_pos_13));
+            const float dsl_let_ring_15 DSL_MAYBE_UNUSED = (dsl_smoothstep(2.500000f, 0.000000f, dsl_let_ring_dist_14) * heartbeat_pulse_uniforms.dsl_let_beat_6);
+            const float dsl_let_r_16 DSL_MAYBE_UNUSED = (dsl_let_ring_15 * 0.900000f);
+            const float dsl_let_g_17 DSL_MAYBE_UNUSED = (dsl_let_ring_15 * 0.100000f);
+            const float dsl_let_b_18 DSL_MAYBE_UNUSED = (dsl_let_ring_15 * 0.150000f);
+            {
+                const float __dsl_blend_a = dsl_let_ring_15;
+                if (!(__dsl_blend_a <= 0.0f)) {
+                    __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_16, 0.000000f, 1.000000f), .g = dsl_let_g_17, .b = dsl_let_b_18, .a = __dsl_blend_a }, __dsl_out);
+                }
+            }
+            /* layer core_glow */
+            const float dsl_let_dx_21 DSL_MAYBE_UNUSED = dsl_wrapdx(x, dsl_let_cx_19, width);
+            const float dsl_let_dist_23 DSL_MAYBE_UNUSED = sqrtf(((dsl_let_dx_21 * dsl_let_dx_21) + (dsl_let_dy_22 * dsl_let_dy_22)));
+            const float dsl_let_glow_24 DSL_MAYBE_UNUSED = (powf(fmaxf((1.000000f - (dsl_let_dist_23 / 8.000000f)), 0.000000f), 2.000000f) * (0.150000f + (0.850000f * heartbeat_pulse_uniforms.dsl_let_beat_6)));
+            const float dsl_let_r_25 DSL_MAYBE_UNUSED = (dsl_let_glow_24 * 1.000000f);
+            const float dsl_let_g_26 DSL_MAYBE_UNUSED = (dsl_let_glow_24 * 0.200000f);
+            const float dsl_let_b_27 DSL_MAYBE_UNUSED = (dsl_let_glow_24 * 0.250000f);
+            {
+                const float __dsl_blend_a = dsl_let_glow_24;
+                if (!(__dsl_blend_a <= 0.0f)) {
+                    __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_25, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_26, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_27, 0.000000f, 1.000000f), .a = __dsl_blend_a }, __dsl_out);
+                }
+            }
+            dsl_store_pixel(pixel_out + (uint32_t)phys_index[py * width_px + px] * 3U, __dsl_out, grb_gamma);
+        }
+    }
+}
+
+/* Generated from effect: heartbeat_pulse */
+static void heartbeat_pulse_render_frame(float time, float frame, int width_px, int height_px, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    heartbeat_pulse_prepare_frame(time, frame, (float)width_px, (float)height_px, seed);
+    heartbeat_pulse_render_rows(time, frame, width_px, height_px, 0, 1, seed, pixel_out, phys_index, grb_gamma);
+}
+
 /* Audio: generated from effect: heartbeat_pulse */
 static float heartbeat_pulse_eval_audio(float time, float seed, float sample_rate, float *phasor_state) {
-    const float dsl_param_bpm_0 DSL_MAYBE_UNUSED = 72.000000f;
+    const float dsl_param_bpm_0 DSL_MAYBE_UNUSED = heartbeat_pulse_params[0].pinned ? heartbeat_pulse_params[0].value : 72.000000f;
     float __dsl_audio_out = 0.0f;
     const float dsl_let_beat_period_1 DSL_MAYBE_UNUSED = (60.000000f / dsl_param_bpm_0);
     const float dsl_let_phase_2 DSL_MAYBE_UNUSED = dsl_fract((time / dsl_let_beat_period_1));
@@ -628,74 +1600,235 @@ static float heartbeat_pulse_eval_audio(float time, float seed, float sample_rat
     return __dsl_audio_out;
 }
 
+static dsl_shader_param_t infinite_lines_params[3] = {
+    { .name = "line_half_width", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "rotation_speed", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "color_speed", .value = 0.0f, .pinned = 0, .settable = 1 },
+};
+
+typedef struct {
+    float dsl_param_line_half_width_0;
+    float dsl_param_rotation_speed_1;
+    float dsl_param_color_speed_2;
+    float dsl_let_t_3;
+    float dsl_let_tc_4;
+    float dsl_let_phase_7[4];
+    float dsl_let_pivot_frac_y_8[4];
+    float dsl_let_pivot_y_9[4];
+    float dsl_let_dir_sign_10[4];
+    float dsl_let_speed_var_11[4];
+    float dsl_let_angle_12[4];
+    float dsl_let_nx_13[4];
+    float dsl_let_ny_14[4];
+    float dsl_let_pivot_theta_15[4];
+    float dsl_let_pivot_x_norm_16[4];
+    float dsl_let_wrap_step_17[4];
+    float dsl_let_hue_phase_18[4];
+    float dsl_let_r_19[4];
+    float dsl_let_g_20[4];
+    float dsl_let_b_21[4];
+    float dsl_let_max_ch_22[4];
+    float dsl_let_boost_23[4];
+    float dsl_let_rb_24[4];
+    float dsl_let_gb_25[4];
+    float dsl_let_bb_26[4];
+} infinite_lines_uniforms_t;
+
+static infinite_lines_uniforms_t infinite_lines_uniforms;
+
 /* Generated from effect: infinite_lines */
-static void infinite_lines_eval_frame(float time, float frame) {
-    const float dsl_param_line_half_width_0 DSL_MAYBE_UNUSED = 0.700000f;
-    const float dsl_param_rotation_speed_1 DSL_MAYBE_UNUSED = 0.350000f;
-    const float dsl_param_color_speed_2 DSL_MAYBE_UNUSED = 0.100000f;
+static void infinite_lines_prepare_frame(float time, float frame, float width, float height, float seed) {
+    const float dsl_param_line_half_width_0 DSL_MAYBE_UNUSED = infinite_lines_params[0].pinned ? infinite_lines_params[0].value : 0.700000f;
+    const float dsl_param_rotation_speed_1 DSL_MAYBE_UNUSED = infinite_lines_params[1].pinned ? infinite_lines_params[1].value : 0.350000f;
+    const float dsl_param_color_speed_2 DSL_MAYBE_UNUSED = infinite_lines_params[2].pinned ? infinite_lines_params[2].value : 0.100000f;
     const float dsl_let_t_3 DSL_MAYBE_UNUSED = (time * dsl_param_rotation_speed_1);
     const float dsl_let_tc_4 DSL_MAYBE_UNUSED = (time * dsl_param_color_speed_2);
+    for (int32_t dsl_iter_i_5 = 0; dsl_iter_i_5 < 4; dsl_iter_i_5++) {
+        const float dsl_index_i_6 DSL_MAYBE_UNUSED = (float)dsl_iter_i_5;
+        const float dsl_let_phase_7 DSL_MAYBE_UNUSED = ((seed * 6.28318530717958647692f) + (dsl_index_i_6 * 1.700000f));
+        const float dsl_let_pivot_frac_y_8 DSL_MAYBE_UNUSED = dsl_fract((seed * (3.170000f + (dsl_index_i_6 * 2.310000f))));
+        const float dsl_let_pivot_y_9 DSL_MAYBE_UNUSED = (dsl_let_pivot_frac_y_8 * height);
+        const float dsl_let_dir_sign_10 DSL_MAYBE_UNUSED = ((floorf((dsl_fract((seed * (7.130000f + (dsl_index_i_6 * 1.930000f)))) + 0.500000f)) * 2.000000f) - 1.000000f);
+        const float dsl_let_speed_var_11 DSL_MAYBE_UNUSED = (0.700000f + (dsl_fract((seed * (5.410000f + (dsl_index_i_6 * 3.070000f)))) * 0.600000f));
+        const float dsl_let_angle_12 DSL_MAYBE_UNUSED = (dsl_let_phase_7 + ((dsl_let_t_3 * dsl_let_dir_sign_10) * dsl_let_speed_var_11));
+        const float dsl_let_nx_13 DSL_MAYBE_UNUSED = (-(sinf(dsl_let_angle_12)));
+        const float dsl_let_ny_14 DSL_MAYBE_UNUSED = cosf(dsl_let_angle_12);
+        const float dsl_let_pivot_theta_15 DSL_MAYBE_UNUSED = (dsl_fract((seed * (1.730000f + (dsl_index_i_6 * 4.190000f)))) * 6.28318530717958647692f);
+        const float dsl_let_pivot_x_norm_16 DSL_MAYBE_UNUSED = ((dsl_let_pivot_theta_15 / 6.28318530717958647692f) * width);
+        const float dsl_let_wrap_step_17 DSL_MAYBE_UNUSED = (width * dsl_let_nx_13);
+        const float dsl_let_hue_phase_18 DSL_MAYBE_UNUSED = ((dsl_let_tc_4 * (0.800000f + (dsl_index_i_6 * 0.300000f))) + (seed * (2.000000f + (dsl_index_i_6 * 1.500000f))));
+        const float dsl_let_r_19 DSL_MAYBE_UNUSED = (0.500000f + (0.500000f * sinf(dsl_let_hue_phase_18)));
+        const float dsl_let_g_20 DSL_MAYBE_UNUSED = (0.500000f + (0.500000f * sinf((dsl_let_hue_phase_18 + 2.094000f))));
+        const float dsl_let_b_21 DSL_MAYBE_UNUSED = (0.500000f + (0.500000f * sinf((dsl_let_hue_phase_18 + 4.189000f))));
+        const float dsl_let_max_ch_22 DSL_MAYBE_UNUSED = fmaxf(dsl_let_r_19, fmaxf(dsl_let_g_20, dsl_let_b_21));
+        const float dsl_let_boost_23 DSL_MAYBE_UNUSED = dsl_clamp((0.850000f / fmaxf(dsl_let_max_ch_22, 0.010000f)), 1.000000f, 2.000000f);
+        const float dsl_let_rb_24 DSL_MAYBE_UNUSED = dsl_clamp((dsl_let_r_19 * dsl_let_boost_23), 0.000000f, 1.000000f);
+        const float dsl_let_gb_25 DSL_MAYBE_UNUSED = dsl_clamp((dsl_let_g_20 * dsl_let_boost_23), 0.000000f, 1.000000f);
+        const float dsl_let_bb_26 DSL_MAYBE_UNUSED = dsl_clamp((dsl_let_b_21 * dsl_let_boost_23), 0.000000f, 1.000000f);
+        infinite_lines_uniforms.dsl_let_phase_7[dsl_iter_i_5] = dsl_let_phase_7;
+        infinite_lines_uniforms.dsl_let_pivot_frac_y_8[dsl_iter_i_5] = dsl_let_pivot_frac_y_8;
+        infinite_lines_uniforms.dsl_let_pivot_y_9[dsl_iter_i_5] = dsl_let_pivot_y_9;
+        infinite_lines_uniforms.dsl_let_dir_sign_10[dsl_iter_i_5] = dsl_let_dir_sign_10;
+        infinite_lines_uniforms.dsl_let_speed_var_11[dsl_iter_i_5] = dsl_let_speed_var_11;
+        infinite_lines_uniforms.dsl_let_angle_12[dsl_iter_i_5] = dsl_let_angle_12;
+        infinite_lines_uniforms.dsl_let_nx_13[dsl_iter_i_5] = dsl_let_nx_13;
+        infinite_lines_uniforms.dsl_let_ny_14[dsl_iter_i_5] = dsl_let_ny_14;
+        infinite_lines_uniforms.dsl_let_pivot_theta_15[dsl_iter_i_5] = dsl_let_pivot_theta_15;
+        infinite_lines_uniforms.dsl_let_pivot_x_norm_16[dsl_iter_i_5] = dsl_let_pivot_x_norm_16;
+        infinite_lines_uniforms.dsl_let_wrap_step_17[dsl_iter_i_5] = dsl_let_wrap_step_17;
+        infinite_lines_uniforms.dsl_let_hue_phase_18[dsl_iter_i_5] = dsl_let_hue_phase_18;
+        infinite_lines_uniforms.dsl_let_r_19[dsl_iter_i_5] = dsl_let_r_19;
+        infinite_lines_uniforms.dsl_let_g_20[dsl_iter_i_5] = dsl_let_g_20;
+        infinite_lines_uniforms.dsl_let_b_21[dsl_iter_i_5] = dsl_let_b_21;
+        infinite_lines_uniforms.dsl_let_max_ch_22[dsl_iter_i_5] = dsl_let_max_ch_22;
+        infinite_lines_uniforms.dsl_let_boost_23[dsl_iter_i_5] = dsl_let_boost_23;
+        infinite_lines_uniforms.dsl_let_rb_24[dsl_iter_i_5] = dsl_let_rb_24;
+        infinite_lines_uniforms.dsl_let_gb_25[dsl_iter_i_5] = dsl_let_gb_25;
+        infinite_lines_uniforms.dsl_let_bb_26[dsl_iter_i_5] = dsl_let_bb_26;
+    }
+    infinite_lines_uniforms.dsl_param_line_half_width_0 = dsl_param_line_half_width_0;
+    infinite_lines_uniforms.dsl_param_rotation_speed_1 = dsl_param_rotation_speed_1;
+    infinite_lines_uniforms.dsl_param_color_speed_2 = dsl_param_color_speed_2;
+    infinite_lines_uniforms.dsl_let_t_3 = dsl_let_t_3;
+    infinite_lines_uniforms.dsl_let_tc_4 = dsl_let_tc_4;
 }
 
 /* Generated from effect: infinite_lines */
 static void infinite_lines_eval_pixel(float time, float frame, float x, float y, float width, float height, float seed, dsl_color_t *out_color) {
-    const float dsl_param_line_half_width_0 DSL_MAYBE_UNUSED = 0.700000f;
-    const float dsl_param_rotation_speed_1 DSL_MAYBE_UNUSED = 0.350000f;
-    const float dsl_param_color_speed_2 DSL_MAYBE_UNUSED = 0.100000f;
-    const float dsl_let_t_3 DSL_MAYBE_UNUSED = (time * dsl_param_rotation_speed_1);
-    const float dsl_let_tc_4 DSL_MAYBE_UNUSED = (time * dsl_param_color_speed_2);
     dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
     /* layer lines */
-    const float dsl_let_theta_5 DSL_MAYBE_UNUSED = ((x / width) * 6.28318530717958647692f);
-    for (int32_t dsl_iter_i_6 = 0; dsl_iter_i_6 < 4; dsl_iter_i_6++) {
-        const float dsl_index_i_7 DSL_MAYBE_UNUSED = (float)dsl_iter_i_6;
-        const float dsl_let_phase_8 DSL_MAYBE_UNUSED = ((seed * 6.28318530717958647692f) + (dsl_index_i_7 * 1.700000f));
-        const float dsl_let_pivot_frac_y_9 DSL_MAYBE_UNUSED = dsl_fract((seed * (3.170000f + (dsl_index_i_7 * 2.310000f))));
-        const float dsl_let_pivot_y_10 DSL_MAYBE_UNUSED = (dsl_let_pivot_frac_y_9 * height);
-        const float dsl_let_dir_sign_11 DSL_MAYBE_UNUSED = ((floorf((dsl_fract((seed * (7.130000f + (dsl_index_i_7 * 1.930000f)))) + 0.500000f)) * 2.000000f) - 1.000000f);
-        const float dsl_let_speed_var_12 DSL_MAYBE_UNUSED = (0.700000f + (dsl_fract((seed * (5.410000f + (dsl_index_i_7 * 3.070000f)))) * 0.600000f));
-        const float dsl_let_angle_13 DSL_MAYBE_UNUSED = (dsl_let_phase_8 + ((dsl_let_t_3 * dsl_let_dir_sign_11) * dsl_let_speed_var_12));
-        const float dsl_let_nx_14 DSL_MAYBE_UNUSED = (-(sinf(dsl_let_angle_13)));
-        const float dsl_let_ny_15 DSL_MAYBE_UNUSED = cosf(dsl_let_angle_13);
-        const float dsl_let_pivot_theta_16 DSL_MAYBE_UNUSED = (dsl_fract((seed * (1.730000f + (dsl_index_i_7 * 4.190000f)))) * 6.28318530717958647692f);
-        const float dsl_let_pivot_x_norm_17 DSL_MAYBE_UNUSED = ((dsl_let_pivot_theta_16 / 6.28318530717958647692f) * width);
-        const float dsl_let_rel_x_18 DSL_MAYBE_UNUSED = (x - dsl_let_pivot_x_norm_17);
-        const float dsl_let_rel_y_19 DSL_MAYBE_UNUSED = (y - dsl_let_pivot_y_10);
-        const float dsl_let_base_proj_20 DSL_MAYBE_UNUSED = ((dsl_let_rel_x_18 * dsl_let_nx_14) + (dsl_let_rel_y_19 * dsl_let_ny_15));
-        const float dsl_let_wrap_step_21 DSL_MAYBE_UNUSED = (width * dsl_let_nx_14);
-        const float dsl_let_d_center_22 DSL_MAYBE_UNUSED = fabsf(dsl_let_base_proj_20);
-        const float dsl_let_d_left_23 DSL_MAYBE_UNUSED = fabsf((dsl_let_base_proj_20 - dsl_let_wrap_step_21));
-        const float dsl_let_d_right_24 DSL_MAYBE_UNUSED = fabsf((dsl_let_base_proj_20 + dsl_let_wrap_step_21));
-        const float dsl_let_d_25 DSL_MAYBE_UNUSED = fminf(dsl_let_d_center_22, fminf(dsl_let_d_left_23, dsl_let_d_right_24));
-        const float dsl_let_line_alpha_26 DSL_MAYBE_UNUSED = (1.000000f - dsl_smoothstep((dsl_param_line_half_width_0 * 0.300000f), dsl_param_line_half_width_0, dsl_let_d_25));
-        const float dsl_let_hue_phase_27 DSL_MAYBE_UNUSED = ((dsl_let_tc_4 * (0.800000f + (dsl_index_i_7 * 0.300000f))) + (seed * (2.000000f + (dsl_index_i_7 * 1.500000f))));
-        const float dsl_let_r_28 DSL_MAYBE_UNUSED = (0.500000f + (0.500000f * sinf(dsl_let_hue_phase_27)));
-        const float dsl_let_g_29 DSL_MAYBE_UNUSED = (0.500000f + (0.500000f * sinf((dsl_let_hue_phase_27 + 2.094000f))));
-        const float dsl_let_b_30 DSL_MAYBE_UNUSED = (0.500000f + (0.500000f * sinf((dsl_let_hue_phase_27 + 4.189000f))));
-        const float dsl_let_max_ch_31 DSL_MAYBE_UNUSED = fmaxf(dsl_let_r_28, fmaxf(dsl_let_g_29, dsl_let_b_30));
-        const float dsl_let_boost_32 DSL_MAYBE_UNUSED = dsl_clamp((0.850000f / fmaxf(dsl_let_max_ch_31, 0.010000f)), 1.000000f, 2.000000f);
-        const float dsl_let_rb_33 DSL_MAYBE_UNUSED = dsl_clamp((dsl_let_r_28 * dsl_let_boost_32), 0.000000f, 1.000000f);
-        const float dsl_let_gb_34 DSL_MAYBE_UNUSED = dsl_clamp((dsl_let_g_29 * dsl_let_boost_32), 0.000000f, 1.000000f);
-        const float dsl_let_bb_35 DSL_MAYBE_UNUSED = dsl_clamp((dsl_let_b_30 * dsl_let_boost_32), 0.000000f, 1.000000f);
-        __dsl_out = dsl_blend_over((dsl_color_t){ .r = dsl_let_rb_33, .g = dsl_let_gb_34, .b = dsl_let_bb_35, .a = dsl_let_line_alpha_26 }, __dsl_out);
+    const float dsl_let_theta_27 DSL_MAYBE_UNUSED = ((x / width) * 6.28318530717958647692f);
+    for (int32_t dsl_iter_i_28 = 0; dsl_iter_i_28 < 4; dsl_iter_i_28++) {
+        const float dsl_index_i_29 DSL_MAYBE_UNUSED = (float)dsl_iter_i_28;
+        const float dsl_let_phase_30 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_phase_7[dsl_iter_i_28];
+        const float dsl_let_pivot_frac_y_31 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_pivot_frac_y_8[dsl_iter_i_28];
+        const float dsl_let_pivot_y_32 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_pivot_y_9[dsl_iter_i_28];
+        const float dsl_let_dir_sign_33 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_dir_sign_10[dsl_iter_i_28];
+        const float dsl_let_speed_var_34 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_speed_var_11[dsl_iter_i_28];
+        const float dsl_let_angle_35 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_angle_12[dsl_iter_i_28];
+        const float dsl_let_nx_36 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_nx_13[dsl_iter_i_28];
+        const float dsl_let_ny_37 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_ny_14[dsl_iter_i_28];
+        const float dsl_let_pivot_theta_38 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_pivot_theta_15[dsl_iter_i_28];
+        const float dsl_let_pivot_x_norm_39 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_pivot_x_norm_16[dsl_iter_i_28];
+        const float dsl_let_rel_x_40 DSL_MAYBE_UNUSED = (x - dsl_let_pivot_x_norm_39);
+        const float dsl_let_rel_y_41 DSL_MAYBE_UNUSED = (y - dsl_let_pivot_y_32);
+        const float dsl_let_base_proj_42 DSL_MAYBE_UNUSED = ((dsl_let_rel_x_40 * dsl_let_nx_36) + (dsl_let_rel_y_41 * dsl_let_ny_37));
+        const float dsl_let_wrap_step_43 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_wrap_step_17[dsl_iter_i_28];
+        const float dsl_let_d_center_44 DSL_MAYBE_UNUSED = fabsf(dsl_let_base_proj_42);
+        const float dsl_let_d_left_45 DSL_MAYBE_UNUSED = fabsf((dsl_let_base_proj_42 - dsl_let_wrap_step_43));
+        const float dsl_let_d_right_46 DSL_MAYBE_UNUSED = fabsf((dsl_let_base_proj_42 + dsl_let_wrap_step_43));
+        const float dsl_let_d_47 DSL_MAYBE_UNUSED = fminf(dsl_let_d_center_44, fminf(dsl_let_d_left_45, dsl_let_d_right_46));
+        const float dsl_let_line_alpha_48 DSL_MAYBE_UNUSED = (1.000000f - dsl_smoothstep((infinite_lines_uniforms.dsl_param_line_half_width_0 * 0.300000f), infinite_lines_uniforms.dsl_param_line_half_width_0, dsl_let_d_47));
+        const float dsl_let_hue_phase_49 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_hue_phase_18[dsl_iter_i_28];
+        const float dsl_let_r_50 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_r_19[dsl_iter_i_28];
+        const float dsl_let_g_51 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_g_20[dsl_iter_i_28];
+        const float dsl_let_b_52 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_b_21[dsl_iter_i_28];
+        const float dsl_let_max_ch_53 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_max_ch_22[dsl_iter_i_28];
+        const float dsl_let_boost_54 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_boost_23[dsl_iter_i_28];
+        const float dsl_let_rb_55 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_rb_24[dsl_iter_i_28];
+        const float dsl_let_gb_56 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_gb_25[dsl_iter_i_28];
+        const float dsl_let_bb_57 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_bb_26[dsl_iter_i_28];
+        {
+            const float __dsl_blend_a = dsl_let_line_alpha_48;
+            if (!(__dsl_blend_a <= 0.0f)) {
+                __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_let_rb_55, .g = dsl_let_gb_56, .b = dsl_let_bb_57, .a = __dsl_blend_a }, __dsl_out);
+            }
+        }
     }
     *out_color = __dsl_out;
 }
 
+/* Generated from effect: infinite_lines */
+static void infinite_lines_render_rows(float time, float frame, int width_px, int height_px, int row_first, int row_step, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    const float width DSL_MAYBE_UNUSED = (float)width_px;
+    const float height DSL_MAYBE_UNUSED = (float)height_px;
+    for (int py = row_first; py < height_px; py += row_step) {
+        const float y DSL_MAYBE_UNUSED = (float)py;
+        for (int px = 0; px < width_px; px++) {
+            const float x DSL_MAYBE_UNUSED = (float)px;
+            dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
+            /* layer lines */
+            const float dsl_let_theta_27 DSL_MAYBE_UNUSED = ((x / width) * 6.28318530717958647692f);
+            for (int32_t dsl_iter_i_28 = 0; dsl_iter_i_28 < 4; dsl_iter_i_28++) {
+                const float dsl_index_i_29 DSL_MAYBE_UNUSED = (float)dsl_iter_i_28;
+                const float dsl_let_phase_30 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_phase_7[dsl_iter_i_28];
+                const float dsl_let_pivot_frac_y_31 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_pivot_frac_y_8[dsl_iter_i_28];
+                const float dsl_let_pivot_y_32 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_pivot_y_9[dsl_iter_i_28];
+                const float dsl_let_dir_sign_33 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_dir_sign_10[dsl_iter_i_28];
+                const float dsl_let_speed_var_34 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_speed_var_11[dsl_iter_i_28];
+                const float dsl_let_angle_35 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_angle_12[dsl_iter_i_28];
+                const float dsl_let_nx_36 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_nx_13[dsl_iter_i_28];
+                const float dsl_let_ny_37 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_ny_14[dsl_iter_i_28];
+                const float dsl_let_pivot_theta_38 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_pivot_theta_15[dsl_iter_i_28];
+                const float dsl_let_pivot_x_norm_39 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_pivot_x_norm_16[dsl_iter_i_28];
+                const float dsl_let_rel_x_40 DSL_MAYBE_UNUSED = (x - dsl_let_pivot_x_norm_39);
+                const float dsl_let_rel_y_41 DSL_MAYBE_UNUSED = (y - dsl_let_pivot_y_32);
+                const float dsl_let_base_proj_42 DSL_MAYBE_UNUSED = ((dsl_let_rel_x_40 * dsl_let_nx_36) + (dsl_let_rel_y_41 * dsl_let_ny_37));
+                const float dsl_let_wrap_step_43 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_wrap_step_17[dsl_iter_i_28];
+                const float dsl_let_d_center_44 DSL_MAYBE_UNUSED = fabsf(dsl_let_base_proj_42);
+                const float dsl_let_d_left_45 DSL_MAYBE_UNUSED = fabsf((dsl_let_base_proj_42 - dsl_let_wrap_step_43));
+                const float dsl_let_d_right_46 DSL_MAYBE_UNUSED = fabsf((dsl_let_base_proj_42 + dsl_let_wrap_step_43));
+                const float dsl_let_d_47 DSL_MAYBE_UNUSED = fminf(dsl_let_d_center_44, fminf(dsl_let_d_left_45, dsl_let_d_right_46));
+                const float dsl_let_line_alpha_48 DSL_MAYBE_UNUSED = (1.000000f - dsl_smoothstep((infinite_lines_uniforms.dsl_param_line_half_width_0 * 0.300000f), infinite_lines_uniforms.dsl_param_line_half_width_0, dsl_let_d_47));
+                const float dsl_let_hue_phase_49 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_hue_phase_18[dsl_iter_i_28];
+                const float dsl_let_r_50 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_r_19[dsl_iter_i_28];
+                const float dsl_let_g_51 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_g_20[dsl_iter_i_28];
+                const float dsl_let_b_52 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_b_21[dsl_iter_i_28];
+                const float dsl_let_max_ch_53 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_max_ch_22[dsl_iter_i_28];
+                const float dsl_let_boost_54 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_boost_23[dsl_iter_i_28];
+                const float dsl_let_rb_55 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_rb_24[dsl_iter_i_28];
+                const float dsl_let_gb_56 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_gb_25[dsl_iter_i_28];
+                const float dsl_let_bb_57 DSL_MAYBE_UNUSED = infinite_lines_uniforms.dsl_let_bb_26[dsl_iter_i_28];
+                {
+                    const float __dsl_blend_a = dsl_let_line_alpha_48;
+                    if (!(__dsl_blend_a <= 0.0f)) {
+                        __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_let_rb_55, .g = dsl_let_gb_56, .b = dsl_let_bb_57, .a = __dsl_blend_a }, __dsl_out);
+                    }
+                }
+            }
+            dsl_store_pixel(pixel_out + (uint32_t)phys_index[py * width_px + px] * 3U, __dsl_out, grb_gamma);
+        }
+    }
+}
+
+/* Generated from effect: infinite_lines */
+static void infinite_lines_render_frame(float time, float frame, int width_px, int height_px, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    infinite_lines_prepare_frame(time, frame, (float)width_px, (float)height_px, seed);
+    infinite_lines_render_rows(time, frame, width_px, height_px, 0, 1, seed, pixel_out, phys_index, grb_gamma);
+}
+
+static dsl_shader_param_t lava_lamp_params[2] = {
+    { .name = "drift", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "blob_scale", .value = 0.0f, .pinned = 0, .settable = 1 },
+};
+
+typedef struct {
+    float dsl_param_drift_0;
+    float dsl_param_blob_scale_1;
+} lava_lamp_uniforms_t;
+
+static lava_lamp_uniforms_t lava_lamp_uniforms;
+
+/* Generated from effect: lava_lamp */
+static void lava_lamp_prepare_frame(float time, float frame, float width, float height, float seed) {
+    const float dsl_param_drift_0 DSL_MAYBE_UNUSED = lava_lamp_params[0].pinned ? lava_lamp_params[0].value : 0.300000f;
+    const float dsl_param_blob_scale_1 DSL_MAYBE_UNUSED = lava_lamp_params[1].pinned ? lava_lamp_params[1].value : 0.070000f;
+    lava_lamp_uniforms.dsl_param_drift_0 = dsl_param_drift_0;
+    lava_lamp_uniforms.dsl_param_blob_scale_1 = dsl_param_blob_scale_1;
+}
+
 /* Generated from effect: lava_lamp */
 static void lava_lamp_eval_pixel(float time, float frame, float x, float y, float width, float height, float seed, dsl_color_t *out_color) {
-    const float dsl_param_drift_0 DSL_MAYBE_UNUSED = 0.300000f;
-    const float dsl_param_blob_scale_1 DSL_MAYBE_UNUSED = 0.070000f;
     dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
     /* layer warm_bg */
     const float dsl_let_ny_2 DSL_MAYBE_UNUSED = (y / height);
     const float dsl_let_r_3 DSL_MAYBE_UNUSED = (0.120000f + (0.080000f * dsl_let_ny_2));
     const float dsl_let_g_4 DSL_MAYBE_UNUSED = (0.030000f + (0.020000f * dsl_let_ny_2));
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = dsl_let_r_3, .g = dsl_let_g_4, .b = 0.010000f, .a = 1.000000f }, __dsl_out);
+    __dsl_out = dsl_color_opaque((dsl_color_t){ .r = dsl_let_r_3, .g = dsl_let_g_4, .b = 0.010000f, .a = 1.000000f });
     /* layer blobs */
-    const float dsl_let_nx_5 DSL_MAYBE_UNUSED = (x * dsl_param_blob_scale_1);
-    const float dsl_let_ny_6 DSL_MAYBE_UNUSED = (y * dsl_param_blob_scale_1);
-    const float dsl_let_t_7 DSL_MAYBE_UNUSED = (time * dsl_param_drift_0);
+    const float dsl_let_nx_5 DSL_MAYBE_UNUSED = (x * lava_lamp_uniforms.dsl_param_blob_scale_1);
+    const float dsl_let_ny_6 DSL_MAYBE_UNUSED = (y * lava_lamp_uniforms.dsl_param_blob_scale_1);
+    const float dsl_let_t_7 DSL_MAYBE_UNUSED = (time * lava_lamp_uniforms.dsl_param_drift_0);
     const float dsl_let_n1_8 DSL_MAYBE_UNUSED = ((dsl_noise2((dsl_let_nx_5 + (dsl_let_t_7 * 0.700000f)), (dsl_let_ny_6 - dsl_let_t_7)) * 0.500000f) + 0.500000f);
     const float dsl_let_n2_9 DSL_MAYBE_UNUSED = ((dsl_noise2(((dsl_let_nx_5 * 1.500000f) - (dsl_let_t_7 * 0.400000f)), ((dsl_let_ny_6 * 1.500000f) + (dsl_let_t_7 * 0.600000f))) * 0.500000f) + 0.500000f);
     const float dsl_let_combined_10 DSL_MAYBE_UNUSED = ((dsl_let_n1_8 + dsl_let_n2_9) * 0.500000f);
@@ -704,90 +1837,287 @@ static void lava_lamp_eval_pixel(float time, float frame, float x, float y, floa
     const float dsl_let_r_13 DSL_MAYBE_UNUSED = (dsl_let_blob_11 * (0.900000f + (0.100000f * dsl_let_hue_noise_12)));
     const float dsl_let_g_14 DSL_MAYBE_UNUSED = (dsl_let_blob_11 * (0.250000f + (0.450000f * dsl_let_hue_noise_12)));
     const float dsl_let_b_15 DSL_MAYBE_UNUSED = ((dsl_let_blob_11 * 0.050000f) * dsl_let_hue_noise_12);
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = dsl_clamp(dsl_let_r_13, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_14, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_15, 0.000000f, 1.000000f), .a = (dsl_let_blob_11 * 0.850000f) }, __dsl_out);
+    {
+        const float __dsl_blend_a = (dsl_let_blob_11 * 0.850000f);
+        if (!(__dsl_blend_a <= 0.0f)) {
+            __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_13, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_14, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_15, 0.000000f, 1.000000f), .a = __dsl_blend_a }, __dsl_out);
+        }
+    }
     /* layer hot_spots */
-    const float dsl_let_nx_16 DSL_MAYBE_UNUSED = ((x * dsl_param_blob_scale_1) * 1.300000f);
-    const float dsl_let_ny_17 DSL_MAYBE_UNUSED = ((y * dsl_param_blob_scale_1) * 1.300000f);
-    const float dsl_let_t_18 DSL_MAYBE_UNUSED = ((time * dsl_param_drift_0) * 0.800000f);
+    const float dsl_let_nx_16 DSL_MAYBE_UNUSED = ((x * lava_lamp_uniforms.dsl_param_blob_scale_1) * 1.300000f);
+    const float dsl_let_ny_17 DSL_MAYBE_UNUSED = ((y * lava_lamp_uniforms.dsl_param_blob_scale_1) * 1.300000f);
+    const float dsl_let_t_18 DSL_MAYBE_UNUSED = ((time * lava_lamp_uniforms.dsl_param_drift_0) * 0.800000f);
     const float dsl_let_n_19 DSL_MAYBE_UNUSED = dsl_noise2((dsl_let_nx_16 - (dsl_let_t_18 * 0.500000f)), (dsl_let_ny_17 + (dsl_let_t_18 * 0.300000f)));
     const float dsl_let_hot_20 DSL_MAYBE_UNUSED = (powf(fmaxf(dsl_let_n_19, 0.000000f), 4.000000f) * 0.600000f);
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = (1.000000f * dsl_let_hot_20), .g = (0.900000f * dsl_let_hot_20), .b = (0.400000f * dsl_let_hot_20), .a = dsl_let_hot_20 }, __dsl_out);
+    {
+        const float __dsl_blend_a = dsl_let_hot_20;
+        if (!(__dsl_blend_a <= 0.0f)) {
+            __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = (1.000000f * dsl_let_hot_20), .g = (0.900000f * dsl_let_hot_20), .b = (0.400000f * dsl_let_hot_20), .a = __dsl_blend_a }, __dsl_out);
+        }
+    }
     *out_color = __dsl_out;
 }
 
+/* Generated from effect: lava_lamp */
+static void lava_lamp_render_rows(float time, float frame, int width_px, int height_px, int row_first, int row_step, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    const float width DSL_MAYBE_UNUSED = (float)width_px;
+    const float height DSL_MAYBE_UNUSED = (float)height_px;
+    for (int py = row_first; py < height_px; py += row_step) {
+        const float y DSL_MAYBE_UNUSED = (float)py;
+        const float dsl_let_ny_2 DSL_MAYBE_UNUSED = (y / height);
+        const float dsl_let_r_3 DSL_MAYBE_UNUSED = (0.120000f + (0.080000f * dsl_let_ny_2));
+        const float dsl_let_g_4 DSL_MAYBE_UNUSED = (0.030000f + (0.020000f * dsl_let_ny_2));
+        const float dsl_let_ny_6 DSL_MAYBE_UNUSED = (y * lava_lamp_uniforms.dsl_param_blob_scale_1);
+        const float dsl_let_t_7 DSL_MAYBE_UNUSED = (time * lava_lamp_uniforms.dsl_param_drift_0);
+        const float dsl_let_ny_17 DSL_MAYBE_UNUSED = ((y * lava_lamp_uniforms.dsl_param_blob_scale_1) * 1.300000f);
+        const float dsl_let_t_18 DSL_MAYBE_UNUSED = ((time * lava_lamp_uniforms.dsl_param_drift_0) * 0.800000f);
+        for (int px = 0; px < width_px; px++) {
+            const float x DSL_MAYBE_UNUSED = (float)px;
+            dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
+            /* layer warm_bg */
+            __dsl_out = dsl_color_opaque((dsl_color_t){ .r = dsl_let_r_3, .g = dsl_let_g_4, .b = 0.010000f, .a = 1.000000f });
+            /* layer blobs */
+            const float dsl_let_nx_5 DSL_MAYBE_UNUSED = (x * lava_lamp_uniforms.dsl_param_blob_scale_1);
+            const float dsl_let_n1_8 DSL_MAYBE_UNUSED = ((dsl_noise2((dsl_let_nx_5 + (dsl_let_t_7 * 0.700000f)), (dsl_let_ny_6 - dsl_let_t_7)) * 0.500000f) + 0.500000f);
+            const float dsl_let_n2_9 DSL_MAYBE_UNUSED = ((dsl_noise2(((dsl_let_nx_5 * 1.500000f) - (dsl_let_t_7 * 0.400000f)), ((dsl_let_ny_6 * 1.500000f) + (dsl_let_t_7 * 0.600000f))) * 0.500000f) + 0.500000f);
+            const float dsl_let_combined_10 DSL_MAYBE_UNUSED = ((dsl_let_n1_8 + dsl_let_n2_9) * 0.500000f);
+            const float dsl_let_blob_11 DSL_MAYBE_UNUSED = powf(dsl_smoothstep(0.350000f, 0.650000f, dsl_let_combined_10), 1.500000f);
+            const float dsl_let_hue_noise_12 DSL_MAYBE_UNUSED = ((dsl_noise2(((dsl_let_nx_5 * 0.500000f) + (dsl_let_t_7 * 0.200000f)), (dsl_let_ny_6 * 0.500000f)) * 0.500000f) + 0.500000f);
+            const float dsl_let_r_13 DSL_MAYBE_UNUSED = (dsl_let_blob_11 * (0.900000f + (0.100000f * dsl_let_hue_noise_12)));
+            const float dsl_let_g_14 DSL_MAYBE_UNUSED = (dsl_let_blob_11 * (0.250000f + (0.450000f * dsl_let_hue_noise_12)));
+            const float dsl_let_b_15 DSL_MAYBE_UNUSED = ((dsl_let_blob_11 * 0.050000f) * dsl_let_hue_noise_12);
+            {
+                const float __dsl_blend_a = (dsl_let_blob_11 * 0.850000f);
+                if (!(__dsl_blend_a <= 0.0f)) {
+                    __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_13, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_14, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_15, 0.000000f, 1.000000f), .a = __dsl_blend_a }, __dsl_out);
+                }
+            }
+            /* layer hot_spots */
+            const float dsl_let_nx_16 DSL_MAYBE_UNUSED = ((x * lava_lamp_uniforms.dsl_param_blob_scale_1) * 1.300000f);
+            const float dsl_let_n_19 DSL_MAYBE_UNUSED = dsl_noise2((dsl_let_nx_16 - (dsl_let_t_18 * 0.500000f)), (dsl_let_ny_17 + (dsl_let_t_18 * 0.300000f)));
+            const float dsl_let_hot_20 DSL_MAYBE_UNUSED = (powf(fmaxf(dsl_let_n_19, 0.000000f), 4.000000f) * 0.600000f);
+            {
+                const float __dsl_blend_a = dsl_let_hot_20;
+                if (!(__dsl_blend_a <= 0.0f)) {
+                    __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = (1.000000f * dsl_let_hot_20), .g = (0.900000f * dsl_let_hot_20), .b = (0.400000f * dsl_let_hot_20), .a = __dsl_blend_a }, __dsl_out);
+                }
+            }
+            dsl_store_pixel(pixel_out + (uint32_t)phys_index[py * width_px + px] * 3U, __dsl_out, grb_gamma);
+        }
+    }
+}
+
+/* Generated from effect: lava_lamp */
+static void lava_lamp_render_frame(float time, float frame, int width_px, int height_px, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    lava_lamp_prepare_frame(time, frame, (float)width_px, (float)height_px, seed);
+    lava_lamp_render_rows(time, frame, width_px, height_px, 0, 1, seed, pixel_out, phys_index, grb_gamma);
+}
+
+static dsl_shader_param_t ocean_waves_params[4] = {
+    { .name = "speed", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "scale1", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "scale2", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "scale3", .value = 0.0f, .pinned = 0, .settable = 1 },
+};
+
+typedef struct {
+    float dsl_param_speed_0;
+    float dsl_param_scale1_1;
+    float dsl_param_scale2_2;
+    float dsl_param_scale3_3;
+} ocean_waves_uniforms_t;
+
+static ocean_waves_uniforms_t ocean_waves_uniforms;
+
+/* Generated from effect: ocean_waves */
+static void ocean_waves_prepare_frame(float time, float frame, float width, float height, float seed) {
+    const float dsl_param_speed_0 DSL_MAYBE_UNUSED = ocean_waves_params[0].pinned ? ocean_waves_params[0].value : 0.400000f;
+    const float dsl_param_scale1_1 DSL_MAYBE_UNUSED = ocean_waves_params[1].pinned ? ocean_waves_params[1].value : 0.150000f;
+    const float dsl_param_scale2_2 DSL_MAYBE_UNUSED = ocean_waves_params[2].pinned ? ocean_waves_params[2].value : 0.080000f;
+    const float dsl_param_scale3_3 DSL_MAYBE_UNUSED = ocean_waves_params[3].pinned ? ocean_waves_params[3].value : 0.220000f;
+    ocean_waves_uniforms.dsl_param_speed_0 = dsl_param_speed_0;
+    ocean_waves_uniforms.dsl_param_scale1_1 = dsl_param_scale1_1;
+    ocean_waves_uniforms.dsl_param_scale2_2 = dsl_param_scale2_2;
+    ocean_waves_uniforms.dsl_param_scale3_3 = dsl_param_scale3_3;
+}
+
 /* Generated from effect: ocean_waves */
 static void ocean_waves_eval_pixel(float time, float frame, float x, float y, float width, float height, float seed, dsl_color_t *out_color) {
-    const float dsl_param_speed_0 DSL_MAYBE_UNUSED = 0.400000f;
-    const float dsl_param_scale1_1 DSL_MAYBE_UNUSED = 0.150000f;
-    const float dsl_param_scale2_2 DSL_MAYBE_UNUSED = 0.080000f;
-    const float dsl_param_scale3_3 DSL_MAYBE_UNUSED = 0.220000f;
     dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
     /* layer deep_water */
-    const float dsl_let_nx_4 DSL_MAYBE_UNUSED = (x * dsl_param_scale1_1);
-    const float dsl_let_ny_5 DSL_MAYBE_UNUSED = (y * dsl_param_scale1_1);
-    const float dsl_let_n_6 DSL_MAYBE_UNUSED = dsl_noise2((dsl_let_nx_4 + ((time * dsl_param_speed_0) * 0.600000f)), (dsl_let_ny_5 + ((time * dsl_param_speed_0) * 0.300000f)));
+    const float dsl_let_nx_4 DSL_MAYBE_UNUSED = (x * ocean_waves_uniforms.dsl_param_scale1_1);
+    const float dsl_let_ny_5 DSL_MAYBE_UNUSED = (y * ocean_waves_uniforms.dsl_param_scale1_1);
+    const float dsl_let_n_6 DSL_MAYBE_UNUSED = dsl_noise2((dsl_let_nx_4 + ((time * ocean_waves_uniforms.dsl_param_speed_0) * 0.600000f)), (dsl_let_ny_5 + ((time * ocean_waves_uniforms.dsl_param_speed_0) * 0.300000f)));
     const float dsl_let_val_7 DSL_MAYBE_UNUSED = ((dsl_let_n_6 * 0.500000f) + 0.500000f);
     const float dsl_let_dark_8 DSL_MAYBE_UNUSED = (dsl_let_val_7 * 0.350000f);
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = 0.000000f, .g = (dsl_let_dark_8 * 0.600000f), .b = dsl_let_dark_8, .a = 1.000000f }, __dsl_out);
+    __dsl_out = dsl_color_opaque((dsl_color_t){ .r = 0.000000f, .g = (dsl_let_dark_8 * 0.600000f), .b = dsl_let_dark_8, .a = 1.000000f });
     /* layer mid_waves */
-    const float dsl_let_nx_9 DSL_MAYBE_UNUSED = (x * dsl_param_scale2_2);
-    const float dsl_let_ny_10 DSL_MAYBE_UNUSED = (y * dsl_param_scale2_2);
-    const float dsl_let_n_11 DSL_MAYBE_UNUSED = dsl_noise2((dsl_let_nx_9 + (time * dsl_param_speed_0)), (dsl_let_ny_10 - ((time * dsl_param_speed_0) * 0.500000f)));
+    const float dsl_let_nx_9 DSL_MAYBE_UNUSED = (x * ocean_waves_uniforms.dsl_param_scale2_2);
+    const float dsl_let_ny_10 DSL_MAYBE_UNUSED = (y * ocean_waves_uniforms.dsl_param_scale2_2);
+    const float dsl_let_n_11 DSL_MAYBE_UNUSED = dsl_noise2((dsl_let_nx_9 + (time * ocean_waves_uniforms.dsl_param_speed_0)), (dsl_let_ny_10 - ((time * ocean_waves_uniforms.dsl_param_speed_0) * 0.500000f)));
     const float dsl_let_val_12 DSL_MAYBE_UNUSED = ((dsl_let_n_11 * 0.500000f) + 0.500000f);
     const float dsl_let_bright_13 DSL_MAYBE_UNUSED = (powf(dsl_let_val_12, 1.500000f) * 0.550000f);
     const float dsl_let_a_14 DSL_MAYBE_UNUSED = dsl_smoothstep(0.150000f, 0.500000f, dsl_let_bright_13);
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = 0.050000f, .g = (dsl_let_bright_13 * 0.800000f), .b = dsl_let_bright_13, .a = dsl_let_a_14 }, __dsl_out);
+    {
+        const float __dsl_blend_a = dsl_let_a_14;
+        if (!(__dsl_blend_a <= 0.0f)) {
+            __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = 0.050000f, .g = (dsl_let_bright_13 * 0.800000f), .b = dsl_let_bright_13, .a = __dsl_blend_a }, __dsl_out);
+        }
+    }
     /* layer surface_foam */
-    const float dsl_let_nx_15 DSL_MAYBE_UNUSED = (x * dsl_param_scale3_3);
-    const float dsl_let_ny_16 DSL_MAYBE_UNUSED = (y * dsl_param_scale3_3);
-    const float dsl_let_n_17 DSL_MAYBE_UNUSED = dsl_noise2((dsl_let_nx_15 - ((time * dsl_param_speed_0) * 1.200000f)), (dsl_let_ny_16 + ((time * dsl_param_speed_0) * 0.700000f)));
+    const float dsl_let_nx_15 DSL_MAYBE_UNUSED = (x * ocean_waves_uniforms.dsl_param_scale3_3);
+    const float dsl_let_ny_16 DSL_MAYBE_UNUSED = (y * ocean_waves_uniforms.dsl_param_scale3_3);
+    const float dsl_let_n_17 DSL_MAYBE_UNUSED = dsl_noise2((dsl_let_nx_15 - ((time * ocean_waves_uniforms.dsl_param_speed_0) * 1.200000f)), (dsl_let_ny_16 + ((time * ocean_waves_uniforms.dsl_param_speed_0) * 0.700000f)));
     const float dsl_let_foam_18 DSL_MAYBE_UNUSED = powf(((dsl_let_n_17 * 0.500000f) + 0.500000f), 3.000000f);
     const float dsl_let_crest_19 DSL_MAYBE_UNUSED = dsl_smoothstep(0.300000f, 0.600000f, dsl_let_foam_18);
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = (0.700000f * dsl_let_crest_19), .g = (0.950000f * dsl_let_crest_19), .b = (1.000000f * dsl_let_crest_19), .a = (dsl_let_crest_19 * 0.700000f) }, __dsl_out);
+    {
+        const float __dsl_blend_a = (dsl_let_crest_19 * 0.700000f);
+        if (!(__dsl_blend_a <= 0.0f)) {
+            __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = (0.700000f * dsl_let_crest_19), .g = (0.950000f * dsl_let_crest_19), .b = (1.000000f * dsl_let_crest_19), .a = __dsl_blend_a }, __dsl_out);
+        }
+    }
     *out_color = __dsl_out;
 }
 
+/* Generated from effect: ocean_waves */
+static void ocean_waves_render_rows(float time, float frame, int width_px, int height_px, int row_first, int row_step, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    const float width DSL_MAYBE_UNUSED = (float)width_px;
+    const float height DSL_MAYBE_UNUSED = (float)height_px;
+    for (int py = row_first; py < height_px; py += row_step) {
+        const float y DSL_MAYBE_UNUSED = (float)py;
+        const float dsl_let_ny_5 DSL_MAYBE_UNUSED = (y * ocean_waves_uniforms.dsl_param_scale1_1);
+        const float dsl_let_ny_10 DSL_MAYBE_UNUSED = (y * ocean_waves_uniforms.dsl_param_scale2_2);
+        const float dsl_let_ny_16 DSL_MAYBE_UNUSED = (y * ocean_waves_uniforms.dsl_param_scale3_3);
+        for (int px = 0; px < width_px; px++) {
+            const float x DSL_MAYBE_UNUSED = (float)px;
+            dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
+            /* layer deep_water */
+            const float dsl_let_nx_4 DSL_MAYBE_UNUSED = (x * ocean_waves_uniforms.dsl_param_scale1_1);
+            const float dsl_let_n_6 DSL_MAYBE_UNUSED = dsl_noise2((dsl_let_nx_4 + ((time * ocean_waves_uniforms.dsl_param_speed_0) * 0.600000f)), (dsl_let_ny_5 + ((time * ocean_waves_uniforms.dsl_param_speed_0) * 0.300000f)));
+            const float dsl_let_val_7 DSL_MAYBE_UNUSED = ((dsl_let_n_6 * 0.500000f) + 0.500000f);
+            const float dsl_let_dark_8 DSL_MAYBE_UNUSED = (dsl_let_val_7 * 0.350000f);
+            __dsl_out = dsl_color_opaque((dsl_color_t){ .r = 0.000000f, .g = (dsl_let_dark_8 * 0.600000f), .b = dsl_let_dark_8, .a = 1.000000f });
+            /* layer mid_waves */
+            const float dsl_let_nx_9 DSL_MAYBE_UNUSED = (x * ocean_waves_uniforms.dsl_param_scale2_2);
+            const float dsl_let_n_11 DSL_MAYBE_UNUSED = dsl_noise2((dsl_let_nx_9 + (time * ocean_waves_uniforms.dsl_param_speed_0)), (dsl_let_ny_10 - ((time * ocean_waves_uniforms.dsl_param_speed_0) * 0.500000f)));
+            const float dsl_let_val_12 DSL_MAYBE_UNUSED = ((dsl_let_n_11 * 0.500000f) + 0.500000f);
+            const float dsl_let_bright_13 DSL_MAYBE_UNUSED = (powf(dsl_let_val_12, 1.500000f) * 0.550000f);
+            const float dsl_let_a_14 DSL_MAYBE_UNUSED = dsl_smoothstep(0.150000f, 0.500000f, dsl_let_bright_13);
+            {
+                const float __dsl_blend_a = dsl_let_a_14;
+                if (!(__dsl_blend_a <= 0.0f)) {
+                    __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = 0.050000f, .g = (dsl_let_bright_13 * 0.800000f), .b = dsl_let_bright_13, .a = __dsl_blend_a }, __dsl_out);
+                }
+            }
+            /* layer surface_foam */
+            const float dsl_let_nx_15 DSL_MAYBE_UNUSED = (x * ocean_waves_uniforms.dsl_param_scale3_3);
+            const float dsl_let_n_17 DSL_MAYBE_UNUSED = dsl_noise2((dsl_let_nx_15 - ((time * ocean_waves_uniforms.dsl_param_speed_0) * 1.200000f)), (dsl_let_ny_16 + ((time * ocean_waves_uniforms.dsl_param_speed_0) * 0.700000f)));
+            const float dsl_let_foam_18 DSL_MAYBE_UNUSED = powf(((dsl_let_n_17 * 0.500000f) + 0.500000f), 3.000000f);
+            const float dsl_let_crest_19 DSL_MAYBE_UNUSED = dsl_smoothstep(0.300000f, 0.600000f, dsl_let_foam_18);
+            {
+                const float __dsl_blend_a = (dsl_let_crest_19 * 0.700000f);
+                if (!(__dsl_blend_a <= 0.0f)) {
+                    __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = (0.700000f * dsl_let_crest_19), .g = (0.950000f * dsl_let_crest_19), .b = (1.000000f * dsl_let_crest_19), .a = __dsl_blend_a }, __dsl_out);
+                }
+            }
+            dsl_store_pixel(pixel_out + (uint32_t)phys_index[py * width_px + px] * 3U, __dsl_out, grb_gamma);
+        }
+    }
+}
+
+/* Generated from effect: ocean_waves */
+static void ocean_waves_render_frame(float time, float frame, int width_px, int height_px, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    ocean_waves_prepare_frame(time, frame, (float)width_px, (float)height_px, seed);
+    ocean_waves_render_rows(time, frame, width_px, height_px, 0, 1, seed, pixel_out, phys_index, grb_gamma);
+}
+
+static dsl_shader_param_t primal_storm_params[8] = {
+    { .name = "t1", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "t2", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "t3", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "storm", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "speed", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "epoch", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "scx", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "scy", .value = 0.0f, .pinned = 0, .settable = 1 },
+};
+
+typedef struct {
+    float dsl_param_t1_0;
+    float dsl_param_t2_1;
+    float dsl_param_t3_2;
+    float dsl_param_storm_3;
+    float dsl_param_speed_4;
+    float dsl_param_epoch_5;
+    float dsl_param_scx_6;
+    float dsl_param_scy_7;
+} primal_storm_uniforms_t;
+
+static primal_storm_uniforms_t primal_storm_uniforms;
+
+/* Generated from effect: primal_storm_v1 */
+static void primal_storm_prepare_frame(float time, float frame, float width, float height, float seed) {
+    const float dsl_param_t1_0 DSL_MAYBE_UNUSED = primal_storm_params[0].pinned ? primal_storm_params[0].value : ((time * 0.073200f) + (seed * 100.000000f));
+    const float dsl_param_t2_1 DSL_MAYBE_UNUSED = primal_storm_params[1].pinned ? primal_storm_params[1].value : ((time * 0.141400f) + (seed * 200.000000f));
+    const float dsl_param_t3_2 DSL_MAYBE_UNUSED = primal_storm_params[2].pinned ? primal_storm_params[2].value : ((time * 0.223600f) + (seed * 300.000000f));
+    const float dsl_param_storm_3 DSL_MAYBE_UNUSED = primal_storm_params[3].pinned ? primal_storm_params[3].value : dsl_clamp((((sinf(((time * 0.097000f) + (seed * 60.000000f))) + sinf(((time * 0.067000f) + (seed * 80.000000f)))) + sinf(((time * 0.041000f) + (seed * 40.000000f)))) - 1.400000f), 0.000000f, 1.000000f);
+    const float dsl_param_speed_4 DSL_MAYBE_UNUSED = primal_storm_params[4].pinned ? primal_storm_params[4].value : (0.500000f + (2.000000f * dsl_param_storm_3));
+    const float dsl_param_epoch_5 DSL_MAYBE_UNUSED = primal_storm_params[5].pinned ? primal_storm_params[5].value : dsl_fract((time * 0.005100f));
+    const float dsl_param_scx_6 DSL_MAYBE_UNUSED = primal_storm_params[6].pinned ? primal_storm_params[6].value : (6.28318530717958647692f / width);
+    const float dsl_param_scy_7 DSL_MAYBE_UNUSED = primal_storm_params[7].pinned ? primal_storm_params[7].value : (6.28318530717958647692f / height);
+    primal_storm_uniforms.dsl_param_t1_0 = dsl_param_t1_0;
+    primal_storm_uniforms.dsl_param_t2_1 = dsl_param_t2_1;
+    primal_storm_uniforms.dsl_param_t3_2 = dsl_param_t3_2;
+    primal_storm_uniforms.dsl_param_storm_3 = dsl_param_storm_3;
+    primal_storm_uniforms.dsl_param_speed_4 = dsl_param_speed_4;
+    primal_storm_uniforms.dsl_param_epoch_5 = dsl_param_epoch_5;
+    primal_storm_uniforms.dsl_param_scx_6 = dsl_param_scx_6;
+    primal_storm_uniforms.dsl_param_scy_7 = dsl_param_scy_7;
+}
+
 /* Generated from effect: primal_storm_v1 */
 static void primal_storm_eval_pixel(float time, float frame, float x, float y, float width, float height, float seed, dsl_color_t *out_color) {
-    const float dsl_param_t1_0 DSL_MAYBE_UNUSED = ((time * 0.073200f) + (seed * 100.000000f));
-    const float dsl_param_t2_1 DSL_MAYBE_UNUSED = ((time * 0.141400f) + (seed * 200.000000f));
-    const float dsl_param_t3_2 DSL_MAYBE_UNUSED = ((time * 0.223600f) + (seed * 300.000000f));
-    const float dsl_param_storm_3 DSL_MAYBE_UNUSED = dsl_clamp((((sinf(((time * 0.097000f) + (seed * 60.000000f))) + sinf(((time * 0.067000f) + (seed * 80.000000f)))) + sinf(((time * 0.041000f) + (seed * 40.000000f)))) - 1.400000f), 0.000000f, 1.000000f);
-    const float dsl_param_speed_4 DSL_MAYBE_UNUSED = (0.500000f + (2.000000f * dsl_param_storm_3));
-    const float dsl_param_epoch_5 DSL_MAYBE_UNUSED = dsl_fract((time * 0.005100f));
-    const float dsl_param_scx_6 DSL_MAYBE_UNUSED = (6.28318530717958647692f / width);
-    const float dsl_param_scy_7 DSL_MAYBE_UNUSED = (6.28318530717958647692f / height);
     dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
     /* layer glow */
-    const float dsl_let_cy_8 DSL_MAYBE_UNUSED = (height * (0.500000f + (0.100000f * sinf((dsl_param_t1_0 * 2.700000f)))));
+    const float dsl_let_cy_8 DSL_MAYBE_UNUSED = (height * (0.500000f + (0.100000f * sinf((primal_storm_uniforms.dsl_param_t1_0 * 2.700000f)))));
     const float dsl_let_dy_9 DSL_MAYBE_UNUSED = (fabsf((y - dsl_let_cy_8)) / height);
-    const float dsl_let_g_val_10 DSL_MAYBE_UNUSED = (dsl_smoothstep(0.450000f, 0.000000f, dsl_let_dy_9) * ((0.030000f + (0.180000f * (1.000000f - dsl_param_storm_3))) + (0.300000f * dsl_param_storm_3)));
-    const float dsl_let_h_11 DSL_MAYBE_UNUSED = dsl_fract(((dsl_param_epoch_5 + (dsl_let_dy_9 * 0.300000f)) + (0.100000f * sinf((dsl_param_t1_0 * 1.500000f)))));
+    const float dsl_let_g_val_10 DSL_MAYBE_UNUSED = (dsl_smoothstep(0.450000f, 0.000000f, dsl_let_dy_9) * ((0.030000f + (0.180000f * (1.000000f - primal_storm_uniforms.dsl_param_storm_3))) + (0.300000f * primal_storm_uniforms.dsl_param_storm_3)));
+    const float dsl_let_h_11 DSL_MAYBE_UNUSED = dsl_fract(((primal_storm_uniforms.dsl_param_epoch_5 + (dsl_let_dy_9 * 0.300000f)) + (0.100000f * sinf((primal_storm_uniforms.dsl_param_t1_0 * 1.500000f)))));
     const float dsl_let_r_12 DSL_MAYBE_UNUSED = (dsl_let_g_val_10 * (0.500000f + (0.500000f * sinf((dsl_let_h_11 * 6.28318530717958647692f)))));
     const float dsl_let_g_13 DSL_MAYBE_UNUSED = (dsl_let_g_val_10 * (0.500000f + (0.500000f * sinf(((dsl_let_h_11 * 6.28318530717958647692f) + (6.28318530717958647692f / 3.000000f))))));
     const float dsl_let_b_14 DSL_MAYBE_UNUSED = (dsl_let_g_val_10 * (0.500000f + (0.500000f * sinf(((dsl_let_h_11 * 6.28318530717958647692f) + ((6.28318530717958647692f * 2.000000f) / 3.000000f))))));
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = dsl_clamp(dsl_let_r_12, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_13, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_14, 0.000000f, 1.000000f), .a = 1.000000f }, __dsl_out);
+    __dsl_out = dsl_color_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_12, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_13, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_14, 0.000000f, 1.000000f), .a = 1.000000f });
     /* layer bands */
-    const float dsl_let_scroll_15 DSL_MAYBE_UNUSED = (((y * dsl_param_scy_7) * 4.000000f) + (time * dsl_param_speed_4));
-    const float dsl_let_wave_16 DSL_MAYBE_UNUSED = (sinf(dsl_let_scroll_15) * cosf((((dsl_let_scroll_15 * 0.700000f) + ((x * dsl_param_scx_6) * 2.000000f)) + (dsl_param_t2_1 * 3.000000f))));
-    const float dsl_let_mask_17 DSL_MAYBE_UNUSED = (dsl_smoothstep(0.200000f, 0.900000f, dsl_let_wave_16) * (0.040000f + (0.550000f * dsl_param_storm_3)));
-    const float dsl_let_mix_v_18 DSL_MAYBE_UNUSED = ((sinf(((dsl_param_t3_2 * 3.000000f) + (y * dsl_param_scy_7))) * 0.500000f) + 0.500000f);
+    const float dsl_let_scroll_15 DSL_MAYBE_UNUSED = (((y * primal_storm_uniforms.dsl_param_scy_7) * 4.000000f) + (time * primal_storm_uniforms.dsl_param_speed_4));
+    const float dsl_let_wave_16 DSL_MAYBE_UNUSED = (sinf(dsl_let_scroll_15) * cosf((((dsl_let_scroll_15 * 0.700000f) + ((x * primal_storm_uniforms.dsl_param_scx_6) * 2.000000f)) + (primal_storm_uniforms.dsl_param_t2_1 * 3.000000f))));
+    const float dsl_let_mask_17 DSL_MAYBE_UNUSED = (dsl_smoothstep(0.200000f, 0.900000f, dsl_let_wave_16) * (0.040000f + (0.550000f * primal_storm_uniforms.dsl_param_storm_3)));
+    const float dsl_let_mix_v_18 DSL_MAYBE_UNUSED = ((sinf(((primal_storm_uniforms.dsl_param_t3_2 * 3.000000f) + (y * primal_storm_uniforms.dsl_param_scy_7))) * 0.500000f) + 0.500000f);
     const float dsl_let_r_19 DSL_MAYBE_UNUSED = (dsl_let_mask_17 * (0.300000f + (0.600000f * dsl_let_mix_v_18)));
     const float dsl_let_g_20 DSL_MAYBE_UNUSED = (dsl_let_mask_17 * (0.600000f - (0.300000f * dsl_let_mix_v_18)));
     const float dsl_let_b_21 DSL_MAYBE_UNUSED = (dsl_let_mask_17 * 0.900000f);
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = dsl_clamp(dsl_let_r_19, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_20, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_21, 0.000000f, 1.000000f), .a = dsl_let_mask_17 }, __dsl_out);
+    {
+        const float __dsl_blend_a = dsl_let_mask_17;
+        if (!(__dsl_blend_a <= 0.0f)) {
+            __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_19, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_20, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_21, 0.000000f, 1.000000f), .a = __dsl_blend_a }, __dsl_out);
+        }
+    }
     /* layer lightning */
     const float dsl_let_col_22 DSL_MAYBE_UNUSED = floorf((x * 0.500000f));
     const float dsl_let_t_slice_23 DSL_MAYBE_UNUSED = floorf((time * 4.000000f));
     const float dsl_let_chance_24 DSL_MAYBE_UNUSED = dsl_hash01(((dsl_let_col_22 * 13.700000f) + (dsl_let_t_slice_23 * 71.300000f)));
-    const float dsl_let_strike_25 DSL_MAYBE_UNUSED = (dsl_smoothstep(0.930000f, 1.000000f, dsl_let_chance_24) * dsl_param_storm_3);
+    const float dsl_let_strike_25 DSL_MAYBE_UNUSED = (dsl_smoothstep(0.930000f, 1.000000f, dsl_let_chance_24) * primal_storm_uniforms.dsl_param_storm_3);
     const float dsl_let_bolt_y_26 DSL_MAYBE_UNUSED = (dsl_hash01(((dsl_let_col_22 * 29.100000f) + (dsl_let_t_slice_23 * 53.700000f))) * height);
     const float dsl_let_bolt_spread_27 DSL_MAYBE_UNUSED = dsl_smoothstep(0.350000f, 0.000000f, (fabsf((y - dsl_let_bolt_y_26)) / height));
     const float dsl_let_bolt_28 DSL_MAYBE_UNUSED = (dsl_let_strike_25 * dsl_let_bolt_spread_27);
     const float dsl_let_r_29 DSL_MAYBE_UNUSED = (dsl_let_bolt_28 * (0.700000f + (0.300000f * dsl_let_bolt_spread_27)));
     const float dsl_let_g_30 DSL_MAYBE_UNUSED = (dsl_let_bolt_28 * (0.800000f + (0.200000f * dsl_let_bolt_spread_27)));
     const float dsl_let_b_31 DSL_MAYBE_UNUSED = dsl_let_bolt_28;
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = dsl_clamp(dsl_let_r_29, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_30, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_31, 0.000000f, 1.000000f), .a = dsl_let_bolt_28 }, __dsl_out);
+    {
+        const float __dsl_blend_a = dsl_let_bolt_28;
+        if (!(__dsl_blend_a <= 0.0f)) {
+            __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_29, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_30, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_31, 0.000000f, 1.000000f), .a = __dsl_blend_a }, __dsl_out);
+        }
+    }
     /* layer embers */
     const float dsl_let_px_32 DSL_MAYBE_UNUSED = floorf((x * 0.250000f));
     const float dsl_let_stripe_seed_33 DSL_MAYBE_UNUSED = dsl_hash01((dsl_let_px_32 * 37.100000f));
@@ -795,82 +2125,337 @@ static void primal_storm_eval_pixel(float time, float frame, float x, float y, f
     const float dsl_let_py_35 DSL_MAYBE_UNUSED = dsl_fract(((dsl_let_stripe_seed_33 * 10.000000f) - ((time * dsl_let_rise_speed_34) * 0.050000f)));
     const float dsl_let_ember_y_36 DSL_MAYBE_UNUSED = (dsl_let_py_35 * height);
     const float dsl_let_dy_37 DSL_MAYBE_UNUSED = (fabsf((y - dsl_let_ember_y_36)) / height);
-    const float dsl_let_ember_38 DSL_MAYBE_UNUSED = ((dsl_smoothstep(0.060000f, 0.000000f, dsl_let_dy_37) * dsl_param_storm_3) * dsl_hash01(((dsl_let_px_32 * 53.000000f) + (floorf((time * 0.300000f)) * 17.000000f))));
+    const float dsl_let_ember_38 DSL_MAYBE_UNUSED = ((dsl_smoothstep(0.060000f, 0.000000f, dsl_let_dy_37) * primal_storm_uniforms.dsl_param_storm_3) * dsl_hash01(((dsl_let_px_32 * 53.000000f) + (floorf((time * 0.300000f)) * 17.000000f))));
     const float dsl_let_r_39 DSL_MAYBE_UNUSED = (dsl_let_ember_38 * 1.000000f);
     const float dsl_let_g_40 DSL_MAYBE_UNUSED = (dsl_let_ember_38 * (0.400000f + (0.300000f * dsl_let_stripe_seed_33)));
     const float dsl_let_b_41 DSL_MAYBE_UNUSED = (dsl_let_ember_38 * 0.100000f);
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = dsl_clamp(dsl_let_r_39, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_40, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_41, 0.000000f, 1.000000f), .a = dsl_let_ember_38 }, __dsl_out);
+    {
+        const float __dsl_blend_a = dsl_let_ember_38;
+        if (!(__dsl_blend_a <= 0.0f)) {
+            __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_39, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_40, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_41, 0.000000f, 1.000000f), .a = __dsl_blend_a }, __dsl_out);
+        }
+    }
     *out_color = __dsl_out;
 }
 
+/* Generated from effect: primal_storm_v1 */
+static void primal_storm_render_rows(float time, float frame, int width_px, int height_px, int row_first, int row_step, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    const float width DSL_MAYBE_UNUSED = (float)width_px;
+    const float height DSL_MAYBE_UNUSED = (float)height_px;
+    for (int py = row_first; py < height_px; py += row_step) {
+        const float y DSL_MAYBE_UNUSED = (float)py;
+        const float dsl_let_cy_8 DSL_MAYBE_UNUSED = (height * (0.500000f + (0.100000f * sinf((primal_storm_uniforms.dsl_param_t1_0 * 2.700000f)))));
+        const float dsl_let_dy_9 DSL_MAYBE_UNUSED = (fabsf((y - dsl_let_cy_8)) / height);
+        const float dsl_let_g_val_10 DSL_MAYBE_UNUSED = (dsl_smoothstep(0.450000f, 0.000000f, dsl_let_dy_9) * ((0.030000f + (0.180000f * (1.000000f - primal_storm_uniforms.dsl_param_storm_3))) + (0.300000f * primal_storm_uniforms.dsl_param_storm_3)));
+        const float dsl_let_h_11 DSL_MAYBE_UNUSED = dsl_fract(((primal_storm_uniforms.dsl_param_epoch_5 + (dsl_let_dy_9 * 0.300000f)) + (0.100000f * sinf((primal_storm_uniforms.dsl_param_t1_0 * 1.500000f)))));
+        const float dsl_let_r_12 DSL_MAYBE_UNUSED = (dsl_let_g_val_10 * (0.500000f + (0.500000f * sinf((dsl_let_h_11 * 6.28318530717958647692f)))));
+        const float dsl_let_g_13 DSL_MAYBE_UNUSED = (dsl_let_g_val_10 * (0.500000f + (0.500000f * sinf(((dsl_let_h_11 * 6.28318530717958647692f) + (6.28318530717958647692f / 3.000000f))))));
+        const float dsl_let_b_14 DSL_MAYBE_UNUSED = (dsl_let_g_val_10 * (0.500000f + (0.500000f * sinf(((dsl_let_h_11 * 6.28318530717958647692f) + ((6.28318530717958647692f * 2.000000f) / 3.000000f))))));
+        const float dsl_let_scroll_15 DSL_MAYBE_UNUSED = (((y * primal_storm_uniforms.dsl_param_scy_7) * 4.000000f) + (time * primal_storm_uniforms.dsl_param_speed_4));
+        const float dsl_let_mix_v_18 DSL_MAYBE_UNUSED = ((sinf(((primal_storm_uniforms.dsl_param_t3_2 * 3.000000f) + (y * primal_storm_uniforms.dsl_param_scy_7))) * 0.500000f) + 0.500000f);
+        const float dsl_let_t_slice_23 DSL_MAYBE_UNUSED = floorf((time * 4.000000f));
+        for (int px = 0; px < width_px; px++) {
+            const float x DSL_MAYBE_UNUSED = (float)px;
+            dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
+            /* layer glow */
+            __dsl_out = dsl_color_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_12, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_13, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_14, 0.000000f, 1.000000f), .a = 1.000000f });
+            /* layer bands */
+            const float dsl_let_wave_16 DSL_MAYBE_UNUSED = (sinf(dsl_let_scroll_15) * cosf((((dsl_let_scroll_15 * 0.700000f) + ((x * primal_storm_uniforms.dsl_param_scx_6) * 2.000000f)) + (primal_storm_uniforms.dsl_param_t2_1 * 3.000000f))));
+            const float dsl_let_mask_17 DSL_MAYBE_UNUSED = (dsl_smoothstep(0.200000f, 0.900000f, dsl_let_wave_16) * (0.040000f + (0.550000f * primal_storm_uniforms.dsl_param_storm_3)));
+            const float dsl_let_r_19 DSL_MAYBE_UNUSED = (dsl_let_mask_17 * (0.300000f + (0.600000f * dsl_let_mix_v_18)));
+            const float dsl_let_g_20 DSL_MAYBE_UNUSED = (dsl_let_mask_17 * (0.600000f - (0.300000f * dsl_let_mix_v_18)));
+            const float dsl_let_b_21 DSL_MAYBE_UNUSED = (dsl_let_mask_17 * 0.900000f);
+            {
+                const float __dsl_blend_a = dsl_let_mask_17;
+                if (!(__dsl_blend_a <= 0.0f)) {
+                    __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_19, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_20, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_21, 0.000000f, 1.000000f), .a = __dsl_blend_a }, __dsl_out);
+                }
+            }
+            /* layer lightning */
+            const float dsl_let_col_22 DSL_MAYBE_UNUSED = floorf((x * 0.500000f));
+            const float dsl_let_chance_24 DSL_MAYBE_UNUSED = dsl_hash01(((dsl_let_col_22 * 13.700000f) + (dsl_let_t_slice_23 * 71.300000f)));
+            const float dsl_let_strike_25 DSL_MAYBE_UNUSED = (dsl_smoothstep(0.930000f, 1.000000f, dsl_let_chance_24) * primal_storm_uniforms.dsl_param_storm_3);
+            const float dsl_let_bolt_y_26 DSL_MAYBE_UNUSED = (dsl_hash01(((dsl_let_col_22 * 29.100000f) + (dsl_let_t_slice_23 * 53.700000f))) * height);
+            const float dsl_let_bolt_spread_27 DSL_MAYBE_UNUSED = dsl_smoothstep(0.350000f, 0.000000f, (fabsf((y - dsl_let_bolt_y_26)) / height));
+            const float dsl_let_bolt_28 DSL_MAYBE_UNUSED = (dsl_let_strike_25 * dsl_let_bolt_spread_27);
+            const float dsl_let_r_29 DSL_MAYBE_UNUSED = (dsl_let_bolt_28 * (0.700000f + (0.300000f * dsl_let_bolt_spread_27)));
+            const float dsl_let_g_30 DSL_MAYBE_UNUSED = (dsl_let_bolt_28 * (0.800000f + (0.200000f * dsl_let_bolt_spread_27)));
+            const float dsl_let_b_31 DSL_MAYBE_UNUSED = dsl_let_bolt_28;
+            {
+                const float __dsl_blend_a = dsl_let_bolt_28;
+                if (!(__dsl_blend_a <= 0.0f)) {
+                    __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_29, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_30, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_31, 0.000000f, 1.000000f), .a = __dsl_blend_a }, __dsl_out);
+                }
+            }
+            /* layer embers */
+            const float dsl_let_px_32 DSL_MAYBE_UNUSED = floorf((x * 0.250000f));
+            const float dsl_let_stripe_seed_33 DSL_MAYBE_UNUSED = dsl_hash01((dsl_let_px_32 * 37.100000f));
+            const float dsl_let_rise_speed_34 DSL_MAYBE_UNUSED = (0.500000f + (dsl_let_stripe_seed_33 * 1.500000f));
+            const float dsl_let_py_35 DSL_MAYBE_UNUSED = dsl_fract(((dsl_let_stripe_seed_33 * 10.000000f) - ((time * dsl_let_rise_speed_34) * 0.050000f)));
+            const float dsl_let_ember_y_36 DSL_MAYBE_UNUSED = (dsl_let_py_35 * height);
+            const float dsl_let_dy_37 DSL_MAYBE_UNUSED = (fabsf((y - dsl_let_ember_y_36)) / height);
+            const float dsl_let_ember_38 DSL_MAYBE_UNUSED = ((dsl_smoothstep(0.060000f, 0.000000f, dsl_let_dy_37) * primal_storm_uniforms.dsl_param_storm_3) * dsl_hash01(((dsl_let_px_32 * 53.000000f) + (floorf((time * 0.300000f)) * 17.000000f))));
+            const float dsl_let_r_39 DSL_MAYBE_UNUSED = (dsl_let_ember_38 * 1.000000f);
+            const float dsl_let_g_40 DSL_MAYBE_UNUSED = (dsl_let_ember_38 * (0.400000f + (0.300000f * dsl_let_stripe_seed_33)));
+            const float dsl_let_b_41 DSL_MAYBE_UNUSED = (dsl_let_ember_38 * 0.100000f);
+            {
+                const float __dsl_blend_a = dsl_let_ember_38;
+                if (!(__dsl_blend_a <= 0.0f)) {
+                    __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_clamp(dsl_let_r_39, 0.000000f, 1.000000f), .g = dsl_clamp(dsl_let_g_40, 0.000000f, 1.000000f), .b = dsl_clamp(dsl_let_b_41, 0.000000f, 1.000000f), .a = __dsl_blend_a }, __dsl_out);
+                }
+            }
+            dsl_store_pixel(pixel_out + (uint32_t)phys_index[py * width_px + px] * 3U, __dsl_out, grb_gamma);
+        }
+    }
+}
+
+/* Generated from effect: primal_storm_v1 */
+static void primal_storm_render_frame(float time, float frame, int width_px, int height_px, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    primal_storm_prepare_frame(time, frame, (float)width_px, (float)height_px, seed);
+    primal_storm_render_rows(time, frame, width_px, height_px, 0, 1, seed, pixel_out, phys_index, grb_gamma);
+}
+
+static dsl_shader_param_t rain_matrix_params[2] = {
+    { .name = "fall_speed", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "trail_len", .value = 0.0f, .pinned = 0, .settable = 1 },
+};
+
+typedef struct {
+    float dsl_param_fall_speed_0;
+    float dsl_param_trail_len_1;
+} rain_matrix_uniforms_t;
+
+static rain_matrix_uniforms_t rain_matrix_uniforms;
+
+/* Generated from effect: rain_matrix */
+static void rain_matrix_prepare_frame(float time, float frame, float width, float height, float seed) {
+    const float dsl_param_fall_speed_0 DSL_MAYBE_UNUSED = rain_matrix_params[0].pinned ? rain_matrix_params[0].value : 6.000000f;
+    const float dsl_param_trail_len_1 DSL_MAYBE_UNUSED = rain_matrix_params[1].pinned ? rain_matrix_params[1].value : 8.000000f;
+    rain_matrix_uniforms.dsl_param_fall_speed_0 = dsl_param_fall_speed_0;
+    rain_matrix_uniforms.dsl_param_trail_len_1 = dsl_param_trail_len_1;
+}
+
 /* Generated from effect: rain_matrix */
 static void rain_matrix_eval_pixel(float time, float frame, float x, float y, float width, float height, float seed, dsl_color_t *out_color) {
-    const float dsl_param_fall_speed_0 DSL_MAYBE_UNUSED = 6.000000f;
-    const float dsl_param_trail_len_1 DSL_MAYBE_UNUSED = 8.000000f;
     dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
     /* layer dark_bg */
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = 0.000000f, .g = 0.020000f, .b = 0.000000f, .a = 1.000000f }, __dsl_out);
+    __dsl_out = dsl_color_opaque((dsl_color_t){ .r = 0.000000f, .g = 0.020000f, .b = 0.000000f, .a = 1.000000f });
     /* layer rain_drops */
-    for (int32_t dsl_iter_i_2 = 0; dsl_iter_i_2 < 6; dsl_iter_i_2++) {
-        const float dsl_index_i_3 DSL_MAYBE_UNUSED = (float)dsl_iter_i_2;
-        const float dsl_let_col_id_4 DSL_MAYBE_UNUSED = (floorf(x) + (dsl_index_i_3 * 7.000000f));
-        const float dsl_let_col_seed_5 DSL_MAYBE_UNUSED = dsl_hash01(((dsl_let_col_id_4 * 17.310000f) + (dsl_index_i_3 * 53.000000f)));
-        const float dsl_let_speed_6 DSL_MAYBE_UNUSED = (dsl_param_fall_speed_0 * (0.500000f + dsl_let_col_seed_5));
-        const float dsl_let_phase_7 DSL_MAYBE_UNUSED = dsl_hash01(((dsl_let_col_id_4 * 41.700000f) + (dsl_index_i_3 * 29.000000f)));
-        const float dsl_let_cycle_8 DSL_MAYBE_UNUSED = dsl_fract((((time * dsl_let_speed_6) / (height + dsl_param_trail_len_1)) + dsl_let_phase_7));
-        const float dsl_let_drop_y_9 DSL_MAYBE_UNUSED = ((dsl_let_cycle_8 * (height + dsl_param_trail_len_1)) - (dsl_param_trail_len_1 * 0.500000f));
-        const float dsl_let_dy_10 DSL_MAYBE_UNUSED = (dsl_let_drop_y_9 - y);
-        const float dsl_let_head_bright_11 DSL_MAYBE_UNUSED = dsl_smoothstep(1.500000f, 0.000000f, fabsf(dsl_let_dy_10));
-        const float dsl_let_trail_12 DSL_MAYBE_UNUSED = (dsl_smoothstep(dsl_param_trail_len_1, 0.000000f, dsl_let_dy_10) * dsl_smoothstep((-(1.000000f)), 0.500000f, dsl_let_dy_10));
-        const float dsl_let_char_cell_13 DSL_MAYBE_UNUSED = floorf(y);
-        const float dsl_let_char_hash_14 DSL_MAYBE_UNUSED = dsl_hash01((((dsl_let_char_cell_13 * 13.700000f) + (dsl_let_col_id_4 * 7.300000f)) + floorf((time * 4.000000f))));
-        const float dsl_let_char_flicker_15 DSL_MAYBE_UNUSED = (0.700000f + (0.300000f * dsl_let_char_hash_14));
-        const float dsl_let_brightness_16 DSL_MAYBE_UNUSED = (fmaxf(dsl_let_head_bright_11, (dsl_let_trail_12 * 0.400000f)) * dsl_let_char_flicker_15);
-        const float dsl_let_is_head_17 DSL_MAYBE_UNUSED = dsl_smoothstep(1.000000f, 0.000000f, fabsf(dsl_let_dy_10));
-        const float dsl_let_r_18 DSL_MAYBE_UNUSED = ((dsl_let_brightness_16 * dsl_let_is_head_17) * 0.700000f);
-        const float dsl_let_g_19 DSL_MAYBE_UNUSED = dsl_let_brightness_16;
-        const float dsl_let_b_20 DSL_MAYBE_UNUSED = ((dsl_let_brightness_16 * dsl_let_is_head_17) * 0.500000f);
-        __dsl_out = dsl_blend_over((dsl_color_t){ .r = dsl_let_r_18, .g = dsl_clamp(dsl_let_g_19, 0.000000f, 1.000000f), .b = dsl_let_b_20, .a = dsl_let_brightness_16 }, __dsl_out);
+    for (int32_t dsl_iter_i_4 = 0; dsl_iter_i_4 < 6; dsl_iter_i_4++) {
+        const float dsl_index_i_5 DSL_MAYBE_UNUSED = (float)dsl_iter_i_4;
+        const float dsl_let_col_id_6 DSL_MAYBE_UNUSED = (floorf(x) + (dsl_index_i_5 * 7.000000f));
+        const float dsl_let_col_seed_7 DSL_MAYBE_UNUSED = dsl_hash01(((dsl_let_col_id_6 * 17.310000f) + (dsl_index_i_5 * 53.000000f)));
+        const float dsl_let_speed_8 DSL_MAYBE_UNUSED = (rain_matrix_uniforms.dsl_param_fall_speed_0 * (0.500000f + dsl_let_col_seed_7));
+        const float dsl_let_phase_9 DSL_MAYBE_UNUSED = dsl_hash01(((dsl_let_col_id_6 * 41.700000f) + (dsl_index_i_5 * 29.000000f)));
+        const float dsl_let_cycle_10 DSL_MAYBE_UNUSED = dsl_fract((((time * dsl_let_speed_8) / (height + rain_matrix_uniforms.dsl_param_trail_len_1)) + dsl_let_phase_9));
+        const float dsl_let_drop_y_11 DSL_MAYBE_UNUSED = ((dsl_let_cycle_10 * (height + rain_matrix_uniforms.dsl_param_trail_len_1)) - (rain_matrix_uniforms.dsl_param_trail_len_1 * 0.500000f));
+        const float dsl_let_dy_12 DSL_MAYBE_UNUSED = (dsl_let_drop_y_11 - y);
+        const float dsl_let_head_bright_13 DSL_MAYBE_UNUSED = dsl_smoothstep(1.500000f, 0.000000f, fabsf(dsl_let_dy_12));
+        const float dsl_let_trail_14 DSL_MAYBE_UNUSED = (dsl_smoothstep(rain_matrix_uniforms.dsl_param_trail_len_1, 0.000000f, dsl_let_dy_12) * dsl_smoothstep((-(1.000000f)), 0.500000f, dsl_let_dy_12));
+        const float dsl_let_char_cell_15 DSL_MAYBE_UNUSED = floorf(y);
+        const float dsl_let_char_hash_16 DSL_MAYBE_UNUSED = dsl_hash01((((dsl_let_char_cell_15 * 13.700000f) + (dsl_let_col_id_6 * 7.300000f)) + floorf((time * 4.000000f))));
+        const float dsl_let_char_flicker_17 DSL_MAYBE_UNUSED = (0.700000f + (0.300000f * dsl_let_char_hash_16));
+        const float dsl_let_brightness_18 DSL_MAYBE_UNUSED = (fmaxf(dsl_let_head_bright_13, (dsl_let_trail_14 * 0.400000f)) * dsl_let_char_flicker_17);
+        const float dsl_let_is_head_19 DSL_MAYBE_UNUSED = dsl_smoothstep(1.000000f, 0.000000f, fabsf(dsl_let_dy_12));
+        const float dsl_let_r_20 DSL_MAYBE_UNUSED = ((dsl_let_brightness_18 * dsl_let_is_head_19) * 0.700000f);
+        const float dsl_let_g_21 DSL_MAYBE_UNUSED = dsl_let_brightness_18;
+        const float dsl_let_b_22 DSL_MAYBE_UNUSED = ((dsl_let_brightness_18 * dsl_let_is_head_19) * 0.500000f);
+        {
+            const float __dsl_blend_a = dsl_let_brightness_18;
+            if (!(__dsl_blend_a <= 0.0f)) {
+                __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_let_r_20, .g = dsl_clamp(dsl_let_g_21, 0.000000f, 1.000000f), .b = dsl_let_b_22, .a = __dsl_blend_a }, __dsl_out);
+            }
+        }
     }
     *out_color = __dsl_out;
 }
 
+/* Generated from effect: rain_matrix */
+static void rain_matrix_render_rows(float time, float frame, int width_px, int height_px, int row_first, int row_step, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    const float width DSL_MAYBE_UNUSED = (float)width_px;
+    const float height DSL_MAYBE_UNUSED = (float)height_px;
+    for (int py = row_first; py < height_px; py += row_step) {
+        const float y DSL_MAYBE_UNUSED = (float)py;
+        for (int px = 0; px < width_px; px++) {
+            const float x DSL_MAYBE_UNUSED = (float)px;
+            dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
+            /* layer dark_bg */
+            __dsl_out = dsl_color_opaque((dsl_color_t){ .r = 0.000000f, .g = 0.020000f, .b = 0.000000f, .a = 1.000000f });
+            /* layer rain_drops */
+            for (int32_t dsl_iter_i_4 = 0; dsl_iter_i_4 < 6; dsl_iter_i_4++) {
+                const float dsl_index_i_5 DSL_MAYBE_UNUSED = (float)dsl_iter_i_4;
+                const float dsl_let_col_id_6 DSL_MAYBE_UNUSED = (floorf(x) + (dsl_index_i_5 * 7.000000f));
+                const float dsl_let_col_seed_7 DSL_MAYBE_UNUSED = dsl_hash01(((dsl_let_col_id_6 * 17.310000f) + (dsl_index_i_5 * 53.000000f)));
+                const float dsl_let_speed_8 DSL_MAYBE_UNUSED = (rain_matrix_uniforms.dsl_param_fall_speed_0 * (0.500000f + dsl_let_col_seed_7));
+                const float dsl_let_phase_9 DSL_MAYBE_UNUSED = dsl_hash01(((dsl_let_col_id_6 * 41.700000f) + (dsl_index_i_5 * 29.000000f)));
+                const float dsl_let_cycle_10 DSL_MAYBE_UNUSED = dsl_fract((((time * dsl_let_speed_8) / (height + rain_matrix_uniforms.dsl_param_trail_len_1)) + dsl_let_phase_9));
+                const float dsl_let_drop_y_11 DSL_MAYBE_UNUSED = ((dsl_let_cycle_10 * (height + rain_matrix_uniforms.dsl_param_trail_len_1)) - (rain_matrix_uniforms.dsl_param_trail_len_1 * 0.500000f));
+                const float dsl_let_dy_12 DSL_MAYBE_UNUSED = (dsl_let_drop_y_11 - y);
+                const float dsl_let_head_bright_13 DSL_MAYBE_UNUSED = dsl_smoothstep(1.500000f, 0.000000f, fabsf(dsl_let_dy_12));
+                const float dsl_let_trail_14 DSL_MAYBE_UNUSED = (dsl_smoothstep(rain_matrix_uniforms.dsl_param_trail_len_1, 0.000000f, dsl_let_dy_12) * dsl_smoothstep((-(1.000000f)), 0.500000f, dsl_let_dy_12));
+                const float dsl_let_char_cell_15 DSL_MAYBE_UNUSED = floorf(y);
+                const float dsl_let_char_hash_16 DSL_MAYBE_UNUSED = dsl_hash01((((dsl_let_char_cell_15 * 13.700000f) + (dsl_let_col_id_6 * 7.300000f)) + floorf((time * 4.000000f))));
+                const float dsl_let_char_flicker_17 DSL_MAYBE_UNUSED = (0.700000f + (0.300000f * dsl_let_char_hash_16));
+                const float dsl_let_brightness_18 DSL_MAYBE_UNUSED = (fmaxf(dsl_let_head_bright_13, (dsl_let_trail_14 * 0.400000f)) * dsl_let_char_flicker_17);
+                const float dsl_let_is_head_19 DSL_MAYBE_UNUSED = dsl_smoothstep(1.000000f, 0.000000f, fabsf(dsl_let_dy_12));
+                const float dsl_let_r_20 DSL_MAYBE_UNUSED = ((dsl_let_brightness_18 * dsl_let_is_head_19) * 0.700000f);
+                const float dsl_let_g_21 DSL_MAYBE_UNUSED = dsl_let_brightness_18;
+                const float dsl_let_b_22 DSL_MAYBE_UNUSED = ((dsl_let_brightness_18 * dsl_let_is_head_19) * 0.500000f);
+                {
+                    const float __dsl_blend_a = dsl_let_brightness_18;
+                    if (!(__dsl_blend_a <= 0.0f)) {
+                        __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_let_r_20, .g = dsl_clamp(dsl_let_g_21, 0.000000f, 1.000000f), .b = dsl_let_b_22, .a = __dsl_blend_a }, __dsl_out);
+                    }
+                }
+            }
+            dsl_store_pixel(pixel_out + (uint32_t)phys_index[py * width_px + px] * 3U, __dsl_out, grb_gamma);
+        }
+    }
+}
+
+/* Generated from effect: rain_matrix */
+static void rain_matrix_render_frame(float time, float frame, int width_px, int height_px, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    rain_matrix_prepare_frame(time, frame, (float)width_px, (float)height_px, seed);
+    rain_matrix_render_rows(time, frame, width_px, height_px, 0, 1, seed, pixel_out, phys_index, grb_gamma);
+}
+
+static dsl_shader_param_t rain_ripple_params[4] = {
+    { .name = "lane_x", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "drop_y", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "ripple_y", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "ripple_r", .value = 0.0f, .pinned = 0, .settable = 1 },
+};
+
+typedef struct {
+    float dsl_param_lane_x_0;
+    float dsl_param_drop_y_1;
+    float dsl_param_ripple_y_2;
+    float dsl_param_ripple_r_3;
+} rain_ripple_uniforms_t;
+
+static rain_ripple_uniforms_t rain_ripple_uniforms;
+
+/* Generated from effect: rain_ripple_v1 */
+static void rain_ripple_prepare_frame(float time, float frame, float width, float height, float seed) {
+    const float dsl_param_lane_x_0 DSL_MAYBE_UNUSED = rain_ripple_params[0].pinned ? rain_ripple_params[0].value : 8.000000f;
+    const float dsl_param_drop_y_1 DSL_MAYBE_UNUSED = rain_ripple_params[1].pinned ? rain_ripple_params[1].value : ((height * 0.500000f) + (sinf((time * 1.700000f)) * (height * 0.450000f)));
+    const float dsl_param_ripple_y_2 DSL_MAYBE_UNUSED = rain_ripple_params[2].pinned ? rain_ripple_params[2].value : (height - 2.000000f);
+    const float dsl_param_ripple_r_3 DSL_MAYBE_UNUSED = rain_ripple_params[3].pinned ? rain_ripple_params[3].value : (1.200000f + ((sinf((time * 4.500000f)) + 1.000000f) * 3.500000f));
+    rain_ripple_uniforms.dsl_param_lane_x_0 = dsl_param_lane_x_0;
+    rain_ripple_uniforms.dsl_param_drop_y_1 = dsl_param_drop_y_1;
+    rain_ripple_uniforms.dsl_param_ripple_y_2 = dsl_param_ripple_y_2;
+    rain_ripple_uniforms.dsl_param_ripple_r_3 = dsl_param_ripple_r_3;
+}
+
 /* Generated from effect: rain_ripple_v1 */
 static void rain_ripple_eval_pixel(float time, float frame, float x, float y, float width, float height, float seed, dsl_color_t *out_color) {
-    const float dsl_param_lane_x_0 DSL_MAYBE_UNUSED = 8.000000f;
-    const float dsl_param_drop_y_1 DSL_MAYBE_UNUSED = ((height * 0.500000f) + (sinf((time * 1.700000f)) * (height * 0.450000f)));
-    const float dsl_param_ripple_y_2 DSL_MAYBE_UNUSED = (height - 2.000000f);
-    const float dsl_param_ripple_r_3 DSL_MAYBE_UNUSED = (1.200000f + ((sinf((time * 4.500000f)) + 1.000000f) * 3.500000f));
     dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
     /* layer drop */
     const float dsl_let_lane_jitter_4 DSL_MAYBE_UNUSED = (dsl_hash_signed((frame + 17.000000f)) * 0.450000f);
-    const float dsl_let_dx_5 DSL_MAYBE_UNUSED = dsl_wrapdx(x, (dsl_param_lane_x_0 + dsl_let_lane_jitter_4), width);
-    const float dsl_let_streak_6 DSL_MAYBE_UNUSED = dsl_box((dsl_vec2_t){ .x = dsl_let_dx_5, .y = (y - (dsl_param_drop_y_1 - 1.200000f)) }, (dsl_vec2_t){ .x = 0.180000f, .y = 1.200000f });
-    const float dsl_let_head_7 DSL_MAYBE_UNUSED = dsl_circle((dsl_vec2_t){ .x = dsl_let_dx_5, .y = (y - dsl_param_drop_y_1) }, 0.400000f);
-    const float dsl_let_a_8 DSL_MAYBE_UNUSED = (((1.000000f - dsl_smoothstep(0.000000f, 0.750000f, dsl_let_streak_6)) * 0.360000f) + ((1.000000f - dsl_smoothstep(0.000000f, 0.550000f, dsl_let_head_7)) * 0.480000f));
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = 0.700000f, .g = 0.840000f, .b = 1.000000f, .a = fminf(dsl_let_a_8, 0.900000f) }, __dsl_out);
+    const float dsl_let_dx_5 DSL_MAYBE_UNUSED = dsl_wrapdx(x, (rain_ripple_uniforms.dsl_param_lane_x_0 + dsl_let_lane_jitter_4), width);
+    if (DSL_NEAR_BOX(dsl_let_dx_5, (y - (rain_ripple_uniforms.dsl_param_drop_y_1 - 1.200000f)), (0.180000f + 0.750000f), (1.200000f + 0.750000f)) || DSL_NEAR_BOX(dsl_let_dx_5, (y - rain_ripple_uniforms.dsl_param_drop_y_1), (0.400000f + 0.550000f), (0.400000f + 0.550000f))) {
+        const float dsl_let_streak_6 DSL_MAYBE_UNUSED = dsl_box((dsl_vec2_t){ .x = dsl_let_dx_5, .y = (y - (rain_ripple_uniforms.dsl_param_drop_y_1 - 1.200000f)) }, (dsl_vec2_t){ .x = 0.180000f, .y = 1.200000f });
+        const float dsl_let_head_7 DSL_MAYBE_UNUSED = dsl_circle((dsl_vec2_t){ .x = dsl_let_dx_5, .y = (y - rain_ripple_uniforms.dsl_param_drop_y_1) }, 0.400000f);
+        const float dsl_let_a_8 DSL_MAYBE_UNUSED = (((1.000000f - dsl_smoothstep(0.000000f, 0.750000f, dsl_let_streak_6)) * 0.360000f) + ((1.000000f - dsl_smoothstep(0.000000f, 0.550000f, dsl_let_head_7)) * 0.480000f));
+        {
+            const float __dsl_blend_a = fminf(dsl_let_a_8, 0.900000f);
+            if (!(__dsl_blend_a <= 0.0f)) {
+                __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = 0.700000f, .g = 0.840000f, .b = 1.000000f, .a = __dsl_blend_a }, __dsl_out);
+            }
+        }
+    }
     /* layer ripple */
-    const dsl_vec2_t dsl_let_local_9 DSL_MAYBE_UNUSED = (dsl_vec2_t){ .x = dsl_wrapdx(x, dsl_param_lane_x_0, width), .y = (y - dsl_param_ripple_y_2) };
-    const float dsl_let_ring_10 DSL_MAYBE_UNUSED = (fabsf(dsl_circle(dsl_let_local_9, dsl_param_ripple_r_3)) - 0.200000f);
-    const float dsl_let_a_11 DSL_MAYBE_UNUSED = ((1.000000f - dsl_smoothstep(0.000000f, 0.800000f, dsl_let_ring_10)) * 0.600000f);
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = 0.350000f, .g = 0.780000f, .b = 1.000000f, .a = dsl_let_a_11 }, __dsl_out);
+    if (DSL_NEAR_BOX(dsl_wrapdx(x, rain_ripple_uniforms.dsl_param_lane_x_0, width), (y - rain_ripple_uniforms.dsl_param_ripple_y_2), (rain_ripple_uniforms.dsl_param_ripple_r_3 + (0.800000f + 0.200000f)), (rain_ripple_uniforms.dsl_param_ripple_r_3 + (0.800000f + 0.200000f)))) {
+        const dsl_vec2_t dsl_let_local_9 DSL_MAYBE_UNUSED = (dsl_vec2_t){ .x = dsl_wrapdx(x, rain_ripple_uniforms.dsl_param_lane_x_0, width), .y = (y - rain_ripple_uniforms.dsl_param_ripple_y_2) };
+        const float dsl_let_ring_10 DSL_MAYBE_UNUSED = (fabsf(dsl_circle(dsl_let_local_9, rain_ripple_uniforms.dsl_param_ripple_r_3)) - 0.200000f);
+        const float dsl_let_a_11 DSL_MAYBE_UNUSED = ((1.000000f - dsl_smoothstep(0.000000f, 0.800000f, dsl_let_ring_10)) * 0.600000f);
+        {
+            const float __dsl_blend_a = dsl_let_a_11;
+            if (!(__dsl_blend_a <= 0.0f)) {
+                __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = 0.350000f, .g = 0.780000f, .b = 1.000000f, .a = __dsl_blend_a }, __dsl_out);
+            }
+        }
+    }
     *out_color = __dsl_out;
 }
 
-/* Generated from effect: soap_bubbles_v1 */
-static void soap_bubbles_eval_frame(float time, float frame) {
-    const float dsl_let_two_pi_0 DSL_MAYBE_UNUSED = (3.14159265358979323846f * 2.000000f);
-    const float dsl_let_depth_time_1 DSL_MAYBE_UNUSED = (time * 0.750000f);
-    const float dsl_let_tint_time_2 DSL_MAYBE_UNUSED = (time * 0.800000f);
+/* Generated from effect: rain_ripple_v1 */
+static void rain_ripple_render_rows(float time, float frame, int width_px, int height_px, int row_first, int row_step, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    const float width DSL_MAYBE_UNUSED = (float)width_px;
+    const float height DSL_MAYBE_UNUSED = (float)height_px;
+    for (int py = row_first; py < height_px; py += row_step) {
+        const float y DSL_MAYBE_UNUSED = (float)py;
+        const float dsl_let_lane_jitter_4 DSL_MAYBE_UNUSED = (dsl_hash_signed((frame + 17.000000f)) * 0.450000f);
+        for (int px = 0; px < width_px; px++) {
+            const float x DSL_MAYBE_UNUSED = (float)px;
+            dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
+            /* layer drop */
+            const float dsl_let_dx_5 DSL_MAYBE_UNUSED = dsl_wrapdx(x, (rain_ripple_uniforms.dsl_param_lane_x_0 + dsl_let_lane_jitter_4), width);
+            if (DSL_NEAR_BOX(dsl_let_dx_5, (y - (rain_ripple_uniforms.dsl_param_drop_y_1 - 1.200000f)), (0.180000f + 0.750000f), (1.200000f + 0.750000f)) || DSL_NEAR_BOX(dsl_let_dx_5, (y - rain_ripple_uniforms.dsl_param_drop_y_1), (0.400000f + 0.550000f), (0.400000f + 0.550000f))) {
+                const float dsl_let_streak_6 DSL_MAYBE_UNUSED = dsl_box((dsl_vec2_t){ .x = dsl_let_dx_5, .y = (y - (rain_ripple_uniforms.dsl_param_drop_y_1 - 1.200000f)) }, (dsl_vec2_t){ .x = 0.180000f, .y = 1.200000f });
+                const float dsl_let_head_7 DSL_MAYBE_UNUSED = dsl_circle((dsl_vec2_t){ .x = dsl_let_dx_5, .y = (y - rain_ripple_uniforms.dsl_param_drop_y_1) }, 0.400000f);
+                const float dsl_let_a_8 DSL_MAYBE_UNUSED = (((1.000000f - dsl_smoothstep(0.000000f, 0.750000f, dsl_let_streak_6)) * 0.360000f) + ((1.000000f - dsl_smoothstep(0.000000f, 0.550000f, dsl_let_head_7)) * 0.480000f));
+                {
+                    const float __dsl_blend_a = fminf(dsl_let_a_8, 0.900000f);
+                    if (!(__dsl_blend_a <= 0.0f)) {
+                        __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = 0.700000f, .g = 0.840000f, .b = 1.000000f, .a = __dsl_blend_a }, __dsl_out);
+                    }
+                }
+            }
+            /* layer ripple */
+            if (DSL_NEAR_BOX(dsl_wrapdx(x, rain_ripple_uniforms.dsl_param_lane_x_0, width), (y - rain_ripple_uniforms.dsl_param_ripple_y_2), (rain_ripple_uniforms.dsl_param_ripple_r_3 + (0.800000f + 0.200000f)), (rain_ripple_uniforms.dsl_param_ripple_r_3 + (0.800000f + 0.200000f)))) {
+                const dsl_vec2_t dsl_let_local_9 DSL_MAYBE_UNUSED = (dsl_vec2_t){ .x = dsl_wrapdx(x, rain_ripple_uniforms.dsl_param_lane_x_0, width), .y = (y - rain_ripple_uniforms.dsl_param_ripple_y_2) };
+                const float dsl_let_ring_10 DSL_MAYBE_UNUSED = (fabsf(dsl_circle(dsl_let_local_9, rain_ripple_uniforms.dsl_param_ripple_r_3)) - 0.200000f);
+                const float dsl_let_a_11 DSL_MAYBE_UNUSED = ((1.000000f - dsl_smoothstep(0.000000f, 0.800000f, dsl_let_ring_10)) * 0.600000f);
+                {
+                    const float __dsl_blend_a = dsl_let_a_11;
+                    if (!(__dsl_blend_a <= 0.0f)) {
+                        __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = 0.350000f, .g = 0.780000f, .b = 1.000000f, .a = __dsl_blend_a }, __dsl_out);
+                    }
+                }
+            }
+            dsl_store_pixel(pixel_out + (uint32_t)phys_index[py * width_px + px] * 3U, __dsl_out, grb_gamma);
+        }
+    }
 }
 
+/* Generated from effect: rain_ripple_v1 */
+static void rain_ripple_render_frame(float time, float frame, int width_px, int height_px, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    rain_ripple_prepare_frame(time, frame, (float)width_px, (float)height_px, seed);
+    rain_ripple_render_rows(time, frame, width_px, height_px, 0, 1, seed, pixel_out, phys_index, grb_gamma);
+}
+
+typedef struct {
+    float dsl_let_two_pi_0;
+    float dsl_let_depth_time_1;
+    float dsl_let_tint_time_2;
+    float dsl_let_phase01_6[14];
+    float dsl_let_phase_7[14];
+    float dsl_let_depth_phase_8[14];
+    float dsl_let_lane_x_9[14];
+    float dsl_let_radius_10[14];
+    float dsl_let_rise_speed_11[14];
+    float dsl_let_wobble_amp_12[14];
+    float dsl_let_wobble_freq_13[14];
+    float dsl_let_travel_14[14];
+    float dsl_let_cycle_15[14];
+    float dsl_let_center_x_16[14];
+    float dsl_let_center_y_17[14];
+    float dsl_let_pop_t_18[14];
+    float dsl_let_pop_gate_19[14];
+    float dsl_let_body_radius_20[14];
+    float dsl_let_depth_21[14];
+    float dsl_let_front_factor_22[14];
+    float dsl_let_depth_alpha_23[14];
+} soap_bubbles_uniforms_t;
+
+static soap_bubbles_uniforms_t soap_bubbles_uniforms;
+
 /* Generated from effect: soap_bubbles_v1 */
-static void soap_bubbles_eval_pixel(float time, float frame, float x, float y, float width, float height, float seed, dsl_color_t *out_color) {
+static void soap_bubbles_prepare_frame(float time, float frame, float width, float height, float seed) {
     const float dsl_let_two_pi_0 DSL_MAYBE_UNUSED = (3.14159265358979323846f * 2.000000f);
     const float dsl_let_depth_time_1 DSL_MAYBE_UNUSED = (time * 0.750000f);
     const float dsl_let_tint_time_2 DSL_MAYBE_UNUSED = (time * 0.800000f);
-    dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
-    /* layer bubbles */
     for (int32_t dsl_iter_i_3 = 0; dsl_iter_i_3 < 14; dsl_iter_i_3++) {
         const float dsl_index_i_4 DSL_MAYBE_UNUSED = (float)dsl_iter_i_3;
         const float dsl_let_id_5 DSL_MAYBE_UNUSED = dsl_index_i_4;
@@ -886,48 +2471,205 @@ static void soap_bubbles_eval_pixel(float time, float frame, float x, float y, f
         const float dsl_let_cycle_15 DSL_MAYBE_UNUSED = dsl_fract(((time * (dsl_let_rise_speed_11 / dsl_let_travel_14)) + dsl_let_phase01_6));
         const float dsl_let_center_x_16 DSL_MAYBE_UNUSED = (dsl_let_lane_x_9 + (sinf(((time * dsl_let_wobble_freq_13) + dsl_let_phase_7)) * dsl_let_wobble_amp_12));
         const float dsl_let_center_y_17 DSL_MAYBE_UNUSED = ((height + dsl_let_radius_10) - (dsl_let_cycle_15 * dsl_let_travel_14));
-        const dsl_vec2_t dsl_let_local_18 DSL_MAYBE_UNUSED = (dsl_vec2_t){ .x = dsl_wrapdx(x, dsl_let_center_x_16, width), .y = (y - dsl_let_center_y_17) };
-        const float dsl_let_pop_t_19 DSL_MAYBE_UNUSED = dsl_clamp(((dsl_let_cycle_15 - 0.900000f) / 0.100000f), 0.000000f, 1.000000f);
-        const float dsl_let_pop_gate_20 DSL_MAYBE_UNUSED = (dsl_smoothstep(0.000000f, 0.150000f, dsl_let_pop_t_19) * (1.000000f - dsl_smoothstep(0.750000f, 1.000000f, dsl_let_pop_t_19)));
-        const float dsl_let_body_radius_21 DSL_MAYBE_UNUSED = (dsl_let_radius_10 * (1.000000f - (0.550000f * dsl_let_pop_t_19)));
-        const float dsl_let_d_22 DSL_MAYBE_UNUSED = dsl_circle(dsl_let_local_18, dsl_let_body_radius_21);
-        const float dsl_let_shell_alpha_23 DSL_MAYBE_UNUSED = (1.000000f - dsl_smoothstep(0.050000f, 0.850000f, fabsf(dsl_let_d_22)));
-        const float dsl_let_core_alpha_24 DSL_MAYBE_UNUSED = ((1.000000f - dsl_smoothstep((-(dsl_let_body_radius_21)), 0.000000f, dsl_let_d_22)) * 0.120000f);
-        const float dsl_let_hi_d_25 DSL_MAYBE_UNUSED = dsl_circle((dsl_vec2_t){ .x = (dsl_wrapdx(x, dsl_let_center_x_16, width) + (dsl_let_body_radius_21 * 0.400000f)), .y = ((y - dsl_let_center_y_17) - (dsl_let_body_radius_21 * 0.340000f)) }, (dsl_let_body_radius_21 * 0.230000f));
-        const float dsl_let_hi_alpha_26 DSL_MAYBE_UNUSED = ((1.000000f - dsl_smoothstep(0.000000f, 0.550000f, dsl_let_hi_d_25)) * 0.260000f);
-        const float dsl_let_depth_27 DSL_MAYBE_UNUSED = sinf((dsl_let_depth_time_1 + dsl_let_depth_phase_8));
-        const float dsl_let_front_factor_28 DSL_MAYBE_UNUSED = dsl_smoothstep(0.000000f, 0.350000f, dsl_let_depth_27);
-        const float dsl_let_depth_alpha_29 DSL_MAYBE_UNUSED = (0.620000f + (0.380000f * dsl_let_front_factor_28));
-        const float dsl_let_body_alpha_30 DSL_MAYBE_UNUSED = fminf((((((dsl_let_shell_alpha_23 * 0.460000f) + dsl_let_core_alpha_24) + dsl_let_hi_alpha_26) * (1.000000f - (0.920000f * dsl_let_pop_t_19))) * dsl_let_depth_alpha_29), 0.860000f);
-        if (dsl_let_body_alpha_30 > 0.0f) {
-            const float dsl_let_tint_31 DSL_MAYBE_UNUSED = (0.500000f + (0.500000f * sinf((dsl_let_tint_time_2 + dsl_let_phase_7))));
-            __dsl_out = dsl_blend_over((dsl_color_t){ .r = fminf((0.660000f + (0.200000f * dsl_let_tint_31)), 1.000000f), .g = fminf((0.820000f + (0.120000f * dsl_let_tint_31)), 1.000000f), .b = 1.000000f, .a = dsl_let_body_alpha_30 }, __dsl_out);
-        } else {
-        }
-        if (dsl_let_pop_gate_20 > 0.0f) {
-            const float dsl_let_ring_radius_32 DSL_MAYBE_UNUSED = (dsl_let_body_radius_21 + ((dsl_let_radius_10 + 0.800000f) * dsl_let_pop_t_19));
-            const float dsl_let_ring_width_33 DSL_MAYBE_UNUSED = (0.120000f + ((1.000000f - dsl_let_pop_t_19) * 0.180000f));
-            const float dsl_let_ring_d_34 DSL_MAYBE_UNUSED = (fabsf(dsl_circle(dsl_let_local_18, dsl_let_ring_radius_32)) - dsl_let_ring_width_33);
-            const float dsl_let_ring_alpha_35 DSL_MAYBE_UNUSED = ((((1.000000f - dsl_smoothstep(0.000000f, 0.650000f, dsl_let_ring_d_34)) * dsl_let_pop_gate_20) * 0.900000f) * dsl_let_depth_alpha_29);
-            __dsl_out = dsl_blend_over((dsl_color_t){ .r = 0.580000f, .g = 0.880000f, .b = 1.000000f, .a = dsl_let_ring_alpha_35 }, __dsl_out);
-        } else {
+        const float dsl_let_pop_t_18 DSL_MAYBE_UNUSED = dsl_clamp(((dsl_let_cycle_15 - 0.900000f) / 0.100000f), 0.000000f, 1.000000f);
+        const float dsl_let_pop_gate_19 DSL_MAYBE_UNUSED = (dsl_smoothstep(0.000000f, 0.150000f, dsl_let_pop_t_18) * (1.000000f - dsl_smoothstep(0.750000f, 1.000000f, dsl_let_pop_t_18)));
+        const float dsl_let_body_radius_20 DSL_MAYBE_UNUSED = (dsl_let_radius_10 * (1.000000f - (0.550000f * dsl_let_pop_t_18)));
+        const float dsl_let_depth_21 DSL_MAYBE_UNUSED = sinf((dsl_let_depth_time_1 + dsl_let_depth_phase_8));
+        const float dsl_let_front_factor_22 DSL_MAYBE_UNUSED = dsl_smoothstep(0.000000f, 0.350000f, dsl_let_depth_21);
+        const float dsl_let_depth_alpha_23 DSL_MAYBE_UNUSED = (0.620000f + (0.380000f * dsl_let_front_factor_22));
+        soap_bubbles_uniforms.dsl_let_phase01_6[dsl_iter_i_3] = dsl_let_phase01_6;
+        soap_bubbles_uniforms.dsl_let_phase_7[dsl_iter_i_3] = dsl_let_phase_7;
+        soap_bubbles_uniforms.dsl_let_depth_phase_8[dsl_iter_i_3] = dsl_let_depth_phase_8;
+        soap_bubbles_uniforms.dsl_let_lane_x_9[dsl_iter_i_3] = dsl_let_lane_x_9;
+        soap_bubbles_uniforms.dsl_let_radius_10[dsl_iter_i_3] = dsl_let_radius_10;
+        soap_bubbles_uniforms.dsl_let_rise_speed_11[dsl_iter_i_3] = dsl_let_rise_speed_11;
+        soap_bubbles_uniforms.dsl_let_wobble_amp_12[dsl_iter_i_3] = dsl_let_wobble_amp_12;
+        soap_bubbles_uniforms.dsl_let_wobble_freq_13[dsl_iter_i_3] = dsl_let_wobble_freq_13;
+        soap_bubbles_uniforms.dsl_let_travel_14[dsl_iter_i_3] = dsl_let_travel_14;
+        soap_bubbles_uniforms.dsl_let_cycle_15[dsl_iter_i_3] = dsl_let_cycle_15;
+        soap_bubbles_uniforms.dsl_let_center_x_16[dsl_iter_i_3] = dsl_let_center_x_16;
+        soap_bubbles_uniforms.dsl_let_center_y_17[dsl_iter_i_3] = dsl_let_center_y_17;
+        soap_bubbles_uniforms.dsl_let_pop_t_18[dsl_iter_i_3] = dsl_let_pop_t_18;
+        soap_bubbles_uniforms.dsl_let_pop_gate_19[dsl_iter_i_3] = dsl_let_pop_gate_19;
+        soap_bubbles_uniforms.dsl_let_body_radius_20[dsl_iter_i_3] = dsl_let_body_radius_20;
+        soap_bubbles_uniforms.dsl_let_depth_21[dsl_iter_i_3] = dsl_let_depth_21;
+        soap_bubbles_uniforms.dsl_let_front_factor_22[dsl_iter_i_3] = dsl_let_front_factor_22;
+        soap_bubbles_uniforms.dsl_let_depth_alpha_23[dsl_iter_i_3] = dsl_let_depth_alpha_23;
+    }
+    soap_bubbles_uniforms.dsl_let_two_pi_0 = dsl_let_two_pi_0;
+    soap_bubbles_uniforms.dsl_let_depth_time_1 = dsl_let_depth_time_1;
+    soap_bubbles_uniforms.dsl_let_tint_time_2 = dsl_let_tint_time_2;
+}
+
+/* Generated from effect: soap_bubbles_v1 */
+static void soap_bubbles_eval_pixel(float time, float frame, float x, float y, float width, float height, float seed, dsl_color_t *out_color) {
+    dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
+    /* layer bubbles */
+    for (int32_t dsl_iter_i_24 = 0; dsl_iter_i_24 < 14; dsl_iter_i_24++) {
+        const float dsl_index_i_25 DSL_MAYBE_UNUSED = (float)dsl_iter_i_24;
+        const float dsl_let_id_26 DSL_MAYBE_UNUSED = dsl_index_i_25;
+        const float dsl_let_phase01_27 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_phase01_6[dsl_iter_i_24];
+        const float dsl_let_phase_28 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_phase_7[dsl_iter_i_24];
+        const float dsl_let_depth_phase_29 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_depth_phase_8[dsl_iter_i_24];
+        const float dsl_let_lane_x_30 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_lane_x_9[dsl_iter_i_24];
+        const float dsl_let_radius_31 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_radius_10[dsl_iter_i_24];
+        const float dsl_let_rise_speed_32 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_rise_speed_11[dsl_iter_i_24];
+        const float dsl_let_wobble_amp_33 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_wobble_amp_12[dsl_iter_i_24];
+        const float dsl_let_wobble_freq_34 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_wobble_freq_13[dsl_iter_i_24];
+        const float dsl_let_travel_35 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_travel_14[dsl_iter_i_24];
+        const float dsl_let_cycle_36 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_cycle_15[dsl_iter_i_24];
+        const float dsl_let_center_x_37 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_center_x_16[dsl_iter_i_24];
+        const float dsl_let_center_y_38 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_center_y_17[dsl_iter_i_24];
+        const dsl_vec2_t dsl_let_local_39 DSL_MAYBE_UNUSED = (dsl_vec2_t){ .x = dsl_wrapdx(x, dsl_let_center_x_37, width), .y = (y - dsl_let_center_y_38) };
+        const float dsl_let_pop_t_40 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_pop_t_18[dsl_iter_i_24];
+        const float dsl_let_pop_gate_41 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_pop_gate_19[dsl_iter_i_24];
+        const float dsl_let_body_radius_42 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_body_radius_20[dsl_iter_i_24];
+        if (!((-(dsl_let_body_radius_42)) <= 0.000000f) || DSL_NEAR_BOX(dsl_wrapdx(x, dsl_let_center_x_37, width), (y - dsl_let_center_y_38), dsl_reach_max(dsl_reach_max((dsl_let_body_radius_42 + 0.850000f), (dsl_let_body_radius_42 + 0.000000f)), ((dsl_let_body_radius_42 + ((dsl_let_radius_31 + 0.800000f) * dsl_let_pop_t_40)) + (0.650000f + (0.120000f + ((1.000000f - dsl_let_pop_t_40) * 0.180000f))))), dsl_reach_max(dsl_reach_max((dsl_let_body_radius_42 + 0.850000f), (dsl_let_body_radius_42 + 0.000000f)), ((dsl_let_body_radius_42 + ((dsl_let_radius_31 + 0.800000f) * dsl_let_pop_t_40)) + (0.650000f + (0.120000f + ((1.000000f - dsl_let_pop_t_40) * 0.180000f)))))) || DSL_NEAR_BOX((dsl_wrapdx(x, dsl_let_center_x_37, width) + (dsl_let_body_radius_42 * 0.400000f)), ((y - dsl_let_center_y_38) - (dsl_let_body_radius_42 * 0.340000f)), ((dsl_let_body_radius_42 * 0.230000f) + 0.550000f), ((dsl_let_body_radius_42 * 0.230000f) + 0.550000f))) {
+            const float dsl_let_d_43 DSL_MAYBE_UNUSED = dsl_circle(dsl_let_local_39, dsl_let_body_radius_42);
+            const float dsl_let_shell_alpha_44 DSL_MAYBE_UNUSED = (1.000000f - dsl_smoothstep(0.050000f, 0.850000f, fabsf(dsl_let_d_43)));
+            const float dsl_let_core_alpha_45 DSL_MAYBE_UNUSED = ((1.000000f - dsl_smoothstep((-(dsl_let_body_radius_42)), 0.000000f, dsl_let_d_43)) * 0.120000f);
+            const float dsl_let_hi_d_46 DSL_MAYBE_UNUSED = dsl_circle((dsl_vec2_t){ .x = (dsl_wrapdx(x, dsl_let_center_x_37, width) + (dsl_let_body_radius_42 * 0.400000f)), .y = ((y - dsl_let_center_y_38) - (dsl_let_body_radius_42 * 0.340000f)) }, (dsl_let_body_radius_42 * 0.230000f));
+            const float dsl_let_hi_alpha_47 DSL_MAYBE_UNUSED = ((1.000000f - dsl_smoothstep(0.000000f, 0.550000f, dsl_let_hi_d_46)) * 0.260000f);
+            const float dsl_let_depth_48 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_depth_21[dsl_iter_i_24];
+            const float dsl_let_front_factor_49 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_front_factor_22[dsl_iter_i_24];
+            const float dsl_let_depth_alpha_50 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_depth_alpha_23[dsl_iter_i_24];
+            const float dsl_let_body_alpha_51 DSL_MAYBE_UNUSED = fminf((((((dsl_let_shell_alpha_44 * 0.460000f) + dsl_let_core_alpha_45) + dsl_let_hi_alpha_47) * (1.000000f - (0.920000f * dsl_let_pop_t_40))) * dsl_let_depth_alpha_50), 0.860000f);
+            if (dsl_let_body_alpha_51 > 0.0f) {
+                const float dsl_let_tint_52 DSL_MAYBE_UNUSED = (0.500000f + (0.500000f * sinf((soap_bubbles_uniforms.dsl_let_tint_time_2 + dsl_let_phase_28))));
+                {
+                    const float __dsl_blend_a = dsl_let_body_alpha_51;
+                    if (!(__dsl_blend_a <= 0.0f)) {
+                        __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = fminf((0.660000f + (0.200000f * dsl_let_tint_52)), 1.000000f), .g = fminf((0.820000f + (0.120000f * dsl_let_tint_52)), 1.000000f), .b = 1.000000f, .a = __dsl_blend_a }, __dsl_out);
+                    }
+                }
+            } else {
+            }
+            if (dsl_let_pop_gate_41 > 0.0f) {
+                const float dsl_let_ring_radius_53 DSL_MAYBE_UNUSED = (dsl_let_body_radius_42 + ((dsl_let_radius_31 + 0.800000f) * dsl_let_pop_t_40));
+                const float dsl_let_ring_width_54 DSL_MAYBE_UNUSED = (0.120000f + ((1.000000f - dsl_let_pop_t_40) * 0.180000f));
+                const float dsl_let_ring_d_55 DSL_MAYBE_UNUSED = (fabsf(dsl_circle(dsl_let_local_39, dsl_let_ring_radius_53)) - dsl_let_ring_width_54);
+                const float dsl_let_ring_alpha_56 DSL_MAYBE_UNUSED = ((((1.000000f - dsl_smoothstep(0.000000f, 0.650000f, dsl_let_ring_d_55)) * dsl_let_pop_gate_41) * 0.900000f) * dsl_let_depth_alpha_50);
+                {
+                    const float __dsl_blend_a = dsl_let_ring_alpha_56;
+                    if (!(__dsl_blend_a <= 0.0f)) {
+                        __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = 0.580000f, .g = 0.880000f, .b = 1.000000f, .a = __dsl_blend_a }, __dsl_out);
+                    }
+                }
+            } else {
+            }
         }
     }
     *out_color = __dsl_out;
 }
 
+/* Generated from effect: soap_bubbles_v1 */
+static void soap_bubbles_render_rows(float time, float frame, int width_px, int height_px, int row_first, int row_step, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    const float width DSL_MAYBE_UNUSED = (float)width_px;
+    const float height DSL_MAYBE_UNUSED = (float)height_px;
+    for (int py = row_first; py < height_px; py += row_step) {
+        const float y DSL_MAYBE_UNUSED = (float)py;
+        for (int px = 0; px < width_px; px++) {
+            const float x DSL_MAYBE_UNUSED = (float)px;
+            dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
+            /* layer bubbles */
+            for (int32_t dsl_iter_i_24 = 0; dsl_iter_i_24 < 14; dsl_iter_i_24++) {
+                const float dsl_index_i_25 DSL_MAYBE_UNUSED = (float)dsl_iter_i_24;
+                const float dsl_let_id_26 DSL_MAYBE_UNUSED = dsl_index_i_25;
+                const float dsl_let_phase01_27 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_phase01_6[dsl_iter_i_24];
+                const float dsl_let_phase_28 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_phase_7[dsl_iter_i_24];
+                const float dsl_let_depth_phase_29 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_depth_phase_8[dsl_iter_i_24];
+                const float dsl_let_lane_x_30 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_lane_x_9[dsl_iter_i_24];
+                const float dsl_let_radius_31 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_radius_10[dsl_iter_i_24];
+                const float dsl_let_rise_speed_32 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_rise_speed_11[dsl_iter_i_24];
+                const float dsl_let_wobble_amp_33 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_wobble_amp_12[dsl_iter_i_24];
+                const float dsl_let_wobble_freq_34 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_wobble_freq_13[dsl_iter_i_24];
+                const float dsl_let_travel_35 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_travel_14[dsl_iter_i_24];
+                const float dsl_let_cycle_36 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_cycle_15[dsl_iter_i_24];
+                const float dsl_let_center_x_37 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_center_x_16[dsl_iter_i_24];
+                const float dsl_let_center_y_38 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_center_y_17[dsl_iter_i_24];
+                const dsl_vec2_t dsl_let_local_39 DSL_MAYBE_UNUSED = (dsl_vec2_t){ .x = dsl_wrapdx(x, dsl_let_center_x_37, width), .y = (y - dsl_let_center_y_38) };
+                const float dsl_let_pop_t_40 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_pop_t_18[dsl_iter_i_24];
+                const float dsl_let_pop_gate_41 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_pop_gate_19[dsl_iter_i_24];
+                const float dsl_let_body_radius_42 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_body_radius_20[dsl_iter_i_24];
+                if (!((-(dsl_let_body_radius_42)) <= 0.000000f) || DSL_NEAR_BOX(dsl_wrapdx(x, dsl_let_center_x_37, width), (y - dsl_let_center_y_38), dsl_reach_max(dsl_reach_max((dsl_let_body_radius_42 + 0.850000f), (dsl_let_body_radius_42 + 0.000000f)), ((dsl_let_body_radius_42 + ((dsl_let_radius_31 + 0.800000f) * dsl_let_pop_t_40)) + (0.650000f + (0.120000f + ((1.000000f - dsl_let_pop_t_40) * 0.180000f))))), dsl_reach_max(dsl_reach_max((dsl_let_body_radius_42 + 0.850000f), (dsl_let_body_radius_42 + 0.000000f)), ((dsl_let_body_radius_42 + ((dsl_let_radius_31 + 0.800000f) * dsl_let_pop_t_40)) + (0.650000f + (0.120000f + ((1.000000f - dsl_let_pop_t_40) * 0.180000f)))))) || DSL_NEAR_BOX((dsl_wrapdx(x, dsl_let_center_x_37, width) + (dsl_let_body_radius_42 * 0.400000f)), ((y - dsl_let_center_y_38) - (dsl_let_body_radius_42 * 0.340000f)), ((dsl_let_body_radius_42 * 0.230000f) + 0.550000f), ((dsl_let_body_radius_42 * 0.230000f) + 0.550000f))) {
+                    const float dsl_let_d_43 DSL_MAYBE_UNUSED = dsl_circle(dsl_let_local_39, dsl_let_body_radius_42);
+                    const float dsl_let_shell_alpha_44 DSL_MAYBE_UNUSED = (1.000000f - dsl_smoothstep(0.050000f, 0.850000f, fabsf(dsl_let_d_43)));
+                    const float dsl_let_core_alpha_45 DSL_MAYBE_UNUSED = ((1.000000f - dsl_smoothstep((-(dsl_let_body_radius_42)), 0.000000f, dsl_let_d_43)) * 0.120000f);
+                    const float dsl_let_hi_d_46 DSL_MAYBE_UNUSED = dsl_circle((dsl_vec2_t){ .x = (dsl_wrapdx(x, dsl_let_center_x_37, width) + (dsl_let_body_radius_42 * 0.400000f)), .y = ((y - dsl_let_center_y_38) - (dsl_let_body_radius_42 * 0.340000f)) }, (dsl_let_body_radius_42 * 0.230000f));
+                    const float dsl_let_hi_alpha_47 DSL_MAYBE_UNUSED = ((1.000000f - dsl_smoothstep(0.000000f, 0.550000f, dsl_let_hi_d_46)) * 0.260000f);
+                    const float dsl_let_depth_48 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_depth_21[dsl_iter_i_24];
+                    const float dsl_let_front_factor_49 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_front_factor_22[dsl_iter_i_24];
+                    const float dsl_let_depth_alpha_50 DSL_MAYBE_UNUSED = soap_bubbles_uniforms.dsl_let_depth_alpha_23[dsl_iter_i_24];
+                    const float dsl_let_body_alpha_51 DSL_MAYBE_UNUSED = fminf((((((dsl_let_shell_alpha_44 * 0.460000f) + dsl_let_core_alpha_45) + dsl_let_hi_alpha_47) * (1.000000f - (0.920000f * dsl_let_pop_t_40))) * dsl_let_depth_alpha_50), 0.860000f);
+                    if (dsl_let_body_alpha_51 > 0.0f) {
+                        const float dsl_let_tint_52 DSL_MAYBE_UNUSED = (0.500000f + (0.500000f * sinf((soap_bubbles_uniforms.dsl_let_tint_time_2 + dsl_let_phase_28))));
+                        {
+                            const float __dsl_blend_a = dsl_let_body_alpha_51;
+                            if (!(__dsl_blend_a <= 0.0f)) {
+                                __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = fminf((0.660000f + (0.200000f * dsl_let_tint_52)), 1.000000f), .g = fminf((0.820000f + (0.120000f * dsl_let_tint_52)), 1.000000f), .b = 1.000000f, .a = __dsl_blend_a }, __dsl_out);
+                            }
+                        }
+                    } else {
+                    }
+                    if (dsl_let_pop_gate_41 > 0.0f) {
+                        const float dsl_let_ring_radius_53 DSL_MAYBE_UNUSED = (dsl_let_body_radius_42 + ((dsl_let_radius_31 + 0.800000f) * dsl_let_pop_t_40));
+                        const float dsl_let_ring_width_54 DSL_MAYBE_UNUSED = (0.120000f + ((1.000000f - dsl_let_pop_t_40) * 0.180000f));
+                        const float dsl_let_ring_d_55 DSL_MAYBE_UNUSED = (fabsf(dsl_circle(dsl_let_local_39, dsl_let_ring_radius_53)) - dsl_let_ring_width_54);
+                        const float dsl_let_ring_alpha_56 DSL_MAYBE_UNUSED = ((((1.000000f - dsl_smoothstep(0.000000f, 0.650000f, dsl_let_ring_d_55)) * dsl_let_pop_gate_41) * 0.900000f) * dsl_let_depth_alpha_50);
+                        {
+                            const float __dsl_blend_a = dsl_let_ring_alpha_56;
+                            if (!(__dsl_blend_a <= 0.0f)) {
+                                __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = 0.580000f, .g = 0.880000f, .b = 1.000000f, .a = __dsl_blend_a }, __dsl_out);
+                            }
+                        }
+                    } else {
+                    }
+                }
+            }
+            dsl_store_pixel(pixel_out + (uint32_t)phys_index[py * width_px + px] * 3U, __dsl_out, grb_gamma);
+        }
+    }
+}
+
+/* Generated from effect: soap_bubbles_v1 */
+static void soap_bubbles_render_frame(float time, float frame, int width_px, int height_px, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    soap_bubbles_prepare_frame(time, frame, (float)width_px, (float)height_px, seed);
+    soap_bubbles_render_rows(time, frame, width_px, height_px, 0, 1, seed, pixel_out, phys_index, grb_gamma);
+}
+
+static dsl_shader_param_t spiral_galaxy_params[3] = {
+    { .name = "rotation_speed", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "arm_count", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "arm_tightness", .value = 0.0f, .pinned = 0, .settable = 1 },
+};
+
+typedef struct {
+    float dsl_param_rotation_speed_0;
+    float dsl_param_arm_count_1;
+    float dsl_param_arm_tightness_2;
+} spiral_galaxy_uniforms_t;
+
+static spiral_galaxy_uniforms_t spiral_galaxy_uniforms;
+
+/* Generated from effect: spiral_galaxy */
+static void spiral_galaxy_prepare_frame(float time, float frame, float width, float height, float seed) {
+    const float dsl_param_rotation_speed_0 DSL_MAYBE_UNUSED = spiral_galaxy_params[0].pinned ? spiral_galaxy_params[0].value : 0.150000f;
+    const float dsl_param_arm_count_1 DSL_MAYBE_UNUSED = spiral_galaxy_params[1].pinned ? spiral_galaxy_params[1].value : 2.000000f;
+    const float dsl_param_arm_tightness_2 DSL_MAYBE_UNUSED = spiral_galaxy_params[2].pinned ? spiral_galaxy_params[2].value : 3.000000f;
+    spiral_galaxy_uniforms.dsl_param_rotation_speed_0 = dsl_param_rotation_speed_0;
+    spiral_galaxy_uniforms.dsl_param_arm_count_1 = dsl_param_arm_count_1;
+    spiral_galaxy_uniforms.dsl_param_arm_tightness_2 = dsl_param_arm_tightness_2;
+}
+
 /* Generated from effect: spiral_galaxy */
 static void spiral_galaxy_eval_pixel(float time, float frame, float x, float y, float width, float height, float seed, dsl_color_t *out_color) {
-    const float dsl_param_rotation_speed_0 DSL_MAYBE_UNUSED = 0.150000f;
-    const float dsl_param_arm_count_1 DSL_MAYBE_UNUSED = 2.000000f;
-    const float dsl_param_arm_tightness_2 DSL_MAYBE_UNUSED = 3.000000f;
     dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
     /* layer nebula_bg */
     const float dsl_let_nx_3 DSL_MAYBE_UNUSED = (x / width);
     const float dsl_let_ny_4 DSL_MAYBE_UNUSED = (y / height);
     const float dsl_let_n_5 DSL_MAYBE_UNUSED = ((dsl_noise2((dsl_let_nx_3 * 3.000000f), (dsl_let_ny_4 * 3.000000f)) * 0.500000f) + 0.500000f);
     const float dsl_let_bg_6 DSL_MAYBE_UNUSED = (dsl_let_n_5 * 0.060000f);
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = (dsl_let_bg_6 * 0.300000f), .g = (dsl_let_bg_6 * 0.100000f), .b = (dsl_let_bg_6 * 0.500000f), .a = 1.000000f }, __dsl_out);
+    __dsl_out = dsl_color_opaque((dsl_color_t){ .r = (dsl_let_bg_6 * 0.300000f), .g = (dsl_let_bg_6 * 0.100000f), .b = (dsl_let_bg_6 * 0.500000f), .a = 1.000000f });
     /* layer spiral_arms */
     const float dsl_let_cx_7 DSL_MAYBE_UNUSED = (width * 0.500000f);
     const float dsl_let_cy_8 DSL_MAYBE_UNUSED = (height * 0.500000f);
@@ -935,14 +2677,19 @@ static void spiral_galaxy_eval_pixel(float time, float frame, float x, float y,
     const float dsl_let_dy_10 DSL_MAYBE_UNUSED = ((y - dsl_let_cy_8) / height);
     const float dsl_let_dist_11 DSL_MAYBE_UNUSED = sqrtf(((dsl_let_dx_9 * dsl_let_dx_9) + (dsl_let_dy_10 * dsl_let_dy_10)));
     const float dsl_let_angle_12 DSL_MAYBE_UNUSED = ((dsl_let_dx_9 * 6.000000f) + (dsl_let_dy_10 * 6.000000f));
-    const float dsl_let_spiral_13 DSL_MAYBE_UNUSED = sinf((((dsl_let_angle_12 + ((dsl_let_dist_11 * dsl_param_arm_tightness_2) * 6.28318530717958647692f)) - (time * dsl_param_rotation_speed_0)) * dsl_param_arm_count_1));
+    const float dsl_let_spiral_13 DSL_MAYBE_UNUSED = sinf((((dsl_let_angle_12 + ((dsl_let_dist_11 * spiral_galaxy_uniforms.dsl_param_arm_tightness_2) * 6.28318530717958647692f)) - (time * spiral_galaxy_uniforms.dsl_param_rotation_speed_0)) * spiral_galaxy_uniforms.dsl_param_arm_count_1));
     const float dsl_let_arm_14 DSL_MAYBE_UNUSED = powf(((dsl_let_spiral_13 * 0.500000f) + 0.500000f), 3.000000f);
     const float dsl_let_radial_15 DSL_MAYBE_UNUSED = dsl_smoothstep(0.500000f, 0.050000f, dsl_let_dist_11);
     const float dsl_let_brightness_16 DSL_MAYBE_UNUSED = ((dsl_let_arm_14 * dsl_let_radial_15) * 0.700000f);
     const float dsl_let_r_17 DSL_MAYBE_UNUSED = (dsl_let_brightness_16 * 0.600000f);
     const float dsl_let_g_18 DSL_MAYBE_UNUSED = (dsl_let_brightness_16 * 0.400000f);
     const float dsl_let_b_19 DSL_MAYBE_UNUSED = dsl_let_brightness_16;
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = dsl_let_r_17, .g = dsl_let_g_18, .b = dsl_let_b_19, .a = dsl_let_brightness_16 }, __dsl_out);
+    {
+        const float __dsl_blend_a = dsl_let_brightness_16;
+        if (!(__dsl_blend_a <= 0.0f)) {
+            __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_let_r_17, .g = dsl_let_g_18, .b = dsl_let_b_19, .a = __dsl_blend_a }, __dsl_out);
+        }
+    }
     /* layer arm_stars */
     const float dsl_let_cell_x_20 DSL_MAYBE_UNUSED = floorf((x * 0.400000f));
     const float dsl_let_cell_y_21 DSL_MAYBE_UNUSED = floorf((y * 0.300000f));
@@ -955,24 +2702,104 @@ static void spiral_galaxy_eval_pixel(float time, float frame, float x, float y,
     const float dsl_let_dy_28 DSL_MAYBE_UNUSED = ((y - dsl_let_cy_26) / height);
     const float dsl_let_dist_29 DSL_MAYBE_UNUSED = sqrtf(((dsl_let_dx_27 * dsl_let_dx_27) + (dsl_let_dy_28 * dsl_let_dy_28)));
     const float dsl_let_angle_30 DSL_MAYBE_UNUSED = ((dsl_let_dx_27 * 6.000000f) + (dsl_let_dy_28 * 6.000000f));
-    const float dsl_let_spiral_31 DSL_MAYBE_UNUSED = sinf((((dsl_let_angle_30 + ((dsl_let_dist_29 * dsl_param_arm_tightness_2) * 6.28318530717958647692f)) - (time * dsl_param_rotation_speed_0)) * dsl_param_arm_count_1));
+    const float dsl_let_spiral_31 DSL_MAYBE_UNUSED = sinf((((dsl_let_angle_30 + ((dsl_let_dist_29 * spiral_galaxy_uniforms.dsl_param_arm_tightness_2) * 6.28318530717958647692f)) - (time * spiral_galaxy_uniforms.dsl_param_rotation_speed_0)) * spiral_galaxy_uniforms.dsl_param_arm_count_1));
     const float dsl_let_arm_proximity_32 DSL_MAYBE_UNUSED = powf(((dsl_let_spiral_31 * 0.500000f) + 0.500000f), 2.000000f);
     const float dsl_let_threshold_33 DSL_MAYBE_UNUSED = (0.970000f - (0.050000f * dsl_let_arm_proximity_32));
     const float dsl_let_bright_34 DSL_MAYBE_UNUSED = (dsl_smoothstep(dsl_let_threshold_33, 1.000000f, dsl_let_presence_23) * (0.500000f + (0.500000f * dsl_let_twinkle_24)));
     const float dsl_let_r_35 DSL_MAYBE_UNUSED = (dsl_let_bright_34 * 0.900000f);
     const float dsl_let_g_36 DSL_MAYBE_UNUSED = (dsl_let_bright_34 * 0.850000f);
     const float dsl_let_b_37 DSL_MAYBE_UNUSED = dsl_let_bright_34;
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = dsl_let_r_35, .g = dsl_let_g_36, .b = dsl_let_b_37, .a = dsl_let_bright_34 }, __dsl_out);
+    {
+        const float __dsl_blend_a = dsl_let_bright_34;
+        if (!(__dsl_blend_a <= 0.0f)) {
+            __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_let_r_35, .g = dsl_let_g_36, .b = dsl_let_b_37, .a = __dsl_blend_a }, __dsl_out);
+        }
+    }
     *out_color = __dsl_out;
 }
 
+/* Generated from effect: spiral_galaxy */
+static void spiral_galaxy_render_rows(float time, float frame, int width_px, int height_px, int row_first, int row_step, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    const float width DSL_MAYBE_UNUSED = (float)width_px;
+    const float height DSL_MAYBE_UNUSED = (float)height_px;
+    for (int py = row_first; py < height_px; py += row_step) {
+        const float y DSL_MAYBE_UNUSED = (float)py;
+        const float dsl_let_ny_4 DSL_MAYBE_UNUSED = (y / height);
+        const float dsl_let_cx_7 DSL_MAYBE_UNUSED = (width * 0.500000f);
+        const float dsl_let_cy_8 DSL_MAYBE_UNUSED = (height * 0.500000f);
+        const float dsl_let_dy_10 DSL_MAYBE_UNUSED = ((y - dsl_let_cy_8) / height);
+        const float dsl_let_cell_y_21 DSL_MAYBE_UNUSED = floorf((y * 0.300000f));
+        const float dsl_let_cx_25 DSL_MAYBE_UNUSED = (width * 0.500000f);
+        const float dsl_let_cy_26 DSL_MAYBE_UNUSED = (height * 0.500000f);
+        const float dsl_let_dy_28 DSL_MAYBE_UNUSED = ((y - dsl_let_cy_26) / height);
+        for (int px = 0; px < width_px; px++) {
+            const float x DSL_MAYBE_UNUSED = (float)px;
+            dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
+            /* layer nebula_bg */
+            const float dsl_let_nx_3 DSL_MAYBE_UNUSED = (x / width);
+            const float dsl_let_n_5 DSL_MAYBE_UNUSED = ((dsl_noise2((dsl_let_nx_3 * 3.000000f), (dsl_let_ny_4 * 3.000000f)) * 0.500000f) + 0.500000f);
+            const float dsl_let_bg_6 DSL_MAYBE_UNUSED = (dsl_let_n_5 * 0.060000f);
+            __dsl_out = dsl_color_opaque((dsl_color_t){ .r = (dsl_let_bg_6 * 0.300000f), .g = (dsl_let_bg_6 * 0.100000f), .b = (dsl_let_bg_6 * 0.500000f), .a = 1.000000f });
+            /* layer spiral_arms */
+            const float dsl_let_dx_9 DSL_MAYBE_UNUSED = (dsl_wrapdx(x, dsl_let_cx_7, width) / width);
+            const float dsl_let_dist_11 DSL_MAYBE_UNUSED = sqrtf(((dsl_let_dx_9 * dsl_let_dx_9) + (dsl_let_dy_10 * dsl_let_dy_10)));
+            const float dsl_let_angle_12 DSL_MAYBE_UNUSED = ((dsl_let_dx_9 * 6.000000f) + (dsl_let_dy_10 * 6.000000f));
+            const float dsl_let_spiral_13 DSL_MAYBE_UNUSED = sinf((((dsl_let_angle_12 + ((dsl_let_dist_11 * spiral_galaxy_uniforms.dsl_param_arm_tightness_2) * 6.28318530717958647692f)) - (time * spiral_galaxy_uniforms.dsl_param_rotation_speed_0)) * spiral_galaxy_uniforms.dsl_param_arm_count_1));
+            const float dsl_let_arm_14 DSL_MAYBE_UNUSED = powf(((dsl_let_spiral_13 * 0.500000f) + 0.500000f), 3.000000f);
+            const float dsl_let_radial_15 DSL_MAYBE_UNUSED = dsl_smoothstep(0.500000f, 0.050000f, dsl_let_dist_11);
+            const float dsl_let_brightness_16 DSL_MAYBE_UNUSED = ((dsl_let_arm_14 * dsl_let_radial_15) * 0.700000f);
+            const float dsl_let_r_17 DSL_MAYBE_UNUSED = (dsl_let_brightness_16 * 0.600000f);
+            const float dsl_let_g_18 DSL_MAYBE_UNUSED = (dsl_let_brightness_16 * 0.400000f);
+            const float dsl_let_b_19 DSL_MAYBE_UNUSED = dsl_let_brightness_16;
+            {
+                const float __dsl_blend_a = dsl_let_brightness_16;
+                if (!(__dsl_blend_a <= 0.0f)) {
+                    __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_let_r_17, .g = dsl_let_g_18, .b = dsl_let_b_19, .a = __dsl_blend_a }, __dsl_out);
+                }
+            }
+            /* layer arm_stars */
+            const float dsl_let_cell_x_20 DSL_MAYBE_UNUSED = floorf((x * 0.400000f));
+            const float dsl_let_star_seed_22 DSL_MAYBE_UNUSED = ((dsl_let_cell_x_20 * 47.310000f) + (dsl_let_cell_y_21 * 29.170000f));
+            const float dsl_let_presence_23 DSL_MAYBE_UNUSED = dsl_hash01(dsl_let_star_seed_22);
+            const float dsl_let_twinkle_24 DSL_MAYBE_UNUSED = ((sinf(((time * 1.500000f) + (dsl_hash01((dsl_let_star_seed_22 + 3.000000f)) * 6.28318530717958647692f))) * 0.500000f) + 0.500000f);
+            const float dsl_let_dx_27 DSL_MAYBE_UNUSED = (dsl_wrapdx(x, dsl_let_cx_25, width) / width);
+            const float dsl_let_dist_29 DSL_MAYBE_UNUSED = sqrtf(((dsl_let_dx_27 * dsl_let_dx_27) + (dsl_let_dy_28 * dsl_let_dy_28)));
+            const float dsl_let_angle_30 DSL_MAYBE_UNUSED = ((dsl_let_dx_27 * 6.000000f) + (dsl_let_dy_28 * 6.000000f));
+            const float dsl_let_spiral_31 DSL_MAYBE_UNUSED = sinf((((dsl_let_angle_30 + ((dsl_let_dist_29 * spiral_galaxy_uniforms.dsl_param_arm_tightness_2) * 6.28318530717958647692f)) - (time * spiral_galaxy_uniforms.dsl_param_rotation_speed_0)) * spiral_galaxy_uniforms.dsl_param_arm_count_1));
+            const float dsl_let_arm_proximity_32 DSL_MAYBE_UNUSED = powf(((dsl_let_spiral_31 * 0.500000f) + 0.500000f), 2.000000f);
+            const float dsl_let_threshold_33 DSL_MAYBE_UNUSED = (0.970000f - (0.050000f * dsl_let_arm_proximity_32));
+            const float dsl_let_bright_34 DSL_MAYBE_UNUSED = (dsl_smoothstep(dsl_let_threshold_33, 1.000000f, dsl_let_presence_23) * (0.500000f + (0.500000f * dsl_let_twinkle_24)));
+            const float dsl_let_r_35 DSL_MAYBE_UNUSED = (dsl_let_bright_34 * 0.900000f);
+            const float dsl_let_g_36 DSL_MAYBE_UNUSED = (dsl_let_bright_34 * 0.850000f);
+            const float dsl_let_b_37 DSL_MAYBE_UNUSED = dsl_let_bright_34;
+            {
+                const float __dsl_blend_a = dsl_let_bright_34;
+                if (!(__dsl_blend_a <= 0.0f)) {
+                    __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_let_r_35, .g = dsl_let_g_36, .b = dsl_let_b_37, .a = __dsl_blend_a }, __dsl_out);
+                }
+            }
+            dsl_store_pixel(pixel_out + (uint32_t)phys_index[py * width_px + px] * 3U, __dsl_out, grb_gamma);
+        }
+    }
+}
+
+/* Generated from effect: spiral_galaxy */
+static void spiral_galaxy_render_frame(float time, float frame, int width_px, int height_px, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    spiral_galaxy_prepare_frame(time, frame, (float)width_px, (float)height_px, seed);
+    spiral_galaxy_render_rows(time, frame, width_px, height_px, 0, 1, seed, pixel_out, phys_index, grb_gamma);
+}
+
+/* Generated from effect: starfield */
+static void starfield_prepare_frame(float time, float frame, float width, float height, float seed) {
+}
+
 /* Generated from effect: starfield */
 static void starfield_eval_pixel(float time, float frame, float x, float y, float width, float height, float seed, dsl_color_t *out_color) {
     dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
     /* layer background */
     const float dsl_let_ny_0 DSL_MAYBE_UNUSED = (y / height);
     const float dsl_let_grad_1 DSL_MAYBE_UNUSED = (dsl_let_ny_0 * 0.060000f);
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = 0.010000f, .g = 0.010000f, .b = (0.040000f + dsl_let_grad_1), .a = 1.000000f }, __dsl_out);
+    __dsl_out = dsl_color_opaque((dsl_color_t){ .r = 0.010000f, .g = 0.010000f, .b = (0.040000f + dsl_let_grad_1), .a = 1.000000f });
     /* layer far_stars */
     const float dsl_let_cell_x_2 DSL_MAYBE_UNUSED = floorf((x * 0.500000f));
     const float dsl_let_cell_y_3 DSL_MAYBE_UNUSED = floorf((y * 0.500000f));
@@ -984,7 +2811,12 @@ static void starfield_eval_pixel(float time, float frame, float x, float y, floa
     const float dsl_let_r_9 DSL_MAYBE_UNUSED = (dsl_let_bright_7 * (0.700000f + (0.300000f * dsl_let_tint_8)));
     const float dsl_let_g_10 DSL_MAYBE_UNUSED = (dsl_let_bright_7 * (0.700000f + (0.300000f * (1.000000f - dsl_let_tint_8))));
     const float dsl_let_b_11 DSL_MAYBE_UNUSED = dsl_let_bright_7;
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = dsl_let_r_9, .g = dsl_let_g_10, .b = dsl_let_b_11, .a = dsl_let_bright_7 }, __dsl_out);
+    {
+        const float __dsl_blend_a = dsl_let_bright_7;
+        if (!(__dsl_blend_a <= 0.0f)) {
+            __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_let_r_9, .g = dsl_let_g_10, .b = dsl_let_b_11, .a = __dsl_blend_a }, __dsl_out);
+        }
+    }
     /* layer mid_stars */
     const float dsl_let_cell_x_12 DSL_MAYBE_UNUSED = floorf((x * 0.330000f));
     const float dsl_let_cell_y_13 DSL_MAYBE_UNUSED = floorf((y * 0.330000f));
@@ -996,7 +2828,12 @@ static void starfield_eval_pixel(float time, float frame, float x, float y, floa
     const float dsl_let_r_19 DSL_MAYBE_UNUSED = (dsl_let_bright_17 * (0.800000f + (0.200000f * dsl_let_warm_18)));
     const float dsl_let_g_20 DSL_MAYBE_UNUSED = (dsl_let_bright_17 * (0.850000f + (0.150000f * dsl_let_warm_18)));
     const float dsl_let_b_21 DSL_MAYBE_UNUSED = (dsl_let_bright_17 * (1.000000f - (0.200000f * dsl_let_warm_18)));
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = dsl_let_r_19, .g = dsl_let_g_20, .b = dsl_let_b_21, .a = dsl_let_bright_17 }, __dsl_out);
+    {
+        const float __dsl_blend_a = dsl_let_bright_17;
+        if (!(__dsl_blend_a <= 0.0f)) {
+            __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_let_r_19, .g = dsl_let_g_20, .b = dsl_let_b_21, .a = __dsl_blend_a }, __dsl_out);
+        }
+    }
     /* layer bright_stars */
     const float dsl_let_cell_x_22 DSL_MAYBE_UNUSED = floorf((x * 0.200000f));
     const float dsl_let_cell_y_23 DSL_MAYBE_UNUSED = floorf((y * 0.200000f));
@@ -1007,24 +2844,117 @@ static void starfield_eval_pixel(float time, float frame, float x, float y, floa
     const float dsl_let_r_28 DSL_MAYBE_UNUSED = dsl_let_bright_27;
     const float dsl_let_g_29 DSL_MAYBE_UNUSED = dsl_let_bright_27;
     const float dsl_let_b_30 DSL_MAYBE_UNUSED = dsl_let_bright_27;
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = dsl_let_r_28, .g = dsl_let_g_29, .b = dsl_let_b_30, .a = dsl_let_bright_27 }, __dsl_out);
+    {
+        const float __dsl_blend_a = dsl_let_bright_27;
+        if (!(__dsl_blend_a <= 0.0f)) {
+            __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_let_r_28, .g = dsl_let_g_29, .b = dsl_let_b_30, .a = __dsl_blend_a }, __dsl_out);
+        }
+    }
     *out_color = __dsl_out;
 }
 
+/* Generated from effect: starfield */
+static void starfield_render_rows(float time, float frame, int width_px, int height_px, int row_first, int row_step, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    const float width DSL_MAYBE_UNUSED = (float)width_px;
+    const float height DSL_MAYBE_UNUSED = (float)height_px;
+    for (int py = row_first; py < height_px; py += row_step) {
+        const float y DSL_MAYBE_UNUSED = (float)py;
+        const float dsl_let_ny_0 DSL_MAYBE_UNUSED = (y / height);
+        const float dsl_let_grad_1 DSL_MAYBE_UNUSED = (dsl_let_ny_0 * 0.060000f);
+        const float dsl_let_cell_y_3 DSL_MAYBE_UNUSED = floorf((y * 0.500000f));
+        const float dsl_let_cell_y_13 DSL_MAYBE_UNUSED = floorf((y * 0.330000f));
+        const float dsl_let_cell_y_23 DSL_MAYBE_UNUSED = floorf((y * 0.200000f));
+        for (int px = 0; px < width_px; px++) {
+            const float x DSL_MAYBE_UNUSED = (float)px;
+            dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
+            /* layer background */
+            __dsl_out = dsl_color_opaque((dsl_color_t){ .r = 0.010000f, .g = 0.010000f, .b = (0.040000f + dsl_let_grad_1), .a = 1.000000f });
+            /* layer far_stars */
+            const float dsl_let_cell_x_2 DSL_MAYBE_UNUSED = floorf((x * 0.500000f));
+            const float dsl_let_star_seed_4 DSL_MAYBE_UNUSED = ((dsl_let_cell_x_2 * 31.170000f) + (dsl_let_cell_y_3 * 57.930000f));
+            const float dsl_let_presence_5 DSL_MAYBE_UNUSED = dsl_hash01(dsl_let_star_seed_4);
+            const float dsl_let_flicker_6 DSL_MAYBE_UNUSED = dsl_hash01((dsl_let_star_seed_4 + (floorf((time * 0.800000f)) * 11.300000f)));
+            const float dsl_let_bright_7 DSL_MAYBE_UNUSED = (dsl_smoothstep(0.920000f, 1.000000f, dsl_let_presence_5) * (0.300000f + (0.700000f * dsl_let_flicker_6)));
+            const float dsl_let_tint_8 DSL_MAYBE_UNUSED = dsl_hash01((dsl_let_star_seed_4 + 7.000000f));
+            const float dsl_let_r_9 DSL_MAYBE_UNUSED = (dsl_let_bright_7 * (0.700000f + (0.300000f * dsl_let_tint_8)));
+            const float dsl_let_g_10 DSL_MAYBE_UNUSED = (dsl_let_bright_7 * (0.700000f + (0.300000f * (1.000000f - dsl_let_tint_8))));
+            const float dsl_let_b_11 DSL_MAYBE_UNUSED = dsl_let_bright_7;
+            {
+                const float __dsl_blend_a = dsl_let_bright_7;
+                if (!(__dsl_blend_a <= 0.0f)) {
+                    __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_let_r_9, .g = dsl_let_g_10, .b = dsl_let_b_11, .a = __dsl_blend_a }, __dsl_out);
+                }
+            }
+            /* layer mid_stars */
+            const float dsl_let_cell_x_12 DSL_MAYBE_UNUSED = floorf((x * 0.330000f));
+            const float dsl_let_star_seed_14 DSL_MAYBE_UNUSED = ((dsl_let_cell_x_12 * 43.710000f) + (dsl_let_cell_y_13 * 23.170000f));
+            const float dsl_let_presence_15 DSL_MAYBE_UNUSED = dsl_hash01(dsl_let_star_seed_14);
+            const float dsl_let_twinkle_16 DSL_MAYBE_UNUSED = ((sinf(((time * 2.500000f) + (dsl_hash01((dsl_let_star_seed_14 + 3.000000f)) * 6.28318530717958647692f))) * 0.500000f) + 0.500000f);
+            const float dsl_let_bright_17 DSL_MAYBE_UNUSED = (dsl_smoothstep(0.950000f, 1.000000f, dsl_let_presence_15) * (0.500000f + (0.500000f * dsl_let_twinkle_16)));
+            const float dsl_let_warm_18 DSL_MAYBE_UNUSED = dsl_hash01((dsl_let_star_seed_14 + 13.000000f));
+            const float dsl_let_r_19 DSL_MAYBE_UNUSED = (dsl_let_bright_17 * (0.800000f + (0.200000f * dsl_let_warm_18)));
+            const float dsl_let_g_20 DSL_MAYBE_UNUSED = (dsl_let_bright_17 * (0.850000f + (0.150000f * dsl_let_warm_18)));
+            const float dsl_let_b_21 DSL_MAYBE_UNUSED = (dsl_let_bright_17 * (1.000000f - (0.200000f * dsl_let_warm_18)));
+            {
+                const float __dsl_blend_a = dsl_let_bright_17;
+                if (!(__dsl_blend_a <= 0.0f)) {
+                    __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_let_r_19, .g = dsl_let_g_20, .b = dsl_let_b_21, .a = __dsl_blend_a }, __dsl_out);
+                }
+            }
+            /* layer bright_stars */
+            const float dsl_let_cell_x_22 DSL_MAYBE_UNUSED = floorf((x * 0.200000f));
+            const float dsl_let_star_seed_24 DSL_MAYBE_UNUSED = ((dsl_let_cell_x_22 * 71.310000f) + (dsl_let_cell_y_23 * 37.910000f));
+            const float dsl_let_presence_25 DSL_MAYBE_UNUSED = dsl_hash01(dsl_let_star_seed_24);
+            const float dsl_let_twinkle_26 DSL_MAYBE_UNUSED = powf(((sinf(((time * 1.800000f) + (dsl_hash01((dsl_let_star_seed_24 + 5.000000f)) * 6.28318530717958647692f))) * 0.500000f) + 0.500000f), 2.000000f);
+            const float dsl_let_bright_27 DSL_MAYBE_UNUSED = (dsl_smoothstep(0.970000f, 1.000000f, dsl_let_presence_25) * (0.600000f + (0.400000f * dsl_let_twinkle_26)));
+            const float dsl_let_r_28 DSL_MAYBE_UNUSED = dsl_let_bright_27;
+            const float dsl_let_g_29 DSL_MAYBE_UNUSED = dsl_let_bright_27;
+            const float dsl_let_b_30 DSL_MAYBE_UNUSED = dsl_let_bright_27;
+            {
+                const float __dsl_blend_a = dsl_let_bright_27;
+                if (!(__dsl_blend_a <= 0.0f)) {
+                    __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = dsl_let_r_28, .g = dsl_let_g_29, .b = dsl_let_b_30, .a = __dsl_blend_a }, __dsl_out);
+                }
+            }
+            dsl_store_pixel(pixel_out + (uint32_t)phys_index[py * width_px + px] * 3U, __dsl_out, grb_gamma);
+        }
+    }
+}
+
+/* Generated from effect: starfield */
+static void starfield_render_frame(float time, float frame, int width_px, int height_px, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    starfield_prepare_frame(time, frame, (float)width_px, (float)height_px, seed);
+    starfield_render_rows(time, frame, width_px, height_px, 0, 1, seed, pixel_out, phys_index, grb_gamma);
+}
+
+static dsl_shader_param_t tone_pulse_params[2] = {
+    { .name = "base_freq", .value = 0.0f, .pinned = 0, .settable = 1 },
+    { .name = "pulse_rate", .value = 0.0f, .pinned = 0, .settable = 1 },
+};
+
+typedef struct {
+    float dsl_param_base_freq_0;
+    float dsl_param_pulse_rate_1;
+    float dsl_let_pulse_2;
+    float dsl_let_brightness_3;
+} tone_pulse_uniforms_t;
+
+static tone_pulse_uniforms_t tone_pulse_uniforms;
+
 /* Generated from effect: tone_pulse */
-static void tone_pulse_eval_frame(float time, float frame) {
-    const float dsl_param_base_freq_0 DSL_MAYBE_UNUSED = 220.000000f;
-    const float dsl_param_pulse_rate_1 DSL_MAYBE_UNUSED = 2.000000f;
+static void tone_pulse_prepare_frame(float time, float frame, float width, float height, float seed) {
+    const float dsl_param_base_freq_0 DSL_MAYBE_UNUSED = tone_pulse_params[0].pinned ? tone_pulse_params[0].value : 220.000000f;
+    const float dsl_param_pulse_rate_1 DSL_MAYBE_UNUSED = tone_pulse_params[1].pinned ? tone_pulse_params[1].value : 2.000000f;
     const float dsl_let_pulse_2 DSL_MAYBE_UNUSED = dsl_clamp(((sinf(((time * dsl_param_pulse_rate_1) * 6.283185f)) * 0.500000f) + 0.500000f), 0.000000f, 1.000000f);
     const float dsl_let_brightness_3 DSL_MAYBE_UNUSED = (dsl_let_pulse_2 * dsl_let_pulse_2);
+    tone_pulse_uniforms.dsl_param_base_freq_0 = dsl_param_base_freq_0;
+    tone_pulse_uniforms.dsl_param_pulse_rate_1 = dsl_param_pulse_rate_1;
+    tone_pulse_uniforms.dsl_let_pulse_2 = dsl_let_pulse_2;
+    tone_pulse_uniforms.dsl_let_brightness_3 = dsl_let_brightness_3;
 }
 
 /* Generated from effect: tone_pulse */
 static void tone_pulse_eval_pixel(float time, float frame, float x, float y, float width, float height, float seed, dsl_color_t *out_color) {
-    const float dsl_param_base_freq_0 DSL_MAYBE_UNUSED = 220.000000f;
-    const float dsl_param_pulse_rate_1 DSL_MAYBE_UNUSED = 2.000000f;
-    const float dsl_let_pulse_2 DSL_MAYBE_UNUSED = dsl_clamp(((sinf(((time * dsl_param_pulse_rate_1) * 6.283185f)) * 0.500000f) + 0.500000f), 0.000000f, 1.000000f);
-    const float dsl_let_brightness_3 DSL_MAYBE_UNUSED = (dsl_let_pulse_2 * dsl_let_pulse_2);
     dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
     /* layer glow */
     const float dsl_let_hue_4 DSL_MAYBE_UNUSED = dsl_fract(((time * 0.050000f) + seed));
@@ -1033,15 +2963,54 @@ static void tone_pulse_eval_pixel(float time, float frame, float x, float y, flo
     const float dsl_let_b_7 DSL_MAYBE_UNUSED = dsl_clamp(((sinf(((dsl_let_hue_4 * 6.283185f) + 4.189000f)) * 0.500000f) + 0.500000f), 0.000000f, 1.000000f);
     const float dsl_let_dist_8 DSL_MAYBE_UNUSED = (fabsf(((y / height) - 0.500000f)) * 2.000000f);
     const float dsl_let_mask_9 DSL_MAYBE_UNUSED = dsl_clamp((1.000000f - dsl_let_dist_8), 0.000000f, 1.000000f);
-    const float dsl_let_intensity_10 DSL_MAYBE_UNUSED = (dsl_let_brightness_3 * dsl_let_mask_9);
-    __dsl_out = dsl_blend_over((dsl_color_t){ .r = (dsl_let_r_5 * dsl_let_intensity_10), .g = (dsl_let_g_6 * dsl_let_intensity_10), .b = (dsl_let_b_7 * dsl_let_intensity_10), .a = dsl_let_intensity_10 }, __dsl_out);
+    const float dsl_let_intensity_10 DSL_MAYBE_UNUSED = (tone_pulse_uniforms.dsl_let_brightness_3 * dsl_let_mask_9);
+    {
+        const float __dsl_blend_a = dsl_let_intensity_10;
+        if (!(__dsl_blend_a <= 0.0f)) {
+            __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = (dsl_let_r_5 * dsl_let_intensity_10), .g = (dsl_let_g_6 * dsl_let_intensity_10), .b = (dsl_let_b_7 * dsl_let_intensity_10), .a = __dsl_blend_a }, __dsl_out);
+        }
+    }
     *out_color = __dsl_out;
 }
 
+/* Generated from effect: tone_pulse */
+static void tone_pulse_render_rows(float time, float frame, int width_px, int height_px, int row_first, int row_step, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    const float width DSL_MAYBE_UNUSED = (float)width_px;
+    const float height DSL_MAYBE_UNUSED = (float)height_px;
+    for (int py = row_first; py < height_px; py += row_step) {
+        const float y DSL_MAYBE_UNUSED = (float)py;
+        const float dsl_let_hue_4 DSL_MAYBE_UNUSED = dsl_fract(((time * 0.050000f) + seed));
+        const float dsl_let_r_5 DSL_MAYBE_UNUSED = dsl_clamp(((sinf((dsl_let_hue_4 * 6.283185f)) * 0.500000f) + 0.500000f), 0.000000f, 1.000000f);
+        const float dsl_let_g_6 DSL_MAYBE_UNUSED = dsl_clamp(((sinf(((dsl_let_hue_4 * 6.283185f) + 2.094000f)) * 0.500000f) + 0.500000f), 0.000000f, 1.000000f);
+        const float dsl_let_b_7 DSL_MAYBE_UNUSED = dsl_clamp(((sinf(((dsl_let_hue_4 * 6.283185f) + 4.189000f)) * 0.500000f) + 0.500000f), 0.000000f, 1.000000f);
+        const float dsl_let_dist_8 DSL_MAYBE_UNUSED = (fabsf(((y / height) - 0.500000f)) * 2.000000f);
+        const float dsl_let_mask_9 DSL_MAYBE_UNUSED = dsl_clamp((1.000000f - dsl_let_dist_8), 0.000000f, 1.000000f);
+        const float dsl_let_intensity_10 DSL_MAYBE_UNUSED = (tone_pulse_uniforms.dsl_let_brightness_3 * dsl_let_mask_9);
+        for (int px = 0; px < width_px; px++) {
+            const float x DSL_MAYBE_UNUSED = (float)px;
+            dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };
+            /* layer glow */
+            {
+                const float __dsl_blend_a = dsl_let_intensity_10;
+                if (!(__dsl_blend_a <= 0.0f)) {
+                    __dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = (dsl_let_r_5 * dsl_let_intensity_10), .g = (dsl_let_g_6 * dsl_let_intensity_10), .b = (dsl_let_b_7 * dsl_let_intensity_10), .a = __dsl_blend_a }, __dsl_out);
+                }
+            }
+            dsl_store_pixel(pixel_out + (uint32_t)phys_index[py * width_px + px] * 3U, __dsl_out, grb_gamma);
+        }
+    }
+}
+
+/* Generated from effect: tone_pulse */
+static void tone_pulse_render_frame(float time, float frame, int width_px, int height_px, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {
+    tone_pulse_prepare_frame(time, frame, (float)width_px, (float)height_px, seed);
+    tone_pulse_render_rows(time, frame, width_px, height_px, 0, 1, seed, pixel_out, phys_index, grb_gamma);
+}
+
 /* Audio: generated from effect: tone_pulse */
 static float tone_pulse_eval_audio(float time, float seed, float sample_rate, float *phasor_state) {
-    const float dsl_param_base_freq_0 DSL_MAYBE_UNUSED = 220.000000f;
-    const float dsl_param_pulse_rate_1 DSL_MAYBE_UNUSED = 2.000000f;
+    const float dsl_param_base_freq_0 DSL_MAYBE_UNUSED = tone_pulse_params[0].pinned ? tone_pulse_params[0].value : 220.000000f;
+    const float dsl_param_pulse_rate_1 DSL_MAYBE_UNUSED = tone_pulse_params[1].pinned ? tone_pulse_params[1].value : 2.000000f;
     float __dsl_audio_out = 0.0f;
     const float dsl_let_pulse_2 DSL_MAYBE_UNUSED = dsl_clamp(((sinf(((time * dsl_param_pulse_rate_1) * 6.283185f)) * 0.500000f) + 0.500000f), 0.000000f, 1.000000f);
     const float dsl_let_freq_3 DSL_MAYBE_UNUSED = (dsl_param_base_freq_0 + (dsl_let_pulse_2 * dsl_param_base_freq_0));
@@ -1055,35 +3024,39 @@ typedef struct {
     const char *folder;
     void (*eval_pixel)(float time, float frame, float x, float y, float width, float height, float seed, dsl_color_t *out_color);
     int has_frame_func;
-    void (*eval_frame)(float time, float frame);
+    void (*prepare_frame)(float time, float frame, float width, float height, float seed);
+    void (*render_frame)(float time, float frame, int width, int height, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma);
+    void (*render_rows)(float time, float frame, int width, int height, int row_first, int row_step, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma);
     int has_audio_func;
     float (*eval_audio)(float time, float seed, float sample_rate, float *phasor_state);
     int phasor_count;
     int target_fps;
+    dsl_shader_param_t *params;
+    int param_count;
 } dsl_shader_entry_t;
 
 const dsl_shader_entry_t dsl_shader_registry[] = {
-    { .name = "a440-test-tone", .folder = "/native/audio", .eval_pixel = a440_test_tone_eval_pixel, .has_frame_func = 0, .eval_frame = (void(*)(float,float))0, .has_audio_func = 1, .eval_audio = a440_test_tone_eval_audio, .phasor_count = 0, .target_fps = 0 },
-    { .name = "aurora", .folder = "/native/ambient", .eval_pixel = aurora_eval_pixel, .has_frame_func = 0, .eval_frame = (void(*)(float,float))0, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0 },
-    { .name = "aurora-ribbons-classic", .folder = "/native/ambient", .eval_pixel = aurora_ribbons_classic_eval_pixel, .has_frame_func = 1, .eval_frame = aurora_ribbons_classic_eval_frame, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0 },
-    { .name = "blink", .folder = "/native/geometric", .eval_pixel = blink_eval_pixel, .has_frame_func = 0, .eval_frame = (void(*)(float,float))0, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0 },
-    { .name = "campfire", .folder = "/native/nature", .eval_pixel = campfire_eval_pixel, .has_frame_func = 0, .eval_frame = (void(*)(float,float))0, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0 },
-    { .name = "chaos-nebula", .folder = "/native/energetic", .eval_pixel = chaos_nebula_eval_pixel, .has_frame_func = 0, .eval_frame = (void(*)(float,float))0, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0 },
-    { .name = "dream-weaver", .folder = "/native/ambient", .eval_pixel = dream_weaver_eval_pixel, .has_frame_func = 0, .eval_frame = (void(*)(float,float))0, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0 },
-    { .name = "electric-arcs", .folder = "/native/energetic", .eval_pixel = electric_arcs_eval_pixel, .has_frame_func = 0, .eval_frame = (void(*)(float,float))0, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0 },
-    { .name = "forest-wind", .folder = "/native/nature", .eval_pixel = forest_wind_eval_pixel, .has_frame_func = 0, .eval_frame = (void(*)(float,float))0, .has_audio_func = 1, .eval_audio = forest_wind_eval_audio, .phasor_count = 0, .target_fps = 30 },
-    { .name = "gradient", .folder = "/native/ambient", .eval_pixel = gradient_eval_pixel, .has_frame_func = 0, .eval_frame = (void(*)(float,float))0, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0 },
-    { .name = "heartbeat-pulse", .folder = "/native/audio", .eval_pixel = heartbeat_pulse_eval_pixel, .has_frame_func = 1, .eval_frame = heartbeat_pulse_eval_frame, .has_audio_func = 1, .eval_audio = heartbeat_pulse_eval_audio, .phasor_count = 0, .target_fps = 0 },
-    { .name = "infinite-lines", .folder = "/native/geometric", .eval_pixel = infinite_lines_eval_pixel, .has_frame_func = 1, .eval_frame = infinite_lines_eval_frame, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0 },
-    { .name = "lava-lamp", .folder = "/native/ambient", .eval_pixel = lava_lamp_eval_pixel, .has_frame_func = 0, .eval_frame = (void(*)(float,float))0, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0 },
-    { .name = "ocean-waves", .folder = "/native/nature", .eval_pixel = ocean_waves_eval_pixel, .has_frame_func = 0, .eval_frame = (void(*)(float,float))0, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0 },
-    { .name = "primal-storm", .folder = "/native/energetic", .eval_pixel = primal_storm_eval_pixel, .has_frame_func = 0, .eval_frame = (void(*)(float,float))0, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0 },
-    { .name = "rain-matrix", .folder = "/native/energetic", .eval_pixel = rain_matrix_eval_pixel, .has_frame_func = 0, .eval_frame = (void(*)(float,float))0, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0 },
-    { .name = "rain-ripple", .folder = "/native/nature", .eval_pixel = rain_ripple_eval_pixel, .has_frame_func = 0, .eval_frame = (void(*)(float,float))0, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0 },
-    { .name = "soap-bubbles", .folder = "/native/ambient", .eval_pixel = soap_bubbles_eval_pixel, .has_frame_func = 1, .eval_frame = soap_bubbles_eval_frame, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 20 },
-    { .name = "spiral-galaxy", .folder = "/native/cosmic", .eval_pixel = spiral_galaxy_eval_pixel, .has_frame_func = 0, .eval_frame = (void(*)(float,float))0, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0 },
-    { .name = "starfield", .folder = "/native/cosmic", .eval_pixel = starfield_eval_pixel, .has_frame_func = 0, .eval_frame = (void(*)(float,float))0, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0 },
-    { .name = "tone-pulse", .folder = "/native/audio", .eval_pixel = tone_pulse_eval_pixel, .has_frame_func = 1, .eval_frame = tone_pulse_eval_frame, .has_audio_func = 1, .eval_audio = tone_pulse_eval_audio, .phasor_count = 0, .target_fps = 0 },
+    { .name = "a440-test-tone", .folder = "/native/audio", .eval_pixel = a440_test_tone_eval_pixel, .has_frame_func = 0, .prepare_frame = a440_test_tone_prepare_frame, .render_frame = a440_test_tone_render_frame, .render_rows = a440_test_tone_render_rows, .has_audio_func = 1, .eval_audio = a440_test_tone_eval_audio, .phasor_count = 0, .target_fps = 0, .params = (dsl_shader_param_t *)0, .param_count = 0 },
+    { .name = "aurora", .folder = "/native/ambient", .eval_pixel = aurora_eval_pixel, .has_frame_func = 0, .prepare_frame = aurora_prepare_frame, .render_frame = aurora_render_frame, .render_rows = aurora_render_rows, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0, .params = aurora_params, .param_count = 3 },
+    { .name = "aurora-ribbons-classic", .folder = "/native/ambient", .eval_pixel = aurora_ribbons_classic_eval_pixel, .has_frame_func = 1, .prepare_frame = aurora_ribbons_classic_prepare_frame, .render_frame = aurora_ribbons_classic_render_frame, .render_rows = aurora_ribbons_classic_render_rows, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0, .params = (dsl_shader_param_t *)0, .param_count = 0 },
+    { .name = "blink", .folder = "/native/geometric", .eval_pixel = blink_eval_pixel, .has_frame_func = 0, .prepare_frame = blink_prepare_frame, .render_frame = blink_render_frame, .render_rows = blink_render_rows, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0, .params = (dsl_shader_param_t *)0, .param_count = 0 },
+    { .name = "campfire", .folder = "/native/nature", .eval_pixel = campfire_eval_pixel, .has_frame_func = 0, .prepare_frame = campfire_prepare_frame, .render_frame = campfire_render_frame, .render_rows = campfire_render_rows, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0, .params = campfire_params, .param_count = 4 },
+    { .name = "chaos-nebula", .folder = "/native/energetic", .eval_pixel = chaos_nebula_eval_pixel, .has_frame_func = 0, .prepare_frame = chaos_nebula_prepare_frame, .render_frame = chaos_nebula_render_frame, .render_rows = chaos_nebula_render_rows, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0, .params = chaos_nebula_params, .param_count = 9 },
+    { .name = "dream-weaver", .folder = "/native/ambient", .eval_pixel = dream_weaver_eval_pixel, .has_frame_func = 0, .prepare_frame = dream_weaver_prepare_frame, .render_frame = dream_weaver_render_frame, .render_rows = dream_weaver_render_rows, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0, .params = dream_weaver_params, .param_count = 11 },
+    { .name = "electric-arcs", .folder = "/native/energetic", .eval_pixel = electric_arcs_eval_pixel, .has_frame_func = 0, .prepare_frame = electric_arcs_prepare_frame, .render_frame = electric_arcs_render_frame, .render_rows = electric_arcs_render_rows, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0, .params = electric_arcs_params, .param_count = 2 },
+    { .name = "forest-wind", .folder = "/native/nature", .eval_pixel = forest_wind_eval_pixel, .has_frame_func = 0, .prepare_frame = forest_wind_prepare_frame, .render_frame = forest_wind_render_frame, .render_rows = forest_wind_render_rows, .has_audio_func = 1, .eval_audio = forest_wind_eval_audio, .phasor_count = 0, .target_fps = 30, .params = forest_wind_params, .param_count = 2 },
+    { .name = "gradient", .folder = "/native/ambient", .eval_pixel = gradient_eval_pixel, .has_frame_func = 0, .prepare_frame = gradient_prepare_frame, .render_frame = gradient_render_frame, .render_rows = gradient_render_rows, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0, .params = (dsl_shader_param_t *)0, .param_count = 0 },
+    { .name = "heartbeat-pulse", .folder = "/native/audio", .eval_pixel = heartbeat_pulse_eval_pixel, .has_frame_func = 1, .prepare_frame = heartbeat_pulse_prepare_frame, .render_frame = heartbeat_pulse_render_frame, .render_rows = heartbeat_pulse_render_rows, .has_audio_func = 1, .eval_audio = heartbeat_pulse_eval_audio, .phasor_count = 0, .target_fps = 0, .params = heartbeat_pulse_params, .param_count = 1 },
+    { .name = "infinite-lines", .folder = "/native/geometric", .eval_pixel = infinite_lines_eval_pixel, .has_frame_func = 1, .prepare_frame = infinite_lines_prepare_frame, .render_frame = infinite_lines_render_frame, .render_rows = infinite_lines_render_rows, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0, .params = infinite_lines_params, .param_count = 3 },
+    { .name = "lava-lamp", .folder = "/native/ambient", .eval_pixel = lava_lamp_eval_pixel, .has_frame_func = 0, .prepare_frame = lava_lamp_prepare_frame, .render_frame = lava_lamp_render_frame, .render_rows = lava_lamp_render_rows, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0, .params = lava_lamp_params, .param_count = 2 },
+    { .name = "ocean-waves", .folder = "/native/nature", .eval_pixel = ocean_waves_eval_pixel, .has_frame_func = 0, .prepare_frame = ocean_waves_prepare_frame, .render_frame = ocean_waves_render_frame, .render_rows = ocean_waves_render_rows, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0, .params = ocean_waves_params, .param_count = 4 },
+    { .name = "primal-storm", .folder = "/native/energetic", .eval_pixel = primal_storm_eval_pixel, .has_frame_func = 0, .prepare_frame = primal_storm_prepare_frame, .render_frame = primal_storm_render_frame, .render_rows = primal_storm_render_rows, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0, .params = primal_storm_params, .param_count = 8 },
+    { .name = "rain-matrix", .folder = "/native/energetic", .eval_pixel = rain_matrix_eval_pixel, .has_frame_func = 0, .prepare_frame = rain_matrix_prepare_frame, .render_frame = rain_matrix_render_frame, .render_rows = rain_matrix_render_rows, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0, .params = rain_matrix_params, .param_count = 2 },
+    { .name = "rain-ripple", .folder = "/native/nature", .eval_pixel = rain_ripple_eval_pixel, .has_frame_func = 0, .prepare_frame = rain_ripple_prepare_frame, .render_frame = rain_ripple_render_frame, .render_rows = rain_ripple_render_rows, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0, .params = rain_ripple_params, .param_count = 4 },
+    { .name = "soap-bubbles", .folder = "/native/ambient", .eval_pixel = soap_bubbles_eval_pixel, .has_frame_func = 1, .prepare_frame = soap_bubbles_prepare_frame, .render_frame = soap_bubbles_render_frame, .render_rows = soap_bubbles_render_rows, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 20, .params = (dsl_shader_param_t *)0, .param_count = 0 },
+    { .name = "spiral-galaxy", .folder = "/native/cosmic", .eval_pixel = spiral_galaxy_eval_pixel, .has_frame_func = 0, .prepare_frame = spiral_galaxy_prepare_frame, .render_frame = spiral_galaxy_render_frame, .render_rows = spiral_galaxy_render_rows, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0, .params = spiral_galaxy_params, .param_count = 3 },
+    { .name = "starfield", .folder = "/native/cosmic", .eval_pixel = starfield_eval_pixel, .has_frame_func = 0, .prepare_frame = starfield_prepare_frame, .render_frame = starfield_render_frame, .render_rows = starfield_render_rows, .has_audio_func = 0, .eval_audio = (float(*)(float,float,float,float*))0, .phasor_count = 0, .target_fps = 0, .params = (dsl_shader_param_t *)0, .param_count = 0 },
+    { .name = "tone-pulse", .folder = "/native/audio", .eval_pixel = tone_pulse_eval_pixel, .has_frame_func = 1, .prepare_frame = tone_pulse_prepare_frame, .render_frame = tone_pulse_render_frame, .render_rows = tone_pulse_render_rows, .has_audio_func = 1, .eval_audio = tone_pulse_eval_audio, .phasor_count = 0, .target_fps = 0, .params = tone_pulse_params, .param_count = 2 },
 };
 
 const int dsl_shader_registry_count = 21;
@@ -1,6 +1,8 @@
 #ifndef DSL_SHADER_REGISTRY_H
 #define DSL_SHADER_REGISTRY_H
 
+#include <stdint.h>
+
 typedef struct {
     float r;
     float g;
@@ -8,16 +10,28 @@ typedef struct {
     float a;
 } dsl_color_t;
 
+/* One DSL param of a shader; SET_PARAMS pins settable ones (no x/y dependency) to value. */
+typedef struct {
+    const char *name;
+    float value;
+    uint8_t pinned;
+    uint8_t settable;
+} dsl_shader_param_t;
+
 typedef struct {
     const char *name;
     const char *folder;
     void (*eval_pixel)(float time, float frame, float x, float y, float width, float height, float seed, dsl_color_t *out_color);
     int has_frame_func;
-    void (*eval_frame)(float time, float frame);
+    void (*prepare_frame)(float time, float frame, float width, float height, float seed);
+    void (*render_frame)(float time, float frame, int width, int height, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma);
+    void (*render_rows)(float time, float frame, int width, int height, int row_first, int row_step, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma);
     int has_audio_func;
     float (*eval_audio)(float time, float seed, float sample_rate, float *phasor_state);
     int phasor_count;
     int target_fps;
+    dsl_shader_param_t *params;
+    int param_count;
 } dsl_shader_entry_t;
 
 extern const dsl_shader_entry_t dsl_shader_registry[];
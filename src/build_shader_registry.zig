@@ -16,6 +16,7 @@ const ShaderEntry = struct {
     has_audio: bool,
     phasor_count: usize,
     target_fps: u32,
+    param_count: usize,
 };
 
 /// Derive a C-safe prefix from a DSL filename: "chaos-nebula.dsl" → "chaos_nebula"
@@ -98,11 +99,15 @@ pub fn generate(allocator: std.mem.Allocator, dsl_dir_path: []const u8, output_d
             \\    const char *folder;
             \\    void (*eval_pixel)(float time, float frame, float x, float y, float width, float height, float seed, dsl_color_t *out_color);
             \\    int has_frame_func;
-            \\    void (*eval_frame)(float time, float frame);
+            \\    void (*prepare_frame)(float time, float frame, float width, float height, float seed);
+            \\    void (*render_frame)(float time, float frame, int width, int height, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma);
+            \\    void (*render_rows)(float time, float frame, int width, int height, int row_first, int row_step, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma);
             \\    int has_audio_func;
             \\    float (*eval_audio)(float time, float seed, float sample_rate, float *phasor_state);
             \\    int phasor_count;
             \\    int target_fps;
+            \\    dsl_shader_param_t *params;
+            \\    int param_count;
             \\} dsl_shader_entry_t;
             \\
             \\
@@ -111,11 +116,8 @@ pub fn generate(allocator: std.mem.Allocator, dsl_dir_path: []const u8, output_d
         try w.print("const dsl_shader_entry_t dsl_shader_registry[] = {{\n", .{});
         for (entries.items) |entry| {
             try w.print("    {{ .name = \"{s}\", .folder = \"{s}\", .eval_pixel = {s}_eval_pixel", .{ entry.name, entry.folder, entry.prefix });
-            if (entry.has_frame) {
-                try w.print(", .has_frame_func = 1, .eval_frame = {s}_eval_frame", .{entry.prefix});
-            } else {
-                try w.writeAll(", .has_frame_func = 0, .eval_frame = (void(*)(float,float))0");
-            }
+            try w.print(", .has_frame_func = {d}, .prepare_frame = {s}_prepare_frame", .{ @intFromBool(entry.has_frame), entry.prefix });
+            try w.print(", .render_frame = {s}_render_frame, .render_rows = {s}_render_rows", .{ entry.prefix, entry.prefix });
             if (entry.has_audio) {
                 try w.print(", .has_audio_func = 1, .eval_audio = {s}_eval_audio", .{entry.prefix});
             } else {
@@ -123,6 +125,11 @@ pub fn generate(allocator: std.mem.Allocator, dsl_dir_path: []const u8, output_d
             }
             try w.print(", .phasor_count = {d}", .{entry.phasor_count});
             try w.print(", .target_fps = {d}", .{entry.target_fps});
+            if (entry.param_count > 0) {
+                try w.print(", .params = {s}_params, .param_count = {d}", .{ entry.prefix, entry.param_count });
+            } else {
+                try w.writeAll(", .params = (dsl_shader_param_t *)0, .param_count = 0");
+            }
             try w.writeAll(" },\n");
         }
         try w.writeAll("};\n\n");
@@ -166,6 +173,8 @@ pub fn generate(allocator: std.mem.Allocator, dsl_dir_path: []const u8, output_d
             \\#ifndef DSL_SHADER_REGISTRY_H
             \\#define DSL_SHADER_REGISTRY_H
             \\
+            \\#include <stdint.h>
+            \\
             \\typedef struct {
             \\    float r;
             \\    float g;
@@ -173,16 +182,28 @@ pub fn generate(allocator: std.mem.Allocator, dsl_dir_path: []const u8, output_d
             \\    float a;
             \\} dsl_color_t;
             \\
+            \\/* One DSL param of a shader; SET_PARAMS pins settable ones (no x/y dependency) to value. */
+            \\typedef struct {
+            \\    const char *name;
+            \\    float value;
+            \\    uint8_t pinned;
+            \\    uint8_t settable;
+            \\} dsl_shader_param_t;
+            \\
             \\typedef struct {
             \\    const char *name;
             \\    const char *folder;
             \\    void (*eval_pixel)(float time, float frame, float x, float y, float width, float height, float seed, dsl_color_t *out_color);
             \\    int has_frame_func;
-            \\    void (*eval_frame)(float time, float frame);
+            \\    void (*prepare_frame)(float time, float frame, float width, float height, float seed);
+            \\    void (*render_frame)(float time, float frame, int width, int height, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma);
+            \\    void (*render_rows)(float time, float frame, int width, int height, int row_first, int row_step, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma);
             \\    int has_audio_func;
             \\    float (*eval_audio)(float time, float seed, float sample_rate, float *phasor_state);
             \\    int phasor_count;
             \\    int target_fps;
+            \\    dsl_shader_param_t *params;
+            \\    int param_count;
             \\} dsl_shader_entry_t;
             \\
             \\extern const dsl_shader_entry_t dsl_shader_registry[];
@@ -259,6 +280,7 @@ fn collectDslFilesRecursive(
                 .has_audio = program.audio_statements.len > 0,
                 .phasor_count = dsl_c_emitter.countPhasorCalls(program.audio_statements),
                 .target_fps = program.target_fps orelse 0,
+                .param_count = program.params.len,
             });
         }
     }
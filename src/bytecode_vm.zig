@@ -0,0 +1,617 @@
+const std = @import("std");
+const sdf_common = @import("sdf_common.zig");
+
+/// Raw bindings to the ESP32 firmware bytecode VM (`esp32_firmware/main/fw_bytecode_vm.c`),
+/// compiled for the host with the `esp32_firmware/host` shims.
+pub const c = @cImport({
+    @cInclude("fw_bytecode_vm.h");
+});
+
+pub const Error = error{
+    BytecodeLoadFailed,
+    BytecodeInitFailed,
+    BytecodeFrameFailed,
+    BytecodePixelFailed,
+    BytecodeRowFailed,
+    BytecodeParamFailed,
+};
+
+/// Pixels evaluated per call of the firmware's row-batched path.
+pub const row_lanes: usize = c.FW_BC3_ROW_LANES;
+
+/// Number of superinstruction kinds the firmware decoder can form (`fw_bc3_fusion_kind_t`).
+pub const fusion_kind_count: usize = @intCast(c.FW_BC3_FUSION_COUNT);
+
+/// Rates at which the loader can hoist layer lets: `fw_bc3_rate_t` frame and row.
+pub const hoist_rate_count: usize = @intCast(c.FW_BC3_RATE_PIXEL);
+
+const arena_alignment: std.mem.Alignment = .@"4";
+
+/// Owns one firmware program slot plus its runtime state.
+/// The program keeps pointers into the blob and into its table arena, and the runtime into its own
+/// program-sized arena, so all three are owned here.
+pub const Machine = struct {
+    allocator: std.mem.Allocator,
+    width: u16,
+    height: u16,
+    blob: []const u8 = &.{},
+    arena: []align(arena_alignment.toByteUnits()) u8 = &.{},
+    runtime_arena: []align(arena_alignment.toByteUnits()) u8 = &.{},
+    program: *c.fw_bc3_program_t,
+    runtime: *c.fw_bc3_runtime_t,
+    last_status: c.fw_bc3_status_t = c.FW_BC3_OK,
+
+    pub fn init(allocator: std.mem.Allocator, width: u16, height: u16) !Machine {
+        const program = try allocator.create(c.fw_bc3_program_t);
+        errdefer allocator.destroy(program);
+        const runtime = try allocator.create(c.fw_bc3_runtime_t);
+        return .{
+            .allocator = allocator,
+            .width = width,
+            .height = height,
+            .program = program,
+            .runtime = runtime,
+        };
+    }
+
+    pub fn deinit(self: *Machine) void {
+        self.allocator.destroy(self.runtime);
+        self.allocator.destroy(self.program);
+        self.allocator.free(self.runtime_arena);
+        self.allocator.free(self.arena);
+        self.allocator.free(self.blob);
+    }
+
+    /// Load and validate a DSLB blob, replacing any previously loaded program.
+    pub fn load(self: *Machine, blob: []const u8) !void {
+        const owned_blob = try self.allocator.dupe(u8, blob);
+        self.allocator.free(self.blob);
+        self.blob = owned_blob;
+
+        var arena_len: usize = 0;
+        self.last_status = c.fw_bc3_program_arena_size(owned_blob.ptr, owned_blob.len, &arena_len);
+        if (self.last_status != c.FW_BC3_OK) return error.BytecodeLoadFailed;
+        const arena = try self.allocator.alignedAlloc(u8, arena_alignment, arena_len);
+        self.allocator.free(self.arena);
+        self.arena = arena;
+
+        self.last_status = c.fw_bc3_program_load(self.program, owned_blob.ptr, owned_blob.len, arena.ptr, arena.len);
+        if (self.last_status != c.FW_BC3_OK) return error.BytecodeLoadFailed;
+
+        // The counting pass only bounds the tables; keep just the bytes the decoded program uses.
+        const used = self.program.arena_used;
+        if (used < arena.len) {
+            const exact = try self.allocator.alignedAlloc(u8, arena_alignment, used);
+            c.fw_bc3_program_relocate(self.program, exact.ptr);
+            self.allocator.free(self.arena);
+            self.arena = exact;
+        }
+
+        var runtime_arena_len: usize = 0;
+        _ = c.fw_bc3_runtime_arena_size(self.program, &runtime_arena_len);
+        const runtime_arena = try self.allocator.alignedAlloc(u8, arena_alignment, runtime_arena_len);
+        self.allocator.free(self.runtime_arena);
+        self.runtime_arena = runtime_arena;
+    }
+
+    /// (Re)initialize the runtime for the loaded program, as the firmware does on activation.
+    pub fn start(self: *Machine, seed: f32) Error!void {
+        self.last_status = c.fw_bc3_runtime_init(
+            self.runtime,
+            self.program,
+            self.width,
+            self.height,
+            self.runtime_arena.ptr,
+            self.runtime_arena.len,
+        );
+        if (self.last_status != c.FW_BC3_OK) return error.BytecodeInitFailed;
+        self.runtime.seed = seed;
+    }
+
+    /// Pin a param that depends on neither x nor y to `value` until the next `start`, as SET_PARAMS does.
+    pub fn setParam(self: *Machine, index: u16, value: f32) Error!void {
+        self.last_status = c.fw_bc3_runtime_set_param(self.runtime, index, value);
+        if (self.last_status != c.FW_BC3_OK) return error.BytecodeParamFailed;
+    }
+
+    pub fn paramCount(self: *const Machine) usize {
+        return self.program.param_count;
+    }
+
+    /// Whether `setParam` accepts `index`: it names a loaded param with no x/y dependency.
+    pub fn paramSettable(self: *const Machine, index: usize) bool {
+        return index < self.program.param_count and self.program.param_depends_xy[index] == 0;
+    }
+
+    pub fn beginFrame(self: *Machine, time_seconds: f32, frame_counter: u32) Error!void {
+        self.last_status = c.fw_bc3_runtime_begin_frame(self.runtime, time_seconds, frame_counter);
+        if (self.last_status != c.FW_BC3_OK) return error.BytecodeFrameFailed;
+    }
+
+    pub fn evalPixel(self: *Machine, x: f32, y: f32) Error!sdf_common.ColorRgba {
+        var color: c.fw_bc3_color_t = .{ .r = 0.0, .g = 0.0, .b = 0.0, .a = 1.0 };
+        self.last_status = c.fw_bc3_runtime_eval_pixel(self.runtime, x, y, &color);
+        if (self.last_status != c.FW_BC3_OK) return error.BytecodePixelFailed;
+        return .{ .r = color.r, .g = color.g, .b = color.b, .a = color.a };
+    }
+
+    /// Evaluate pixels `x0 .. x0 + out.len` of row `y` through `fw_bc3_runtime_eval_row`.
+    pub fn evalRow(self: *Machine, y: f32, x0: u16, out: []c.fw_bc3_color_t) Error!void {
+        self.last_status = c.fw_bc3_runtime_eval_row(self.runtime, y, x0, @intCast(out.len), out.ptr);
+        if (self.last_status != c.FW_BC3_OK) return error.BytecodeRowFailed;
+    }
+
+    /// RAM the loaded program occupies on the firmware: the fixed program struct plus its table arena.
+    pub fn programBytes(self: *const Machine) usize {
+        return @sizeOf(c.fw_bc3_program_t) + self.program.arena_used;
+    }
+
+    /// RAM the runtime for the loaded program occupies: the fixed runtime struct plus its arena.
+    pub fn runtimeBytes(self: *const Machine) usize {
+        return @sizeOf(c.fw_bc3_runtime_t) + self.runtime_arena.len;
+    }
+
+    pub fn decodedOpCount(self: *const Machine) usize {
+        return self.program.decoded_op_count;
+    }
+
+    /// Whether the loader lowered the program to the register form used by `evalRow`;
+    /// programs without one are rendered per pixel.
+    pub fn hasRegisterForm(self: *const Machine) bool {
+        return self.program.has_register_form != 0;
+    }
+
+    pub fn registerOpCount(self: *const Machine) usize {
+        return self.program.register_op_count;
+    }
+
+    /// Rows of the register file the runtime arena holds (FW_BC3_ROW_LANES floats each); 0 without a register form.
+    pub fn registerCount(self: *const Machine) usize {
+        return if (self.hasRegisterForm()) self.program.register_count else 0;
+    }
+
+    /// How often each superinstruction kind occurs in the decoded program, indexed by `fw_bc3_fusion_kind_t`.
+    pub fn fusionCounts(self: *const Machine) [fusion_kind_count]usize {
+        var counts: [fusion_kind_count]usize = undefined;
+        for (&counts, self.program.fusion_counts) |*count, raw| {
+            count.* = raw;
+        }
+        return counts;
+    }
+
+    /// Decoded ops saved by fusion, i.e. how many fewer dispatches each evaluation performs.
+    pub fn fusionRemovedOpCount(self: *const Machine) usize {
+        return self.program.fusion_removed_op_count;
+    }
+
+    /// Layer lets evaluated once per frame or row instead of per pixel, indexed by `fw_bc3_rate_t`.
+    pub fn hoistedLetCounts(self: *const Machine) [hoist_rate_count]usize {
+        var counts: [hoist_rate_count]usize = undefined;
+        for (&counts, self.program.hoisted_let_count) |*count, raw| {
+            count.* = raw;
+        }
+        return counts;
+    }
+
+    /// Hoisted let values the runtime arena caches: one per hoisted let, times the trips of enclosing loops.
+    pub fn hoistedValueCount(self: *const Machine) usize {
+        return self.program.hoisted_value_count;
+    }
+
+    pub fn pixelDependsOnXY(self: *const Machine) bool {
+        return self.program.pixel_depends_xy != 0;
+    }
+
+    pub fn lastStatusName(self: *const Machine) []const u8 {
+        return statusName(self.last_status);
+    }
+};
+
+pub fn statusName(status: c.fw_bc3_status_t) []const u8 {
+    return std.mem.span(c.fw_bc3_status_to_string(status));
+}
+
+pub fn fusionKindName(kind: usize) []const u8 {
+    return std.mem.span(c.fw_bc3_fusion_kind_to_string(@intCast(kind)));
+}
+
+test "Machine loads evaluator bytecode and matches reference pixels" {
+    const dsl_parser = @import("dsl_parser.zig");
+    const dsl_runtime = @import("dsl_runtime.zig");
+
+    const source =
+        \\effect vm_parity
+        \\param speed = 0.5
+        \\frame {
+        \\  let t = time * speed
+        \\}
+        \\layer base {
+        \\  let glow = smoothstep(0.0, height, y) * (0.5 + 0.5 * sin(t + x))
+        \\  blend rgba(glow, 0.2, 1.0 - glow, 0.8)
+        \\}
+        \\emit
+    ;
+
+    var arena = std.heap.ArenaAllocator.init(std.testing.allocator);
+    defer arena.deinit();
+
+    const program = try dsl_parser.parseAndValidate(arena.allocator(), source);
+    var evaluator = try dsl_runtime.Evaluator.init(std.testing.allocator, program);
+    defer evaluator.deinit();
+
+    var blob = std.ArrayList(u8).empty;
+    defer blob.deinit(std.testing.allocator);
+    try evaluator.writeBytecodeBinary(blob.writer(std.testing.allocator));
+
+    var machine = try Machine.init(std.testing.allocator, 30, 40);
+    defer machine.deinit();
+    try machine.load(blob.items);
+    try machine.start(evaluator.seed);
+    try std.testing.expect(machine.decodedOpCount() > 0);
+    try std.testing.expect(machine.pixelDependsOnXY());
+
+    const time: f32 = 1.25;
+    try machine.beginFrame(time, 3);
+    const probes = [_][2]f32{ .{ 0.0, 0.0 }, .{ 7.0, 13.0 }, .{ 29.0, 39.0 } };
+    for (probes) |probe| {
+        const expected = try evaluator.evaluatePixel(.{
+            .time = time,
+            .frame = 3.0,
+            .x = probe[0],
+            .y = probe[1],
+            .width = 30.0,
+            .height = 40.0,
+            .seed = evaluator.seed,
+        });
+        const actual = try machine.evalPixel(probe[0], probe[1]);
+        // The firmware uses fast sin/sqrt approximations, so allow a small tolerance.
+        try std.testing.expectApproxEqAbs(expected.r, actual.r, 0.01);
+        try std.testing.expectApproxEqAbs(expected.g, actual.g, 0.01);
+        try std.testing.expectApproxEqAbs(expected.b, actual.b, 0.01);
+    }
+}
+
+test "Machine row evaluation is bit-identical to per-pixel evaluation" {
+    const dsl_parser = @import("dsl_parser.zig");
+    const dsl_runtime = @import("dsl_runtime.zig");
+
+    const source =
+        \\effect vm_rows
+        \\param wobble = sin(x * 0.3 + time)
+        \\layer base {
+        \\  for i in 0..3 {
+        \\    let d = abs(x - 10.0 * i - wobble)
+        \\    if d - 2.0 {
+        \\      blend rgba(0.1 * i, 0.0, 0.5, 0.5)
+        \\    } else {
+        \\      let c = circle(vec2(d, y - 20.0), 4.0)
+        \\      blend rgba(smoothstep(1.0, 0.0, c), hash01(i + y), 0.0, 1.0)
+        \\    }
+        \\  }
+        \\}
+        \\emit
+    ;
+
+    var arena = std.heap.ArenaAllocator.init(std.testing.allocator);
+    defer arena.deinit();
+
+    const program = try dsl_parser.parseAndValidate(arena.allocator(), source);
+    var evaluator = try dsl_runtime.Evaluator.init(std.testing.allocator, program);
+    defer evaluator.deinit();
+
+    var blob = std.ArrayList(u8).empty;
+    defer blob.deinit(std.testing.allocator);
+    try evaluator.writeBytecodeBinary(blob.writer(std.testing.allocator));
+
+    var machine = try Machine.init(std.testing.allocator, 30, 40);
+    defer machine.deinit();
+    try machine.load(blob.items);
+    try machine.start(evaluator.seed);
+    try std.testing.expect(machine.hasRegisterForm());
+    try machine.beginFrame(0.75, 2);
+
+    var row: [30]c.fw_bc3_color_t = undefined;
+    var y: u16 = 0;
+    while (y < 40) : (y += 1) {
+        try machine.evalRow(@floatFromInt(y), 0, &row);
+        for (row, 0..) |actual, x| {
+            const expected = try machine.evalPixel(@floatFromInt(x), @floatFromInt(y));
+            try std.testing.expectEqual(expected.r, actual.r);
+            try std.testing.expectEqual(expected.g, actual.g);
+            try std.testing.expectEqual(expected.b, actual.b);
+            try std.testing.expectEqual(expected.a, actual.a);
+        }
+    }
+}
+
+test "Machine runs the statements that follow a nested block" {
+    const dsl_parser = @import("dsl_parser.zig");
+    const dsl_runtime = @import("dsl_runtime.zig");
+
+    // The trailing blend must stay in the layer's statement range rather than the if body's.
+    const source =
+        \\effect vm_blocks
+        \\layer base {
+        \\  if x - 1.0 {
+        \\    blend rgba(0.0, 1.0, 0.0, 1.0)
+        \\  }
+        \\  blend rgba(1.0, 0.0, 0.0, 0.5)
+        \\}
+        \\emit
+    ;
+
+    var arena = std.heap.ArenaAllocator.init(std.testing.allocator);
+    defer arena.deinit();
+
+    const program = try dsl_parser.parseAndValidate(arena.allocator(), source);
+    var evaluator = try dsl_runtime.Evaluator.init(std.testing.allocator, program);
+    defer evaluator.deinit();
+
+    var blob = std.ArrayList(u8).empty;
+    defer blob.deinit(std.testing.allocator);
+    try evaluator.writeBytecodeBinary(blob.writer(std.testing.allocator));
+
+    var machine = try Machine.init(std.testing.allocator, 4, 1);
+    defer machine.deinit();
+    try machine.load(blob.items);
+    try machine.start(evaluator.seed);
+    try machine.beginFrame(0.0, 0);
+
+    var row: [4]c.fw_bc3_color_t = undefined;
+    try machine.evalRow(0.0, 0, &row);
+    const expected_green = [_]f32{ 0.0, 0.0, 0.5, 0.5 };
+    for (row, expected_green, 0..) |actual, green, x| {
+        const pixel = try machine.evalPixel(@floatFromInt(x), 0.0);
+        try std.testing.expectApproxEqAbs(@as(f32, 0.5), pixel.r, 1e-6);
+        try std.testing.expectApproxEqAbs(green, pixel.g, 1e-6);
+        try std.testing.expectApproxEqAbs(@as(f32, 0.5), actual.r, 1e-6);
+        try std.testing.expectApproxEqAbs(green, actual.g, 1e-6);
+    }
+}
+
+test "Machine keeps set params across frames until the next start" {
+    const dsl_parser = @import("dsl_parser.zig");
+    const dsl_runtime = @import("dsl_runtime.zig");
+
+    const source =
+        \\effect vm_params
+        \\param level = 0.25
+        \\param wobble = sin(x * 0.3 + time)
+        \\layer base {
+        \\  blend rgba(level, 0.5 + 0.5 * wobble, y / height, 1.0)
+        \\}
+        \\emit
+    ;
+
+    var arena = std.heap.ArenaAllocator.init(std.testing.allocator);
+    defer arena.deinit();
+
+    const program = try dsl_parser.parseAndValidate(arena.allocator(), source);
+    var evaluator = try dsl_runtime.Evaluator.init(std.testing.allocator, program);
+    defer evaluator.deinit();
+
+    var blob = std.ArrayList(u8).empty;
+    defer blob.deinit(std.testing.allocator);
+    try evaluator.writeBytecodeBinary(blob.writer(std.testing.allocator));
+
+    var machine = try Machine.init(std.testing.allocator, 30, 40);
+    defer machine.deinit();
+    try machine.load(blob.items);
+    try machine.start(evaluator.seed);
+    try std.testing.expectEqual(@as(usize, 2), machine.paramCount());
+    try std.testing.expect(machine.paramSettable(0));
+    try std.testing.expect(!machine.paramSettable(1));
+
+    try machine.setParam(0, 0.75);
+    try std.testing.expectError(error.BytecodeParamFailed, machine.setParam(1, 0.0));
+    try std.testing.expectEqualStrings("invalid_slot", machine.lastStatusName());
+    try std.testing.expectError(error.BytecodeParamFailed, machine.setParam(2, 0.0));
+
+    var row: [30]c.fw_bc3_color_t = undefined;
+    for (0..3) |frame| {
+        try machine.beginFrame(@floatFromInt(frame), @intCast(frame));
+        try std.testing.expectApproxEqAbs(@as(f32, 0.75), (try machine.evalPixel(4.0, 5.0)).r, 1e-6);
+        try machine.evalRow(5.0, 0, &row);
+        try std.testing.expectApproxEqAbs(@as(f32, 0.75), row[4].r, 1e-6);
+    }
+
+    try machine.start(evaluator.seed);
+    try machine.beginFrame(0.0, 0);
+    try std.testing.expectApproxEqAbs(@as(f32, 0.25), (try machine.evalPixel(4.0, 5.0)).r, 1e-6);
+}
+
+test "Machine fuses literal arithmetic into superinstructions" {
+    const dsl_parser = @import("dsl_parser.zig");
+    const dsl_runtime = @import("dsl_runtime.zig");
+
+    const source =
+        \\effect vm_fusion
+        \\layer base {
+        \\  let wave = 0.5 + 0.5 * sin(x * 0.3 + 2.0)
+        \\  let fade = 1.0 - smoothstep(0.0, 40.0, y)
+        \\  blend rgba(wave * fade, y * 0.02 - 0.1, 0.25, 1.0)
+        \\}
+        \\emit
+    ;
+
+    var arena = std.heap.ArenaAllocator.init(std.testing.allocator);
+    defer arena.deinit();
+
+    const program = try dsl_parser.parseAndValidate(arena.allocator(), source);
+    var evaluator = try dsl_runtime.Evaluator.init(std.testing.allocator, program);
+    defer evaluator.deinit();
+
+    var blob = std.ArrayList(u8).empty;
+    defer blob.deinit(std.testing.allocator);
+    try evaluator.writeBytecodeBinary(blob.writer(std.testing.allocator));
+
+    var machine = try Machine.init(std.testing.allocator, 30, 40);
+    defer machine.deinit();
+    try machine.load(blob.items);
+    try machine.start(evaluator.seed);
+
+    const counts = machine.fusionCounts();
+    try std.testing.expectEqual(@as(usize, 1), counts[c.FW_BC3_FUSION_SIN_AFFINE]);
+    try std.testing.expectEqual(@as(usize, 2), counts[c.FW_BC3_FUSION_FMA_LIT]);
+    try std.testing.expectEqual(@as(usize, 1), counts[c.FW_BC3_FUSION_RSUB_LIT]);
+    try std.testing.expect(machine.fusionRemovedOpCount() > 0);
+    try std.testing.expectEqualStrings("sin_affine", fusionKindName(c.FW_BC3_FUSION_SIN_AFFINE));
+
+    const time: f32 = 0.5;
+    try machine.beginFrame(time, 1);
+    const probes = [_][2]f32{ .{ 0.0, 0.0 }, .{ 11.0, 17.0 }, .{ 29.0, 39.0 } };
+    for (probes) |probe| {
+        const expected = try evaluator.evaluatePixel(.{
+            .time = time,
+            .frame = 1.0,
+            .x = probe[0],
+            .y = probe[1],
+            .width = 30.0,
+            .height = 40.0,
+            .seed = evaluator.seed,
+        });
+        const actual = try machine.evalPixel(probe[0], probe[1]);
+        try std.testing.expectApproxEqAbs(expected.r, actual.r, 0.01);
+        try std.testing.expectApproxEqAbs(expected.g, actual.g, 0.01);
+        try std.testing.expectApproxEqAbs(expected.b, actual.b, 0.01);
+    }
+}
+
+test "Machine hoists frame- and row-invariant lets out of the pixel loop" {
+    const dsl_parser = @import("dsl_parser.zig");
+    const dsl_runtime = @import("dsl_runtime.zig");
+
+    const source =
+        \\effect vm_hoist
+        \\layer base {
+        \\  let sway = sin(time * 0.7) * 5.0
+        \\  let band = smoothstep(0.0, height, y + sway)
+        \\  for i in 0..4 {
+        \\    let cx = hash01(i * 3.0 + 1.0) * width + sway
+        \\    let d = abs(wrapdx(x, cx, width))
+        \\    blend rgba(band, 1.0 - smoothstep(0.0, 3.0, d), 0.2, 0.5)
+        \\  }
+        \\}
+        \\emit
+    ;
+
+    var arena = std.heap.ArenaAllocator.init(std.testing.allocator);
+    defer arena.deinit();
+
+    const program = try dsl_parser.parseAndValidate(arena.allocator(), source);
+    var evaluator = try dsl_runtime.Evaluator.init(std.testing.allocator, program);
+    defer evaluator.deinit();
+
+    var blob = std.ArrayList(u8).empty;
+    defer blob.deinit(std.testing.allocator);
+    try evaluator.writeBytecodeBinary(blob.writer(std.testing.allocator));
+
+    var machine = try Machine.init(std.testing.allocator, 30, 40);
+    defer machine.deinit();
+    try machine.load(blob.items);
+    try machine.start(evaluator.seed);
+
+    // `sway` and `cx` (once per loop iteration) are frame-invariant, `band` only changes per row.
+    const hoisted = machine.hoistedLetCounts();
+    try std.testing.expectEqual(@as(usize, 2), hoisted[c.FW_BC3_RATE_FRAME]);
+    try std.testing.expectEqual(@as(usize, 1), hoisted[c.FW_BC3_RATE_ROW]);
+    // `sway`, `band` and four `cx`, one per iteration.
+    try std.testing.expectEqual(@as(usize, 6), machine.hoistedValueCount());
+
+    const time: f32 = 2.5;
+    try machine.beginFrame(time, 4);
+    var row: [30]c.fw_bc3_color_t = undefined;
+    var y: u16 = 0;
+    while (y < 40) : (y += 1) {
+        try machine.evalRow(@floatFromInt(y), 0, &row);
+        for (row, 0..) |actual, x| {
+            const pixel = try machine.evalPixel(@floatFromInt(x), @floatFromInt(y));
+            try std.testing.expectEqual(pixel.r, actual.r);
+            try std.testing.expectEqual(pixel.g, actual.g);
+            try std.testing.expectEqual(pixel.b, actual.b);
+
+            const expected = try evaluator.evaluatePixel(.{
+                .time = time,
+                .frame = 4.0,
+                .x = @floatFromInt(x),
+                .y = @floatFromInt(y),
+                .width = 30.0,
+                .height = 40.0,
+                .seed = evaluator.seed,
+            });
+            try std.testing.expectApproxEqAbs(expected.r, pixel.r, 0.01);
+            try std.testing.expectApproxEqAbs(expected.g, pixel.g, 0.01);
+        }
+    }
+}
+
+test "Machine keeps only the arena bytes the decoded program uses" {
+    const dsl_parser = @import("dsl_parser.zig");
+    const dsl_runtime = @import("dsl_runtime.zig");
+
+    const source =
+        \\effect vm_arena
+        \\param speed = 0.5
+        \\layer base {
+        \\  let wave = 0.5 + 0.5 * sin(x * 0.3 + time * speed)
+        \\  for i in 0..2 {
+        \\    blend rgba(wave, 0.1 * i, 0.5, wave * 0.8)
+        \\  }
+        \\}
+        \\emit
+    ;
+
+    var arena = std.heap.ArenaAllocator.init(std.testing.allocator);
+    defer arena.deinit();
+
+    const program = try dsl_parser.parseAndValidate(arena.allocator(), source);
+    var evaluator = try dsl_runtime.Evaluator.init(std.testing.allocator, program);
+    defer evaluator.deinit();
+
+    var blob = std.ArrayList(u8).empty;
+    defer blob.deinit(std.testing.allocator);
+    try evaluator.writeBytecodeBinary(blob.writer(std.testing.allocator));
+
+    var bound: usize = 0;
+    try std.testing.expect(c.fw_bc3_program_arena_size(blob.items.ptr, blob.items.len, &bound) == c.FW_BC3_OK);
+
+    var machine = try Machine.init(std.testing.allocator, 30, 40);
+    defer machine.deinit();
+    try machine.load(blob.items);
+    try machine.start(evaluator.seed);
+
+    // The loaded tables are compacted to their counts and then moved into an exact-size arena.
+    try std.testing.expectEqual(machine.arena.len, machine.program.arena_used);
+    try std.testing.expect(machine.arena.len <= bound);
+    try std.testing.expectEqual(machine.program.expr_count, machine.program.expr_capacity);
+    try std.testing.expectEqual(machine.program.decoded_op_count, machine.program.decoded_op_capacity);
+    try std.testing.expectEqual(machine.program.register_op_count, machine.program.register_op_capacity);
+    try std.testing.expect(machine.hasRegisterForm());
+    try std.testing.expect(machine.programBytes() < 4096);
+
+    try machine.beginFrame(0.75, 2);
+    var row: [30]c.fw_bc3_color_t = undefined;
+    try machine.evalRow(7.0, 0, &row);
+    for (row, 0..) |actual, x| {
+        const expected = try evaluator.evaluatePixel(.{
+            .time = 0.75,
+            .frame = 2.0,
+            .x = @floatFromInt(x),
+            .y = 7.0,
+            .width = 30.0,
+            .height = 40.0,
+            .seed = evaluator.seed,
+        });
+        try std.testing.expectApproxEqAbs(expected.r, actual.r, 0.01);
+        try std.testing.expectApproxEqAbs(expected.g, actual.g, 0.01);
+        try std.testing.expectApproxEqAbs(expected.b, actual.b, 0.01);
+    }
+}
+
+test "Machine reports load failures with firmware status names" {
+    const garbage = [_]u8{ 'N', 'O', 'P', 'E', 3, 0, 0, 0 };
+    var machine = try Machine.init(std.testing.allocator, 30, 40);
+    defer machine.deinit();
+    try std.testing.expectError(error.BytecodeLoadFailed, machine.load(&garbage));
+    try std.testing.expectEqualStrings("bad_magic", machine.lastStatusName());
+}
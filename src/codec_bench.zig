@@ -0,0 +1,220 @@
+const std = @import("std");
+const dsl_parser = @import("dsl_parser.zig");
+const dsl_runtime = @import("dsl_runtime.zig");
+const display_logic = @import("display_logic.zig");
+const frame_codec = @import("frame_codec.zig");
+const vm_bench = @import("vm_bench.zig");
+
+pub const Options = struct {
+    width: u16 = 30,
+    height: u16 = 40,
+    /// Frames encoded after the first one, which only seeds the reference.
+    frames: u32 = 200,
+    frame_rate_hz: f32 = 40.0,
+    /// Fixed so byte counts of shaders that use `seed` are the same on every run.
+    seed: f32 = 0.5,
+};
+
+const encoding_count = 3;
+
+pub const ShaderResult = struct {
+    status: []const u8,
+    raw_bytes: usize = 0,
+    /// Mean body bytes per frame of each delta encoding on its own.
+    xor_rle_bytes: f64 = 0.0,
+    spans_bytes: f64 = 0.0,
+    /// Mean payload bytes per frame as the client sends it: prefix plus the smallest encoding.
+    best_bytes: f64 = 0.0,
+    /// How often each encoding was the smallest, indexed by `frame_codec.Encoding`.
+    encodings: [encoding_count]u32 = @splat(0),
+    encode_ns: u64 = 0,
+    decode_ns: u64 = 0,
+};
+
+/// Render `options.frames + 1` frames with the DSL evaluator into RGB payloads in physical LED order, as
+/// `dsl-file` streams them, and encode each against the previous one like `TcpClient.sendFrame`.
+/// `encode_ns` times the encoder choosing the smallest encoding, `decode_ns` the firmware decoder.
+pub fn benchmarkEvaluator(allocator: std.mem.Allocator, evaluator: *dsl_runtime.Evaluator, options: Options) !ShaderResult {
+    var display = try display_logic.DisplayBuffer.init(allocator, .{
+        .width = options.width,
+        .height = options.height,
+        .pixel_format = .rgb,
+    });
+    defer display.deinit();
+    const colors = try allocator.alloc(display_logic.Color, display.pixel_count);
+    defer allocator.free(colors);
+
+    const frame_len = display.payload().len;
+    const bytes_per_pixel = display.bytes_per_pixel;
+    const previous = try allocator.alloc(u8, frame_len);
+    defer allocator.free(previous);
+    const reference = try allocator.alloc(u8, frame_len);
+    defer allocator.free(reference);
+    const scratch = try allocator.alloc(u8, frame_len);
+    defer allocator.free(scratch);
+    // Twice the frame is more than either encoding can produce, so sizes are measured even past raw.
+    const out = try allocator.alloc(u8, 2 * frame_len);
+    defer allocator.free(out);
+
+    evaluator.seed = options.seed;
+    try renderPayload(evaluator, &display, colors, 0, options);
+    @memcpy(previous, display.payload());
+    @memcpy(reference, previous);
+
+    var result = ShaderResult{ .status = "ok", .raw_bytes = frame_len };
+    var xor_rle_total: u64 = 0;
+    var spans_total: u64 = 0;
+    var best_total: u64 = 0;
+    var encode_ns: u64 = 0;
+    var decode_ns: u64 = 0;
+    var frame: u32 = 1;
+    while (frame <= options.frames) : (frame += 1) {
+        try renderPayload(evaluator, &display, colors, frame, options);
+        const current = display.payload();
+        xor_rle_total += frame_codec.encodeXorRle(previous, current, out).?;
+        spans_total += frame_codec.encodeSpans(previous, current, bytes_per_pixel, out).?;
+
+        var timer = try std.time.Timer.start();
+        const encoded = frame_codec.encodeFrame(previous, current, bytes_per_pixel, out, scratch);
+        encode_ns += timer.lap();
+        try frame_codec.decode(encoded.encoding, out[0..encoded.len], reference, bytes_per_pixel);
+        decode_ns += timer.read();
+        if (!std.mem.eql(u8, reference, current)) return .{ .status = "decode_mismatch", .raw_bytes = frame_len };
+
+        result.encodings[@intFromEnum(encoded.encoding)] += 1;
+        best_total += frame_codec.prefix_len + encoded.len;
+        @memcpy(previous, current);
+    }
+
+    if (options.frames > 0) {
+        const frames_f: f64 = @floatFromInt(options.frames);
+        result.xor_rle_bytes = @as(f64, @floatFromInt(xor_rle_total)) / frames_f;
+        result.spans_bytes = @as(f64, @floatFromInt(spans_total)) / frames_f;
+        result.best_bytes = @as(f64, @floatFromInt(best_total)) / frames_f;
+        result.encode_ns = encode_ns / options.frames;
+        result.decode_ns = decode_ns / options.frames;
+    }
+    return result;
+}
+
+fn renderPayload(
+    evaluator: *dsl_runtime.Evaluator,
+    display: *display_logic.DisplayBuffer,
+    colors: []display_logic.Color,
+    frame_number: u32,
+    options: Options,
+) !void {
+    try evaluator.renderFrame(display, colors, frame_number, options.frame_rate_hz);
+    var encoded: [4]u8 = undefined;
+    var y: u16 = 0;
+    while (y < display.height) : (y += 1) {
+        var x: u16 = 0;
+        while (x < display.width) : (x += 1) {
+            const idx = (@as(usize, y) * @as(usize, display.width)) + @as(usize, x);
+            const pixel = display_logic.encodeColor(display.pixel_format, colors[idx], &encoded);
+            try display.setPixel(@as(i32, @intCast(x)), y, pixel);
+        }
+    }
+}
+
+/// Render every `.dsl` file below `dsl_dir_path` with the DSL evaluator and write a JSON report of the
+/// encoded frame sizes and encode/decode times per shader.
+pub fn run(allocator: std.mem.Allocator, dsl_dir_path: []const u8, options: Options, writer: *std.Io.Writer) !void {
+    var arena = std.heap.ArenaAllocator.init(allocator);
+    defer arena.deinit();
+    const temp = arena.allocator();
+    const paths = try vm_bench.collectDslPaths(temp, dsl_dir_path);
+
+    try writer.print("{{\n  \"width\": {d},\n  \"height\": {d},\n  \"frames\": {d},\n  \"shaders\": [", .{ options.width, options.height, options.frames });
+    var raw_total: f64 = 0.0;
+    var best_total: f64 = 0.0;
+    for (paths, 0..) |rel_path, idx| {
+        const result = try benchmarkDslFile(allocator, temp, dsl_dir_path, rel_path, options);
+        if (std.mem.eql(u8, result.status, "ok")) {
+            raw_total += @floatFromInt(result.raw_bytes);
+            best_total += result.best_bytes;
+        }
+        try writer.writeAll(if (idx == 0) "\n" else ",\n");
+        try writer.print(
+            "    {{ \"name\": {f}, \"path\": {f}, \"status\": \"{s}\", \"raw_bytes\": {d}, \"xor_rle_bytes\": {d:.1}, \"spans_bytes\": {d:.1}, \"best_bytes\": {d:.1}, \"ratio\": {d:.3}, \"encodings\": {{ \"raw\": {d}, \"xor_rle\": {d}, \"spans\": {d} }}, \"encode_ns\": {d}, \"decode_ns\": {d} }}",
+            .{
+                std.json.fmt(std.fs.path.stem(rel_path), .{}),
+                std.json.fmt(rel_path, .{}),
+                result.status,
+                result.raw_bytes,
+                result.xor_rle_bytes,
+                result.spans_bytes,
+                result.best_bytes,
+                ratio(result.best_bytes, @floatFromInt(result.raw_bytes)),
+                result.encodings[@intFromEnum(frame_codec.Encoding.raw)],
+                result.encodings[@intFromEnum(frame_codec.Encoding.xor_rle)],
+                result.encodings[@intFromEnum(frame_codec.Encoding.spans)],
+                result.encode_ns,
+                result.decode_ns,
+            },
+        );
+    }
+    try writer.print("\n  ],\n  \"ratio\": {d:.3}\n}}\n", .{ratio(best_total, raw_total)});
+    try writer.flush();
+}
+
+fn ratio(encoded: f64, raw: f64) f64 {
+    return if (raw > 0.0) encoded / raw else 0.0;
+}
+
+fn benchmarkDslFile(
+    allocator: std.mem.Allocator,
+    temp: std.mem.Allocator,
+    dsl_dir_path: []const u8,
+    rel_path: []const u8,
+    options: Options,
+) !ShaderResult {
+    const full_path = try std.fs.path.join(temp, &.{ dsl_dir_path, rel_path });
+    const source = try std.fs.cwd().readFileAlloc(temp, full_path, std.math.maxInt(usize));
+    const program = dsl_parser.parseAndValidate(temp, source) catch |err| return .{ .status = @errorName(err) };
+    var evaluator = dsl_runtime.Evaluator.init(allocator, program) catch |err| return .{ .status = @errorName(err) };
+    defer evaluator.deinit();
+    return benchmarkEvaluator(allocator, &evaluator, options) catch |err| switch (err) {
+        error.OutOfMemory => return err,
+        else => return .{ .status = @errorName(err) },
+    };
+}
+
+fn benchmarkSource(source: []const u8, options: Options) !ShaderResult {
+    var arena = std.heap.ArenaAllocator.init(std.testing.allocator);
+    defer arena.deinit();
+    const program = try dsl_parser.parseAndValidate(arena.allocator(), source);
+    var evaluator = try dsl_runtime.Evaluator.init(std.testing.allocator, program);
+    defer evaluator.deinit();
+    return benchmarkEvaluator(std.testing.allocator, &evaluator, options);
+}
+
+test "benchmarkEvaluator sends empty deltas for a static shader" {
+    const result = try benchmarkSource(
+        \\effect codec_static
+        \\layer l {
+        \\  blend rgba(0.2, 0.4, 0.6, 1.0)
+        \\}
+        \\emit
+    , .{ .width = 6, .height = 8, .frames = 4 });
+    try std.testing.expectEqualStrings("ok", result.status);
+    try std.testing.expectEqual(@as(usize, 6 * 8 * 3), result.raw_bytes);
+    try std.testing.expectEqual(@as(f64, 0.0), result.xor_rle_bytes);
+    try std.testing.expectEqual(@as(f64, @floatFromInt(frame_codec.prefix_len)), result.best_bytes);
+    try std.testing.expectEqual(@as(u32, 0), result.encodings[@intFromEnum(frame_codec.Encoding.raw)]);
+}
+
+test "benchmarkEvaluator encodes a moving shader below raw size" {
+    // A bright band sweeping down a dark display: only the rows it enters and leaves change.
+    const result = try benchmarkSource(
+        \\effect codec_band
+        \\layer l {
+        \\  let v = clamp(1.0 - abs(y - time * 20.0), 0.0, 1.0)
+        \\  blend rgba(v, v, v, 1.0)
+        \\}
+        \\emit
+    , .{ .width = 6, .height = 40, .frames = 20 });
+    try std.testing.expectEqualStrings("ok", result.status);
+    try std.testing.expect(result.best_bytes < @as(f64, @floatFromInt(result.raw_bytes)) / 2.0);
+    try std.testing.expect(result.best_bytes <= @min(result.xor_rle_bytes, result.spans_bytes) + @as(f64, @floatFromInt(frame_codec.prefix_len)));
+}
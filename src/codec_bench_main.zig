@@ -0,0 +1,21 @@
+const std = @import("std");
+const led = @import("led_pillar_zig");
+
+pub fn main() !void {
+    var args = try std.process.argsWithAllocator(std.heap.page_allocator);
+    defer args.deinit();
+
+    _ = args.next(); // skip argv[0]
+    const dsl_dir = args.next() orelse "examples/dsl/v1";
+    var options = led.codec_bench.Options{
+        .width = led.display_width,
+        .height = led.display_height,
+    };
+    if (args.next()) |frames_arg| {
+        options.frames = try std.fmt.parseInt(u32, frames_arg, 10);
+    }
+
+    var stdout_buffer: [4096]u8 = undefined;
+    var stdout_writer = std.fs.File.stdout().writer(&stdout_buffer);
+    try led.codec_bench.run(std.heap.page_allocator, dsl_dir, options, &stdout_writer.interface);
+}
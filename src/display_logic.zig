@@ -10,10 +10,76 @@ pub const Color = struct {
 
 pub const StopFlag = std.atomic.Value(bool);
 
+/// One strip segment of the LED chain, in chain order (`fw_led_segment_config_t`).
+pub const LayoutSegment = struct {
+    led_count: u16,
+    /// Data enters at the far end, so the segment's LEDs are numbered backwards.
+    reversed: bool = false,
+};
+
+/// How the logical grid is wired, mirroring `fw_led_layout_config_t`: columns of `height`
+/// LEDs chained bottom-up (alternating when serpentine). The grid is mirrored/flipped first
+/// and then rotated around the pillar by `column_offset` columns.
+pub const Wiring = struct {
+    serpentine_columns: bool = true,
+    mirror_x: bool = false,
+    flip_y: bool = false,
+    column_offset: u16 = 0,
+    /// Empty means one forward segment covering every LED.
+    segments: []const LayoutSegment = &.{},
+};
+
+/// Fill `map[y * width + x]` with the physical (wire order) LED index of every logical pixel;
+/// the same table `fw_led_layout_map_init` builds on the firmware.
+pub fn fillLayoutMap(width: u16, height: u16, wiring: Wiring, map: []u16) !void {
+    if (width == 0 or height == 0) return error.InvalidDimensions;
+    const pixel_count = @as(u32, width) * @as(u32, height);
+    if (pixel_count > @as(u32, std.math.maxInt(u16)) + 1) return error.InvalidDimensions;
+    if (map.len != pixel_count) return error.InvalidMapLength;
+    if (wiring.segments.len > 0) {
+        var total: u32 = 0;
+        for (wiring.segments) |segment| total += segment.led_count;
+        if (total != pixel_count) return error.SegmentLengthMismatch;
+    }
+
+    var y: u16 = 0;
+    while (y < height) : (y += 1) {
+        var x: u16 = 0;
+        while (x < width) : (x += 1) {
+            var column: u32 = if (wiring.mirror_x) width - 1 - x else x;
+            column = (column + wiring.column_offset) % width;
+            var row: u32 = if (wiring.flip_y) height - 1 - y else y;
+            if (wiring.serpentine_columns and (column & 1) != 0) row = height - 1 - row;
+            const chain_index = column * height + row;
+            map[@as(usize, y) * width + x] = @intCast(wireIndex(wiring.segments, chain_index));
+        }
+    }
+}
+
+pub fn buildLayoutMap(allocator: std.mem.Allocator, width: u16, height: u16, wiring: Wiring) ![]u16 {
+    const map = try allocator.alloc(u16, @as(usize, width) * @as(usize, height));
+    errdefer allocator.free(map);
+    try fillLayoutMap(width, height, wiring, map);
+    return map;
+}
+
+fn wireIndex(segments: []const LayoutSegment, chain_index: u32) u32 {
+    var offset: u32 = 0;
+    for (segments) |segment| {
+        if (chain_index < offset + segment.led_count) {
+            const local = chain_index - offset;
+            return offset + (if (segment.reversed) segment.led_count - 1 - local else local);
+        }
+        offset += segment.led_count;
+    }
+    return chain_index;
+}
+
 pub const Config = struct {
     width: u16 = tcp_client.default_display_width,
     height: u16 = tcp_client.default_display_height,
     pixel_format: tcp_client.PixelFormat = .rgb,
+    wiring: Wiring = .{},
 };
 
 pub const DisplayBuffer = struct {
@@ -24,6 +90,8 @@ pub const DisplayBuffer = struct {
     bytes_per_pixel: usize,
     pixel_count: u32,
     buffer: []u8,
+    /// Logical `y * width + x` to physical LED index.
+    layout_map: []u16,
 
     pub fn init(allocator: std.mem.Allocator, config: Config) !DisplayBuffer {
         if (config.width == 0 or config.height == 0) return error.InvalidDimensions;
@@ -31,6 +99,8 @@ pub const DisplayBuffer = struct {
         const pixel_count = try std.math.mul(u32, @as(u32, config.width), @as(u32, config.height));
         const bytes_per_pixel = config.pixel_format.bytesPerPixel();
         const payload_len = try std.math.mul(usize, @as(usize, pixel_count), bytes_per_pixel);
+        const layout_map = try buildLayoutMap(allocator, config.width, config.height, config.wiring);
+        errdefer allocator.free(layout_map);
         const buffer = try allocator.alloc(u8, payload_len);
 
         return .{
@@ -41,11 +111,13 @@ pub const DisplayBuffer = struct {
             .bytes_per_pixel = bytes_per_pixel,
             .pixel_count = pixel_count,
             .buffer = buffer,
+            .layout_map = layout_map,
         };
     }
 
     pub fn deinit(self: *DisplayBuffer) void {
         self.allocator.free(self.buffer);
+        self.allocator.free(self.layout_map);
     }
 
     pub fn clear(self: *DisplayBuffer, value: u8) void {
@@ -62,11 +134,7 @@ pub const DisplayBuffer = struct {
 
     pub fn physicalPixelIndex(self: *const DisplayBuffer, x: i32, y: u16) !u32 {
         if (y >= self.height) return error.YOutOfBounds;
-
-        const column = self.wrapX(x);
-        const row = if ((column & 1) == 0) y else self.height - 1 - y;
-        const base = try std.math.mul(u32, @as(u32, column), @as(u32, self.height));
-        return base + @as(u32, row);
+        return self.layout_map[@as(usize, y) * self.width + self.wrapX(x)];
     }
 
     pub fn pixelOffset(self: *const DisplayBuffer, x: i32, y: u16) !usize {
@@ -243,3 +311,34 @@ test "init rejects invalid dimensions" {
         .width = 0,
     }));
 }
+
+test "fillLayoutMap matches the default serpentine wiring" {
+    var map: [3 * 4]u16 = undefined;
+    try fillLayoutMap(3, 4, .{}, &map);
+    // Row-major logical pixels; odd columns run top-down.
+    try std.testing.expectEqualSlices(u16, &.{ 0, 7, 8, 1, 6, 9, 2, 5, 10, 3, 4, 11 }, &map);
+}
+
+test "fillLayoutMap applies mirror, flip, column offset and reversed segments" {
+    const segments = [_]LayoutSegment{ .{ .led_count = 4 }, .{ .led_count = 8, .reversed = true } };
+    var map: [3 * 4]u16 = undefined;
+    try fillLayoutMap(3, 4, .{ .mirror_x = true, .flip_y = true, .column_offset = 4, .segments = &segments }, &map);
+
+    // x=0 mirrors to column 2, rotates to column 0; y=0 flips to row 3: chain 3 in the forward segment.
+    try std.testing.expectEqual(@as(u16, 3), map[0]);
+    // x=2 mirrors to column 0, rotates to column 1 (odd, so row 3 runs back to 0): chain 4,
+    // the first LED of the reversed segment, which is wired last.
+    try std.testing.expectEqual(@as(u16, 11), map[2]);
+
+    var seen = [_]bool{false} ** map.len;
+    for (map) |index| {
+        try std.testing.expect(!seen[index]);
+        seen[index] = true;
+    }
+}
+
+test "fillLayoutMap rejects segments that do not cover the grid" {
+    const segments = [_]LayoutSegment{.{ .led_count = 5 }};
+    var map: [2 * 2]u16 = undefined;
+    try std.testing.expectError(error.SegmentLengthMismatch, fillLayoutMap(2, 2, .{ .segments = &segments }, &map));
+}
@@ -41,6 +41,7 @@ const Scope = struct {
 pub fn writePreambleC(writer: anytype) !void {
     try writer.print(
         \\#include <math.h>
+        \\#include <stddef.h>
         \\#include <stdint.h>
         \\
         \\/* DSL_NOINLINE: defined by the ESP32 build to control inlining of
@@ -70,12 +71,43 @@ pub fn writePreambleC(writer: anytype) !void {
         \\    float a;
         \\}} dsl_color_t;
         \\
+        \\/* One DSL param of a shader; SET_PARAMS pins settable ones (no x/y dependency) to value. */
+        \\typedef struct {{
+        \\    const char *name;
+        \\    float value;
+        \\    uint8_t pinned;
+        \\    uint8_t settable;
+        \\}} dsl_shader_param_t;
+        \\
         \\static inline float dsl_clamp(float v, float lo, float hi) {{
         \\    if (v < lo) return lo;
         \\    if (v > hi) return hi;
         \\    return v;
         \\}}
         \\
+        \\static inline uint8_t dsl_channel_to_u8(float v) {{
+        \\    if (v <= 0.0f) return 0U;
+        \\    if (v >= 1.0f) return 255U;
+        \\    return (uint8_t)(v * 255.0f + 0.5f);
+        \\}}
+        \\
+        \\/* Quantize one pixel into its output bytes: RGB, or the LED wire format
+        \\ * (gamma-corrected GRB) when a gamma table is given. */
+        \\static inline void dsl_store_pixel(uint8_t *px, dsl_color_t c, const uint8_t *grb_gamma) {{
+        \\    const uint8_t r = dsl_channel_to_u8(c.r);
+        \\    const uint8_t g = dsl_channel_to_u8(c.g);
+        \\    const uint8_t b = dsl_channel_to_u8(c.b);
+        \\    if (grb_gamma != NULL) {{
+        \\        px[0] = grb_gamma[g];
+        \\        px[1] = grb_gamma[r];
+        \\        px[2] = grb_gamma[b];
+        \\        return;
+        \\    }}
+        \\    px[0] = r;
+        \\    px[1] = g;
+        \\    px[2] = b;
+        \\}}
+        \\
         \\static inline float dsl_fract(float v) {{
         \\    return v - floorf(v);
         \\}}
@@ -133,6 +165,15 @@ pub fn writePreambleC(writer: anytype) !void {
         \\    return sqrtf((outside.x * outside.x) + (outside.y * outside.y)) + inside;
         \\}}
         \\
+        \\/* Conservative footprint test for blend culling: false only when (px, py) lies at
+        \\ * least (rx, ry), plus a margin for SDF rounding, from the origin on either axis.
+        \\ * A macro so px is only evaluated for rows that pass the y test. */
+        \\#define DSL_NEAR_BOX(px, py, rx, ry) (fabsf(py) < (ry) + 0.01f && fabsf(px) < (rx) + 0.01f)
+        \\
+        \\static inline float dsl_reach_max(float a, float b) {{
+        \\    return (a > b) ? a : b;
+        \\}}
+        \\
         \\static DSL_NOINLINE dsl_color_t dsl_blend_over(dsl_color_t src, dsl_color_t dst) {{
         \\    const float src_a = dsl_clamp(src.a, 0.0f, 1.0f);
         \\    const float dst_a = dsl_clamp(dst.a, 0.0f, 1.0f);
@@ -150,6 +191,29 @@ pub fn writePreambleC(writer: anytype) !void {
         \\    }};
         \\}}
         \\
+        \\/* dsl_blend_over with dst.a == 1: out_a is then exactly 1, so the division
+        \\ * and the transparent-result branch drop out. */
+        \\static inline dsl_color_t dsl_blend_over_opaque(dsl_color_t src, dsl_color_t dst) {{
+        \\    const float src_a = dsl_clamp(src.a, 0.0f, 1.0f);
+        \\    const float one_minus_src_a = 1.0f - src_a;
+        \\    return (dsl_color_t){{
+        \\        .r = dsl_clamp((src.r * src_a) + (dst.r * one_minus_src_a), 0.0f, 1.0f),
+        \\        .g = dsl_clamp((src.g * src_a) + (dst.g * one_minus_src_a), 0.0f, 1.0f),
+        \\        .b = dsl_clamp((src.b * src_a) + (dst.b * one_minus_src_a), 0.0f, 1.0f),
+        \\        .a = 1.0f,
+        \\    }};
+        \\}}
+        \\
+        \\/* dsl_blend_over with src.a >= 1: the source simply replaces the destination. */
+        \\static inline dsl_color_t dsl_color_opaque(dsl_color_t src) {{
+        \\    return (dsl_color_t){{
+        \\        .r = dsl_clamp(src.r, 0.0f, 1.0f),
+        \\        .g = dsl_clamp(src.g, 0.0f, 1.0f),
+        \\        .b = dsl_clamp(src.b, 0.0f, 1.0f),
+        \\        .a = 1.0f,
+        \\    }};
+        \\}}
+        \\
         \\static const unsigned char dsl_perm[512] = {{
         \\    151,160,137,91,90,15,131,13,201,95,96,53,194,233,7,225,
         \\    140,36,103,30,69,142,8,99,37,240,21,10,23,190,6,148,
@@ -321,8 +385,65 @@ fn countPhasorCallsInExpr(expr: *const dsl_parser.Expr) usize {
     };
 }
 
+fn exprUsesNames(expr: *const dsl_parser.Expr, names: *const std.StringHashMap(void)) bool {
+    return switch (expr.*) {
+        .number => false,
+        .identifier => |name| names.contains(name),
+        .unary => |u| exprUsesNames(u.operand, names),
+        .binary => |b| exprUsesNames(b.left, names) or exprUsesNames(b.right, names),
+        .call => |c| blk: {
+            for (c.args) |arg| {
+                if (exprUsesNames(arg, names)) break :blk true;
+            }
+            break :blk false;
+        },
+    };
+}
+
+fn statementsUseNames(statements: []const dsl_parser.Statement, names: *const std.StringHashMap(void)) bool {
+    for (statements) |statement| {
+        const uses = switch (statement) {
+            .let_decl => |let_decl| exprUsesNames(let_decl.value, names),
+            .blend => |blend_expr| exprUsesNames(blend_expr, names),
+            .out => |out_expr| exprUsesNames(out_expr, names),
+            .if_stmt => |if_stmt| exprUsesNames(if_stmt.condition, names) or
+                statementsUseNames(if_stmt.then_statements, names) or
+                statementsUseNames(if_stmt.else_statements, names),
+            .for_range => |for_range| statementsUseNames(for_range.statements, names),
+        };
+        if (uses) return true;
+    }
+    return false;
+}
+
+fn exprOnlyUsesNames(expr: *const dsl_parser.Expr, names: *const std.StringHashMap(void)) bool {
+    return switch (expr.*) {
+        .number => true,
+        .identifier => |name| names.contains(name) or std.mem.eql(u8, name, "PI") or std.mem.eql(u8, name, "TAU"),
+        .unary => |u| exprOnlyUsesNames(u.operand, names),
+        .binary => |b| exprOnlyUsesNames(b.left, names) and exprOnlyUsesNames(b.right, names),
+        .call => |c| blk: {
+            for (c.args) |arg| {
+                if (!exprOnlyUsesNames(arg, names)) break :blk false;
+            }
+            break :blk true;
+        },
+    };
+}
+
 /// Emit shader functions with a prefix. When prefix is non-null, functions are
-/// marked `static` and named `{prefix}_eval_pixel` / `{prefix}_eval_frame`.
+/// marked `static` and named `{prefix}_prepare_frame` / `{prefix}_eval_pixel` /
+/// `{prefix}_render_rows` / `{prefix}_render_frame`.
+///
+/// Params and top-level frame statements that do not depend on x/y are evaluated
+/// once per frame by `prepare_frame` and stored in a `{prefix}_uniforms_t` struct;
+/// `eval_pixel` reads them from there instead of recomputing them per pixel.
+/// Lets inside layer-level `for` loops that depend only on the loop index and
+/// frame values are filled into per-iteration arrays of the same struct.
+/// `render_rows` runs the x/y loop itself over every `row_step`-th row starting
+/// at `row_first`, evaluating lets that do not depend on x once per row, and
+/// writes quantized RGB through a physical index map. It reads the uniforms, so
+/// `prepare_frame` must run first; `render_frame` does both for the whole frame.
 pub fn writeShaderFunctions(
     allocator: std.mem.Allocator,
     writer: anytype,
@@ -335,53 +456,20 @@ pub fn writeShaderFunctions(
 
     const is_prefixed = prefix != null;
     const static_kw: []const u8 = if (is_prefixed) "static " else "";
-
-    // Emit eval_frame if the program has frame statements
-    if (program.frame_statements.len > 0) {
-        const frame_fn_name = if (prefix) |p|
-            try std.fmt.allocPrint(temp_allocator, "{s}_eval_frame", .{p})
-        else
-            try std.fmt.allocPrint(temp_allocator, "dsl_shader_eval_frame", .{});
-
-        try writer.print(
-            \\/* Generated from effect: {s} */
-            \\{s}void {s}(float time, float frame) {{
-            \\
-        , .{ program.effect_name, static_kw, frame_fn_name });
-
-        var name_counter: usize = 0;
-        var frame_scope = Scope.init(temp_allocator, null);
-        defer frame_scope.deinit();
-        try frame_scope.put("time", .{ .c_name = "time", .value_type = .scalar });
-        try frame_scope.put("frame", .{ .c_name = "frame", .value_type = .scalar });
-
-        for (program.params) |param| {
-            const param_type = try inferExprType(param.value, &frame_scope);
-            const c_name = try makeName(temp_allocator, "dsl_param", param.name, &name_counter);
-            try writeIndent(writer, 1);
-            try writer.print("const {s} {s} DSL_MAYBE_UNUSED = ", .{ cTypeName(param_type), c_name });
-            try emitExpr(writer, param.value, &frame_scope);
-            try writer.writeAll(";\n");
-            try frame_scope.put(param.name, .{ .c_name = c_name, .value_type = param_type });
-        }
-
-        try emitStatements(writer, temp_allocator, &name_counter, &frame_scope, program.frame_statements, false, "__dsl_out", 1);
-        try writer.writeAll("}\n\n");
-    }
-
-    // Emit eval_pixel
-    const pixel_fn_name = if (prefix) |p|
-        try std.fmt.allocPrint(temp_allocator, "{s}_eval_pixel", .{p})
-    else
-        try std.fmt.allocPrint(temp_allocator, "dsl_shader_eval_pixel", .{});
-
-    try writer.print(
-        \\/* Generated from effect: {s} */
-        \\{s}void {s}(float time, float frame, float x, float y, float width, float height, float seed, dsl_color_t *out_color) {{
-        \\
-    , .{ program.effect_name, static_kw, pixel_fn_name });
+    const fn_prefix: []const u8 = prefix orelse "dsl_shader";
+    const uniforms_type_name = try std.fmt.allocPrint(temp_allocator, "{s}_uniforms_t", .{fn_prefix});
+    const uniforms_var_name = try std.fmt.allocPrint(temp_allocator, "{s}_uniforms", .{fn_prefix});
+    const params_var_name = try std.fmt.allocPrint(temp_allocator, "{s}_params", .{fn_prefix});
 
     var name_counter: usize = 0;
+    var frame_scope = Scope.init(temp_allocator, null);
+    defer frame_scope.deinit();
+    try frame_scope.put("time", .{ .c_name = "time", .value_type = .scalar });
+    try frame_scope.put("frame", .{ .c_name = "frame", .value_type = .scalar });
+    try frame_scope.put("width", .{ .c_name = "width", .value_type = .scalar });
+    try frame_scope.put("height", .{ .c_name = "height", .value_type = .scalar });
+    try frame_scope.put("seed", .{ .c_name = "seed", .value_type = .scalar });
+
     var root_scope = Scope.init(temp_allocator, null);
     defer root_scope.deinit();
     try root_scope.put("time", .{ .c_name = "time", .value_type = .scalar });
@@ -392,30 +480,237 @@ pub fn writeShaderFunctions(
     try root_scope.put("height", .{ .c_name = "height", .value_type = .scalar });
     try root_scope.put("seed", .{ .c_name = "seed", .value_type = .scalar });
 
-    for (program.params) |param| {
-        const param_type = try inferExprType(param.value, &root_scope);
+    // Names whose value varies per pixel; anything referencing one stays in the pixel body.
+    var pixel_names = std.StringHashMap(void).init(temp_allocator);
+    defer pixel_names.deinit();
+    try pixel_names.put("x", {});
+    try pixel_names.put("y", {});
+
+    // Names whose value is fixed for the whole frame (the complement of pixel_names).
+    var frame_names = std.StringHashMap(void).init(temp_allocator);
+    defer frame_names.deinit();
+    try frame_names.put("time", {});
+    try frame_names.put("frame", {});
+    try frame_names.put("width", {});
+    try frame_names.put("height", {});
+    try frame_names.put("seed", {});
+
+    var frame_body = std.ArrayList(u8).empty;
+    const frame_writer = frame_body.writer(temp_allocator);
+    var uniform_fields = std.ArrayList(Symbol).empty;
+    const param_is_uniform = try temp_allocator.alloc(bool, program.params.len);
+    const frame_statement_is_uniform = try temp_allocator.alloc(bool, program.frame_statements.len);
+
+    for (program.params, param_is_uniform, 0..) |param, *is_uniform, index| {
+        is_uniform.* = !exprUsesNames(param.value, &pixel_names);
+        if (!is_uniform.*) {
+            try pixel_names.put(param.name, {});
+            continue;
+        }
+        const param_type = try inferExprType(param.value, &frame_scope);
         const c_name = try makeName(temp_allocator, "dsl_param", param.name, &name_counter);
-        try writeIndent(writer, 1);
-        try writer.print("const {s} {s} DSL_MAYBE_UNUSED = ", .{ cTypeName(param_type), c_name });
-        try emitExpr(writer, param.value, &root_scope);
-        try writer.writeAll(";\n");
-        try root_scope.put(param.name, .{ .c_name = c_name, .value_type = param_type });
+        try writeIndent(frame_writer, 1);
+        try frame_writer.print("const {s} {s} DSL_MAYBE_UNUSED = ", .{ cTypeName(param_type), c_name });
+        try writePinnedParamRead(frame_writer, params_var_name, index);
+        try emitExpr(frame_writer, param.value, &frame_scope);
+        try frame_writer.writeAll(";\n");
+        try frame_scope.put(param.name, .{ .c_name = c_name, .value_type = param_type });
+        try frame_names.put(param.name, {});
+        try uniform_fields.append(temp_allocator, .{ .c_name = c_name, .value_type = param_type });
+        try root_scope.put(param.name, .{
+            .c_name = try std.fmt.allocPrint(temp_allocator, "{s}.{s}", .{ uniforms_var_name, c_name }),
+            .value_type = param_type,
+        });
     }
 
-    try emitStatements(writer, temp_allocator, &name_counter, &root_scope, program.frame_statements, false, "__dsl_out", 1);
+    for (program.frame_statements, frame_statement_is_uniform, 0..) |statement, *is_uniform, index| {
+        const single = program.frame_statements[index .. index + 1];
+        is_uniform.* = !statementsUseNames(single, &pixel_names);
+        if (!is_uniform.*) {
+            if (statement == .let_decl) try pixel_names.put(statement.let_decl.name, {});
+            continue;
+        }
+        try emitStatements(frame_writer, temp_allocator, &name_counter, &frame_scope, single, false, "__dsl_out", 1);
+        if (statement == .let_decl) {
+            const symbol = frame_scope.get(statement.let_decl.name).?;
+            try frame_names.put(statement.let_decl.name, {});
+            try uniform_fields.append(temp_allocator, symbol);
+            try root_scope.put(statement.let_decl.name, .{
+                .c_name = try std.fmt.allocPrint(temp_allocator, "{s}.{s}", .{ uniforms_var_name, symbol.c_name }),
+                .value_type = symbol.value_type,
+            });
+        }
+    }
 
-    try writeIndent(writer, 1);
-    try writer.writeAll("dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };\n");
+    // Lets in layer-level for loops that only read the loop index and frame values are
+    // evaluated per iteration in prepare_frame and stored in arrays indexed by the loop.
+    var array_fields = std.ArrayList(ArrayField).empty;
+    var lifted_loops = std.ArrayList(LiftedLoop).empty;
     for (program.layers) |layer| {
+        for (layer.statements, 0..) |statement, statement_index| {
+            if (statement != .for_range) continue;
+            const for_stmt = statement.for_range;
+            const iterations = for_stmt.end_exclusive - for_stmt.start_inclusive;
+            if (iterations > max_lifted_loop_iterations) continue;
+
+            var loop_body = std.ArrayList(u8).empty;
+            const loop_writer = loop_body.writer(temp_allocator);
+            var store_body = std.ArrayList(u8).empty;
+            const store_writer = store_body.writer(temp_allocator);
+            // Frame names shadowed by pixel-varying params, frame lets or earlier layer lets
+            // no longer refer to the frame value.
+            var loop_names = try frame_names.clone();
+            defer loop_names.deinit();
+            var pixel_it = pixel_names.keyIterator();
+            while (pixel_it.next()) |name| _ = loop_names.remove(name.*);
+            for (layer.statements[0..statement_index]) |earlier| {
+                if (earlier == .let_decl) _ = loop_names.remove(earlier.let_decl.name);
+            }
+            var loop_scope = Scope.init(temp_allocator, &frame_scope);
+            defer loop_scope.deinit();
+
+            const iter_name = try makeName(temp_allocator, "dsl_iter", for_stmt.index_name, &name_counter);
+            const index_name = try makeName(temp_allocator, "dsl_index", for_stmt.index_name, &name_counter);
+            try loop_scope.put(for_stmt.index_name, .{ .c_name = index_name, .value_type = .scalar });
+            try loop_names.put(for_stmt.index_name, {});
+            const slot = try liftedSlotExpr(temp_allocator, iter_name, for_stmt.start_inclusive);
+
+            var lifted = LiftedLoop{
+                .statements = for_stmt.statements,
+                .lets = std.StringHashMap(Symbol).init(temp_allocator),
+            };
+            for (for_stmt.statements, 0..) |body_statement, index| {
+                if (body_statement != .let_decl) continue;
+                const let_decl = body_statement.let_decl;
+                if (!exprOnlyUsesNames(let_decl.value, &loop_names)) {
+                    _ = loop_names.remove(let_decl.name);
+                    continue;
+                }
+                try emitStatements(loop_writer, temp_allocator, &name_counter, &loop_scope, for_stmt.statements[index .. index + 1], false, "__dsl_out", 2);
+                try loop_names.put(let_decl.name, {});
+                // A copy or a literal is cheaper to recompute than to load.
+                if (let_decl.value.* == .identifier or let_decl.value.* == .number) continue;
+                const symbol = loop_scope.get(let_decl.name).?;
+                try lifted.lets.put(let_decl.name, symbol);
+                try array_fields.append(temp_allocator, .{ .symbol = symbol, .len = iterations });
+                try writeIndent(store_writer, 2);
+                try store_writer.print("{s}.{s}[{s}] = {s};\n", .{ uniforms_var_name, symbol.c_name, slot, symbol.c_name });
+            }
+            if (lifted.lets.count() == 0) continue;
+
+            try writeIndent(frame_writer, 1);
+            try frame_writer.print(
+                "for (int32_t {s} = {d}; {s} < {d}; {s}++) {{\n",
+                .{ iter_name, for_stmt.start_inclusive, iter_name, for_stmt.end_exclusive, iter_name },
+            );
+            try writeIndent(frame_writer, 2);
+            try frame_writer.print("const float {s} DSL_MAYBE_UNUSED = (float){s};\n", .{ index_name, iter_name });
+            try frame_writer.writeAll(loop_body.items);
+            try frame_writer.writeAll(store_body.items);
+            try writeIndent(frame_writer, 1);
+            try frame_writer.writeAll("}\n");
+            try lifted_loops.append(temp_allocator, lifted);
+        }
+    }
+
+    const split = PixelSplit{
+        .param_is_uniform = param_is_uniform,
+        .frame_statement_is_uniform = frame_statement_is_uniform,
+        .uniforms_var_name = uniforms_var_name,
+        .lifted_loops = lifted_loops.items,
+    };
+
+    if (program.params.len > 0) {
+        try writer.print("{s}dsl_shader_param_t {s}[{d}] = {{\n", .{ static_kw, params_var_name, program.params.len });
+        // Params are scalars; those prepare_frame computes (no x/y dependency) can be pinned.
+        for (program.params, param_is_uniform) |param, is_settable| {
+            try writeIndent(writer, 1);
+            try writer.print(
+                "{{ .name = \"{s}\", .value = 0.0f, .pinned = 0, .settable = {d} }},\n",
+                .{ param.name, @intFromBool(is_settable) },
+            );
+        }
+        try writer.writeAll("};\n\n");
+    }
+
+    // Emit the uniforms struct and prepare_frame
+    if (uniform_fields.items.len > 0 or array_fields.items.len > 0) {
+        try writer.writeAll("typedef struct {\n");
+        for (uniform_fields.items) |field| {
+            try writeIndent(writer, 1);
+            try writer.print("{s} {s};\n", .{ cTypeName(field.value_type), field.c_name });
+        }
+        for (array_fields.items) |field| {
+            try writeIndent(writer, 1);
+            try writer.print("{s} {s}[{d}];\n", .{ cTypeName(field.symbol.value_type), field.symbol.c_name, field.len });
+        }
+        try writer.print("}} {s};\n\nstatic {s} {s};\n\n", .{ uniforms_type_name, uniforms_type_name, uniforms_var_name });
+    }
+
+    try writer.print(
+        \\/* Generated from effect: {s} */
+        \\{s}void {s}_prepare_frame(float time, float frame, float width, float height, float seed) {{
+        \\
+    , .{ program.effect_name, static_kw, fn_prefix });
+    try writer.writeAll(frame_body.items);
+    for (uniform_fields.items) |field| {
         try writeIndent(writer, 1);
-        try writer.print("/* layer {s} */\n", .{layer.name});
-        var layer_scope = Scope.init(temp_allocator, &root_scope);
-        defer layer_scope.deinit();
-        try emitStatements(writer, temp_allocator, &name_counter, &layer_scope, layer.statements, true, "__dsl_out", 1);
+        try writer.print("{s}.{s} = {s};\n", .{ uniforms_var_name, field.c_name, field.c_name });
     }
+    try writer.writeAll("}\n\n");
+
+    // Emit eval_pixel
+    try writer.print(
+        \\/* Generated from effect: {s} */
+        \\{s}void {s}_eval_pixel(float time, float frame, float x, float y, float width, float height, float seed, dsl_color_t *out_color) {{
+        \\
+    , .{ program.effect_name, static_kw, fn_prefix });
+    var pixel_name_counter = name_counter;
+    try emitPixelBody(writer, writer, temp_allocator, &pixel_name_counter, &root_scope, program, split, 1, 1);
     try writeIndent(writer, 1);
     try writer.writeAll("*out_color = __dsl_out;\n");
-    try writer.writeAll("}\n");
+    try writer.writeAll("}\n\n");
+
+    // Emit render_rows: the same body inside the x/y loops, with x-invariant lets per row.
+    // Rows are visited with a stride so several cores can share one frame.
+    var row_body = std.ArrayList(u8).empty;
+    var pixel_body = std.ArrayList(u8).empty;
+    var render_name_counter = name_counter;
+    try emitPixelBody(row_body.writer(temp_allocator), pixel_body.writer(temp_allocator), temp_allocator, &render_name_counter, &root_scope, program, split, 2, 3);
+
+    try writer.print(
+        \\/* Generated from effect: {s} */
+        \\{s}void {s}_render_rows(float time, float frame, int width_px, int height_px, int row_first, int row_step, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {{
+        \\    const float width DSL_MAYBE_UNUSED = (float)width_px;
+        \\    const float height DSL_MAYBE_UNUSED = (float)height_px;
+        \\    for (int py = row_first; py < height_px; py += row_step) {{
+        \\        const float y DSL_MAYBE_UNUSED = (float)py;
+        \\
+    , .{ program.effect_name, static_kw, fn_prefix });
+    try writer.writeAll(row_body.items);
+    try writer.writeAll(
+        \\        for (int px = 0; px < width_px; px++) {
+        \\            const float x DSL_MAYBE_UNUSED = (float)px;
+        \\
+    );
+    try writer.writeAll(pixel_body.items);
+    try writer.writeAll(
+        \\            dsl_store_pixel(pixel_out + (uint32_t)phys_index[py * width_px + px] * 3U, __dsl_out, grb_gamma);
+        \\        }
+        \\    }
+        \\}
+        \\
+        \\
+    );
+
+    try writer.print(
+        \\/* Generated from effect: {s} */
+        \\{s}void {s}_render_frame(float time, float frame, int width_px, int height_px, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma) {{
+        \\    {s}_prepare_frame(time, frame, (float)width_px, (float)height_px, seed);
+        \\    {s}_render_rows(time, frame, width_px, height_px, 0, 1, seed, pixel_out, phys_index, grb_gamma);
+        \\}}
+        \\
+    , .{ program.effect_name, static_kw, fn_prefix, fn_prefix, fn_prefix });
 
     // Emit eval_audio if the program has audio statements
     if (program.audio_statements.len > 0) {
@@ -439,11 +734,12 @@ pub fn writeShaderFunctions(
         try audio_scope.put("time", .{ .c_name = "time", .value_type = .scalar });
         try audio_scope.put("seed", .{ .c_name = "seed", .value_type = .scalar });
 
-        for (program.params) |param| {
+        for (program.params, split.param_is_uniform, 0..) |param, is_settable, index| {
             const param_type = try inferExprType(param.value, &audio_scope);
             const c_name = try makeName(temp_allocator, "dsl_param", param.name, &audio_name_counter);
             try writeIndent(writer, 1);
             try writer.print("const {s} {s} DSL_MAYBE_UNUSED = ", .{ cTypeName(param_type), c_name });
+            if (is_settable) try writePinnedParamRead(writer, params_var_name, index);
             try emitExpr(writer, param.value, &audio_scope);
             try writer.writeAll(";\n");
             try audio_scope.put(param.name, .{ .c_name = c_name, .value_type = param_type });
@@ -458,6 +754,207 @@ pub fn writeShaderFunctions(
     }
 }
 
+/// A pinned param reads its table entry instead of its expression; the caller emits the expression next.
+fn writePinnedParamRead(writer: anytype, params_var_name: []const u8, index: usize) !void {
+    try writer.print("{s}[{d}].pinned ? {s}[{d}].value : ", .{ params_var_name, index, params_var_name, index });
+}
+
+/// Loops longer than this keep all their lets per pixel rather than growing the uniforms.
+const max_lifted_loop_iterations: usize = 64;
+
+/// A per-iteration array in the uniforms struct.
+const ArrayField = struct {
+    symbol: Symbol,
+    len: usize,
+};
+
+/// A layer-level for loop whose frame-invariant lets prepare_frame stores per iteration.
+const LiftedLoop = struct {
+    /// The loop body; identifies the loop when the pixel body is emitted.
+    statements: []const dsl_parser.Statement,
+    /// DSL let name -> array field holding its value for each iteration.
+    lets: std.StringHashMap(Symbol),
+};
+
+/// What prepare_frame already computes: params and top-level frame statements, and
+/// the lifted lets of layer-level for loops.
+const PixelSplit = struct {
+    param_is_uniform: []const bool,
+    frame_statement_is_uniform: []const bool,
+    uniforms_var_name: []const u8,
+    lifted_loops: []const LiftedLoop,
+};
+
+fn liftedSlotExpr(allocator: std.mem.Allocator, iter_name: []const u8, start_inclusive: usize) ![]const u8 {
+    if (start_inclusive == 0) return iter_name;
+    return std.fmt.allocPrint(allocator, "{s} - {d}", .{ iter_name, start_inclusive });
+}
+
+/// Emit the per-pixel part of a shader: the params and frame statements left out of
+/// prepare_frame, the `__dsl_out` accumulator and the layers. Top-level lets that do
+/// not depend on x go to `row_writer`; eval_pixel passes the same writer for both.
+fn emitPixelBody(
+    row_writer: anytype,
+    pixel_writer: anytype,
+    allocator: std.mem.Allocator,
+    name_counter: *usize,
+    uniform_scope: *const Scope,
+    program: dsl_parser.Program,
+    split: PixelSplit,
+    row_indent: usize,
+    pixel_indent: usize,
+) !void {
+    var root_scope = Scope.init(allocator, uniform_scope);
+    defer root_scope.deinit();
+
+    // Names whose value varies along a row; lets referencing one stay in the pixel loop.
+    var x_names = std.StringHashMap(void).init(allocator);
+    defer x_names.deinit();
+    try x_names.put("x", {});
+
+    for (program.params, split.param_is_uniform) |param, is_uniform| {
+        if (is_uniform) continue;
+        const param_type = try inferExprType(param.value, &root_scope);
+        const c_name = try makeName(allocator, "dsl_param", param.name, name_counter);
+        if (exprUsesNames(param.value, &x_names)) {
+            try writeIndent(pixel_writer, pixel_indent);
+            try pixel_writer.print("const {s} {s} DSL_MAYBE_UNUSED = ", .{ cTypeName(param_type), c_name });
+            try emitExpr(pixel_writer, param.value, &root_scope);
+            try pixel_writer.writeAll(";\n");
+            try x_names.put(param.name, {});
+        } else {
+            try writeIndent(row_writer, row_indent);
+            try row_writer.print("const {s} {s} DSL_MAYBE_UNUSED = ", .{ cTypeName(param_type), c_name });
+            try emitExpr(row_writer, param.value, &root_scope);
+            try row_writer.writeAll(";\n");
+        }
+        try root_scope.put(param.name, .{ .c_name = c_name, .value_type = param_type });
+    }
+
+    for (program.frame_statements, split.frame_statement_is_uniform, 0..) |_, is_uniform, index| {
+        if (is_uniform) continue;
+        const single = program.frame_statements[index .. index + 1];
+        try emitRowOrPixelStatement(row_writer, pixel_writer, allocator, name_counter, &root_scope, &x_names, split, single, false, row_indent, pixel_indent);
+    }
+
+    try writeIndent(pixel_writer, pixel_indent);
+    try pixel_writer.writeAll("dsl_color_t __dsl_out = (dsl_color_t){ .r = 0.0f, .g = 0.0f, .b = 0.0f, .a = 1.0f };\n");
+    for (program.layers) |layer| {
+        try writeIndent(pixel_writer, pixel_indent);
+        try pixel_writer.print("/* layer {s} */\n", .{layer.name});
+        var layer_scope = Scope.init(allocator, &root_scope);
+        defer layer_scope.deinit();
+        const cull_plan = try planBlendCulling(allocator, layer.statements);
+        var layer_row_indent = row_indent;
+        var layer_pixel_indent = pixel_indent;
+        for (layer.statements, 0..) |_, index| {
+            if (cull_plan) |plan| {
+                if (index == plan.start) {
+                    try emitCullGuard(pixel_writer, plan, &layer_scope, pixel_indent);
+                    layer_pixel_indent += 1;
+                    // eval_pixel writes rows and pixels to one writer at one indent.
+                    if (row_indent == pixel_indent) layer_row_indent += 1;
+                }
+            }
+            const single = layer.statements[index .. index + 1];
+            try emitRowOrPixelStatement(row_writer, pixel_writer, allocator, name_counter, &layer_scope, &x_names, split, single, true, layer_row_indent, layer_pixel_indent);
+        }
+        if (cull_plan != null) {
+            try writeIndent(pixel_writer, pixel_indent);
+            try pixel_writer.writeAll("}\n");
+        }
+    }
+}
+
+/// Emit one top-level statement: x-independent lets to `row_writer`, everything else
+/// (blends, nested blocks and lets that read x) to `pixel_writer`.
+fn emitRowOrPixelStatement(
+    row_writer: anytype,
+    pixel_writer: anytype,
+    allocator: std.mem.Allocator,
+    name_counter: *usize,
+    scope: *Scope,
+    x_names: *std.StringHashMap(void),
+    split: PixelSplit,
+    single: []const dsl_parser.Statement,
+    allow_blend: bool,
+    row_indent: usize,
+    pixel_indent: usize,
+) !void {
+    const statement = single[0];
+    if (statement == .let_decl and !exprUsesNames(statement.let_decl.value, x_names)) {
+        try emitStatements(row_writer, allocator, name_counter, scope, single, allow_blend, "__dsl_out", row_indent);
+        return;
+    }
+    if (statement == .for_range) {
+        for (split.lifted_loops) |*lifted| {
+            if (lifted.statements.ptr != statement.for_range.statements.ptr) continue;
+            try emitLiftedLoop(pixel_writer, allocator, name_counter, scope, statement.for_range, lifted, split.uniforms_var_name, allow_blend, pixel_indent);
+            return;
+        }
+    }
+    try emitStatements(pixel_writer, allocator, name_counter, scope, single, allow_blend, "__dsl_out", pixel_indent);
+    if (statement == .let_decl) try x_names.put(statement.let_decl.name, {});
+}
+
+/// Emit a layer-level for loop whose lifted lets are read from the per-iteration
+/// arrays filled by prepare_frame; the remaining statements are emitted as usual.
+fn emitLiftedLoop(
+    writer: anytype,
+    allocator: std.mem.Allocator,
+    name_counter: *usize,
+    scope: *Scope,
+    for_stmt: dsl_parser.Statement.ForRange,
+    lifted: *const LiftedLoop,
+    uniforms_var_name: []const u8,
+    allow_blend: bool,
+    indent: usize,
+) !void {
+    const iter_name = try makeName(allocator, "dsl_iter", for_stmt.index_name, name_counter);
+    const index_name = try makeName(allocator, "dsl_index", for_stmt.index_name, name_counter);
+    const slot = try liftedSlotExpr(allocator, iter_name, for_stmt.start_inclusive);
+    try writeIndent(writer, indent);
+    try writer.print(
+        "for (int32_t {s} = {d}; {s} < {d}; {s}++) {{\n",
+        .{ iter_name, for_stmt.start_inclusive, iter_name, for_stmt.end_exclusive, iter_name },
+    );
+    var loop_scope = Scope.init(allocator, scope);
+    defer loop_scope.deinit();
+    try writeIndent(writer, indent + 1);
+    try writer.print("const float {s} DSL_MAYBE_UNUSED = (float){s};\n", .{ index_name, iter_name });
+    try loop_scope.put(for_stmt.index_name, .{ .c_name = index_name, .value_type = .scalar });
+
+    const cull_plan = if (allow_blend) try planBlendCulling(allocator, for_stmt.statements) else null;
+    var body_indent = indent + 1;
+    for (for_stmt.statements, 0..) |statement, index| {
+        if (cull_plan) |plan| {
+            if (index == plan.start) {
+                try emitCullGuard(writer, plan, &loop_scope, body_indent);
+                body_indent += 1;
+            }
+        }
+        if (statement == .let_decl) {
+            if (lifted.lets.get(statement.let_decl.name)) |field| {
+                const c_name = try makeName(allocator, "dsl_let", statement.let_decl.name, name_counter);
+                try writeIndent(writer, body_indent);
+                try writer.print(
+                    "const {s} {s} DSL_MAYBE_UNUSED = {s}.{s}[{s}];\n",
+                    .{ cTypeName(field.value_type), c_name, uniforms_var_name, field.c_name, slot },
+                );
+                try loop_scope.put(statement.let_decl.name, .{ .c_name = c_name, .value_type = field.value_type });
+                continue;
+            }
+        }
+        try emitStatements(writer, allocator, name_counter, &loop_scope, for_stmt.statements[index .. index + 1], allow_blend, "__dsl_out", body_indent);
+    }
+    if (cull_plan != null) {
+        try writeIndent(writer, indent + 1);
+        try writer.writeAll("}\n");
+    }
+    try writeIndent(writer, indent);
+    try writer.writeAll("}\n");
+}
+
 fn emitStatements(
     writer: anytype,
     allocator: std.mem.Allocator,
@@ -481,10 +978,22 @@ fn emitStatements(
             },
             .blend => |blend_expr| {
                 if (!allow_blend) return error.InvalidFrameStatement;
+                // The pixel color starts opaque and only blends write it (`out` is scalar-only),
+                // so every blend sees dst.a == 1.
+                if (blendAlphaIsLazy(blend_expr)) {
+                    try emitAlphaFirstBlend(writer, blend_expr.call.args, scope, out_name, indent);
+                    continue;
+                }
                 try writeIndent(writer, indent);
-                try writer.print("{s} = dsl_blend_over(", .{out_name});
-                try emitExpr(writer, blend_expr, scope);
-                try writer.print(", {s});\n", .{out_name});
+                if (blendAlphaIsOne(blend_expr)) {
+                    try writer.print("{s} = dsl_color_opaque(", .{out_name});
+                    try emitExpr(writer, blend_expr, scope);
+                    try writer.writeAll(");\n");
+                } else {
+                    try writer.print("{s} = dsl_blend_over_opaque(", .{out_name});
+                    try emitExpr(writer, blend_expr, scope);
+                    try writer.print(", {s});\n", .{out_name});
+                }
             },
             .out => |out_expr| {
                 try writeIndent(writer, indent);
@@ -539,7 +1048,7 @@ fn emitStatements(
                 try writeIndent(writer, indent + 1);
                 try writer.print("const float {s} DSL_MAYBE_UNUSED = (float){s};\n", .{ index_name, iter_name });
                 try loop_scope.put(for_stmt.index_name, .{ .c_name = index_name, .value_type = .scalar });
-                try emitStatements(
+                try emitCulledStatements(
                     writer,
                     allocator,
                     name_counter,
@@ -556,6 +1065,477 @@ fn emitStatements(
     }
 }
 
+/// True when a blend source is an `rgba(...)` whose alpha is a literal of at least 1.
+fn blendAlphaIsOne(expr: *const dsl_parser.Expr) bool {
+    if (expr.* != .call) return false;
+    const call = expr.call;
+    if (call.builtin != .rgba or call.args.len != 4) return false;
+    const alpha = call.args[3];
+    return alpha.* == .number and alpha.number >= 1.0;
+}
+
+/// True when a blend source is an `rgba(...)` with a computed alpha, whose color
+/// channels are worth skipping where the alpha comes out transparent.
+fn blendAlphaIsLazy(expr: *const dsl_parser.Expr) bool {
+    if (expr.* != .call) return false;
+    const call = expr.call;
+    return call.builtin == .rgba and call.args.len == 4 and call.args[3].* != .number;
+}
+
+/// Blend an `rgba(r, g, b, a)` source by evaluating `a` first; a blend with alpha <= 0
+/// leaves the opaque pixel color unchanged, so r/g/b are skipped then. A NaN alpha still
+/// blends, so it poisons the pixel exactly as the unconditional blend did.
+fn emitAlphaFirstBlend(
+    writer: anytype,
+    args: []const *dsl_parser.Expr,
+    scope: *const Scope,
+    out_name: []const u8,
+    indent: usize,
+) !void {
+    try writeIndent(writer, indent);
+    try writer.writeAll("{\n");
+    try writeIndent(writer, indent + 1);
+    try writer.writeAll("const float __dsl_blend_a = ");
+    try emitExpr(writer, args[3], scope);
+    try writer.writeAll(";\n");
+    try writeIndent(writer, indent + 1);
+    try writer.writeAll("if (!(__dsl_blend_a <= 0.0f)) {\n");
+    try writeIndent(writer, indent + 2);
+    try writer.print("{s} = dsl_blend_over_opaque((dsl_color_t){{ .r = ", .{out_name});
+    try emitExpr(writer, args[0], scope);
+    try writer.writeAll(", .g = ");
+    try emitExpr(writer, args[1], scope);
+    try writer.writeAll(", .b = ");
+    try emitExpr(writer, args[2], scope);
+    try writer.print(", .a = __dsl_blend_a }}, {s});\n", .{out_name});
+    try writeIndent(writer, indent + 1);
+    try writer.writeAll("}\n");
+    try writeIndent(writer, indent);
+    try writer.writeAll("}\n");
+}
+
+/// Upper bound on the footprints one culling guard tests; more blends than this in a
+/// block cost about as much to test as to evaluate.
+const max_cull_boxes: usize = 8;
+
+/// Axis-aligned footprint of a blend: outside |px| < rx, |py| < ry its alpha is exactly 0,
+/// where rx/ry are the largest of their reaches. When `edge0` is set the bound only holds
+/// for `edge0 <= edge1`, checked at run time.
+const CullBox = struct {
+    px: *dsl_parser.Expr,
+    py: *dsl_parser.Expr,
+    rx: []const *dsl_parser.Expr,
+    ry: []const *dsl_parser.Expr,
+    edge0: ?*dsl_parser.Expr = null,
+    edge1: ?*dsl_parser.Expr = null,
+};
+
+/// Guard for one block: statements from `start` on run only inside one of `boxes`.
+const CullPlan = struct {
+    start: usize,
+    boxes: []const CullBox,
+};
+
+const CullLet = struct {
+    value: *dsl_parser.Expr,
+    /// Position in the guarded block; null for lets inside if-branches, which are not
+    /// visible where the guard is emitted and get inlined into it instead.
+    top_index: ?usize,
+};
+
+/// Derives blend footprints from the SDF calls (`circle`, `box`) feeding an alpha through
+/// `1.0 - smoothstep(e0, e1, d)`, which is exactly 0 once d >= e1. Products, sums,
+/// min/max/clamp and if-conditions carry the bound through to the blend.
+const CullAnalysis = struct {
+    allocator: std.mem.Allocator,
+    lets: std.StringHashMap(CullLet),
+    /// Highest block let the guard reads by name; the guard goes right after it.
+    last_top_let: ?usize = null,
+
+    fn resolve(self: *const CullAnalysis, expr: *dsl_parser.Expr) *dsl_parser.Expr {
+        var current = expr;
+        while (current.* == .identifier) {
+            const let_info = self.lets.get(current.identifier) orelse break;
+            current = let_info.value;
+        }
+        return current;
+    }
+
+    fn newExpr(self: *CullAnalysis, value: dsl_parser.Expr) !*dsl_parser.Expr {
+        const expr = try self.allocator.create(dsl_parser.Expr);
+        expr.* = value;
+        return expr;
+    }
+
+    fn newBinary(self: *CullAnalysis, op: dsl_parser.Expr.BinaryOp, left: *dsl_parser.Expr, right: *dsl_parser.Expr) !*dsl_parser.Expr {
+        return self.newExpr(.{ .binary = .{ .op = op, .left = left, .right = right } });
+    }
+
+    fn join(self: *CullAnalysis, a: []const CullBox, b: []const CullBox) ![]const CullBox {
+        return try std.mem.concat(self.allocator, CullBox, &.{ a, b });
+    }
+
+    fn singleBox(
+        self: *CullAnalysis,
+        px: *dsl_parser.Expr,
+        py: *dsl_parser.Expr,
+        rx: *dsl_parser.Expr,
+        ry: *dsl_parser.Expr,
+    ) ![]const CullBox {
+        const boxes = try self.allocator.alloc(CullBox, 1);
+        boxes[0] = .{
+            .px = px,
+            .py = py,
+            .rx = try self.allocator.dupe(*dsl_parser.Expr, &.{rx}),
+            .ry = try self.allocator.dupe(*dsl_parser.Expr, &.{ry}),
+        };
+        return boxes;
+    }
+
+    /// Copy of `expr` that only reads names visible at the guard: branch lets are
+    /// inlined, block lets are read by name and recorded for guard placement.
+    fn leaf(self: *CullAnalysis, expr: *dsl_parser.Expr) anyerror!*dsl_parser.Expr {
+        switch (expr.*) {
+            .number => return expr,
+            .identifier => |name| {
+                const let_info = self.lets.get(name) orelse return expr;
+                const index = let_info.top_index orelse return self.leaf(let_info.value);
+                if (self.last_top_let == null or self.last_top_let.? < index) self.last_top_let = index;
+                return expr;
+            },
+            .unary => |unary_expr| return self.newExpr(.{ .unary = .{
+                .op = unary_expr.op,
+                .operand = try self.leaf(unary_expr.operand),
+            } }),
+            .binary => |binary_expr| return self.newBinary(
+                binary_expr.op,
+                try self.leaf(binary_expr.left),
+                try self.leaf(binary_expr.right),
+            ),
+            .call => |call_expr| {
+                const args = try self.allocator.alloc(*dsl_parser.Expr, call_expr.args.len);
+                for (call_expr.args, 0..) |arg, index| args[index] = try self.leaf(arg);
+                return self.newExpr(.{ .call = .{ .builtin = call_expr.builtin, .args = args } });
+            },
+        }
+    }
+
+    fn point(self: *CullAnalysis, expr: *dsl_parser.Expr) !?[2]*dsl_parser.Expr {
+        const value = self.resolve(expr);
+        if (value.* != .call or value.call.builtin != .vec2) return null;
+        return .{ try self.leaf(value.call.args[0]), try self.leaf(value.call.args[1]) };
+    }
+
+    /// Footprints outside of which `expr` is exactly 0; null when unbounded.
+    fn support(self: *CullAnalysis, expr: *dsl_parser.Expr) anyerror!?[]const CullBox {
+        const value = self.resolve(expr);
+        switch (value.*) {
+            .number => |number| return if (number == 0.0) &.{} else null,
+            .identifier => return null,
+            .unary => |unary_expr| return self.support(unary_expr.operand),
+            .binary => |binary_expr| switch (binary_expr.op) {
+                .mul => {
+                    const saved = self.last_top_let;
+                    if (try self.support(binary_expr.left)) |boxes| return boxes;
+                    self.last_top_let = saved;
+                    return self.support(binary_expr.right);
+                },
+                .div => return self.support(binary_expr.left),
+                .add, .sub => {
+                    if (binary_expr.op == .sub) {
+                        if (try self.oneMinusSmoothstep(binary_expr.left, binary_expr.right)) |boxes| return boxes;
+                    }
+                    const left = (try self.support(binary_expr.left)) orelse return null;
+                    const right = (try self.support(binary_expr.right)) orelse return null;
+                    return try self.join(left, right);
+                },
+                .mod => return null,
+            },
+            .call => |call_expr| switch (call_expr.builtin) {
+                .abs => return self.support(call_expr.args[0]),
+                // fminf(0, b) is 0 for any b >= 0 (and for NaN); likewise fmaxf for b <= 0.
+                .min, .max => {
+                    const is_min = call_expr.builtin == .min;
+                    for (0..2) |side| {
+                        const other = literalValue(call_expr.args[1 - side]) orelse continue;
+                        if ((is_min and other >= 0.0) or (!is_min and other <= 0.0)) {
+                            return self.support(call_expr.args[side]);
+                        }
+                    }
+                    const left = (try self.support(call_expr.args[0])) orelse return null;
+                    const right = (try self.support(call_expr.args[1])) orelse return null;
+                    return try self.join(left, right);
+                },
+                .clamp => {
+                    const lo = literalValue(call_expr.args[1]) orelse return null;
+                    const hi = literalValue(call_expr.args[2]) orelse return null;
+                    if (lo > 0.0 or hi < 0.0) return null;
+                    return self.support(call_expr.args[0]);
+                },
+                else => return null,
+            },
+        }
+    }
+
+    fn oneMinusSmoothstep(self: *CullAnalysis, left: *dsl_parser.Expr, right: *dsl_parser.Expr) !?[]const CullBox {
+        const one = literalValue(left) orelse return null;
+        if (one != 1.0) return null;
+        const step = self.resolve(right);
+        if (step.* != .call or step.call.builtin != .smoothstep) return null;
+        const edge0 = step.call.args[0];
+        const edge1 = step.call.args[1];
+        if (literalValue(edge0)) |lo| {
+            if (literalValue(edge1)) |hi| {
+                if (lo > hi) return null;
+            }
+        }
+        const saved = self.last_top_let;
+        const threshold = try self.leaf(edge1);
+        const boxes = (try self.below(step.call.args[2], threshold)) orelse {
+            self.last_top_let = saved;
+            return null;
+        };
+        if (literalValue(edge0) != null and literalValue(edge1) != null) return boxes;
+        const lower = try self.leaf(edge0);
+        const guarded = try self.allocator.alloc(CullBox, boxes.len);
+        for (boxes, 0..) |box, index| {
+            guarded[index] = box;
+            guarded[index].edge0 = lower;
+            guarded[index].edge1 = threshold;
+        }
+        return guarded;
+    }
+
+    /// Footprints outside of which `expr >= threshold`; null when unbounded.
+    fn below(self: *CullAnalysis, expr: *dsl_parser.Expr, threshold: *dsl_parser.Expr) anyerror!?[]const CullBox {
+        const value = self.resolve(expr);
+        switch (value.*) {
+            .binary => |binary_expr| switch (binary_expr.op) {
+                .sub => return self.below(
+                    binary_expr.left,
+                    try self.newBinary(.add, threshold, try self.leaf(binary_expr.right)),
+                ),
+                .add => {
+                    const saved = self.last_top_let;
+                    const left_threshold = try self.newBinary(.sub, threshold, try self.leaf(binary_expr.right));
+                    if (try self.below(binary_expr.left, left_threshold)) |boxes| return boxes;
+                    self.last_top_let = saved;
+                    const right_threshold = try self.newBinary(.sub, threshold, try self.leaf(binary_expr.left));
+                    return self.below(binary_expr.right, right_threshold);
+                },
+                else => return null,
+            },
+            .call => |call_expr| switch (call_expr.builtin) {
+                .abs => return self.below(call_expr.args[0], threshold),
+                .min => {
+                    const left = (try self.below(call_expr.args[0], threshold)) orelse return null;
+                    const right = (try self.below(call_expr.args[1], threshold)) orelse return null;
+                    return try self.join(left, right);
+                },
+                .max => {
+                    const saved = self.last_top_let;
+                    if (try self.below(call_expr.args[0], threshold)) |boxes| return boxes;
+                    self.last_top_let = saved;
+                    return self.below(call_expr.args[1], threshold);
+                },
+                // circle(p, r) >= |p.x| - r and box(p, b) >= |p.x| - b.x, and likewise in y.
+                .circle => {
+                    const center = (try self.point(call_expr.args[0])) orelse return null;
+                    const reach = try self.newBinary(.add, try self.leaf(call_expr.args[1]), threshold);
+                    return try self.singleBox(center[0], center[1], reach, reach);
+                },
+                .box => {
+                    const center = (try self.point(call_expr.args[0])) orelse return null;
+                    const size = (try self.point(call_expr.args[1])) orelse return null;
+                    return try self.singleBox(
+                        center[0],
+                        center[1],
+                        try self.newBinary(.add, size[0], threshold),
+                        try self.newBinary(.add, size[1], threshold),
+                    );
+                },
+                else => return null,
+            },
+            else => return null,
+        }
+    }
+
+    fn statementFootprint(self: *CullAnalysis, statement: dsl_parser.Statement) anyerror!?[]const CullBox {
+        switch (statement) {
+            .let_decl => return &.{},
+            .blend => |blend_expr| {
+                if (blend_expr.* != .call or blend_expr.call.builtin != .rgba) return null;
+                return self.support(blend_expr.call.args[3]);
+            },
+            .if_stmt => |if_stmt| {
+                const saved = self.last_top_let;
+                if (try self.branchFootprint(if_stmt.then_statements)) |then_boxes| {
+                    if (try self.branchFootprint(if_stmt.else_statements)) |else_boxes| {
+                        return try self.join(then_boxes, else_boxes);
+                    }
+                }
+                self.last_top_let = saved;
+                // Without an else branch nothing runs where the condition is 0.
+                if (if_stmt.else_statements.len != 0) return null;
+                return self.support(if_stmt.condition);
+            },
+            .out, .for_range => return null,
+        }
+    }
+
+    /// Fold boxes around the same center into one with the larger reach, so each center
+    /// is tested once. A folded box keeps its edge precondition: where that fails the
+    /// guard passes anyway, and where it holds the larger box covers both.
+    fn mergeBoxes(self: *CullAnalysis, boxes: []const CullBox) ![]const CullBox {
+        var merged = std.ArrayList(CullBox).empty;
+        next_box: for (boxes) |box| {
+            for (merged.items) |*kept| {
+                if (!exprEql(kept.px, box.px) or !exprEql(kept.py, box.py)) continue;
+                if (box.edge0) |edge0| {
+                    if (kept.edge0) |kept_edge0| {
+                        if (!exprEql(kept_edge0, edge0) or !exprEql(kept.edge1.?, box.edge1.?)) continue;
+                    }
+                    kept.edge0 = edge0;
+                    kept.edge1 = box.edge1;
+                }
+                kept.rx = try std.mem.concat(self.allocator, *dsl_parser.Expr, &.{ kept.rx, box.rx });
+                kept.ry = try std.mem.concat(self.allocator, *dsl_parser.Expr, &.{ kept.ry, box.ry });
+                continue :next_box;
+            }
+            try merged.append(self.allocator, box);
+        }
+        return merged.items;
+    }
+
+    fn branchFootprint(self: *CullAnalysis, statements: []const dsl_parser.Statement) anyerror!?[]const CullBox {
+        const outer_lets = self.lets;
+        self.lets = try outer_lets.clone();
+        defer self.lets = outer_lets;
+        var boxes: []const CullBox = &.{};
+        for (statements) |statement| {
+            if (statement == .let_decl) {
+                try self.lets.put(statement.let_decl.name, .{ .value = statement.let_decl.value, .top_index = null });
+                continue;
+            }
+            const found = (try self.statementFootprint(statement)) orelse return null;
+            boxes = try self.join(boxes, found);
+        }
+        return boxes;
+    }
+};
+
+fn exprEql(a: *const dsl_parser.Expr, b: *const dsl_parser.Expr) bool {
+    if (std.meta.activeTag(a.*) != std.meta.activeTag(b.*)) return false;
+    return switch (a.*) {
+        .number => |number| number == b.number,
+        .identifier => |name| std.mem.eql(u8, name, b.identifier),
+        .unary => |unary_expr| unary_expr.op == b.unary.op and exprEql(unary_expr.operand, b.unary.operand),
+        .binary => |binary_expr| binary_expr.op == b.binary.op and
+            exprEql(binary_expr.left, b.binary.left) and
+            exprEql(binary_expr.right, b.binary.right),
+        .call => |call_expr| blk: {
+            if (call_expr.builtin != b.call.builtin or call_expr.args.len != b.call.args.len) break :blk false;
+            for (call_expr.args, b.call.args) |left, right| {
+                if (!exprEql(left, right)) break :blk false;
+            }
+            break :blk true;
+        },
+    };
+}
+
+fn literalValue(expr: *const dsl_parser.Expr) ?f32 {
+    return switch (expr.*) {
+        .number => |number| number,
+        .unary => |unary_expr| if (unary_expr.operand.* == .number) -unary_expr.operand.number else null,
+        else => null,
+    };
+}
+
+/// Plan a guard that skips the tail of a blend block for pixels outside every blend's
+/// footprint; null when a blend is unbounded or comes before the lets the test reads.
+fn planBlendCulling(allocator: std.mem.Allocator, statements: []const dsl_parser.Statement) !?CullPlan {
+    if (countPhasorCalls(statements) != 0) return null;
+    var analysis = CullAnalysis{
+        .allocator = allocator,
+        .lets = std.StringHashMap(CullLet).init(allocator),
+    };
+    var boxes: []const CullBox = &.{};
+    var first_effect: ?usize = null;
+    for (statements, 0..) |statement, index| {
+        if (statement == .let_decl) {
+            try analysis.lets.put(statement.let_decl.name, .{ .value = statement.let_decl.value, .top_index = index });
+            continue;
+        }
+        const found = (try analysis.statementFootprint(statement)) orelse return null;
+        if (first_effect == null) first_effect = index;
+        boxes = try analysis.join(boxes, found);
+    }
+    const first = first_effect orelse return null;
+    boxes = try analysis.mergeBoxes(boxes);
+    if (boxes.len == 0 or boxes.len > max_cull_boxes) return null;
+    const start = if (analysis.last_top_let) |index| index + 1 else 0;
+    if (start > first) return null;
+    return .{ .start = start, .boxes = boxes };
+}
+
+/// Open `if (<pixel may be inside a footprint>) {` for a cull plan.
+fn emitCullGuard(writer: anytype, plan: CullPlan, scope: *const Scope, indent: usize) !void {
+    try writeIndent(writer, indent);
+    try writer.writeAll("if (");
+    for (plan.boxes, 0..) |box, index| {
+        if (index != 0) try writer.writeAll(" || ");
+        if (box.edge0) |edge0| {
+            try writer.writeAll("!(");
+            try emitExpr(writer, edge0, scope);
+            try writer.writeAll(" <= ");
+            try emitExpr(writer, box.edge1.?, scope);
+            try writer.writeAll(") || ");
+        }
+        try writer.writeAll("DSL_NEAR_BOX(");
+        try emitExpr(writer, box.px, scope);
+        try writer.writeAll(", ");
+        try emitExpr(writer, box.py, scope);
+        try writer.writeAll(", ");
+        try emitCullReach(writer, box.rx, scope);
+        try writer.writeAll(", ");
+        try emitCullReach(writer, box.ry, scope);
+        try writer.writeAll(")");
+    }
+    try writer.writeAll(") {\n");
+}
+
+fn emitCullReach(writer: anytype, reaches: []const *dsl_parser.Expr, scope: *const Scope) !void {
+    for (reaches[1..]) |_| try writer.writeAll("dsl_reach_max(");
+    try emitExpr(writer, reaches[0], scope);
+    for (reaches[1..]) |reach| {
+        try writer.writeAll(", ");
+        try emitExpr(writer, reach, scope);
+        try writer.writeAll(")");
+    }
+}
+
+/// Emit a loop body, skipping everything after the cull plan's start outside the
+/// footprints of its blends.
+fn emitCulledStatements(
+    writer: anytype,
+    allocator: std.mem.Allocator,
+    name_counter: *usize,
+    scope: *Scope,
+    statements: []const dsl_parser.Statement,
+    allow_blend: bool,
+    out_name: []const u8,
+    indent: usize,
+) anyerror!void {
+    const plan = (if (allow_blend) try planBlendCulling(allocator, statements) else null) orelse {
+        return emitStatements(writer, allocator, name_counter, scope, statements, allow_blend, out_name, indent);
+    };
+    try emitStatements(writer, allocator, name_counter, scope, statements[0..plan.start], allow_blend, out_name, indent);
+    try emitCullGuard(writer, plan, scope, indent);
+    try emitStatements(writer, allocator, name_counter, scope, statements[plan.start..], allow_blend, out_name, indent + 1);
+    try writeIndent(writer, indent);
+    try writer.writeAll("}\n");
+}
+
 fn emitExpr(writer: anytype, expr: *dsl_parser.Expr, scope: *const Scope) anyerror!void {
     switch (expr.*) {
         .number => |number| try writer.print("{d:.6}f", .{number}),
@@ -789,9 +1769,228 @@ test "writeShaderFunctions emits prefixed static functions" {
     try writeShaderFunctions(std.testing.allocator, writer, program, "my_shader");
 
     try std.testing.expect(std.mem.indexOf(u8, out.items, "static void my_shader_eval_pixel") != null);
-    try std.testing.expect(std.mem.indexOf(u8, out.items, "static void my_shader_eval_frame") != null);
+    try std.testing.expect(std.mem.indexOf(u8, out.items, "static void my_shader_prepare_frame") != null);
     // Should NOT contain the preamble types
-    try std.testing.expect(std.mem.indexOf(u8, out.items, "typedef struct") == null);
+    try std.testing.expect(std.mem.indexOf(u8, out.items, "} dsl_color_t;") == null);
+}
+
+test "writeShaderFunctions moves frame-uniform params and lets into prepare_frame" {
+    const source =
+        \\effect uniform_test
+        \\param speed = 0.5
+        \\param wobble = sin(x + time)
+        \\frame {
+        \\  let t = time * speed
+        \\}
+        \\layer l {
+        \\  let a = clamp(wobble * t, 0.0, 1.0)
+        \\  blend rgba(1.0, 0.0, 0.0, a)
+        \\}
+        \\emit
+    ;
+
+    var arena = std.heap.ArenaAllocator.init(std.testing.allocator);
+    defer arena.deinit();
+    const program = try dsl_parser.parseAndValidate(arena.allocator(), source);
+
+    var out = std.ArrayList(u8).empty;
+    defer out.deinit(std.testing.allocator);
+    const writer = out.writer(std.testing.allocator);
+    try writeShaderFunctions(std.testing.allocator, writer, program, "my_shader");
+
+    const prepare_at = std.mem.indexOf(u8, out.items, "static void my_shader_prepare_frame(float time, float frame, float width, float height, float seed)").?;
+    const pixel_at = std.mem.indexOf(u8, out.items, "static void my_shader_eval_pixel").?;
+    try std.testing.expect(prepare_at < pixel_at);
+    try std.testing.expect(std.mem.indexOf(u8, out.items, "} my_shader_uniforms_t;") != null);
+    try std.testing.expect(std.mem.indexOf(u8, out.items, "my_shader_uniforms.dsl_let_t_1 = dsl_let_t_1;") != null);
+    // The x-dependent param stays per pixel; the uniform let is read from the struct.
+    const wobble_at = std.mem.indexOf(u8, out.items, "const float dsl_param_wobble_2").?;
+    try std.testing.expect(wobble_at > pixel_at);
+    try std.testing.expect(std.mem.indexOf(u8, out.items, "(dsl_param_wobble_2 * my_shader_uniforms.dsl_let_t_1)") != null);
+}
+
+test "writeShaderFunctions lets SET_PARAMS pin frame-uniform scalar params" {
+    const source =
+        \\effect param_table_test
+        \\param speed = 0.5
+        \\param wobble = sin(x + time)
+        \\param radius = speed * 4.0 + y * 0.1
+        \\layer l {
+        \\  let d = circle(vec2(x, y), wobble + radius)
+        \\  blend rgba(1.0, 0.0, 0.0, clamp(d, 0.0, 1.0))
+        \\}
+        \\emit
+    ;
+
+    var arena = std.heap.ArenaAllocator.init(std.testing.allocator);
+    defer arena.deinit();
+    const program = try dsl_parser.parseAndValidate(arena.allocator(), source);
+
+    var out = std.ArrayList(u8).empty;
+    defer out.deinit(std.testing.allocator);
+    const writer = out.writer(std.testing.allocator);
+    try writeShaderFunctions(std.testing.allocator, writer, program, "my_shader");
+
+    const table_at = std.mem.indexOf(u8, out.items, "static dsl_shader_param_t my_shader_params[3] = {").?;
+    const prepare_at = std.mem.indexOf(u8, out.items, "static void my_shader_prepare_frame").?;
+    try std.testing.expect(table_at < prepare_at);
+    try std.testing.expect(std.mem.indexOf(u8, out.items, "{ .name = \"speed\", .value = 0.0f, .pinned = 0, .settable = 1 },") != null);
+    // Params that depend on x or y keep their expression.
+    try std.testing.expect(std.mem.indexOf(u8, out.items, "{ .name = \"wobble\", .value = 0.0f, .pinned = 0, .settable = 0 },") != null);
+    try std.testing.expect(std.mem.indexOf(u8, out.items, "{ .name = \"radius\", .value = 0.0f, .pinned = 0, .settable = 0 },") != null);
+    const read_at = std.mem.indexOf(u8, out.items, "DSL_MAYBE_UNUSED = my_shader_params[0].pinned ? my_shader_params[0].value : ").?;
+    try std.testing.expect(read_at > prepare_at);
+    try std.testing.expect(std.mem.indexOf(u8, out.items, "my_shader_params[2].pinned") == null);
+}
+
+test "writeShaderFunctions emits render_rows with x-invariant lets in the row loop" {
+    const source =
+        \\effect render_test
+        \\layer l {
+        \\  let band = sin(y * 0.5 + time)
+        \\  let a = clamp(band * x, 0.0, 1.0)
+        \\  blend rgba(1.0, 0.0, 0.0, a)
+        \\}
+        \\emit
+    ;
+
+    var arena = std.heap.ArenaAllocator.init(std.testing.allocator);
+    defer arena.deinit();
+    const program = try dsl_parser.parseAndValidate(arena.allocator(), source);
+
+    var out = std.ArrayList(u8).empty;
+    defer out.deinit(std.testing.allocator);
+    const writer = out.writer(std.testing.allocator);
+    try writeShaderFunctions(std.testing.allocator, writer, program, "my_shader");
+
+    const render_at = std.mem.indexOf(u8, out.items, "static void my_shader_render_rows(float time, float frame, int width_px, int height_px, int row_first, int row_step, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma)").?;
+    const rest = out.items[render_at..];
+    try std.testing.expect(std.mem.indexOf(u8, rest, "for (int py = row_first; py < height_px; py += row_step)") != null);
+    const band_at = std.mem.indexOf(u8, rest, "const float dsl_let_band_0").?;
+    const inner_loop_at = std.mem.indexOf(u8, rest, "for (int px = 0; px < width_px; px++)").?;
+    const a_at = std.mem.indexOf(u8, rest, "const float dsl_let_a_1").?;
+    try std.testing.expect(band_at < inner_loop_at);
+    try std.testing.expect(inner_loop_at < a_at);
+    try std.testing.expect(std.mem.indexOf(u8, rest, "dsl_store_pixel(pixel_out + (uint32_t)phys_index[py * width_px + px] * 3U, __dsl_out, grb_gamma);") != null);
+
+    // render_frame prepares the uniforms once and renders every row.
+    const frame_at = std.mem.indexOf(u8, rest, "static void my_shader_render_frame(float time, float frame, int width_px, int height_px, float seed, uint8_t *pixel_out, const uint16_t *phys_index, const uint8_t *grb_gamma)").?;
+    const frame_fn = rest[frame_at..];
+    const prepare_at = std.mem.indexOf(u8, frame_fn, "my_shader_prepare_frame(time, frame, (float)width_px, (float)height_px, seed);").?;
+    const rows_at = std.mem.indexOf(u8, frame_fn, "my_shader_render_rows(time, frame, width_px, height_px, 0, 1, seed, pixel_out, phys_index, grb_gamma);").?;
+    try std.testing.expect(prepare_at < rows_at);
+}
+
+test "writeShaderFunctions lifts frame-invariant loop lets into per-iteration arrays" {
+    const source =
+        \\effect loop_test
+        \\layer l {
+        \\  for i in 2..5 {
+        \\    let cx = hash01(i + seed) * width
+        \\    let d = abs(x - cx)
+        \\    blend rgba(1.0, 0.0, 0.0, clamp(1.0 - d, 0.0, 1.0))
+        \\  }
+        \\}
+        \\emit
+    ;
+
+    var arena = std.heap.ArenaAllocator.init(std.testing.allocator);
+    defer arena.deinit();
+    const program = try dsl_parser.parseAndValidate(arena.allocator(), source);
+
+    var out = std.ArrayList(u8).empty;
+    defer out.deinit(std.testing.allocator);
+    const writer = out.writer(std.testing.allocator);
+    try writeShaderFunctions(std.testing.allocator, writer, program, "my_shader");
+
+    try std.testing.expect(std.mem.indexOf(u8, out.items, "float dsl_let_cx_2[3];") != null);
+    try std.testing.expect(std.mem.indexOf(u8, out.items, "my_shader_uniforms.dsl_let_cx_2[dsl_iter_i_0 - 2] = dsl_let_cx_2;") != null);
+    try std.testing.expect(std.mem.indexOf(u8, out.items, "const float dsl_let_cx_5 DSL_MAYBE_UNUSED = my_shader_uniforms.dsl_let_cx_2[dsl_iter_i_3 - 2];") != null);
+    try std.testing.expect(std.mem.indexOf(u8, out.items, "const float dsl_let_d_6 DSL_MAYBE_UNUSED = fabsf((x - dsl_let_cx_5));") != null);
+}
+
+test "writeShaderFunctions specializes blends over the opaque pixel color" {
+    const source =
+        \\effect blend_test
+        \\layer base {
+        \\  blend rgba(0.1, 0.2, 0.3, 1.0)
+        \\}
+        \\layer haze {
+        \\  blend rgba(0.0, 0.0, 1.0, 0.5)
+        \\}
+        \\layer glow {
+        \\  blend rgba(sin(x), 0.5, 0.0, x / width - 0.5)
+        \\}
+        \\emit
+    ;
+
+    var arena = std.heap.ArenaAllocator.init(std.testing.allocator);
+    defer arena.deinit();
+    const program = try dsl_parser.parseAndValidate(arena.allocator(), source);
+
+    var out = std.ArrayList(u8).empty;
+    defer out.deinit(std.testing.allocator);
+    const writer = out.writer(std.testing.allocator);
+    try writeShaderFunctions(std.testing.allocator, writer, program, "my_shader");
+
+    try std.testing.expect(std.mem.indexOf(u8, out.items, "__dsl_out = dsl_color_opaque((dsl_color_t){ .r = 0.100000f") != null);
+    try std.testing.expect(std.mem.indexOf(u8, out.items, "__dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = 0.000000f, .g = 0.000000f, .b = 1.000000f, .a = 0.500000f }, __dsl_out);") != null);
+    try std.testing.expect(std.mem.indexOf(u8, out.items, "dsl_blend_over(") == null);
+}
+
+test "writeShaderFunctions evaluates a computed blend alpha before the color channels" {
+    const source =
+        \\effect lazy_blend_test
+        \\layer glow {
+        \\  blend rgba(sin(x), 0.5, 0.0, x / width - 0.5)
+        \\}
+        \\emit
+    ;
+
+    var arena = std.heap.ArenaAllocator.init(std.testing.allocator);
+    defer arena.deinit();
+    const program = try dsl_parser.parseAndValidate(arena.allocator(), source);
+
+    var out = std.ArrayList(u8).empty;
+    defer out.deinit(std.testing.allocator);
+    const writer = out.writer(std.testing.allocator);
+    try writeShaderFunctions(std.testing.allocator, writer, program, "my_shader");
+
+    const alpha_at = std.mem.indexOf(u8, out.items, "const float __dsl_blend_a = ((x / width) - 0.500000f);").?;
+    const guard_at = std.mem.indexOf(u8, out.items, "if (!(__dsl_blend_a <= 0.0f)) {").?;
+    const color_at = std.mem.indexOf(u8, out.items, "__dsl_out = dsl_blend_over_opaque((dsl_color_t){ .r = sinf(x), .g = 0.500000f, .b = 0.000000f, .a = __dsl_blend_a }, __dsl_out);").?;
+    try std.testing.expect(alpha_at < guard_at);
+    try std.testing.expect(guard_at < color_at);
+}
+
+test "writeShaderFunctions culls blends outside their SDF footprint" {
+    const source =
+        \\effect cull_test
+        \\layer spot {
+        \\  let glow = 1.0 - smoothstep(0.0, 1.5, circle(vec2(wrapdx(x, 4.0, width), y - 3.0), 2.0))
+        \\  blend rgba(1.0, 0.8, 0.2, glow * 0.5)
+        \\}
+        \\layer wash {
+        \\  blend rgba(0.0, 0.0, 1.0, 0.2)
+        \\}
+        \\emit
+    ;
+
+    var arena = std.heap.ArenaAllocator.init(std.testing.allocator);
+    defer arena.deinit();
+    const program = try dsl_parser.parseAndValidate(arena.allocator(), source);
+
+    var out = std.ArrayList(u8).empty;
+    defer out.deinit(std.testing.allocator);
+    const writer = out.writer(std.testing.allocator);
+    try writeShaderFunctions(std.testing.allocator, writer, program, "my_shader");
+
+    // The spot layer is skipped wherever the circle's SDF reaches the smoothstep's upper edge;
+    // the constant wash has no footprint and stays unguarded.
+    const guard_at = std.mem.indexOf(u8, out.items, "if (DSL_NEAR_BOX(dsl_wrapdx(x, 4.000000f, width), (y - 3.000000f), (2.000000f + 1.500000f), (2.000000f + 1.500000f))) {").?;
+    const glow_at = std.mem.indexOf(u8, out.items, "const float dsl_let_glow_0").?;
+    try std.testing.expect(guard_at < glow_at);
+    try std.testing.expectEqual(@as(usize, 2), std.mem.count(u8, out.items, "DSL_NEAR_BOX("));
 }
 
 test "writePreambleC emits type definitions" {
@@ -816,6 +2015,21 @@ test "writePreambleC emits noise functions" {
     try std.testing.expect(std.mem.indexOf(u8, out.items, "dsl_perm") != null);
 }
 
+test "writePreambleC emits a pixel store with a gamma-corrected GRB wire path" {
+    var out = std.ArrayList(u8).empty;
+    defer out.deinit(std.testing.allocator);
+    const writer = out.writer(std.testing.allocator);
+    try writePreambleC(writer);
+
+    const store_at = std.mem.indexOf(u8, out.items, "static inline void dsl_store_pixel(uint8_t *px, dsl_color_t c, const uint8_t *grb_gamma)").?;
+    const store_fn = out.items[store_at..];
+    const g_at = std.mem.indexOf(u8, store_fn, "px[0] = grb_gamma[g];").?;
+    const r_at = std.mem.indexOf(u8, store_fn, "px[1] = grb_gamma[r];").?;
+    const rgb_at = std.mem.indexOf(u8, store_fn, "px[0] = r;").?;
+    try std.testing.expect(g_at < r_at);
+    try std.testing.expect(r_at < rgb_at);
+}
+
 test "writeProgramC emits pow, fmodf, and noise calls" {
     const source =
         \\effect emitter_test
@@ -149,12 +149,14 @@ pub const Evaluator = struct {
     expr_stack: []RuntimeValue,
     has_dynamic_params: bool,
     seed: f32,
+    optimization: OptimizationReport,
 
     pub fn init(allocator: std.mem.Allocator, program: dsl_parser.Program) !Evaluator {
         var compile_arena = std.heap.ArenaAllocator.init(allocator);
         errdefer compile_arena.deinit();
 
-        const compiled = try compileProgram(compile_arena.allocator(), program);
+        var compiled = try compileProgram(compile_arena.allocator(), program);
+        const optimization = try optimizeCompiledProgram(compile_arena.allocator(), &compiled);
 
         const param_values = try allocator.alloc(f32, compiled.params.len);
         errdefer allocator.free(param_values);
@@ -187,6 +189,7 @@ pub const Evaluator = struct {
             .expr_stack = expr_stack,
             .has_dynamic_params = has_dynamic_params,
             .seed = generateSeed(),
+            .optimization = optimization,
         };
     }
 
@@ -818,6 +821,833 @@ fn maxExprStackInStatements(statements: []const CompiledStatement) usize {
     return max_stack;
 }
 
+/// Instruction/statement counts and per-pass tallies from `optimizeCompiledProgram`.
+pub const OptimizationReport = struct {
+    instructions_before: usize = 0,
+    instructions_after: usize = 0,
+    statements_before: usize = 0,
+    statements_after: usize = 0,
+    folded_constants: usize = 0,
+    simplified_ops: usize = 0,
+    dead_statements: usize = 0,
+    cse_lets: usize = 0,
+    cse_replacements: usize = 0,
+};
+
+// Mirror FW_BC3_MAX_LET_SLOTS / FW_BC3_MAX_STATEMENTS / FW_BC3_MAX_EXPRESSIONS in fw_bytecode_vm.h.
+const bytecode_max_let_slots: usize = 128;
+const bytecode_max_statements: usize = 2048;
+const bytecode_max_expressions: usize = 2048;
+
+// A synthetic let costs a statement dispatch plus one slot load per use, so only
+// hoist a repeated subexpression when that removes at least this many instructions.
+const cse_min_saved_instructions: usize = 4;
+
+/// Expression tree rebuilt from a postfix instruction list; args are in push order.
+const OptNode = struct {
+    instruction: BytecodeInstruction,
+    args: []*OptNode,
+};
+
+const CseEntry = struct {
+    /// Original statement, or null for a let introduced by CSE.
+    statement: ?CompiledStatement,
+    slot: usize = 0,
+    root: ?*OptNode,
+};
+
+const CseOccurrence = struct {
+    entry_index: usize,
+    ref: **OptNode,
+    hash: u64,
+    size: usize,
+    /// The occurrence is the whole expression of its statement.
+    is_root: bool,
+};
+
+const CseCandidate = struct {
+    index: usize,
+    reuse_slot: ?usize,
+};
+
+/// Runs the host-side pass pipeline over a freshly compiled program:
+/// 1. constant folding with literal-let propagation and algebraic simplification,
+/// 2. dead-let (and empty control-flow) elimination,
+/// 3. common-subexpression elimination into synthetic let slots.
+/// All passes keep the DSLB v3 shape, so the firmware loads the result unchanged.
+fn optimizeCompiledProgram(allocator: std.mem.Allocator, compiled: *CompiledProgram) !OptimizationReport {
+    var report = OptimizationReport{
+        .instructions_before = countProgramInstructions(compiled.*),
+        .statements_before = countProgramStatements(compiled.*),
+    };
+
+    var max_let_count: usize = compiled.frame.let_count;
+    for (compiled.layers) |layer| {
+        max_let_count = @max(max_let_count, layer.let_count);
+    }
+    const let_literals = try allocator.alloc(?f32, max_let_count);
+    @memset(let_literals, null);
+
+    var optimizer = Optimizer{
+        .allocator = allocator,
+        .report = &report,
+        .let_literals = let_literals,
+        .frame_literals = &.{},
+    };
+
+    const params = try allocator.alloc(CompiledParam, compiled.params.len);
+    for (compiled.params, 0..) |param, idx| {
+        const expr = try optimizer.simplifyExpr(param.expr);
+        params[idx] = .{
+            .expr = expr,
+            .depends_on_xy = compiledExprDependsOnXY(expr, params[0..idx]),
+        };
+    }
+    compiled.params = params;
+
+    compiled.frame.statements = try optimizer.foldStatements(compiled.frame.statements);
+    // Layers can only name top-level frame lets, and those slots are never shared with nested ones.
+    optimizer.frame_literals = try allocator.dupe(?f32, let_literals[0..compiled.frame.let_count]);
+
+    const layers = try allocator.alloc(CompiledLayer, compiled.layers.len);
+    for (compiled.layers, 0..) |layer, idx| {
+        @memset(let_literals, null);
+        layers[idx] = .{
+            .statements = try optimizer.foldStatements(layer.statements),
+            .let_count = layer.let_count,
+        };
+    }
+    compiled.layers = layers;
+
+    const slot_reads = try allocator.alloc(bool, max_let_count);
+    for (layers) |*layer| {
+        layer.statements = try eliminateDeadLets(allocator, layer.statements, null, slot_reads[0..layer.let_count], &report);
+    }
+    const layer_frame_reads = try allocator.alloc(bool, compiled.frame.let_count);
+    @memset(layer_frame_reads, false);
+    for (layers) |layer| {
+        markSlotReads(layer.statements, null, layer_frame_reads);
+    }
+    compiled.frame.statements = try eliminateDeadLets(
+        allocator,
+        compiled.frame.statements,
+        layer_frame_reads,
+        slot_reads[0..compiled.frame.let_count],
+        &report,
+    );
+
+    const statement_count = countProgramStatements(compiled.*);
+    const expression_count = compiled.params.len + countProgramStatementExprs(compiled.*);
+    optimizer.synthetic_budget = @min(
+        bytecode_max_statements -| statement_count,
+        bytecode_max_expressions -| expression_count,
+    );
+    compiled.frame.statements = try optimizer.eliminateCommonSubexpressions(compiled.frame.statements, &compiled.frame.let_count);
+    for (layers) |*layer| {
+        layer.statements = try optimizer.eliminateCommonSubexpressions(layer.statements, &layer.let_count);
+    }
+
+    report.instructions_after = countProgramInstructions(compiled.*);
+    report.statements_after = countProgramStatements(compiled.*);
+    return report;
+}
+
+const Optimizer = struct {
+    allocator: std.mem.Allocator,
+    report: *OptimizationReport,
+    /// Literal value of each let slot in the block being folded, null when not constant.
+    let_literals: []?f32,
+    frame_literals: []const ?f32,
+    synthetic_budget: usize = 0,
+
+    fn foldStatements(self: *Optimizer, statements: []const CompiledStatement) ![]const CompiledStatement {
+        var folded = std.ArrayList(CompiledStatement).empty;
+        try self.foldStatementsInto(&folded, statements);
+        return folded.toOwnedSlice(self.allocator);
+    }
+
+    fn foldStatementsInto(
+        self: *Optimizer,
+        folded: *std.ArrayList(CompiledStatement),
+        statements: []const CompiledStatement,
+    ) !void {
+        for (statements) |statement| {
+            switch (statement) {
+                .let_decl => |let_decl| {
+                    const expr = try self.simplifyExpr(let_decl.expr);
+                    // Every let slot has a single declaration in scope, so setting it here also
+                    // clears any literal left behind by a sibling branch that reused the slot.
+                    self.let_literals[let_decl.slot] = exprScalarLiteral(expr);
+                    try folded.append(self.allocator, .{ .let_decl = .{ .slot = let_decl.slot, .expr = expr } });
+                },
+                .blend => |blend_expr| {
+                    try folded.append(self.allocator, .{ .blend = try self.simplifyExpr(blend_expr) });
+                },
+                .out => |out_expr| {
+                    try folded.append(self.allocator, .{ .out = try self.simplifyExpr(out_expr) });
+                },
+                .if_stmt => |if_stmt| {
+                    const condition = try self.simplifyExpr(if_stmt.condition);
+                    if (exprScalarLiteral(condition)) |value| {
+                        // Branch slots are unique, so the taken branch can be spliced into this block.
+                        self.report.folded_constants += 1;
+                        try self.foldStatementsInto(folded, if (value > 0.0) if_stmt.then_statements else if_stmt.else_statements);
+                        continue;
+                    }
+                    try folded.append(self.allocator, .{ .if_stmt = .{
+                        .condition = condition,
+                        .then_statements = try self.foldStatements(if_stmt.then_statements),
+                        .else_statements = try self.foldStatements(if_stmt.else_statements),
+                    } });
+                },
+                .for_stmt => |for_stmt| {
+                    self.let_literals[for_stmt.index_slot] = null;
+                    try folded.append(self.allocator, .{ .for_stmt = .{
+                        .index_slot = for_stmt.index_slot,
+                        .start_inclusive = for_stmt.start_inclusive,
+                        .end_exclusive = for_stmt.end_exclusive,
+                        .statements = try self.foldStatements(for_stmt.statements),
+                    } });
+                },
+            }
+        }
+    }
+
+    fn simplifyExpr(self: *Optimizer, expr: *const CompiledExpr) !*const CompiledExpr {
+        const root = try buildExprTree(self.allocator, expr.instructions);
+        return finishExprTree(self.allocator, try self.simplifyNode(root));
+    }
+
+    fn simplifyNode(self: *Optimizer, node: *OptNode) !*OptNode {
+        for (node.args) |*arg| {
+            arg.* = try self.simplifyNode(arg.*);
+        }
+
+        switch (node.instruction) {
+            .push_literal => return node,
+            .push_slot => |slot| {
+                const literal: ?f32 = switch (slot) {
+                    .let_slot => |idx| self.let_literals[idx],
+                    .frame_let => |idx| if (idx < self.frame_literals.len) self.frame_literals[idx] else null,
+                    .input, .param => null,
+                };
+                if (literal) |value| return self.folded(node, value);
+                return node;
+            },
+            .negate => {
+                const operand = node.args[0];
+                if (nodeScalarLiteral(operand)) |value| return self.folded(node, -value);
+                if (operand.instruction == .negate) return self.simplified(operand.args[0]);
+                return node;
+            },
+            .add, .sub, .mul, .div, .mod => return self.simplifyBinary(node),
+            .call_builtin => |call| {
+                if (!isFoldableBuiltin(call.builtin)) return node;
+                var args: [4]RuntimeValue = undefined;
+                for (node.args, 0..) |arg, idx| {
+                    args[idx] = .{ .scalar = nodeScalarLiteral(arg) orelse return node };
+                }
+                // fminf/fmaxf may return either zero for min(-0.0, 0.0); leave that pair to the device.
+                if (node.args.len == 2 and args[0].scalar == 0.0 and args[1].scalar == 0.0 and
+                    std.math.signbit(args[0].scalar) != std.math.signbit(args[1].scalar)) return node;
+                const value = asScalar(evalBuiltin(call.builtin, args[0..node.args.len]));
+                if (!std.math.isFinite(value)) return node;
+                return self.folded(node, value);
+            },
+        }
+    }
+
+    fn simplifyBinary(self: *Optimizer, node: *OptNode) !*OptNode {
+        const lhs = node.args[0];
+        const rhs = node.args[1];
+        const lhs_literal = nodeScalarLiteral(lhs);
+        const rhs_literal = nodeScalarLiteral(rhs);
+        if (lhs_literal != null and rhs_literal != null) {
+            if (foldBinary(node.instruction, lhs_literal.?, rhs_literal.?)) |value| return self.folded(node, value);
+            return node;
+        }
+
+        switch (node.instruction) {
+            .add => {
+                // Only -0.0 is an exact additive identity: -0.0 + 0.0 is +0.0, so `x + 0.0` must stay.
+                if (rhs_literal) |value| {
+                    if (isNegativeZero(value)) return self.simplified(lhs);
+                }
+                if (lhs_literal) |value| {
+                    if (isNegativeZero(value)) return self.simplified(rhs);
+                }
+                if (rhs.instruction == .negate) return self.rewriteBinary(node, .sub, lhs, rhs.args[0]);
+                if (lhs.instruction == .negate) return self.rewriteBinary(node, .sub, rhs, lhs.args[0]);
+            },
+            .sub => {
+                // `x - 0.0` is exact; `0.0 - x` is not `-x` for x = +0.0, only `-0.0 - x` is.
+                if (rhs_literal) |value| {
+                    if (value == 0.0 and !std.math.signbit(value)) return self.simplified(lhs);
+                }
+                if (lhs_literal) |value| {
+                    if (isNegativeZero(value)) return self.rewriteNegate(node, rhs);
+                }
+                if (rhs.instruction == .negate) return self.rewriteBinary(node, .add, lhs, rhs.args[0]);
+            },
+            .mul => {
+                if (rhs_literal) |value| {
+                    if (value == 1.0) return self.simplified(lhs);
+                    if (value == -1.0) return self.rewriteNegate(node, lhs);
+                }
+                if (lhs_literal) |value| {
+                    if (value == 1.0) return self.simplified(rhs);
+                    if (value == -1.0) return self.rewriteNegate(node, rhs);
+                }
+                if (lhs.instruction == .negate and rhs.instruction == .negate) {
+                    return self.rewriteBinary(node, .mul, lhs.args[0], rhs.args[0]);
+                }
+            },
+            .div => {
+                if (rhs_literal) |value| {
+                    if (value == 1.0) return self.simplified(lhs);
+                    if (value == -1.0) return self.rewriteNegate(node, lhs);
+                    if (exactReciprocal(value)) |reciprocal| {
+                        // Division by a power of two is exactly a multiply, which is far cheaper on the ESP32.
+                        self.report.simplified_ops += 1;
+                        node.instruction = .mul;
+                        node.args[1] = try self.literalNode(reciprocal);
+                        return self.simplifyBinary(node);
+                    }
+                }
+                if (lhs.instruction == .negate and rhs.instruction == .negate) {
+                    return self.rewriteBinary(node, .div, lhs.args[0], rhs.args[0]);
+                }
+            },
+            .mod => {},
+            else => unreachable,
+        }
+        return node;
+    }
+
+    fn folded(self: *Optimizer, node: *OptNode, value: f32) *OptNode {
+        self.report.folded_constants += 1;
+        node.instruction = .{ .push_literal = .{ .scalar = value } };
+        node.args = node.args[0..0];
+        return node;
+    }
+
+    fn simplified(self: *Optimizer, node: *OptNode) *OptNode {
+        self.report.simplified_ops += 1;
+        return node;
+    }
+
+    fn rewriteBinary(self: *Optimizer, node: *OptNode, instruction: BytecodeInstruction, lhs: *OptNode, rhs: *OptNode) !*OptNode {
+        self.report.simplified_ops += 1;
+        node.instruction = instruction;
+        node.args[0] = lhs;
+        node.args[1] = rhs;
+        return self.simplifyBinary(node);
+    }
+
+    fn rewriteNegate(self: *Optimizer, node: *OptNode, operand: *OptNode) *OptNode {
+        self.report.simplified_ops += 1;
+        if (operand.instruction == .negate) return operand.args[0];
+        node.instruction = .negate;
+        node.args[0] = operand;
+        node.args = node.args[0..1];
+        return node;
+    }
+
+    fn literalNode(self: *Optimizer, value: f32) !*OptNode {
+        const node = try self.allocator.create(OptNode);
+        node.* = .{
+            .instruction = .{ .push_literal = .{ .scalar = value } },
+            .args = try self.allocator.alloc(*OptNode, 0),
+        };
+        return node;
+    }
+
+    fn eliminateCommonSubexpressions(
+        self: *Optimizer,
+        statements: []const CompiledStatement,
+        let_count: *usize,
+    ) ![]const CompiledStatement {
+        const allocator = self.allocator;
+        var entries = std.ArrayList(CseEntry).empty;
+        for (statements) |statement| {
+            const nested = try self.eliminateNestedCommonSubexpressions(statement, let_count);
+            const root = if (statementExpr(nested)) |expr| try buildExprTree(allocator, expr.instructions) else null;
+            try entries.append(allocator, .{ .statement = nested, .root = root });
+        }
+
+        var occurrences = std.ArrayList(CseOccurrence).empty;
+        var grouped = std.ArrayList(bool).empty;
+        while (true) {
+            occurrences.clearRetainingCapacity();
+            for (entries.items, 0..) |*entry, idx| {
+                if (entry.root) |*root| _ = try collectCseOccurrences(allocator, &occurrences, idx, root, true);
+            }
+            try grouped.resize(allocator, occurrences.items.len);
+            @memset(grouped.items, false);
+
+            const can_add_let = let_count.* < bytecode_max_let_slots and self.synthetic_budget > 0;
+            const candidate = findCseCandidate(entries.items, occurrences.items, grouped.items, can_add_let) orelse break;
+
+            const first = occurrences.items[candidate.index];
+            const representative = first.ref.*;
+            const slot = candidate.reuse_slot orelse blk: {
+                const new_slot = let_count.*;
+                let_count.* += 1;
+                self.synthetic_budget -= 1;
+                self.report.cse_lets += 1;
+                break :blk new_slot;
+            };
+            const slot_node = try allocator.create(OptNode);
+            slot_node.* = .{
+                .instruction = .{ .push_slot = .{ .let_slot = slot } },
+                .args = try allocator.alloc(*OptNode, 0),
+            };
+
+            for (occurrences.items[candidate.index..]) |occurrence| {
+                if (occurrence.hash != first.hash or occurrence.size != first.size) continue;
+                if (candidate.reuse_slot != null and occurrence.ref == first.ref) continue;
+                if (!exprTreesEqual(occurrence.ref.*, representative)) continue;
+                occurrence.ref.* = slot_node;
+                self.report.cse_replacements += 1;
+            }
+            if (candidate.reuse_slot == null) {
+                try entries.insert(allocator, first.entry_index, .{ .statement = null, .slot = slot, .root = representative });
+            }
+        }
+
+        var optimized = std.ArrayList(CompiledStatement).empty;
+        for (entries.items) |entry| {
+            const statement = entry.statement orelse {
+                try optimized.append(allocator, .{ .let_decl = .{
+                    .slot = entry.slot,
+                    .expr = try finishExprTree(allocator, entry.root.?),
+                } });
+                continue;
+            };
+            if (entry.root) |root| {
+                try optimized.append(allocator, withStatementExpr(statement, try finishExprTree(allocator, root)));
+            } else {
+                try optimized.append(allocator, statement);
+            }
+        }
+        return optimized.toOwnedSlice(allocator);
+    }
+
+    fn eliminateNestedCommonSubexpressions(
+        self: *Optimizer,
+        statement: CompiledStatement,
+        let_count: *usize,
+    ) !CompiledStatement {
+        return switch (statement) {
+            .if_stmt => |if_stmt| .{ .if_stmt = .{
+                .condition = if_stmt.condition,
+                .then_statements = try self.eliminateCommonSubexpressions(if_stmt.then_statements, let_count),
+                .else_statements = try self.eliminateCommonSubexpressions(if_stmt.else_statements, let_count),
+            } },
+            .for_stmt => |for_stmt| .{ .for_stmt = .{
+                .index_slot = for_stmt.index_slot,
+                .start_inclusive = for_stmt.start_inclusive,
+                .end_exclusive = for_stmt.end_exclusive,
+                .statements = try self.eliminateCommonSubexpressions(for_stmt.statements, let_count),
+            } },
+            else => statement,
+        };
+    }
+};
+
+/// Picks the repeated subtree whose replacement saves the most instructions. Occurrences are in
+/// statement order, so the first member of a group is where a synthetic let has to be placed.
+fn findCseCandidate(
+    entries: []const CseEntry,
+    occurrences: []const CseOccurrence,
+    grouped: []bool,
+    can_add_let: bool,
+) ?CseCandidate {
+    var best: ?CseCandidate = null;
+    var best_saved: usize = 0;
+    for (occurrences, 0..) |first, idx| {
+        if (grouped[idx]) continue;
+        var count: usize = 1;
+        for (occurrences[idx + 1 ..], idx + 1..) |other, other_idx| {
+            if (grouped[other_idx] or other.hash != first.hash or other.size != first.size) continue;
+            if (!exprTreesEqual(other.ref.*, first.ref.*)) continue;
+            grouped[other_idx] = true;
+            count += 1;
+        }
+        if (count < 2) continue;
+
+        const reuse_slot = if (first.is_root) letSlotOfEntry(entries[first.entry_index]) else null;
+        var saved: usize = 0;
+        if (reuse_slot != null) {
+            saved = (count - 1) * (first.size - 1);
+        } else if (can_add_let) {
+            const replaced = count * first.size;
+            const cost = first.size + count;
+            if (replaced < cost + cse_min_saved_instructions) continue;
+            saved = replaced - cost;
+        } else {
+            continue;
+        }
+        if (saved > best_saved) {
+            best_saved = saved;
+            best = .{ .index = idx, .reuse_slot = reuse_slot };
+        }
+    }
+    return best;
+}
+
+fn letSlotOfEntry(entry: CseEntry) ?usize {
+    const statement = entry.statement orelse return entry.slot;
+    return switch (statement) {
+        .let_decl => |let_decl| let_decl.slot,
+        else => null,
+    };
+}
+
+fn collectCseOccurrences(
+    allocator: std.mem.Allocator,
+    occurrences: *std.ArrayList(CseOccurrence),
+    entry_index: usize,
+    ref: **OptNode,
+    is_root: bool,
+) !struct { hash: u64, size: usize } {
+    const node = ref.*;
+    var hasher = std.hash.Wyhash.init(0);
+    hashInstruction(&hasher, node.instruction);
+    var size: usize = 1;
+    for (node.args) |*arg| {
+        const child = try collectCseOccurrences(allocator, occurrences, entry_index, arg, false);
+        std.hash.autoHash(&hasher, child.hash);
+        size += child.size;
+    }
+    const hash = hasher.final();
+    if (node.args.len > 0) {
+        try occurrences.append(allocator, .{
+            .entry_index = entry_index,
+            .ref = ref,
+            .hash = hash,
+            .size = size,
+            .is_root = is_root,
+        });
+    }
+    return .{ .hash = hash, .size = size };
+}
+
+fn hashInstruction(hasher: *std.hash.Wyhash, instruction: BytecodeInstruction) void {
+    std.hash.autoHash(hasher, std.meta.activeTag(instruction));
+    switch (instruction) {
+        .push_literal => |literal| hasher.update(runtimeValueBytes(&literal)),
+        .push_slot => |slot| std.hash.autoHash(hasher, slot),
+        .call_builtin => |call| std.hash.autoHash(hasher, call),
+        else => {},
+    }
+}
+
+fn runtimeValueBytes(value: *const RuntimeValue) []const u8 {
+    return switch (value.*) {
+        .scalar => |*scalar| std.mem.asBytes(scalar),
+        .vec2 => |*vec| std.mem.asBytes(vec),
+        .rgba => |*rgba| std.mem.asBytes(rgba),
+    };
+}
+
+fn exprTreesEqual(a: *const OptNode, b: *const OptNode) bool {
+    if (!instructionsEqual(a.instruction, b.instruction) or a.args.len != b.args.len) return false;
+    for (a.args, b.args) |lhs, rhs| {
+        if (!exprTreesEqual(lhs, rhs)) return false;
+    }
+    return true;
+}
+
+fn instructionsEqual(a: BytecodeInstruction, b: BytecodeInstruction) bool {
+    if (std.meta.activeTag(a) != std.meta.activeTag(b)) return false;
+    return switch (a) {
+        .push_literal => |literal| std.meta.activeTag(literal) == std.meta.activeTag(b.push_literal) and
+            std.mem.eql(u8, runtimeValueBytes(&literal), runtimeValueBytes(&b.push_literal)),
+        .push_slot => |slot| std.meta.eql(slot, b.push_slot),
+        .call_builtin => |call| std.meta.eql(call, b.call_builtin),
+        else => true,
+    };
+}
+
+fn buildExprTree(allocator: std.mem.Allocator, instructions: []const BytecodeInstruction) !*OptNode {
+    var stack = std.ArrayList(*OptNode).empty;
+    defer stack.deinit(allocator);
+    for (instructions) |instruction| {
+        const arity: usize = switch (instruction) {
+            .push_literal, .push_slot => 0,
+            .negate => 1,
+            .add, .sub, .mul, .div, .mod => 2,
+            .call_builtin => |call| call.arg_count,
+        };
+        const node = try allocator.create(OptNode);
+        node.* = .{
+            .instruction = instruction,
+            .args = try allocator.dupe(*OptNode, stack.items[stack.items.len - arity ..]),
+        };
+        stack.shrinkRetainingCapacity(stack.items.len - arity);
+        try stack.append(allocator, node);
+    }
+    if (stack.items.len != 1) return error.InvalidExpressionStack;
+    return stack.items[0];
+}
+
+fn finishExprTree(allocator: std.mem.Allocator, root: *const OptNode) !*const CompiledExpr {
+    var instructions = std.ArrayList(BytecodeInstruction).empty;
+    try emitExprTree(&instructions, allocator, root);
+
+    const owned = try instructions.toOwnedSlice(allocator);
+    const ptr = try allocator.create(CompiledExpr);
+    ptr.* = .{
+        .instructions = owned,
+        .max_stack_depth = computeExprMaxStackDepth(owned),
+    };
+    return ptr;
+}
+
+fn emitExprTree(instructions: *std.ArrayList(BytecodeInstruction), allocator: std.mem.Allocator, node: *const OptNode) !void {
+    for (node.args) |arg| {
+        try emitExprTree(instructions, allocator, arg);
+    }
+    try instructions.append(allocator, node.instruction);
+}
+
+fn nodeScalarLiteral(node: *const OptNode) ?f32 {
+    return switch (node.instruction) {
+        .push_literal => |literal| switch (literal) {
+            .scalar => |value| value,
+            else => null,
+        },
+        else => null,
+    };
+}
+
+fn exprScalarLiteral(expr: *const CompiledExpr) ?f32 {
+    if (expr.instructions.len != 1) return null;
+    return switch (expr.instructions[0]) {
+        .push_literal => |literal| switch (literal) {
+            .scalar => |value| value,
+            else => null,
+        },
+        else => null,
+    };
+}
+
+fn isNegativeZero(value: f32) bool {
+    return value == 0.0 and std.math.signbit(value);
+}
+
+fn foldBinary(instruction: BytecodeInstruction, lhs: f32, rhs: f32) ?f32 {
+    const value = switch (instruction) {
+        .add => lhs + rhs,
+        .sub => lhs - rhs,
+        .mul => lhs * rhs,
+        // The firmware guards division and modulo by zero; leave those to the device.
+        .div => if (rhs == 0.0) return null else lhs / rhs,
+        .mod => if (rhs == 0.0) return null else @rem(lhs, rhs),
+        else => unreachable,
+    };
+    return if (std.math.isFinite(value)) value else null;
+}
+
+/// Returns 1/value when value is a normal power of two, so `x / value == x * (1/value)` exactly.
+fn exactReciprocal(value: f32) ?f32 {
+    const bits: u32 = @bitCast(value);
+    const exponent = (bits >> 23) & 0xff;
+    if ((bits & 0x7fffff) != 0 or exponent <= 1 or exponent >= 253) return null;
+    return 1.0 / value;
+}
+
+fn isFoldableBuiltin(builtin: dsl_parser.BuiltinId) bool {
+    return switch (builtin) {
+        // The firmware computes these exactly too (fabsf/fminf/fmaxf), so folding cannot change a pixel.
+        .abs, .min, .max => true,
+        // The firmware uses its own fast approximations (dsl_fast_sinf, dsl_fast_floorf, ...) for these, so a
+        // host-folded value would differ from what the device computes. clamp also asserts lo <= hi on the host.
+        .sin, .cos, .sqrt, .ln, .log, .floor, .fract, .clamp, .smoothstep => false,
+        .wrapdx, .hash01, .hash_signed, .hash_coords01, .pow, .noise, .noise3 => false,
+        // Vector constructors/consumers never see all-scalar literal args, and phasor is stateful.
+        .circle, .box, .phasor, .vec2, .rgba => false,
+    };
+}
+
+fn statementExpr(statement: CompiledStatement) ?*const CompiledExpr {
+    return switch (statement) {
+        .let_decl => |let_decl| let_decl.expr,
+        .blend => |blend_expr| blend_expr,
+        .out => |out_expr| out_expr,
+        .if_stmt => |if_stmt| if_stmt.condition,
+        .for_stmt => null,
+    };
+}
+
+fn withStatementExpr(statement: CompiledStatement, expr: *const CompiledExpr) CompiledStatement {
+    return switch (statement) {
+        .let_decl => |let_decl| .{ .let_decl = .{ .slot = let_decl.slot, .expr = expr } },
+        .blend => .{ .blend = expr },
+        .out => .{ .out = expr },
+        .if_stmt => |if_stmt| .{ .if_stmt = .{
+            .condition = expr,
+            .then_statements = if_stmt.then_statements,
+            .else_statements = if_stmt.else_statements,
+        } },
+        .for_stmt => unreachable,
+    };
+}
+
+/// Removes lets whose slot is never read, plus if/for statements left without a body, until
+/// nothing changes. `external_reads` marks slots read from outside the block (frame lets read by layers).
+fn eliminateDeadLets(
+    allocator: std.mem.Allocator,
+    statements: []const CompiledStatement,
+    external_reads: ?[]const bool,
+    reads: []bool,
+    report: *OptimizationReport,
+) ![]const CompiledStatement {
+    var current = statements;
+    while (true) {
+        if (external_reads) |external| @memcpy(reads, external) else @memset(reads, false);
+        markSlotReads(current, reads, null);
+        var removed: usize = 0;
+        current = try removeDeadStatements(allocator, current, reads, &removed);
+        if (removed == 0) return current;
+        report.dead_statements += removed;
+    }
+}
+
+fn removeDeadStatements(
+    allocator: std.mem.Allocator,
+    statements: []const CompiledStatement,
+    reads: []const bool,
+    removed: *usize,
+) ![]const CompiledStatement {
+    var live = std.ArrayList(CompiledStatement).empty;
+    for (statements) |statement| {
+        switch (statement) {
+            .let_decl => |let_decl| {
+                if (!reads[let_decl.slot]) {
+                    removed.* += 1;
+                    continue;
+                }
+                try live.append(allocator, statement);
+            },
+            .blend, .out => try live.append(allocator, statement),
+            .if_stmt => |if_stmt| {
+                const then_statements = try removeDeadStatements(allocator, if_stmt.then_statements, reads, removed);
+                const else_statements = try removeDeadStatements(allocator, if_stmt.else_statements, reads, removed);
+                if (then_statements.len == 0 and else_statements.len == 0) {
+                    removed.* += 1;
+                    continue;
+                }
+                try live.append(allocator, .{ .if_stmt = .{
+                    .condition = if_stmt.condition,
+                    .then_statements = then_statements,
+                    .else_statements = else_statements,
+                } });
+            },
+            .for_stmt => |for_stmt| {
+                const body = try removeDeadStatements(allocator, for_stmt.statements, reads, removed);
+                if (body.len == 0 or for_stmt.start_inclusive >= for_stmt.end_exclusive) {
+                    removed.* += 1;
+                    continue;
+                }
+                try live.append(allocator, .{ .for_stmt = .{
+                    .index_slot = for_stmt.index_slot,
+                    .start_inclusive = for_stmt.start_inclusive,
+                    .end_exclusive = for_stmt.end_exclusive,
+                    .statements = body,
+                } });
+            },
+        }
+    }
+    return live.toOwnedSlice(allocator);
+}
+
+fn markSlotReads(statements: []const CompiledStatement, let_reads: ?[]bool, frame_reads: ?[]bool) void {
+    for (statements) |statement| {
+        if (statementExpr(statement)) |expr| {
+            for (expr.instructions) |instruction| {
+                switch (instruction) {
+                    .push_slot => |slot| switch (slot) {
+                        .let_slot => |idx| if (let_reads) |reads| {
+                            reads[idx] = true;
+                        },
+                        .frame_let => |idx| if (frame_reads) |reads| {
+                            reads[idx] = true;
+                        },
+                        else => {},
+                    },
+                    else => {},
+                }
+            }
+        }
+        switch (statement) {
+            .if_stmt => |if_stmt| {
+                markSlotReads(if_stmt.then_statements, let_reads, frame_reads);
+                markSlotReads(if_stmt.else_statements, let_reads, frame_reads);
+            },
+            .for_stmt => |for_stmt| markSlotReads(for_stmt.statements, let_reads, frame_reads),
+            else => {},
+        }
+    }
+}
+
+fn countProgramInstructions(compiled: CompiledProgram) usize {
+    var count: usize = 0;
+    for (compiled.params) |param| {
+        count += param.expr.instructions.len;
+    }
+    count += countStatementInstructions(compiled.frame.statements);
+    for (compiled.layers) |layer| {
+        count += countStatementInstructions(layer.statements);
+    }
+    return count;
+}
+
+fn countStatementInstructions(statements: []const CompiledStatement) usize {
+    var count: usize = 0;
+    for (statements) |statement| {
+        if (statementExpr(statement)) |expr| count += expr.instructions.len;
+        switch (statement) {
+            .if_stmt => |if_stmt| count += countStatementInstructions(if_stmt.then_statements) +
+                countStatementInstructions(if_stmt.else_statements),
+            .for_stmt => |for_stmt| count += countStatementInstructions(for_stmt.statements),
+            else => {},
+        }
+    }
+    return count;
+}
+
+fn countProgramStatements(compiled: CompiledProgram) usize {
+    var count = countStatements(compiled.frame.statements, false);
+    for (compiled.layers) |layer| {
+        count += countStatements(layer.statements, false);
+    }
+    return count;
+}
+
+fn countProgramStatementExprs(compiled: CompiledProgram) usize {
+    var count = countStatements(compiled.frame.statements, true);
+    for (compiled.layers) |layer| {
+        count += countStatements(layer.statements, true);
+    }
+    return count;
+}
+
+fn countStatements(statements: []const CompiledStatement, only_with_expr: bool) usize {
+    var count: usize = 0;
+    for (statements) |statement| {
+        if (!only_with_expr or statementExpr(statement) != null) count += 1;
+        switch (statement) {
+            .if_stmt => |if_stmt| count += countStatements(if_stmt.then_statements, only_with_expr) +
+                countStatements(if_stmt.else_statements, only_with_expr),
+            .for_stmt => |for_stmt| count += countStatements(for_stmt.statements, only_with_expr),
+            else => {},
+        }
+    }
+    return count;
+}
+
 fn serializeCompiledProgram(writer: anytype, compiled: CompiledProgram) !void {
     try writeU32(writer, try asU32(compiled.params.len));
     for (compiled.params) |param| {
@@ -1329,6 +2159,112 @@ test "Evaluator supports frame block, for-range, and if statements" {
     try std.testing.expectApproxEqAbs(@as(f32, 1.0), color.a, 0.0001);
 }
 
+test "Evaluator optimizes folded, dead, and repeated expressions" {
+    const source =
+        \\effect optimized
+        \\layer l {
+        \\  let unused = sin(x)
+        \\  let k = 6.0 * 2.0 / 3.0
+        \\  let w = sin(x * 0.1 + time) * 0.25 + sin(x * 0.1 + time) * 0.25
+        \\  blend rgba(w + 0.5, k * 0.1, 0.0, 1.0)
+        \\}
+        \\emit
+    ;
+
+    var arena = std.heap.ArenaAllocator.init(std.testing.allocator);
+    defer arena.deinit();
+
+    const program = try dsl_parser.parseAndValidate(arena.allocator(), source);
+    var evaluator = try Evaluator.init(std.testing.allocator, program);
+    defer evaluator.deinit();
+
+    const report = evaluator.optimization;
+    try std.testing.expect(report.instructions_after < report.instructions_before);
+    try std.testing.expect(report.folded_constants > 0);
+    try std.testing.expectEqual(@as(usize, 2), report.dead_statements);
+    try std.testing.expectEqual(@as(usize, 1), report.cse_lets);
+    try std.testing.expectEqual(@as(usize, 2), report.cse_replacements);
+
+    const color = try evaluator.evaluatePixel(.{
+        .time = 0.3,
+        .frame = 0.0,
+        .x = 2.0,
+        .y = 0.5,
+        .width = 30.0,
+        .height = 40.0,
+        .seed = 0.42,
+    });
+
+    try std.testing.expectApproxEqAbs(@sin(@as(f32, 0.5)) * 0.5 + 0.5, color.r, 0.0001);
+    try std.testing.expectApproxEqAbs(@as(f32, 0.4), color.g, 0.0001);
+    try std.testing.expectApproxEqAbs(@as(f32, 0.0), color.b, 0.0001);
+}
+
+test "Evaluator optimizer keeps chained literal offsets and scales in source order" {
+    const source =
+        \\effect chained
+        \\layer l {
+        \\  blend rgba((x * 0.01 + 0.1) + 0.2, (x * 0.7) * 0.9, 0.0, 1.0)
+        \\}
+        \\emit
+    ;
+
+    var arena = std.heap.ArenaAllocator.init(std.testing.allocator);
+    defer arena.deinit();
+
+    const program = try dsl_parser.parseAndValidate(arena.allocator(), source);
+    var evaluator = try Evaluator.init(std.testing.allocator, program);
+    defer evaluator.deinit();
+
+    const color = try evaluator.evaluatePixel(.{
+        .time = 0.0,
+        .frame = 0.0,
+        .x = 3.0,
+        .y = 0.0,
+        .width = 30.0,
+        .height = 40.0,
+        .seed = 0.42,
+    });
+
+    // At x = 3 both chains round differently from x * 0.01 + 0.3 and x * 0.63, so they must not be folded.
+    const x: f32 = 3.0;
+    try std.testing.expectEqual((x * @as(f32, 0.01) + @as(f32, 0.1)) + @as(f32, 0.2), color.r);
+    try std.testing.expectEqual((x * @as(f32, 0.7)) * @as(f32, 0.9), color.g);
+}
+
+test "Evaluator optimizer folds only builtins the firmware computes exactly" {
+    const source =
+        \\effect builtins
+        \\layer l {
+        \\  blend rgba(sin(0.5), abs(0.25 - 0.5), 0.0, 1.0)
+        \\}
+        \\emit
+    ;
+
+    var arena = std.heap.ArenaAllocator.init(std.testing.allocator);
+    defer arena.deinit();
+
+    const program = try dsl_parser.parseAndValidate(arena.allocator(), source);
+    var evaluator = try Evaluator.init(std.testing.allocator, program);
+    defer evaluator.deinit();
+
+    // sin(0.5) must reach the device, which evaluates it with its own approximation; abs folds to 0.25.
+    var sin_calls: usize = 0;
+    var abs_calls: usize = 0;
+    for (evaluator.compiled.layers[0].statements[0].blend.instructions) |instruction| {
+        switch (instruction) {
+            .call_builtin => |call| switch (call.builtin) {
+                .sin => sin_calls += 1,
+                .abs => abs_calls += 1,
+                else => {},
+            },
+            else => {},
+        }
+    }
+    try std.testing.expectEqual(@as(usize, 1), sin_calls);
+    try std.testing.expectEqual(@as(usize, 0), abs_calls);
+}
+
 test "renderFrame evaluates params and layers per pixel" {
     const source =
         \\effect gradient
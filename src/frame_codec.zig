@@ -0,0 +1,268 @@
+const std = @import("std");
+
+/// Raw bindings to the firmware's frame payload decoder (`esp32_firmware/main/fw_frame_codec.c`), so the
+/// simulator and tests decode exactly like the pillar. Encoding only happens on the host and lives here.
+pub const c = @cImport({
+    @cInclude("fw_frame_codec.h");
+});
+
+pub const Error = error{InvalidEncodedFrame};
+
+/// Set in the pixel format byte (v2 header, v4 hello) when every frame payload is encoded.
+pub const format_flag: u8 = c.FW_FRAME_CODEC_FORMAT_FLAG;
+/// `u32 BE body_len` + encoding byte in front of every encoded payload.
+pub const prefix_len: usize = c.FW_FRAME_CODEC_PREFIX_LEN;
+
+pub const Encoding = enum(u8) {
+    raw = c.FW_FRAME_CODEC_RAW,
+    xor_rle = c.FW_FRAME_CODEC_XOR_RLE,
+    spans = c.FW_FRAME_CODEC_SPANS,
+    _,
+};
+
+pub const Prefix = struct {
+    encoding: Encoding,
+    body_len: u32,
+};
+
+pub const Encoded = struct {
+    encoding: Encoding,
+    len: usize,
+};
+
+const max_run: usize = 128;
+const span_header_len: usize = 4;
+const max_span_pixels: usize = std.math.maxInt(u16);
+
+pub fn writePrefix(prefix: *[prefix_len]u8, encoding: Encoding, body_len: u32) void {
+    std.mem.writeInt(u32, prefix[0..4], body_len, .big);
+    prefix[4] = @intFromEnum(encoding);
+}
+
+pub fn parsePrefix(prefix: *const [prefix_len]u8) Prefix {
+    return .{
+        .encoding = @enumFromInt(prefix[4]),
+        .body_len = std.mem.readInt(u32, prefix[0..4], .big),
+    };
+}
+
+/// Apply one encoded body to `frame`, the previous frame of the connection. On error `frame` is partially
+/// updated and no longer a valid reference.
+pub fn decode(encoding: Encoding, body: []const u8, frame: []u8, bytes_per_pixel: usize) Error!void {
+    const status = c.fw_frame_codec_decode(@intFromEnum(encoding), body.ptr, body.len, frame.ptr, frame.len, @intCast(bytes_per_pixel));
+    if (status != 0) return error.InvalidEncodedFrame;
+}
+
+/// Encode `frame` with the smallest encoding: raw when there is no `previous` frame on the receiver or
+/// when no delta beats it. `out` and `scratch` must each hold `frame.len` bytes; the body ends up in `out`.
+pub fn encodeFrame(previous: ?[]const u8, frame: []const u8, bytes_per_pixel: usize, out: []u8, scratch: []u8) Encoded {
+    if (previous) |reference| {
+        const xor_len = encodeXorRle(reference, frame, out[0..frame.len]);
+        const limit = xor_len orelse frame.len;
+        if (encodeSpans(reference, frame, bytes_per_pixel, scratch[0..limit])) |spans_len| {
+            if (spans_len < limit) {
+                @memcpy(out[0..spans_len], scratch[0..spans_len]);
+                return .{ .encoding = .spans, .len = spans_len };
+            }
+        }
+        if (xor_len) |len| {
+            if (len < frame.len) return .{ .encoding = .xor_rle, .len = len };
+        }
+    }
+    @memcpy(out[0..frame.len], frame);
+    return .{ .encoding = .raw, .len = frame.len };
+}
+
+/// Run-length code `frame XOR previous` into `out`; null when it does not fit. Unchanged trailing bytes
+/// are left out, so an unchanged frame encodes to an empty body.
+pub fn encodeXorRle(previous: []const u8, frame: []const u8, out: []u8) ?usize {
+    std.debug.assert(previous.len == frame.len);
+    var end = frame.len;
+    while (end > 0 and frame[end - 1] == previous[end - 1]) end -= 1;
+
+    var len: usize = 0;
+    var i: usize = 0;
+    while (i < end) {
+        if (len >= out.len) return null;
+        if (frame[i] == previous[i]) {
+            const run = @min(unchangedRun(previous, frame, i, end), max_run);
+            out[len] = 0x80 | @as(u8, @intCast(run - 1));
+            len += 1;
+            i += run;
+            continue;
+        }
+
+        // Keep gaps of up to two unchanged bytes inside the literal: ending it there costs a skip and
+        // a new literal control byte.
+        var run: usize = 1;
+        while (i + run < end and run < max_run) {
+            if (frame[i + run] != previous[i + run]) {
+                run += 1;
+                continue;
+            }
+            const gap = unchangedRun(previous, frame, i + run, end);
+            if (gap > 2 or run + gap >= max_run) break;
+            run += gap;
+        }
+        if (out.len - len < 1 + run) return null;
+        out[len] = @intCast(run - 1);
+        for (out[len + 1 ..][0..run], frame[i..][0..run], previous[i..][0..run]) |*dst, new, old| dst.* = new ^ old;
+        len += 1 + run;
+        i += run;
+    }
+    return len;
+}
+
+/// Write the changed pixels of `frame` as `{first_pixel, pixel_count, pixels}` spans into `out`; null
+/// when they do not fit. Short unchanged gaps are bridged when that is cheaper than a new span header.
+pub fn encodeSpans(previous: []const u8, frame: []const u8, bytes_per_pixel: usize, out: []u8) ?usize {
+    std.debug.assert(previous.len == frame.len);
+    const pixel_count = frame.len / bytes_per_pixel;
+
+    var len: usize = 0;
+    var pixel: usize = 0;
+    while (pixel < pixel_count) {
+        if (!pixelChanged(previous, frame, bytes_per_pixel, pixel)) {
+            pixel += 1;
+            continue;
+        }
+        if (pixel > std.math.maxInt(u16)) return null;
+
+        const first = pixel;
+        var last = pixel;
+        var next = pixel + 1;
+        while (next < pixel_count and next - first < max_span_pixels) : (next += 1) {
+            if (pixelChanged(previous, frame, bytes_per_pixel, next)) {
+                last = next;
+            } else if ((next - last) * bytes_per_pixel > span_header_len) {
+                break;
+            }
+        }
+
+        const count = last - first + 1;
+        const bytes = count * bytes_per_pixel;
+        if (out.len - len < span_header_len + bytes) return null;
+        std.mem.writeInt(u16, out[len..][0..2], @intCast(first), .big);
+        std.mem.writeInt(u16, out[len + 2 ..][0..2], @intCast(count), .big);
+        @memcpy(out[len + span_header_len ..][0..bytes], frame[first * bytes_per_pixel ..][0..bytes]);
+        len += span_header_len + bytes;
+        pixel = last + 1;
+    }
+    return len;
+}
+
+fn unchangedRun(previous: []const u8, frame: []const u8, start: usize, end: usize) usize {
+    var i = start;
+    while (i < end and frame[i] == previous[i]) i += 1;
+    return i - start;
+}
+
+fn pixelChanged(previous: []const u8, frame: []const u8, bytes_per_pixel: usize, pixel: usize) bool {
+    const offset = pixel * bytes_per_pixel;
+    return !std.mem.eql(u8, previous[offset..][0..bytes_per_pixel], frame[offset..][0..bytes_per_pixel]);
+}
+
+fn expectRoundTrip(previous: []const u8, frame: []const u8, bytes_per_pixel: usize) !Encoded {
+    var out: [1200]u8 = undefined;
+    var scratch: [1200]u8 = undefined;
+    const encoded = encodeFrame(previous, frame, bytes_per_pixel, &out, &scratch);
+    try std.testing.expect(encoded.len <= frame.len);
+
+    var decoded: [1200]u8 = undefined;
+    @memcpy(decoded[0..previous.len], previous);
+    try decode(encoded.encoding, out[0..encoded.len], decoded[0..frame.len], bytes_per_pixel);
+    try std.testing.expectEqualSlices(u8, frame, decoded[0..frame.len]);
+    return encoded;
+}
+
+test "encodeFrame sends raw without a reference and an empty delta for an unchanged frame" {
+    var frame: [30]u8 = undefined;
+    for (&frame, 0..) |*byte, i| byte.* = @intCast(i * 7);
+    var out: [30]u8 = undefined;
+    var scratch: [30]u8 = undefined;
+
+    const first = encodeFrame(null, &frame, 3, &out, &scratch);
+    try std.testing.expectEqual(Encoding.raw, first.encoding);
+    try std.testing.expectEqualSlices(u8, &frame, out[0..first.len]);
+
+    const unchanged = try expectRoundTrip(&frame, &frame, 3);
+    try std.testing.expectEqual(@as(usize, 0), unchanged.len);
+}
+
+test "encodeFrame picks spans for a few changed pixels and xor_rle for scattered small changes" {
+    var previous: [1200]u8 = @splat(40);
+    var frame = previous;
+    // Two changed pixels far apart: two 7-byte spans beat XOR literals plus one skip per 128 bytes.
+    frame[30..33].* = .{ 1, 2, 3 };
+    frame[1140..1143].* = .{ 4, 5, 6 };
+    const sparse = try expectRoundTrip(&previous, &frame, 3);
+    try std.testing.expectEqual(Encoding.spans, sparse.encoding);
+    try std.testing.expectEqual(@as(usize, 2 * (span_header_len + 3)), sparse.len);
+
+    // One channel drifting on every other pixel: bridging the gaps, a span would resend every byte.
+    frame = previous;
+    var i: usize = 0;
+    while (i < frame.len) : (i += 6) frame[i] += 1;
+    const dense = try expectRoundTrip(&previous, &frame, 3);
+    try std.testing.expectEqual(Encoding.xor_rle, dense.encoding);
+    try std.testing.expect(dense.len < frame.len);
+
+    // Noise falls back to raw.
+    var prng = std.Random.DefaultPrng.init(7);
+    prng.random().bytes(&previous);
+    prng.random().bytes(&frame);
+    try std.testing.expectEqual(Encoding.raw, (try expectRoundTrip(&previous, &frame, 3)).encoding);
+}
+
+test "every encoding round-trips through the firmware decoder" {
+    var prng = std.Random.DefaultPrng.init(0x1ed5);
+    const random = prng.random();
+    var previous: [480]u8 = undefined;
+    var frame: [480]u8 = undefined;
+    var out: [480]u8 = undefined;
+    var decoded: [480]u8 = undefined;
+
+    for (0..200) |round| {
+        const bytes_per_pixel: usize = if (round % 2 == 0) 3 else 4;
+        random.bytes(&previous);
+        frame = previous;
+        // From a handful of changed bytes up to most of the frame, including runs longer than 128.
+        const changes = random.uintLessThan(usize, 400);
+        for (0..changes) |_| {
+            const at = random.uintLessThan(usize, frame.len);
+            const run = @min(random.uintLessThan(usize, 200) + 1, frame.len - at);
+            for (frame[at..][0..run]) |*byte| byte.* +%= 1;
+        }
+
+        if (encodeXorRle(&previous, &frame, &out)) |len| {
+            decoded = previous;
+            try decode(.xor_rle, out[0..len], &decoded, bytes_per_pixel);
+            try std.testing.expectEqualSlices(u8, &frame, &decoded);
+        }
+        if (encodeSpans(&previous, &frame, bytes_per_pixel, &out)) |len| {
+            decoded = previous;
+            try decode(.spans, out[0..len], &decoded, bytes_per_pixel);
+            try std.testing.expectEqualSlices(u8, &frame, &decoded);
+        }
+    }
+}
+
+test "decoder rejects bodies that run past the frame" {
+    var frame: [12]u8 = @splat(0);
+    // Skip 13 bytes of a 12-byte frame.
+    try std.testing.expectError(error.InvalidEncodedFrame, decode(.xor_rle, &.{0x8c}, &frame, 3));
+    // Literal of 3 bytes with only 2 present.
+    try std.testing.expectError(error.InvalidEncodedFrame, decode(.xor_rle, &.{ 0x02, 1, 2 }, &frame, 3));
+    // Span of pixels 3..4 in a 4-pixel frame.
+    try std.testing.expectError(error.InvalidEncodedFrame, decode(.spans, &.{ 0, 3, 0, 2, 1, 2, 3, 4, 5, 6 }, &frame, 3));
+    // Truncated span header.
+    try std.testing.expectError(error.InvalidEncodedFrame, decode(.spans, &.{ 0, 1 }, &frame, 3));
+    try std.testing.expectError(error.InvalidEncodedFrame, decode(.raw, &.{ 1, 2, 3 }, &frame, 3));
+    try std.testing.expectError(error.InvalidEncodedFrame, decode(@enumFromInt(9), &.{}, &frame, 3));
+
+    var prefix: [prefix_len]u8 = undefined;
+    writePrefix(&prefix, .spans, 1234);
+    const parsed = parsePrefix(&prefix);
+    try std.testing.expectEqual(Encoding.spans, parsed.encoding);
+    try std.testing.expectEqual(@as(u32, 1234), parsed.body_len);
+}
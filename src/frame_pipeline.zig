@@ -0,0 +1,136 @@
+const std = @import("std");
+const builtin = @import("builtin");
+
+/// Raw bindings to the firmware's render/output frame pipeline (`esp32_firmware/main/fw_frame_pipeline.c`).
+/// On the host the output stage is a pthread, so the pipeline runs against a mock output instead of RMT.
+pub const c = @cImport({
+    @cInclude("fw_frame_pipeline.h");
+});
+
+pub const Error = error{
+    FramePipelineCreateFailed,
+    FrameOutputFailed,
+};
+
+pub const Stats = c.fw_frame_pipeline_stats_t;
+
+/// Owns one pipeline: two frame buffers plus the output stage thread.
+pub const Pipeline = struct {
+    handle: *c.fw_frame_pipeline_t,
+    frame_len: usize,
+
+    /// `outputFn(output, frame)` runs on the output stage; `output` must outlive the pipeline.
+    /// A non-zero return is reported by the next `submit` or `flush`.
+    pub fn init(frame_len: usize, output: anytype, comptime outputFn: fn (@TypeOf(output), []const u8) c_int) Error!Pipeline {
+        const Context = @TypeOf(output);
+        const Trampoline = struct {
+            fn call(ctx: ?*anyopaque, frame: [*c]const u8, len: usize) callconv(.c) c_int {
+                const typed: Context = @ptrCast(@alignCast(ctx.?));
+                return outputFn(typed, frame[0..len]);
+            }
+        };
+        const handle = c.fw_frame_pipeline_create(frame_len, &Trampoline.call, @ptrCast(output), 0) orelse
+            return error.FramePipelineCreateFailed;
+        return .{ .handle = handle, .frame_len = frame_len };
+    }
+
+    /// Drains queued frames, then stops the output stage.
+    pub fn deinit(self: *Pipeline) void {
+        c.fw_frame_pipeline_destroy(self.handle);
+    }
+
+    /// Next buffer to render into; waits while the output stage still owns it.
+    pub fn acquire(self: *Pipeline) []u8 {
+        return c.fw_frame_pipeline_acquire(self.handle)[0..self.frame_len];
+    }
+
+    /// Queue the last acquired buffer for output without waiting for it.
+    pub fn submit(self: *Pipeline) Error!void {
+        if (c.fw_frame_pipeline_submit(self.handle) != 0) return error.FrameOutputFailed;
+    }
+
+    /// Wait until every submitted frame has been output.
+    pub fn flush(self: *Pipeline) Error!void {
+        if (c.fw_frame_pipeline_flush(self.handle) != 0) return error.FrameOutputFailed;
+    }
+
+    pub fn stats(self: *Pipeline) Stats {
+        var out: Stats = undefined;
+        c.fw_frame_pipeline_get_stats(self.handle, &out);
+        return out;
+    }
+};
+
+/// Host stand-in for the LED output stage: takes `transmit_ns` per frame like an RMT
+/// transfer and records the frame tag (first two bytes) of everything it outputs.
+pub const MockOutput = struct {
+    transmit_ns: u64 = 0,
+    fail_at: ?usize = null,
+    tags: [256]u16 = @splat(0),
+    count: usize = 0,
+    /// Buffer currently inside the output call, so a test can check the renderer never gets it.
+    busy_buffer: std.atomic.Value(usize) = .init(0),
+
+    pub fn output(self: *MockOutput, frame: []const u8) c_int {
+        self.busy_buffer.store(@intFromPtr(frame.ptr), .seq_cst);
+        defer self.busy_buffer.store(0, .seq_cst);
+        if (self.transmit_ns > 0) std.Thread.sleep(self.transmit_ns);
+        if (self.count < self.tags.len) self.tags[self.count] = std.mem.readInt(u16, frame[0..2], .little);
+        self.count += 1;
+        if (self.fail_at) |fail_at| {
+            if (self.count == fail_at) return 7;
+        }
+        return 0;
+    }
+};
+
+test "pipeline outputs frames in order while the next one renders" {
+    if (builtin.os.tag == .windows) return error.SkipZigTest;
+
+    var mock = MockOutput{ .transmit_ns = 2 * std.time.ns_per_ms };
+    var pipeline = try Pipeline.init(64, &mock, MockOutput.output);
+    defer pipeline.deinit();
+
+    const frame_count = 20;
+    var overlapped_frames: usize = 0;
+    for (0..frame_count) |i| {
+        const frame = pipeline.acquire();
+        // The renderer never gets the buffer the output stage is reading.
+        try std.testing.expect(mock.busy_buffer.load(.seq_cst) != @intFromPtr(frame.ptr));
+        if (mock.busy_buffer.load(.seq_cst) != 0) overlapped_frames += 1;
+        std.Thread.sleep(2 * std.time.ns_per_ms);
+        std.mem.writeInt(u16, frame[0..2], @intCast(i), .little);
+        try pipeline.submit();
+    }
+    try pipeline.flush();
+
+    try std.testing.expectEqual(@as(usize, frame_count), mock.count);
+    for (0..frame_count) |i| try std.testing.expectEqual(@as(u16, @intCast(i)), mock.tags[i]);
+    try std.testing.expect(overlapped_frames > 0);
+
+    const stats = pipeline.stats();
+    try std.testing.expectEqual(@as(u32, frame_count), stats.frames_submitted);
+    try std.testing.expectEqual(@as(u32, frame_count), stats.frames_output);
+    try std.testing.expect(stats.output_us > 0.0);
+    try std.testing.expect(stats.latency_us >= stats.output_us);
+}
+
+test "pipeline reports an output error once on the next submit or flush" {
+    var mock = MockOutput{ .fail_at = 2 };
+    var pipeline = try Pipeline.init(16, &mock, MockOutput.output);
+    defer pipeline.deinit();
+
+    var failures: usize = 0;
+    for (0..4) |_| {
+        _ = pipeline.acquire();
+        pipeline.submit() catch {
+            failures += 1;
+        };
+    }
+    pipeline.flush() catch {
+        failures += 1;
+    };
+    try std.testing.expectEqual(@as(usize, 1), failures);
+    try std.testing.expectEqual(@as(usize, 4), mock.count);
+    try pipeline.flush();
+}
@@ -11,6 +11,20 @@ const EffectKind = enum {
     firmware_upload,
     native_shader_activate,
     stop,
+    set_params,
+};
+
+/// Most `name=value` assignments one `params` invocation takes; the VM holds at most 64 params.
+const max_param_assignments = 64;
+
+/// A `params` assignment: the key is a param index, or a name the pillar (native shaders) or
+/// `--dsl` (uploaded bytecode) resolves.
+const ParamAssignment = struct {
+    key: union(enum) {
+        index: u8,
+        name: []const u8,
+    },
+    value: f32,
 };
 
 const RunConfig = struct {
@@ -22,6 +36,20 @@ const RunConfig = struct {
     bytecode_file_path: ?[]const u8 = null,
     firmware_file_path: ?[]const u8 = null,
     shader_name: ?[]const u8 = null,
+    opt_report: bool = false,
+    /// `--window <n>`: stream frames with protocol v4 and up to n frames in flight (0 = v2).
+    stream_window: u16 = 0,
+    /// `--compress`: send frames as deltas against the previous frame.
+    compress: bool = false,
+    /// `--udp`: stream frames as protocol v5 datagrams; late frames are dropped by the receiver.
+    transport: led.tcp_client.Transport = .tcp,
+    /// `--present-delay <ms>`: have the receiver show each frame this long after it was scheduled (needs `--window`).
+    presentation_delay_ms: u16 = 0,
+    /// `bytecode-upload --crossfade <ms>`: fade from the running bytecode shader to the new one.
+    crossfade_ms: u16 = 0,
+    /// `params` assignments from the command line; none means read them from stdin.
+    param_assignments: [max_param_assignments]ParamAssignment = undefined,
+    param_assignment_count: usize = 0,
 };
 
 const v3_protocol_version: u8 = 0x03;
@@ -31,7 +59,9 @@ const v3_cmd_query_default_hook: u8 = 0x05;
 const v3_cmd_upload_firmware: u8 = 0x06;
 const v3_cmd_activate_native_shader: u8 = 0x07;
 const v3_cmd_stop_shader: u8 = 0x08;
+const v3_cmd_set_params: u8 = 0x09;
 const v3_response_flag: u8 = 0x80;
+const v3_param_by_name: u8 = 0xff;
 
 pub fn main() !void {
     shutdown_requested.store(false, .seq_cst);
@@ -64,11 +94,12 @@ pub fn main() !void {
             run_config.host,
             run_config.port,
             run_config.bytecode_file_path orelse return error.MissingBytecodePath,
+            run_config.crossfade_ms,
         );
         return;
     }
     if (run_config.effect == .dsl_compile) {
-        try runDslCompileOnly(run_config.dsl_file_path orelse return error.MissingDslPath);
+        try runDslCompileOnly(run_config.dsl_file_path orelse return error.MissingDslPath, run_config.opt_report);
         return;
     }
     if (run_config.effect == .firmware_upload) {
@@ -87,6 +118,15 @@ pub fn main() !void {
         try runShaderStop(run_config.host, run_config.port);
         return;
     }
+    if (run_config.effect == .set_params) {
+        try runSetParams(
+            run_config.host,
+            run_config.port,
+            run_config.dsl_file_path,
+            run_config.param_assignments[0..run_config.param_assignment_count],
+        );
+        return;
+    }
 
     var client = try led.TcpClient.init(std.heap.page_allocator, .{
         .host = run_config.host,
@@ -95,6 +135,10 @@ pub fn main() !void {
         .height = led.display_height,
         .frame_rate_hz = run_config.frame_rate_hz,
         .pixel_format = .rgb,
+        .stream_window = run_config.stream_window,
+        .compress = run_config.compress,
+        .transport = run_config.transport,
+        .presentation_delay_us = @as(u32, run_config.presentation_delay_ms) * std.time.us_per_ms,
     });
     defer client.deinit();
 
@@ -124,10 +168,11 @@ pub fn main() !void {
         .firmware_upload => unreachable,
         .native_shader_activate => unreachable,
         .stop => unreachable,
+        .set_params => unreachable,
     }
 }
 
-fn runBytecodeUpload(host: []const u8, port: u16, bytecode_file_path: []const u8) !void {
+fn runBytecodeUpload(host: []const u8, port: u16, bytecode_file_path: []const u8, crossfade_ms: u16) !void {
     std.debug.print("Preparing bytecode upload...\n", .{});
     const input_is_dsl = std.mem.endsWith(u8, bytecode_file_path, ".dsl");
     var compiled_payload = std.ArrayList(u8).empty;
@@ -190,7 +235,14 @@ fn runBytecodeUpload(host: []const u8, port: u16, bytecode_file_path: []const u8
     }
 
     std.debug.print("Activating uploaded shader (cmd=0x02)...\n", .{});
-    try writeV3Header(&stream, v3_cmd_activate_shader, 0);
+    if (crossfade_ms > 0) {
+        var crossfade_payload: [2]u8 = undefined;
+        std.mem.writeInt(u16, &crossfade_payload, crossfade_ms, .big);
+        try writeV3Header(&stream, v3_cmd_activate_shader, crossfade_payload.len);
+        try stream.writeAll(&crossfade_payload);
+    } else {
+        try writeV3Header(&stream, v3_cmd_activate_shader, 0);
+    }
     const activate_response = try readV3StatusResponse(&reader, v3_cmd_activate_shader);
     if (activate_response.status != 0) {
         std.debug.print("Shader activation failed: v3 status={d} ({s})\n", .{ activate_response.status, v3StatusName(activate_response.status) });
@@ -320,13 +372,139 @@ fn runShaderStop(host: []const u8, port: u16) !void {
     std.debug.print("Shader stopped and display cleared.\n", .{});
 }
 
+/// Send SET_PARAMS for the given assignments, or for each stdin line of whitespace-separated
+/// assignments until EOF so an external controller can pipe in changes at frame rate.
+fn runSetParams(host: []const u8, port: u16, dsl_file_path: ?[]const u8, assignments: []const ParamAssignment) !void {
+    var arena = std.heap.ArenaAllocator.init(std.heap.page_allocator);
+    defer arena.deinit();
+    var dsl_param_names: ?[]const []const u8 = null;
+    if (dsl_file_path) |path| {
+        const source = try std.fs.cwd().readFileAlloc(arena.allocator(), path, std.math.maxInt(usize));
+        const program = try led.dsl_parser.parseAndValidate(arena.allocator(), source);
+        const names = try arena.allocator().alloc([]const u8, program.params.len);
+        for (program.params, names) |param, *name| name.* = param.name;
+        dsl_param_names = names;
+    }
+
+    std.debug.print("Connecting to {s}:{d}...\n", .{ host, port });
+    var stream = try std.net.tcpConnectToHost(std.heap.page_allocator, host, port);
+    defer stream.close();
+    var reader_buffer: [16 * 1024]u8 = undefined;
+    var reader = stream.reader(&reader_buffer);
+    std.debug.print("Connected.\n", .{});
+
+    var payload = std.ArrayList(u8).empty;
+    defer payload.deinit(std.heap.page_allocator);
+    if (assignments.len > 0) {
+        try encodeSetParams(std.heap.page_allocator, &payload, assignments, dsl_param_names);
+        const status = try sendSetParams(&stream, &reader, payload.items);
+        if (status != 0) {
+            std.debug.print("Set params failed: v3 status={d} ({s})\n", .{ status, v3StatusName(status) });
+            return error.V3CommandFailed;
+        }
+        std.debug.print("Set {d} param(s).\n", .{assignments.len});
+        return;
+    }
+
+    std.debug.print("Reading `name=value` lines from stdin until EOF...\n", .{});
+    var stdin_buffer: [4096]u8 = undefined;
+    var stdin_reader = std.fs.File.stdin().reader(&stdin_buffer);
+    const stdin = &stdin_reader.interface;
+    var line_assignments: [max_param_assignments]ParamAssignment = undefined;
+    while (!shutdown_requested.load(.seq_cst)) {
+        const raw_line = stdin.takeDelimiterInclusive('\n') catch |err| switch (err) {
+            error.EndOfStream => break,
+            error.ReadFailed => return stdin_reader.err orelse error.Unexpected,
+            else => return err,
+        };
+        const count = parseParamLine(raw_line, &line_assignments) catch |err| {
+            std.debug.print("skipping line: {s}\n", .{@errorName(err)});
+            continue;
+        };
+        if (count == 0) continue;
+
+        payload.clearRetainingCapacity();
+        encodeSetParams(std.heap.page_allocator, &payload, line_assignments[0..count], dsl_param_names) catch |err| {
+            std.debug.print("skipping line: {s}\n", .{@errorName(err)});
+            continue;
+        };
+        const status = try sendSetParams(&stream, &reader, payload.items);
+        if (status != 0) {
+            std.debug.print("Set params failed: v3 status={d} ({s})\n", .{ status, v3StatusName(status) });
+        }
+    }
+}
+
+fn sendSetParams(stream: *std.net.Stream, reader: *std.net.Stream.Reader, payload: []const u8) !u8 {
+    try writeV3Header(stream, v3_cmd_set_params, @intCast(payload.len));
+    try stream.writeAll(payload);
+    const response = try readV3StatusResponse(reader, v3_cmd_set_params);
+    return response.status;
+}
+
+/// SET_PARAMS payload: per assignment a selector byte (param index, or 0xFF followed by a u8
+/// name length and the name) and the big-endian f32 value. With `dsl_param_names`, names are
+/// resolved to indices on the host since uploaded bytecode carries no param names.
+fn encodeSetParams(
+    allocator: std.mem.Allocator,
+    out: *std.ArrayList(u8),
+    assignments: []const ParamAssignment,
+    dsl_param_names: ?[]const []const u8,
+) !void {
+    for (assignments) |assignment| {
+        switch (assignment.key) {
+            .index => |index| try out.append(allocator, index),
+            .name => |name| if (dsl_param_names) |names| {
+                const index = for (names, 0..) |candidate, i| {
+                    if (std.mem.eql(u8, candidate, name)) break i;
+                } else return error.UnknownParam;
+                try out.append(allocator, @intCast(index));
+            } else {
+                try out.append(allocator, v3_param_by_name);
+                try out.append(allocator, @intCast(name.len));
+                try out.appendSlice(allocator, name);
+            },
+        }
+        var value_bytes: [4]u8 = undefined;
+        std.mem.writeInt(u32, &value_bytes, @bitCast(assignment.value), .big);
+        try out.appendSlice(allocator, &value_bytes);
+    }
+}
+
+/// Parses a line of whitespace-separated assignments into `out`, returning how many there were.
+fn parseParamLine(line: []const u8, out: []ParamAssignment) !usize {
+    var count: usize = 0;
+    var tokens = std.mem.tokenizeAny(u8, line, " \t\r\n");
+    while (tokens.next()) |token| {
+        if (count == out.len) return error.TooManyParams;
+        out[count] = try parseParamAssignment(token);
+        count += 1;
+    }
+    return count;
+}
+
+/// Parses `name=value` or `index=value`.
+fn parseParamAssignment(text: []const u8) !ParamAssignment {
+    const eq = std.mem.indexOfScalar(u8, text, '=') orelse return error.InvalidParamAssignment;
+    const key = text[0..eq];
+    if (key.len == 0 or key.len > std.math.maxInt(u8)) return error.InvalidParamAssignment;
+    const value = std.fmt.parseFloat(f32, text[eq + 1 ..]) catch return error.InvalidParamValue;
+    if (!std.math.isFinite(value)) return error.InvalidParamValue;
+    if (std.fmt.parseInt(u8, key, 10)) |index| {
+        if (index == v3_param_by_name) return error.InvalidParamAssignment;
+        return .{ .key = .{ .index = index }, .value = value };
+    } else |_| {
+        return .{ .key = .{ .name = key }, .value = value };
+    }
+}
+
 fn clearDisplayOnExit(client: *led.TcpClient, display: *led.DisplayBuffer) !void {
     led.display_logic.fillSolid(display, .{});
     try client.sendFrame(display.payload());
     try client.finishPendingFrame();
 }
 
-fn runDslCompileOnly(dsl_file_path: []const u8) !void {
+fn runDslCompileOnly(dsl_file_path: []const u8, opt_report: bool) !void {
     var arena = std.heap.ArenaAllocator.init(std.heap.page_allocator);
     defer arena.deinit();
 
@@ -337,6 +515,25 @@ fn runDslCompileOnly(dsl_file_path: []const u8) !void {
     try writeDslBytecodeReference(&evaluator, dsl_file_path);
     try writeDslCReference(program, dsl_file_path);
     std.debug.print("DSL compile complete for {s}; wrote bytecode and emitted C reference.\n", .{dsl_file_path});
+    if (opt_report) printOptimizationReport(evaluator.optimization);
+}
+
+fn printOptimizationReport(report: led.dsl_runtime.OptimizationReport) void {
+    std.debug.print(
+        "Optimizer: instructions {d} -> {d}, statements {d} -> {d}\n" ++
+            "  folded constants: {d}, simplified ops: {d}, dead statements: {d}, cse lets: {d} ({d} uses)\n",
+        .{
+            report.instructions_before,
+            report.instructions_after,
+            report.statements_before,
+            report.statements_after,
+            report.folded_constants,
+            report.simplified_ops,
+            report.dead_statements,
+            report.cse_lets,
+            report.cse_replacements,
+        },
+    );
 }
 
 fn runDslFileEffect(
@@ -372,7 +569,8 @@ fn runDslFileEffect(
 
         try evaluator.renderFrame(display, frame, frame_number, frame_rate_f);
         try blitDslFrameToDisplay(display, frame);
-        try client.sendFrame(display.payload());
+        // Stamp the frame with its slot in the schedule, not the send time, so render jitter does not reach the LEDs.
+        try client.sendFrameAt(display.payload(), @intCast(@divTrunc(next_send_ns, std.time.ns_per_us)));
 
         frame_number +%= 1;
         next_send_ns += frame_period_ns_i128;
@@ -459,13 +657,12 @@ fn parseRunConfig(args: anytype) !RunConfig {
     const host_or_mode = args.next() orelse return error.MissingHost;
 
     if (std.mem.eql(u8, host_or_mode, "dsl-compile")) {
-        const dsl_file_path = args.next() orelse return error.MissingDslPath;
-        if (args.next() != null) return error.TooManyArguments;
-        return .{
+        var run_config = RunConfig{
             .host = "127.0.0.1",
             .effect = .dsl_compile,
-            .dsl_file_path = dsl_file_path,
         };
+        try parseDslCompileArgs(args, &run_config);
+        return run_config;
     }
 
     var run_config = RunConfig{
@@ -501,18 +698,10 @@ fn parseRunConfig(args: anytype) !RunConfig {
         .stop => {
             if (args.next() != null) return error.TooManyArguments;
         },
-        .dsl_compile => {
-            run_config.dsl_file_path = args.next() orelse return error.MissingDslPath;
-            if (args.next() != null) return error.TooManyArguments;
-        },
-        .dsl_file => {
-            run_config.dsl_file_path = args.next() orelse return error.MissingDslPath;
-            if (args.next() != null) return error.TooManyArguments;
-        },
-        .bytecode_upload => {
-            run_config.bytecode_file_path = args.next() orelse return error.MissingBytecodePath;
-            if (args.next() != null) return error.TooManyArguments;
-        },
+        .set_params => try parseSetParamsArgs(args, &run_config),
+        .dsl_compile => try parseDslCompileArgs(args, &run_config),
+        .dsl_file => try parseDslFileArgs(args, &run_config),
+        .bytecode_upload => try parseBytecodeUploadArgs(args, &run_config),
         .firmware_upload => {
             run_config.firmware_file_path = args.next() orelse return error.MissingFirmwarePath;
             if (args.next() != null) return error.TooManyArguments;
@@ -522,6 +711,74 @@ fn parseRunConfig(args: anytype) !RunConfig {
     return run_config;
 }
 
+/// Accepts `<path-to-effect.dsl>` plus an optional `--opt-report` flag on either side of it.
+fn parseDslCompileArgs(args: anytype, run_config: *RunConfig) !void {
+    while (args.next()) |arg| {
+        if (std.mem.eql(u8, arg, "--opt-report")) {
+            run_config.opt_report = true;
+        } else if (run_config.dsl_file_path == null) {
+            run_config.dsl_file_path = arg;
+        } else {
+            return error.TooManyArguments;
+        }
+    }
+    if (run_config.dsl_file_path == null) return error.MissingDslPath;
+}
+
+/// Accepts `<path-to-effect.dsl>` plus optional `--window <n>`, `--compress`, `--udp` and `--present-delay <ms>`
+/// on either side of it.
+fn parseDslFileArgs(args: anytype, run_config: *RunConfig) !void {
+    while (args.next()) |arg| {
+        if (std.mem.eql(u8, arg, "--window")) {
+            const window_arg = args.next() orelse return error.MissingStreamWindow;
+            run_config.stream_window = try std.fmt.parseInt(u16, window_arg, 10);
+            if (run_config.stream_window > led.tcp_client.max_stream_window) return error.InvalidStreamWindow;
+        } else if (std.mem.eql(u8, arg, "--compress")) {
+            run_config.compress = true;
+        } else if (std.mem.eql(u8, arg, "--udp")) {
+            run_config.transport = .udp;
+        } else if (std.mem.eql(u8, arg, "--present-delay")) {
+            const delay_arg = args.next() orelse return error.MissingPresentDelay;
+            run_config.presentation_delay_ms = try std.fmt.parseInt(u16, delay_arg, 10);
+        } else if (run_config.dsl_file_path == null) {
+            run_config.dsl_file_path = arg;
+        } else {
+            return error.TooManyArguments;
+        }
+    }
+    if (run_config.dsl_file_path == null) return error.MissingDslPath;
+    if (run_config.presentation_delay_ms > 0 and run_config.stream_window == 0) return error.PresentDelayNeedsWindow;
+}
+
+/// Accepts `<path-to-bytecode.bin|path-to-effect.dsl>` plus an optional `--crossfade <ms>` on either side of it.
+fn parseBytecodeUploadArgs(args: anytype, run_config: *RunConfig) !void {
+    while (args.next()) |arg| {
+        if (std.mem.eql(u8, arg, "--crossfade")) {
+            const crossfade_arg = args.next() orelse return error.MissingCrossfade;
+            run_config.crossfade_ms = try std.fmt.parseInt(u16, crossfade_arg, 10);
+        } else if (run_config.bytecode_file_path == null) {
+            run_config.bytecode_file_path = arg;
+        } else {
+            return error.TooManyArguments;
+        }
+    }
+    if (run_config.bytecode_file_path == null) return error.MissingBytecodePath;
+}
+
+/// Accepts `name=value` / `index=value` assignments plus an optional `--dsl <path-to-effect.dsl>`
+/// used to resolve names for uploaded bytecode.
+fn parseSetParamsArgs(args: anytype, run_config: *RunConfig) !void {
+    while (args.next()) |arg| {
+        if (std.mem.eql(u8, arg, "--dsl")) {
+            run_config.dsl_file_path = args.next() orelse return error.MissingDslPath;
+        } else {
+            if (run_config.param_assignment_count == max_param_assignments) return error.TooManyParams;
+            run_config.param_assignments[run_config.param_assignment_count] = try parseParamAssignment(arg);
+            run_config.param_assignment_count += 1;
+        }
+    }
+}
+
 fn parseEffectKind(effect_arg: []const u8) !EffectKind {
     if (std.mem.eql(u8, effect_arg, "dsl-compile")) return .dsl_compile;
     if (std.mem.eql(u8, effect_arg, "dsl-file")) return .dsl_file;
@@ -529,6 +786,7 @@ fn parseEffectKind(effect_arg: []const u8) !EffectKind {
     if (std.mem.eql(u8, effect_arg, "firmware-upload")) return .firmware_upload;
     if (std.mem.eql(u8, effect_arg, "native-shader-activate")) return .native_shader_activate;
     if (std.mem.eql(u8, effect_arg, "stop")) return .stop;
+    if (std.mem.eql(u8, effect_arg, "params")) return .set_params;
     return error.UnknownEffect;
 }
 
@@ -795,6 +1053,7 @@ test "parseEffectKind accepts known effect names" {
     try std.testing.expectEqual(.firmware_upload, try parseEffectKind("firmware-upload"));
     try std.testing.expectEqual(.native_shader_activate, try parseEffectKind("native-shader-activate"));
     try std.testing.expectEqual(.stop, try parseEffectKind("stop"));
+    try std.testing.expectEqual(.set_params, try parseEffectKind("params"));
 }
 
 test "parseMaybeU16 returns null for non-numeric strings" {
@@ -832,6 +1091,21 @@ test "parseRunConfig parses compile-only dsl mode without host" {
     try std.testing.expectEqualStrings("examples\\dsl\\v1\\aurora.dsl", run_config.dsl_file_path.?);
 }
 
+test "parseRunConfig parses dsl-compile --opt-report flag" {
+    var args = TestArgs{
+        .values = &[_][]const u8{ "led-pillar-zig", "dsl-compile", "--opt-report", "examples\\dsl\\v1\\aurora.dsl" },
+    };
+    const run_config = try parseRunConfig(&args);
+    try std.testing.expectEqual(.dsl_compile, run_config.effect);
+    try std.testing.expect(run_config.opt_report);
+    try std.testing.expectEqualStrings("examples\\dsl\\v1\\aurora.dsl", run_config.dsl_file_path.?);
+
+    var extra_args = TestArgs{
+        .values = &[_][]const u8{ "led-pillar-zig", "dsl-compile", "a.dsl", "--opt-report", "b.dsl" },
+    };
+    try std.testing.expectError(error.TooManyArguments, parseRunConfig(&extra_args));
+}
+
 test "parseRunConfig compile-only dsl mode requires path" {
     var args = TestArgs{
         .values = &[_][]const u8{ "led-pillar-zig", "dsl-compile" },
@@ -853,6 +1127,54 @@ test "parseRunConfig dsl-file rejects extra args" {
     try std.testing.expectError(error.TooManyArguments, parseRunConfig(&args));
 }
 
+test "parseRunConfig parses dsl-file --window and --compress flags" {
+    var args = TestArgs{
+        .values = &[_][]const u8{ "led-pillar-zig", "127.0.0.1", "dsl-file", "effect.dsl", "--window", "4" },
+    };
+    const run_config = try parseRunConfig(&args);
+    try std.testing.expectEqualStrings("effect.dsl", run_config.dsl_file_path.?);
+    try std.testing.expectEqual(@as(u16, 4), run_config.stream_window);
+    try std.testing.expect(!run_config.compress);
+
+    var compressed = TestArgs{
+        .values = &[_][]const u8{ "led-pillar-zig", "127.0.0.1", "dsl-file", "--compress", "effect.dsl", "--window", "2" },
+    };
+    const compressed_config = try parseRunConfig(&compressed);
+    try std.testing.expectEqualStrings("effect.dsl", compressed_config.dsl_file_path.?);
+    try std.testing.expect(compressed_config.compress);
+    try std.testing.expectEqual(@as(u16, 2), compressed_config.stream_window);
+    try std.testing.expectEqual(led.tcp_client.Transport.tcp, compressed_config.transport);
+
+    var udp = TestArgs{
+        .values = &[_][]const u8{ "led-pillar-zig", "127.0.0.1", "dsl-file", "--udp", "effect.dsl" },
+    };
+    const udp_config = try parseRunConfig(&udp);
+    try std.testing.expectEqual(led.tcp_client.Transport.udp, udp_config.transport);
+    try std.testing.expectEqualStrings("effect.dsl", udp_config.dsl_file_path.?);
+
+    var too_large = TestArgs{
+        .values = &[_][]const u8{ "led-pillar-zig", "127.0.0.1", "dsl-file", "--window", "9", "effect.dsl" },
+    };
+    try std.testing.expectError(error.InvalidStreamWindow, parseRunConfig(&too_large));
+
+    var missing = TestArgs{
+        .values = &[_][]const u8{ "led-pillar-zig", "127.0.0.1", "dsl-file", "effect.dsl", "--window" },
+    };
+    try std.testing.expectError(error.MissingStreamWindow, parseRunConfig(&missing));
+
+    var timed = TestArgs{
+        .values = &[_][]const u8{ "led-pillar-zig", "127.0.0.1", "dsl-file", "--present-delay", "60", "effect.dsl", "--window", "3" },
+    };
+    const timed_config = try parseRunConfig(&timed);
+    try std.testing.expectEqual(@as(u16, 60), timed_config.presentation_delay_ms);
+    try std.testing.expectEqual(@as(u16, 3), timed_config.stream_window);
+
+    var untimed_window = TestArgs{
+        .values = &[_][]const u8{ "led-pillar-zig", "127.0.0.1", "dsl-file", "effect.dsl", "--present-delay", "60" },
+    };
+    try std.testing.expectError(error.PresentDelayNeedsWindow, parseRunConfig(&untimed_window));
+}
+
 test "parseRunConfig parses firmware-upload mode" {
     var args = TestArgs{
         .values = &[_][]const u8{ "led-pillar-zig", "192.168.1.22", "firmware-upload", "esp32_firmware/build/led_pillar_firmware.bin" },
@@ -885,6 +1207,25 @@ test "parseRunConfig bytecode-upload requires path" {
     try std.testing.expectError(error.MissingBytecodePath, parseRunConfig(&args));
 }
 
+test "parseRunConfig parses bytecode-upload --crossfade" {
+    var args = TestArgs{
+        .values = &[_][]const u8{ "led-pillar-zig", "192.168.1.22", "bytecode-upload", "--crossfade", "500", "effect.dsl" },
+    };
+    const run_config = try parseRunConfig(&args);
+    try std.testing.expectEqualStrings("effect.dsl", run_config.bytecode_file_path.?);
+    try std.testing.expectEqual(@as(u16, 500), run_config.crossfade_ms);
+
+    var extra = TestArgs{
+        .values = &[_][]const u8{ "led-pillar-zig", "192.168.1.22", "bytecode-upload", "a.bin", "b.bin" },
+    };
+    try std.testing.expectError(error.TooManyArguments, parseRunConfig(&extra));
+
+    var missing = TestArgs{
+        .values = &[_][]const u8{ "led-pillar-zig", "192.168.1.22", "bytecode-upload", "a.bin", "--crossfade" },
+    };
+    try std.testing.expectError(error.MissingCrossfade, parseRunConfig(&missing));
+}
+
 test "parseRunConfig parses native-shader-activate mode" {
     var args = TestArgs{
         .values = &[_][]const u8{ "led-pillar-zig", "192.168.1.22", "native-shader-activate" },
@@ -924,3 +1265,62 @@ test "parseRunConfig stop rejects extra args" {
     };
     try std.testing.expectError(error.TooManyArguments, parseRunConfig(&args));
 }
+
+test "parseRunConfig parses params assignments and --dsl" {
+    var args = TestArgs{
+        .values = &[_][]const u8{ "led-pillar-zig", "192.168.1.22", "params", "speed=1.5", "--dsl", "effect.dsl", "2=-0.25" },
+    };
+    const run_config = try parseRunConfig(&args);
+    try std.testing.expectEqual(.set_params, run_config.effect);
+    try std.testing.expectEqualStrings("effect.dsl", run_config.dsl_file_path.?);
+    try std.testing.expectEqual(@as(usize, 2), run_config.param_assignment_count);
+    try std.testing.expectEqualStrings("speed", run_config.param_assignments[0].key.name);
+    try std.testing.expectEqual(@as(f32, 1.5), run_config.param_assignments[0].value);
+    try std.testing.expectEqual(@as(u8, 2), run_config.param_assignments[1].key.index);
+    try std.testing.expectEqual(@as(f32, -0.25), run_config.param_assignments[1].value);
+
+    var stdin_mode = TestArgs{
+        .values = &[_][]const u8{ "led-pillar-zig", "192.168.1.22", "params" },
+    };
+    try std.testing.expectEqual(@as(usize, 0), (try parseRunConfig(&stdin_mode)).param_assignment_count);
+
+    var bad = TestArgs{
+        .values = &[_][]const u8{ "led-pillar-zig", "192.168.1.22", "params", "speed" },
+    };
+    try std.testing.expectError(error.InvalidParamAssignment, parseRunConfig(&bad));
+    try std.testing.expectError(error.InvalidParamValue, parseParamAssignment("speed=nan"));
+    try std.testing.expectError(error.InvalidParamValue, parseParamAssignment("speed=fast"));
+    try std.testing.expectError(error.InvalidParamAssignment, parseParamAssignment("255=1"));
+
+    var line_assignments: [2]ParamAssignment = undefined;
+    try std.testing.expectEqual(@as(usize, 2), try parseParamLine(" speed=2\t0=0.5\r\n", &line_assignments));
+    try std.testing.expectEqual(@as(u8, 0), line_assignments[1].key.index);
+    try std.testing.expectEqual(@as(usize, 0), try parseParamLine("\n", &line_assignments));
+    try std.testing.expectError(error.TooManyParams, parseParamLine("a=1 b=2 c=3", &line_assignments));
+}
+
+test "encodeSetParams sends names or resolves them through the DSL param order" {
+    const assignments = [_]ParamAssignment{
+        .{ .key = .{ .name = "speed" }, .value = 1.5 },
+        .{ .key = .{ .index = 3 }, .value = -2.0 },
+    };
+    var payload = std.ArrayList(u8).empty;
+    defer payload.deinit(std.testing.allocator);
+
+    try encodeSetParams(std.testing.allocator, &payload, &assignments, null);
+    try std.testing.expectEqualSlices(u8, &[_]u8{
+        0xff, 5, 's', 'p', 'e', 'e', 'd', 0x3f, 0xc0, 0x00, 0x00,
+        3,    0xc0, 0x00, 0x00, 0x00,
+    }, payload.items);
+
+    payload.clearRetainingCapacity();
+    const names = [_][]const u8{ "radius", "speed" };
+    try encodeSetParams(std.testing.allocator, &payload, &assignments, &names);
+    try std.testing.expectEqualSlices(u8, &[_]u8{
+        1, 0x3f, 0xc0, 0x00, 0x00,
+        3, 0xc0, 0x00, 0x00, 0x00,
+    }, payload.items);
+
+    payload.clearRetainingCapacity();
+    try std.testing.expectError(error.UnknownParam, encodeSetParams(std.testing.allocator, &payload, assignments[0..1], names[0..1]));
+}
@@ -0,0 +1,108 @@
+const std = @import("std");
+
+/// Raw bindings to the firmware's band-parallel render jobs (`esp32_firmware/main/fw_render_jobs.c`).
+/// On the host the worker is a pthread; without pthreads every band runs on the caller.
+pub const c = @cImport({
+    @cInclude("fw_render_jobs.h");
+});
+
+pub const Error = error{RenderJobsStartFailed};
+
+/// Upper bound on `bandCount()`: the calling thread plus one worker.
+pub const max_bands: u32 = c.FW_RENDER_JOBS_MAX_BANDS;
+
+/// Start the persistent band worker. Starting it again while it runs is a no-op.
+pub fn start() Error!void {
+    if (c.fw_render_jobs_start(0) != 0) return error.RenderJobsStartFailed;
+}
+
+/// Stop the worker and wait for it to exit; must not overlap a `run`.
+pub fn stop() void {
+    c.fw_render_jobs_stop();
+}
+
+/// Bands `run` splits a frame into: `max_bands` with a worker, 1 without.
+pub fn bandCount() u32 {
+    return c.fw_render_jobs_band_count();
+}
+
+/// Call `bandFn(context, band_index, band_count)` once per band, band 0 on the calling thread,
+/// and return once every band is done. `context` must be a pointer.
+pub fn run(context: anytype, comptime bandFn: fn (@TypeOf(context), u32, u32) void) void {
+    const Context = @TypeOf(context);
+    const Trampoline = struct {
+        fn call(ctx: ?*anyopaque, band_index: u32, band_count: u32) callconv(.c) void {
+            const typed: Context = @ptrCast(@alignCast(ctx.?));
+            bandFn(typed, band_index, band_count);
+        }
+    };
+    c.fw_render_jobs_run(&Trampoline.call, @ptrCast(@constCast(context)));
+}
+
+const TestFrame = struct {
+    const width = 7;
+    const height = 11;
+
+    frame: u32 = 0,
+    rgb: [width * height * 3]u8 = @splat(0),
+    row_frame: [height]u32 = @splat(0),
+    row_writes: [height]u32 = @splat(0),
+    band_threads: [max_bands]std.Thread.Id = @splat(0),
+
+    /// Deterministic stand-in for a generated `render_rows`: interleaved rows, scattered writes.
+    fn renderBand(self: *TestFrame, band_index: u32, band_count: u32) void {
+        self.band_threads[band_index] = std.Thread.getCurrentId();
+        var y: u32 = band_index;
+        while (y < height) : (y += band_count) {
+            for (0..width) |x| {
+                const py: usize = if (x % 2 == 1) height - 1 - y else y;
+                const phys = x * height + py;
+                const value: u8 = @truncate(self.frame *% 31 +% y *% 7 +% @as(u32, @intCast(x)) *% 13);
+                self.rgb[phys * 3 + 0] = value;
+                self.rgb[phys * 3 + 1] = value ^ 0x5a;
+                self.rgb[phys * 3 + 2] = value +% 1;
+            }
+            self.row_frame[y] = self.frame;
+            self.row_writes[y] += 1;
+        }
+    }
+};
+
+test "run splits frames into interleaved bands that all finish before it returns" {
+    start() catch return error.SkipZigTest;
+    defer stop();
+    try std.testing.expectEqual(max_bands, bandCount());
+
+    var banded = TestFrame{};
+    var single = TestFrame{};
+    for (1..200) |frame| {
+        banded.frame = @intCast(frame);
+        single.frame = @intCast(frame);
+        run(&banded, TestFrame.renderBand);
+        single.renderBand(0, 1);
+
+        // Barrier: every row of this frame is written by the time run returns.
+        for (banded.row_frame) |row_frame| try std.testing.expectEqual(banded.frame, row_frame);
+        try std.testing.expectEqualSlices(u8, &single.rgb, &banded.rgb);
+    }
+    for (banded.row_writes) |writes| try std.testing.expectEqual(@as(u32, 199), writes);
+    try std.testing.expectEqual(std.Thread.getCurrentId(), banded.band_threads[0]);
+    try std.testing.expect(banded.band_threads[1] != banded.band_threads[0]);
+}
+
+test "run renders a single band on the caller without a worker" {
+    start() catch return error.SkipZigTest;
+    stop();
+    stop();
+    try std.testing.expectEqual(@as(u32, 1), bandCount());
+
+    var frame = TestFrame{ .frame = 3 };
+    run(&frame, TestFrame.renderBand);
+    for (frame.row_writes) |writes| try std.testing.expectEqual(@as(u32, 1), writes);
+    try std.testing.expectEqual(std.Thread.getCurrentId(), frame.band_threads[0]);
+
+    // The worker can be restarted after a stop.
+    try start();
+    defer stop();
+    try std.testing.expectEqual(max_bands, bandCount());
+}
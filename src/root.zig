@@ -6,6 +6,14 @@ pub const dsl_parser = @import("dsl_parser.zig");
 pub const dsl_runtime = @import("dsl_runtime.zig");
 pub const dsl_c_emitter = @import("dsl_c_emitter.zig");
 pub const build_shader_registry = @import("build_shader_registry.zig");
+pub const bytecode_vm = @import("bytecode_vm.zig");
+pub const render_jobs = @import("render_jobs.zig");
+pub const frame_pipeline = @import("frame_pipeline.zig");
+pub const frame_codec = @import("frame_codec.zig");
+pub const udp_stream = @import("udp_stream.zig");
+pub const vm_bench = @import("vm_bench.zig");
+pub const stream_bench = @import("stream_bench.zig");
+pub const codec_bench = @import("codec_bench.zig");
 
 pub const display_height: u16 = tcp_client.default_display_height;
 pub const display_width: u16 = tcp_client.default_display_width;
@@ -26,4 +34,12 @@ test {
     _ = @import("dsl_runtime.zig");
     _ = @import("dsl_c_emitter.zig");
     _ = @import("build_shader_registry.zig");
+    _ = @import("bytecode_vm.zig");
+    _ = @import("render_jobs.zig");
+    _ = @import("frame_pipeline.zig");
+    _ = @import("frame_codec.zig");
+    _ = @import("udp_stream.zig");
+    _ = @import("vm_bench.zig");
+    _ = @import("stream_bench.zig");
+    _ = @import("codec_bench.zig");
 }
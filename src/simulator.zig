@@ -1,10 +1,121 @@
 const std = @import("std");
 const tcp_client = @import("tcp_client.zig");
+const bytecode_vm = @import("bytecode_vm.zig");
+const render_jobs = @import("render_jobs.zig");
+const display_logic = @import("display_logic.zig");
+const frame_codec = @import("frame_codec.zig");
+const udp_stream = @import("udp_stream.zig");
 
-const FrameHeader = struct {
+pub const FrameHeader = struct {
     protocol_version: u8,
     pixel_format: tcp_client.PixelFormat,
+    /// Decoded payload length; an encoded payload on the wire is prefixed and at most this long.
     payload_len: usize,
+    encoded: bool = false,
+};
+
+/// Pixel format announced by a sender, and whether its frame payloads are `frame_codec` encoded.
+pub const FrameFormat = struct {
+    pixel_format: tcp_client.PixelFormat,
+    encoded: bool = false,
+    /// v4 frames carry a presentation deadline on the receiver's clock (`tcp_client.present_flag`).
+    timed: bool = false,
+};
+
+pub const ReceivedFrame = struct {
+    pixels: []const u8,
+    /// Payload bytes read from the socket for this frame.
+    wire_len: usize,
+};
+
+/// Reads frame payloads for one connection. Encoded payloads are deltas against `reference`, the
+/// previous frame, so every one of them has to be decoded, including frames that are never shown.
+pub const FrameReceiver = struct {
+    reference: []u8,
+    reference_format: ?tcp_client.PixelFormat = null,
+
+    /// Read one payload that decodes to `payload.len` bytes. Raw payloads land in `payload`; encoded
+    /// ones are read into it and applied to the reference, which is returned.
+    pub fn receive(self: *FrameReceiver, reader: *std.net.Stream.Reader, format: FrameFormat, payload: []u8) !ReceivedFrame {
+        if (!format.encoded) {
+            try readExact(reader, payload);
+            return .{ .pixels = payload, .wire_len = payload.len };
+        }
+        if (payload.len > self.reference.len) return error.FrameTooLarge;
+
+        var prefix_buf: [frame_codec.prefix_len]u8 = undefined;
+        try readExact(reader, &prefix_buf);
+        const prefix = frame_codec.parsePrefix(&prefix_buf);
+        // Senders fall back to raw rather than send a body larger than the frame.
+        if (prefix.body_len > payload.len) return error.FrameTooLarge;
+        const body = payload[0..prefix.body_len];
+        try readExact(reader, body);
+
+        const has_reference = if (self.reference_format) |reference_format| reference_format == format.pixel_format else false;
+        if (prefix.encoding != .raw and !has_reference) return error.MissingDeltaReference;
+        const frame = self.reference[0..payload.len];
+        self.reference_format = null;
+        try frame_codec.decode(prefix.encoding, body, frame, format.pixel_format.bytesPerPixel());
+        self.reference_format = format.pixel_format;
+        return .{ .pixels = frame, .wire_len = frame_codec.prefix_len + body.len };
+    }
+};
+
+/// Protocol v5 receiver for one display: datagrams go into the firmware's jitter buffer, which hands back
+/// due frames and drops late or incomplete ones instead of waiting for them.
+pub const UdpReceiver = struct {
+    jitter: udp_stream.JitterBuffer,
+    expected_pixels: u32,
+
+    pub fn init(allocator: std.mem.Allocator, expected_pixels: u32, slot_count: u8, delay_us: u32) !UdpReceiver {
+        const slot_len = try std.math.mul(usize, @as(usize, expected_pixels), 4);
+        return .{
+            .jitter = try udp_stream.JitterBuffer.init(allocator, slot_len, slot_count, delay_us),
+            .expected_pixels = expected_pixels,
+        };
+    }
+
+    pub fn deinit(self: *UdpReceiver) void {
+        self.jitter.deinit();
+    }
+
+    /// Same checks as the firmware: the frame must have this display's pixel count and a known format.
+    pub fn receive(self: *UdpReceiver, bytes: []const u8, now_us: i64) void {
+        const datagram = udp_stream.parse(bytes) catch return self.jitter.recordInvalid();
+        const format = parsePixelFormat(datagram.pixel_format) catch return self.jitter.recordInvalid();
+        if (datagram.pixel_count != self.expected_pixels) return self.jitter.recordInvalid();
+        _ = self.jitter.push(&datagram, @as(usize, self.expected_pixels) * format.bytesPerPixel(), now_us);
+    }
+
+    /// Receive from `socket` until a frame is due, or return null after `max_wait_ms`. The frame's pixels
+    /// stay valid until the next call.
+    pub fn next(self: *UdpReceiver, socket: std.posix.socket_t, clock: *std.time.Timer, max_wait_ms: u31) !?udp_stream.Frame {
+        var buffer: [udp_stream.max_datagram_len]u8 = undefined;
+        const deadline_us = clockUs(clock) + @as(i64, max_wait_ms) * std.time.us_per_ms;
+        while (true) {
+            const now_us = clockUs(clock);
+            if (self.jitter.pop(now_us)) |frame| return frame;
+            if (now_us >= deadline_us) return null;
+
+            const wake_us = if (self.jitter.nextDue()) |due_us| @min(due_us, deadline_us) else deadline_us;
+            // Rounded up, so waiting for a due frame does not spin.
+            const wait_ms = @divFloor(wake_us - now_us + std.time.us_per_ms - 1, std.time.us_per_ms);
+            var fds = [_]std.posix.pollfd{.{ .fd = socket, .events = std.posix.POLL.IN, .revents = 0 }};
+            if (try std.posix.poll(&fds, @intCast(wait_ms)) == 0) continue;
+            const len = try std.posix.recv(socket, &buffer, 0);
+            self.receive(buffer[0..len], clockUs(clock));
+        }
+    }
+};
+
+const UdpServeContext = struct {
+    socket: std.posix.socket_t,
+    width: u16,
+    height: u16,
+    phys_index: []const u16,
+    receiver: *UdpReceiver,
+    render_lock: *std.Thread.Mutex,
+    stop_flag: *const std.atomic.Value(bool),
 };
 
 const Rgb = struct {
@@ -21,22 +132,41 @@ const EmittedShaderColor = extern struct {
 };
 
 const ShaderEvalPixelFn = *const fn (f32, f32, f32, f32, f32, f32, f32, *EmittedShaderColor) callconv(.c) void;
-const ShaderEvalFrameFn = *const fn (f32, f32) callconv(.c) void;
+const ShaderPrepareFrameFn = *const fn (f32, f32, f32, f32, f32) callconv(.c) void;
+const ShaderRenderFrameFn = *const fn (f32, f32, c_int, c_int, f32, [*]u8, [*]const u16, ?[*]const u8) callconv(.c) void;
+const ShaderRenderRowsFn = *const fn (f32, f32, c_int, c_int, c_int, c_int, f32, [*]u8, [*]const u16, ?[*]const u8) callconv(.c) void;
 
 const ShaderEvalAudioFn = *const fn (f32, f32) callconv(.c) f32;
 
+/// One DSL param of a native shader; mirrors dsl_shader_param_t in the generated registry.
+const ShaderParam = extern struct {
+    name: [*:0]const u8,
+    value: f32,
+    pinned: u8,
+    settable: u8,
+};
+
 const ShaderRegistryEntry = extern struct {
     name: [*:0]const u8,
     folder: [*:0]const u8,
     eval_pixel: ShaderEvalPixelFn,
     has_frame_func: c_int,
-    eval_frame: ?ShaderEvalFrameFn,
+    prepare_frame: ?ShaderPrepareFrameFn,
+    render_frame: ?ShaderRenderFrameFn,
+    render_rows: ?ShaderRenderRowsFn,
     has_audio_func: c_int,
     eval_audio: ?ShaderEvalAudioFn,
     phasor_count: c_int,
     target_fps: c_int,
+    params: ?[*]ShaderParam,
+    param_count: c_int,
 };
 
+fn shaderParams(entry: *const ShaderRegistryEntry) []ShaderParam {
+    const params = entry.params orelse return &.{};
+    return params[0..@intCast(entry.param_count)];
+}
+
 extern const dsl_shader_registry_count: c_int;
 extern fn dsl_shader_find(name: [*:0]const u8) ?*const ShaderRegistryEntry;
 extern fn dsl_shader_get(index: c_int) ?*const ShaderRegistryEntry;
@@ -60,12 +190,41 @@ const V3State = struct {
     shader_source: ShaderSource = .none,
     seed: f32 = 0.0,
     active_shader: ?*const ShaderRegistryEntry = null,
+    /// Firmware VM slots, guarded by `lock`. `bytecode` renders; uploads decode into `staged` off the lock
+    /// (only the connection thread writes it) and activation swaps the two. Without `staged`, uploads stop
+    /// the shader and decode into `bytecode`, like the firmware with one program slot.
+    bytecode: ?*bytecode_vm.Machine = null,
+    staged: ?*bytecode_vm.Machine = null,
+    /// The last upload is in `staged`, not in the program `bytecode` runs.
+    upload_staged: bool = false,
+    /// Hot-swap crossfade: the replaced program in `staged` keeps rendering underneath for these frames.
+    crossfade_frames_total: u16 = 0,
+    crossfade_frames_left: u16 = 0,
+};
+
+/// The replaced program blended under the active one for a crossfade frame; `mix` weighs the active one.
+const Crossfade = struct {
+    machine: *bytecode_vm.Machine,
+    mix: f32,
+    failed: bool = false,
 };
 
+/// Take the next crossfade frame, if one is running; call with `state.lock` held.
+fn nextCrossfade(state: *V3State) ?Crossfade {
+    if (state.crossfade_frames_left == 0) return null;
+    const machine = state.staged orelse return null;
+    const left: f32 = @floatFromInt(state.crossfade_frames_left);
+    const total: f32 = @floatFromInt(state.crossfade_frames_total);
+    state.crossfade_frames_left -= 1;
+    return .{ .machine = machine, .mix = 1.0 - left / total };
+}
+
 const ShaderRenderContext = struct {
     width: u16,
     height: u16,
     payload: []u8,
+    /// Logical (x, y) to physical LED index, row-major; passed to the generated render_frame.
+    phys_index: []const u16,
     state: *V3State,
     render_lock: *std.Thread.Mutex,
     stop_flag: *const std.atomic.Value(bool),
@@ -80,6 +239,7 @@ const v3_cmd_query_default_hook: u8 = 0x05;
 const v3_cmd_upload_firmware: u8 = 0x06;
 const v3_cmd_activate_native_shader: u8 = 0x07;
 const v3_cmd_stop_shader: u8 = 0x08;
+const v3_cmd_set_params: u8 = 0x09;
 const v3_response_flag: u8 = 0x80;
 
 const v3_status_ok: u8 = 0;
@@ -91,6 +251,10 @@ const v3_status_vm_error: u8 = 5;
 const v3_status_internal: u8 = 6;
 
 const v3_status_payload_len: usize = 20;
+/// ACTIVATE_SHADER may carry a u16 BE crossfade duration in ms for swapping out a running bytecode shader.
+const v3_activate_crossfade_len: usize = 2;
+/// SET_PARAMS selector for a param given by name (u8 length + bytes) instead of index.
+const v3_param_by_name: u8 = 0xff;
 const v3_max_bytecode_blob: usize = 64 * 1024;
 const default_frame_interval_ns: u64 = 25 * std.time.ns_per_ms;
 
@@ -103,6 +267,11 @@ const SimulatorStats = struct {
     window_start_ns: u64 = 0,
     fps_x10: u64 = 0,
     bytes_per_sec: u64 = 0,
+    vm_frame_ns: u64 = 0,
+    vm_pixel_count: u64 = 0,
+    /// v4 frames replaced by a newer queued frame before they were rendered.
+    dropped_frames: u64 = 0,
+    presentation: PresentationErrors = .{},
 
     fn init() !SimulatorStats {
         return .{ .timer = try std.time.Timer.start() };
@@ -125,6 +294,36 @@ const SimulatorStats = struct {
             self.window_start_ns = now;
         }
     }
+
+    fn recordVmFrame(self: *SimulatorStats, frame_ns: u64, pixel_count: usize) void {
+        // Smooth like the firmware's render-time EMA so the stats line stays readable.
+        self.vm_frame_ns = if (self.vm_frame_ns == 0) frame_ns else (self.vm_frame_ns * 9 + frame_ns) / 10;
+        self.vm_pixel_count = @intCast(pixel_count);
+    }
+};
+
+/// How far from its deadline each timed frame was shown: positive is late. Keeps the most recent errors.
+pub const PresentationErrors = struct {
+    pub const capacity = 512;
+
+    errors_us: [capacity]i64 = undefined,
+    count: usize = 0,
+    next: usize = 0,
+
+    pub fn record(self: *PresentationErrors, error_us: i64) void {
+        self.errors_us[self.next] = error_us;
+        self.next = (self.next + 1) % capacity;
+        self.count = @min(self.count + 1, capacity);
+    }
+
+    /// Percentile (0..100) of the absolute errors; null before the first timed frame.
+    pub fn percentile(self: *const PresentationErrors, pct: u8) ?u64 {
+        if (self.count == 0) return null;
+        var sorted: [capacity]u64 = undefined;
+        for (self.errors_us[0..self.count], sorted[0..self.count]) |error_us, *out| out.* = @abs(error_us);
+        std.mem.sort(u64, sorted[0..self.count], {}, std.sort.asc(u64));
+        return sorted[(self.count - 1) * @min(pct, 100) / 100];
+    }
 };
 
 pub fn runServer(port: u16, width: u16, height: u16) !void {
@@ -144,21 +343,36 @@ pub fn runServer(port: u16, width: u16, height: u16) !void {
     const max_payload_len = @max(frame_payload_len, v3_max_bytecode_blob);
     const payload_buffer = try std.heap.page_allocator.alloc(u8, max_payload_len);
     defer std.heap.page_allocator.free(payload_buffer);
+    const reference_frame = try std.heap.page_allocator.alloc(u8, frame_payload_len);
+    defer std.heap.page_allocator.free(reference_frame);
     const shader_payload_len = try std.math.mul(usize, @as(usize, expected_pixels), 3);
     const shader_payload = try std.heap.page_allocator.alloc(u8, shader_payload_len);
     defer std.heap.page_allocator.free(shader_payload);
+    if (expected_pixels > @as(u32, std.math.maxInt(u16)) + 1) return error.InvalidDimensions;
+    const phys_index = try std.heap.page_allocator.alloc(u16, expected_pixels);
+    defer std.heap.page_allocator.free(phys_index);
+    try display_logic.fillLayoutMap(width, height, .{}, phys_index);
+
+    var vm_machine = try bytecode_vm.Machine.init(std.heap.page_allocator, width, height);
+    defer vm_machine.deinit();
+    var vm_staged = try bytecode_vm.Machine.init(std.heap.page_allocator, width, height);
+    defer vm_staged.deinit();
 
-    var v3_state = V3State{};
+    var v3_state = V3State{ .bytecode = &vm_machine, .staged = &vm_staged };
     var render_lock: std.Thread.Mutex = .{};
     var shader_stop = std.atomic.Value(bool).init(false);
     var shader_ctx = ShaderRenderContext{
         .width = width,
         .height = height,
         .payload = shader_payload,
+        .phys_index = phys_index,
         .state = &v3_state,
         .render_lock = &render_lock,
         .stop_flag = &shader_stop,
     };
+    // Same band split as the firmware's dual-core native rendering; single-band if it fails.
+    render_jobs.start() catch {};
+    defer render_jobs.stop();
     var shader_thread = try std.Thread.spawn(.{}, shaderRenderLoop, .{&shader_ctx});
     defer {
         shader_stop.store(true, .seq_cst);
@@ -169,12 +383,32 @@ pub fn runServer(port: u16, width: u16, height: u16) !void {
     var server = try address.listen(.{ .reuse_address = true });
     defer server.deinit();
 
-    std.debug.print("Simulator listening on 0.0.0.0:{d}\n", .{port});
+    var udp_receiver = try UdpReceiver.init(std.heap.page_allocator, expected_pixels, udp_stream.default_jitter_slots, udp_stream.default_jitter_delay_us);
+    defer udp_receiver.deinit();
+    const udp_socket = try udp_stream.openSocket(address);
+    defer udp_stream.closeSocket(udp_socket);
+    var udp_stop = std.atomic.Value(bool).init(false);
+    var udp_ctx = UdpServeContext{
+        .socket = udp_socket,
+        .width = width,
+        .height = height,
+        .phys_index = phys_index,
+        .receiver = &udp_receiver,
+        .render_lock = &render_lock,
+        .stop_flag = &udp_stop,
+    };
+    var udp_thread = try std.Thread.spawn(.{}, udpServeLoop, .{&udp_ctx});
+    defer {
+        udp_stop.store(true, .seq_cst);
+        udp_thread.join();
+    }
+
+    std.debug.print("Simulator listening on 0.0.0.0:{d} (TCP, and UDP frame streaming)\n", .{port});
     while (true) {
         var connection = try server.accept();
         defer connection.stream.close();
         std.debug.print("Client connected: {any}\n", .{connection.address});
-        serveConnection(&connection.stream, width, height, expected_pixels, payload_buffer, &v3_state, &render_lock) catch |err| {
+        serveConnection(&connection.stream, width, height, phys_index, expected_pixels, payload_buffer, reference_frame, &v3_state, &render_lock) catch |err| {
             if (err != error.EndOfStream) {
                 std.debug.print("Connection closed with error: {any}\n", .{err});
             }
@@ -186,8 +420,10 @@ fn serveConnection(
     stream: *std.net.Stream,
     width: u16,
     height: u16,
+    phys_index: []const u16,
     expected_pixels: u32,
     payload_buffer: []u8,
+    reference_frame: []u8,
     v3_state: *V3State,
     render_lock: *std.Thread.Mutex,
 ) !void {
@@ -196,6 +432,12 @@ fn serveConnection(
     var header_buf: [tcp_client.header_len]u8 = undefined;
     var first_frame = true;
     var stats = try SimulatorStats.init();
+    // This connection's receiver clock, for clock-sync replies and presentation deadlines.
+    var clock = try std.time.Timer.start();
+    // Set by a v4 hello; v4 frames before it are rejected.
+    var stream_format: ?FrameFormat = null;
+    // Deltas never span connections: a new client starts from a raw frame.
+    var receiver = FrameReceiver{ .reference = reference_frame };
 
     while (true) {
         readExact(&reader, header_buf[0..]) catch |err| switch (err) {
@@ -221,16 +463,52 @@ fn serveConnection(
             try handleV3Message(stream, v3_state, cmd, payload_buffer[0..payload_len]);
             continue;
         }
+        if (protocol_version == tcp_client.stream_protocol_version) {
+            const stream_header = try tcp_client.parseStreamHeader(&header_buf);
+            switch (stream_header.message) {
+                .hello => {
+                    tcp_client.setNoDelay(stream.*);
+                    stream_format = try acceptStreamHello(stream.*, &reader, stream_header.value, expected_pixels);
+                    continue;
+                },
+                .time_request => {
+                    try sendTimeReply(stream.*, stream_header.value, clockUs(&clock), &clock);
+                    continue;
+                },
+                .frame => {},
+                else => return error.UnexpectedStreamMessage,
+            }
+            const format = stream_format orelse return error.StreamNotNegotiated;
+            const payload_len = @as(usize, expected_pixels) * format.pixel_format.bytesPerPixel();
+            if (payload_len > payload_buffer.len) return error.FrameTooLarge;
+
+            const frames = try receiveStreamFrames(stream.*, &reader, stream_header.value, &receiver, format, payload_buffer[0..payload_len], &clock);
+            stats.dropped_frames += frames.dropped;
+            if (frames.present_at_us) |present_at_us| {
+                try holdUntil(stream.*, &reader, &clock, present_at_us);
+                stats.presentation.record(clockUs(&clock) - present_at_us);
+            }
+            stats.recordFrame(tcp_client.header_len + frames.frame.wire_len);
+            {
+                render_lock.lock();
+                defer render_lock.unlock();
+                try renderFrame(width, height, phys_index, format.pixel_format, frames.frame.pixels, &stats, first_frame);
+            }
+            try sendStreamMessage(stream.*, .ack, frames.seq);
+            first_frame = false;
+            continue;
+        }
 
         const header = try parseHeader(header_buf[0..], expected_pixels);
         if (header.payload_len > payload_buffer.len) return error.FrameTooLarge;
 
-        try readExact(&reader, payload_buffer[0..header.payload_len]);
-        stats.recordFrame(tcp_client.header_len + header.payload_len);
+        const format = FrameFormat{ .pixel_format = header.pixel_format, .encoded = header.encoded };
+        const frame = try receiver.receive(&reader, format, payload_buffer[0..header.payload_len]);
+        stats.recordFrame(tcp_client.header_len + frame.wire_len);
         {
             render_lock.lock();
             defer render_lock.unlock();
-            try renderFrame(width, height, header.pixel_format, payload_buffer[0..header.payload_len], &stats, first_frame);
+            try renderFrame(width, height, phys_index, header.pixel_format, frame.pixels, &stats, first_frame);
         }
         if (header.protocol_version == tcp_client.protocol_version) {
             try stream.writeAll(&[_]u8{tcp_client.ack_byte});
@@ -239,17 +517,165 @@ fn serveConnection(
     }
 }
 
+/// Read the v4 hello payload and reply with the granted window, or with 0 when this display cannot
+/// take the announced pixel count or format.
+pub fn acceptStreamHello(stream: std.net.Stream, reader: *std.net.Stream.Reader, requested_window: u32, expected_pixels: u32) !FrameFormat {
+    var payload: [tcp_client.stream_hello_payload_len]u8 = undefined;
+    try readExact(reader, &payload);
+    const pixel_format = parsePixelFormat(payload[4] & ~(frame_codec.format_flag | tcp_client.present_flag)) catch null;
+    if (pixel_format == null or readBeU32(payload[0..4]) != expected_pixels or requested_window == 0) {
+        try sendStreamMessage(stream, .hello_reply, 0);
+        return error.StreamRejected;
+    }
+    try sendStreamMessage(stream, .hello_reply, @min(requested_window, tcp_client.max_stream_window));
+    return .{
+        .pixel_format = pixel_format.?,
+        .encoded = (payload[4] & frame_codec.format_flag) != 0,
+        .timed = (payload[4] & tcp_client.present_flag) != 0,
+    };
+}
+
+pub const StreamFrames = struct {
+    /// Sequence number of `frame`; ACK this one.
+    seq: u32,
+    dropped: u32,
+    frame: ReceivedFrame,
+    /// Deadline of a timed frame on the receiver clock.
+    present_at_us: ?i64 = null,
+};
+
+/// Read the v4 frame announced with `seq`, then keep replacing it while a newer frame is already queued
+/// behind it (drop-oldest), so a backed-up window costs one render, not a growing delay. Dropped frames
+/// are still decoded, since the next delta applies to them. A timed frame is only replaced once its
+/// deadline on `clock` has passed.
+pub fn receiveStreamFrames(
+    stream: std.net.Stream,
+    reader: *std.net.Stream.Reader,
+    seq: u32,
+    receiver: *FrameReceiver,
+    format: FrameFormat,
+    payload: []u8,
+    clock: *std.time.Timer,
+) !StreamFrames {
+    var frames = StreamFrames{ .seq = seq, .dropped = 0, .frame = undefined };
+    try receiveStreamFrame(reader, receiver, format, payload, &frames);
+    while ((frames.present_at_us == null or frames.present_at_us.? <= clockUs(clock)) and streamFrameQueued(stream, reader)) {
+        var header_buf: [tcp_client.header_len]u8 = undefined;
+        try readExact(reader, &header_buf);
+        frames.seq = (try tcp_client.parseStreamHeader(&header_buf)).value;
+        try receiveStreamFrame(reader, receiver, format, payload, &frames);
+        frames.dropped += 1;
+    }
+    return frames;
+}
+
+fn receiveStreamFrame(reader: *std.net.Stream.Reader, receiver: *FrameReceiver, format: FrameFormat, payload: []u8, frames: *StreamFrames) !void {
+    if (format.timed) {
+        var prefix: [tcp_client.present_prefix_len]u8 = undefined;
+        try readExact(reader, &prefix);
+        frames.present_at_us = @bitCast(std.mem.readInt(u64, &prefix, .big));
+    }
+    frames.frame = try receiver.receive(reader, format, payload);
+}
+
+/// Like the firmware: wait for a timed frame's deadline (at most a second, for a stale clock mapping),
+/// answering time requests queued right behind the frame meanwhile so the hold does not skew them.
+pub fn holdUntil(stream: std.net.Stream, reader: *std.net.Stream.Reader, clock: *std.time.Timer, deadline_us: i64) !void {
+    const until_us = @min(deadline_us, clockUs(clock) + std.time.us_per_s);
+    while (true) {
+        const now_us = clockUs(clock);
+        if (now_us >= until_us) return;
+        const io = reader.interface();
+        if (tcp_client.streamMessageQueued(io.buffered(), .time_request)) {
+            var header_buf: [tcp_client.header_len]u8 = undefined;
+            try readExact(reader, &header_buf);
+            try sendTimeReply(stream, (try tcp_client.parseStreamHeader(&header_buf)).value, clockUs(clock), clock);
+            continue;
+        }
+        if (io.bufferedLen() >= tcp_client.header_len) break;
+        var fds = [_]std.posix.pollfd{.{ .fd = stream.handle, .events = std.posix.POLL.IN, .revents = 0 }};
+        const wait_ms = @divFloor(until_us - now_us, std.time.us_per_ms);
+        if (wait_ms == 0 or try std.posix.poll(&fds, @intCast(wait_ms)) == 0) break;
+        io.fillMore() catch break;
+    }
+    const now_us = clockUs(clock);
+    if (now_us < until_us) std.Thread.sleep(@as(u64, @intCast(until_us - now_us)) * std.time.ns_per_us);
+}
+
+pub fn sendTimeReply(stream: std.net.Stream, request_id: u32, received_us: i64, clock: *std.time.Timer) !void {
+    var reply: [tcp_client.header_len + tcp_client.time_reply_payload_len]u8 = undefined;
+    tcp_client.writeStreamHeader(reply[0..tcp_client.header_len], .time_reply, request_id);
+    std.mem.writeInt(u64, reply[tcp_client.header_len..][0..8], @bitCast(received_us), .big);
+    std.mem.writeInt(u64, reply[tcp_client.header_len + 8 ..][0..8], @bitCast(clockUs(clock)), .big);
+    try stream.writeAll(&reply);
+}
+
+fn clockUs(clock: *std.time.Timer) i64 {
+    return @intCast(clock.read() / std.time.ns_per_us);
+}
+
+pub fn sendStreamMessage(stream: std.net.Stream, message: tcp_client.StreamMessage, value: u32) !void {
+    var header: [tcp_client.header_len]u8 = undefined;
+    tcp_client.writeStreamHeader(&header, message, value);
+    try stream.writeAll(&header);
+}
+
+fn streamFrameQueued(stream: std.net.Stream, reader: *std.net.Stream.Reader) bool {
+    const io = reader.interface();
+    if (io.bufferedLen() < tcp_client.header_len and socketReadable(stream)) {
+        io.fillMore() catch return false;
+    }
+    return tcp_client.streamFrameQueued(io.buffered());
+}
+
+fn socketReadable(stream: std.net.Stream) bool {
+    var fds = [_]std.posix.pollfd{.{ .fd = stream.handle, .events = std.posix.POLL.IN, .revents = 0 }};
+    const ready = std.posix.poll(&fds, 0) catch return false;
+    return ready > 0;
+}
+
+/// Protocol v5: render frames from the jitter buffer as they fall due. Frames the buffer dropped count as
+/// dropped in the stats line.
+fn udpServeLoop(context: *UdpServeContext) void {
+    var stats = SimulatorStats.init() catch return;
+    var clock = std.time.Timer.start() catch return;
+    var first_frame = true;
+    while (!context.stop_flag.load(.seq_cst)) {
+        const maybe_frame = context.receiver.next(context.socket, &clock, 100) catch |err| {
+            std.debug.print("UDP receive failed: {any}\n", .{err});
+            std.Thread.sleep(100 * std.time.ns_per_ms);
+            continue;
+        };
+        const frame = maybe_frame orelse continue;
+        // Checked when its datagrams were received.
+        const format = parsePixelFormat(frame.pixel_format) catch continue;
+        const jitter_stats = context.receiver.jitter.stats();
+        stats.dropped_frames = @as(u64, jitter_stats.frames_skipped) + jitter_stats.frames_incomplete;
+        stats.recordFrame(frame.pixels.len + udp_stream.fragmentCount(frame.pixels.len) * udp_stream.header_len);
+
+        context.render_lock.lock();
+        defer context.render_lock.unlock();
+        renderFrame(context.width, context.height, context.phys_index, format, frame.pixels, &stats, first_frame) catch {};
+        first_frame = false;
+    }
+}
+
 fn handleV3Message(stream: *std.net.Stream, state: *V3State, cmd: u8, payload: []const u8) !void {
     var response_payload: [v3_status_payload_len]u8 = undefined;
     var response_len: usize = 0;
     const status = switch (cmd) {
         v3_cmd_upload_bytecode => handleV3Upload(state, payload),
-        v3_cmd_activate_shader => if (payload.len == 0) handleV3Activate(state, .bytecode, null) else v3_status_invalid_arg,
+        v3_cmd_activate_shader => switch (payload.len) {
+            0 => handleV3Activate(state, .bytecode, null, 0),
+            v3_activate_crossfade_len => handleV3Activate(state, .bytecode, null, std.mem.readInt(u16, payload[0..2], .big)),
+            else => v3_status_invalid_arg,
+        },
         v3_cmd_set_default_hook => handleV3SetHook(state, payload),
         v3_cmd_clear_default_hook => handleV3ClearHook(state, payload),
         v3_cmd_query_default_hook => handleV3Query(state, payload, response_payload[0..], &response_len),
         v3_cmd_activate_native_shader => handleV3ActivateNative(state, payload),
         v3_cmd_stop_shader => handleV3Stop(state, payload),
+        v3_cmd_set_params => handleV3SetParams(state, payload),
         v3_cmd_upload_firmware => v3_status_unsupported_cmd,
         else => v3_status_unsupported_cmd,
     };
@@ -261,12 +687,40 @@ fn handleV3Upload(state: *V3State, payload: []const u8) u8 {
     if (payload.len == 0) return v3_status_invalid_arg;
     if (payload.len > v3_max_bytecode_blob) return v3_status_too_large;
 
+    const in_place = state.staged == null;
+    const machine = blk: {
+        state.lock.lock();
+        defer state.lock.unlock();
+        // Only an upload that overwrites the activatable program drops it; a failed swap upload leaves the
+        // running program to re-activate.
+        if (in_place or state.upload_staged) {
+            state.has_uploaded_program = false;
+            state.upload_staged = false;
+        }
+        // A crossfade still renders the previous program from the staged slot.
+        state.crossfade_frames_left = 0;
+        if (in_place) {
+            state.shader_active = false;
+            state.shader_source = .none;
+        }
+        break :blk (if (in_place) state.bytecode else state.staged) orelse return v3_status_internal;
+    };
+    // Decode without the lock so a running shader keeps rendering.
+    machine.load(payload) catch |err| {
+        if (err == error.BytecodeLoadFailed) {
+            std.debug.print("bytecode load failed: {s}\n", .{machine.lastStatusName()});
+        }
+        state.lock.lock();
+        defer state.lock.unlock();
+        state.bytecode_blob_len = 0;
+        return if (err == error.BytecodeLoadFailed) v3_status_vm_error else v3_status_internal;
+    };
+
     state.lock.lock();
     defer state.lock.unlock();
     state.has_uploaded_program = true;
+    state.upload_staged = !in_place;
     state.bytecode_blob_len = @intCast(payload.len);
-    state.shader_active = false;
-    state.shader_source = .none;
     return v3_status_ok;
 }
 
@@ -274,13 +728,13 @@ fn handleV3ActivateNative(state: *V3State, payload: []const u8) u8 {
     if (payload.len == 0) {
         // No name: activate first shader
         const first = dsl_shader_get(0) orelse return v3_status_not_ready;
-        return handleV3Activate(state, .native, first);
+        return handleV3Activate(state, .native, first, 0);
     }
     // Payload contains a null-terminated shader name
     const name_end = std.mem.indexOfScalar(u8, payload, 0) orelse payload.len;
     if (name_end == 0) {
         const first = dsl_shader_get(0) orelse return v3_status_not_ready;
-        return handleV3Activate(state, .native, first);
+        return handleV3Activate(state, .native, first, 0);
     }
 
     // Build null-terminated name on the stack
@@ -291,21 +745,124 @@ fn handleV3ActivateNative(state: *V3State, payload: []const u8) u8 {
     const name_z: [*:0]const u8 = @ptrCast(&name_buf);
 
     const entry = dsl_shader_find(name_z) orelse return v3_status_invalid_arg;
-    return handleV3Activate(state, .native, entry);
+    return handleV3Activate(state, .native, entry, 0);
 }
 
-fn handleV3Activate(state: *V3State, source: ShaderSource, shader: ?*const ShaderRegistryEntry) u8 {
+/// A staged bytecode upload is started off the lock and swapped in between frames, optionally crossfading
+/// from a running bytecode shader; re-activating the running program restarts it in place.
+fn handleV3Activate(state: *V3State, source: ShaderSource, shader: ?*const ShaderRegistryEntry, crossfade_ms: u16) u8 {
+    const swap = blk: {
+        state.lock.lock();
+        defer state.lock.unlock();
+        if (source == .bytecode and !state.has_uploaded_program) return v3_status_not_ready;
+        break :blk source == .bytecode and state.upload_staged;
+    };
+    const seed = generateSimulatorSeed();
+    if (swap) {
+        const staged = state.staged orelse return v3_status_internal;
+        // A failed swap leaves the running shader alone.
+        staged.start(seed) catch {
+            std.debug.print("shader activate failed: {s}\n", .{staged.lastStatusName()});
+            return v3_status_vm_error;
+        };
+    }
+
     state.lock.lock();
     defer state.lock.unlock();
-    if (source == .bytecode and !state.has_uploaded_program) return v3_status_not_ready;
+    if (source == .bytecode and !swap) {
+        const machine = state.bytecode orelse return v3_status_internal;
+        machine.start(seed) catch {
+            std.debug.print("shader activate failed: {s}\n", .{machine.lastStatusName()});
+            state.shader_active = false;
+            return v3_status_vm_error;
+        };
+    }
+    state.crossfade_frames_left = 0;
+    if (swap) {
+        if (crossfade_ms > 0 and state.shader_active and state.shader_source == .bytecode) {
+            const frames = @max(@as(u64, crossfade_ms) * std.time.ns_per_ms / default_frame_interval_ns, 1);
+            state.crossfade_frames_total = @intCast(@min(frames, std.math.maxInt(u16)));
+            state.crossfade_frames_left = state.crossfade_frames_total;
+        }
+        std.mem.swap(?*bytecode_vm.Machine, &state.bytecode, &state.staged);
+        state.upload_staged = false;
+    }
     state.shader_active = true;
     state.shader_source = source;
-    state.seed = generateSimulatorSeed();
+    state.seed = seed;
     state.shader_slow_frame_count = 0;
     state.shader_last_slow_frame_ms = 0;
     state.shader_frame_count = 0;
     if (source == .native) {
         state.active_shader = shader;
+        if (shader) |entry| {
+            for (shaderParams(entry)) |*param| param.pinned = 0;
+        }
+    }
+    return v3_status_ok;
+}
+
+const ParamUpdate = struct {
+    index: u16,
+    value: f32,
+};
+
+/// Parse the SET_PARAMS entry at `offset.*` against the active shader, as the firmware does.
+/// Bytecode blobs carry no param names, so uploaded programs only take indices.
+fn parseParamEntry(state: *const V3State, payload: []const u8, offset: *usize) ?ParamUpdate {
+    var at = offset.*;
+    const selector = payload[at];
+    at += 1;
+    const native_params: ?[]ShaderParam = if (state.shader_source == .native) shaderParams(state.active_shader.?) else null;
+
+    var index: usize = selector;
+    if (selector == v3_param_by_name) {
+        const params = native_params orelse return null;
+        if (at >= payload.len) return null;
+        const name_len = payload[at];
+        at += 1;
+        if (name_len == 0 or payload.len - at < name_len) return null;
+        const name = payload[at .. at + name_len];
+        at += name_len;
+        index = for (params, 0..) |param, i| {
+            if (std.mem.eql(u8, std.mem.span(param.name), name)) break i;
+        } else return null;
+    }
+    if (native_params) |params| {
+        if (index >= params.len or params[index].settable == 0) return null;
+    } else {
+        const machine = state.bytecode orelse return null;
+        if (!machine.paramSettable(index)) return null;
+    }
+
+    if (payload.len - at < 4) return null;
+    const value: f32 = @bitCast(readBeU32(payload[at .. at + 4]));
+    if (!std.math.isFinite(value)) return null;
+    offset.* = at + 4;
+    return .{ .index = @intCast(index), .value = value };
+}
+
+fn handleV3SetParams(state: *V3State, payload: []const u8) u8 {
+    if (payload.len == 0) return v3_status_invalid_arg;
+
+    state.lock.lock();
+    defer state.lock.unlock();
+    if (!state.shader_active or state.shader_source == .none) return v3_status_not_ready;
+    if (state.shader_source == .native and state.active_shader == null) return v3_status_not_ready;
+    // Pass 0 validates every entry so a bad one leaves all params untouched; pass 1 applies.
+    for (0..2) |pass| {
+        var offset: usize = 0;
+        while (offset < payload.len) {
+            const update = parseParamEntry(state, payload, &offset) orelse return v3_status_invalid_arg;
+            if (pass == 0) continue;
+            if (state.shader_source == .native) {
+                const param = &shaderParams(state.active_shader.?)[update.index];
+                param.value = update.value;
+                param.pinned = 1;
+            } else {
+                state.bytecode.?.setParam(update.index, update.value) catch return v3_status_vm_error;
+            }
+        }
     }
     return v3_status_ok;
 }
@@ -394,6 +951,7 @@ fn shaderRenderLoop(context: *ShaderRenderContext) void {
         const frame_start_ns = timer.read();
 
         var should_render = false;
+        var current_source: ShaderSource = .none;
         var current_seed: f32 = 0.0;
         var current_shader: ?*const ShaderRegistryEntry = null;
         {
@@ -404,6 +962,7 @@ fn shaderRenderLoop(context: *ShaderRenderContext) void {
                 frame_counter = 0;
                 context.state.shader_frame_count = 0;
             } else {
+                current_source = context.state.shader_source;
                 current_seed = context.state.seed;
                 current_shader = context.state.active_shader;
             }
@@ -417,12 +976,30 @@ fn shaderRenderLoop(context: *ShaderRenderContext) void {
                 frame_interval_ns = std.time.ns_per_s / fps;
                 next_deadline_ns = timer.read() + frame_interval_ns;
             }
-            const eval_pixel: ?ShaderEvalPixelFn = if (current_shader) |s| s.eval_pixel else blk: {
-                if (dsl_shader_get(0)) |first| break :blk first.eval_pixel;
-                break :blk null;
-            };
-            if (eval_pixel) |pixel_fn| {
-                const time_seconds: f32 = @floatCast(@as(f64, @floatFromInt(frame_start_ns)) / @as(f64, @floatFromInt(std.time.ns_per_s)));
+            const time_seconds: f32 = @floatCast(@as(f64, @floatFromInt(frame_start_ns)) / @as(f64, @floatFromInt(std.time.ns_per_s)));
+            if (current_source != .bytecode) {
+                stats.vm_frame_ns = 0;
+            } else {
+                // The program may be replaced by an upload, so run the VM under the state lock (as the firmware does).
+                context.state.lock.lock();
+                defer context.state.lock.unlock();
+                if (context.state.bytecode) |machine| {
+                    const vm_start_ns = timer.read();
+                    var crossfade = nextCrossfade(context.state);
+                    defer if (crossfade) |fade| {
+                        if (fade.failed) context.state.crossfade_frames_left = 0;
+                    };
+                    if (renderBytecodeFrame(machine, if (crossfade) |*fade| fade else null, context.width, context.height, context.phys_index, time_seconds, frame_counter, context.payload)) {
+                        stats.recordVmFrame(timer.read() - vm_start_ns, @as(usize, context.width) * @as(usize, context.height));
+                    } else |_| {
+                        std.debug.print("shader render stopped: {s}\n", .{machine.lastStatusName()});
+                        context.state.shader_active = false;
+                        context.state.shader_source = .none;
+                    }
+                }
+            }
+            const native_shader: ?*const ShaderRegistryEntry = if (current_source != .native) null else current_shader orelse dsl_shader_get(0);
+            if (native_shader) |shader| {
                 renderEmittedShaderFrame(
                     context.width,
                     context.height,
@@ -430,7 +1007,8 @@ fn shaderRenderLoop(context: *ShaderRenderContext) void {
                     frame_counter,
                     current_seed,
                     context.payload,
-                    pixel_fn,
+                    context.phys_index,
+                    shader,
                 );
             }
             stats.recordFrame(tcp_client.header_len + context.payload.len);
@@ -439,6 +1017,7 @@ fn shaderRenderLoop(context: *ShaderRenderContext) void {
             _ = renderFrame(
                 context.width,
                 context.height,
+                context.phys_index,
                 .rgb,
                 context.payload,
                 &stats,
@@ -467,6 +1046,7 @@ fn shaderRenderLoop(context: *ShaderRenderContext) void {
                 _ = renderFrame(
                     context.width,
                     context.height,
+                    context.phys_index,
                     .rgb,
                     context.payload,
                     &stats,
@@ -493,33 +1073,106 @@ fn shaderRenderLoop(context: *ShaderRenderContext) void {
     }
 }
 
-fn renderEmittedShaderFrame(width: u16, height: u16, time_seconds: f32, frame_counter: u32, seed: f32, payload: []u8, eval_pixel: ShaderEvalPixelFn) void {
+fn renderEmittedShaderFrame(width: u16, height: u16, time_seconds: f32, frame_counter: u32, seed: f32, payload: []u8, phys_index: []const u16, shader: *const ShaderRegistryEntry) void {
     const pixel_count = @as(usize, width) * @as(usize, height);
     const required_len = pixel_count * 3;
-    if (payload.len < required_len) return;
+    if (payload.len < required_len or phys_index.len < pixel_count) return;
+    const frame: f32 = @floatFromInt(frame_counter);
+
+    if (render_jobs.bandCount() > 1) {
+        if (shader.prepare_frame) |prepare_frame| {
+            if (shader.render_rows) |render_rows| {
+                prepare_frame(time_seconds, frame, @floatFromInt(width), @floatFromInt(height), seed);
+                const job = EmittedBandJob{
+                    .render_rows = render_rows,
+                    .time_seconds = time_seconds,
+                    .frame = frame,
+                    .width = width,
+                    .height = height,
+                    .seed = seed,
+                    .payload = payload.ptr,
+                    .phys_index = phys_index.ptr,
+                };
+                render_jobs.run(&job, EmittedBandJob.renderBand);
+                return;
+            }
+        }
+    }
+
+    const render_frame = shader.render_frame orelse return;
+    // The simulator streams plain RGB frames, so no gamma table (wire format is firmware-only).
+    render_frame(time_seconds, frame, width, height, seed, payload.ptr, phys_index.ptr, null);
+}
+
+/// One frame of a native shader split into row bands, as `fw_native_shader_render_frame` does.
+const EmittedBandJob = struct {
+    render_rows: ShaderRenderRowsFn,
+    time_seconds: f32,
+    frame: f32,
+    width: c_int,
+    height: c_int,
+    seed: f32,
+    payload: [*]u8,
+    phys_index: [*]const u16,
+
+    fn renderBand(job: *const EmittedBandJob, band_index: u32, band_count: u32) void {
+        job.render_rows(job.time_seconds, job.frame, job.width, job.height, @intCast(band_index), @intCast(band_count), job.seed, job.payload, job.phys_index, null);
+    }
+};
 
-    const width_f: f32 = @floatFromInt(width);
-    const height_f: f32 = @floatFromInt(height);
-    const frame_f: f32 = @floatFromInt(frame_counter);
+/// Mirrors `fw_tcp_render_shader_frame_locked`: one evaluation fills the frame when the
+/// program does not depend on x/y, otherwise every pixel runs through the VM. During a crossfade the
+/// replaced program renders too and is blended underneath; it is dropped (`failed`) when it errors.
+fn renderBytecodeFrame(machine: *bytecode_vm.Machine, crossfade: ?*Crossfade, width: u16, height: u16, phys_index: []const u16, time_seconds: f32, frame_counter: u32, payload: []u8) !void {
+    const pixel_count = @as(usize, width) * @as(usize, height);
+    if (payload.len < pixel_count * 3 or phys_index.len < pixel_count) return error.FrameTooLarge;
+
+    try machine.beginFrame(time_seconds, frame_counter);
+    var fade = crossfade;
+    if (fade) |f| {
+        f.machine.beginFrame(time_seconds, frame_counter) catch {
+            f.failed = true;
+            fade = null;
+        };
+    }
+    if (fade == null and !machine.pixelDependsOnXY()) {
+        const color = try machine.evalPixel(0.0, 0.0);
+        const rgb = [3]u8{ channelToU8(color.r), channelToU8(color.g), channelToU8(color.b) };
+        var i: usize = 0;
+        while (i < pixel_count) : (i += 1) {
+            @memcpy(payload[i * 3 .. i * 3 + 3], &rgb);
+        }
+        return;
+    }
+
+    var row_colors: [bytecode_vm.row_lanes]bytecode_vm.c.fw_bc3_color_t = undefined;
+    var fade_colors: [bytecode_vm.row_lanes]bytecode_vm.c.fw_bc3_color_t = undefined;
     var y: u16 = 0;
     while (y < height) : (y += 1) {
-        var x: u16 = 0;
-        while (x < width) : (x += 1) {
-            var color = EmittedShaderColor{ .r = 0, .g = 0, .b = 0, .a = 0 };
-            eval_pixel(
-                time_seconds,
-                frame_f,
-                @floatFromInt(x),
-                @floatFromInt(y),
-                width_f,
-                height_f,
-                seed,
-                &color,
-            );
-            const offset = @as(usize, physicalPixelIndex(height, x, y)) * 3;
-            payload[offset] = channelToU8(color.r);
-            payload[offset + 1] = channelToU8(color.g);
-            payload[offset + 2] = channelToU8(color.b);
+        var x0: u16 = 0;
+        while (x0 < width) {
+            const chunk: u16 = @intCast(@min(@as(usize, width - x0), bytecode_vm.row_lanes));
+            try machine.evalRow(@floatFromInt(y), x0, row_colors[0..chunk]);
+            if (fade) |f| {
+                if (f.machine.evalRow(@floatFromInt(y), x0, fade_colors[0..chunk])) {
+                    for (row_colors[0..chunk], fade_colors[0..chunk]) |*color, under| {
+                        color.r = under.r + (color.r - under.r) * f.mix;
+                        color.g = under.g + (color.g - under.g) * f.mix;
+                        color.b = under.b + (color.b - under.b) * f.mix;
+                    }
+                } else |_| {
+                    f.failed = true;
+                    fade = null;
+                }
+            }
+            for (row_colors[0..chunk], 0..) |color, lane| {
+                const x = x0 + @as(u16, @intCast(lane));
+                const offset = @as(usize, phys_index[@as(usize, y) * width + x]) * 3;
+                payload[offset] = channelToU8(color.r);
+                payload[offset + 1] = channelToU8(color.g);
+                payload[offset + 2] = channelToU8(color.b);
+            }
+            x0 += chunk;
         }
     }
 }
@@ -548,7 +1201,7 @@ fn readExact(reader: *std.net.Stream.Reader, buffer: []u8) !void {
     };
 }
 
-fn parseHeader(header: []const u8, expected_pixels: u32) !FrameHeader {
+pub fn parseHeader(header: []const u8, expected_pixels: u32) !FrameHeader {
     if (header.len != tcp_client.header_len) return error.InvalidHeaderLength;
     if (!std.mem.eql(u8, header[0..4], "LEDS")) return error.InvalidMagic;
     const protocol_version = header[4];
@@ -560,12 +1213,13 @@ fn parseHeader(header: []const u8, expected_pixels: u32) !FrameHeader {
     const count = readBeU32(header[5..9]);
     if (count != expected_pixels) return error.UnexpectedPixelCount;
 
-    const pixel_format = try parsePixelFormat(header[9]);
+    const pixel_format = try parsePixelFormat(header[9] & ~frame_codec.format_flag);
     const payload_len = try std.math.mul(usize, @as(usize, count), pixel_format.bytesPerPixel());
     return .{
         .protocol_version = protocol_version,
         .pixel_format = pixel_format,
         .payload_len = payload_len,
+        .encoded = (header[9] & frame_codec.format_flag) != 0,
     };
 }
 
@@ -583,6 +1237,7 @@ fn parsePixelFormat(value: u8) !tcp_client.PixelFormat {
 fn renderFrame(
     width: u16,
     height: u16,
+    phys_index: []const u16,
     format: tcp_client.PixelFormat,
     payload: []const u8,
     stats: *const SimulatorStats,
@@ -601,7 +1256,7 @@ fn renderFrame(
     while (y < height) : (y += 1) {
         var x: u16 = 0;
         while (x < width) : (x += 1) {
-            const index = physicalPixelIndex(height, x, y);
+            const index = phys_index[@as(usize, y) * width + x];
             const offset = @as(usize, index) * format.bytesPerPixel();
             const rgb = decodePixel(format, payload[offset .. offset + format.bytesPerPixel()]);
             try stdout.print("\x1b[48;2;{d};{d};{d}m  ", .{ rgb.r, rgb.g, rgb.b });
@@ -611,18 +1266,23 @@ fn renderFrame(
     const fps_whole = stats.fps_x10 / 10;
     const fps_tenths = stats.fps_x10 % 10;
     try stdout.print(
-        "\x1b[0mFPS: {d}.{d}  Bytes/s: {d}  Frames: {d}  Total bytes: {d}\x1b[K\n",
+        "\x1b[0mFPS: {d}.{d}  Bytes/s: {d}  Frames: {d}  Total bytes: {d}",
         .{ fps_whole, fps_tenths, stats.bytes_per_sec, stats.total_frames, stats.total_bytes },
     );
+    if (stats.vm_frame_ns > 0 and stats.vm_pixel_count > 0) {
+        try stdout.print("  VM: {d} us/frame ({d} ns/px)", .{ stats.vm_frame_ns / std.time.ns_per_us, stats.vm_frame_ns / stats.vm_pixel_count });
+    }
+    if (stats.dropped_frames > 0) {
+        try stdout.print("  Dropped: {d}", .{stats.dropped_frames});
+    }
+    if (stats.presentation.percentile(50)) |p50| {
+        try stdout.print("  Present error p50/p90/p99: {d}/{d}/{d} us", .{ p50, stats.presentation.percentile(90).?, stats.presentation.percentile(99).? });
+    }
+    try stdout.writeAll("\x1b[K\n");
     try stdout.writeAll("\x1b[0m");
     try stdout.flush();
 }
 
-fn physicalPixelIndex(height: u16, x: u16, y: u16) u32 {
-    const row = if ((x & 1) == 0) y else height - 1 - y;
-    return @as(u32, x) * @as(u32, height) + @as(u32, row);
-}
-
 fn decodePixel(format: tcp_client.PixelFormat, pixel: []const u8) Rgb {
     return switch (format) {
         .rgb => .{ .r = pixel[0], .g = pixel[1], .b = pixel[2] },
@@ -677,10 +1337,322 @@ test "parseHeader rejects invalid magic" {
     try std.testing.expectError(error.InvalidMagic, parseHeader(header[0..], 1200));
 }
 
-test "physicalPixelIndex uses serpentine mapping" {
-    try std.testing.expectEqual(@as(u32, 0), physicalPixelIndex(4, 0, 0));
-    try std.testing.expectEqual(@as(u32, 7), physicalPixelIndex(4, 1, 0));
-    try std.testing.expectEqual(@as(u32, 4), physicalPixelIndex(4, 1, 3));
+test "v4 stream hello grants a clamped window and queued frames collapse to the newest" {
+    const address = try std.net.Address.parseIp4("127.0.0.1", 0);
+    var server = try address.listen(.{ .reuse_address = true });
+    defer server.deinit();
+    const client = try std.net.tcpConnectToAddress(server.listen_address);
+    defer client.close();
+    const connection = try server.accept();
+    defer connection.stream.close();
+
+    // Hello for 2 RGB pixels asking for more than the maximum window, then three frames back to back.
+    var header: [tcp_client.header_len]u8 = undefined;
+    tcp_client.writeStreamHeader(&header, .hello, 64);
+    try client.writeAll(&header);
+    try client.writeAll(&[_]u8{ 0, 0, 0, 2, @intFromEnum(tcp_client.PixelFormat.rgb) });
+    for (1..4) |seq| {
+        tcp_client.writeStreamHeader(&header, .frame, @intCast(seq));
+        try client.writeAll(&header);
+        try client.writeAll(&@as([6]u8, @splat(@intCast(seq))));
+    }
+
+    var reader_buffer: [1024]u8 = undefined;
+    var reader = connection.stream.reader(&reader_buffer);
+    try readExact(&reader, &header);
+    const hello = try tcp_client.parseStreamHeader(&header);
+    const format = try acceptStreamHello(connection.stream, &reader, hello.value, 2);
+    try std.testing.expectEqual(tcp_client.PixelFormat.rgb, format.pixel_format);
+    try std.testing.expect(!format.encoded);
+
+    var reply: [tcp_client.header_len]u8 = undefined;
+    var client_reader_buffer: [64]u8 = undefined;
+    var client_reader = client.reader(&client_reader_buffer);
+    try readExact(&client_reader, &reply);
+    const granted = try tcp_client.parseStreamHeader(&reply);
+    try std.testing.expectEqual(tcp_client.StreamMessage.hello_reply, granted.message);
+    try std.testing.expectEqual(@as(u32, tcp_client.max_stream_window), granted.value);
+
+    try readExact(&reader, &header);
+    var payload: [6]u8 = undefined;
+    var receiver = FrameReceiver{ .reference = payload[0..0] };
+    var clock = try std.time.Timer.start();
+    const frames = try receiveStreamFrames(connection.stream, &reader, (try tcp_client.parseStreamHeader(&header)).value, &receiver, format, &payload, &clock);
+    try std.testing.expectEqual(@as(u32, 3), frames.seq);
+    try std.testing.expectEqual(@as(u32, 2), frames.dropped);
+    try std.testing.expectEqualSlices(u8, &@as([6]u8, @splat(3)), frames.frame.pixels);
+}
+
+test "encoded v4 frames dropped behind a newer one are still decoded" {
+    const address = try std.net.Address.parseIp4("127.0.0.1", 0);
+    var server = try address.listen(.{ .reuse_address = true });
+    defer server.deinit();
+    const client = try std.net.tcpConnectToAddress(server.listen_address);
+    defer client.close();
+    const connection = try server.accept();
+    defer connection.stream.close();
+
+    // Hello for 4 encoded RGB pixels, then a raw frame and two deltas back to back. The last delta
+    // only touches pixel 3, so pixel 0 is right only if the dropped middle frame was applied.
+    var header: [tcp_client.header_len]u8 = undefined;
+    tcp_client.writeStreamHeader(&header, .hello, 2);
+    try client.writeAll(&header);
+    try client.writeAll(&[_]u8{ 0, 0, 0, 4, @intFromEnum(tcp_client.PixelFormat.rgb) | frame_codec.format_flag });
+    const frames_sent = [_][12]u8{
+        @splat(1),
+        .{ 9, 9, 9, 1, 1, 1, 1, 1, 1, 1, 1, 1 },
+        .{ 9, 9, 9, 1, 1, 1, 1, 1, 1, 7, 7, 7 },
+    };
+    for (frames_sent, 0..) |frame, i| {
+        var body: [12]u8 = undefined;
+        var scratch: [12]u8 = undefined;
+        const previous: ?[]const u8 = if (i == 0) null else &frames_sent[i - 1];
+        const encoded = frame_codec.encodeFrame(previous, &frame, 3, &body, &scratch);
+        try std.testing.expectEqual(i == 0, encoded.encoding == .raw);
+        var prefix: [frame_codec.prefix_len]u8 = undefined;
+        frame_codec.writePrefix(&prefix, encoded.encoding, @intCast(encoded.len));
+        tcp_client.writeStreamHeader(&header, .frame, @intCast(i + 1));
+        try client.writeAll(&header);
+        try client.writeAll(&prefix);
+        try client.writeAll(body[0..encoded.len]);
+    }
+
+    var reader_buffer: [1024]u8 = undefined;
+    var reader = connection.stream.reader(&reader_buffer);
+    try readExact(&reader, &header);
+    const format = try acceptStreamHello(connection.stream, &reader, (try tcp_client.parseStreamHeader(&header)).value, 4);
+    try std.testing.expect(format.encoded);
+
+    try readExact(&reader, &header);
+    var payload: [12]u8 = undefined;
+    var reference: [12]u8 = undefined;
+    var receiver = FrameReceiver{ .reference = &reference };
+    var clock = try std.time.Timer.start();
+    const frames = try receiveStreamFrames(connection.stream, &reader, (try tcp_client.parseStreamHeader(&header)).value, &receiver, format, &payload, &clock);
+    try std.testing.expectEqual(@as(u32, 3), frames.seq);
+    try std.testing.expectEqual(@as(u32, 2), frames.dropped);
+    try std.testing.expectEqualSlices(u8, &frames_sent[2], frames.frame.pixels);
+    try std.testing.expect(frames.frame.wire_len < frame_codec.prefix_len + payload.len);
+}
+
+test "encoded v2 frames from the client decode against the previous frame" {
+    const address = try std.net.Address.parseIp4("127.0.0.1", 0);
+    var server = try address.listen(.{ .reuse_address = true });
+    defer server.deinit();
+    var client = try tcp_client.TcpClient.init(std.testing.allocator, .{
+        .host = "127.0.0.1",
+        .port = server.listen_address.getPort(),
+        .width = 4,
+        .height = 10,
+        .compress = true,
+    });
+    defer client.deinit();
+    try client.connect();
+    const connection = try server.accept();
+    defer connection.stream.close();
+
+    var reader_buffer: [1024]u8 = undefined;
+    var reader = connection.stream.reader(&reader_buffer);
+    var payload: [120]u8 = undefined;
+    var reference: [120]u8 = undefined;
+    var receiver = FrameReceiver{ .reference = &reference };
+    var frame: [120]u8 = @splat(10);
+    for (0..3) |i| {
+        if (i > 0) frame[40 * i] +%= 1;
+        try client.sendFrame(&frame);
+
+        var header_buf: [tcp_client.header_len]u8 = undefined;
+        try readExact(&reader, &header_buf);
+        const header = try parseHeader(&header_buf, 40);
+        try std.testing.expect(header.encoded);
+        const received = try receiver.receive(&reader, .{ .pixel_format = header.pixel_format, .encoded = true }, payload[0..header.payload_len]);
+        try std.testing.expectEqualSlices(u8, &frame, received.pixels);
+        // Only the first frame of the connection goes out whole.
+        if (i == 0) {
+            try std.testing.expectEqual(frame_codec.prefix_len + frame.len, received.wire_len);
+        } else {
+            try std.testing.expect(received.wire_len < 16);
+        }
+        try connection.stream.writeAll(&[_]u8{tcp_client.ack_byte});
+    }
+}
+
+test "v4 stream hello rejects a pixel count the display does not have" {
+    const address = try std.net.Address.parseIp4("127.0.0.1", 0);
+    var server = try address.listen(.{ .reuse_address = true });
+    defer server.deinit();
+    const client = try std.net.tcpConnectToAddress(server.listen_address);
+    defer client.close();
+    const connection = try server.accept();
+    defer connection.stream.close();
+
+    try client.writeAll(&[_]u8{ 0, 0, 0, 3, @intFromEnum(tcp_client.PixelFormat.rgb) });
+    var reader_buffer: [64]u8 = undefined;
+    var reader = connection.stream.reader(&reader_buffer);
+    try std.testing.expectError(error.StreamRejected, acceptStreamHello(connection.stream, &reader, 4, 2));
+
+    var reply: [tcp_client.header_len]u8 = undefined;
+    var client_reader_buffer: [64]u8 = undefined;
+    var client_reader = client.reader(&client_reader_buffer);
+    try readExact(&client_reader, &reply);
+    try std.testing.expectEqual(@as(u32, 0), (try tcp_client.parseStreamHeader(&reply)).value);
+}
+
+test "timed v4 frames are held until their deadline while time requests are answered" {
+    const address = try std.net.Address.parseIp4("127.0.0.1", 0);
+    var server = try address.listen(.{ .reuse_address = true });
+    defer server.deinit();
+    const client = try std.net.tcpConnectToAddress(server.listen_address);
+    defer client.close();
+    const connection = try server.accept();
+    defer connection.stream.close();
+
+    // Two frames due 30 ms from now with a time request between them, all queued before the receiver looks.
+    var clock = try std.time.Timer.start();
+    const deadline_us: i64 = 30 * std.time.us_per_ms;
+    var header: [tcp_client.header_len]u8 = undefined;
+    var prefix: [tcp_client.present_prefix_len]u8 = undefined;
+    std.mem.writeInt(u64, &prefix, @bitCast(deadline_us), .big);
+    for (1..3) |seq| {
+        tcp_client.writeStreamHeader(&header, .frame, @intCast(seq));
+        try client.writeAll(&header);
+        try client.writeAll(&prefix);
+        try client.writeAll(&@as([6]u8, @splat(@intCast(seq))));
+        if (seq == 1) {
+            tcp_client.writeStreamHeader(&header, .time_request, 7);
+            try client.writeAll(&header);
+        }
+    }
+
+    var reader_buffer: [1024]u8 = undefined;
+    var reader = connection.stream.reader(&reader_buffer);
+    const format = FrameFormat{ .pixel_format = .rgb, .timed = true };
+    var payload: [6]u8 = undefined;
+    var receiver = FrameReceiver{ .reference = payload[0..0] };
+    try readExact(&reader, &header);
+    const frames = try receiveStreamFrames(connection.stream, &reader, (try tcp_client.parseStreamHeader(&header)).value, &receiver, format, &payload, &clock);
+    try std.testing.expectEqual(@as(u32, 1), frames.seq);
+    try std.testing.expectEqual(@as(u32, 0), frames.dropped);
+    try std.testing.expectEqual(@as(?i64, deadline_us), frames.present_at_us);
+    try holdUntil(connection.stream, &reader, &clock, frames.present_at_us.?);
+    try std.testing.expect(clockUs(&clock) >= deadline_us);
+
+    var reply: [tcp_client.header_len + tcp_client.time_reply_payload_len]u8 = undefined;
+    var client_reader_buffer: [64]u8 = undefined;
+    var client_reader = client.reader(&client_reader_buffer);
+    try readExact(&client_reader, &reply);
+    const time_reply = try tcp_client.parseStreamHeader(reply[0..tcp_client.header_len]);
+    try std.testing.expectEqual(tcp_client.StreamMessage.time_reply, time_reply.message);
+    try std.testing.expectEqual(@as(u32, 7), time_reply.value);
+    const replied_at_us: i64 = @bitCast(std.mem.readInt(u64, reply[tcp_client.header_len + 8 ..][0..8], .big));
+    try std.testing.expect(replied_at_us < deadline_us);
+
+    // The second frame's deadline has passed by now; it renders right away.
+    try readExact(&reader, &header);
+    const late = try receiveStreamFrames(connection.stream, &reader, (try tcp_client.parseStreamHeader(&header)).value, &receiver, format, &payload, &clock);
+    try std.testing.expectEqual(@as(u32, 2), late.seq);
+    try std.testing.expectEqualSlices(u8, &@as([6]u8, @splat(2)), late.frame.pixels);
+}
+
+test "presentation error percentiles use absolute errors of the most recent frames" {
+    var errors = PresentationErrors{};
+    try std.testing.expectEqual(@as(?u64, null), errors.percentile(50));
+    for (1..101) |i| {
+        const error_us: i64 = @intCast(i);
+        errors.record(if (i % 2 == 0) -error_us else error_us);
+    }
+    try std.testing.expectEqual(@as(?u64, 50), errors.percentile(50));
+    try std.testing.expectEqual(@as(?u64, 90), errors.percentile(90));
+    try std.testing.expectEqual(@as(?u64, 99), errors.percentile(99));
+
+    for (0..PresentationErrors.capacity) |_| errors.record(7);
+    try std.testing.expectEqual(@as(?u64, 7), errors.percentile(99));
+}
+
+test "udp frames survive loss, duplicates and reordering through a mangling relay" {
+    const receiver_socket = try udp_stream.openSocket(try std.net.Address.parseIp4("127.0.0.1", 0));
+    defer udp_stream.closeSocket(receiver_socket);
+    // Every frame is three datagrams: frame 2 loses its middle one, frame 3 arrives out of order with a
+    // duplicate, frame 4 arrives out of order.
+    var mangler = try udp_stream.Mangler.init(try udp_stream.boundAddress(receiver_socket), &.{
+        .forward, .forward, .forward,
+        .forward, .drop,    .forward,
+        .hold,    .forward, .duplicate,
+        .forward, .hold,    .forward,
+    });
+    defer mangler.deinit();
+
+    var client = try tcp_client.TcpClient.init(std.testing.allocator, .{
+        .host = "127.0.0.1",
+        .port = mangler.address.getPort(),
+        .transport = .udp,
+    });
+    defer client.deinit();
+    try client.connect();
+    try std.testing.expectEqual(@as(usize, 3), udp_stream.fragmentCount(client.expectedPayloadLen()));
+
+    var receiver = try UdpReceiver.init(std.testing.allocator, client.pixel_count, udp_stream.default_jitter_slots, 0);
+    defer receiver.deinit();
+    var clock = try std.time.Timer.start();
+    const pixels = try std.testing.allocator.alloc(u8, client.expectedPayloadLen());
+    defer std.testing.allocator.free(pixels);
+
+    @memset(pixels, 1);
+    try client.sendFrame(pixels);
+    try mangler.relay(3);
+    const first = (try receiver.next(receiver_socket, &clock, 1000)).?;
+    try std.testing.expectEqual(@as(u32, 1), first.frame_id);
+    try std.testing.expectEqualSlices(u8, pixels, first.pixels);
+
+    // Incomplete frame 2 is dropped rather than holding back frame 3.
+    @memset(pixels, 2);
+    try client.sendFrame(pixels);
+    try mangler.relay(3);
+    @memset(pixels, 3);
+    try client.sendFrame(pixels);
+    try mangler.relay(3);
+    const third = (try receiver.next(receiver_socket, &clock, 1000)).?;
+    try std.testing.expectEqual(@as(u32, 3), third.frame_id);
+    try std.testing.expectEqualSlices(u8, pixels, third.pixels);
+
+    // The duplicate of frame 3 is still queued and arrives late.
+    @memset(pixels, 4);
+    try client.sendFrame(pixels);
+    try mangler.relay(3);
+    const fourth = (try receiver.next(receiver_socket, &clock, 1000)).?;
+    try std.testing.expectEqual(@as(u32, 4), fourth.frame_id);
+    try std.testing.expectEqualSlices(u8, pixels, fourth.pixels);
+
+    const stats = receiver.jitter.stats();
+    try std.testing.expectEqual(@as(u32, 3), stats.frames_shown);
+    try std.testing.expectEqual(@as(u32, 1), stats.frames_incomplete);
+    try std.testing.expectEqual(@as(u32, 0), stats.frames_skipped);
+    try std.testing.expectEqual(@as(u32, 1), stats.datagrams_late);
+}
+
+test "udp receiver rejects frames for another display size" {
+    var receiver = try UdpReceiver.init(std.testing.allocator, 2, 2, 0);
+    defer receiver.deinit();
+    var datagram: [udp_stream.max_datagram_len]u8 = undefined;
+    const frame: [9]u8 = @splat(5);
+    receiver.receive(udp_stream.writeFragment(&datagram, .{
+        .frame_id = 1,
+        .pixel_format = @intFromEnum(tcp_client.PixelFormat.rgb),
+        .fragment_index = 0,
+        .fragment_count = 1,
+        .presentation_us = 0,
+        .pixel_count = 3,
+    }, &frame), 0);
+    try std.testing.expectEqual(@as(u32, 1), receiver.jitter.stats().datagrams_invalid);
+    try std.testing.expect(receiver.jitter.pop(0) == null);
+}
+
+test "simulator layout map uses serpentine mapping" {
+    var phys_index: [2 * 4]u16 = undefined;
+    try display_logic.fillLayoutMap(2, 4, .{}, &phys_index);
+    try std.testing.expectEqual(@as(u16, 0), phys_index[0 * 2 + 0]);
+    try std.testing.expectEqual(@as(u16, 7), phys_index[0 * 2 + 1]);
+    try std.testing.expectEqual(@as(u16, 4), phys_index[3 * 2 + 1]);
 }
 
 test "decodePixel maps RGBW white into RGB channels" {
@@ -700,9 +1672,169 @@ test "v3 upload requires non-empty payload" {
     try std.testing.expectEqual(v3_status_invalid_arg, handleV3Upload(&state, &.{}));
 }
 
+test "v3 upload validates bytecode with the firmware VM" {
+    var machine = try bytecode_vm.Machine.init(std.testing.allocator, 30, 40);
+    defer machine.deinit();
+    var state = V3State{ .bytecode = &machine };
+
+    const garbage = [_]u8{ 'N', 'O', 'P', 'E', 3, 0, 0, 0 };
+    try std.testing.expectEqual(v3_status_vm_error, handleV3Upload(&state, &garbage));
+    try std.testing.expect(!state.has_uploaded_program);
+    try std.testing.expectEqual(@as(u32, 0), state.bytecode_blob_len);
+}
+
+test "v3 bytecode upload and activate renders through the firmware VM" {
+    const dsl_parser = @import("dsl_parser.zig");
+    const dsl_runtime = @import("dsl_runtime.zig");
+    const source =
+        \\effect sim_vm
+        \\layer l {
+        \\  blend rgba(x / width, y / height, 0.0, 1.0)
+        \\}
+        \\emit
+    ;
+
+    var arena = std.heap.ArenaAllocator.init(std.testing.allocator);
+    defer arena.deinit();
+    const program = try dsl_parser.parseAndValidate(arena.allocator(), source);
+    var evaluator = try dsl_runtime.Evaluator.init(std.testing.allocator, program);
+    defer evaluator.deinit();
+    var blob = std.ArrayList(u8).empty;
+    defer blob.deinit(std.testing.allocator);
+    try evaluator.writeBytecodeBinary(blob.writer(std.testing.allocator));
+
+    var machine = try bytecode_vm.Machine.init(std.testing.allocator, 4, 2);
+    defer machine.deinit();
+    var state = V3State{ .bytecode = &machine };
+    try std.testing.expectEqual(v3_status_ok, handleV3Upload(&state, blob.items));
+    try std.testing.expectEqual(@as(u32, @intCast(blob.items.len)), state.bytecode_blob_len);
+    try std.testing.expectEqual(v3_status_ok, handleV3Activate(&state, .bytecode, null, 0));
+    try std.testing.expectEqual(ShaderSource.bytecode, state.shader_source);
+
+    var payload: [4 * 2 * 3]u8 = undefined;
+    var phys_index: [4 * 2]u16 = undefined;
+    try display_logic.fillLayoutMap(4, 2, .{}, &phys_index);
+    try renderBytecodeFrame(&machine, null, 4, 2, &phys_index, 0.0, 0, payload[0..]);
+    // x=2, y=1 → r=0.5, g=0.5; column 2 is even so it is not serpentine-flipped.
+    const offset = @as(usize, phys_index[1 * 4 + 2]) * 3;
+    try std.testing.expectEqual(@as(u8, 128), payload[offset]);
+    try std.testing.expectEqual(@as(u8, 128), payload[offset + 1]);
+    try std.testing.expectEqual(@as(u8, 0), payload[offset + 2]);
+}
+
+test "v3 set params pins bytecode params until the next activation" {
+    const dsl_parser = @import("dsl_parser.zig");
+    const dsl_runtime = @import("dsl_runtime.zig");
+    const source =
+        \\effect sim_params
+        \\param level = 0.25
+        \\param wobble = sin(x * 0.3 + time)
+        \\layer l {
+        \\  blend rgba(level, 0.5 + 0.5 * wobble, 0.0, 1.0)
+        \\}
+        \\emit
+    ;
+
+    var arena = std.heap.ArenaAllocator.init(std.testing.allocator);
+    defer arena.deinit();
+    const program = try dsl_parser.parseAndValidate(arena.allocator(), source);
+    var evaluator = try dsl_runtime.Evaluator.init(std.testing.allocator, program);
+    defer evaluator.deinit();
+    var blob = std.ArrayList(u8).empty;
+    defer blob.deinit(std.testing.allocator);
+    try evaluator.writeBytecodeBinary(blob.writer(std.testing.allocator));
+
+    var machine = try bytecode_vm.Machine.init(std.testing.allocator, 4, 2);
+    defer machine.deinit();
+    var state = V3State{ .bytecode = &machine };
+    const level_entry = [_]u8{ 0x00, 0x3f, 0x40, 0x00, 0x00 }; // level = 0.75
+    try std.testing.expectEqual(v3_status_not_ready, handleV3SetParams(&state, &level_entry));
+    try std.testing.expectEqual(v3_status_ok, handleV3Upload(&state, blob.items));
+    try std.testing.expectEqual(v3_status_ok, handleV3Activate(&state, .bytecode, null, 0));
+
+    // wobble depends on x; names need a native shader; a bad entry rejects the whole batch.
+    try std.testing.expectEqual(v3_status_invalid_arg, handleV3SetParams(&state, &.{ 0x01, 0x00, 0x00, 0x00, 0x00 }));
+    try std.testing.expectEqual(v3_status_invalid_arg, handleV3SetParams(&state, &.{ v3_param_by_name, 5, 'l', 'e', 'v', 'e', 'l', 0x3f, 0x40, 0x00, 0x00 }));
+    try std.testing.expectEqual(v3_status_invalid_arg, handleV3SetParams(&state, &(level_entry ++ [_]u8{ 0x00, 0x7f, 0xc0, 0x00, 0x00 })));
+    try std.testing.expectEqual(v3_status_invalid_arg, handleV3SetParams(&state, level_entry[0..3]));
+
+    var payload: [4 * 2 * 3]u8 = undefined;
+    var phys_index: [4 * 2]u16 = undefined;
+    try display_logic.fillLayoutMap(4, 2, .{}, &phys_index);
+    try renderBytecodeFrame(&machine, null, 4, 2, &phys_index, 0.0, 0, payload[0..]);
+    try std.testing.expectEqual(@as(u8, 64), payload[0]);
+
+    try std.testing.expectEqual(v3_status_ok, handleV3SetParams(&state, &level_entry));
+    for (0..3) |frame| {
+        try renderBytecodeFrame(&machine, null, 4, 2, &phys_index, @floatFromInt(frame), @intCast(frame), payload[0..]);
+        try std.testing.expectEqual(@as(u8, 191), payload[0]);
+    }
+
+    try std.testing.expectEqual(v3_status_ok, handleV3Activate(&state, .bytecode, null, 0));
+    try renderBytecodeFrame(&machine, null, 4, 2, &phys_index, 0.0, 0, payload[0..]);
+    try std.testing.expectEqual(@as(u8, 64), payload[0]);
+}
+
+fn testBytecodeBlob(allocator: std.mem.Allocator, source: []const u8, blob: *std.ArrayList(u8)) !void {
+    const dsl_parser = @import("dsl_parser.zig");
+    const dsl_runtime = @import("dsl_runtime.zig");
+    var arena = std.heap.ArenaAllocator.init(allocator);
+    defer arena.deinit();
+    const program = try dsl_parser.parseAndValidate(arena.allocator(), source);
+    var evaluator = try dsl_runtime.Evaluator.init(allocator, program);
+    defer evaluator.deinit();
+    try evaluator.writeBytecodeBinary(blob.writer(allocator));
+}
+
+test "v3 uploads decode into the staged slot while the running program keeps rendering" {
+    var dim = std.ArrayList(u8).empty;
+    defer dim.deinit(std.testing.allocator);
+    try testBytecodeBlob(std.testing.allocator, "effect dim\nlayer l {\n  blend rgba(0.25, 0.0, 0.0, 1.0)\n}\nemit\n", &dim);
+    var bright = std.ArrayList(u8).empty;
+    defer bright.deinit(std.testing.allocator);
+    try testBytecodeBlob(std.testing.allocator, "effect bright\nlayer l {\n  blend rgba(0.75, 0.0, 0.0, 1.0)\n}\nemit\n", &bright);
+
+    var slot_a = try bytecode_vm.Machine.init(std.testing.allocator, 4, 2);
+    defer slot_a.deinit();
+    var slot_b = try bytecode_vm.Machine.init(std.testing.allocator, 4, 2);
+    defer slot_b.deinit();
+    var state = V3State{ .bytecode = &slot_a, .staged = &slot_b };
+    var payload: [4 * 2 * 3]u8 = undefined;
+    var phys_index: [4 * 2]u16 = undefined;
+    try display_logic.fillLayoutMap(4, 2, .{}, &phys_index);
+
+    try std.testing.expectEqual(v3_status_ok, handleV3Upload(&state, dim.items));
+    try std.testing.expectEqual(v3_status_ok, handleV3Activate(&state, .bytecode, null, 0));
+    try std.testing.expectEqual(&slot_b, state.bytecode.?);
+
+    // Neither a good nor a bad upload interrupts the running program.
+    try std.testing.expectEqual(v3_status_vm_error, handleV3Upload(&state, &[_]u8{ 'N', 'O', 'P', 'E' }));
+    try std.testing.expect(state.has_uploaded_program and !state.upload_staged);
+    try std.testing.expectEqual(v3_status_ok, handleV3Upload(&state, bright.items));
+    try std.testing.expect(state.shader_active);
+    try std.testing.expect(state.upload_staged);
+    try renderBytecodeFrame(state.bytecode.?, null, 4, 2, &phys_index, 0.0, 0, payload[0..]);
+    try std.testing.expectEqual(@as(u8, 64), payload[0]);
+
+    // 100 ms at 40 FPS: four frames fading from the old program to the new one.
+    try std.testing.expectEqual(v3_status_ok, handleV3Activate(&state, .bytecode, null, 100));
+    try std.testing.expectEqual(&slot_a, state.bytecode.?);
+    const expected_red = [_]u8{ 64, 96, 128, 159, 191, 191 };
+    for (expected_red, 0..) |red, frame| {
+        var crossfade = nextCrossfade(&state);
+        try renderBytecodeFrame(state.bytecode.?, if (crossfade) |*fade| fade else null, 4, 2, &phys_index, 0.0, @intCast(frame), payload[0..]);
+        try std.testing.expectEqual(red, payload[0]);
+    }
+
+    // Activating again restarts the running program in place.
+    try std.testing.expectEqual(v3_status_ok, handleV3Activate(&state, .bytecode, null, 100));
+    try std.testing.expectEqual(&slot_a, state.bytecode.?);
+    try std.testing.expectEqual(@as(u16, 0), state.crossfade_frames_left);
+}
+
 test "v3 bytecode activate requires upload first" {
     var state = V3State{};
-    try std.testing.expectEqual(v3_status_not_ready, handleV3Activate(&state, .bytecode, null));
+    try std.testing.expectEqual(v3_status_not_ready, handleV3Activate(&state, .bytecode, null, 0));
 }
 
 test "v3 stop deactivates shader state" {
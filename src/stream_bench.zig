@@ -0,0 +1,339 @@
+const std = @import("std");
+const tcp_client = @import("tcp_client.zig");
+const simulator = @import("simulator.zig");
+
+pub const Options = struct {
+    width: u16 = tcp_client.default_display_width,
+    height: u16 = tcp_client.default_display_height,
+    frame_rate_hz: u16 = tcp_client.default_frame_rate_hz,
+    duration_ms: u32 = 2000,
+    /// Time the receiver spends showing each frame, standing in for the pillar's LED transfer.
+    show_ns: u64 = 5 * std.time.ns_per_ms,
+};
+
+/// One-way delays added by the proxy in each direction (the round trip is twice this).
+pub const default_delays_ms = [_]u32{ 0, 5, 10, 20, 40 };
+/// 0 is protocol v2 (stop-and-wait); anything else is the v4 window the client asks for.
+pub const default_windows = [_]u16{ 0, 2, 4, 8 };
+
+pub const RunResult = struct {
+    window: u16 = 0,
+    frames_sent: u32 = 0,
+    frames_shown: u32 = 0,
+    frames_dropped: u32 = 0,
+    elapsed_ns: u64 = 0,
+
+    pub fn fps(self: RunResult) f64 {
+        if (self.elapsed_ns == 0) return 0.0;
+        return @as(f64, @floatFromInt(self.frames_sent)) * std.time.ns_per_s / @as(f64, @floatFromInt(self.elapsed_ns));
+    }
+};
+
+/// Stream paced frames for `options.duration_ms` from a `TcpClient` through a loopback proxy that
+/// delays both directions by `delay_ms`, into a receiver that speaks v2 and v4 like the simulator.
+pub fn benchmarkStream(allocator: std.mem.Allocator, delay_ms: u32, stream_window: u16, options: Options) !RunResult {
+    const pixel_count = @as(u32, options.width) * @as(u32, options.height);
+    const loopback = try std.net.Address.parseIp4("127.0.0.1", 0);
+
+    const payload = try allocator.alloc(u8, @as(usize, pixel_count) * tcp_client.PixelFormat.rgb.bytesPerPixel());
+    defer allocator.free(payload);
+    var sink = Sink{
+        .server = try loopback.listen(.{ .reuse_address = true }),
+        .expected_pixels = pixel_count,
+        .payload = payload,
+        .show_ns = options.show_ns,
+    };
+    defer sink.server.deinit();
+
+    const delay_ns = @as(u64, delay_ms) * std.time.ns_per_ms;
+    var proxy = DelayProxy{
+        .server = try loopback.listen(.{ .reuse_address = true }),
+        .upstream = sink.server.listen_address,
+        .to_sink = .{ .allocator = allocator, .delay_ns = delay_ns },
+        .to_client = .{ .allocator = allocator, .delay_ns = delay_ns },
+    };
+    defer proxy.server.deinit();
+    defer proxy.to_sink.deinit();
+    defer proxy.to_client.deinit();
+
+    const sink_thread = try std.Thread.spawn(.{}, Sink.run, .{&sink});
+    const proxy_thread = std.Thread.spawn(.{}, DelayProxy.run, .{&proxy}) catch |err| {
+        // Unblock the sink's accept so it can be joined.
+        if (std.net.tcpConnectToAddress(sink.server.listen_address)) |stream| stream.close() else |_| {}
+        sink_thread.join();
+        return err;
+    };
+
+    var result = RunResult{};
+    const stream_result = streamFrames(allocator, proxy.server.listen_address.getPort(), stream_window, options, payload.len, &result);
+    if (stream_result) |_| {} else |_| {
+        // The client may have failed before connecting; make sure the proxy's accept returns.
+        if (std.net.tcpConnectToAddress(proxy.server.listen_address)) |stream| stream.close() else |_| {}
+    }
+    proxy_thread.join();
+    sink_thread.join();
+    try stream_result;
+
+    result.frames_shown = sink.frames_shown;
+    result.frames_dropped = sink.frames_dropped;
+    return result;
+}
+
+fn streamFrames(allocator: std.mem.Allocator, port: u16, stream_window: u16, options: Options, payload_len: usize, result: *RunResult) !void {
+    var client = try tcp_client.TcpClient.init(allocator, .{
+        .host = "127.0.0.1",
+        .port = port,
+        .width = options.width,
+        .height = options.height,
+        .frame_rate_hz = options.frame_rate_hz,
+        .stream_window = stream_window,
+    });
+    defer client.deinit();
+    try client.connect();
+    result.window = client.window;
+
+    const pixels = try allocator.alloc(u8, payload_len);
+    defer allocator.free(pixels);
+
+    const frame_period_ns: u64 = std.time.ns_per_s / @as(u64, options.frame_rate_hz);
+    const duration_ns = @as(u64, options.duration_ms) * std.time.ns_per_ms;
+    var timer = try std.time.Timer.start();
+    var next_send_ns: u64 = 0;
+    while (timer.read() < duration_ns) {
+        const now = timer.read();
+        if (now < next_send_ns) {
+            std.Thread.sleep(next_send_ns - now);
+        } else if (now > next_send_ns + frame_period_ns) {
+            // Running behind because the protocol blocked: do not burst to catch up.
+            next_send_ns = now;
+        }
+        @memset(pixels, @truncate(result.frames_sent));
+        try client.sendFrame(pixels);
+        result.frames_sent += 1;
+        next_send_ns += frame_period_ns;
+    }
+    result.elapsed_ns = timer.read();
+    try client.finishPendingFrame();
+}
+
+/// Receiving end: v2 frames are shown and acknowledged one by one, v4 frames go through the
+/// simulator's hello and drop-oldest receive path.
+const Sink = struct {
+    server: std.net.Server,
+    expected_pixels: u32,
+    payload: []u8,
+    show_ns: u64,
+    frames_shown: u32 = 0,
+    frames_dropped: u32 = 0,
+
+    fn run(self: *Sink) void {
+        self.serve() catch |err| switch (err) {
+            error.EndOfStream => {},
+            else => std.debug.print("stream bench receiver: {s}\n", .{@errorName(err)}),
+        };
+    }
+
+    fn serve(self: *Sink) !void {
+        const connection = try self.server.accept();
+        defer connection.stream.close();
+        var reader_buffer: [16 * 1024]u8 = undefined;
+        var reader = connection.stream.reader(&reader_buffer);
+        var header_buf: [tcp_client.header_len]u8 = undefined;
+        var stream_format: ?simulator.FrameFormat = null;
+        // The bench streams raw frames only, so there is no reference to decode deltas against.
+        var receiver = simulator.FrameReceiver{ .reference = self.payload[0..0] };
+        var clock = try std.time.Timer.start();
+
+        while (true) {
+            try readExact(&reader, &header_buf);
+            if (header_buf[4] != tcp_client.stream_protocol_version) {
+                const frame_header = try simulator.parseHeader(&header_buf, self.expected_pixels);
+                if (frame_header.payload_len > self.payload.len) return error.FrameTooLarge;
+                const format = simulator.FrameFormat{ .pixel_format = frame_header.pixel_format, .encoded = frame_header.encoded };
+                _ = try receiver.receive(&reader, format, self.payload[0..frame_header.payload_len]);
+                self.show();
+                if (frame_header.protocol_version == tcp_client.protocol_version) {
+                    try connection.stream.writeAll(&[_]u8{tcp_client.ack_byte});
+                }
+                continue;
+            }
+
+            const header = try tcp_client.parseStreamHeader(&header_buf);
+            if (header.message == .hello) {
+                tcp_client.setNoDelay(connection.stream);
+                stream_format = try simulator.acceptStreamHello(connection.stream, &reader, header.value, self.expected_pixels);
+                continue;
+            }
+            if (header.message != .frame) return error.UnexpectedStreamMessage;
+            const format = stream_format orelse return error.StreamNotNegotiated;
+            const payload_len = @as(usize, self.expected_pixels) * format.pixel_format.bytesPerPixel();
+            if (payload_len > self.payload.len) return error.FrameTooLarge;
+            const frames = try simulator.receiveStreamFrames(connection.stream, &reader, header.value, &receiver, format, self.payload[0..payload_len], &clock);
+            self.frames_dropped += frames.dropped;
+            self.show();
+            try simulator.sendStreamMessage(connection.stream, .ack, frames.seq);
+        }
+    }
+
+    fn show(self: *Sink) void {
+        if (self.show_ns > 0) std.Thread.sleep(self.show_ns);
+        self.frames_shown += 1;
+    }
+
+    fn readExact(reader: *std.net.Stream.Reader, buffer: []u8) !void {
+        reader.interface().readSliceAll(buffer) catch |err| switch (err) {
+            error.ReadFailed => return reader.getError() orelse error.Unexpected,
+            else => return err,
+        };
+    }
+};
+
+/// Forwards one connection to `upstream`, holding every chunk for `delay_ns` in each direction.
+const DelayProxy = struct {
+    server: std.net.Server,
+    upstream: std.net.Address,
+    to_sink: DelayPipe,
+    to_client: DelayPipe,
+
+    fn run(self: *DelayProxy) void {
+        self.serve() catch |err| std.debug.print("stream bench proxy: {s}\n", .{@errorName(err)});
+    }
+
+    fn serve(self: *DelayProxy) !void {
+        const client = try self.server.accept();
+        defer client.stream.close();
+        const upstream = try std.net.tcpConnectToAddress(self.upstream);
+        defer upstream.close();
+        tcp_client.setNoDelay(client.stream);
+        tcp_client.setNoDelay(upstream);
+
+        const threads = [_]std.Thread{
+            try std.Thread.spawn(.{}, DelayPipe.pumpIn, .{ &self.to_sink, client.stream }),
+            try std.Thread.spawn(.{}, DelayPipe.pumpOut, .{ &self.to_sink, upstream }),
+            try std.Thread.spawn(.{}, DelayPipe.pumpIn, .{ &self.to_client, upstream }),
+            try std.Thread.spawn(.{}, DelayPipe.pumpOut, .{ &self.to_client, client.stream }),
+        };
+        for (threads) |thread| thread.join();
+    }
+};
+
+/// One direction of the proxy: `pumpIn` timestamps what it reads, `pumpOut` writes each chunk once it
+/// is `delay_ns` old, so the delay adds latency without limiting throughput.
+const DelayPipe = struct {
+    allocator: std.mem.Allocator,
+    delay_ns: u64,
+    mutex: std.Thread.Mutex = .{},
+    cond: std.Thread.Condition = .{},
+    chunks: std.ArrayList(Chunk) = .empty,
+    head: usize = 0,
+    closed: bool = false,
+
+    const Chunk = struct {
+        due_ns: i128,
+        data: []u8,
+    };
+
+    fn deinit(self: *DelayPipe) void {
+        for (self.chunks.items[self.head..]) |chunk| self.allocator.free(chunk.data);
+        self.chunks.deinit(self.allocator);
+    }
+
+    fn pumpIn(self: *DelayPipe, from: std.net.Stream) void {
+        var buffer: [16 * 1024]u8 = undefined;
+        while (true) {
+            const read_now = std.posix.recv(from.handle, &buffer, 0) catch 0;
+            if (read_now == 0) break;
+            const data = self.allocator.dupe(u8, buffer[0..read_now]) catch break;
+            self.mutex.lock();
+            defer self.mutex.unlock();
+            self.chunks.append(self.allocator, .{ .due_ns = std.time.nanoTimestamp() + self.delay_ns, .data = data }) catch {
+                self.allocator.free(data);
+                break;
+            };
+            self.cond.signal();
+        }
+        self.mutex.lock();
+        defer self.mutex.unlock();
+        self.closed = true;
+        self.cond.signal();
+    }
+
+    fn pumpOut(self: *DelayPipe, to: std.net.Stream) void {
+        var failed = false;
+        while (self.next()) |chunk| {
+            defer self.allocator.free(chunk.data);
+            const now = std.time.nanoTimestamp();
+            if (chunk.due_ns > now) std.Thread.sleep(@intCast(chunk.due_ns - now));
+            if (!failed) to.writeAll(chunk.data) catch {
+                failed = true;
+            };
+        }
+        // Pass the end of stream on, so the far side finishes and closes its end too.
+        std.posix.shutdown(to.handle, .send) catch {};
+    }
+
+    fn next(self: *DelayPipe) ?Chunk {
+        self.mutex.lock();
+        defer self.mutex.unlock();
+        while (self.head == self.chunks.items.len and !self.closed) self.cond.wait(&self.mutex);
+        if (self.head == self.chunks.items.len) return null;
+        const chunk = self.chunks.items[self.head];
+        self.head += 1;
+        if (self.head == self.chunks.items.len) {
+            self.chunks.clearRetainingCapacity();
+            self.head = 0;
+        }
+        return chunk;
+    }
+};
+
+/// Run every delay/window pair and write a JSON report.
+pub fn run(allocator: std.mem.Allocator, options: Options, writer: *std.Io.Writer) !void {
+    try writer.print(
+        "{{\n  \"width\": {d},\n  \"height\": {d},\n  \"frame_rate_hz\": {d},\n  \"duration_ms\": {d},\n  \"show_us\": {d},\n  \"runs\": [",
+        .{ options.width, options.height, options.frame_rate_hz, options.duration_ms, options.show_ns / std.time.ns_per_us },
+    );
+    var first = true;
+    for (default_delays_ms) |delay_ms| {
+        for (default_windows) |stream_window| {
+            const result = try benchmarkStream(allocator, delay_ms, stream_window, options);
+            try writer.writeAll(if (first) "\n" else ",\n");
+            first = false;
+            try writer.print(
+                "    {{ \"rtt_ms\": {d}, \"protocol\": \"{s}\", \"window\": {d}, \"fps\": {d:.1}, \"frames_sent\": {d}, \"frames_shown\": {d}, \"frames_dropped\": {d} }}",
+                .{
+                    delay_ms * 2,
+                    if (stream_window == 0) "v2" else "v4",
+                    if (stream_window == 0) 1 else result.window,
+                    result.fps(),
+                    result.frames_sent,
+                    result.frames_shown,
+                    result.frames_dropped,
+                },
+            );
+            try writer.flush();
+        }
+    }
+    try writer.writeAll("\n  ]\n}\n");
+    try writer.flush();
+}
+
+test "windowed streaming keeps its frame rate where stop-and-wait loses it to latency" {
+    // 60 ms round trip against a 25 ms frame period: v2 manages at most one frame per round trip.
+    const options = Options{ .width = 8, .height = 8, .duration_ms = 400, .show_ns = 0 };
+    const v2 = try benchmarkStream(std.testing.allocator, 30, 0, options);
+    const v4 = try benchmarkStream(std.testing.allocator, 30, 4, options);
+
+    try std.testing.expectEqual(@as(u16, 4), v4.window);
+    try std.testing.expectEqual(v2.frames_sent, v2.frames_shown);
+    try std.testing.expectEqual(v4.frames_sent, v4.frames_shown + v4.frames_dropped);
+    try std.testing.expect(v4.frames_sent > v2.frames_sent);
+}
+
+test "a receiver slower than the frame period drops superseded frames instead of queueing them" {
+    const options = Options{ .width = 8, .height = 8, .frame_rate_hz = 100, .duration_ms = 300, .show_ns = 30 * std.time.ns_per_ms };
+    const result = try benchmarkStream(std.testing.allocator, 0, 8, options);
+
+    try std.testing.expectEqual(result.frames_sent, result.frames_shown + result.frames_dropped);
+    try std.testing.expect(result.frames_dropped > 0);
+}
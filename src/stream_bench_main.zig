@@ -0,0 +1,17 @@
+const std = @import("std");
+const led = @import("led_pillar_zig");
+
+pub fn main() !void {
+    var args = try std.process.argsWithAllocator(std.heap.page_allocator);
+    defer args.deinit();
+
+    _ = args.next(); // skip argv[0]
+    var options = led.stream_bench.Options{};
+    if (args.next()) |duration_arg| {
+        options.duration_ms = try std.fmt.parseInt(u32, duration_arg, 10);
+    }
+
+    var stdout_buffer: [4096]u8 = undefined;
+    var stdout_writer = std.fs.File.stdout().writer(&stdout_buffer);
+    try led.stream_bench.run(std.heap.page_allocator, options, &stdout_writer.interface);
+}
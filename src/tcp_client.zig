@@ -1,4 +1,6 @@
 const std = @import("std");
+const frame_codec = @import("frame_codec.zig");
+const udp_stream = @import("udp_stream.zig");
 
 pub const default_display_height: u16 = 40;
 pub const default_display_width: u16 = 30;
@@ -9,6 +11,122 @@ pub const protocol_version: u8 = 0x02;
 pub const ack_byte: u8 = 0x06;
 pub const header_len: usize = 10;
 
+/// Windowed streaming: `LEDS`, 0x04, a big-endian u32 value and a message byte. The client opens with
+/// a hello (value = requested window, payload = pixel count + pixel format), the server replies with the
+/// granted window (0 = rejected). Frames carry a sequence number as value and ACKs are cumulative: an
+/// ACK for `n` covers every frame up to `n`, including frames the receiver dropped because a newer
+/// one was already queued behind them.
+pub const stream_protocol_version: u8 = 0x04;
+pub const max_stream_window: u16 = 8;
+pub const stream_hello_payload_len: usize = 5;
+/// Time reply payload: u64 BE times the receiver got and answered the request, on its own clock (us).
+pub const time_reply_payload_len: usize = 16;
+/// Set in the hello pixel format byte when every frame payload starts with a u64 BE presentation
+/// deadline on the receiver's clock (us).
+pub const present_flag: u8 = 0x40;
+pub const present_prefix_len: usize = 8;
+/// Time exchanges right after connecting, and how often one is repeated while streaming.
+pub const clock_sync_burst: usize = 8;
+pub const clock_sync_interval_us: i64 = std.time.us_per_s;
+
+pub const StreamMessage = enum(u8) {
+    hello = 0x01,
+    frame = 0x02,
+    /// Value is a request id; no payload. Allowed before the hello.
+    time_request = 0x03,
+    hello_reply = 0x81,
+    ack = 0x82,
+    time_reply = 0x83,
+    _,
+};
+
+pub const StreamHeader = struct {
+    message: StreamMessage,
+    value: u32,
+};
+
+pub fn writeStreamHeader(header: *[header_len]u8, message: StreamMessage, value: u32) void {
+    header[0..4].* = "LEDS".*;
+    header[4] = stream_protocol_version;
+    std.mem.writeInt(u32, header[5..9], value, .big);
+    header[9] = @intFromEnum(message);
+}
+
+pub fn parseStreamHeader(header: *const [header_len]u8) !StreamHeader {
+    if (!std.mem.eql(u8, header[0..4], "LEDS")) return error.InvalidMagic;
+    if (header[4] != stream_protocol_version) return error.UnsupportedProtocolVersion;
+    return .{
+        .message = @enumFromInt(header[9]),
+        .value = std.mem.readInt(u32, header[5..9], .big),
+    };
+}
+
+/// Best effort: with several frames in flight Nagle's algorithm would hold back the tail of a frame (or
+/// a small ACK) until the previous one is acknowledged, adding a round trip per frame.
+pub fn setNoDelay(stream: std.net.Stream) void {
+    std.posix.setsockopt(stream.handle, std.posix.IPPROTO.TCP, std.posix.TCP.NODELAY, &std.mem.toBytes(@as(c_int, 1))) catch {};
+}
+
+/// True when `buffered` (bytes a receiver has not consumed yet) starts with a complete v4 frame header,
+/// i.e. a newer frame is already queued behind the one just read.
+pub fn streamFrameQueued(buffered: []const u8) bool {
+    return streamMessageQueued(buffered, .frame);
+}
+
+pub fn streamMessageQueued(buffered: []const u8, message: StreamMessage) bool {
+    if (buffered.len < header_len) return false;
+    const header = parseStreamHeader(buffered[0..header_len]) catch return false;
+    return header.message == message;
+}
+
+pub const ClockSample = struct {
+    round_trip_us: i64,
+    /// Receiver clock minus sender clock.
+    offset_us: i64,
+};
+
+/// NTP-style offset between the sender's clock and the receiver's, filtered by minimum round trip: the
+/// exchange that waited least in queues bounds the offset most tightly, so of the last
+/// `clock_sync_samples` exchanges only the fastest is used.
+pub const ClockSync = struct {
+    pub const clock_sync_samples = 8;
+
+    samples: [clock_sync_samples]ClockSample = undefined,
+    count: usize = 0,
+    next: usize = 0,
+
+    /// `sent_us`/`received_us` on the sender's clock; `remote_received_us`/`remote_sent_us` on the
+    /// receiver's, from its time reply.
+    pub fn addSample(self: *ClockSync, sent_us: i64, remote_received_us: i64, remote_sent_us: i64, received_us: i64) void {
+        self.samples[self.next] = .{
+            .round_trip_us = (received_us - sent_us) - (remote_sent_us - remote_received_us),
+            .offset_us = @divFloor((remote_received_us - sent_us) + (remote_sent_us - received_us), 2),
+        };
+        self.next = (self.next + 1) % clock_sync_samples;
+        self.count = @min(self.count + 1, clock_sync_samples);
+    }
+
+    pub fn best(self: *const ClockSync) ?ClockSample {
+        if (self.count == 0) return null;
+        var fastest = self.samples[0];
+        for (self.samples[1..self.count]) |sample| {
+            if (sample.round_trip_us < fastest.round_trip_us) fastest = sample;
+        }
+        return fastest;
+    }
+
+    /// Receiver time for sender time `local_us`; null before the first exchange.
+    pub fn toRemote(self: *const ClockSync, local_us: i64) ?i64 {
+        const sample = self.best() orelse return null;
+        return local_us + sample.offset_us;
+    }
+
+    pub fn reset(self: *ClockSync) void {
+        self.count = 0;
+        self.next = 0;
+    }
+};
+
 pub const PixelFormat = enum(u8) {
     rgb = 0,
     rgbw = 1,
@@ -24,6 +142,12 @@ pub const PixelFormat = enum(u8) {
     }
 };
 
+pub const Transport = enum {
+    tcp,
+    /// Protocol v5 (`udp_stream`): fragmented datagrams, no ACKs; the receiver drops late frames.
+    udp,
+};
+
 pub const Config = struct {
     host: []const u8,
     port: u16 = default_port,
@@ -31,6 +155,19 @@ pub const Config = struct {
     height: u16 = default_display_height,
     frame_rate_hz: u16 = default_frame_rate_hz,
     pixel_format: PixelFormat = .rgb,
+    /// 0 streams with protocol v2 (one frame in flight, one ACK byte per frame); 1..`max_stream_window`
+    /// negotiates protocol v4 with up to that many unacknowledged frames.
+    stream_window: u16 = 0,
+    /// Send frames as `frame_codec` deltas against the previous frame (XOR+RLE or dirty spans, whichever
+    /// is smaller); the first frame of every connection goes out raw.
+    compress: bool = false,
+    /// `.udp` sends raw frames as v5 datagrams to the same port; it cannot be combined with
+    /// `stream_window` or `compress`.
+    transport: Transport = .tcp,
+    /// Above 0, v4 frames are stamped to be shown this long after they were scheduled, on the receiver's
+    /// clock (kept in sync with time requests), so network jitter no longer shows as judder. Needs
+    /// `stream_window`.
+    presentation_delay_us: u32 = 0,
 };
 
 pub const TcpClient = struct {
@@ -44,22 +181,59 @@ pub const TcpClient = struct {
     pixel_count: u32,
     payload_len: usize,
     frame_buffer: []u8,
+    stream_window: u16,
+    compress: bool,
+    /// Last frame sent on this connection, the receiver's delta reference; empty unless compressing.
+    previous_frame: []u8,
+    encode_scratch: []u8,
+    has_reference: bool = false,
     stream: ?std.net.Stream = null,
+    transport: Transport,
+    udp_socket: ?std.posix.socket_t = null,
+    udp_target: std.net.Address = undefined,
+    /// Presentation times are microseconds since `connect`.
+    udp_clock: std.time.Timer = undefined,
+    /// One v5 datagram; empty unless streaming over UDP.
+    datagram: []u8,
+    presentation_delay_us: u32,
+    /// Offset of `frame_buffer`'s payload: after the header and, for timed frames, the deadline.
+    payload_offset: usize,
+    clock: ClockSync = .{},
+    /// Outstanding time request: its id and send time (`std.time.microTimestamp`).
+    sync_request_id: u32 = 0,
+    sync_sent_us: ?i64 = null,
+    last_sync_us: i64 = 0,
     pending_ack: bool = false,
+    /// Window granted by the server for the current connection; 0 while streaming v2.
+    window: u16 = 0,
+    sent_seq: u32 = 0,
+    acked_seq: u32 = 0,
 
     pub fn init(allocator: std.mem.Allocator, config: Config) !TcpClient {
         if (config.width == 0 or config.height == 0) return error.InvalidDimensions;
         if (config.frame_rate_hz == 0) return error.InvalidFrameRate;
+        if (config.stream_window > max_stream_window) return error.InvalidStreamWindow;
+        if (config.transport == .udp and (config.compress or config.stream_window > 0 or config.presentation_delay_us > 0)) return error.UnsupportedUdpOption;
+        if (config.presentation_delay_us > 0 and config.stream_window == 0) return error.PresentationNeedsStreamWindow;
 
         const pixel_count = try std.math.mul(u32, @as(u32, config.width), @as(u32, config.height));
         const payload_len = try std.math.mul(usize, @as(usize, pixel_count), config.pixel_format.bytesPerPixel());
-        const frame_len = header_len + payload_len;
+        const payload_offset = header_len + (if (config.presentation_delay_us > 0) present_prefix_len else 0);
+        const frame_len = payload_offset + (if (config.compress) frame_codec.prefix_len else 0) + payload_len;
+        const reference_len = if (config.compress) payload_len else 0;
+        if (config.transport == .udp and udp_stream.fragmentCount(payload_len) > udp_stream.max_fragments) return error.FrameTooLargeForUdp;
 
         const host_copy = try allocator.dupe(u8, config.host);
         errdefer allocator.free(host_copy);
 
         const frame_buffer = try allocator.alloc(u8, frame_len);
         errdefer allocator.free(frame_buffer);
+        const previous_frame = try allocator.alloc(u8, reference_len);
+        errdefer allocator.free(previous_frame);
+        const encode_scratch = try allocator.alloc(u8, reference_len);
+        errdefer allocator.free(encode_scratch);
+        const datagram = try allocator.alloc(u8, if (config.transport == .udp) udp_stream.max_datagram_len else 0);
+        errdefer allocator.free(datagram);
 
         var client = TcpClient{
             .allocator = allocator,
@@ -72,6 +246,14 @@ pub const TcpClient = struct {
             .pixel_count = pixel_count,
             .payload_len = payload_len,
             .frame_buffer = frame_buffer,
+            .stream_window = config.stream_window,
+            .compress = config.compress,
+            .previous_frame = previous_frame,
+            .encode_scratch = encode_scratch,
+            .transport = config.transport,
+            .datagram = datagram,
+            .presentation_delay_us = config.presentation_delay_us,
+            .payload_offset = payload_offset,
         };
         client.writeHeader();
         return client;
@@ -79,14 +261,30 @@ pub const TcpClient = struct {
 
     pub fn deinit(self: *TcpClient) void {
         self.disconnect();
+        self.allocator.free(self.datagram);
+        self.allocator.free(self.encode_scratch);
+        self.allocator.free(self.previous_frame);
         self.allocator.free(self.frame_buffer);
         self.allocator.free(self.host);
     }
 
     pub fn connect(self: *TcpClient) !void {
+        if (self.transport == .udp) return self.connectUdp();
         if (self.stream != null) return;
-        self.stream = try std.net.tcpConnectToHost(self.allocator, self.host, self.port);
-        self.pending_ack = false;
+        const stream = try std.net.tcpConnectToHost(self.allocator, self.host, self.port);
+        errdefer stream.close();
+        self.resetFlowState();
+        if (self.stream_window > 0) {
+            setNoDelay(stream);
+            self.window = try self.negotiateStream(stream);
+            if (self.presentation_delay_us > 0) {
+                for (0..clock_sync_burst) |_| {
+                    try self.sendTimeRequest(stream);
+                    while (self.sync_sent_us != null) _ = try self.readStreamMessage(stream);
+                }
+            }
+        }
+        self.stream = stream;
     }
 
     pub fn disconnect(self: *TcpClient) void {
@@ -94,28 +292,81 @@ pub const TcpClient = struct {
             stream.close();
             self.stream = null;
         }
-        self.pending_ack = false;
+        if (self.udp_socket) |socket| {
+            udp_stream.closeSocket(socket);
+            self.udp_socket = null;
+        }
+        self.resetFlowState();
     }
 
     pub fn sendFrame(self: *TcpClient, pixels: []const u8) !void {
+        return self.sendFrameAt(pixels, std.time.microTimestamp());
+    }
+
+    /// Send a frame scheduled at `scheduled_us` (`std.time.microTimestamp`); with a presentation delay
+    /// the receiver shows it that long after the scheduled time, otherwise on arrival.
+    pub fn sendFrameAt(self: *TcpClient, pixels: []const u8, scheduled_us: i64) !void {
         if (pixels.len != self.payload_len) return error.InvalidFrameLength;
+        if (self.transport == .udp) return self.sendUdpFrame(pixels);
         const stream = self.stream orelse return error.NotConnected;
-        try self.waitForPendingAck(stream);
+        if (self.window == 0) {
+            try self.waitForPendingAck(stream);
+        } else {
+            // Only block once the window is full; ACKs are read as they are needed.
+            // Timed streams read replies as they arrive: a time reply read late looks like a slow exchange.
+            if (self.presentation_delay_us > 0) {
+                while (socketReadable(stream)) _ = try self.readStreamMessage(stream);
+            }
+            while (self.framesInFlight() >= self.window) try self.readStreamAck(stream);
+            self.sent_seq +%= 1;
+            writeStreamHeader(self.frame_buffer[0..header_len], .frame, self.sent_seq);
+            if (self.presentation_delay_us > 0) {
+                const present_at_us = self.clock.toRemote(scheduled_us + self.presentation_delay_us) orelse return error.ClockNotSynced;
+                std.mem.writeInt(u64, self.frame_buffer[header_len..][0..present_prefix_len], @bitCast(present_at_us), .big);
+            }
+        }
 
-        @memcpy(self.frame_buffer[header_len..], pixels);
-        try stream.writeAll(self.frame_buffer);
-        self.pending_ack = true;
+        if (self.compress) {
+            // A frame that is only partly written leaves the receiver without a usable reference.
+            self.has_reference = false;
+            try stream.writeAll(self.frame_buffer[0..self.encodePayload(pixels)]);
+            @memcpy(self.previous_frame, pixels);
+            self.has_reference = true;
+        } else {
+            @memcpy(self.frame_buffer[self.payload_offset..], pixels);
+            try stream.writeAll(self.frame_buffer);
+        }
+        if (self.window == 0) self.pending_ack = true;
+        // Right behind a frame, so the receiver answers it while it holds that frame.
+        if (self.presentation_delay_us > 0 and self.sync_sent_us == null and
+            std.time.microTimestamp() - self.last_sync_us >= clock_sync_interval_us)
+        {
+            try self.sendTimeRequest(stream);
+        }
     }
 
     pub fn finishPendingFrame(self: *TcpClient) !void {
+        // Nothing is acknowledged over UDP.
+        if (self.transport == .udp) {
+            if (self.udp_socket == null) return error.NotConnected;
+            return;
+        }
         const stream = self.stream orelse return error.NotConnected;
-        try self.waitForPendingAck(stream);
+        if (self.window == 0) return self.waitForPendingAck(stream);
+        while (self.framesInFlight() > 0) try self.readStreamAck(stream);
+    }
+
+    /// Frames sent but not yet covered by an ACK.
+    pub fn framesInFlight(self: *const TcpClient) u32 {
+        if (self.window == 0) return @intFromBool(self.pending_ack);
+        return self.sent_seq -% self.acked_seq;
     }
 
     pub fn expectedPayloadLen(self: *const TcpClient) usize {
         return self.payload_len;
     }
 
+    /// Upper bound when compressing; encoded frames are usually much shorter.
     pub fn expectedPacketLen(self: *const TcpClient) usize {
         return self.frame_buffer.len;
     }
@@ -131,7 +382,130 @@ pub const TcpClient = struct {
         header[6] = @as(u8, @intCast((self.pixel_count >> 16) & 0xff));
         header[7] = @as(u8, @intCast((self.pixel_count >> 8) & 0xff));
         header[8] = @as(u8, @intCast(self.pixel_count & 0xff));
-        header[9] = @intFromEnum(self.pixel_format);
+        header[9] = self.pixelFormatByte();
+    }
+
+    fn pixelFormatByte(self: *const TcpClient) u8 {
+        return @intFromEnum(self.pixel_format) | (if (self.compress) frame_codec.format_flag else 0);
+    }
+
+    /// Encode `pixels` behind the header and return the packet length.
+    fn encodePayload(self: *TcpClient, pixels: []const u8) usize {
+        const body = self.frame_buffer[self.payload_offset + frame_codec.prefix_len ..];
+        const reference: ?[]const u8 = if (self.has_reference) self.previous_frame else null;
+        const encoded = frame_codec.encodeFrame(reference, pixels, self.pixel_format.bytesPerPixel(), body, self.encode_scratch);
+        frame_codec.writePrefix(self.frame_buffer[self.payload_offset..][0..frame_codec.prefix_len], encoded.encoding, @intCast(encoded.len));
+        return self.payload_offset + frame_codec.prefix_len + encoded.len;
+    }
+
+    /// No handshake: resolve the host and open a socket to send datagrams from.
+    fn connectUdp(self: *TcpClient) !void {
+        if (self.udp_socket != null) return;
+        const list = try std.net.getAddressList(self.allocator, self.host, self.port);
+        defer list.deinit();
+        if (list.addrs.len == 0) return error.UnknownHostName;
+        const socket = try udp_stream.openUnboundSocket(list.addrs[0]);
+        errdefer udp_stream.closeSocket(socket);
+        self.udp_clock = try std.time.Timer.start();
+        self.resetFlowState();
+        self.udp_target = list.addrs[0];
+        self.udp_socket = socket;
+    }
+
+    /// Frame ids count up from 1 per connection, like v4 sequence numbers.
+    fn sendUdpFrame(self: *TcpClient, pixels: []const u8) !void {
+        const socket = self.udp_socket orelse return error.NotConnected;
+        self.sent_seq +%= 1;
+        var header = udp_stream.Header{
+            .frame_id = self.sent_seq,
+            .pixel_format = @intFromEnum(self.pixel_format),
+            .fragment_index = 0,
+            .fragment_count = @intCast(udp_stream.fragmentCount(pixels.len)),
+            .presentation_us = @truncate(self.udp_clock.read() / std.time.ns_per_us),
+            .pixel_count = self.pixel_count,
+        };
+        while (header.fragment_index < header.fragment_count) : (header.fragment_index += 1) {
+            const bytes = udp_stream.writeFragment(self.datagram[0..udp_stream.max_datagram_len], header, pixels);
+            _ = try std.posix.sendto(socket, bytes, 0, &self.udp_target.any, self.udp_target.getOsSockLen());
+        }
+    }
+
+    fn resetFlowState(self: *TcpClient) void {
+        self.pending_ack = false;
+        self.window = 0;
+        self.sent_seq = 0;
+        self.acked_seq = 0;
+        self.has_reference = false;
+        // The receiver's clock may have restarted with it.
+        self.clock.reset();
+        self.sync_sent_us = null;
+        self.last_sync_us = 0;
+    }
+
+    fn negotiateStream(self: *TcpClient, stream: std.net.Stream) !u16 {
+        var hello: [header_len + stream_hello_payload_len]u8 = undefined;
+        writeStreamHeader(hello[0..header_len], .hello, self.stream_window);
+        std.mem.writeInt(u32, hello[header_len..][0..4], self.pixel_count, .big);
+        hello[header_len + 4] = self.pixelFormatByte() | (if (self.presentation_delay_us > 0) present_flag else 0);
+        try stream.writeAll(&hello);
+
+        var reply: [header_len]u8 = undefined;
+        try readExact(stream, &reply);
+        const header = try parseStreamHeader(&reply);
+        if (header.message != .hello_reply) return error.InvalidStreamReply;
+        if (header.value == 0) return error.StreamRejected;
+        if (header.value > self.stream_window) return error.InvalidStreamReply;
+        return @intCast(header.value);
+    }
+
+    fn readStreamAck(self: *TcpClient, stream: std.net.Stream) !void {
+        while ((try self.readStreamMessage(stream)) != .ack) {}
+    }
+
+    /// Read one ACK or time reply.
+    fn readStreamMessage(self: *TcpClient, stream: std.net.Stream) !StreamMessage {
+        var reply: [header_len]u8 = undefined;
+        try readExact(stream, &reply);
+        const header = try parseStreamHeader(&reply);
+        switch (header.message) {
+            .ack => {
+                // Cumulative: one ACK may cover several frames, but never one that was not sent.
+                if (header.value -% self.acked_seq > self.framesInFlight()) return error.InvalidAck;
+                self.acked_seq = header.value;
+            },
+            .time_reply => {
+                var payload: [time_reply_payload_len]u8 = undefined;
+                try readExact(stream, &payload);
+                const received_us = std.time.microTimestamp();
+                const sent_us = self.sync_sent_us orelse return error.InvalidTimeReply;
+                if (header.value != self.sync_request_id) return error.InvalidTimeReply;
+                self.sync_sent_us = null;
+                self.clock.addSample(
+                    sent_us,
+                    @bitCast(std.mem.readInt(u64, payload[0..8], .big)),
+                    @bitCast(std.mem.readInt(u64, payload[8..16], .big)),
+                    received_us,
+                );
+            },
+            else => return error.InvalidAck,
+        }
+        return header.message;
+    }
+
+    fn sendTimeRequest(self: *TcpClient, stream: std.net.Stream) !void {
+        var request: [header_len]u8 = undefined;
+        self.sync_request_id +%= 1;
+        writeStreamHeader(&request, .time_request, self.sync_request_id);
+        const sent_us = std.time.microTimestamp();
+        try stream.writeAll(&request);
+        self.sync_sent_us = sent_us;
+        self.last_sync_us = sent_us;
+    }
+
+    fn socketReadable(stream: std.net.Stream) bool {
+        var fds = [_]std.posix.pollfd{.{ .fd = stream.handle, .events = std.posix.POLL.IN, .revents = 0 }};
+        const ready = std.posix.poll(&fds, 0) catch return false;
+        return ready > 0;
     }
 
     fn waitForPendingAck(self: *TcpClient, stream: std.net.Stream) !void {
@@ -142,13 +516,14 @@ pub const TcpClient = struct {
         if (ack[0] != ack_byte) return error.InvalidAck;
     }
 
+    /// Unbuffered: v4 ACKs can arrive back to back, so nothing past `buffer` may be read ahead and lost.
     fn readExact(stream: std.net.Stream, buffer: []u8) !void {
-        var reader_buffer: [256]u8 = undefined;
-        var reader = stream.reader(&reader_buffer);
-        reader.interface().readSliceAll(buffer) catch |err| switch (err) {
-            error.ReadFailed => return reader.getError() orelse error.Unexpected,
-            else => return err,
-        };
+        var filled: usize = 0;
+        while (filled < buffer.len) {
+            const read_now = try std.posix.recv(stream.handle, buffer[filled..], 0);
+            if (read_now == 0) return error.EndOfStream;
+            filled += read_now;
+        }
     }
 };
 
@@ -175,6 +550,16 @@ test "client init builds packet header" {
     try std.testing.expectEqual(@as(u8, @intFromEnum(PixelFormat.rgb)), header[9]);
 }
 
+test "compressing client flags the pixel format and reserves the payload prefix" {
+    var client = try TcpClient.init(std.testing.allocator, .{ .host = "127.0.0.1", .pixel_format = .grb, .compress = true });
+    defer client.deinit();
+
+    try std.testing.expectEqual(header_len + frame_codec.prefix_len + client.expectedPayloadLen(), client.expectedPacketLen());
+    try std.testing.expectEqual(@intFromEnum(PixelFormat.grb) | frame_codec.format_flag, client.frame_buffer[9]);
+    try std.testing.expectEqual(client.expectedPayloadLen(), client.previous_frame.len);
+    try std.testing.expect(!client.has_reference);
+}
+
 test "client init rejects invalid dimensions" {
     try std.testing.expectError(error.InvalidDimensions, TcpClient.init(std.testing.allocator, .{
         .host = "127.0.0.1",
@@ -216,3 +601,226 @@ test "disconnect clears pending ack state" {
     client.disconnect();
     try std.testing.expect(!client.pending_ack);
 }
+
+test "udp client rejects options that need a tcp connection" {
+    try std.testing.expectError(error.UnsupportedUdpOption, TcpClient.init(std.testing.allocator, .{
+        .host = "127.0.0.1",
+        .transport = .udp,
+        .compress = true,
+    }));
+    try std.testing.expectError(error.UnsupportedUdpOption, TcpClient.init(std.testing.allocator, .{
+        .host = "127.0.0.1",
+        .transport = .udp,
+        .stream_window = 2,
+    }));
+    try std.testing.expectError(error.FrameTooLargeForUdp, TcpClient.init(std.testing.allocator, .{
+        .host = "127.0.0.1",
+        .transport = .udp,
+        .width = 200,
+        .height = 200,
+    }));
+}
+
+test "udp client sends each frame as numbered fragments" {
+    const receiver = try udp_stream.openSocket(try std.net.Address.parseIp4("127.0.0.1", 0));
+    defer udp_stream.closeSocket(receiver);
+
+    var client = try TcpClient.init(std.testing.allocator, .{
+        .host = "127.0.0.1",
+        .port = (try udp_stream.boundAddress(receiver)).getPort(),
+        .transport = .udp,
+    });
+    defer client.deinit();
+    try client.connect();
+
+    const pixels = try std.testing.allocator.alloc(u8, client.expectedPayloadLen());
+    defer std.testing.allocator.free(pixels);
+    for (pixels, 0..) |*byte, i| byte.* = @truncate(i);
+    try client.sendFrame(pixels);
+    try client.finishPendingFrame();
+    try std.testing.expectEqual(@as(u32, 0), client.framesInFlight());
+
+    const fragment_count = udp_stream.fragmentCount(pixels.len);
+    try std.testing.expectEqual(@as(usize, 3), fragment_count);
+    var buffer: [udp_stream.max_datagram_len]u8 = undefined;
+    for (0..fragment_count) |index| {
+        const len = try std.posix.recv(receiver, &buffer, 0);
+        const datagram = try udp_stream.parse(buffer[0..len]);
+        try std.testing.expectEqual(@as(u32, 1), datagram.frame_id);
+        try std.testing.expectEqual(@as(u16, @intCast(index)), datagram.fragment_index);
+        try std.testing.expectEqual(client.pixel_count, datagram.pixel_count);
+        const start = index * udp_stream.fragment_len;
+        try std.testing.expectEqualSlices(u8, pixels[start..][0..datagram.fragment_len], datagram.fragment[0..datagram.fragment_len]);
+    }
+}
+
+test "client init rejects a window above the protocol maximum" {
+    try std.testing.expectError(error.InvalidStreamWindow, TcpClient.init(std.testing.allocator, .{
+        .host = "127.0.0.1",
+        .stream_window = max_stream_window + 1,
+    }));
+}
+
+test "stream header round-trips and detects queued frames" {
+    var header: [header_len]u8 = undefined;
+    writeStreamHeader(&header, .frame, 0x01020304);
+    try std.testing.expectEqualSlices(u8, &[_]u8{ 'L', 'E', 'D', 'S', stream_protocol_version, 1, 2, 3, 4, 0x02 }, &header);
+
+    const parsed = try parseStreamHeader(&header);
+    try std.testing.expectEqual(StreamMessage.frame, parsed.message);
+    try std.testing.expectEqual(@as(u32, 0x01020304), parsed.value);
+
+    try std.testing.expect(streamFrameQueued(&header));
+    try std.testing.expect(!streamFrameQueued(header[0 .. header_len - 1]));
+    writeStreamHeader(&header, .hello, 4);
+    try std.testing.expect(!streamFrameQueued(&header));
+    header[4] = protocol_version;
+    try std.testing.expectError(error.UnsupportedProtocolVersion, parseStreamHeader(&header));
+}
+
+test "windowed client keeps several frames in flight and accepts cumulative acks" {
+    const address = try std.net.Address.parseIp4("127.0.0.1", 0);
+    var server = try address.listen(.{ .reuse_address = true });
+    defer server.deinit();
+
+    const Server = struct {
+        fn run(listener: *std.net.Server) !void {
+            const connection = try listener.accept();
+            defer connection.stream.close();
+            var request: [header_len + stream_hello_payload_len]u8 = undefined;
+            try TcpClient.readExact(connection.stream, &request);
+            const hello = try parseStreamHeader(request[0..header_len]);
+            try std.testing.expectEqual(StreamMessage.hello, hello.message);
+            try std.testing.expectEqual(@as(u32, 16), std.mem.readInt(u32, request[header_len..][0..4], .big));
+
+            var reply: [header_len]u8 = undefined;
+            writeStreamHeader(&reply, .hello_reply, 3);
+            try connection.stream.writeAll(&reply);
+
+            // Take three frames before acknowledging anything, then cover them with one ACK.
+            var frame: [header_len + 16 * 3]u8 = undefined;
+            for (0..3) |_| try TcpClient.readExact(connection.stream, &frame);
+            writeStreamHeader(&reply, .ack, (try parseStreamHeader(frame[0..header_len])).value);
+            try connection.stream.writeAll(&reply);
+
+            try TcpClient.readExact(connection.stream, &frame);
+            writeStreamHeader(&reply, .ack, (try parseStreamHeader(frame[0..header_len])).value);
+            try connection.stream.writeAll(&reply);
+        }
+    };
+
+    var server_thread = try std.Thread.spawn(.{}, Server.run, .{&server});
+    defer server_thread.join();
+
+    var client = try TcpClient.init(std.testing.allocator, .{
+        .host = "127.0.0.1",
+        .port = server.listen_address.getPort(),
+        .width = 4,
+        .height = 4,
+        .stream_window = 4,
+    });
+    defer client.deinit();
+    try client.connect();
+    try std.testing.expectEqual(@as(u16, 3), client.window);
+
+    const pixels: [16 * 3]u8 = @splat(0);
+    for (0..3) |_| try client.sendFrame(&pixels);
+    try std.testing.expectEqual(@as(u32, 3), client.framesInFlight());
+    // The window is full: the fourth frame waits for the cumulative ACK of the first three.
+    try client.sendFrame(&pixels);
+    try std.testing.expectEqual(@as(u32, 3), client.acked_seq);
+    try std.testing.expectEqual(@as(u32, 1), client.framesInFlight());
+    try client.finishPendingFrame();
+    try std.testing.expectEqual(@as(u32, 4), client.acked_seq);
+    try std.testing.expectEqual(@as(u32, 0), client.framesInFlight());
+}
+
+test "clock sync keeps the offset of the fastest exchange" {
+    var clock = ClockSync{};
+    try std.testing.expect(clock.toRemote(0) == null);
+
+    // Receiver clock 5000 us ahead. A slow exchange whose reply waited 800 us skews the midpoint by 400 us.
+    clock.addSample(1000, 6025, 6075, 1900);
+    try std.testing.expectEqual(@as(i64, 4600), clock.best().?.offset_us);
+    clock.addSample(3000, 8025, 8075, 3100);
+    try std.testing.expectEqual(@as(i64, 50), clock.best().?.round_trip_us);
+    try std.testing.expectEqual(@as(i64, 5000), clock.best().?.offset_us);
+    clock.addSample(4000, 9025, 9075, 4300);
+    try std.testing.expectEqual(@as(?i64, 15000), clock.toRemote(10000));
+
+    // Only the last samples count: once the fast one is pushed out, the best of the rest is used.
+    for (0..ClockSync.clock_sync_samples) |_| clock.addSample(0, 5300, 5300, 400);
+    try std.testing.expectEqual(@as(i64, 400), clock.best().?.round_trip_us);
+    try std.testing.expectEqual(@as(i64, 5100), clock.best().?.offset_us);
+}
+
+test "presentation delay needs a stream window" {
+    try std.testing.expectError(error.PresentationNeedsStreamWindow, TcpClient.init(std.testing.allocator, .{
+        .host = "127.0.0.1",
+        .presentation_delay_us = 40 * std.time.us_per_ms,
+    }));
+}
+
+test "timed client syncs the receiver clock and stamps frames with its deadline" {
+    const address = try std.net.Address.parseIp4("127.0.0.1", 0);
+    var server = try address.listen(.{ .reuse_address = true });
+    defer server.deinit();
+    const Server = struct {
+        // The receiver's clock runs 10 s ahead of the sender's.
+        const remote_ahead_us: i64 = 10 * std.time.us_per_s;
+        const delay_us: u32 = 40 * std.time.us_per_ms;
+
+        fn run(listener: *std.net.Server, deadline_error_us: *i64) !void {
+            const connection = try listener.accept();
+            defer connection.stream.close();
+            var request: [header_len + stream_hello_payload_len]u8 = undefined;
+            try TcpClient.readExact(connection.stream, &request);
+            try std.testing.expectEqual(@intFromEnum(PixelFormat.rgb) | present_flag, request[header_len + 4]);
+            var reply: [header_len + time_reply_payload_len]u8 = undefined;
+            writeStreamHeader(reply[0..header_len], .hello_reply, 2);
+            try connection.stream.writeAll(reply[0..header_len]);
+
+            var header: [header_len]u8 = undefined;
+            for (0..clock_sync_burst) |_| {
+                try TcpClient.readExact(connection.stream, &header);
+                const time_request = try parseStreamHeader(&header);
+                try std.testing.expectEqual(StreamMessage.time_request, time_request.message);
+                const now_us = std.time.microTimestamp() + remote_ahead_us;
+                writeStreamHeader(reply[0..header_len], .time_reply, time_request.value);
+                std.mem.writeInt(u64, reply[header_len..][0..8], @bitCast(now_us), .big);
+                std.mem.writeInt(u64, reply[header_len + 8 ..][0..8], @bitCast(now_us), .big);
+                try connection.stream.writeAll(&reply);
+            }
+
+            var frame: [header_len + present_prefix_len + 4 * 3]u8 = undefined;
+            try TcpClient.readExact(connection.stream, &frame);
+            const frame_header = try parseStreamHeader(frame[0..header_len]);
+            try std.testing.expectEqual(StreamMessage.frame, frame_header.message);
+            const present_at_us: i64 = @bitCast(std.mem.readInt(u64, frame[header_len..][0..8], .big));
+            deadline_error_us.* = present_at_us - (std.time.microTimestamp() + remote_ahead_us + delay_us);
+            writeStreamHeader(reply[0..header_len], .ack, frame_header.value);
+            try connection.stream.writeAll(reply[0..header_len]);
+        }
+    };
+
+    var deadline_error_us: i64 = std.math.maxInt(i64);
+    var server_thread = try std.Thread.spawn(.{}, Server.run, .{ &server, &deadline_error_us });
+    var client = try TcpClient.init(std.testing.allocator, .{
+        .host = "127.0.0.1",
+        .port = server.listen_address.getPort(),
+        .width = 2,
+        .height = 2,
+        .stream_window = 2,
+        .presentation_delay_us = Server.delay_us,
+    });
+    defer client.deinit();
+    try client.connect();
+    try std.testing.expectEqual(@as(usize, ClockSync.clock_sync_samples), client.clock.count);
+
+    const pixels: [4 * 3]u8 = @splat(0);
+    try client.sendFrame(&pixels);
+    try client.finishPendingFrame();
+    server_thread.join();
+    // Loopback round trips are far below this; a wrong offset would be off by about 10 s.
+    try std.testing.expect(@abs(deadline_error_us) < 50 * std.time.us_per_ms);
+}
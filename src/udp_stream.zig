@@ -0,0 +1,313 @@
+const std = @import("std");
+const builtin = @import("builtin");
+
+/// Raw bindings to the firmware's UDP frame stream (`esp32_firmware/main/fw_udp_stream.c`): datagram parsing
+/// and the presentation jitter buffer, so the simulator reassembles and drops frames exactly like the pillar.
+pub const c = @cImport({
+    @cInclude("fw_udp_stream.h");
+});
+
+pub const Error = error{
+    InvalidDatagram,
+    InvalidJitterConfig,
+};
+
+pub const protocol_version: u8 = c.FW_UDP_STREAM_PROTOCOL_VERSION;
+pub const header_len: usize = c.FW_UDP_STREAM_HEADER_LEN;
+/// Payload bytes per datagram; the last fragment of a frame is shorter.
+pub const fragment_len: usize = c.FW_UDP_STREAM_FRAGMENT_LEN;
+pub const max_datagram_len: usize = header_len + fragment_len;
+pub const max_fragments: usize = c.FW_UDP_STREAM_MAX_FRAGMENTS;
+pub const max_jitter_slots: u8 = c.FW_UDP_STREAM_MAX_SLOTS;
+/// Same defaults as the firmware's `FW_UDP_JITTER_SLOTS` / `FW_UDP_JITTER_DELAY_MS`.
+pub const default_jitter_slots: u8 = 3;
+pub const default_jitter_delay_us: u32 = 30 * std.time.us_per_ms;
+
+pub const Header = struct {
+    frame_id: u32,
+    pixel_format: u8,
+    fragment_index: u16,
+    fragment_count: u16,
+    presentation_us: u32,
+    pixel_count: u32,
+};
+
+pub const Datagram = c.fw_udp_datagram_t;
+pub const Stats = c.fw_udp_jitter_stats_t;
+
+pub const Frame = struct {
+    pixels: []const u8,
+    frame_id: u32,
+    pixel_format: u8,
+};
+
+pub fn writeHeader(out: *[header_len]u8, header: Header) void {
+    out[0..4].* = "LEDS".*;
+    out[4] = protocol_version;
+    std.mem.writeInt(u32, out[5..9], header.frame_id, .big);
+    out[9] = header.pixel_format;
+    std.mem.writeInt(u16, out[10..12], header.fragment_index, .big);
+    std.mem.writeInt(u16, out[12..14], header.fragment_count, .big);
+    std.mem.writeInt(u32, out[14..18], header.presentation_us, .big);
+    std.mem.writeInt(u32, out[18..22], header.pixel_count, .big);
+}
+
+/// Build datagram `header.fragment_index` of `frame` in `out`.
+pub fn writeFragment(out: *[max_datagram_len]u8, header: Header, frame: []const u8) []const u8 {
+    writeHeader(out[0..header_len], header);
+    const start = @as(usize, header.fragment_index) * fragment_len;
+    const len = @min(frame.len - start, fragment_len);
+    @memcpy(out[header_len..][0..len], frame[start..][0..len]);
+    return out[0 .. header_len + len];
+}
+
+pub fn fragmentCount(frame_len: usize) usize {
+    return c.fw_udp_stream_fragment_count(frame_len);
+}
+
+/// The fragment points into `bytes`.
+pub fn parse(bytes: []const u8) Error!Datagram {
+    var datagram: Datagram = undefined;
+    if (c.fw_udp_stream_parse(bytes.ptr, bytes.len, &datagram) != 0) return error.InvalidDatagram;
+    return datagram;
+}
+
+/// Owns the slot storage of one firmware jitter buffer. Times are microseconds on any monotonic clock.
+pub const JitterBuffer = struct {
+    allocator: std.mem.Allocator,
+    storage: []u8,
+    state: c.fw_udp_jitter_t,
+
+    pub fn init(allocator: std.mem.Allocator, slot_len: usize, slot_count: u8, delay_us: u32) !JitterBuffer {
+        const storage = try allocator.alloc(u8, try std.math.mul(usize, slot_len, slot_count));
+        errdefer allocator.free(storage);
+        var buffer = JitterBuffer{ .allocator = allocator, .storage = storage, .state = undefined };
+        if (c.fw_udp_jitter_init(&buffer.state, storage.ptr, slot_len, slot_count, delay_us) != 0) return error.InvalidJitterConfig;
+        return buffer;
+    }
+
+    pub fn deinit(self: *JitterBuffer) void {
+        self.allocator.free(self.storage);
+    }
+
+    /// `frame_len` is the decoded size of the datagram's frame on this display. False when dropped.
+    pub fn push(self: *JitterBuffer, datagram: *const Datagram, frame_len: usize, now_us: i64) bool {
+        return c.fw_udp_jitter_push(&self.state, datagram, frame_len, now_us) == 0;
+    }
+
+    /// Newest complete frame due at `now_us`; its pixels stay valid until the next `push`.
+    pub fn pop(self: *JitterBuffer, now_us: i64) ?Frame {
+        var frame: c.fw_udp_frame_t = undefined;
+        if (!c.fw_udp_jitter_pop(&self.state, now_us, &frame)) return null;
+        return .{ .pixels = frame.pixels[0..frame.len], .frame_id = frame.frame_id, .pixel_format = frame.pixel_format };
+    }
+
+    pub fn nextDue(self: *const JitterBuffer) ?i64 {
+        var due_us: i64 = 0;
+        return if (c.fw_udp_jitter_next_due(&self.state, &due_us)) due_us else null;
+    }
+
+    /// A datagram rejected before it reached the buffer, e.g. for the wrong pixel count.
+    pub fn recordInvalid(self: *JitterBuffer) void {
+        self.state.stats.datagrams_invalid += 1;
+    }
+
+    pub fn stats(self: *const JitterBuffer) Stats {
+        return self.state.stats;
+    }
+};
+
+pub const MangleAction = enum {
+    forward,
+    drop,
+    duplicate,
+    /// Keep the datagram and forward it right after the next one, swapping the two.
+    hold,
+};
+
+/// Loopback stand-in for a lossy network: a UDP socket that relays what is sent to `address` on to
+/// `target`, applying `plan` in turn (cycling) so tests see reproducible loss, duplicates and reordering.
+pub const Mangler = struct {
+    socket: std.posix.socket_t,
+    address: std.net.Address,
+    target: std.net.Address,
+    plan: []const MangleAction,
+    next_action: usize = 0,
+    held: [max_datagram_len]u8 = undefined,
+    held_len: ?usize = null,
+    forwarded: usize = 0,
+
+    pub fn init(target: std.net.Address, plan: []const MangleAction) !Mangler {
+        const socket = try openSocket(try std.net.Address.parseIp4("127.0.0.1", 0));
+        errdefer closeSocket(socket);
+        return .{ .socket = socket, .address = try boundAddress(socket), .target = target, .plan = plan };
+    }
+
+    pub fn deinit(self: *Mangler) void {
+        closeSocket(self.socket);
+    }
+
+    /// Receive `count` datagrams and relay them; a datagram still held at the end is forwarded last.
+    pub fn relay(self: *Mangler, count: usize) !void {
+        var buffer: [max_datagram_len]u8 = undefined;
+        for (0..count) |_| {
+            const len = try std.posix.recv(self.socket, &buffer, 0);
+            const action = if (self.plan.len == 0) MangleAction.forward else self.plan[self.next_action % self.plan.len];
+            self.next_action += 1;
+            switch (action) {
+                .forward => try self.forward(buffer[0..len]),
+                .drop => {},
+                .duplicate => {
+                    try self.forward(buffer[0..len]);
+                    try self.forward(buffer[0..len]);
+                },
+                .hold => {
+                    try self.flushHeld();
+                    @memcpy(self.held[0..len], buffer[0..len]);
+                    self.held_len = len;
+                    continue;
+                },
+            }
+            try self.flushHeld();
+        }
+        try self.flushHeld();
+    }
+
+    fn flushHeld(self: *Mangler) !void {
+        const len = self.held_len orelse return;
+        self.held_len = null;
+        try self.forward(self.held[0..len]);
+    }
+
+    fn forward(self: *Mangler, bytes: []const u8) !void {
+        _ = try std.posix.sendto(self.socket, bytes, 0, &self.target.any, self.target.getOsSockLen());
+        self.forwarded += 1;
+    }
+};
+
+const socket_flags: u32 = if (builtin.os.tag == .windows) 0 else std.posix.SOCK.CLOEXEC;
+
+/// UDP socket bound to `address` (port 0 picks a free one).
+pub fn openSocket(address: std.net.Address) !std.posix.socket_t {
+    const socket = try openUnboundSocket(address);
+    errdefer closeSocket(socket);
+    try std.posix.bind(socket, &address.any, address.getOsSockLen());
+    return socket;
+}
+
+/// UDP socket for sending to addresses of `address`'s family.
+pub fn openUnboundSocket(address: std.net.Address) !std.posix.socket_t {
+    return std.posix.socket(address.any.family, std.posix.SOCK.DGRAM | socket_flags, std.posix.IPPROTO.UDP);
+}
+
+pub fn closeSocket(socket: std.posix.socket_t) void {
+    (std.net.Stream{ .handle = socket }).close();
+}
+
+pub fn boundAddress(socket: std.posix.socket_t) !std.net.Address {
+    var address: std.net.Address = undefined;
+    var address_len: std.posix.socklen_t = @sizeOf(std.net.Address);
+    try std.posix.getsockname(socket, &address.any, &address_len);
+    return address;
+}
+
+fn testDatagram(out: *[max_datagram_len]u8, frame: []const u8, frame_id: u32, fragment_index: u16, presentation_us: u32) !Datagram {
+    const fragment_count: u16 = @intCast(fragmentCount(frame.len));
+    return parse(writeFragment(out, .{
+        .frame_id = frame_id,
+        .pixel_format = 0,
+        .fragment_index = fragment_index,
+        .fragment_count = fragment_count,
+        .presentation_us = presentation_us,
+        .pixel_count = @intCast(frame.len / 3),
+    }, frame));
+}
+
+test "fragments round-trip through the firmware parser" {
+    var frame: [fragment_len + 6]u8 = undefined;
+    for (&frame, 0..) |*byte, i| byte.* = @truncate(i);
+    try std.testing.expectEqual(@as(usize, 2), fragmentCount(frame.len));
+    try std.testing.expectEqual(@as(usize, 1), fragmentCount(fragment_len));
+
+    var out: [max_datagram_len]u8 = undefined;
+    const datagram = try testDatagram(&out, &frame, 0x01020304, 1, 77);
+    try std.testing.expectEqual(@as(u32, 0x01020304), datagram.frame_id);
+    try std.testing.expectEqual(@as(u16, 1), datagram.fragment_index);
+    try std.testing.expectEqual(@as(u16, 2), datagram.fragment_count);
+    try std.testing.expectEqual(@as(u32, 77), datagram.presentation_us);
+    try std.testing.expectEqual(@as(u32, frame.len / 3), datagram.pixel_count);
+    try std.testing.expectEqualSlices(u8, frame[fragment_len..], datagram.fragment[0..datagram.fragment_len]);
+
+    out[4] = 0x04;
+    try std.testing.expectError(error.InvalidDatagram, parse(&out));
+    try std.testing.expectError(error.InvalidDatagram, parse(out[0 .. header_len - 1]));
+}
+
+test "jitter buffer holds frames until due and shows the newest" {
+    var jitter = try JitterBuffer.init(std.testing.allocator, 6, 3, 1000);
+    defer jitter.deinit();
+    var out: [max_datagram_len]u8 = undefined;
+
+    // Frame 1 sets the clock mapping: due 1000 us after it arrived.
+    try std.testing.expect(jitter.push(&try testDatagram(&out, &@as([6]u8, @splat(1)), 1, 0, 0), 6, 5000));
+    try std.testing.expectEqual(@as(?i64, 6000), jitter.nextDue());
+    try std.testing.expect(jitter.pop(5999) == null);
+    try std.testing.expect(jitter.push(&try testDatagram(&out, &@as([6]u8, @splat(2)), 2, 0, 500), 6, 5500));
+
+    // Both are due: frame 2 is shown, frame 1 skipped, and frame 1 arriving again is late.
+    const frame = jitter.pop(7000).?;
+    try std.testing.expectEqual(@as(u32, 2), frame.frame_id);
+    try std.testing.expectEqualSlices(u8, &@as([6]u8, @splat(2)), frame.pixels);
+    try std.testing.expect(!jitter.push(&try testDatagram(&out, &@as([6]u8, @splat(1)), 1, 0, 0), 6, 7000));
+    const stats = jitter.stats();
+    try std.testing.expectEqual(@as(u32, 1), stats.frames_shown);
+    try std.testing.expectEqual(@as(u32, 1), stats.frames_skipped);
+    try std.testing.expectEqual(@as(u32, 1), stats.datagrams_late);
+}
+
+test "jitter buffer drops a frame with a lost fragment without stalling the next" {
+    var frame: [fragment_len * 2]u8 = @splat(7);
+    var jitter = try JitterBuffer.init(std.testing.allocator, frame.len, 2, 0);
+    defer jitter.deinit();
+    var out: [max_datagram_len]u8 = undefined;
+
+    try std.testing.expect(jitter.push(&try testDatagram(&out, &frame, 1, 0, 0), frame.len, 0));
+    try std.testing.expect(jitter.pop(100) == null);
+    // Frame 2 arrives reordered; once complete it replaces the incomplete frame 1.
+    frame[0] = 9;
+    try std.testing.expect(jitter.push(&try testDatagram(&out, &frame, 2, 1, 100), frame.len, 150));
+    try std.testing.expect(jitter.push(&try testDatagram(&out, &frame, 2, 0, 100), frame.len, 160));
+    const shown = jitter.pop(200).?;
+    try std.testing.expectEqual(@as(u32, 2), shown.frame_id);
+    try std.testing.expectEqualSlices(u8, &frame, shown.pixels);
+    try std.testing.expectEqual(@as(u32, 1), jitter.stats().frames_incomplete);
+}
+
+test "jitter buffer rejects invalid slot configuration" {
+    try std.testing.expectError(error.InvalidJitterConfig, JitterBuffer.init(std.testing.allocator, 6, 1, 0));
+    try std.testing.expectError(error.InvalidJitterConfig, JitterBuffer.init(std.testing.allocator, 6, max_jitter_slots + 1, 0));
+}
+
+test "mangler drops, duplicates and swaps datagrams" {
+    const receiver = try openSocket(try std.net.Address.parseIp4("127.0.0.1", 0));
+    defer closeSocket(receiver);
+    var mangler = try Mangler.init(try boundAddress(receiver), &.{ .hold, .forward, .drop, .duplicate });
+    defer mangler.deinit();
+    const sender = try openSocket(try std.net.Address.parseIp4("127.0.0.1", 0));
+    defer closeSocket(sender);
+
+    for (1..5) |i| {
+        const byte = [_]u8{@intCast(i)};
+        _ = try std.posix.sendto(sender, &byte, 0, &mangler.address.any, mangler.address.getOsSockLen());
+    }
+    try mangler.relay(4);
+    try std.testing.expectEqual(@as(usize, 4), mangler.forwarded);
+
+    var received: [4]u8 = undefined;
+    for (&received) |*byte| {
+        var buffer: [1]u8 = undefined;
+        _ = try std.posix.recv(receiver, &buffer, 0);
+        byte.* = buffer[0];
+    }
+    try std.testing.expectEqualSlices(u8, &[_]u8{ 2, 1, 4, 4 }, &received);
+}
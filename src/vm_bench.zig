@@ -0,0 +1,403 @@
+const std = @import("std");
+const dsl_parser = @import("dsl_parser.zig");
+const dsl_runtime = @import("dsl_runtime.zig");
+const bytecode_vm = @import("bytecode_vm.zig");
+
+pub const Options = struct {
+    width: u16 = 30,
+    height: u16 = 40,
+    frames: u32 = 100,
+    warmup_frames: u32 = 5,
+    frame_rate_hz: f32 = 40.0,
+    /// Uploads per shader for the render stall measurement.
+    uploads: u32 = 8,
+};
+
+pub const ShaderResult = struct {
+    status: []const u8,
+    blob_bytes: usize = 0,
+    /// Firmware RAM for the loaded program and for its runtime, each a struct plus an arena sized to the program.
+    program_bytes: usize = 0,
+    runtime_bytes: usize = 0,
+    decoded_ops: usize = 0,
+    register_form: bool = false,
+    register_ops: usize = 0,
+    registers: usize = 0,
+    fusions: [bytecode_vm.fusion_kind_count]usize = @splat(0),
+    fused_away_ops: usize = 0,
+    hoisted_lets: [bytecode_vm.hoist_rate_count]usize = @splat(0),
+    hoisted_values: usize = 0,
+    pixel_depends_xy: bool = false,
+    ns_per_frame: u64 = 0,
+    ns_per_pixel: f64 = 0.0,
+    upload_stall: UploadStall = .{},
+};
+
+/// What a render loop sees while `Options.uploads` re-uploads replace its program, with one program slot
+/// (as before hot swap) and with two. Gaps are the longest time between two frame starts.
+pub const UploadStall = struct {
+    /// Rendering with no upload running, for reference.
+    idle_gap_ns: u64 = 0,
+    /// One slot: the upload decodes and initializes the runtime the render loop uses under its lock.
+    in_place_gap_ns: u64 = 0,
+    in_place_lock_ns: u64 = 0,
+    /// Two slots: decode and runtime init run in the idle slot; only the slot swap holds the lock.
+    swap_gap_ns: u64 = 0,
+    swap_lock_ns: u64 = 0,
+};
+
+/// Time the firmware VM on one compiled blob: `begin_frame` plus `eval_row` for every row, per frame,
+/// matching how the firmware renders.
+pub fn benchmarkBlob(allocator: std.mem.Allocator, blob: []const u8, seed: f32, options: Options) !ShaderResult {
+    var machine = try bytecode_vm.Machine.init(allocator, options.width, options.height);
+    defer machine.deinit();
+    machine.load(blob) catch |err| switch (err) {
+        error.BytecodeLoadFailed => return .{ .status = machine.lastStatusName(), .blob_bytes = blob.len },
+        else => return err,
+    };
+    machine.start(seed) catch return .{ .status = machine.lastStatusName(), .blob_bytes = blob.len };
+
+    var result = ShaderResult{
+        .status = "ok",
+        .blob_bytes = blob.len,
+        .program_bytes = machine.programBytes(),
+        .runtime_bytes = machine.runtimeBytes(),
+        .decoded_ops = machine.decodedOpCount(),
+        .register_form = machine.hasRegisterForm(),
+        .register_ops = machine.registerOpCount(),
+        .registers = machine.registerCount(),
+        .fusions = machine.fusionCounts(),
+        .fused_away_ops = machine.fusionRemovedOpCount(),
+        .hoisted_lets = machine.hoistedLetCounts(),
+        .hoisted_values = machine.hoistedValueCount(),
+        .pixel_depends_xy = machine.pixelDependsOnXY(),
+    };
+
+    var sink: f32 = 0.0;
+    var elapsed_ns: u64 = 0;
+    const total_frames = options.warmup_frames + options.frames;
+    var frame: u32 = 0;
+    while (frame < total_frames) : (frame += 1) {
+        const time_seconds = @as(f32, @floatFromInt(frame)) / options.frame_rate_hz;
+        var timer = try std.time.Timer.start();
+        renderFrame(&machine, time_seconds, frame, options, &sink) catch {
+            result.status = machine.lastStatusName();
+            return result;
+        };
+        if (frame >= options.warmup_frames) {
+            elapsed_ns += timer.read();
+        }
+    }
+    std.mem.doNotOptimizeAway(sink);
+
+    const pixel_count = @as(u64, options.width) * @as(u64, options.height);
+    if (options.frames > 0) {
+        result.ns_per_frame = elapsed_ns / options.frames;
+        result.ns_per_pixel = @as(f64, @floatFromInt(elapsed_ns)) / @as(f64, @floatFromInt(pixel_count * options.frames));
+    }
+    result.upload_stall = measureUploadStall(allocator, blob, seed, options) catch {
+        result.status = machine.lastStatusName();
+        return result;
+    };
+    return result;
+}
+
+/// Re-upload `blob` `options.uploads` times while another thread renders it back to back, the way the
+/// firmware's upload handler runs next to its render task, once per upload strategy.
+pub fn measureUploadStall(allocator: std.mem.Allocator, blob: []const u8, seed: f32, options: Options) !UploadStall {
+    var first = try bytecode_vm.Machine.init(allocator, options.width, options.height);
+    defer first.deinit();
+    var second = try bytecode_vm.Machine.init(allocator, options.width, options.height);
+    defer second.deinit();
+    const slots = [2]*bytecode_vm.Machine{ &first, &second };
+    try first.load(blob);
+    try first.start(seed);
+
+    var active: usize = 0;
+    const idle = try runUploads(&slots, &active, blob, seed, options, .none);
+    const in_place = try runUploads(&slots, &active, blob, seed, options, .in_place);
+    const swap = try runUploads(&slots, &active, blob, seed, options, .swap);
+    return .{
+        .idle_gap_ns = idle.gap_ns,
+        .in_place_gap_ns = in_place.gap_ns,
+        .in_place_lock_ns = in_place.lock_ns,
+        .swap_gap_ns = swap.gap_ns,
+        .swap_lock_ns = swap.lock_ns,
+    };
+}
+
+const UploadMode = enum { none, in_place, swap };
+
+const UploadRun = struct {
+    gap_ns: u64 = 0,
+    lock_ns: u64 = 0,
+};
+
+/// Stand-in for fw_tcp_shader_task: renders the active slot under `lock` (state_lock) and records the
+/// longest gap between frame starts.
+const RenderLoop = struct {
+    slots: *const [2]*bytecode_vm.Machine,
+    options: Options,
+    lock: std.Thread.Mutex = .{},
+    active: usize,
+    stop: std.atomic.Value(bool) = .init(false),
+    failed: std.atomic.Value(bool) = .init(false),
+    frames: std.atomic.Value(u32) = .init(0),
+    max_gap_ns: u64 = 0,
+    sink: f32 = 0.0,
+
+    fn run(self: *RenderLoop) void {
+        var timer = std.time.Timer.start() catch {
+            self.failed.store(true, .release);
+            return;
+        };
+        var last_start_ns: ?u64 = null;
+        var frame: u32 = 0;
+        while (!self.stop.load(.acquire)) : (frame += 1) {
+            self.lock.lock();
+            const start_ns = timer.read();
+            if (last_start_ns) |last| self.max_gap_ns = @max(self.max_gap_ns, start_ns - last);
+            last_start_ns = start_ns;
+            const time_seconds = @as(f32, @floatFromInt(frame)) / self.options.frame_rate_hz;
+            renderFrame(self.slots[self.active], time_seconds, frame, self.options, &self.sink) catch {
+                self.lock.unlock();
+                self.failed.store(true, .release);
+                return;
+            };
+            self.lock.unlock();
+            _ = self.frames.fetchAdd(1, .release);
+            // The firmware task sleeps until its next deadline here, which is when an upload gets the lock.
+            std.Thread.yield() catch {};
+        }
+    }
+
+    /// Wait until `count` more frames have started and finished; false if the loop stopped on an error.
+    fn waitFrames(self: *RenderLoop, count: u32) bool {
+        const target = self.frames.load(.acquire) + count;
+        while (self.frames.load(.acquire) < target) {
+            if (self.failed.load(.acquire)) return false;
+            std.Thread.yield() catch {};
+        }
+        return true;
+    }
+
+    /// One upload plus activation; returns how long it held the lock.
+    fn upload(self: *RenderLoop, blob: []const u8, seed: f32, mode: UploadMode) !u64 {
+        switch (mode) {
+            .none => return 0,
+            .in_place => {
+                self.lock.lock();
+                defer self.lock.unlock();
+                var timer = try std.time.Timer.start();
+                try self.slots[self.active].load(blob);
+                try self.slots[self.active].start(seed);
+                return timer.read();
+            },
+            .swap => {
+                // Only this thread writes `active`, so it can read it without the lock.
+                const idle = self.active ^ 1;
+                try self.slots[idle].load(blob);
+                try self.slots[idle].start(seed);
+                self.lock.lock();
+                defer self.lock.unlock();
+                var timer = try std.time.Timer.start();
+                self.active = idle;
+                return timer.read();
+            },
+        }
+    }
+};
+
+/// Render from `active.*` on a second thread while running the uploads; `active` returns the slot left rendering.
+fn runUploads(
+    slots: *const [2]*bytecode_vm.Machine,
+    active: *usize,
+    blob: []const u8,
+    seed: f32,
+    options: Options,
+    mode: UploadMode,
+) !UploadRun {
+    var render_loop = RenderLoop{ .slots = slots, .options = options, .active = active.* };
+    const thread = try std.Thread.spawn(.{}, RenderLoop.run, .{&render_loop});
+    var result = UploadRun{};
+    var upload_error: ?anyerror = null;
+    var upload: u32 = 0;
+    while (upload < options.uploads) : (upload += 1) {
+        // Every upload replaces a program that has been rendering.
+        if (!render_loop.waitFrames(2)) break;
+        const lock_ns = render_loop.upload(blob, seed, mode) catch |err| {
+            upload_error = err;
+            break;
+        };
+        result.lock_ns = @max(result.lock_ns, lock_ns);
+    }
+    _ = render_loop.waitFrames(2);
+    render_loop.stop.store(true, .release);
+    thread.join();
+    active.* = render_loop.active;
+    std.mem.doNotOptimizeAway(render_loop.sink);
+    if (upload_error) |err| return err;
+    if (render_loop.failed.load(.acquire)) return error.BytecodeFrameFailed;
+    result.gap_ns = render_loop.max_gap_ns;
+    return result;
+}
+
+fn renderFrame(machine: *bytecode_vm.Machine, time_seconds: f32, frame: u32, options: Options, sink: *f32) !void {
+    try machine.beginFrame(time_seconds, frame);
+    var row_colors: [bytecode_vm.row_lanes]bytecode_vm.c.fw_bc3_color_t = undefined;
+    var y: u16 = 0;
+    while (y < options.height) : (y += 1) {
+        var x0: u16 = 0;
+        while (x0 < options.width) {
+            const chunk: u16 = @intCast(@min(@as(usize, options.width - x0), bytecode_vm.row_lanes));
+            try machine.evalRow(@floatFromInt(y), x0, row_colors[0..chunk]);
+            for (row_colors[0..chunk]) |color| {
+                sink.* += color.r;
+            }
+            x0 += chunk;
+        }
+    }
+}
+
+/// Paths (relative to `dsl_dir_path`, `/`-separated, sorted) of every `.dsl` file below it.
+pub fn collectDslPaths(temp: std.mem.Allocator, dsl_dir_path: []const u8) ![]const []const u8 {
+    var paths = std.ArrayList([]const u8).empty;
+    var dir = try std.fs.cwd().openDir(dsl_dir_path, .{ .iterate = true });
+    defer dir.close();
+    var walker = try dir.walk(temp);
+    defer walker.deinit();
+    while (try walker.next()) |entry| {
+        if (entry.kind != .file or !std.mem.endsWith(u8, entry.basename, ".dsl")) continue;
+        const rel_path = try temp.dupe(u8, entry.path);
+        // Normalize separators so the report is identical on every platform.
+        for (rel_path) |*ch| {
+            if (ch.* == '\\') ch.* = '/';
+        }
+        try paths.append(temp, rel_path);
+    }
+    std.mem.sort([]const u8, paths.items, {}, struct {
+        fn lessThan(_: void, a: []const u8, b: []const u8) bool {
+            return std.mem.order(u8, a, b) == .lt;
+        }
+    }.lessThan);
+    return paths.items;
+}
+
+/// Compile every `.dsl` file below `dsl_dir_path`, run it through the firmware VM and write a JSON report.
+pub fn run(allocator: std.mem.Allocator, dsl_dir_path: []const u8, options: Options, writer: *std.Io.Writer) !void {
+    var arena = std.heap.ArenaAllocator.init(allocator);
+    defer arena.deinit();
+    const temp = arena.allocator();
+    const paths = try collectDslPaths(temp, dsl_dir_path);
+
+    try writer.print("{{\n  \"width\": {d},\n  \"height\": {d},\n  \"frames\": {d},\n  \"shaders\": [", .{ options.width, options.height, options.frames });
+    for (paths, 0..) |rel_path, idx| {
+        const result = try benchmarkDslFile(allocator, temp, dsl_dir_path, rel_path, options);
+        try writer.writeAll(if (idx == 0) "\n" else ",\n");
+        try writer.print(
+            "    {{ \"name\": {f}, \"path\": {f}, \"status\": \"{s}\", \"blob_bytes\": {d}, \"program_bytes\": {d}, \"runtime_bytes\": {d}, \"decoded_ops\": {d}, \"register_form\": {}, \"register_ops\": {d}, \"registers\": {d}, \"fused_away_ops\": {d}, \"fusions\": {{",
+            .{
+                std.json.fmt(std.fs.path.stem(rel_path), .{}),
+                std.json.fmt(rel_path, .{}),
+                result.status,
+                result.blob_bytes,
+                result.program_bytes,
+                result.runtime_bytes,
+                result.decoded_ops,
+                result.register_form,
+                result.register_ops,
+                result.registers,
+                result.fused_away_ops,
+            },
+        );
+        for (result.fusions, 0..) |count, kind| {
+            try writer.print("{s}\"{s}\": {d}", .{ if (kind == 0) " " else ", ", bytecode_vm.fusionKindName(kind), count });
+        }
+        try writer.print(
+            " }}, \"hoisted_lets\": {{ \"frame\": {d}, \"row\": {d} }}, \"hoisted_values\": {d}, \"pixel_depends_xy\": {}, \"ns_per_frame\": {d}, \"ns_per_pixel\": {d:.1}, \"upload_stall_ns\": {{ \"idle_gap\": {d}, \"in_place_gap\": {d}, \"in_place_lock\": {d}, \"swap_gap\": {d}, \"swap_lock\": {d} }} }}",
+            .{
+                result.hoisted_lets[bytecode_vm.c.FW_BC3_RATE_FRAME],
+                result.hoisted_lets[bytecode_vm.c.FW_BC3_RATE_ROW],
+                result.hoisted_values,
+                result.pixel_depends_xy,
+                result.ns_per_frame,
+                result.ns_per_pixel,
+                result.upload_stall.idle_gap_ns,
+                result.upload_stall.in_place_gap_ns,
+                result.upload_stall.in_place_lock_ns,
+                result.upload_stall.swap_gap_ns,
+                result.upload_stall.swap_lock_ns,
+            },
+        );
+    }
+    try writer.writeAll("\n  ]\n}\n");
+    try writer.flush();
+}
+
+fn benchmarkDslFile(
+    allocator: std.mem.Allocator,
+    temp: std.mem.Allocator,
+    dsl_dir_path: []const u8,
+    rel_path: []const u8,
+    options: Options,
+) !ShaderResult {
+    const full_path = try std.fs.path.join(temp, &.{ dsl_dir_path, rel_path });
+    const source = try std.fs.cwd().readFileAlloc(temp, full_path, std.math.maxInt(usize));
+    const program = dsl_parser.parseAndValidate(temp, source) catch |err| return .{ .status = @errorName(err) };
+    var evaluator = dsl_runtime.Evaluator.init(allocator, program) catch |err| return .{ .status = @errorName(err) };
+    defer evaluator.deinit();
+
+    var blob = std.ArrayList(u8).empty;
+    defer blob.deinit(allocator);
+    try evaluator.writeBytecodeBinary(blob.writer(allocator));
+    return benchmarkBlob(allocator, blob.items, evaluator.seed, options);
+}
+
+test "benchmarkBlob times frames and reports decoded and register op counts" {
+    const source =
+        \\effect bench_probe
+        \\layer l {
+        \\  let v = 0.5 + 0.5 * sin(time + x * 0.2 + y * 0.1)
+        \\  blend rgba(v, v, v, 1.0)
+        \\}
+        \\emit
+    ;
+
+    var arena = std.heap.ArenaAllocator.init(std.testing.allocator);
+    defer arena.deinit();
+
+    const program = try dsl_parser.parseAndValidate(arena.allocator(), source);
+    var evaluator = try dsl_runtime.Evaluator.init(std.testing.allocator, program);
+    defer evaluator.deinit();
+
+    var blob = std.ArrayList(u8).empty;
+    defer blob.deinit(std.testing.allocator);
+    try evaluator.writeBytecodeBinary(blob.writer(std.testing.allocator));
+
+    const result = try benchmarkBlob(std.testing.allocator, blob.items, evaluator.seed, .{ .frames = 2, .warmup_frames = 1 });
+    try std.testing.expectEqualStrings("ok", result.status);
+    try std.testing.expectEqual(blob.items.len, result.blob_bytes);
+    try std.testing.expect(result.decoded_ops > 0);
+    try std.testing.expect(result.program_bytes > @sizeOf(bytecode_vm.c.fw_bc3_program_t));
+    // The register file is sized to the registers the program uses, well below the 128-register limit.
+    try std.testing.expect(result.runtime_bytes > @sizeOf(bytecode_vm.c.fw_bc3_runtime_t));
+    try std.testing.expect(result.runtime_bytes < @sizeOf(bytecode_vm.c.fw_bc3_runtime_t) + @as(usize, bytecode_vm.c.FW_BC3_MAX_REGISTERS) * bytecode_vm.row_lanes * @sizeOf(f32));
+    try std.testing.expect(result.register_form);
+    try std.testing.expect(result.register_ops > 0);
+    try std.testing.expect(result.registers > 0 and result.registers < bytecode_vm.c.FW_BC3_MAX_REGISTERS);
+    // `0.5 + 0.5 * sin(...)` folds into one FMA_LIT.
+    try std.testing.expect(result.fusions[bytecode_vm.c.FW_BC3_FUSION_FMA_LIT] > 0);
+    try std.testing.expect(result.fused_away_ops > 0);
+    try std.testing.expect(result.pixel_depends_xy);
+    try std.testing.expect(result.ns_per_frame > 0);
+    try std.testing.expect(result.upload_stall.in_place_lock_ns > 0);
+    try std.testing.expect(result.upload_stall.in_place_gap_ns > 0);
+    try std.testing.expect(result.upload_stall.swap_gap_ns > 0);
+}
+
+test "benchmarkBlob reports load failures instead of aborting" {
+    const garbage = [_]u8{ 'D', 'S', 'L', 'B', 9, 0, 0, 0 };
+    const result = try benchmarkBlob(std.testing.allocator, &garbage, 0.0, .{ .frames = 1 });
+    try std.testing.expectEqualStrings("unsupported_version", result.status);
+    try std.testing.expectEqual(@as(usize, 0), result.decoded_ops);
+}